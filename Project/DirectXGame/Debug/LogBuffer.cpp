@@ -36,7 +36,11 @@ std::string LogBuffer::GetCurrentTimestamp() const {
         now.time_since_epoch()) % 1000;
 
     std::tm localTime;
+#ifdef _WIN32
     localtime_s(&localTime, &time);
+#else
+    localtime_r(&time, &localTime);  // tools/cpp/headless_bench を Windows 以外でビルドするとき
+#endif
 
     std::ostringstream oss;
     oss << std::put_time(&localTime, "%H:%M:%S");
@@ -0,0 +1,516 @@
+#include "BulletPool.h"
+#include "Components/Gameplay.h"
+#include "Components/PrefabManager.h"
+#include "Components/Prefab.h"
+#include "CollisionManager.h"
+#include "IImGuiEditable.h"
+#include "Effect/EffectManager.h"
+#include "Camera.h"
+#include "Primitive/PrimitiveInstance.h"
+#include "Primitive/PrimitiveInstanceBatch.h"
+#include "Primitive/DebugDraw.h"
+#include "MathUtility.h"
+#include "LogBuffer.h"
+#include "PepperMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// 進行方向（正規化済み）→ オイラー角（ラジアン）。LH系・前方+Z 前提（GameScene と同じ式）。
+	Vector3 DirectionToEuler(const Vector3& dir) {
+		const float yaw = std::atan2(dir.x, dir.z);
+		const float horizLen = std::sqrt(dir.x * dir.x + dir.z * dir.z);
+		const float pitch = std::atan2(-dir.y, horizLen);
+		return { pitch, yaw, 0.0f };
+	}
+}
+
+//====================
+// Shell（スロットごとの軽量エンティティ）
+//====================
+
+/// <summary>
+/// 弾スロットの代理エンティティ。Hierarchy / ID Pass には出さず、Gameplay と CollisionManager にだけ登録する。
+/// 位置・回転はプールの SoA 配列を直接指す。
+/// </summary>
+class BulletPool::Shell : public IImGuiEditable {
+public:
+	Shell(Vector3* translate, Vector3* rotate)
+		: IImGuiEditable(NoAutoRegister{}), translate_(translate), rotate_(rotate) {}
+
+	std::string GetName() const override { return "Bullet"; }
+	std::string GetTypeName() const override { return "Bullet"; }
+	void OnImGuiInspector() override {}
+	Vector3* GetEditableTranslate() override { return translate_; }
+	const Vector3* GetEditableRotate() const override { return rotate_; }
+
+private:
+	Vector3* translate_;
+	Vector3* rotate_;
+};
+
+BulletPool::BulletPool() = default;
+
+BulletPool::~BulletPool() {
+	for (uint32_t slot : activeSlots_) {
+		if (trailHandle_[slot] != 0) {
+			if (auto* em = EffectManager::GetInstance()) em->Stop(trailHandle_[slot]);
+		}
+	}
+	// Shell の dtor フックが CollisionManager / Gameplay から外す
+}
+
+void BulletPool::Initialize(uint32_t capacity) {
+	if (IsInitialized() || capacity == 0) return;
+	capacity_ = capacity;
+
+	position_.assign(capacity, Vector3{ 0.0f, 0.0f, 0.0f });
+	velocity_.assign(capacity, Vector3{ 0.0f, 0.0f, 0.0f });
+	rotation_.assign(capacity, Vector3{ 0.0f, 0.0f, 0.0f });
+	origin_.assign(capacity, Vector3{ 0.0f, 0.0f, 0.0f });
+	speed_.assign(capacity, 0.0f);
+	lifetime_.assign(capacity, 0.0f);
+	baseRadius_.assign(capacity, 0.0f);
+	growth_.assign(capacity, 0.0f);
+	maxTravel_.assign(capacity, 0.0f);
+	homingStrength_.assign(capacity, 0.0f);
+	homingTarget_.assign(capacity, EntityHandle{});
+	trailHandle_.assign(capacity, 0);
+	penetrateDamage_.assign(capacity, 0);
+	cooldowns_.assign(capacity, PenetrateCooldowns{});
+	archetype_.assign(capacity, kInvalidBulletArchetype);
+	archetypeVersion_.assign(capacity, 0);
+	playerOwned_.assign(capacity, 0);
+	active_.assign(capacity, 0);
+
+	activeSlots_.clear();
+	activeSlots_.reserve(capacity);
+	freshSlots_.clear();
+	freshSlots_.reserve(capacity);
+
+	shells_.clear();
+	shells_.reserve(capacity);
+	for (uint32_t i = 0; i < capacity; ++i) {
+		shells_.push_back(std::make_unique<Shell>(&position_[i], &rotation_[i]));
+		Shell* shell = shells_.back().get();
+		GameplayComponents& gp = Gameplay::Of(shell);
+		gp.GetCollider().enabled = false;
+		gp.GetCollider().onCollision = [this, i](IImGuiEditable* other) {
+			if (!other || !active_[i] || !hitHandler_) return;
+			hitHandler_(i, other);
+		};
+		CollisionManager::GetInstance()->Register(shell);
+	}
+	// 小さい番号から使う（pop_back で取り出すので逆順に積む）
+	for (uint32_t i = capacity; i > 0; --i) freshSlots_.push_back(i - 1);
+
+	stats_ = Stats{};
+	stats_.capacity = capacity;
+}
+
+//====================
+// アーキタイプ
+//====================
+
+BulletArchetypeId BulletPool::ResolveArchetype(const std::string& prefabName) {
+	if (!IsInitialized()) Initialize();
+
+	auto it = archetypeByName_.find(prefabName);
+	if (it != archetypeByName_.end()) {
+		return RefreshArchetype(it->second) ? it->second : kInvalidBulletArchetype;
+	}
+
+	if (archetypes_.size() >= kInvalidBulletArchetype) return kInvalidBulletArchetype;
+	auto arch = std::make_unique<Archetype>();
+	arch->prefabName = prefabName;
+	if (!BuildArchetype(*arch)) {
+		LogBuffer::Instance().Add(
+			std::string("BulletPool: prefab not usable as bullet (missing or not primitive): ") + prefabName,
+			LogBuffer::Level::Warning);
+		return kInvalidBulletArchetype;
+	}
+	const BulletArchetypeId id = static_cast<BulletArchetypeId>(archetypes_.size());
+	archetypes_.push_back(std::move(arch));
+	archetypeByName_.emplace(prefabName, id);
+	stats_.archetypes = static_cast<uint32_t>(archetypes_.size());
+	return id;
+}
+
+bool BulletPool::RefreshArchetype(BulletArchetypeId id) {
+	if (id >= archetypes_.size()) return false;
+	Archetype& arch = *archetypes_[id];
+	if (arch.prefabRevision == PrefabManager::GetInstance()->GetRevision()) return true;
+	// プレハブが再スキャンされた → テンプレートを作り直す（スロット側は version 差分で次回スポーン時にコピーし直す）
+	return BuildArchetype(arch);
+}
+
+bool BulletPool::BuildArchetype(Archetype& arch) {
+	const PrefabDef* def = PrefabManager::GetInstance()->Find(arch.prefabName);
+	if (!def || def->kind != PrefabKind::Primitive) return false;
+
+	const int kCount = static_cast<int>(PrimitiveInstance::PrimitiveType::kCount);
+	const int type = def->primitiveParams.primitiveType;
+	if (type < 0 || type >= kCount) return false;
+
+	arch.prefabRevision = PrefabManager::GetInstance()->GetRevision();
+	++arch.version;
+
+	arch.components = GameplayComponents{};
+	PrefabManager::ApplyGameplayComponents(*def, arch.prefabName, arch.components);
+	arch.baseRadius = arch.components.GetCollider().radius;
+	arch.colliderEnabled = arch.components.GetCollider().enabled;
+	arch.penetrate = def->hasBullet && def->bulletPenetrate;
+	arch.penetrateDamageRate = def->hasBullet ? def->bulletPenetrateDamageRate : 0.2f;
+	arch.trailEffect = arch.components.FindEffect("trail");
+	arch.scale = def->defaultScale;
+
+	// 描画テンプレート：InstantiatePrefab と同じ手順で 1 個だけ作る（シーンには登録しない）
+	arch.visual = std::make_unique<PrimitiveInstance>(IImGuiEditable::NoAutoRegister{});
+	arch.visual->Initialize(static_cast<PrimitiveInstance::PrimitiveType>(type), arch.prefabName);
+	arch.visual->ApplyPrefabParams(def->primitiveParams);
+	arch.visual->SetScale(def->defaultScale);
+
+	if (!arch.batch) {
+		arch.batch = std::make_unique<PrimitiveInstanceBatch>();
+		arch.batch->Initialize(capacity_);
+	}
+	return true;
+}
+
+const GameplayComponents* BulletPool::GetArchetypeComponents(BulletArchetypeId id) const {
+	if (id >= archetypes_.size()) return nullptr;
+	return &archetypes_[id]->components;
+}
+
+void BulletPool::AssignArchetype(uint32_t slot, BulletArchetypeId id) {
+	const Archetype& arch = *archetypes_[id];
+	if (archetype_[slot] == id && archetypeVersion_[slot] == arch.version) return;
+
+	// テンプレートのタグ・コライダー形状・DamageDealer・エフェクト等をコピー（onCollision はスロット固有なので残す）
+	GameplayComponents& gp = Gameplay::Of(shells_[slot].get());
+	auto onCollision = std::move(gp.GetCollider().onCollision);
+	gp = arch.components;
+	gp.GetCollider().onCollision = std::move(onCollision);
+	// 高速弾が 1 フレームで相手をまたがないよう掃引判定にする
+	gp.GetCollider().continuous = true;
+	gp.GetCollider().enabled = false;
+
+	archetype_[slot] = id;
+	archetypeVersion_[slot] = arch.version;
+	++stats_.componentCopies;
+}
+
+uint32_t BulletPool::AcquireSlot(BulletArchetypeId id) {
+	// 同じアーキタイプの空き → 未使用 → 他アーキタイプの空き（コピーし直し）の順
+	auto& own = archetypes_[id]->freeSlots;
+	if (!own.empty()) {
+		const uint32_t slot = own.back();
+		own.pop_back();
+		return slot;
+	}
+	if (!freshSlots_.empty()) {
+		const uint32_t slot = freshSlots_.back();
+		freshSlots_.pop_back();
+		return slot;
+	}
+	for (auto& other : archetypes_) {
+		if (other->freeSlots.empty()) continue;
+		const uint32_t slot = other->freeSlots.back();
+		other->freeSlots.pop_back();
+		return slot;
+	}
+	return kInvalidSlot;
+}
+
+void BulletPool::Prewarm(BulletArchetypeId id, uint32_t count) {
+	if (id >= archetypes_.size()) return;
+	auto& own = archetypes_[id]->freeSlots;
+	while (own.size() < count && !freshSlots_.empty()) {
+		const uint32_t slot = freshSlots_.back();
+		freshSlots_.pop_back();
+		AssignArchetype(slot, id);
+		own.push_back(slot);
+	}
+}
+
+//====================
+// スポーン / 消滅
+//====================
+
+uint32_t BulletPool::Spawn(BulletArchetypeId id, const BulletSpawnDesc& desc) {
+	if (!IsInitialized()) Initialize();
+	if (id >= archetypes_.size()) return kInvalidSlot;
+
+	const uint32_t slot = AcquireSlot(id);
+	if (slot == kInvalidSlot) {
+		++stats_.spawnFailures;
+		return kInvalidSlot;
+	}
+	AssignArchetype(slot, id);
+	const Archetype& arch = *archetypes_[id];
+
+	const Vector3 euler = DirectionToEuler(desc.direction);
+	position_[slot] = desc.position;
+	velocity_[slot] = { desc.direction.x * desc.speed, desc.direction.y * desc.speed, desc.direction.z * desc.speed };
+	rotation_[slot] = euler;
+	origin_[slot] = desc.position;
+	speed_[slot] = desc.speed;
+	lifetime_[slot] = desc.lifetime;
+	baseRadius_[slot] = arch.baseRadius;
+	growth_[slot] = desc.colliderGrowthPerMeter;
+	maxTravel_[slot] = desc.maxTravelDistance;
+	homingTarget_[slot] = desc.homingTarget;
+	homingStrength_[slot] = desc.homingStrength;
+	cooldowns_[slot].count = 0;
+	playerOwned_[slot] = desc.playerOwned ? 1 : 0;
+
+	// 前回の弾の状態（拡大した半径・掃引の前フレーム中心）をリセットして有効化
+	GameplayComponents& gp = Gameplay::Of(shells_[slot].get());
+	Collider& col = gp.GetCollider();
+	col.radius = arch.baseRadius;
+	col.hasPrevCenter = false;
+	col.isCollidingThisFrame = false;
+	col.enabled = arch.colliderEnabled;
+
+	DamageDealer& dd = gp.GetDamageDealer();
+	dd = arch.components.GetDamageDealer();
+	penetrateDamage_[slot] = 0;
+	if (dd.enabled) {
+		if (desc.damage >= 0) dd.damage = desc.damage;
+		// 貫通弾は CollisionManager の毎フレーム自動ダメージを無効化し、ヒット側で damageRate 制御する
+		if (desc.playerOwned && arch.penetrate) {
+			penetrateDamage_[slot] = dd.damage;
+			dd.enabled = false;
+		}
+	}
+
+	// 弾追従エフェクト（trail スロット、ループ前提）。消滅時に Stop する。
+	trailHandle_[slot] = 0;
+	if (desc.playerOwned && !arch.trailEffect.empty()) {
+		if (auto* em = EffectManager::GetInstance()) {
+			trailHandle_[slot] = em->Play(arch.trailEffect, desc.position);
+			em->SetRotation(trailHandle_[slot], euler);
+		}
+	}
+
+	active_[slot] = 1;
+	activeSlots_.push_back(slot);
+	stats_.active = static_cast<uint32_t>(activeSlots_.size());
+	stats_.peakActive = (std::max)(stats_.peakActive, stats_.active);
+	return slot;
+}
+
+void BulletPool::Kill(uint32_t slot) {
+	if (!IsActive(slot)) return;
+	lifetime_[slot] = -1.0f;
+}
+
+bool BulletPool::KillEntity(const IImGuiEditable* e) {
+	const uint32_t slot = SlotOf(e);
+	if (slot == kInvalidSlot || !active_[slot]) return false;
+	lifetime_[slot] = -1.0f;
+	return true;
+}
+
+void BulletPool::Release(uint32_t slot) {
+	GameplayComponents& gp = Gameplay::Of(shells_[slot].get());
+	gp.GetCollider().enabled = false;
+	gp.GetCollider().isCollidingThisFrame = false;
+	if (trailHandle_[slot] != 0) {
+		if (auto* em = EffectManager::GetInstance()) em->Stop(trailHandle_[slot]);
+		trailHandle_[slot] = 0;
+	}
+	homingTarget_[slot] = {};
+	active_[slot] = 0;
+	archetypes_[archetype_[slot]]->freeSlots.push_back(slot);
+}
+
+void BulletPool::Clear() {
+	for (uint32_t slot : activeSlots_) Release(slot);
+	activeSlots_.clear();
+	stats_.active = 0;
+}
+
+//====================
+// 参照
+//====================
+
+IImGuiEditable* BulletPool::EntityOf(uint32_t slot) const {
+	return slot < capacity_ ? shells_[slot].get() : nullptr;
+}
+
+GameplayComponents& BulletPool::ComponentsOf(uint32_t slot) const {
+	return Gameplay::Of(shells_[slot].get());
+}
+
+uint32_t BulletPool::SlotOf(const IImGuiEditable* e) const {
+	if (!e || shells_.empty()) return kInvalidSlot;
+	// Shell は個別に確保しているので、Shell が指す位置（position_ の要素）から添字を引く
+	const Shell* shell = dynamic_cast<const Shell*>(e);
+	if (!shell) return kInvalidSlot;
+	const Vector3* t = const_cast<Shell*>(shell)->GetEditableTranslate();
+	if (t < position_.data() || t >= position_.data() + capacity_) return kInvalidSlot;
+	return static_cast<uint32_t>(t - position_.data());
+}
+
+bool BulletPool::IsPenetrating(uint32_t slot) const {
+	return playerOwned_[slot] && archetypes_[archetype_[slot]]->penetrate;
+}
+
+bool BulletPool::TryPenetrateHit(uint32_t slot, EntityHandle target) {
+	PenetrateCooldowns& cd = cooldowns_[slot];
+	const float rate = archetypes_[archetype_[slot]]->penetrateDamageRate;
+	for (uint32_t i = 0; i < cd.count; ++i) {
+		if (cd.target[i] != target) continue;
+		if (cd.remaining[i] > 0.0f) return false;
+		cd.remaining[i] = rate;
+		return true;
+	}
+	// 初ヒット：空き（クールタイム切れ）を再利用、無ければ末尾に追加。満杯なら最も早く切れる枠を上書き
+	uint32_t idx = cd.count;
+	for (uint32_t i = 0; i < cd.count; ++i) {
+		if (cd.remaining[i] <= 0.0f) { idx = i; break; }
+	}
+	if (idx == kMaxPenetrateTargets) {
+		idx = 0;
+		for (uint32_t i = 1; i < cd.count; ++i) {
+			if (cd.remaining[i] < cd.remaining[idx]) idx = i;
+		}
+	}
+	if (idx == cd.count) ++cd.count;
+	cd.target[idx] = target;
+	cd.remaining[idx] = rate;
+	return true;
+}
+
+//====================
+// 更新 / 描画
+//====================
+
+void BulletPool::Update(float deltaTime) {
+	PEPPER_SCOPE("BulletPool::Update");
+	if (activeSlots_.empty()) return;
+
+	auto* em = EffectManager::GetInstance();
+
+	for (uint32_t slot : activeSlots_) {
+		// 貫通弾の多段ヒット用クールタイムを減算
+		PenetrateCooldowns& cd = cooldowns_[slot];
+		for (uint32_t i = 0; i < cd.count; ++i) cd.remaining[i] -= deltaTime;
+
+		Vector3& pos = position_[slot];
+		Vector3& vel = velocity_[slot];
+		const float speed = speed_[slot];
+
+		// ----- ホーミング（target が生きていれば velocity を target 方向へ補正） -----
+		// 弾速の大きさは保持し、方向だけを target に向けて指数減衰で寄せる。
+		if (homingTarget_[slot].IsValid()) {
+			IImGuiEditable* target = Gameplay::Resolve(homingTarget_[slot]);
+			const Vector3* tp = target ? target->GetEditableTranslate() : nullptr;
+			if (!tp) {
+				homingTarget_[slot] = {}; // target が破棄済み → ホーミング解除
+			} else if (homingStrength_[slot] > 0.0f && speed > 0.0f) {
+				const float dx = tp->x - pos.x;
+				const float dy = tp->y - pos.y;
+				const float dz = tp->z - pos.z;
+				const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+				if (dist > 1e-4f) {
+					const float alpha = 1.0f - std::exp(-homingStrength_[slot] * deltaTime);
+					const float curX = vel.x / speed;
+					const float curY = vel.y / speed;
+					const float curZ = vel.z / speed;
+					float nx = curX + (dx / dist - curX) * alpha;
+					float ny = curY + (dy / dist - curY) * alpha;
+					float nz = curZ + (dz / dist - curZ) * alpha;
+					const float nlen = std::sqrt(nx * nx + ny * ny + nz * nz);
+					if (nlen > 1e-6f) {
+						nx /= nlen; ny /= nlen; nz /= nlen;
+						vel = { nx * speed, ny * speed, nz * speed };
+					}
+				}
+			}
+		}
+
+		// 移動
+		pos.x += vel.x * deltaTime;
+		pos.y += vel.y * deltaTime;
+		pos.z += vel.z * deltaTime;
+
+		// 進行方向に弾とエフェクトの向きを合わせる（ホーミングで方向が変わるため毎フレーム更新）
+		if (speed > 1e-4f) {
+			const Vector3 d{ vel.x / speed, vel.y / speed, vel.z / speed };
+			rotation_[slot] = DirectionToEuler(d);
+			if (trailHandle_[slot] != 0 && em) em->SetRotation(trailHandle_[slot], rotation_[slot]);
+#ifdef USE_IMGUI
+			// デバッグ：プレイヤー弾の進行方向に線を表示（黄色）
+			if (TagOf(slot) == EntityTag::PlayerBullet) {
+				DebugDraw::Ray(pos, d, 5.0f, { 1.0f, 1.0f, 0.0f, 1.0f });
+			}
+#endif
+		}
+
+		// trail エフェクトを弾位置に追従
+		if (trailHandle_[slot] != 0 && em) em->SetPosition(trailHandle_[slot], pos);
+
+		// 進行距離（colliderGrowth と maxTravelDistance の両方で使う）
+		const float growth = growth_[slot];
+		const float maxTravel = maxTravel_[slot];
+		float traveled = 0.0f;
+		if (growth > 0.0f || maxTravel > 0.0f) {
+			const float dx = pos.x - origin_[slot].x;
+			const float dy = pos.y - origin_[slot].y;
+			const float dz = pos.z - origin_[slot].z;
+			traveled = std::sqrt(dx * dx + dy * dy + dz * dz);
+		}
+
+		// 進行距離に応じて collider 半径を拡大（STG 的「遠距離ほど判定太く」）
+		if (growth > 0.0f) {
+			ComponentsOf(slot).GetCollider().radius = baseRadius_[slot] + traveled * growth;
+		}
+
+		// 最大到達距離（aim plane）を超えたら消滅
+		if (maxTravel > 0.0f && traveled >= maxTravel) {
+			lifetime_[slot] = -1.0f;
+		} else {
+			lifetime_[slot] -= deltaTime;
+		}
+	}
+
+	// 寿命切れの弾を回収（スポーン順を保ったまま詰める）
+	auto keep = activeSlots_.begin();
+	for (uint32_t slot : activeSlots_) {
+		if (lifetime_[slot] > 0.0f) {
+			*keep++ = slot;
+		} else {
+			Release(slot);
+		}
+	}
+	activeSlots_.erase(keep, activeSlots_.end());
+	stats_.active = static_cast<uint32_t>(activeSlots_.size());
+}
+
+void BulletPool::Draw(Camera* camera) {
+	PEPPER_SCOPE("BulletPool::Draw");
+	stats_.drawCalls = 0;
+	if (!camera || activeSlots_.empty()) return;
+
+	for (auto& arch : archetypes_) arch->batch->Clear();
+
+	const Matrix4x4& viewProjection = camera->GetViewProjectionMatrix();
+	for (uint32_t slot : activeSlots_) {
+		Archetype& arch = *archetypes_[archetype_[slot]];
+		const Matrix4x4 world = arch.visual->GetMesh().BuildInstanceWorldMatrix(
+			camera, arch.scale, rotation_[slot], position_[slot]);
+		arch.batch->Push(world, Multiply(world, viewProjection));
+	}
+
+	for (auto& arch : archetypes_) {
+		if (arch->batch->GetCount() == 0) continue;
+		// マテリアル（色・UV スクロール）をテンプレート側で進めてから全インスタンスで共有する
+		arch->visual->SetCamera(camera);
+		arch->visual->Update();
+		arch->batch->Draw(arch->visual->GetMesh());
+		++stats_.drawCalls;
+	}
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EntityHandle.h"
+#include "EntityTag.h"
+#include "GameplayComponents.h"
+#include "Vector3.h"
+
+class Camera;
+class IImGuiEditable;
+class PrimitiveInstance;
+class PrimitiveInstanceBatch;
+
+/// <summary>弾アーキタイプ（弾プレハブを 1 回だけ解決したもの）の ID。</summary>
+using BulletArchetypeId = uint16_t;
+constexpr BulletArchetypeId kInvalidBulletArchetype = 0xFFFF;
+
+/// <summary>
+/// 弾 1 発ぶんのスポーン指定。プレハブ由来の値（見た目・コライダー・エフェクト・貫通設定）はアーキタイプが持つ。
+/// </summary>
+struct BulletSpawnDesc {
+	Vector3 position{ 0.0f, 0.0f, 0.0f };
+	Vector3 direction{ 0.0f, 0.0f, 1.0f }; // 正規化済みの前提
+	float speed = 0.0f;
+	float lifetime = 0.0f;
+	float colliderGrowthPerMeter = 0.0f;   // 進行 1m あたりの collider 半径拡大量
+	EntityHandle homingTarget{};
+	float homingStrength = 0.0f;
+	float maxTravelDistance = 0.0f;        // 0 = 無制限
+	int   damage = -1;                     // 0 以上なら DamageDealer.damage を上書き（攻撃力の焼き込み）
+	bool  playerOwned = false;             // プレイヤー弾（プレハブの貫通設定と "trail" エフェクトを使う）
+};
+
+/// <summary>
+/// 固定容量の弾プール。弾 1 発ごとに PrimitiveInstance（メッシュ・定数バッファ）を作らず、
+/// 位置・速度・寿命などを SoA 配列に持ち、空きスロットをフリーリストで再利用する。
+/// 描画はアーキタイプ（弾プレハブ）ごとにインスタンシングで 1 ドローコール。
+///
+/// 各スロットは軽量なエンティティ（Shell）を 1 つ持ち、Gameplay / CollisionManager には Initialize 時に一度だけ登録する。
+/// ロックオン・PlayHitEffects など IImGuiEditable* を受ける既存処理は EntityOf(slot) をそのまま渡せる。
+/// Shell のコンポーネントは「別アーキタイプの弾として再利用するとき」だけコピーし直すので、
+/// 定常状態のスポーン / 更新はヒープを確保しない。
+/// Shell は再利用されるため、弾の生死は EntityHandle ではなく IsActive / スロット番号で判定すること。
+/// </summary>
+class BulletPool {
+public:
+	static constexpr uint32_t kDefaultCapacity = 1024;
+	static constexpr uint32_t kInvalidSlot = 0xFFFFFFFFu;
+	static constexpr uint32_t kMaxPenetrateTargets = 8; // 貫通弾 1 発が同時にクールタイムを持てる敵の数
+
+	/// <summary>弾が何かに当たったときの通知（slot = 弾、other = 相手）。</summary>
+	using HitHandler = std::function<void(uint32_t slot, IImGuiEditable* other)>;
+
+	struct Stats {
+		uint32_t capacity = 0;
+		uint32_t active = 0;
+		uint32_t peakActive = 0;
+		uint32_t archetypes = 0;
+		uint32_t spawnFailures = 0;   // 満杯で捨てた数
+		uint32_t componentCopies = 0; // アーキタイプ替えでコンポーネントをコピーし直した回数
+		uint32_t drawCalls = 0;       // 直近 Draw のドローコール数
+	};
+
+	BulletPool();
+	~BulletPool();
+
+	BulletPool(const BulletPool&) = delete;
+	BulletPool& operator=(const BulletPool&) = delete;
+
+	/// <summary>スロットと Shell を確保する（未初期化なら Spawn / ResolveArchetype が既定容量で呼ぶ）。</summary>
+	void Initialize(uint32_t capacity = kDefaultCapacity);
+	bool IsInitialized() const { return capacity_ != 0; }
+
+	void SetHitHandler(HitHandler handler) { hitHandler_ = std::move(handler); }
+
+	/// <summary>
+	/// 弾プレハブ名 → アーキタイプ ID。初回にプレハブを読んでテンプレート（見た目・コンポーネント）を作り、
+	/// 以降は ID を返すだけ。PrefabManager::Rescan 後は次の呼び出しで作り直す。
+	/// Primitive 種別でない / 見つからないプレハブは kInvalidBulletArchetype。
+	/// </summary>
+	BulletArchetypeId ResolveArchetype(const std::string& prefabName);
+
+	/// <summary>
+	/// 控えておいた ID のアーキタイプを、PrefabManager::Rescan 後なら作り直す（ID は変わらない）。
+	/// 名前は引かないので、スポーンのたびに呼んでよい。無効な ID・作り直せないときは false。
+	/// </summary>
+	bool RefreshArchetype(BulletArchetypeId id);
+
+	/// <summary>アーキタイプのテンプレートコンポーネント（プレハブの BulletParams / DamageDealer の参照用）。</summary>
+	const GameplayComponents* GetArchetypeComponents(BulletArchetypeId id) const;
+
+	/// <summary>
+	/// 空きスロットを count 個このアーキタイプ用に先取りし、コンポーネントをコピーしておく
+	/// （初回の弾幕でコピーが走らないように、シーン初期化時に呼ぶ）。
+	/// </summary>
+	void Prewarm(BulletArchetypeId id, uint32_t count);
+
+	/// <summary>1 発スポーン。満杯・無効アーキタイプなら kInvalidSlot。</summary>
+	uint32_t Spawn(BulletArchetypeId id, const BulletSpawnDesc& desc);
+
+	/// <summary>弾を消滅予約する（寿命を 0 以下にし、次の Update で回収）。</summary>
+	void Kill(uint32_t slot);
+
+	/// <summary>Shell から弾を引いて消滅予約する。弾でなければ false。</summary>
+	bool KillEntity(const IImGuiEditable* e);
+
+	/// <summary>全弾を即時回収する（ウェーブのリセット・シーン再ロード用）。</summary>
+	void Clear();
+
+	/// <summary>ホーミング → 移動 → 向き → trail 追従 → collider 拡大 → 寿命、を生存弾について 1 パスで回し、消滅した弾を回収する。</summary>
+	void Update(float deltaTime);
+
+	/// <summary>アーキタイプごとにインスタンスバッファへ積み、インスタンシングで描画する。</summary>
+	void Draw(Camera* camera);
+
+	//====================
+	// 参照（スポーン順に並んだ生存スロット）
+	//====================
+	const std::vector<uint32_t>& ActiveSlots() const { return activeSlots_; }
+	bool IsActive(uint32_t slot) const { return slot < capacity_ && active_[slot] != 0; }
+	IImGuiEditable* EntityOf(uint32_t slot) const;
+	const Vector3& PositionOf(uint32_t slot) const { return position_[slot]; }
+	GameplayComponents& ComponentsOf(uint32_t slot) const;
+	EntityTag TagOf(uint32_t slot) const { return ComponentsOf(slot).GetTag(); }
+	bool IsPlayerOwned(uint32_t slot) const { return playerOwned_[slot] != 0; }
+
+	/// <summary>Shell → スロット（弾でなければ kInvalidSlot）。</summary>
+	uint32_t SlotOf(const IImGuiEditable* e) const;
+
+	//====================
+	// 貫通弾
+	//====================
+	bool IsPenetrating(uint32_t slot) const;
+	int  PenetrateDamageOf(uint32_t slot) const { return penetrateDamage_[slot]; }
+
+	/// <summary>
+	/// 貫通弾が target に当たったとき、多段ヒットのクールタイムが切れていれば true を返してクールタイムを開始する。
+	/// </summary>
+	bool TryPenetrateHit(uint32_t slot, EntityHandle target);
+
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	class Shell;
+
+	struct Archetype {
+		std::string prefabName;
+		uint32_t prefabRevision = 0;
+		uint32_t version = 0;                  // 作り直すたびに進む（スロット側のコピーと比較）
+		GameplayComponents components;         // タグ・コライダー・DamageDealer・エフェクト等のテンプレート
+		float   baseRadius = 0.0f;
+		bool    colliderEnabled = false;
+		bool    penetrate = false;
+		float   penetrateDamageRate = 0.2f;
+		std::string trailEffect;
+		Vector3 scale{ 1.0f, 1.0f, 1.0f };
+		std::unique_ptr<PrimitiveInstance> visual; // 描画テンプレート（メッシュ・マテリアル）
+		std::unique_ptr<PrimitiveInstanceBatch> batch;
+		std::vector<uint32_t> freeSlots;       // このアーキタイプのコンポーネントを保持している空きスロット
+	};
+
+	struct PenetrateCooldowns {
+		EntityHandle target[kMaxPenetrateTargets];
+		float remaining[kMaxPenetrateTargets];
+		uint32_t count = 0;
+	};
+
+	bool BuildArchetype(Archetype& arch);
+	uint32_t AcquireSlot(BulletArchetypeId id);
+	void AssignArchetype(uint32_t slot, BulletArchetypeId id);
+	void Release(uint32_t slot);
+
+	uint32_t capacity_ = 0;
+	HitHandler hitHandler_;
+
+	// ----- スロットごと（SoA、Initialize 後はサイズ固定なので要素へのポインタは動かない） -----
+	std::vector<std::unique_ptr<Shell>> shells_;
+	std::vector<Vector3> position_;
+	std::vector<Vector3> velocity_;
+	std::vector<Vector3> rotation_;
+	std::vector<Vector3> origin_;
+	std::vector<float> speed_;
+	std::vector<float> lifetime_;
+	std::vector<float> baseRadius_;
+	std::vector<float> growth_;
+	std::vector<float> maxTravel_;
+	std::vector<float> homingStrength_;
+	std::vector<EntityHandle> homingTarget_;
+	std::vector<uint64_t> trailHandle_;
+	std::vector<int> penetrateDamage_;
+	std::vector<PenetrateCooldowns> cooldowns_;
+	std::vector<BulletArchetypeId> archetype_;   // このスロットのコンポーネントがどのアーキタイプのものか
+	std::vector<uint32_t> archetypeVersion_;
+	std::vector<uint8_t> playerOwned_;
+	std::vector<uint8_t> active_;
+
+	std::vector<uint32_t> activeSlots_;
+	std::vector<uint32_t> freshSlots_;           // まだどのアーキタイプにも割り当てていないスロット
+
+	std::vector<std::unique_ptr<Archetype>> archetypes_;
+	std::unordered_map<std::string, BulletArchetypeId> archetypeByName_;
+
+	Stats stats_{};
+};
@@ -0,0 +1,292 @@
+#include "CollisionBenchmark.h"
+#include "CollisionBroadphase.h"
+#include "CollisionMatrix.h"
+#include "CollisionNarrowphase.h"
+#include "EntityTag.h"
+#include "LogBuffer.h"
+#include "MathUtility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+	BroadphaseProxy MakeProxy(const Vector3& center, const Vector3& half, EntityTag tag) {
+		BroadphaseProxy p;
+		p.min = { center.x - half.x, center.y - half.y, center.z - half.z };
+		p.max = { center.x + half.x, center.y + half.y, center.z + half.z };
+		p.tagBit = 1u << static_cast<uint32_t>(tag);
+		p.collideMask = CollisionMatrix::CollideMask(tag);
+		return p;
+	}
+
+	// 形状ペアごとの SIMD / スカラー照合の 1 行ぶん
+	struct ShapeCombo {
+		const char*   name;
+		ColliderShape a;
+		ColliderShape b;
+	};
+
+	// RunNarrowphase 用：形状と向きをばらしたコライダーを soa に count 個詰める（形状は shapes[i % 3]）
+	void FillRandomColliders(std::mt19937& rng, uint32_t count, ColliderSoA& soa) {
+		std::uniform_real_distribution<float> posDist(-2.5f, 2.5f);
+		std::uniform_real_distribution<float> angDist(-kPi, kPi);
+		std::uniform_real_distribution<float> sizeDist(0.1f, 1.5f);
+		std::uniform_real_distribution<float> heightDist(0.0f, 3.0f);
+		const ColliderShape kShapes[] = { ColliderShape::Sphere, ColliderShape::OBB, ColliderShape::Capsule };
+
+		soa.Clear();
+		for (uint32_t i = 0; i < count; ++i) {
+			Collider c;
+			c.shape = kShapes[i % 3];
+			c.radius = sizeDist(rng);
+			c.halfExtents = { sizeDist(rng), sizeDist(rng), sizeDist(rng) };
+			c.capsuleRadius = sizeDist(rng);
+			// 1 割は高さ 0（点カプセル = 球）にして線分が縮退した場合も通す
+			c.capsuleHeight = (i % 10 == 0) ? 0.0f : heightDist(rng);
+			const Vector3 center{ posDist(rng), posDist(rng), posDist(rng) };
+			const Matrix4x4 rot = MakeRotateMatrix({ angDist(rng), angDist(rng), angDist(rng) });
+			Vector3 axes[3];
+			for (int k = 0; k < 3; ++k) axes[k] = { rot.m[k][0], rot.m[k][1], rot.m[k][2] };
+			soa.Push(c, center, axes);
+		}
+	}
+}
+
+namespace CollisionBenchmark {
+
+	void RunBroadphase(float cellSize) {
+		using Clock = std::chrono::high_resolution_clock;
+
+		// 弾幕シーン相当のタグ構成（大半が弾、少数の敵、自機 1）
+		const EntityTag kTags[] = {
+			EntityTag::EnemyAttack, EntityTag::EnemyAttack, EntityTag::EnemyAttack,
+			EntityTag::PlayerBullet, EntityTag::PlayerBullet, EntityTag::Enemy,
+		};
+		const uint32_t kCounts[] = { 100, 500, 1000, 2000, 5000, 10000 };
+
+		std::mt19937 rng(12345u);
+		std::vector<BroadphaseProxy> proxies;
+		std::vector<BroadphasePair> hashPairs;
+		std::vector<BroadphasePair> brutePairs;
+		SpatialHashBroadphase hash;
+		hash.SetCellSize(cellSize);
+
+		LogBuffer::Instance().Add("[Collision] Broadphase benchmark (spatial hash vs brute force)");
+		for (uint32_t count : kCounts) {
+			// 密度一定（1 コライダーあたり一辺 4 の空間）で散らす
+			const float side = std::cbrt(static_cast<float>(count)) * 4.0f;
+			std::uniform_real_distribution<float> posDist(-0.5f * side, 0.5f * side);
+			std::uniform_real_distribution<float> radiusDist(0.3f, 1.5f);
+			std::uniform_int_distribution<size_t> tagDist(0, std::size(kTags) - 1);
+
+			proxies.clear();
+			for (uint32_t i = 0; i < count; ++i) {
+				const EntityTag tag = (i == 0) ? EntityTag::Player : kTags[tagDist(rng)];
+				const Vector3 c{ posDist(rng), posDist(rng), posDist(rng) };
+				const float r = radiusDist(rng);
+				proxies.push_back(MakeProxy(c, { r, r, r }, tag));
+			}
+
+			// 小さい n は回数を増やしてタイマー分解能の影響を減らす
+			const uint32_t reps = std::max<uint32_t>(1, 20000 / count);
+
+			const auto h0 = Clock::now();
+			for (uint32_t r = 0; r < reps; ++r) hash.FindPairs(proxies, hashPairs);
+			const auto h1 = Clock::now();
+			for (uint32_t r = 0; r < reps; ++r) SpatialHashBroadphase::FindPairsBruteForce(proxies, brutePairs);
+			const auto h2 = Clock::now();
+
+			const double hashMs  = std::chrono::duration<double, std::milli>(h1 - h0).count() / reps;
+			const double bruteMs = std::chrono::duration<double, std::milli>(h2 - h1).count() / reps;
+			const bool match = (hashPairs == brutePairs);
+
+			char buf[192];
+			std::snprintf(buf, sizeof(buf),
+				"[Collision] n=%5u  hash %.3f ms  brute %.3f ms  (x%.1f)  pairs %zu  %s",
+				count, hashMs, bruteMs, (hashMs > 0.0) ? bruteMs / hashMs : 0.0,
+				hashPairs.size(), match ? "match" : "MISMATCH");
+			LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+		}
+	}
+
+	void RunOBBCapsule() {
+		using Clock = std::chrono::high_resolution_clock;
+		constexpr int kCases = 20000;
+		constexpr int kReferenceSamples = 2048; // 基準値：十分細かいサンプリング
+
+		struct Case {
+			Vector3 oc;
+			Vector3 axes[3];
+			Vector3 he;
+			Vector3 a, b;
+			float   r;
+		};
+
+		std::mt19937 rng(67890u);
+		std::uniform_real_distribution<float> posDist(-4.0f, 4.0f);
+		std::uniform_real_distribution<float> angDist(-kPi, kPi);
+		std::uniform_real_distribution<float> extDist(0.1f, 2.0f);
+		std::uniform_real_distribution<float> radiusDist(0.02f, 1.0f);
+
+		std::vector<Case> cases(kCases);
+		for (int i = 0; i < kCases; ++i) {
+			Case& c = cases[i];
+			c.oc = { posDist(rng), posDist(rng), posDist(rng) };
+			const Matrix4x4 rot = MakeRotateMatrix({ angDist(rng), angDist(rng), angDist(rng) });
+			for (int k = 0; k < 3; ++k) c.axes[k] = { rot.m[k][0], rot.m[k][1], rot.m[k][2] };
+			c.he = { extDist(rng), extDist(rng), extDist(rng) };
+			c.a = { posDist(rng), posDist(rng), posDist(rng) };
+			c.b = { posDist(rng), posDist(rng), posDist(rng) };
+			// 半数は細く長いカプセル（高速弾の掃引相当）にしてサンプリング近似のすり抜けを見る
+			c.r = (i % 2 == 0) ? radiusDist(rng) : 0.05f * radiusDist(rng);
+		}
+
+		std::vector<uint8_t> exact(kCases), sampled(kCases), reference(kCases);
+		const auto t0 = Clock::now();
+		for (int i = 0; i < kCases; ++i) {
+			const Case& c = cases[i];
+			exact[i] = CollisionNarrowphase::TestOBBCapsule(c.oc, c.axes, c.he, c.a, c.b, c.r) ? 1 : 0;
+		}
+		const auto t1 = Clock::now();
+		for (int i = 0; i < kCases; ++i) {
+			const Case& c = cases[i];
+			sampled[i] = CollisionNarrowphase::TestOBBCapsuleSampled(c.oc, c.axes, c.he, c.a, c.b, c.r) ? 1 : 0;
+		}
+		const auto t2 = Clock::now();
+		for (int i = 0; i < kCases; ++i) {
+			const Case& c = cases[i];
+			reference[i] = CollisionNarrowphase::TestOBBCapsuleSampled(c.oc, c.axes, c.he, c.a, c.b, c.r, kReferenceSamples) ? 1 : 0;
+		}
+
+		int exactMismatch = 0, sampledMiss = 0, hits = 0;
+		for (int i = 0; i < kCases; ++i) {
+			hits += reference[i];
+			// 基準値は有限サンプルなので「基準 hit なのに exact が外す」だけを誤りとして数える
+			if (reference[i] && !exact[i]) ++exactMismatch;
+			if (reference[i] && !sampled[i]) ++sampledMiss;
+		}
+
+		const double exactUs   = std::chrono::duration<double, std::micro>(t1 - t0).count() / kCases;
+		const double sampledUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / kCases;
+		char buf[224];
+		std::snprintf(buf, sizeof(buf),
+			"[Collision] OBB-Capsule %d cases (%d hits): exact %.3f us (missed %d)  sampled(6) %.3f us (missed %d)",
+			kCases, hits, exactUs, exactMismatch, sampledUs, sampledMiss);
+		LogBuffer::Instance().Add(buf, exactMismatch == 0 ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+	}
+
+	void RunNarrowphase() {
+		using Clock = std::chrono::high_resolution_clock;
+		constexpr uint32_t kColliders = 3 * 256;
+		constexpr uint32_t kLargeCount = 4093;  // 4 の倍数 + 1（端数レーンの扱いを大きな n でも通す）
+		constexpr int kTrialsPerCount = 64;
+
+		// SSE で 4 ペアずつ判定する組み合わせ。逆順（OBB-Sphere など）は a/b を入れ替えて同じカーネルに入る
+		const ShapeCombo kCombos[] = {
+			{ "Sphere-Sphere",   ColliderShape::Sphere,  ColliderShape::Sphere },
+			{ "Sphere-OBB",      ColliderShape::Sphere,  ColliderShape::OBB },
+			{ "OBB-Sphere",      ColliderShape::OBB,     ColliderShape::Sphere },
+			{ "Sphere-Capsule",  ColliderShape::Sphere,  ColliderShape::Capsule },
+			{ "Capsule-Sphere",  ColliderShape::Capsule, ColliderShape::Sphere },
+			{ "Capsule-Capsule", ColliderShape::Capsule, ColliderShape::Capsule },
+		};
+
+		std::mt19937 rng(24680u);
+		ColliderSoA soa;
+		FillRandomColliders(rng, kColliders, soa);
+
+		// 形状ごとの添字（FillRandomColliders は i % 3 で形状を決める）
+		std::vector<uint32_t> byShape[3];
+		for (uint32_t i = 0; i < kColliders; ++i) byShape[static_cast<int>(soa.shape[i])].push_back(i);
+
+		std::vector<BroadphasePair> pairs;
+		std::vector<uint8_t> simdHits;
+		std::vector<uint8_t> scalarHits;
+		auto makePairs = [&](ColliderShape sa, ColliderShape sb, uint32_t n) {
+			const std::vector<uint32_t>& listA = byShape[static_cast<int>(sa)];
+			const std::vector<uint32_t>& listB = byShape[static_cast<int>(sb)];
+			std::uniform_int_distribution<size_t> pickA(0, listA.size() - 1);
+			std::uniform_int_distribution<size_t> pickB(0, listB.size() - 1);
+			pairs.clear();
+			while (pairs.size() < n) {
+				const uint32_t a = listA[pickA(rng)];
+				const uint32_t b = listB[pickB(rng)];
+				if (a != b) pairs.push_back({ a, b });
+			}
+		};
+		auto countMismatches = [&]() {
+			CollisionNarrowphase::TestPairs(soa, pairs, simdHits);
+			uint32_t mismatches = 0;
+			for (size_t k = 0; k < pairs.size(); ++k) {
+				const bool scalar = CollisionNarrowphase::TestPairScalar(soa, pairs[k].first, pairs[k].second);
+				if (scalar != (simdHits[k] != 0)) ++mismatches;
+			}
+			return mismatches;
+		};
+
+		LogBuffer::Instance().Add("[Collision] Narrowphase SSE vs scalar (TestPairs vs TestPairScalar, n = 1..9 and 4093 pairs)");
+		char buf[224];
+		bool allMatch = true;
+		for (const ShapeCombo& combo : kCombos) {
+			// 照合：端数レーン（n % 4 != 0）を含む小さな n と、大きな n
+			uint32_t checked = 0;
+			uint32_t mismatches = 0;
+			for (uint32_t n = 1; n <= 9; ++n) {
+				for (int trial = 0; trial < kTrialsPerCount; ++trial) {
+					makePairs(combo.a, combo.b, n);
+					mismatches += countMismatches();
+					checked += n;
+				}
+			}
+			makePairs(combo.a, combo.b, kLargeCount);
+			mismatches += countMismatches();
+			checked += kLargeCount;
+
+			// 速さ：大きな n のペア列をそのまま SSE / スカラーで
+			uint32_t hits = 0;
+			for (uint8_t h : simdHits) hits += h;
+			constexpr int kReps = 50;
+			const auto t0 = Clock::now();
+			for (int r = 0; r < kReps; ++r) CollisionNarrowphase::TestPairs(soa, pairs, simdHits);
+			const auto t1 = Clock::now();
+			scalarHits.resize(pairs.size());
+			for (int r = 0; r < kReps; ++r) {
+				for (size_t k = 0; k < pairs.size(); ++k) {
+					scalarHits[k] = CollisionNarrowphase::TestPairScalar(soa, pairs[k].first, pairs[k].second) ? 1 : 0;
+				}
+			}
+			const auto t2 = Clock::now();
+			const double simdNs   = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(kReps) * pairs.size());
+			const double scalarNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (double(kReps) * pairs.size());
+
+			allMatch = allMatch && mismatches == 0;
+			std::snprintf(buf, sizeof(buf),
+				"[Collision]  %-15s %6u pairs checked  mismatches %u  |  %u hits / %u: SSE %.1f ns  scalar %.1f ns per pair (x%.1f)",
+				combo.name, checked, mismatches, hits, kLargeCount, simdNs, scalarNs, (simdNs > 0.0) ? scalarNs / simdNs : 0.0);
+			LogBuffer::Instance().Add(buf, mismatches == 0 ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+		}
+
+		// 全形状を混ぜたペア列（仕分け + スカラー経路の OBB-OBB / OBB-Capsule も含めて TestPairs 全体）
+		{
+			std::uniform_int_distribution<uint32_t> pick(0, kColliders - 1);
+			pairs.clear();
+			while (pairs.size() < kLargeCount) {
+				const uint32_t a = pick(rng);
+				const uint32_t b = pick(rng);
+				if (a != b) pairs.push_back({ std::min(a, b), std::max(a, b) });
+			}
+			const uint32_t mismatches = countMismatches();
+			allMatch = allMatch && mismatches == 0;
+			std::snprintf(buf, sizeof(buf), "[Collision]  %-15s %6u pairs checked  mismatches %u", "mixed", kLargeCount, mismatches);
+			LogBuffer::Instance().Add(buf, mismatches == 0 ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+		}
+		LogBuffer::Instance().Add(allMatch ? "[Collision] Narrowphase SSE matches scalar" : "[Collision] Narrowphase SSE MISMATCH",
+			allMatch ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+	}
+
+} // namespace CollisionBenchmark
@@ -0,0 +1,29 @@
+#pragma once
+
+/// <summary>
+/// 当たり判定のベンチマーク。合成データだけで回し、エンティティ・描画・GPU に触れないので
+/// ゲーム本体（CollisionManager / Benchmarks ウィンドウ）からも headless_bench からも呼べる。
+/// 結果は LogBuffer に出し、不一致はエラーで出す。ゲームの RandomGenerator は使わない（リプレイの乱数列を乱さない）。
+/// </summary>
+namespace CollisionBenchmark {
+
+	/// <summary>
+	/// 合成データ（100〜10000 コライダー）で空間ハッシュと総当たりのブロードフェーズを計測し、
+	/// 候補ペアが一致するかも検証する。cellSize は空間ハッシュのセルの一辺。
+	/// </summary>
+	void RunBroadphase(float cellSize);
+
+	/// <summary>
+	/// OBB-Capsule の厳密判定（CollisionNarrowphase::TestOBBCapsule）を、旧サンプリング近似と
+	/// 密サンプリングの基準値に対してランダム入力で検証・計測する。
+	/// </summary>
+	void RunOBBCapsule();
+
+	/// <summary>
+	/// SSE で 4 ペアずつ判定する 4 組（Sphere-Sphere / Sphere-OBB / Sphere-Capsule / Capsule-Capsule、逆順も）について、
+	/// ランダムなペア列を TestPairs と TestPairScalar で判定して結果を突き合わせ、速さも比べる。
+	/// ペア数は 1〜9 と 4093 で、4 の倍数でない端数レーンも通す。最後に全形状を混ぜた列でも照合する。
+	/// </summary>
+	void RunNarrowphase();
+
+} // namespace CollisionBenchmark
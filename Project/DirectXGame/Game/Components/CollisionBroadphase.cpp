@@ -0,0 +1,141 @@
+#include "CollisionBroadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// セル座標 1 軸あたり 21bit（±約 100 万セル）。3 軸で 63bit に詰める。
+	constexpr int32_t kCellCoordLimit = (1 << 20) - 1;
+	constexpr uint64_t kCellCoordMask = (1ull << 21) - 1;
+}
+
+void SpatialHashBroadphase::SetCellSize(float size) {
+	if (!(size > 0.01f)) size = 0.01f;
+	cellSize_ = size;
+	invCellSize_ = 1.0f / size;
+}
+
+int32_t SpatialHashBroadphase::ToCell(float v) const {
+	float c = std::floor(v * invCellSize_);
+	// NaN / 極端な座標はグリッド端に寄せる（キーのビット溢れ防止）
+	if (!(c > -static_cast<float>(kCellCoordLimit))) return -kCellCoordLimit;
+	if (c > static_cast<float>(kCellCoordLimit)) return kCellCoordLimit;
+	return static_cast<int32_t>(c);
+}
+
+uint64_t SpatialHashBroadphase::PackKey(int32_t x, int32_t y, int32_t z) {
+	const uint64_t ux = static_cast<uint64_t>(x + kCellCoordLimit) & kCellCoordMask;
+	const uint64_t uy = static_cast<uint64_t>(y + kCellCoordLimit) & kCellCoordMask;
+	const uint64_t uz = static_cast<uint64_t>(z + kCellCoordLimit) & kCellCoordMask;
+	return (ux << 42) | (uy << 21) | uz;
+}
+
+void SpatialHashBroadphase::FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& outPairs) {
+	outPairs.clear();
+	entries_.clear();
+	large_.clear();
+	stats_ = {};
+
+	const uint32_t n = static_cast<uint32_t>(proxies.size());
+	stats_.proxyCount = n;
+	isLarge_.assign(n, 0);
+
+	//==================== セル登録 ====================
+	for (uint32_t i = 0; i < n; ++i) {
+		const BroadphaseProxy& p = proxies[i];
+		if (p.collideMask == 0) continue; // 誰とも当たらないタグはグリッドに入れない
+
+		const int32_t x0 = ToCell(p.min.x), x1 = ToCell(p.max.x);
+		const int32_t y0 = ToCell(p.min.y), y1 = ToCell(p.max.y);
+		const int32_t z0 = ToCell(p.min.z), z1 = ToCell(p.max.z);
+		const uint64_t cells = static_cast<uint64_t>(x1 - x0 + 1)
+			* static_cast<uint64_t>(y1 - y0 + 1)
+			* static_cast<uint64_t>(z1 - z0 + 1);
+		if (cells > maxCellsPerProxy_) {
+			isLarge_[i] = 1;
+			large_.push_back(i);
+			continue;
+		}
+		for (int32_t x = x0; x <= x1; ++x) {
+			for (int32_t y = y0; y <= y1; ++y) {
+				for (int32_t z = z0; z <= z1; ++z) {
+					entries_.push_back({ PackKey(x, y, z), i });
+				}
+			}
+		}
+	}
+	stats_.largeProxyCount = static_cast<uint32_t>(large_.size());
+	stats_.cellEntryCount = static_cast<uint32_t>(entries_.size());
+
+	std::sort(entries_.begin(), entries_.end(), [](const CellEntry& a, const CellEntry& b) {
+		return (a.key != b.key) ? (a.key < b.key) : (a.index < b.index);
+	});
+
+	//==================== バケット内ペア ====================
+	const size_t entryCount = entries_.size();
+	size_t begin = 0;
+	while (begin < entryCount) {
+		const uint64_t key = entries_[begin].key;
+		size_t end = begin + 1;
+		uint32_t tagBits = proxies[entries_[begin].index].tagBit;
+		uint32_t maskBits = proxies[entries_[begin].index].collideMask;
+		while (end < entryCount && entries_[end].key == key) {
+			tagBits  |= proxies[entries_[end].index].tagBit;
+			maskBits |= proxies[entries_[end].index].collideMask;
+			++end;
+		}
+		++stats_.bucketCount;
+
+		// バケット単位のタグフィルタ：このセルに居るタグ同士で当たり得る組が無ければ丸ごと飛ばす
+		if ((end - begin) < 2 || (tagBits & maskBits) == 0) {
+			if ((end - begin) >= 2) ++stats_.skippedBuckets;
+			begin = end;
+			continue;
+		}
+
+		for (size_t a = begin; a < end; ++a) {
+			const uint32_t ia = entries_[a].index;
+			const BroadphaseProxy& pa = proxies[ia];
+			for (size_t b = a + 1; b < end; ++b) {
+				const uint32_t ib = entries_[b].index;
+				const BroadphaseProxy& pb = proxies[ib];
+				if (!IsCandidate(pa, pb)) continue;
+
+				// 重なり領域の最小角が属するセルでだけ採用（複数セルでの重複検出を除去）
+				const int32_t cx = ToCell(std::max(pa.min.x, pb.min.x));
+				const int32_t cy = ToCell(std::max(pa.min.y, pb.min.y));
+				const int32_t cz = ToCell(std::max(pa.min.z, pb.min.z));
+				if (PackKey(cx, cy, cz) != key) continue;
+
+				outPairs.emplace_back(ia, ib); // entries_ は index 昇順なので ia < ib
+			}
+		}
+		begin = end;
+	}
+
+	//==================== 巨大 proxy は総当たり ====================
+	for (uint32_t l : large_) {
+		const BroadphaseProxy& pl = proxies[l];
+		for (uint32_t j = 0; j < n; ++j) {
+			if (j == l) continue;
+			// 巨大同士は index の小さい側からだけ数える
+			if (isLarge_[j] && j < l) continue;
+			if (!IsCandidate(pl, proxies[j])) continue;
+			outPairs.emplace_back(std::min(l, j), std::max(l, j));
+		}
+	}
+
+	// 総当たりと同じ (i, j) 昇順に揃える（onCollision / ダメージ適用順を登録順のまま保つ）
+	std::sort(outPairs.begin(), outPairs.end());
+	stats_.candidatePairs = static_cast<uint32_t>(outPairs.size());
+}
+
+void SpatialHashBroadphase::FindPairsBruteForce(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& outPairs) {
+	outPairs.clear();
+	const uint32_t n = static_cast<uint32_t>(proxies.size());
+	for (uint32_t i = 0; i < n; ++i) {
+		for (uint32_t j = i + 1; j < n; ++j) {
+			if (IsCandidate(proxies[i], proxies[j])) outPairs.emplace_back(i, j);
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Vector3.h"
+
+/// <summary>
+/// ブロードフェーズに渡す 1 コライダー分の情報。
+/// ワールド AABB と、タグのビット（1 << EntityTag）・衝突相手タグのマスクだけを持つ。
+/// </summary>
+struct BroadphaseProxy {
+	Vector3  min{};
+	Vector3  max{};
+	uint32_t tagBit = 0;      // 自分のタグ（1 << tag）
+	uint32_t collideMask = 0; // 判定相手になり得るタグの OR
+};
+
+/// <summary>
+/// 候補ペア（proxy のインデックス。first < second）。
+/// </summary>
+using BroadphasePair = std::pair<uint32_t, uint32_t>;
+
+/// <summary>
+/// 一様グリッドの空間ハッシュによるブロードフェーズ。
+/// 各 proxy の AABB が掛かるセルを (セルキー, index) で列挙→ソートしてバケット化し、
+/// 同じバケット内のペアだけを候補にする。
+/// ・セルを跨ぐ proxy の重複ペアは「2 つの AABB の重なり領域の最小角が属するセル」でだけ採用して除去
+/// ・バケット内に衝突し得るタグの組が無ければバケットごとスキップ（タグフィルタをバケット単位で先に掛ける）
+/// ・掛かるセル数が多すぎる巨大 proxy（地形など）はグリッドに入れず、全 proxy と総当たりする
+/// 出力ペアは (first, second) 昇順にソート済みで、総当たりと同じ順序になる（コールバック順の決定性を保つ）。
+/// エンジン/GPU に依存しないので、単体でベンチマークできる。
+/// </summary>
+class SpatialHashBroadphase {
+public:
+	struct Stats {
+		uint32_t proxyCount = 0;
+		uint32_t largeProxyCount = 0;  // グリッドに入れず総当たりした proxy
+		uint32_t cellEntryCount = 0;   // (セル, proxy) の登録数
+		uint32_t bucketCount = 0;      // 空でないセル数
+		uint32_t skippedBuckets = 0;   // タグフィルタで丸ごと飛ばしたセル数
+		uint32_t candidatePairs = 0;   // 出力した候補ペア数
+	};
+
+	/// <summary>セルの一辺（ワールド単位）。弾〜雑魚敵の直径程度が目安。</summary>
+	void SetCellSize(float size);
+	float GetCellSize() const { return cellSize_; }
+
+	/// <summary>1 proxy が掛かってよいセル数の上限。超えたものは巨大 proxy 扱い。</summary>
+	void SetMaxCellsPerProxy(uint32_t n) { maxCellsPerProxy_ = n; }
+	uint32_t GetMaxCellsPerProxy() const { return maxCellsPerProxy_; }
+
+	/// <summary>
+	/// AABB が重なり、かつタグマスク上判定し得るペアを outPairs に列挙する（outPairs は上書き）。
+	/// </summary>
+	void FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& outPairs);
+
+	/// <summary>
+	/// 比較用の総当たり実装。結果は FindPairs と同一集合・同一順序。
+	/// </summary>
+	static void FindPairsBruteForce(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& outPairs);
+
+	/// <summary>AABB の重なり＋タグマスク判定（両方向のどちらかで許可されていれば候補）。</summary>
+	static bool IsCandidate(const BroadphaseProxy& a, const BroadphaseProxy& b) {
+		if ((a.collideMask & b.tagBit) == 0 && (b.collideMask & a.tagBit) == 0) return false;
+		return a.min.x <= b.max.x && b.min.x <= a.max.x
+			&& a.min.y <= b.max.y && b.min.y <= a.max.y
+			&& a.min.z <= b.max.z && b.min.z <= a.max.z;
+	}
+
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	struct CellEntry {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	int32_t ToCell(float v) const;
+	static uint64_t PackKey(int32_t x, int32_t y, int32_t z);
+
+	float    cellSize_ = 4.0f;
+	float    invCellSize_ = 0.25f;
+	uint32_t maxCellsPerProxy_ = 64;
+
+	// フレームを跨いで容量を使い回す作業領域
+	std::vector<CellEntry> entries_;
+	std::vector<uint32_t>  large_;
+	std::vector<uint8_t>   isLarge_;
+
+	Stats stats_{};
+};
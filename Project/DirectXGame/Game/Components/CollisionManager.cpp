@@ -3,10 +3,13 @@
 
 #include "IImGuiEditable.h"
 #include "SphereCollider.h"
+#include "CollisionBenchmark.h"
 #include "CollisionMatrix.h"
+#include "CollisionNarrowphase.h"
 #include "EntityTag.h"
 #include "Primitive/DebugDraw.h"
 #include "MathUtility.h"
+#include "PepperMacros.h"
 
 #include <algorithm>
 #include <cmath>
@@ -35,10 +38,8 @@ namespace {
 		Vector3 axes[3];  // 0=X, 1=Y, 2=Z（オーナーのオイラー回転に対応）
 	};
 
-	inline float Dot3(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
 	inline Vector3 SubV(const Vector3& a, const Vector3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
 	inline Vector3 AddV(const Vector3& a, const Vector3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
-	inline Vector3 MulS(const Vector3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
 
 	// オーナーの translate + offset を中心、オイラー rotate から軸を取り出して入れる
 	bool TryGetWorldData(IImGuiEditable* e, const Collider& c, WorldData& out) {
@@ -59,265 +60,158 @@ namespace {
 		return true;
 	}
 
-	// 点 p に最も近い OBB 上の点
-	Vector3 ClosestPointOnOBB(const Vector3& p, const Vector3& obbCenter,
-		const Vector3 axes[3], const Vector3& halfExtents)
-	{
-		Vector3 d = SubV(p, obbCenter);
-		Vector3 result = obbCenter;
-		const float halfArr[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
-		for (int i = 0; i < 3; ++i) {
-			float dist = Dot3(d, axes[i]);
-			dist = std::clamp(dist, -halfArr[i], halfArr[i]);
-			result = AddV(result, MulS(axes[i], dist));
-		}
-		return result;
-	}
-
-	Vector3 ClosestPointOnSegment(const Vector3& a, const Vector3& b, const Vector3& p) {
-		Vector3 ab = SubV(b, a);
-		float denom = Dot3(ab, ab);
-		if (denom < 1e-6f) return a;
-		float t = std::clamp(Dot3(SubV(p, a), ab) / denom, 0.0f, 1.0f);
-		return AddV(a, MulS(ab, t));
-	}
+	// Update 1 回分の判定対象。Gameplay::Of の引き直しとワールド姿勢の再計算をペアごとにしないよう、
+	// フレーム頭で 1 エンティティ 1 回だけ解決し、姿勢は g_soa に詰める（添字は g_bodies と共通）。
+	struct Body {
+		IImGuiEditable*     entity;
+		GameplayComponents* gameplay;
+	};
 
-	// セグメント間最短距離（Christer Ericson）
-	float SegmentSegmentDistSq(
-		const Vector3& p1, const Vector3& q1,
-		const Vector3& p2, const Vector3& q2)
-	{
-		Vector3 d1 = SubV(q1, p1);
-		Vector3 d2 = SubV(q2, p2);
-		Vector3 r  = SubV(p1, p2);
-		float a = Dot3(d1, d1);
-		float e = Dot3(d2, d2);
-		float f = Dot3(d2, r);
-		const float eps = 1e-6f;
-		float s = 0.0f, t = 0.0f;
+	// CollisionManager はシングルトンなので作業領域もファイル内で持ち、容量をフレーム間で使い回す
+	std::vector<Body>            g_bodies;
+	ColliderSoA                  g_soa;
+	std::vector<BroadphaseProxy> g_proxies;
+	std::vector<BroadphasePair>  g_pairs;
+	std::vector<uint8_t>         g_hits;
 
-		if (a <= eps && e <= eps) {
-			Vector3 dd = SubV(p1, p2);
-			return Dot3(dd, dd);
+	// 形状ごとのワールド AABB（中心からの半幅）
+	Vector3 ComputeHalfBounds(const Collider& c, const WorldData& w) {
+		switch (c.shape) {
+		case ColliderShape::Sphere:
+			return { c.radius, c.radius, c.radius };
+		case ColliderShape::OBB: {
+			const Vector3& he = c.halfExtents;
+			return {
+				std::fabs(w.axes[0].x) * he.x + std::fabs(w.axes[1].x) * he.y + std::fabs(w.axes[2].x) * he.z,
+				std::fabs(w.axes[0].y) * he.x + std::fabs(w.axes[1].y) * he.y + std::fabs(w.axes[2].y) * he.z,
+				std::fabs(w.axes[0].z) * he.x + std::fabs(w.axes[1].z) * he.y + std::fabs(w.axes[2].z) * he.z,
+			};
 		}
-		if (a <= eps) {
-			t = std::clamp(f / e, 0.0f, 1.0f);
-		} else {
-			float c = Dot3(d1, r);
-			if (e <= eps) {
-				s = std::clamp(-c / a, 0.0f, 1.0f);
-				t = 0.0f;
-			} else {
-				float b = Dot3(d1, d2);
-				float denom = a * e - b * b;
-				s = (denom != 0.0f)
-					? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f)
-					: 0.0f;
-				t = (b * s + f) / e;
-				if (t < 0.0f) { t = 0.0f; s = std::clamp(-c / a, 0.0f, 1.0f); }
-				else if (t > 1.0f) { t = 1.0f; s = std::clamp((b - c) / a, 0.0f, 1.0f); }
-			}
+		case ColliderShape::Capsule: {
+			const float half = 0.5f * c.capsuleHeight;
+			const float r = c.capsuleRadius;
+			return {
+				std::fabs(w.axes[1].x) * half + r,
+				std::fabs(w.axes[1].y) * half + r,
+				std::fabs(w.axes[1].z) * half + r,
+			};
 		}
-		Vector3 c1 = AddV(p1, MulS(d1, s));
-		Vector3 c2 = AddV(p2, MulS(d2, t));
-		Vector3 dd = SubV(c1, c2);
-		return Dot3(dd, dd);
-	}
-
-	bool TestSphereSphere(const Vector3& ca, float ra, const Vector3& cb, float rb) {
-		Vector3 d = SubV(ca, cb);
-		float sumR = ra + rb;
-		return Dot3(d, d) <= sumR * sumR;
-	}
-
-	bool TestSphereOBB(const Vector3& sc, float sr,
-		const Vector3& oc, const Vector3 axes[3], const Vector3& he)
-	{
-		Vector3 q = ClosestPointOnOBB(sc, oc, axes, he);
-		Vector3 d = SubV(sc, q);
-		return Dot3(d, d) <= sr * sr;
+		}
+		return { 0.0f, 0.0f, 0.0f };
 	}
 
-	bool TestSphereCapsule(const Vector3& sc, float sr,
-		const Vector3& cc, const Vector3 axes[3], float h, float cr)
-	{
-		float half = 0.5f * h;
-		Vector3 a = AddV(cc, MulS(axes[1], +half));
-		Vector3 b = AddV(cc, MulS(axes[1], -half));
-		Vector3 q = ClosestPointOnSegment(a, b, sc);
-		Vector3 d = SubV(sc, q);
-		float sum = sr + cr;
-		return Dot3(d, d) <= sum * sum;
+	BroadphaseProxy MakeProxy(const Vector3& center, const Vector3& half, EntityTag tag) {
+		BroadphaseProxy p;
+		p.min = SubV(center, half);
+		p.max = AddV(center, half);
+		p.tagBit = 1u << static_cast<uint32_t>(tag);
+		p.collideMask = CollisionMatrix::CollideMask(tag);
+		return p;
 	}
+}
 
-	bool TestCapsuleCapsule(
-		const Vector3& cA, const Vector3 axA[3], float hA, float rA,
-		const Vector3& cB, const Vector3 axB[3], float hB, float rB)
-	{
-		float halfA = 0.5f * hA;
-		float halfB = 0.5f * hB;
-		Vector3 a0 = AddV(cA, MulS(axA[1], +halfA));
-		Vector3 a1 = AddV(cA, MulS(axA[1], -halfA));
-		Vector3 b0 = AddV(cB, MulS(axB[1], +halfB));
-		Vector3 b1 = AddV(cB, MulS(axB[1], -halfB));
-		float distSq = SegmentSegmentDistSq(a0, a1, b0, b1);
-		float sum = rA + rB;
-		return distSq <= sum * sum;
-	}
+void CollisionManager::Update() {
+	PEPPER_SCOPE("CollisionManager::Update");
 
-	// SAT による OBB-OBB（標準 15 軸テスト）
-	bool TestOBBOBB(const Vector3& cA, const Vector3 axA[3], const Vector3& heA,
-		const Vector3& cB, const Vector3 axB[3], const Vector3& heB)
-	{
-		const float eps = 1e-6f;
-		float R[3][3];
-		float AbsR[3][3];
-		for (int i = 0; i < 3; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				R[i][j] = Dot3(axA[i], axB[j]);
-				AbsR[i][j] = std::fabs(R[i][j]) + eps;
-			}
+	//==================== 判定対象の収集 ====================
+	g_bodies.clear();
+	g_soa.Clear();
+	g_proxies.clear();
+	frameStats_.sweptBodies = 0;
+	for (IImGuiEditable* e : entities_) {
+		if (!e) continue;
+		GameplayComponents& gp = Gameplay::Of(e);
+		Collider& c = gp.GetCollider();
+		c.isCollidingThisFrame = false;
+		const EntityTag tag = gp.GetTag();
+		WorldData world;
+		if (!c.enabled || !CollisionMatrix::IsCollidableTag(tag) || !TryGetWorldData(e, c, world)) {
+			// 判定から外れた間の移動は掃引しない（再有効化フレームで遠くから線を引かないように）
+			c.hasPrevCenter = false;
+			continue;
 		}
-		Vector3 tWorld = SubV(cB, cA);
-		float t[3] = {
-			Dot3(tWorld, axA[0]),
-			Dot3(tWorld, axA[1]),
-			Dot3(tWorld, axA[2])
-		};
-		const float aE[3] = { heA.x, heA.y, heA.z };
-		const float bE[3] = { heB.x, heB.y, heB.z };
 
-		// L = A axes
-		for (int i = 0; i < 3; ++i) {
-			float ra = aE[i];
-			float rb = bE[0] * AbsR[i][0] + bE[1] * AbsR[i][1] + bE[2] * AbsR[i][2];
-			if (std::fabs(t[i]) > ra + rb) return false;
-		}
-		// L = B axes
-		for (int j = 0; j < 3; ++j) {
-			float ra = aE[0] * AbsR[0][j] + aE[1] * AbsR[1][j] + aE[2] * AbsR[2][j];
-			float rb = bE[j];
-			if (std::fabs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb) return false;
+		// 連続判定：1 フレームの移動が半径を超えた球は、前フレーム位置からの掃引球（Capsule）で判定する
+		const Vector3 move = SubV(world.center, c.prevCenter);
+		const bool swept = c.continuous && c.shape == ColliderShape::Sphere && c.hasPrevCenter
+			&& (move.x * move.x + move.y * move.y + move.z * move.z) > c.radius * c.radius;
+		if (swept) {
+			g_soa.PushSweptSphere(c.prevCenter, world.center, c.radius);
+			BroadphaseProxy proxy = MakeProxy(world.center, { c.radius, c.radius, c.radius }, tag);
+			proxy.min = { std::min(proxy.min.x, c.prevCenter.x - c.radius), std::min(proxy.min.y, c.prevCenter.y - c.radius), std::min(proxy.min.z, c.prevCenter.z - c.radius) };
+			proxy.max = { std::max(proxy.max.x, c.prevCenter.x + c.radius), std::max(proxy.max.y, c.prevCenter.y + c.radius), std::max(proxy.max.z, c.prevCenter.z + c.radius) };
+			g_proxies.push_back(proxy);
+			++frameStats_.sweptBodies;
+		} else {
+			g_soa.Push(c, world.center, world.axes);
+			g_proxies.push_back(MakeProxy(world.center, ComputeHalfBounds(c, world), tag));
 		}
-		// L = A0 x B0..B2
-		{ float ra = aE[1]*AbsR[2][0] + aE[2]*AbsR[1][0]; float rb = bE[1]*AbsR[0][2] + bE[2]*AbsR[0][1];
-		  if (std::fabs(t[2]*R[1][0] - t[1]*R[2][0]) > ra+rb) return false; }
-		{ float ra = aE[1]*AbsR[2][1] + aE[2]*AbsR[1][1]; float rb = bE[0]*AbsR[0][2] + bE[2]*AbsR[0][0];
-		  if (std::fabs(t[2]*R[1][1] - t[1]*R[2][1]) > ra+rb) return false; }
-		{ float ra = aE[1]*AbsR[2][2] + aE[2]*AbsR[1][2]; float rb = bE[0]*AbsR[0][1] + bE[1]*AbsR[0][0];
-		  if (std::fabs(t[2]*R[1][2] - t[1]*R[2][2]) > ra+rb) return false; }
-		// L = A1 x B0..B2
-		{ float ra = aE[0]*AbsR[2][0] + aE[2]*AbsR[0][0]; float rb = bE[1]*AbsR[1][2] + bE[2]*AbsR[1][1];
-		  if (std::fabs(t[0]*R[2][0] - t[2]*R[0][0]) > ra+rb) return false; }
-		{ float ra = aE[0]*AbsR[2][1] + aE[2]*AbsR[0][1]; float rb = bE[0]*AbsR[1][2] + bE[2]*AbsR[1][0];
-		  if (std::fabs(t[0]*R[2][1] - t[2]*R[0][1]) > ra+rb) return false; }
-		{ float ra = aE[0]*AbsR[2][2] + aE[2]*AbsR[0][2]; float rb = bE[0]*AbsR[1][1] + bE[1]*AbsR[1][0];
-		  if (std::fabs(t[0]*R[2][2] - t[2]*R[0][2]) > ra+rb) return false; }
-		// L = A2 x B0..B2
-		{ float ra = aE[0]*AbsR[1][0] + aE[1]*AbsR[0][0]; float rb = bE[1]*AbsR[2][2] + bE[2]*AbsR[2][1];
-		  if (std::fabs(t[1]*R[0][0] - t[0]*R[1][0]) > ra+rb) return false; }
-		{ float ra = aE[0]*AbsR[1][1] + aE[1]*AbsR[0][1]; float rb = bE[0]*AbsR[2][2] + bE[2]*AbsR[2][0];
-		  if (std::fabs(t[1]*R[0][1] - t[0]*R[1][1]) > ra+rb) return false; }
-		{ float ra = aE[0]*AbsR[1][2] + aE[1]*AbsR[0][2]; float rb = bE[0]*AbsR[2][1] + bE[1]*AbsR[2][0];
-		  if (std::fabs(t[1]*R[0][2] - t[0]*R[1][2]) > ra+rb) return false; }
-		return true;
+		g_bodies.push_back({ e, &gp });
+		c.prevCenter = world.center;
+		c.hasPrevCenter = true;
 	}
 
-	// OBB-Capsule（近似）：線分を N サンプリングして Sphere-OBB 判定
-	bool TestOBBCapsule(
-		const Vector3& oc, const Vector3 oax[3], const Vector3& he,
-		const Vector3& cc, const Vector3 cax[3], float h, float cr)
+	//==================== ブロードフェーズ ====================
 	{
-		float half = 0.5f * h;
-		Vector3 a = AddV(cc, MulS(cax[1], +half));
-		Vector3 b = AddV(cc, MulS(cax[1], -half));
-		constexpr int N = 6;
-		for (int i = 0; i <= N; ++i) {
-			float t = static_cast<float>(i) / static_cast<float>(N);
-			Vector3 p = AddV(a, MulS(SubV(b, a), t));
-			if (TestSphereOBB(p, cr, oc, oax, he)) return true;
+		PEPPER_SCOPE("CollisionManager::Broadphase");
+		if (broadphaseMode_ == BroadphaseMode::SpatialHash) {
+			broadphase_.FindPairs(g_proxies, g_pairs);
+		} else {
+			SpatialHashBroadphase::FindPairsBruteForce(g_proxies, g_pairs);
 		}
-		return false;
 	}
 
-	bool TestPair(const Collider& ca, const WorldData& wA,
-		const Collider& cb, const WorldData& wB)
-	{
-		switch (ca.shape) {
-		case ColliderShape::Sphere:
-			switch (cb.shape) {
-			case ColliderShape::Sphere:  return TestSphereSphere(wA.center, ca.radius, wB.center, cb.radius);
-			case ColliderShape::OBB:     return TestSphereOBB(wA.center, ca.radius, wB.center, wB.axes, cb.halfExtents);
-			case ColliderShape::Capsule: return TestSphereCapsule(wA.center, ca.radius, wB.center, wB.axes, cb.capsuleHeight, cb.capsuleRadius);
-			} break;
-		case ColliderShape::OBB:
-			switch (cb.shape) {
-			case ColliderShape::Sphere:  return TestSphereOBB(wB.center, cb.radius, wA.center, wA.axes, ca.halfExtents);
-			case ColliderShape::OBB:     return TestOBBOBB(wA.center, wA.axes, ca.halfExtents, wB.center, wB.axes, cb.halfExtents);
-			case ColliderShape::Capsule: return TestOBBCapsule(wA.center, wA.axes, ca.halfExtents, wB.center, wB.axes, cb.capsuleHeight, cb.capsuleRadius);
-			} break;
-		case ColliderShape::Capsule:
-			switch (cb.shape) {
-			case ColliderShape::Sphere:  return TestSphereCapsule(wB.center, cb.radius, wA.center, wA.axes, ca.capsuleHeight, ca.capsuleRadius);
-			case ColliderShape::OBB:     return TestOBBCapsule(wB.center, wB.axes, cb.halfExtents, wA.center, wA.axes, ca.capsuleHeight, ca.capsuleRadius);
-			case ColliderShape::Capsule: return TestCapsuleCapsule(wA.center, wA.axes, ca.capsuleHeight, ca.capsuleRadius, wB.center, wB.axes, cb.capsuleHeight, cb.capsuleRadius);
-			} break;
-		}
-		return false;
-	}
-}
+	frameStats_.bodies = static_cast<uint32_t>(g_bodies.size());
+	frameStats_.candidatePairs = static_cast<uint32_t>(g_pairs.size());
+	frameStats_.hits = 0;
+	PEPPER_COUNT_N("CollisionCandidatePairs", static_cast<int64_t>(g_pairs.size()));
 
-void CollisionManager::Update() {
-	for (IImGuiEditable* e : entities_) {
-		if (e) Gameplay::Of(e).GetCollider().isCollidingThisFrame = false;
+	//==================== 詳細判定（候補ペアのみ、SoA をまとめて判定） ====================
+	{
+		PEPPER_SCOPE("CollisionManager::Narrowphase");
+		CollisionNarrowphase::TestPairs(g_soa, g_pairs, g_hits);
 	}
 
-	const size_t n = entities_.size();
-	for (size_t i = 0; i < n; ++i) {
-		IImGuiEditable* a = entities_[i];
-		if (!a) continue;
-		Collider& ca = Gameplay::Of(a).GetCollider();
-		if (!ca.enabled) continue;
-		EntityTag ta = Gameplay::Of(a).GetTag();
-		if (!CollisionMatrix::IsCollidableTag(ta)) continue;
-
-		WorldData wA;
-		if (!TryGetWorldData(a, ca, wA)) continue;
-
-		for (size_t j = i + 1; j < n; ++j) {
-			IImGuiEditable* b = entities_[j];
-			if (!b) continue;
-			Collider& cb = Gameplay::Of(b).GetCollider();
-			if (!cb.enabled) continue;
-			EntityTag tb = Gameplay::Of(b).GetTag();
-
-			if (!CollisionMatrix::ShouldCollide(ta, tb)) continue;
-
-			WorldData wB;
-			if (!TryGetWorldData(b, cb, wB)) continue;
-
-			if (TestPair(ca, wA, cb, wB)) {
-				ca.isCollidingThisFrame = true;
-				cb.isCollidingThisFrame = true;
-
-				// ----- 共通ダメージ交換 -----
-				// CollisionMatrix::ShouldCollide で既にフレンドリーファイア等は除外されている前提。
-				// DamageDealer 側の damage を HP 側に適用する。両方向に成立しうる（突進敵がプレイヤーに突っ込み、
-				// 同時にプレイヤーが近接でカウンターしているケース等）。
-				{
-					DamageDealer& dda = Gameplay::Of(a).GetDamageDealer();
-					HP&           hpb = Gameplay::Of(b).GetHP();
-					if (dda.enabled && hpb.enabled) hpb.TakeDamage(dda.damage);
-
-					DamageDealer& ddb = Gameplay::Of(b).GetDamageDealer();
-					HP&           hpa = Gameplay::Of(a).GetHP();
-					if (ddb.enabled && hpa.enabled) hpa.TakeDamage(ddb.damage);
-				}
-
-				if (ca.onCollision) ca.onCollision(b);
-				if (cb.onCollision) cb.onCollision(a);
-			}
+	//==================== 応答（ペア順＝登録順で発火） ====================
+	// 先行ペアのコールバックで無効化されたコライダーの扱いは旧来の総当たりループと同じにする：
+	// first 側は外側ループに入った時点（first が切り替わった最初のペア）で 1 回だけ enabled を見て、
+	// そのまとまりの途中で無効化されても残りのペアは判定を続ける。second 側はペアごとに見る。
+	uint32_t currentFirst = UINT32_MAX;
+	bool     firstEnabled = false;
+	for (size_t k = 0; k < g_pairs.size(); ++k) {
+		if (g_pairs[k].first != currentFirst) {
+			currentFirst = g_pairs[k].first;
+			firstEnabled = g_bodies[currentFirst].gameplay->GetCollider().enabled;
 		}
+		if (!g_hits[k] || !firstEnabled) continue;
+		const Body& bodyA = g_bodies[g_pairs[k].first];
+		const Body& bodyB = g_bodies[g_pairs[k].second];
+		IImGuiEditable* a = bodyA.entity;
+		IImGuiEditable* b = bodyB.entity;
+		Collider& ca = bodyA.gameplay->GetCollider();
+		Collider& cb = bodyB.gameplay->GetCollider();
+		if (!cb.enabled) continue;
+
+		++frameStats_.hits;
+		ca.isCollidingThisFrame = true;
+		cb.isCollidingThisFrame = true;
+
+		// ----- 共通ダメージ交換 -----
+		// CollisionMatrix::ShouldCollide で既にフレンドリーファイア等は除外されている前提。
+		// DamageDealer 側の damage を HP 側に適用する。両方向に成立しうる（突進敵がプレイヤーに突っ込み、
+		// 同時にプレイヤーが近接でカウンターしているケース等）。
+		{
+			DamageDealer& dda = bodyA.gameplay->GetDamageDealer();
+			HP&           hpb = bodyB.gameplay->GetHP();
+			if (dda.enabled && hpb.enabled) hpb.TakeDamage(dda.damage);
+
+			DamageDealer& ddb = bodyB.gameplay->GetDamageDealer();
+			HP&           hpa = bodyA.gameplay->GetHP();
+			if (ddb.enabled && hpa.enabled) hpa.TakeDamage(ddb.damage);
+		}
+
+		if (ca.onCollision) ca.onCollision(b);
+		if (cb.onCollision) cb.onCollision(a);
 	}
 
 #ifdef _DEBUG
@@ -325,6 +219,15 @@ void CollisionManager::Update() {
 #endif
 }
 
+void CollisionManager::RunBroadphaseBenchmark() {
+	CollisionBenchmark::RunBroadphase(broadphase_.GetCellSize());
+}
+
+void CollisionManager::RunOBBCapsuleBenchmark() {
+	CollisionBenchmark::RunOBBCapsule();
+	CollisionBenchmark::RunNarrowphase();
+}
+
 void CollisionManager::DrawDebug() {
 	if (!drawDebugEnabled_) return;
 
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
+#include "CollisionBroadphase.h"
+
 class IImGuiEditable;
 
 /// <summary>
 /// 球コライダーの登録・判定を一元管理する（シングルトン）。
 /// IImGuiEditable の構築/破棄時に自動的に Register/Unregister される。
-/// 毎フレーム Update() で全ペアを評価し、衝突発生時にコールバックを呼ぶ。
+/// 毎フレーム Update() でワールド AABB を空間ハッシュに登録し、候補ペアだけを詳細判定して
+/// 衝突発生時にコールバックを呼ぶ。
 /// Debug ビルドでは showDebug が true のコライダーを DebugDraw::Sphere で描画する。
 /// </summary>
 class CollisionManager {
@@ -18,7 +22,26 @@ public:
 	void Unregister(IImGuiEditable* e);
 
 	/// <summary>
-	/// 全ペアの衝突判定を実施。SceneManager から毎フレーム呼ばれる。
+	/// ブロードフェーズの方式。BruteForce は比較・検証用に残している旧来の総当たり。
+	/// </summary>
+	enum class BroadphaseMode : int {
+		SpatialHash = 0,
+		BruteForce  = 1,
+	};
+
+	/// <summary>
+	/// 直近 Update の集計（ImGui の Collision ウィンドウ表示用）。
+	/// </summary>
+	struct FrameStats {
+		uint32_t bodies = 0;         // 判定対象になったコライダー数
+		uint32_t candidatePairs = 0; // ブロードフェーズを通過したペア数
+		uint32_t hits = 0;           // 詳細判定で当たったペア数
+		uint32_t sweptBodies = 0;    // 掃引球（Collider::continuous）で判定したコライダー数
+	};
+
+	/// <summary>
+	/// 衝突判定を実施（ブロードフェーズ → 候補ペアのみ詳細判定）。SceneManager から毎フレーム呼ばれる。
+	/// コールバックの呼び出し順は総当たり時と同じ（登録順の i < j）。
 	/// </summary>
 	void Update();
 
@@ -39,6 +62,28 @@ public:
 	bool IsDrawDebugEnabled() const { return drawDebugEnabled_; }
 	void SetDrawDebugEnabled(bool v) { drawDebugEnabled_ = v; }
 
+	BroadphaseMode GetBroadphaseMode() const { return broadphaseMode_; }
+	void SetBroadphaseMode(BroadphaseMode m) { broadphaseMode_ = m; }
+
+	/// <summary>空間ハッシュのセルサイズ（ワールド単位）。</summary>
+	float GetCellSize() const { return broadphase_.GetCellSize(); }
+	void SetCellSize(float size) { broadphase_.SetCellSize(size); }
+
+	const FrameStats& GetFrameStats() const { return frameStats_; }
+	const SpatialHashBroadphase::Stats& GetBroadphaseStats() const { return broadphase_.GetStats(); }
+
+	/// <summary>
+	/// 現在のセルサイズで CollisionBenchmark::RunBroadphase を回す（空間ハッシュ vs 総当たりの計測と一致確認）。
+	/// 本体は CollisionBenchmark.cpp にあり、headless_bench からも同じものを呼ぶ。
+	/// </summary>
+	void RunBroadphaseBenchmark();
+
+	/// <summary>
+	/// 詳細判定のベンチマーク：CollisionBenchmark::RunOBBCapsule（厳密判定 vs サンプリング近似）と
+	/// CollisionBenchmark::RunNarrowphase（SSE 経路とスカラー経路の照合）を続けて回す。
+	/// </summary>
+	void RunOBBCapsuleBenchmark();
+
 private:
 	CollisionManager() = default;
 	~CollisionManager() = default;
@@ -47,4 +92,8 @@ private:
 
 	std::vector<IImGuiEditable*> entities_;
 	bool drawDebugEnabled_ = true;
+
+	BroadphaseMode broadphaseMode_ = BroadphaseMode::SpatialHash;
+	SpatialHashBroadphase broadphase_;
+	FrameStats frameStats_{};
 };
@@ -2,6 +2,10 @@
 
 #include "EntityTag.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 /// <summary>
 /// タグペアの当たり判定許可マトリクス。
 /// Player と PlayerBullet など、明示的に「判定しない」ペアを早期 return するための表。
@@ -62,4 +66,23 @@ namespace CollisionMatrix {
 		return true;
 	}
 
+	/// <summary>
+	/// タグ t と判定し得るタグのビットマスク（bit b = ShouldCollide(t, b)）。ShouldCollide を初回に表へ展開して引く。
+	/// ブロードフェーズの BroadphaseProxy::collideMask 用。
+	/// </summary>
+	inline uint32_t CollideMask(EntityTag t) {
+		static const auto table = [] {
+			std::array<uint32_t, static_cast<size_t>(EntityTag::Count)> m{};
+			for (int a = 0; a < static_cast<int>(EntityTag::Count); ++a) {
+				for (int b = 0; b < static_cast<int>(EntityTag::Count); ++b) {
+					if (ShouldCollide(static_cast<EntityTag>(a), static_cast<EntityTag>(b))) {
+						m[a] |= (1u << b);
+					}
+				}
+			}
+			return m;
+		}();
+		return table[static_cast<size_t>(t)];
+	}
+
 } // namespace CollisionMatrix
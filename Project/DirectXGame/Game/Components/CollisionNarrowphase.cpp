@@ -0,0 +1,579 @@
+#include "CollisionNarrowphase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <emmintrin.h>
+
+void ColliderSoA::Clear() {
+	cx.clear(); cy.clear(); cz.clear();
+	radius.clear();
+	for (int k = 0; k < 3; ++k) { ax[k].clear(); ay[k].clear(); az[k].clear(); }
+	hx.clear(); hy.clear(); hz.clear();
+	p0x.clear(); p0y.clear(); p0z.clear();
+	p1x.clear(); p1y.clear(); p1z.clear();
+	shape.clear();
+}
+
+void ColliderSoA::Push(const Collider& c, const Vector3& center, const Vector3 axes[3]) {
+	cx.push_back(center.x);
+	cy.push_back(center.y);
+	cz.push_back(center.z);
+	radius.push_back(c.shape == ColliderShape::Capsule ? c.capsuleRadius : c.radius);
+	for (int k = 0; k < 3; ++k) {
+		ax[k].push_back(axes[k].x);
+		ay[k].push_back(axes[k].y);
+		az[k].push_back(axes[k].z);
+	}
+	hx.push_back(c.halfExtents.x);
+	hy.push_back(c.halfExtents.y);
+	hz.push_back(c.halfExtents.z);
+	const float half = 0.5f * c.capsuleHeight;
+	p0x.push_back(center.x + axes[1].x * half);
+	p0y.push_back(center.y + axes[1].y * half);
+	p0z.push_back(center.z + axes[1].z * half);
+	p1x.push_back(center.x - axes[1].x * half);
+	p1y.push_back(center.y - axes[1].y * half);
+	p1z.push_back(center.z - axes[1].z * half);
+	shape.push_back(c.shape);
+}
+
+void ColliderSoA::PushSweptSphere(const Vector3& from, const Vector3& to, float radius) {
+	cx.push_back(0.5f * (from.x + to.x));
+	cy.push_back(0.5f * (from.y + to.y));
+	cz.push_back(0.5f * (from.z + to.z));
+	this->radius.push_back(radius);
+	// Capsule 判定は線分端点しか見ないので、軸と半幅はダミー
+	for (int k = 0; k < 3; ++k) {
+		ax[k].push_back(k == 0 ? 1.0f : 0.0f);
+		ay[k].push_back(k == 1 ? 1.0f : 0.0f);
+		az[k].push_back(k == 2 ? 1.0f : 0.0f);
+	}
+	hx.push_back(radius);
+	hy.push_back(radius);
+	hz.push_back(radius);
+	p0x.push_back(from.x);
+	p0y.push_back(from.y);
+	p0z.push_back(from.z);
+	p1x.push_back(to.x);
+	p1y.push_back(to.y);
+	p1z.push_back(to.z);
+	shape.push_back(ColliderShape::Capsule);
+}
+
+namespace {
+	inline float Dot3(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	inline Vector3 SubV(const Vector3& a, const Vector3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+	inline Vector3 AddV(const Vector3& a, const Vector3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+	inline Vector3 MulS(const Vector3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+
+	// 点 p に最も近い OBB 上の点
+	Vector3 ClosestPointOnOBB(const Vector3& p, const Vector3& obbCenter,
+		const Vector3 axes[3], const Vector3& halfExtents)
+	{
+		Vector3 d = SubV(p, obbCenter);
+		Vector3 result = obbCenter;
+		const float halfArr[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+		for (int i = 0; i < 3; ++i) {
+			float dist = Dot3(d, axes[i]);
+			dist = std::clamp(dist, -halfArr[i], halfArr[i]);
+			result = AddV(result, MulS(axes[i], dist));
+		}
+		return result;
+	}
+
+	Vector3 ClosestPointOnSegment(const Vector3& a, const Vector3& b, const Vector3& p) {
+		Vector3 ab = SubV(b, a);
+		float denom = Dot3(ab, ab);
+		if (denom < 1e-6f) return a;
+		float t = std::clamp(Dot3(SubV(p, a), ab) / denom, 0.0f, 1.0f);
+		return AddV(a, MulS(ab, t));
+	}
+
+	// セグメント間最短距離（Christer Ericson）
+	float SegmentSegmentDistSq(
+		const Vector3& p1, const Vector3& q1,
+		const Vector3& p2, const Vector3& q2)
+	{
+		Vector3 d1 = SubV(q1, p1);
+		Vector3 d2 = SubV(q2, p2);
+		Vector3 r  = SubV(p1, p2);
+		float a = Dot3(d1, d1);
+		float e = Dot3(d2, d2);
+		float f = Dot3(d2, r);
+		const float eps = 1e-6f;
+		float s = 0.0f, t = 0.0f;
+
+		if (a <= eps && e <= eps) {
+			Vector3 dd = SubV(p1, p2);
+			return Dot3(dd, dd);
+		}
+		if (a <= eps) {
+			t = std::clamp(f / e, 0.0f, 1.0f);
+		} else {
+			float c = Dot3(d1, r);
+			if (e <= eps) {
+				s = std::clamp(-c / a, 0.0f, 1.0f);
+				t = 0.0f;
+			} else {
+				float b = Dot3(d1, d2);
+				float denom = a * e - b * b;
+				s = (denom != 0.0f)
+					? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f)
+					: 0.0f;
+				t = (b * s + f) / e;
+				if (t < 0.0f) { t = 0.0f; s = std::clamp(-c / a, 0.0f, 1.0f); }
+				else if (t > 1.0f) { t = 1.0f; s = std::clamp((b - c) / a, 0.0f, 1.0f); }
+			}
+		}
+		Vector3 c1 = AddV(p1, MulS(d1, s));
+		Vector3 c2 = AddV(p2, MulS(d2, t));
+		Vector3 dd = SubV(c1, c2);
+		return Dot3(dd, dd);
+	}
+
+	bool TestSphereSphere(const Vector3& ca, float ra, const Vector3& cb, float rb) {
+		Vector3 d = SubV(ca, cb);
+		float sumR = ra + rb;
+		return Dot3(d, d) <= sumR * sumR;
+	}
+
+	bool TestSphereOBB(const Vector3& sc, float sr,
+		const Vector3& oc, const Vector3 axes[3], const Vector3& he)
+	{
+		Vector3 q = ClosestPointOnOBB(sc, oc, axes, he);
+		Vector3 d = SubV(sc, q);
+		return Dot3(d, d) <= sr * sr;
+	}
+
+	// カプセルは線分端点 a-b（SoA に前計算済み）と半径で受ける
+	bool TestSphereCapsule(const Vector3& sc, float sr,
+		const Vector3& a, const Vector3& b, float cr)
+	{
+		Vector3 q = ClosestPointOnSegment(a, b, sc);
+		Vector3 d = SubV(sc, q);
+		float sum = sr + cr;
+		return Dot3(d, d) <= sum * sum;
+	}
+
+	bool TestCapsuleCapsule(
+		const Vector3& a0, const Vector3& a1, float rA,
+		const Vector3& b0, const Vector3& b1, float rB)
+	{
+		float distSq = SegmentSegmentDistSq(a0, a1, b0, b1);
+		float sum = rA + rB;
+		return distSq <= sum * sum;
+	}
+
+	// SAT による OBB-OBB（標準 15 軸テスト）
+	bool TestOBBOBB(const Vector3& cA, const Vector3 axA[3], const Vector3& heA,
+		const Vector3& cB, const Vector3 axB[3], const Vector3& heB)
+	{
+		const float eps = 1e-6f;
+		float R[3][3];
+		float AbsR[3][3];
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				R[i][j] = Dot3(axA[i], axB[j]);
+				AbsR[i][j] = std::fabs(R[i][j]) + eps;
+			}
+		}
+		Vector3 tWorld = SubV(cB, cA);
+		float t[3] = {
+			Dot3(tWorld, axA[0]),
+			Dot3(tWorld, axA[1]),
+			Dot3(tWorld, axA[2])
+		};
+		const float aE[3] = { heA.x, heA.y, heA.z };
+		const float bE[3] = { heB.x, heB.y, heB.z };
+
+		// L = A axes
+		for (int i = 0; i < 3; ++i) {
+			float ra = aE[i];
+			float rb = bE[0] * AbsR[i][0] + bE[1] * AbsR[i][1] + bE[2] * AbsR[i][2];
+			if (std::fabs(t[i]) > ra + rb) return false;
+		}
+		// L = B axes
+		for (int j = 0; j < 3; ++j) {
+			float ra = aE[0] * AbsR[0][j] + aE[1] * AbsR[1][j] + aE[2] * AbsR[2][j];
+			float rb = bE[j];
+			if (std::fabs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb) return false;
+		}
+		// L = A0 x B0..B2
+		{ float ra = aE[1]*AbsR[2][0] + aE[2]*AbsR[1][0]; float rb = bE[1]*AbsR[0][2] + bE[2]*AbsR[0][1];
+		  if (std::fabs(t[2]*R[1][0] - t[1]*R[2][0]) > ra+rb) return false; }
+		{ float ra = aE[1]*AbsR[2][1] + aE[2]*AbsR[1][1]; float rb = bE[0]*AbsR[0][2] + bE[2]*AbsR[0][0];
+		  if (std::fabs(t[2]*R[1][1] - t[1]*R[2][1]) > ra+rb) return false; }
+		{ float ra = aE[1]*AbsR[2][2] + aE[2]*AbsR[1][2]; float rb = bE[0]*AbsR[0][1] + bE[1]*AbsR[0][0];
+		  if (std::fabs(t[2]*R[1][2] - t[1]*R[2][2]) > ra+rb) return false; }
+		// L = A1 x B0..B2
+		{ float ra = aE[0]*AbsR[2][0] + aE[2]*AbsR[0][0]; float rb = bE[1]*AbsR[1][2] + bE[2]*AbsR[1][1];
+		  if (std::fabs(t[0]*R[2][0] - t[2]*R[0][0]) > ra+rb) return false; }
+		{ float ra = aE[0]*AbsR[2][1] + aE[2]*AbsR[0][1]; float rb = bE[0]*AbsR[1][2] + bE[2]*AbsR[1][0];
+		  if (std::fabs(t[0]*R[2][1] - t[2]*R[0][1]) > ra+rb) return false; }
+		{ float ra = aE[0]*AbsR[2][2] + aE[2]*AbsR[0][2]; float rb = bE[0]*AbsR[1][1] + bE[1]*AbsR[1][0];
+		  if (std::fabs(t[0]*R[2][2] - t[2]*R[0][2]) > ra+rb) return false; }
+		// L = A2 x B0..B2
+		{ float ra = aE[0]*AbsR[1][0] + aE[1]*AbsR[0][0]; float rb = bE[1]*AbsR[2][2] + bE[2]*AbsR[2][1];
+		  if (std::fabs(t[1]*R[0][0] - t[0]*R[1][0]) > ra+rb) return false; }
+		{ float ra = aE[0]*AbsR[1][1] + aE[1]*AbsR[0][1]; float rb = bE[0]*AbsR[2][2] + bE[2]*AbsR[2][0];
+		  if (std::fabs(t[1]*R[0][1] - t[0]*R[1][1]) > ra+rb) return false; }
+		{ float ra = aE[0]*AbsR[1][2] + aE[1]*AbsR[0][2]; float rb = bE[0]*AbsR[2][1] + bE[1]*AbsR[2][0];
+		  if (std::fabs(t[1]*R[0][2] - t[0]*R[1][2]) > ra+rb) return false; }
+		return true;
+	}
+
+	//==================== SoA からの取り出し（スカラー経路用） ====================
+
+	inline Vector3 Center(const ColliderSoA& s, uint32_t i) { return { s.cx[i], s.cy[i], s.cz[i] }; }
+	inline Vector3 HalfExtents(const ColliderSoA& s, uint32_t i) { return { s.hx[i], s.hy[i], s.hz[i] }; }
+	inline void Axes(const ColliderSoA& s, uint32_t i, Vector3 out[3]) {
+		for (int k = 0; k < 3; ++k) out[k] = { s.ax[k][i], s.ay[k][i], s.az[k][i] };
+	}
+	inline Vector3 SegP0(const ColliderSoA& s, uint32_t i) { return { s.p0x[i], s.p0y[i], s.p0z[i] }; }
+	inline Vector3 SegP1(const ColliderSoA& s, uint32_t i) { return { s.p1x[i], s.p1y[i], s.p1z[i] }; }
+
+	//==================== SSE 4 レーン ====================
+	// 各レーンが独立した 1 ペア（a 側 / b 側）を持つ。ペアごとのインデックスから SoA を gather して詰める。
+
+	constexpr int kLanes = 4;
+
+	struct LaneIndices {
+		uint32_t a[kLanes];
+		uint32_t b[kLanes];
+	};
+
+	inline __m128 Gather(const std::vector<float>& v, const uint32_t idx[kLanes]) {
+		return _mm_setr_ps(v[idx[0]], v[idx[1]], v[idx[2]], v[idx[3]]);
+	}
+
+	inline __m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse) {
+		return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+	}
+
+	inline __m128 Clamp(__m128 v, __m128 lo, __m128 hi) {
+		return _mm_min_ps(_mm_max_ps(v, lo), hi);
+	}
+
+	inline __m128 Dot3(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+	}
+
+	// 0 除算を避けた割り算（分母が eps 以下のレーンは 0 を返す）
+	inline __m128 SafeDiv(__m128 num, __m128 den, __m128 eps) {
+		const __m128 ok = _mm_cmpgt_ps(den, eps);
+		const __m128 q = _mm_div_ps(num, Select(ok, den, _mm_set1_ps(1.0f)));
+		return _mm_and_ps(ok, q);
+	}
+
+	// 線分上の点 p に最も近い点までの距離²（線分 a-b、p は 4 レーン）
+	inline __m128 PointSegmentDistSq(
+		__m128 px, __m128 py, __m128 pz,
+		__m128 ax, __m128 ay, __m128 az,
+		__m128 bx, __m128 by, __m128 bz)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 abx = _mm_sub_ps(bx, ax), aby = _mm_sub_ps(by, ay), abz = _mm_sub_ps(bz, az);
+		const __m128 apx = _mm_sub_ps(px, ax), apy = _mm_sub_ps(py, ay), apz = _mm_sub_ps(pz, az);
+		const __m128 denom = Dot3(abx, aby, abz, abx, aby, abz);
+		const __m128 t = Clamp(SafeDiv(Dot3(apx, apy, apz, abx, aby, abz), denom, _mm_set1_ps(1e-6f)), zero, one);
+		const __m128 dx = _mm_sub_ps(apx, _mm_mul_ps(abx, t));
+		const __m128 dy = _mm_sub_ps(apy, _mm_mul_ps(aby, t));
+		const __m128 dz = _mm_sub_ps(apz, _mm_mul_ps(abz, t));
+		return Dot3(dx, dy, dz, dx, dy, dz);
+	}
+
+	// 結果マスクを hits に書き戻す（count 未満のレーンだけ）
+	inline void StoreHits(__m128 mask, const uint32_t* pairIdx, int count, uint8_t* hits) {
+		const int bits = _mm_movemask_ps(mask);
+		for (int l = 0; l < count; ++l) hits[pairIdx[l]] = static_cast<uint8_t>((bits >> l) & 1);
+	}
+
+	__m128 SphereSphere4(const ColliderSoA& s, const LaneIndices& li) {
+		const __m128 dx = _mm_sub_ps(Gather(s.cx, li.a), Gather(s.cx, li.b));
+		const __m128 dy = _mm_sub_ps(Gather(s.cy, li.a), Gather(s.cy, li.b));
+		const __m128 dz = _mm_sub_ps(Gather(s.cz, li.a), Gather(s.cz, li.b));
+		const __m128 sumR = _mm_add_ps(Gather(s.radius, li.a), Gather(s.radius, li.b));
+		return _mm_cmple_ps(Dot3(dx, dy, dz, dx, dy, dz), _mm_mul_ps(sumR, sumR));
+	}
+
+	// a = Sphere, b = OBB。正規直交軸への射影をクランプした残差² の和が最近点距離²
+	__m128 SphereOBB4(const ColliderSoA& s, const LaneIndices& li) {
+		const __m128 dx = _mm_sub_ps(Gather(s.cx, li.a), Gather(s.cx, li.b));
+		const __m128 dy = _mm_sub_ps(Gather(s.cy, li.a), Gather(s.cy, li.b));
+		const __m128 dz = _mm_sub_ps(Gather(s.cz, li.a), Gather(s.cz, li.b));
+		const __m128 he[3] = { Gather(s.hx, li.b), Gather(s.hy, li.b), Gather(s.hz, li.b) };
+		__m128 distSq = _mm_setzero_ps();
+		for (int k = 0; k < 3; ++k) {
+			const __m128 proj = Dot3(dx, dy, dz, Gather(s.ax[k], li.b), Gather(s.ay[k], li.b), Gather(s.az[k], li.b));
+			const __m128 clamped = Clamp(proj, _mm_sub_ps(_mm_setzero_ps(), he[k]), he[k]);
+			const __m128 excess = _mm_sub_ps(proj, clamped);
+			distSq = _mm_add_ps(distSq, _mm_mul_ps(excess, excess));
+		}
+		const __m128 r = Gather(s.radius, li.a);
+		return _mm_cmple_ps(distSq, _mm_mul_ps(r, r));
+	}
+
+	// a = Sphere, b = Capsule
+	__m128 SphereCapsule4(const ColliderSoA& s, const LaneIndices& li) {
+		const __m128 distSq = PointSegmentDistSq(
+			Gather(s.cx, li.a), Gather(s.cy, li.a), Gather(s.cz, li.a),
+			Gather(s.p0x, li.b), Gather(s.p0y, li.b), Gather(s.p0z, li.b),
+			Gather(s.p1x, li.b), Gather(s.p1y, li.b), Gather(s.p1z, li.b));
+		const __m128 sumR = _mm_add_ps(Gather(s.radius, li.a), Gather(s.radius, li.b));
+		return _mm_cmple_ps(distSq, _mm_mul_ps(sumR, sumR));
+	}
+
+	// 線分-線分最短距離（Ericson）を分岐なしで 4 レーン評価
+	__m128 CapsuleCapsule4(const ColliderSoA& s, const LaneIndices& li) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 eps = _mm_set1_ps(1e-6f);
+
+		const __m128 p1x = Gather(s.p0x, li.a), p1y = Gather(s.p0y, li.a), p1z = Gather(s.p0z, li.a);
+		const __m128 p2x = Gather(s.p0x, li.b), p2y = Gather(s.p0y, li.b), p2z = Gather(s.p0z, li.b);
+		const __m128 d1x = _mm_sub_ps(Gather(s.p1x, li.a), p1x);
+		const __m128 d1y = _mm_sub_ps(Gather(s.p1y, li.a), p1y);
+		const __m128 d1z = _mm_sub_ps(Gather(s.p1z, li.a), p1z);
+		const __m128 d2x = _mm_sub_ps(Gather(s.p1x, li.b), p2x);
+		const __m128 d2y = _mm_sub_ps(Gather(s.p1y, li.b), p2y);
+		const __m128 d2z = _mm_sub_ps(Gather(s.p1z, li.b), p2z);
+		const __m128 rx = _mm_sub_ps(p1x, p2x), ry = _mm_sub_ps(p1y, p2y), rz = _mm_sub_ps(p1z, p2z);
+
+		const __m128 a = Dot3(d1x, d1y, d1z, d1x, d1y, d1z);
+		const __m128 e = Dot3(d2x, d2y, d2z, d2x, d2y, d2z);
+		const __m128 f = Dot3(d2x, d2y, d2z, rx, ry, rz);
+		const __m128 c = Dot3(d1x, d1y, d1z, rx, ry, rz);
+		const __m128 b = Dot3(d1x, d1y, d1z, d2x, d2y, d2z);
+		const __m128 aOk = _mm_cmpgt_ps(a, eps);
+		const __m128 eOk = _mm_cmpgt_ps(e, eps);
+
+		// 一般ケース
+		const __m128 denom = _mm_sub_ps(_mm_mul_ps(a, e), _mm_mul_ps(b, b));
+		const __m128 denomNonZero = _mm_cmpneq_ps(denom, zero);
+		__m128 sN = Clamp(_mm_div_ps(_mm_sub_ps(_mm_mul_ps(b, f), _mm_mul_ps(c, e)), Select(denomNonZero, denom, one)), zero, one);
+		sN = _mm_and_ps(denomNonZero, sN);
+		__m128 tN = SafeDiv(_mm_add_ps(_mm_mul_ps(b, sN), f), e, eps);
+		const __m128 sLo = Clamp(SafeDiv(_mm_sub_ps(zero, c), a, eps), zero, one);
+		const __m128 sHi = Clamp(SafeDiv(_mm_sub_ps(b, c), a, eps), zero, one);
+		const __m128 tBelow = _mm_cmplt_ps(tN, zero);
+		const __m128 tAbove = _mm_cmpgt_ps(tN, one);
+		sN = Select(tBelow, sLo, Select(tAbove, sHi, sN));
+		tN = Select(tBelow, zero, Select(tAbove, one, tN));
+
+		// 退化ケース：a 側が点 → s=0, t=clamp(f/e)。b 側が点 → t=0, s=clamp(-c/a)
+		const __m128 tPointA = Clamp(SafeDiv(f, e, eps), zero, one);
+		__m128 sv = Select(aOk, Select(eOk, sN, sLo), zero);
+		__m128 tv = Select(aOk, Select(eOk, tN, zero), tPointA);
+
+		const __m128 dx = _mm_sub_ps(_mm_add_ps(rx, _mm_mul_ps(d1x, sv)), _mm_mul_ps(d2x, tv));
+		const __m128 dy = _mm_sub_ps(_mm_add_ps(ry, _mm_mul_ps(d1y, sv)), _mm_mul_ps(d2y, tv));
+		const __m128 dz = _mm_sub_ps(_mm_add_ps(rz, _mm_mul_ps(d1z, sv)), _mm_mul_ps(d2z, tv));
+		const __m128 sumR = _mm_add_ps(Gather(s.radius, li.a), Gather(s.radius, li.b));
+		return _mm_cmple_ps(Dot3(dx, dy, dz, dx, dy, dz), _mm_mul_ps(sumR, sumR));
+	}
+
+	using Kernel4 = __m128 (*)(const ColliderSoA&, const LaneIndices&);
+
+	// list（pairs への添字）を 4 件ずつ kernel に流す。swap=true なら a/b を入れ替えて
+	// 「Sphere 側を a」に揃える（OBB-Sphere → Sphere-OBB 等）
+	void RunKernel(Kernel4 kernel, const ColliderSoA& soa, const std::vector<BroadphasePair>& pairs,
+		const std::vector<uint32_t>& list, const std::vector<uint8_t>& swap, uint8_t* hits)
+	{
+		const size_t n = list.size();
+		for (size_t base = 0; base < n; base += kLanes) {
+			const int count = static_cast<int>(std::min<size_t>(kLanes, n - base));
+			LaneIndices li{};
+			for (int l = 0; l < kLanes; ++l) {
+				// 端数レーンは先頭ペアで埋める（結果は StoreHits で捨てる）
+				const size_t k = base + static_cast<size_t>(l < count ? l : 0);
+				const BroadphasePair& p = pairs[list[k]];
+				li.a[l] = swap[k] ? p.second : p.first;
+				li.b[l] = swap[k] ? p.first : p.second;
+			}
+			StoreHits(kernel(soa, li), &list[base], count, hits);
+		}
+	}
+
+	// 形状の組み合わせ → 仕分け先
+	enum Bucket : int {
+		kSphereSphere = 0,
+		kSphereOBB,
+		kSphereCapsule,
+		kCapsuleCapsule,
+		kScalar,
+		kBucketCount
+	};
+
+	struct BucketLists {
+		std::vector<uint32_t> list[kBucketCount];
+		std::vector<uint8_t>  swap[kBucketCount];
+		void Clear() {
+			for (int i = 0; i < kBucketCount; ++i) { list[i].clear(); swap[i].clear(); }
+		}
+		void Add(Bucket b, uint32_t pairIndex, bool swapAB) {
+			list[b].push_back(pairIndex);
+			swap[b].push_back(swapAB ? 1 : 0);
+		}
+	};
+
+	BucketLists g_buckets;
+}
+
+namespace CollisionNarrowphase {
+
+	float SegmentOBBDistSq(
+		const Vector3& p0, const Vector3& p1,
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he)
+	{
+		// OBB ローカルへ：a = 始点の各軸座標、d = 方向の各軸成分
+		const Vector3 rel = SubV(p0, oc);
+		const Vector3 dir = SubV(p1, p0);
+		const float a[3] = { Dot3(rel, oax[0]), Dot3(rel, oax[1]), Dot3(rel, oax[2]) };
+		const float d[3] = { Dot3(dir, oax[0]), Dot3(dir, oax[1]), Dot3(dir, oax[2]) };
+		const float h[3] = { he.x, he.y, he.z };
+
+		// 線分が各スラブ面（±h）を横切る t を区切りにする。区間内では「どの軸がどちら側に出ているか」が
+		// 固定なので距離² は t の 2 次式。距離² は t について凸なので、各区間の極小の最小が全体の最小。
+		float ts[8];
+		int count = 0;
+		ts[count++] = 0.0f;
+		ts[count++] = 1.0f;
+		for (int k = 0; k < 3; ++k) {
+			if (std::fabs(d[k]) < 1e-12f) continue;
+			const float tPos = (h[k] - a[k]) / d[k];
+			const float tNeg = (-h[k] - a[k]) / d[k];
+			if (tPos > 0.0f && tPos < 1.0f) ts[count++] = tPos;
+			if (tNeg > 0.0f && tNeg < 1.0f) ts[count++] = tNeg;
+		}
+		// 高々 8 個なので挿入ソート（std::sort は GCC の -Warray-bounds が配列長 8 を越えると誤検出する）
+		for (int i = 1; i < count; ++i) {
+			const float v = ts[i];
+			int j = i;
+			for (; j > 0 && ts[j - 1] > v; --j) ts[j] = ts[j - 1];
+			ts[j] = v;
+		}
+
+		float best = std::numeric_limits<float>::max();
+		for (int i = 0; i + 1 < count; ++i) {
+			const float t0 = ts[i];
+			const float t1 = ts[i + 1];
+			const float mid = 0.5f * (t0 + t1);
+
+			// 区間中点で各軸の外側判定 → 出ている軸だけ (a + d t - bound)^2 を足す
+			float bound[3];
+			bool outside[3];
+			float A = 0.0f, B = 0.0f;
+			for (int k = 0; k < 3; ++k) {
+				const float v = a[k] + d[k] * mid;
+				outside[k] = (v > h[k]) || (v < -h[k]);
+				bound[k] = (v > h[k]) ? h[k] : -h[k];
+				if (!outside[k]) continue;
+				A += d[k] * d[k];
+				B += d[k] * (a[k] - bound[k]);
+			}
+			const float t = (A > 1e-12f) ? std::clamp(-B / A, t0, t1) : t0;
+
+			float distSq = 0.0f;
+			for (int k = 0; k < 3; ++k) {
+				if (!outside[k]) continue;
+				const float e = a[k] + d[k] * t - bound[k];
+				distSq += e * e;
+			}
+			best = std::min(best, distSq);
+			if (best <= 0.0f) break;
+		}
+		return best;
+	}
+
+	bool TestOBBCapsule(
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he,
+		const Vector3& a, const Vector3& b, float cr)
+	{
+		return SegmentOBBDistSq(a, b, oc, oax, he) <= cr * cr;
+	}
+
+	bool TestOBBCapsuleSampled(
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he,
+		const Vector3& a, const Vector3& b, float cr, int samples)
+	{
+		if (samples < 1) samples = 1;
+		for (int i = 0; i <= samples; ++i) {
+			float t = static_cast<float>(i) / static_cast<float>(samples);
+			Vector3 p = AddV(a, MulS(SubV(b, a), t));
+			if (TestSphereOBB(p, cr, oc, oax, he)) return true;
+		}
+		return false;
+	}
+
+	bool TestPairScalar(const ColliderSoA& soa, uint32_t a, uint32_t b) {
+		const ColliderShape sa = soa.shape[a];
+		const ColliderShape sb = soa.shape[b];
+		const Vector3 cA = Center(soa, a);
+		const Vector3 cB = Center(soa, b);
+		Vector3 axA[3], axB[3];
+		Axes(soa, a, axA);
+		Axes(soa, b, axB);
+
+		switch (sa) {
+		case ColliderShape::Sphere:
+			switch (sb) {
+			case ColliderShape::Sphere:  return TestSphereSphere(cA, soa.radius[a], cB, soa.radius[b]);
+			case ColliderShape::OBB:     return TestSphereOBB(cA, soa.radius[a], cB, axB, HalfExtents(soa, b));
+			case ColliderShape::Capsule: return TestSphereCapsule(cA, soa.radius[a], SegP0(soa, b), SegP1(soa, b), soa.radius[b]);
+			} break;
+		case ColliderShape::OBB:
+			switch (sb) {
+			case ColliderShape::Sphere:  return TestSphereOBB(cB, soa.radius[b], cA, axA, HalfExtents(soa, a));
+			case ColliderShape::OBB:     return TestOBBOBB(cA, axA, HalfExtents(soa, a), cB, axB, HalfExtents(soa, b));
+			case ColliderShape::Capsule: return TestOBBCapsule(cA, axA, HalfExtents(soa, a), SegP0(soa, b), SegP1(soa, b), soa.radius[b]);
+			} break;
+		case ColliderShape::Capsule:
+			switch (sb) {
+			case ColliderShape::Sphere:  return TestSphereCapsule(cB, soa.radius[b], SegP0(soa, a), SegP1(soa, a), soa.radius[a]);
+			case ColliderShape::OBB:     return TestOBBCapsule(cB, axB, HalfExtents(soa, b), SegP0(soa, a), SegP1(soa, a), soa.radius[a]);
+			case ColliderShape::Capsule: return TestCapsuleCapsule(SegP0(soa, a), SegP1(soa, a), soa.radius[a], SegP0(soa, b), SegP1(soa, b), soa.radius[b]);
+			} break;
+		}
+		return false;
+	}
+
+	void TestPairs(const ColliderSoA& soa, const std::vector<BroadphasePair>& pairs, std::vector<uint8_t>& outHits) {
+		outHits.assign(pairs.size(), 0);
+
+		// 形状の組み合わせで仕分け（Sphere / Capsule 側が a になるよう swap を記録）
+		g_buckets.Clear();
+		for (uint32_t k = 0; k < static_cast<uint32_t>(pairs.size()); ++k) {
+			const ColliderShape sa = soa.shape[pairs[k].first];
+			const ColliderShape sb = soa.shape[pairs[k].second];
+			if (sa == ColliderShape::Sphere && sb == ColliderShape::Sphere) {
+				g_buckets.Add(kSphereSphere, k, false);
+			} else if (sa == ColliderShape::Sphere && sb == ColliderShape::OBB) {
+				g_buckets.Add(kSphereOBB, k, false);
+			} else if (sa == ColliderShape::OBB && sb == ColliderShape::Sphere) {
+				g_buckets.Add(kSphereOBB, k, true);
+			} else if (sa == ColliderShape::Sphere && sb == ColliderShape::Capsule) {
+				g_buckets.Add(kSphereCapsule, k, false);
+			} else if (sa == ColliderShape::Capsule && sb == ColliderShape::Sphere) {
+				g_buckets.Add(kSphereCapsule, k, true);
+			} else if (sa == ColliderShape::Capsule && sb == ColliderShape::Capsule) {
+				g_buckets.Add(kCapsuleCapsule, k, false);
+			} else {
+				g_buckets.Add(kScalar, k, false);
+			}
+		}
+
+		uint8_t* hits = outHits.data();
+		RunKernel(&SphereSphere4,   soa, pairs, g_buckets.list[kSphereSphere],   g_buckets.swap[kSphereSphere],   hits);
+		RunKernel(&SphereOBB4,      soa, pairs, g_buckets.list[kSphereOBB],      g_buckets.swap[kSphereOBB],      hits);
+		RunKernel(&SphereCapsule4,  soa, pairs, g_buckets.list[kSphereCapsule],  g_buckets.swap[kSphereCapsule],  hits);
+		RunKernel(&CapsuleCapsule4, soa, pairs, g_buckets.list[kCapsuleCapsule], g_buckets.swap[kCapsuleCapsule], hits);
+
+		for (uint32_t k : g_buckets.list[kScalar]) {
+			hits[k] = TestPairScalar(soa, pairs[k].first, pairs[k].second) ? 1 : 0;
+		}
+	}
+
+} // namespace CollisionNarrowphase
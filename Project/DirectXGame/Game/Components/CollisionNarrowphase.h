@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CollisionBroadphase.h"
+#include "SphereCollider.h"
+#include "Vector3.h"
+
+/// <summary>
+/// 1 フレーム分のコライダー姿勢を詰めた SoA スナップショット。
+/// CollisionManager::Update の頭で 1 コライダー 1 回だけ書き込み、詳細判定はこの配列だけを読む
+/// （Gameplay::Of のハッシュ引きや Collider へのポインタ追跡をホットループから追い出す）。
+/// インデックスは BroadphaseProxy / BroadphasePair と共通。
+/// </summary>
+struct ColliderSoA {
+	// 中心（オーナー translate + offset）
+	std::vector<float> cx, cy, cz;
+	// Sphere: radius / Capsule: capsuleRadius
+	std::vector<float> radius;
+	// 向き：軸 k の xyz（k = 0..2）。Sphere では未使用
+	std::vector<float> ax[3], ay[3], az[3];
+	// OBB の半幅
+	std::vector<float> hx, hy, hz;
+	// Capsule の線分端点（中心 ± 軸Y * height/2）
+	std::vector<float> p0x, p0y, p0z;
+	std::vector<float> p1x, p1y, p1z;
+	std::vector<ColliderShape> shape;
+
+	void Clear();
+	size_t Size() const { return cx.size(); }
+
+	/// <summary>1 コライダー分を末尾に追加。axes はワールド空間の正規直交基底（0=X, 1=Y, 2=Z）。</summary>
+	void Push(const Collider& c, const Vector3& center, const Vector3 axes[3]);
+
+	/// <summary>掃引球（from → to を半径 radius でなぞる）を Capsule として追加。Collider::continuous 用。</summary>
+	void PushSweptSphere(const Vector3& from, const Vector3& to, float radius);
+};
+
+/// <summary>
+/// 形状ペアごとの詳細判定。候補ペアを形状の組み合わせで仕分けてから、
+/// Sphere-Sphere / Sphere-OBB / Sphere-Capsule / Capsule-Capsule は SSE で 4 ペアずつまとめて判定する。
+/// OBB-OBB（SAT 15 軸）と OBB-Capsule（線分-OBB 最短距離の厳密解）はスカラー。
+/// </summary>
+namespace CollisionNarrowphase {
+
+	/// <summary>
+	/// pairs の各ペアを判定し、outHits[k] に 1（当たり）/ 0 を入れる（outHits は pairs と同じ長さにリサイズ）。
+	/// </summary>
+	void TestPairs(const ColliderSoA& soa, const std::vector<BroadphasePair>& pairs, std::vector<uint8_t>& outHits);
+
+	/// <summary>
+	/// 線分 p0-p1 と OBB の最短距離²（厳密解）。
+	/// 線分を OBB ローカルに落とし、スラブ面を横切る t で区間分けして各区間の 2 次式の極小を取る。
+	/// </summary>
+	float SegmentOBBDistSq(
+		const Vector3& p0, const Vector3& p1,
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he);
+
+	/// <summary>OBB-Capsule（カプセルは線分端点 a-b と半径 cr）。SegmentOBBDistSq による厳密判定。</summary>
+	bool TestOBBCapsule(
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he,
+		const Vector3& a, const Vector3& b, float cr);
+
+	/// <summary>
+	/// 旧実装：線分を samples 分割した点で Sphere-OBB を取る近似。検証/ベンチマークの比較対象としてだけ残す。
+	/// </summary>
+	bool TestOBBCapsuleSampled(
+		const Vector3& oc, const Vector3 oax[3], const Vector3& he,
+		const Vector3& a, const Vector3& b, float cr, int samples = 6);
+
+	/// <summary>
+	/// 1 ペアをスカラーで判定する。SSE に載せない組（OBB-OBB / OBB-Capsule）の判定と、
+	/// SSE 経路との照合（CollisionBenchmark::RunNarrowphase）に使う。
+	/// </summary>
+	bool TestPairScalar(const ColliderSoA& soa, uint32_t a, uint32_t b);
+
+} // namespace CollisionNarrowphase
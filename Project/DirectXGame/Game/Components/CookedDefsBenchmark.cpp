@@ -0,0 +1,128 @@
+#include "CookedDefsBenchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "CookedDefs.h"
+#include "EffectDef.h"
+#include "LogBuffer.h"
+#include "PrefabManager.h"
+#include "WaveDef.h"
+
+namespace {
+	constexpr const char* kEffectDir = "Resources/Json/Effects";
+	constexpr const char* kWaveDir = "Resources/Json/Waves";
+	constexpr int kReps = 20;
+
+	using Clock = std::chrono::steady_clock;
+	using CookedDefs::Mode;
+
+	struct Row {
+		const char* label = "";
+		size_t defCount = 0;
+		uint64_t jsonBytes = 0;
+		size_t cookedBytes = 0;
+		double jsonMs = 0.0;
+		double cookedMs = 0.0;
+		bool cookedOk = true;
+		bool match = true;
+	};
+
+	uint64_t SumBytes(const std::vector<CookedDefs::SourceInfo>& sources) {
+		uint64_t total = 0;
+		for (const auto& source : sources) total += source.size;
+		return total;
+	}
+
+	// load(mode, out) を JSON / .defs の両方で kReps 回ずつ計り、結果を Encode して比べる
+	template <class T, class Load>
+	void Measure(Row& row, uint32_t kind, Load load) {
+		std::vector<T> fromJson;
+		std::vector<T> fromCooked;
+		load(Mode::PreferCooked, fromCooked); // .defs が無い・古ければここで焼き直す
+
+		auto t0 = Clock::now();
+		for (int r = 0; r < kReps; ++r) {
+			fromJson.clear();
+			load(Mode::JsonOnly, fromJson);
+		}
+		row.jsonMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kReps;
+
+		t0 = Clock::now();
+		for (int r = 0; r < kReps; ++r) {
+			fromCooked.clear();
+			row.cookedOk = load(Mode::CookedOnly, fromCooked) && row.cookedOk;
+		}
+		row.cookedMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kReps;
+
+		row.defCount = fromJson.size();
+		row.match = row.cookedOk && CookedDefs::Encode(kind, fromJson) == CookedDefs::Encode(kind, fromCooked);
+	}
+}
+
+void RunCookedDefsBenchmark() {
+	std::vector<Row> rows;
+
+	{
+		Row row;
+		row.label = "Prefabs";
+		row.jsonBytes = SumBytes(CookedDefs::ScanSources(PrefabManager::GetPrefabDir()));
+		Measure<PrefabDef>(row, PrefabManager::kCookedKind, [](Mode mode, std::vector<PrefabDef>& out) {
+			return PrefabManager::LoadAll(out, mode);
+		});
+		row.cookedBytes = CookedDefs::LoadBytes(CookedDefs::CookedPathFor(PrefabManager::GetPrefabDir())).size();
+		rows.push_back(row);
+	}
+	{
+		Row row;
+		row.label = "Effects";
+		row.jsonBytes = SumBytes(CookedDefs::ScanSources(kEffectDir));
+		Measure<EffectDef>(row, EffectDefIO::kCookedKind, [](Mode mode, std::vector<EffectDef>& out) {
+			return EffectDefIO::LoadAllInDirectory(kEffectDir, out, mode);
+		});
+		row.cookedBytes = CookedDefs::LoadBytes(CookedDefs::CookedPathFor(kEffectDir)).size();
+		rows.push_back(row);
+	}
+	{
+		// ウェーブは 1 ファイル = 1 .defs
+		const std::vector<CookedDefs::SourceInfo> waves = CookedDefs::ScanSources(kWaveDir);
+		Row row;
+		row.label = "Waves";
+		row.jsonBytes = SumBytes(waves);
+		Measure<WaveDef>(row, WaveDefIO::kCookedKind, [&waves](Mode mode, std::vector<WaveDef>& out) {
+			bool ok = true;
+			for (const auto& source : waves) {
+				WaveDef def;
+				ok = WaveDefIO::LoadFromFile(source.path, def, mode) && ok;
+				out.push_back(std::move(def));
+			}
+			return ok;
+		});
+		for (const auto& source : waves) {
+			row.cookedBytes += CookedDefs::LoadBytes(CookedDefs::CookedPathFor(source.path)).size();
+		}
+		rows.push_back(row);
+	}
+
+	char buf[256];
+	LogBuffer::Instance().Add("[CookedDefs] JSON vs binary .defs loading (Resources/Json -> Resources/Cooked)");
+	double jsonTotal = 0.0;
+	double cookedTotal = 0.0;
+	bool allMatch = true;
+	for (const Row& row : rows) {
+		jsonTotal += row.jsonMs;
+		cookedTotal += row.cookedMs;
+		allMatch = allMatch && row.match;
+		std::snprintf(buf, sizeof(buf), "  %-8s %3zu defs : JSON %.3f ms (%.1f KB) / .defs %.3f ms (%.1f KB)  x%.2f  %s",
+			row.label, row.defCount, row.jsonMs, row.jsonBytes / 1024.0, row.cookedMs, row.cookedBytes / 1024.0,
+			(row.cookedMs > 0.0) ? row.jsonMs / row.cookedMs : 0.0,
+			!row.cookedOk ? ".defs missing/stale" : (row.match ? "match" : "MISMATCH"));
+		LogBuffer::Instance().Add(buf);
+	}
+	std::snprintf(buf, sizeof(buf), "  all defs x%d : JSON %.3f ms / .defs %.3f ms per load  x%.2f, results %s",
+		kReps, jsonTotal, cookedTotal, (cookedTotal > 0.0) ? jsonTotal / cookedTotal : 0.0,
+		allMatch ? "match" : "MISMATCH");
+	LogBuffer::Instance().Add(buf);
+}
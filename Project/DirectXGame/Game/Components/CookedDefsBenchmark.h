@@ -0,0 +1,8 @@
+#pragma once
+
+/// <summary>
+/// プリファブ / エフェクト / ウェーブの全定義を、JSON から読む場合と焼き込み済みの .defs から読む場合で
+/// 読み込み時間とサイズを比べて LogBuffer に出す。2 つの読み方の結果が一致するかも確かめる。
+/// .defs が無い・古いときは先に焼き直す（pack モードでは焼かずに pack 内のものを使う）。
+/// </summary>
+void RunCookedDefsBenchmark();
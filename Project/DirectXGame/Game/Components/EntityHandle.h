@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+/// <summary>
+/// エンティティの世代付きハンドル（スロット index ＋ 世代）。
+/// Gameplay のスロット表が発行し、エンティティ破棄でスロットの世代が進むので、
+/// 破棄済みエンティティを指す古いハンドルは Gameplay::Resolve で nullptr になる（生ポインタの dangling/再利用を検出できる）。
+/// generation == 0 は無効値（既定構築）。
+/// </summary>
+struct EntityHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return generation != 0; }
+
+	/// <summary>64bit に詰める（ハッシュキー・保存用）。0 は無効ハンドル。</summary>
+	uint64_t ToBits() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+	static EntityHandle FromBits(uint64_t bits) {
+		return { static_cast<uint32_t>(bits & 0xFFFFFFFFull), static_cast<uint32_t>(bits >> 32) };
+	}
+
+	bool operator==(const EntityHandle& o) const { return index == o.index && generation == o.generation; }
+	bool operator!=(const EntityHandle& o) const { return !(*this == o); }
+};
+
+template <>
+struct std::hash<EntityHandle> {
+	size_t operator()(const EntityHandle& h) const noexcept { return std::hash<uint64_t>{}(h.ToBits()); }
+};
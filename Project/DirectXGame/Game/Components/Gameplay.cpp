@@ -1,24 +1,193 @@
 #include "Gameplay.h"
+#include "IImGuiEditable.h"
+#include "LogBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
 #include <unordered_map>
+#include <vector>
 
 namespace {
-	// エンティティポインタ → ゲームプレイコンポーネント。
-	// 破棄時に Remove で除去するため dangling/ポインタ再利用のエイリアスは起きない。
-	std::unordered_map<const IImGuiEditable*, GameplayComponents> g_store;
+	// コンポーネントは 256 個単位のページに置く。ページは一度確保したら動かさない
+	// （vector の再確保で GameplayComponents& が無効にならないように）。
+	constexpr uint32_t kPageShift = 8;
+	constexpr uint32_t kPageSize = 1u << kPageShift;
+	constexpr uint32_t kPageMask = kPageSize - 1;
+
+	struct Slot {
+		uint32_t generation = 1;         // 0 は無効ハンドル用に予約
+		IImGuiEditable* owner = nullptr; // nullptr = 空きスロット
+	};
+
+	std::vector<Slot> g_slots;
+	std::vector<std::unique_ptr<GameplayComponents[]>> g_pages;
+	std::vector<uint32_t> g_freeSlots;
+
+	// Of(nullptr) 用（旧実装の g_store[nullptr] と同じく、nullptr にも 1 エントリを持たせる）
+	GameplayComponents g_nullEntry;
+
+	GameplayComponents& At(uint32_t index) {
+		return g_pages[index >> kPageShift][index & kPageMask];
+	}
+
+	bool IsLive(EntityHandle h) {
+		return h.IsValid() && h.index < g_slots.size()
+			&& g_slots[h.index].generation == h.generation
+			&& g_slots[h.index].owner != nullptr;
+	}
+
+	// エンティティに書き込まれたスロットが今も自分のものならそのハンドル、でなければ無効ハンドル
+	EntityHandle Lookup(const IImGuiEditable* e) {
+		const EntityHandle h = EntityHandle::FromBits(e->GetSideTableSlot());
+		if (!IsLive(h) || g_slots[h.index].owner != e) return {};
+		return h;
+	}
+
+	void ReleaseSlot(uint32_t index) {
+		Slot& s = g_slots[index];
+		At(index) = GameplayComponents{}; // onCollision のキャプチャ等をここで解放
+		s.owner = nullptr;
+		if (++s.generation == 0) s.generation = 1;
+		g_freeSlots.push_back(index);
+	}
+
+	EntityHandle Allocate(const IImGuiEditable* e) {
+		uint32_t index;
+		if (!g_freeSlots.empty()) {
+			index = g_freeSlots.back();
+			g_freeSlots.pop_back();
+		} else {
+			index = static_cast<uint32_t>(g_slots.size());
+			g_slots.emplace_back();
+			if ((index >> kPageShift) >= g_pages.size()) {
+				g_pages.push_back(std::make_unique<GameplayComponents[]>(kPageSize));
+			}
+		}
+		// スロットの書き込みはエンティティの論理状態を変えないので、const を外して記録する
+		IImGuiEditable* owner = const_cast<IImGuiEditable*>(e);
+		g_slots[index].owner = owner;
+		const EntityHandle h{ index, g_slots[index].generation };
+		owner->SetSideTableSlot(h.ToBits());
+		return h;
+	}
+
+	// ベンチマーク用のダミーエンティティ（フック無しで生成、破棄時は Remove が呼ばれる）
+	class BenchEntity : public IImGuiEditable {
+	public:
+		BenchEntity() : IImGuiEditable(NoAutoRegister{}) {}
+		std::string GetName() const override { return "BenchEntity"; }
+		std::string GetTypeName() const override { return "BenchEntity"; }
+		void OnImGuiInspector() override {}
+	};
+
+	// ホットパスで読むフィールド（HP / タグ / コライダー / DamageDealer）を 1 回ずつ触る
+	int64_t Touch(const GameplayComponents& gp) {
+		return static_cast<int64_t>(gp.GetHP().currentHP)
+			+ static_cast<int64_t>(gp.GetTag())
+			+ static_cast<int64_t>(gp.GetCollider().radius)
+			+ gp.GetDamageDealer().damage;
+	}
 }
 
 namespace Gameplay {
 
 	GameplayComponents& Of(const IImGuiEditable* e) {
-		return g_store[e];
+		if (!e) return g_nullEntry;
+		EntityHandle h = Lookup(e);
+		if (!h.IsValid()) h = Allocate(e);
+		return At(h.index);
+	}
+
+	EntityHandle HandleOf(const IImGuiEditable* e) {
+		if (!e) return {};
+		const EntityHandle h = Lookup(e);
+		return h.IsValid() ? h : Allocate(e);
+	}
+
+	IImGuiEditable* Resolve(EntityHandle h) {
+		return IsLive(h) ? g_slots[h.index].owner : nullptr;
+	}
+
+	GameplayComponents* TryGet(EntityHandle h) {
+		return IsLive(h) ? &At(h.index) : nullptr;
 	}
 
 	void Remove(const IImGuiEditable* e) {
-		g_store.erase(e);
+		if (!e) {
+			g_nullEntry = GameplayComponents{};
+			return;
+		}
+		const EntityHandle h = Lookup(e);
+		if (!h.IsValid()) return;
+		ReleaseSlot(h.index);
+		const_cast<IImGuiEditable*>(e)->SetSideTableSlot(0);
 	}
 
 	void Clear() {
-		g_store.clear();
+		// 生きているエンティティに残ったスロット値は世代不一致で無効になり、次の Of で取り直される
+		for (uint32_t i = 0; i < g_slots.size(); ++i) {
+			if (g_slots[i].owner) ReleaseSlot(i);
+		}
+		g_nullEntry = GameplayComponents{};
+	}
+
+	void RunLookupBenchmark() {
+		using Clock = std::chrono::high_resolution_clock;
+		const uint32_t kCounts[] = { 100, 1000, 10000 };
+
+		std::mt19937 rng(24680u);
+		std::uniform_int_distribution<int> hpDist(1, 500);
+
+		LogBuffer::Instance().Add("[Gameplay] Lookup benchmark (handle slots vs pointer map)");
+		for (uint32_t count : kCounts) {
+			std::vector<std::unique_ptr<BenchEntity>> entities;
+			std::unordered_map<const IImGuiEditable*, GameplayComponents> map;
+			entities.reserve(count);
+			for (uint32_t i = 0; i < count; ++i) {
+				entities.push_back(std::make_unique<BenchEntity>());
+				const int hp = hpDist(rng);
+				Of(entities.back()).GetHP().currentHP = hp;
+				map[entities.back().get()].GetHP().currentHP = hp;
+			}
+
+			// 実シーン同様、登録順とは無関係な順序で引く
+			std::vector<const IImGuiEditable*> order;
+			order.reserve(count);
+			for (const auto& e : entities) order.push_back(e.get());
+			std::shuffle(order.begin(), order.end(), rng);
+
+			// 1 エンティティあたり数回引く hot path（SweepDeadEntities / onCollision 等）を想定
+			const uint32_t reps = std::max<uint32_t>(1, 2000000 / count);
+
+			int64_t sumHandle = 0;
+			int64_t sumMap = 0;
+			const auto t0 = Clock::now();
+			for (uint32_t r = 0; r < reps; ++r) {
+				for (const IImGuiEditable* e : order) sumHandle += Touch(Of(e));
+			}
+			const auto t1 = Clock::now();
+			for (uint32_t r = 0; r < reps; ++r) {
+				for (const IImGuiEditable* e : order) sumMap += Touch(map[e]);
+			}
+			const auto t2 = Clock::now();
+
+			const double lookups = static_cast<double>(reps) * count;
+			const double handleNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / lookups;
+			const double mapNs    = std::chrono::duration<double, std::nano>(t2 - t1).count() / lookups;
+			const bool match = (sumHandle == sumMap);
+
+			char buf[192];
+			std::snprintf(buf, sizeof(buf),
+				"[Gameplay] n=%5u  handle %.2f ns  map %.2f ns  (x%.1f)  %s",
+				count, handleNs, mapNs, (handleNs > 0.0) ? mapNs / handleNs : 0.0,
+				match ? "match" : "MISMATCH");
+			LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+
+			// フック未設定でもスロットが残らないよう明示的に返す（dtor フックからの Remove は空振りになる）
+			for (const auto& e : entities) Remove(e.get());
+		}
 	}
 
 } // namespace Gameplay
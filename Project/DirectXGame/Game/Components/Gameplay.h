@@ -1,13 +1,17 @@
 #pragma once
 #include <memory>
+#include "EntityHandle.h"
 #include "GameplayComponents.h"
 
 class IImGuiEditable;
 
 /// <summary>
 /// エンティティ（IImGuiEditable）→ GameplayComponents の登録表（サイドテーブル）。
-/// エンジンのエンティティ基底に戦闘データを持たせず、ゲーム側でポインタをキーに保持する。
-/// 生成時に Of() でエントリ確保、破棄時に Remove()（IImGuiEditable の dtor フックから呼ぶ）。
+/// エンジンのエンティティ基底に戦闘データを持たせず、ゲーム側で保持する。
+/// 生成時に Of() でスロット確保、破棄時に Remove()（IImGuiEditable の dtor フックから呼ぶ）。
+/// スロットは世代付き（EntityHandle）で、コンポーネントはスロット index 順に詰めたページ配列に置く。
+/// エンティティ側にスロットを書き込んでおくので、Of() はハッシュ無しの配列添字で引ける。
+/// ページは確保後に動かさないため、返した参照はそのエンティティの Remove まで有効。
 /// </summary>
 namespace Gameplay {
 
@@ -18,10 +22,26 @@ namespace Gameplay {
 	template <class T>
 	GameplayComponents& Of(const std::unique_ptr<T>& p) { return Of(p.get()); }
 
-	/// <summary>エンティティのコンポーネントを破棄する。</summary>
+	/// <summary>エンティティのハンドルを返す（無ければスロットを確保）。nullptr は無効ハンドル。</summary>
+	EntityHandle HandleOf(const IImGuiEditable* e);
+
+	/// <summary>ハンドルが指すエンティティ。破棄済み（世代不一致）・無効ハンドルなら nullptr。</summary>
+	IImGuiEditable* Resolve(EntityHandle h);
+
+	/// <summary>ハンドルが指すコンポーネント。破棄済み・無効ハンドルなら nullptr。</summary>
+	GameplayComponents* TryGet(EntityHandle h);
+
+	/// <summary>エンティティのコンポーネントを破棄する（スロットの世代を進め、既存ハンドルを無効化）。</summary>
 	void Remove(const IImGuiEditable* e);
 
 	/// <summary>全エントリ破棄（シーン全消去など）。</summary>
 	void Clear();
 
+	/// <summary>
+	/// 旧実装（ポインタキーの unordered_map）との引き比べ。
+	/// 同数のダミーエンティティを両方に登録し、同じ順序で HP / タグ / コライダー / DamageDealer を読んで
+	/// 1 回あたりの時間を LogBuffer に出す。ゲームの状態は変えない。
+	/// </summary>
+	void RunLookupBenchmark();
+
 } // namespace Gameplay
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -91,13 +92,27 @@ struct GameplayComponents {
 	}
 
 	//==================== 弾プレハブスロット ====================
+	// 書き換えたら版を進める（非 const の GetBulletPrefabs で直接書いた側は MarkBulletPrefabsEdited を呼ぶ）。
+	// 発射側は版が変わったときだけスロット名からアーキタイプを引き直す。
 	const std::unordered_map<std::string, std::string>& GetBulletPrefabs() const { return bulletPrefabs; }
 	std::unordered_map<std::string, std::string>& GetBulletPrefabs() { return bulletPrefabs; }
-	void SetBulletPrefab(const std::string& slot, const std::string& prefabName) { bulletPrefabs[slot] = prefabName; }
-	std::string FindBulletPrefab(const std::string& slot) const {
+	void SetBulletPrefab(const std::string& slot, const std::string& prefabName) {
+		bulletPrefabs[slot] = prefabName;
+		MarkBulletPrefabsEdited();
+	}
+	void SetBulletPrefabs(const std::unordered_map<std::string, std::string>& slots) {
+		bulletPrefabs = slots;
+		MarkBulletPrefabsEdited();
+	}
+	/// <summary>スロットのプレハブ名（無ければ空文字列への参照）。</summary>
+	const std::string& FindBulletPrefab(const std::string& slot) const {
+		static const std::string kNone;
 		auto it = bulletPrefabs.find(slot);
-		return (it != bulletPrefabs.end()) ? it->second : std::string();
+		return (it != bulletPrefabs.end()) ? it->second : kNone;
 	}
+	/// <summary>スロットの版。全エンティティを通して一意なので、別のエンティティに差し替わっても一致しない（0 は発行しない）。</summary>
+	uint32_t GetBulletPrefabsRevision() const { return bulletPrefabsRevision; }
+	void MarkBulletPrefabsEdited() { bulletPrefabsRevision = NextBulletPrefabsRevision(); }
 
 	//==================== 実データ ====================
 	EntityTag tag = EntityTag::None;
@@ -117,4 +132,12 @@ struct GameplayComponents {
 	int  scoreValue = 10; // 撃破スコア（Enemy/Boss プレハブで使用、Prefab から上書き）
 	std::unordered_map<std::string, std::string> effects;
 	std::unordered_map<std::string, std::string> bulletPrefabs;
+	uint32_t bulletPrefabsRevision = NextBulletPrefabsRevision();
+
+private:
+	// メインスレッドからだけ呼ぶ
+	static uint32_t NextBulletPrefabsRevision() {
+		static uint32_t next = 0;
+		return ++next;
+	}
 };
@@ -171,3 +171,8 @@ struct PrefabDef {
 	// スロット名（normal / charge1 / charge2）→ 弾プレハブ名。
 	std::unordered_map<std::string, std::string> bulletPrefabs;
 };
+
+/// <summary>
+/// PrefabDef のフィールド並び（CookedDefs の .defs 読み書き用。定義と実体化は PrefabManager.cpp）
+/// </summary>
+template <class Ar> void CookFields(Ar& ar, PrefabDef& v);
@@ -1,4 +1,5 @@
 #include "PrefabManager.h"
+#include "GameplayComponents.h"
 
 #include "Json/JsonValue.h"
 #include "Json/JsonParser.h"
@@ -32,14 +33,14 @@ namespace {
 		return arr;
 	}
 
-	Vector2 JsonToVec2(const JsonValue& v, const Vector2& fallback = {}) {
+	Vector2 JsonToVec2(const JsonNode& v, const Vector2& fallback = {}) {
 		if (!v.IsArray() || v.Size() < 2) return fallback;
 		return {
 			static_cast<float>(v[0].AsDouble(fallback.x)),
 			static_cast<float>(v[1].AsDouble(fallback.y))
 		};
 	}
-	Vector3 JsonToVec3(const JsonValue& v, const Vector3& fallback = {}) {
+	Vector3 JsonToVec3(const JsonNode& v, const Vector3& fallback = {}) {
 		if (!v.IsArray() || v.Size() < 3) return fallback;
 		return {
 			static_cast<float>(v[0].AsDouble(fallback.x)),
@@ -47,7 +48,7 @@ namespace {
 			static_cast<float>(v[2].AsDouble(fallback.z))
 		};
 	}
-	Vector4 JsonToVec4(const JsonValue& v, const Vector4& fallback = {}) {
+	Vector4 JsonToVec4(const JsonNode& v, const Vector4& fallback = {}) {
 		if (!v.IsArray() || v.Size() < 4) return fallback;
 		return {
 			static_cast<float>(v[0].AsDouble(fallback.x)),
@@ -115,7 +116,7 @@ namespace {
 		o["endAngle"]    = static_cast<double>(p.endAngle);
 		return o;
 	}
-	void RingParamsFromJson(const JsonValue& o, PrimitiveGenerator::RingParams& p) {
+	void RingParamsFromJson(const JsonNode& o, PrimitiveGenerator::RingParams& p) {
 		p.outerRadius = static_cast<float>(o["outerRadius"].AsDouble(p.outerRadius));
 		p.innerRadius = static_cast<float>(o["innerRadius"].AsDouble(p.innerRadius));
 		p.divisions   = static_cast<uint32_t>(o["divisions"].AsInt(static_cast<int64_t>(p.divisions)));
@@ -137,7 +138,7 @@ namespace {
 		o["endAngle"]     = static_cast<double>(p.endAngle);
 		return o;
 	}
-	void CylinderParamsFromJson(const JsonValue& o, PrimitiveGenerator::CylinderParams& p) {
+	void CylinderParamsFromJson(const JsonNode& o, PrimitiveGenerator::CylinderParams& p) {
 		p.topRadius    = static_cast<float>(o["topRadius"].AsDouble(p.topRadius));
 		p.bottomRadius = static_cast<float>(o["bottomRadius"].AsDouble(p.bottomRadius));
 		p.height       = static_cast<float>(o["height"].AsDouble(p.height));
@@ -162,7 +163,7 @@ namespace {
 		o["endColor"]         = Vec4ToJson(p.endColor);
 		return o;
 	}
-	void HelixParamsFromJson(const JsonValue& o, PrimitiveGenerator::HelixParams& p) {
+	void HelixParamsFromJson(const JsonNode& o, PrimitiveGenerator::HelixParams& p) {
 		p.startHelixRadius = static_cast<float>(o["startHelixRadius"].AsDouble(p.startHelixRadius));
 		p.endHelixRadius   = static_cast<float>(o["endHelixRadius"].AsDouble(p.endHelixRadius));
 		p.startTubeRadius  = static_cast<float>(o["startTubeRadius"].AsDouble(p.startTubeRadius));
@@ -176,6 +177,80 @@ namespace {
 	}
 }
 
+template <class Ar>
+void CookFields(Ar& ar, PrefabDef& v) {
+	ar.Field(v.name);
+	ar.Field(v.kind);
+	ar.Field(v.isAnimated);
+	ar.Field(v.modelDir);
+	ar.Field(v.modelFile);
+	ar.Field(v.primitiveParams);
+	ar.Field(v.tag);
+	ar.Field(v.defaultScale);
+	ar.Field(v.defaultRotate);
+	ar.Field(v.hasCollider);
+	ar.Field(v.colliderShape);
+	ar.Field(v.colliderOffset);
+	ar.Field(v.colliderRadius);
+	ar.Field(v.colliderHalfExtents);
+	ar.Field(v.colliderCapsuleRadius);
+	ar.Field(v.colliderCapsuleHeight);
+	ar.Field(v.hasHP);
+	ar.Field(v.maxHP);
+	ar.Field(v.hasDamageDealer);
+	ar.Field(v.damage);
+	ar.Field(v.attackMultiplier);
+	ar.Field(v.hasAttackPower);
+	ar.Field(v.attackPower);
+	ar.Field(v.scoreValue);
+	ar.Field(v.hasBullet);
+	ar.Field(v.bulletSpeed);
+	ar.Field(v.bulletLifetime);
+	ar.Field(v.bulletHomingStrength);
+	ar.Field(v.bulletStrongHomingStrength);
+	ar.Field(v.bulletColliderGrowth);
+	ar.Field(v.bulletPenetrate);
+	ar.Field(v.bulletPenetrateDamageRate);
+	ar.Field(v.bulletPenetrateEffect);
+	ar.Field(v.hasMelee);
+	ar.Field(v.meleeStartup);
+	ar.Field(v.meleeActiveDuration);
+	ar.Field(v.meleeRecovery);
+	ar.Field(v.meleeOffset);
+	ar.Field(v.meleeComboWindow);
+	ar.Field(v.meleeCleanWindow);
+	ar.Field(v.meleeCleanMultiplier);
+	ar.Field(v.meleeLateMultiplier);
+	ar.Field(v.hasMovement);
+	ar.Field(v.movementType);
+	ar.Field(v.moveSpeed);
+	ar.Field(v.hoverApproachSpeed);
+	ar.Field(v.hoverHoldDuration);
+	ar.Field(v.hasCarrier);
+	ar.Field(v.carrierChildLifetimeSec);
+	ar.Field(v.carrierChildWanderRadius);
+	ar.Field(v.carrierChildMoveSpeed);
+	ar.Field(v.hasCharge);
+	ar.Field(v.chargeStage1Time);
+	ar.Field(v.chargeStage2Time);
+	ar.Field(v.chargeFireRate);
+	ar.Field(v.hasPrecision);
+	ar.Field(v.precisionSpeedAdd);
+	ar.Field(v.precisionHomingAdd);
+	ar.Field(v.hasWeapon);
+	ar.Field(v.weaponEnabled);
+	ar.Field(v.weaponModelDir);
+	ar.Field(v.weaponModelFile);
+	ar.Field(v.weaponBone);
+	ar.Field(v.weaponOffsetTranslate);
+	ar.Field(v.weaponOffsetRotate);
+	ar.Field(v.weaponOffsetScale);
+	ar.Field(v.effects);
+	ar.Field(v.bulletPrefabs);
+}
+
+COOKED_DEFS_INSTANTIATE(PrefabDef);
+
 PrefabManager* PrefabManager::GetInstance() {
 	static PrefabManager instance;
 	return &instance;
@@ -203,21 +278,37 @@ bool PrefabManager::Delete(const std::string& name) {
 
 void PrefabManager::Rescan() {
 	prefabs_.clear();
+	++revision_;
+	LoadAll(prefabs_);
+}
+
+bool PrefabManager::LoadAll(std::vector<PrefabDef>& out, CookedDefs::Mode mode) {
 	std::filesystem::path dir(kPrefabDir);
 	std::error_code ec;
 	if (!std::filesystem::exists(dir, ec)) {
-		return; // 未作成なら何もしない（プリファブ無し状態）
+		return false; // 未作成なら何もしない（プリファブ無し状態）
 	}
-	for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
-		if (ec) break;
-		if (!entry.is_regular_file()) continue;
-		if (entry.path().extension() != ".json") continue;
 
+	const std::string cookedPath = CookedDefs::CookedPathFor(kPrefabDir);
+	const std::vector<CookedDefs::SourceInfo> sources = CookedDefs::ScanSources(kPrefabDir);
+	if (mode != CookedDefs::Mode::JsonOnly) {
+		if (CookedDefs::LoadRecords(cookedPath, kCookedKind, &sources, out)) return true;
+		if (mode == CookedDefs::Mode::CookedOnly) return false;
+	}
+
+	std::vector<PrefabDef> defs;
+	defs.reserve(sources.size());
+	for (const CookedDefs::SourceInfo& source : sources) {
 		PrefabDef def;
-		if (LoadFile(entry.path().generic_string(), def)) {
-			prefabs_.push_back(std::move(def));
+		if (LoadFile(source.path, def)) {
+			defs.push_back(std::move(def));
 		}
 	}
+	if (mode == CookedDefs::Mode::PreferCooked) {
+		CookedDefs::SaveRecords(cookedPath, kCookedKind, sources, defs);
+	}
+	out = std::move(defs);
+	return true;
 }
 
 const PrefabDef* PrefabManager::Find(const std::string& name) const {
@@ -227,13 +318,116 @@ const PrefabDef* PrefabManager::Find(const std::string& name) const {
 	return nullptr;
 }
 
-bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const {
-	auto result = JsonParser::ParseFile(filePath);
+void PrefabManager::ApplyGameplayComponents(const PrefabDef& def, const std::string& prefabName, GameplayComponents& gp) {
+	gp.SetTag(def.tag);
+	gp.SetPrefabName(prefabName);
+	if (def.hasCollider) {
+		Collider& c = gp.GetCollider();
+		c.enabled = true;
+		c.shape = def.colliderShape;
+		c.offset = def.colliderOffset;
+		c.radius = def.colliderRadius;
+		c.halfExtents = def.colliderHalfExtents;
+		c.capsuleRadius = def.colliderCapsuleRadius;
+		c.capsuleHeight = def.colliderCapsuleHeight;
+	}
+	if (def.hasHP) {
+		HP& hp = gp.GetHP();
+		hp.enabled = true;
+		hp.maxHP = def.maxHP;
+		hp.currentHP = def.maxHP;
+	}
+	if (def.hasDamageDealer) {
+		DamageDealer& dd = gp.GetDamageDealer();
+		dd.enabled = true;
+		dd.damage = def.damage;
+		dd.multiplier = def.attackMultiplier;
+	}
+	if (def.hasAttackPower) {
+		gp.SetHasAttackPower(true);
+		gp.SetAttackPower(def.attackPower);
+	}
+	// 敵撃破スコア（タグに関わらずコピー、StagePlay 側で Enemy/Boss だけ参照する）
+	gp.SetScoreValue(def.scoreValue);
+	if (def.hasBullet) {
+		BulletParams& bp = gp.GetBulletParams();
+		bp.enabled        = true;
+		bp.speed          = def.bulletSpeed;
+		bp.lifetime       = def.bulletLifetime;
+		bp.homingStrength = def.bulletHomingStrength;
+		bp.strongHomingStrength = def.bulletStrongHomingStrength;
+		bp.colliderGrowth = def.bulletColliderGrowth;
+		bp.penetrate            = def.bulletPenetrate;
+		bp.penetrateDamageRate  = def.bulletPenetrateDamageRate;
+		bp.penetrateEffect      = def.bulletPenetrateEffect;
+	}
+	if (def.hasMelee) {
+		MeleeParams& mp = gp.GetMeleeParams();
+		mp.enabled         = true;
+		mp.startup         = def.meleeStartup;
+		mp.activeDuration  = def.meleeActiveDuration;
+		mp.offset          = def.meleeOffset;
+		mp.comboWindow     = def.meleeComboWindow;
+		mp.recovery        = def.meleeRecovery;
+		mp.cleanWindow     = def.meleeCleanWindow;
+		mp.cleanMultiplier = def.meleeCleanMultiplier;
+		mp.lateMultiplier  = def.meleeLateMultiplier;
+	}
+	if (def.hasCarrier) {
+		CarrierParams& cp = gp.GetCarrierParams();
+		cp.enabled           = true;
+		cp.childLifetimeSec  = def.carrierChildLifetimeSec;
+		cp.childWanderRadius = def.carrierChildWanderRadius;
+		cp.childMoveSpeed    = def.carrierChildMoveSpeed;
+	}
+	if (def.hasMovement) {
+		MovementParams& mv = gp.GetMovementParams();
+		mv.enabled            = true;
+		mv.movementType       = def.movementType;
+		mv.moveSpeed          = def.moveSpeed;
+		mv.hoverApproachSpeed = def.hoverApproachSpeed;
+		mv.hoverHoldDuration  = def.hoverHoldDuration;
+	}
+	if (def.hasCharge) {
+		ChargeParams& chp = gp.GetChargeParams();
+		chp.enabled    = true;
+		chp.stage1Time = def.chargeStage1Time;
+		chp.stage2Time = def.chargeStage2Time;
+		chp.fireRate   = def.chargeFireRate;
+	}
+	if (def.hasPrecision) {
+		PrecisionParams& pp = gp.GetPrecisionParams();
+		pp.enabled   = true;
+		pp.speedAdd  = def.precisionSpeedAdd;
+		pp.homingAdd = def.precisionHomingAdd;
+	}
+	if (def.hasWeapon) {
+		WeaponParams& wp = gp.GetWeaponParams();
+		wp.enabled         = def.weaponEnabled;
+		wp.bone            = def.weaponBone;
+		wp.offsetTranslate = def.weaponOffsetTranslate;
+		wp.offsetRotate    = def.weaponOffsetRotate;
+		wp.offsetScale     = def.weaponOffsetScale;
+		wp.modelDir        = def.weaponModelDir;
+		wp.modelFile       = def.weaponModelFile;
+	}
+	// エフェクトスロットを丸ごとコピー
+	if (!def.effects.empty()) {
+		gp.GetEffects() = def.effects;
+	}
+	// 弾プレハブスロットを丸ごとコピー
+	if (!def.bulletPrefabs.empty()) {
+		gp.SetBulletPrefabs(def.bulletPrefabs);
+	}
+}
+
+bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) {
+	auto result = JsonParser::ParseDocumentFile(filePath);
 	if (!result.success) {
 		Log(std::string("[PrefabManager] Parse error in ") + filePath + ": " + result.errorMessage + "\n");
 		return false;
 	}
-	const JsonValue& root = result.value;
+	const JsonNode& root = result.document.Root();
 
 	// 名前はファイル名から（拡張子無し）
 	std::filesystem::path p(filePath);
@@ -257,7 +451,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 
 	// Primitive 用パラメータ
 	if (out.kind == PrefabKind::Primitive) {
-		const JsonValue& pp = root["primitive"];
+		const JsonNode& pp = root["primitive"];
 		auto& pr = out.primitiveParams;
 		pr.primitiveType = static_cast<int>(pp["primitiveType"].AsInt(static_cast<int64_t>(pr.primitiveType)));
 		if (pp["texturePath"].IsString()) pr.texturePath = pp["texturePath"].AsString();
@@ -280,7 +474,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 		if (pp["helix"].IsObject())    HelixParamsFromJson(pp["helix"], pr.helixParams);
 	}
 
-	const JsonValue& col = root["collider"];
+	const JsonNode& col = root["collider"];
 	out.hasCollider = col.IsObject() && col.GetType() != JsonValue::Type::Null;
 	if (out.hasCollider) {
 		// shape: "Sphere" / "OBB" / "Capsule"。未指定なら Sphere（旧形式互換）。
@@ -297,14 +491,14 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// HP
-	const JsonValue& hpJ = root["hp"];
+	const JsonNode& hpJ = root["hp"];
 	if (hpJ.IsObject()) {
 		out.hasHP = true;
 		out.maxHP = static_cast<int>(hpJ["maxHP"].AsInt(static_cast<int64_t>(out.maxHP)));
 	}
 
 	// DamageDealer
-	const JsonValue& ddJ = root["damageDealer"];
+	const JsonNode& ddJ = root["damageDealer"];
 	if (ddJ.IsObject()) {
 		out.hasDamageDealer = true;
 		out.damage           = static_cast<int>(ddJ["damage"].AsInt(static_cast<int64_t>(out.damage)));
@@ -312,7 +506,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// AttackPower（数値直値 or オブジェクト）
-	const JsonValue& apJ = root["attackPower"];
+	const JsonNode& apJ = root["attackPower"];
 	if (apJ.IsObject()) {
 		out.hasAttackPower = true;
 		out.attackPower    = static_cast<int>(apJ["value"].AsInt(static_cast<int64_t>(out.attackPower)));
@@ -322,7 +516,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// ScoreValue（敵プレハブ用の撃破スコア。number or {value:int}）
-	const JsonValue& svJ = root["scoreValue"];
+	const JsonNode& svJ = root["scoreValue"];
 	if (svJ.IsObject()) {
 		out.scoreValue = static_cast<int>(svJ["value"].AsInt(static_cast<int64_t>(out.scoreValue)));
 	} else if (svJ.IsNumber()) {
@@ -330,7 +524,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Bullet（弾プレハブ用の速度・寿命・ホーミング・貫通）
-	const JsonValue& blJ = root["bullet"];
+	const JsonNode& blJ = root["bullet"];
 	if (blJ.IsObject()) {
 		out.hasBullet            = true;
 		out.bulletSpeed          = static_cast<float>(blJ["speed"].AsDouble(out.bulletSpeed));
@@ -344,7 +538,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Melee（近接攻撃プレハブ用：持続・オフセット・コンボ・本/持続あて）
-	const JsonValue& meJ = root["melee"];
+	const JsonNode& meJ = root["melee"];
 	if (meJ.IsObject()) {
 		out.hasMelee             = true;
 		out.meleeStartup         = static_cast<float>(meJ["startup"].AsDouble(out.meleeStartup));
@@ -358,7 +552,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Movement（敵プレハブ用：登場/移動の方法と速度）
-	const JsonValue& mvJ = root["movement"];
+	const JsonNode& mvJ = root["movement"];
 	if (mvJ.IsObject()) {
 		out.hasMovement        = true;
 		out.movementType       = MovementTypeFromStr(mvJ["type"].AsString("SplineFollow"), out.movementType);
@@ -368,7 +562,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Carrier（運び屋プレハブ用の子敵パラメータ）
-	const JsonValue& caJ = root["carrier"];
+	const JsonNode& caJ = root["carrier"];
 	if (caJ.IsObject()) {
 		out.hasCarrier               = true;
 		out.carrierChildLifetimeSec  = static_cast<float>(caJ["childLifetimeSec"].AsDouble(out.carrierChildLifetimeSec));
@@ -377,7 +571,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Charge（プレイヤープレハブ用のチャージ時間 + 連射間隔）
-	const JsonValue& chJ = root["charge"];
+	const JsonNode& chJ = root["charge"];
 	if (chJ.IsObject()) {
 		out.hasCharge        = true;
 		out.chargeStage1Time = static_cast<float>(chJ["stage1Time"].AsDouble(out.chargeStage1Time));
@@ -386,7 +580,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Precision（プレイヤープレハブ用の精密射撃モード加算値）
-	const JsonValue& prJ = root["precision"];
+	const JsonNode& prJ = root["precision"];
 	if (prJ.IsObject()) {
 		out.hasPrecision       = true;
 		out.precisionSpeedAdd  = static_cast<float>(prJ["speedAdd"].AsDouble(out.precisionSpeedAdd));
@@ -394,7 +588,7 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// Weapon（プレイヤープレハブ用のソケット追従武器）
-	const JsonValue& weJ = root["weapon"];
+	const JsonNode& weJ = root["weapon"];
 	if (weJ.IsObject()) {
 		out.hasWeapon     = true;
 		out.weaponEnabled = weJ["enabled"].AsBool(out.weaponEnabled);
@@ -407,21 +601,21 @@ bool PrefabManager::LoadFile(const std::string& filePath, PrefabDef& out) const
 	}
 
 	// エフェクトスロット（スロット名 → エフェクト名）
-	const JsonValue& efJ = root["effects"];
+	const JsonNode& efJ = root["effects"];
 	if (efJ.IsObject()) {
 		for (const auto& kv : efJ.AsObject()) {
 			if (kv.second.IsString()) {
-				out.effects[kv.first] = kv.second.AsString();
+				out.effects[std::string(kv.first)] = kv.second.AsString();
 			}
 		}
 	}
 
 	// 弾プレハブスロット（スロット名 → 弾プレハブ名）
-	const JsonValue& bpJ = root["bulletPrefabs"];
+	const JsonNode& bpJ = root["bulletPrefabs"];
 	if (bpJ.IsObject()) {
 		for (const auto& kv : bpJ.AsObject()) {
 			if (kv.second.IsString()) {
-				out.bulletPrefabs[kv.first] = kv.second.AsString();
+				out.bulletPrefabs[std::string(kv.first)] = kv.second.AsString();
 			}
 		}
 	}
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Prefab.h"
+#include "CookedDefs.h"
+
+struct GameplayComponents;
 
 /// <summary>
 /// Resources/Json/Prefabs/ 配下の .json プリファブをロード・キャッシュする（シングルトン）。
@@ -29,6 +33,18 @@ public:
 	/// </summary>
 	const std::vector<PrefabDef>& GetAll() const { return prefabs_; }
 
+	/// <summary>
+	/// Rescan のたびに進む番号。プリファブ内容をキャッシュする側（BulletPool のアーキタイプ等）が
+	/// 古くなったかを判定するのに使う。
+	/// </summary>
+	uint32_t GetRevision() const { return revision_; }
+
+	/// <summary>
+	/// プリファブのタグ・コライダー・HP / DamageDealer / 各種 Params・エフェクト等を GameplayComponents へ書き込む。
+	/// InstantiatePrefab と弾プールのアーキタイプ構築で共用する。
+	/// </summary>
+	static void ApplyGameplayComponents(const PrefabDef& def, const std::string& prefabName, GameplayComponents& gp);
+
 	/// <summary>
 	/// プリファブを JSON にシリアライズしてファイル保存（Inspector の "Save as Prefab" 用）。
 	/// </summary>
@@ -45,13 +61,24 @@ public:
 	/// </summary>
 	static const char* GetPrefabDir();
 
+	/// <summary>
+	/// プリファブ保存先の *.json をすべて読む（パス順）。Rescan の中身。
+	/// PreferCooked なら Resources/Cooked/Prefabs.defs が元 JSON と一致すればそちらを使い、
+	/// 無い・古いときは JSON から読んで焼き直す。
+	/// </summary>
+	static bool LoadAll(std::vector<PrefabDef>& out, CookedDefs::Mode mode = CookedDefs::Mode::PreferCooked);
+
+	/// <summary>.defs の種別</summary>
+	static constexpr uint32_t kCookedKind = CookedDefs::MakeKind('P', 'R', 'F', 'B');
+
 private:
 	PrefabManager() = default;
 	~PrefabManager() = default;
 	PrefabManager(const PrefabManager&) = delete;
 	PrefabManager& operator=(const PrefabManager&) = delete;
 
-	bool LoadFile(const std::string& filePath, PrefabDef& out) const;
+	static bool LoadFile(const std::string& filePath, PrefabDef& out);
 
 	std::vector<PrefabDef> prefabs_;
+	uint32_t revision_ = 0;
 };
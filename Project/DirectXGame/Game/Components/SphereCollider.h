@@ -45,6 +45,14 @@ struct Collider {
 	float capsuleRadius = 0.5f;
 	float capsuleHeight = 1.0f;
 
+	/// 連続判定（Sphere のみ）。1 フレームの移動量が radius を超えたら、前フレームの中心→今の中心を
+	/// 線分とするカプセル（掃引球）で判定し、高速な弾が薄い相手をすり抜けないようにする。
+	bool continuous = false;
+
+	/// 前フレームの判定中心（continuous 用。CollisionManager が毎フレ更新し、無効化/姿勢なしでリセット）
+	Vector3 prevCenter{ 0.0f, 0.0f, 0.0f };
+	bool hasPrevCenter = false;
+
 	/// 衝突発生時に呼ばれるコールバック（相手のエンティティを受け取る）
 	std::function<void(IImGuiEditable* other)> onCollision;
 
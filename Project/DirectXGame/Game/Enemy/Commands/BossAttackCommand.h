@@ -61,7 +61,7 @@ private:
 		if (len < 1e-4f) return;
 		d = { d.x / len, d.y / len, d.z / len };
 		// 弾速/寿命/ホーミングは EnemyBullet プレハブの bullet セクションから（負数＝プレハブ既定）。
-		ctx.scene->SpawnEnemyBullet(*bp, d, -1.0f, -1.0f, "EnemyBullet", ctx.player);
+		ctx.scene->SpawnEnemyBullet(*bp, d, -1.0f, -1.0f, ctx.scene->GetEnemyBulletArchetype(), ctx.player);
 	}
 
 	Phase phase_         = Phase::Telegraph;
@@ -47,6 +47,6 @@ private:
 		dir = { dir.x / len, dir.y / len, dir.z / len };
 
 		// プレイヤーを homingTarget として渡す（ホーミング強度はプレハブから）
-		ctx.scene->SpawnEnemyBullet(*pos, dir, -1.0f, -1.0f, "EnemyBullet", ctx.player);
+		ctx.scene->SpawnEnemyBullet(*pos, dir, -1.0f, -1.0f, ctx.scene->GetEnemyBulletArchetype(), ctx.player);
 	}
 };
@@ -130,7 +130,7 @@ public:
 						const float dlen = std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
 						if (dlen > 0.01f) {
 							d = { d.x / dlen, d.y / dlen, d.z / dlen };
-							ctx.scene->SpawnEnemyBullet(*pos, d, -1.0f, -1.0f, "EnemyBullet", ctx.player);
+							ctx.scene->SpawnEnemyBullet(*pos, d, -1.0f, -1.0f, ctx.scene->GetEnemyBulletArchetype(), ctx.player);
 						}
 					}
 				}
@@ -668,9 +668,7 @@ void DemoScene::Update() {
 
 	// SceneEditorWindow からドロップで追加された動的エンティティ
 	UpdateDynamicPrimitives();
-	for (auto& a : dynamicAnimated_) {
-		a->Update(GetScaledDeltaTime());
-	}
+	UpdateDynamicAnimated(GetScaledDeltaTime());
 	for (auto& s : dynamicSprites_) {
 		s->Update();
 	}
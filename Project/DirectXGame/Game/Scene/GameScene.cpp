@@ -14,8 +14,8 @@
 #include "Components/Prefab.h"
 #include "Components/EntityTag.h"
 #include "LogBuffer.h"
+#include "AssetLocator.h"
 #include "Primitive/PrimitiveInstance.h"
-#include "Primitive/DebugDraw.h"
 #include <algorithm>
 #include <cmath>
 
@@ -29,7 +29,9 @@ namespace {
 	}
 }
 
-GameScene::GameScene() = default;
+GameScene::GameScene() {
+	bulletPool_.SetHitHandler([this](uint32_t slot, IImGuiEditable* other) { OnBulletHit(slot, other); });
+}
 GameScene::~GameScene() = default;
 
 //====================
@@ -91,108 +93,6 @@ IImGuiEditable* GameScene::InstantiatePrefab(const std::string& prefabName, cons
 		return nullptr;
 	}
 
-	auto applyCollider = [&](Collider& c) {
-		c.enabled = true;
-		c.shape = def->colliderShape;
-		c.offset = def->colliderOffset;
-		c.radius = def->colliderRadius;
-		c.halfExtents = def->colliderHalfExtents;
-		c.capsuleRadius = def->colliderCapsuleRadius;
-		c.capsuleHeight = def->colliderCapsuleHeight;
-	};
-
-	auto applyHPAndDamage = [&](IImGuiEditable* e) {
-		if (!e) return;
-		if (def->hasHP) {
-			HP& hp = Gameplay::Of(e).GetHP();
-			hp.enabled = true;
-			hp.maxHP = def->maxHP;
-			hp.currentHP = def->maxHP;
-		}
-		if (def->hasDamageDealer) {
-			DamageDealer& dd = Gameplay::Of(e).GetDamageDealer();
-			dd.enabled = true;
-			dd.damage = def->damage;
-			dd.multiplier = def->attackMultiplier;
-		}
-		if (def->hasAttackPower) {
-			Gameplay::Of(e).SetHasAttackPower(true);
-			Gameplay::Of(e).SetAttackPower(def->attackPower);
-		}
-		// 敵撃破スコア（タグに関わらずコピー、StagePlay 側で Enemy/Boss だけ参照する）
-		Gameplay::Of(e).SetScoreValue(def->scoreValue);
-		if (def->hasBullet) {
-			BulletParams& bp = Gameplay::Of(e).GetBulletParams();
-			bp.enabled        = true;
-			bp.speed          = def->bulletSpeed;
-			bp.lifetime       = def->bulletLifetime;
-			bp.homingStrength = def->bulletHomingStrength;
-			bp.strongHomingStrength = def->bulletStrongHomingStrength;
-			bp.colliderGrowth = def->bulletColliderGrowth;
-			bp.penetrate            = def->bulletPenetrate;
-			bp.penetrateDamageRate  = def->bulletPenetrateDamageRate;
-			bp.penetrateEffect      = def->bulletPenetrateEffect;
-		}
-		if (def->hasMelee) {
-			MeleeParams& mp = Gameplay::Of(e).GetMeleeParams();
-			mp.enabled         = true;
-			mp.startup         = def->meleeStartup;
-			mp.activeDuration  = def->meleeActiveDuration;
-			mp.offset          = def->meleeOffset;
-			mp.comboWindow     = def->meleeComboWindow;
-			mp.recovery        = def->meleeRecovery;
-			mp.cleanWindow     = def->meleeCleanWindow;
-			mp.cleanMultiplier = def->meleeCleanMultiplier;
-			mp.lateMultiplier  = def->meleeLateMultiplier;
-		}
-		if (def->hasCarrier) {
-			CarrierParams& cp = Gameplay::Of(e).GetCarrierParams();
-			cp.enabled           = true;
-			cp.childLifetimeSec  = def->carrierChildLifetimeSec;
-			cp.childWanderRadius = def->carrierChildWanderRadius;
-			cp.childMoveSpeed    = def->carrierChildMoveSpeed;
-		}
-		if (def->hasMovement) {
-			MovementParams& mv = Gameplay::Of(e).GetMovementParams();
-			mv.enabled            = true;
-			mv.movementType       = def->movementType;
-			mv.moveSpeed          = def->moveSpeed;
-			mv.hoverApproachSpeed = def->hoverApproachSpeed;
-			mv.hoverHoldDuration  = def->hoverHoldDuration;
-		}
-		if (def->hasCharge) {
-			ChargeParams& chp = Gameplay::Of(e).GetChargeParams();
-			chp.enabled    = true;
-			chp.stage1Time = def->chargeStage1Time;
-			chp.stage2Time = def->chargeStage2Time;
-			chp.fireRate   = def->chargeFireRate;
-		}
-		if (def->hasPrecision) {
-			PrecisionParams& pp = Gameplay::Of(e).GetPrecisionParams();
-			pp.enabled   = true;
-			pp.speedAdd  = def->precisionSpeedAdd;
-			pp.homingAdd = def->precisionHomingAdd;
-		}
-		if (def->hasWeapon) {
-			WeaponParams& wp = Gameplay::Of(e).GetWeaponParams();
-			wp.enabled         = def->weaponEnabled;
-			wp.bone            = def->weaponBone;
-			wp.offsetTranslate = def->weaponOffsetTranslate;
-			wp.offsetRotate    = def->weaponOffsetRotate;
-			wp.offsetScale     = def->weaponOffsetScale;
-			wp.modelDir        = def->weaponModelDir;
-			wp.modelFile       = def->weaponModelFile;
-		}
-		// エフェクトスロットを丸ごとコピー
-		if (!def->effects.empty()) {
-			Gameplay::Of(e).GetEffects() = def->effects;
-		}
-		// 弾プレハブスロットを丸ごとコピー
-		if (!def->bulletPrefabs.empty()) {
-			Gameplay::Of(e).GetBulletPrefabs() = def->bulletPrefabs;
-		}
-	};
-
 	const std::string base = def->name.empty() ? std::string("PrefabInstance") : def->name;
 
 	if (def->kind == PrefabKind::Primitive) {
@@ -207,14 +107,11 @@ IImGuiEditable* GameScene::InstantiatePrefab(const std::string& prefabName, cons
 			name = base + " (" + std::to_string(suffix++) + ")";
 		}
 		back->SetName(name);
-		Gameplay::Of(back).SetTag(def->tag);
-		Gameplay::Of(back).SetPrefabName(prefabName);
 		back->ApplyPrefabParams(def->primitiveParams);
 		back->SetScale(def->defaultScale);
 		back->SetRotate(def->defaultRotate);
 		back->SetTranslate(worldPos);
-		if (def->hasCollider) applyCollider(Gameplay::Of(back).GetCollider());
-		applyHPAndDamage(back.get());
+		PrefabManager::ApplyGameplayComponents(*def, prefabName, Gameplay::Of(back));
 		return back.get();
 	} else if (def->kind == PrefabKind::Animated || def->isAnimated) {
 		AddDynamicAnimated(def->modelDir, def->modelFile, worldPos);
@@ -228,12 +125,9 @@ IImGuiEditable* GameScene::InstantiatePrefab(const std::string& prefabName, cons
 			name = base + " (" + std::to_string(suffix++) + ")";
 		}
 		back->SetName(name);
-		Gameplay::Of(back).SetTag(def->tag);
-		Gameplay::Of(back).SetPrefabName(prefabName);
 		back->SetScale(def->defaultScale);
 		back->SetRotate(def->defaultRotate);
-		if (def->hasCollider) applyCollider(Gameplay::Of(back).GetCollider());
-		applyHPAndDamage(back.get());
+		PrefabManager::ApplyGameplayComponents(*def, prefabName, Gameplay::Of(back));
 		return back.get();
 	} else {
 		AddDynamicObject(def->modelDir, def->modelFile, worldPos);
@@ -247,12 +141,9 @@ IImGuiEditable* GameScene::InstantiatePrefab(const std::string& prefabName, cons
 			name = base + " (" + std::to_string(suffix++) + ")";
 		}
 		back->SetName(name);
-		Gameplay::Of(back).SetTag(def->tag);
-		Gameplay::Of(back).SetPrefabName(prefabName);
 		back->SetScale(def->defaultScale);
 		back->SetRotate(def->defaultRotate);
-		if (def->hasCollider) applyCollider(Gameplay::Of(back).GetCollider());
-		applyHPAndDamage(back.get());
+		PrefabManager::ApplyGameplayComponents(*def, prefabName, Gameplay::Of(back));
 		return back.get();
 	}
 }
@@ -456,12 +347,28 @@ void GameScene::UpdateEnemyControllers(float deltaTime, IImGuiEditable* player,
 void GameScene::SpawnEnemyBullet(const Vector3& pos, const Vector3& direction,
 	float speed, float lifetime, const std::string& prefabName,
 	IImGuiEditable* homingTarget, float homingStrength) {
-	// 引数が負数ならプレハブの "bullet" セクションから読み込む
-	if (const PrefabDef* def = PrefabManager::GetInstance()->Find(prefabName)) {
-		if (def->hasBullet) {
-			if (speed          < 0.0f) speed          = def->bulletSpeed;
-			if (lifetime       < 0.0f) lifetime       = def->bulletLifetime;
-			if (homingStrength < 0.0f) homingStrength = def->bulletHomingStrength;
+	const BulletArchetypeId archetype = bulletPool_.ResolveArchetype(prefabName);
+	if (archetype == kInvalidBulletArchetype) {
+		LogBuffer::Instance().Add(
+			std::string("SpawnEnemyBullet: prefab not spawned as primitive: ") + prefabName,
+			LogBuffer::Level::Warning);
+		return;
+	}
+	SpawnEnemyBullet(pos, direction, speed, lifetime, archetype, homingTarget, homingStrength);
+}
+
+void GameScene::SpawnEnemyBullet(const Vector3& pos, const Vector3& direction,
+	float speed, float lifetime, BulletArchetypeId archetype,
+	IImGuiEditable* homingTarget, float homingStrength) {
+	if (!bulletPool_.RefreshArchetype(archetype)) return;
+
+	// 引数が負数ならプレハブの "bullet" セクション（アーキタイプのテンプレートに焼いたもの）から埋める
+	if (const GameplayComponents* tmpl = bulletPool_.GetArchetypeComponents(archetype)) {
+		const BulletParams& bp = tmpl->GetBulletParams();
+		if (bp.enabled) {
+			if (speed          < 0.0f) speed          = bp.speed;
+			if (lifetime       < 0.0f) lifetime       = bp.lifetime;
+			if (homingStrength < 0.0f) homingStrength = bp.homingStrength;
 		}
 	}
 	// プレハブに bullet 指定がなければデフォルトにフォールバック
@@ -469,38 +376,21 @@ void GameScene::SpawnEnemyBullet(const Vector3& pos, const Vector3& direction,
 	if (lifetime       < 0.0f) lifetime       = 4.0f;
 	if (homingStrength < 0.0f) homingStrength = 0.0f;
 
-	const size_t prevCount = dynamicPrimitives_.size();
-	InstantiatePrefab(prefabName, pos);
-	if (dynamicPrimitives_.size() != prevCount + 1) {
-		LogBuffer::Instance().Add(
-			std::string("SpawnEnemyBullet: prefab not spawned as primitive: ") + prefabName,
-			LogBuffer::Level::Warning);
-		return;
-	}
+	BulletSpawnDesc desc{};
+	desc.position       = pos;
+	desc.direction      = direction;
+	desc.speed          = speed;
+	desc.lifetime       = lifetime;
+	desc.homingTarget   = Gameplay::HandleOf(homingTarget);
+	desc.homingStrength = homingStrength;
+	bulletPool_.Spawn(archetype, desc);
+}
 
-	const Vector3 vel{ direction.x * speed, direction.y * speed, direction.z * speed };
-	PrimitiveInstance* spawned = dynamicPrimitives_.back().get();
-	if (spawned) {
-		spawned->Update();
-		Gameplay::Of(spawned).GetCollider().onCollision = [this, spawned](IImGuiEditable* other) {
-			if (!other) return;
-			if (Gameplay::Of(other).GetTag() != EntityTag::Player) return;
-			for (auto& b : bullets_) {
-				if (b.primitive == spawned) b.remainingLifetime = -1.0f;
-			}
-		};
+BulletArchetypeId GameScene::GetEnemyBulletArchetype() {
+	if (enemyBulletArchetype_ == kInvalidBulletArchetype) {
+		enemyBulletArchetype_ = bulletPool_.ResolveArchetype("EnemyBullet");
 	}
-
-	BulletRuntime br{};
-	br.primitive         = spawned;
-	br.velocity          = vel;
-	br.speed             = speed;
-	br.remainingLifetime = lifetime;
-	br.originPos         = pos;
-	br.homingTarget      = homingTarget;
-	br.homingStrength    = homingStrength;
-	if (spawned) br.baseColliderRadius = Gameplay::Of(spawned).GetCollider().radius;
-	bullets_.push_back(br);
+	return enemyBulletArchetype_;
 }
 
 IImGuiEditable* GameScene::SpawnEnemyAt(const std::string& prefabName, const Vector3& pos) {
@@ -575,22 +465,16 @@ void GameScene::DestroyDynamicEntity(IImGuiEditable* e) {
 	for (auto& ctrl : enemyControllers_) {
 		if (ctrl && ctrl->entity_ == e) ctrl->entity_ = nullptr;
 	}
-	for (auto& b : bullets_) {
-		if (b.homingTarget == e) b.homingTarget = nullptr;
-		if (b.penetrate) b.hitCooldowns.erase(e);
-	}
-	for (auto& m : melees_) {
-		if (m.owner == e) m.owner = nullptr;
-		m.hitTargets.erase(e);
-	}
+	// 弾 / melees_ のターゲット・owner・ヒット済み集合は EntityHandle で持つので掃除不要
+	// （破棄で世代が進み、古いハンドルは Gameplay::Resolve で nullptr になる）
 
-	// e が動的プリミティブなら、それを primitive として参照する弾・近接も掃除
+	// 弾はプールのスロットなので、破棄要求は消滅予約に読み替える
+	if (bulletPool_.KillEntity(e)) return;
+
+	// e が動的プリミティブなら、それを primitive として参照する近接も掃除
 	for (const auto& p : dynamicPrimitives_) {
 		if (static_cast<IImGuiEditable*>(p.get()) == e) {
 			PrimitiveInstance* prim = p.get();
-			for (auto& b : bullets_) {
-				if (b.primitive == prim) b.remainingLifetime = -1.0f;
-			}
 			for (auto& m : melees_) {
 				if (m.primitive == prim) { m.remainingLifetime = -1.0f; m.primitive = nullptr; }
 			}
@@ -622,112 +506,75 @@ void GameScene::SpawnPlayerBullet(const Vector3& pos, const Vector3& direction,
 	float maxTravelDistance,
 	const std::string& prefabName,
 	int attackPower) {
-	const size_t prevCount = dynamicPrimitives_.size();
-	InstantiatePrefab(prefabName, pos);
-	if (dynamicPrimitives_.size() != prevCount + 1) {
+	const BulletArchetypeId archetype = bulletPool_.ResolveArchetype(prefabName);
+	if (archetype == kInvalidBulletArchetype) {
 		// プレハブが Primitive 種別でなかった、または見つからなかった
 		LogBuffer::Instance().Add(
 			std::string("SpawnPlayerBullet: prefab not spawned as primitive: ") + prefabName,
 			LogBuffer::Level::Warning);
 		return;
 	}
+	SpawnPlayerBullet(pos, direction, speed, lifetime, colliderGrowthPerMeter,
+		homingTarget, homingStrength, maxTravelDistance, archetype, attackPower);
+}
 
-	// velocity = direction * speed（direction は呼び出し側が正規化済みの前提）
-	const Vector3 vel{ direction.x * speed, direction.y * speed, direction.z * speed };
-
-	// 弾プレハブの貫通設定を読む
-	bool        penetrate = false;
-	float       penetrateDamageRate = 0.2f;
-	std::string penetrateEffect;
-	if (const PrefabDef* bdef = PrefabManager::GetInstance()->Find(prefabName); bdef && bdef->hasBullet) {
-		penetrate           = bdef->bulletPenetrate;
-		penetrateDamageRate = bdef->bulletPenetrateDamageRate;
-		penetrateEffect     = bdef->bulletPenetrateEffect;
+void GameScene::SpawnPlayerBullet(const Vector3& pos, const Vector3& direction,
+	float speed, float lifetime, float colliderGrowthPerMeter,
+	IImGuiEditable* homingTarget, float homingStrength,
+	float maxTravelDistance,
+	BulletArchetypeId archetype,
+	int attackPower) {
+	if (!bulletPool_.RefreshArchetype(archetype)) return;
+
+	BulletSpawnDesc desc{};
+	desc.position               = pos;
+	desc.direction              = direction; // 呼び出し側が正規化済みの前提
+	desc.speed                  = speed;
+	desc.lifetime               = lifetime;
+	desc.colliderGrowthPerMeter = colliderGrowthPerMeter;
+	desc.homingTarget           = Gameplay::HandleOf(homingTarget);
+	desc.homingStrength         = homingStrength;
+	desc.maxTravelDistance      = maxTravelDistance;
+	desc.playerOwned            = true;
+
+	// プレイヤー攻撃力 × プレハブの倍率で最終ダメージを確定（発射時に焼き込む）
+	if (const GameplayComponents* tmpl = bulletPool_.GetArchetypeComponents(archetype)) {
+		const DamageDealer& dd = tmpl->GetDamageDealer();
+		if (dd.enabled) desc.damage = static_cast<int>(static_cast<float>(attackPower) * dd.multiplier);
 	}
+	bulletPool_.Spawn(archetype, desc);
+}
 
-	const Vector3 bulletEuler = DirectionToEuler(direction);
+void GameScene::OnBulletHit(uint32_t slot, IImGuiEditable* other) {
+	if (!other) return;
+	const EntityTag otherTag = Gameplay::Of(other).GetTag();
 
-	int penetrateDamage = 0;
-	PrimitiveInstance* spawned = dynamicPrimitives_.back().get();
-	if (spawned) {
-		// 進行方向に弾の向きを合わせる
-		spawned->SetRotate(bulletEuler);
-		spawned->Update();
-
-		// プレイヤー攻撃力 × プレハブの倍率で最終ダメージを確定（発射時に焼き込む）
-		DamageDealer& dd = Gameplay::Of(spawned).GetDamageDealer();
-		if (dd.enabled) {
-			dd.damage = static_cast<int>(static_cast<float>(attackPower) * dd.multiplier);
-			penetrateDamage = dd.damage;
-			// 貫通弾は CollisionManager の毎フレーム自動ダメージを無効化し、onCollision で damageRate 制御する
-			if (penetrate) {
-				dd.enabled = false;
-			}
-		}
-
-		// 敵に当たったときの処理。実ダメージ適用は通常弾=CollisionManager / 貫通弾=ここで手動。
-		Gameplay::Of(spawned).GetCollider().onCollision = [this, spawned](IImGuiEditable* other) {
-			if (!other) return;
-			const EntityTag tag = Gameplay::Of(other).GetTag();
-			if (tag != EntityTag::Enemy && tag != EntityTag::Boss) return;
+	// 敵弾：自機に当たったら消滅（被弾処理は StagePlayScene 側の距離判定）
+	if (!bulletPool_.IsPlayerOwned(slot)) {
+		if (otherTag == EntityTag::Player) bulletPool_.Kill(slot);
+		return;
+	}
 
-			Vector3 hitPos{ 0.0f, 0.0f, 0.0f };
-			if (const Vector3* t = spawned->GetEditableTranslate()) {
-				hitPos = *t;
-			}
+	// プレイヤー弾：敵に当たったときの処理。実ダメージ適用は通常弾=CollisionManager / 貫通弾=ここで手動。
+	if (otherTag != EntityTag::Enemy && otherTag != EntityTag::Boss) return;
 
-			for (auto& b : bullets_) {
-				if (b.primitive != spawned) continue;
-				if (b.penetrate) {
-					// 貫通：damageRate クールタイムが切れていればダメージ + ヒットエフェクト
-					auto it = b.hitCooldowns.find(other);
-					const float cd = (it != b.hitCooldowns.end()) ? it->second : 0.0f;
-					if (cd <= 0.0f) {
-						if (Gameplay::Of(other).GetHP().enabled) {
-							Gameplay::Of(other).GetHP().TakeDamage(b.penetrateDamage);
-						}
-						// 攻撃側の "hit" ＋ 被弾側（敵）の "hurt" を再生
-						PlayHitEffects(spawned, other, hitPos);
-						b.hitCooldowns[other] = b.penetrateDamageRate;
-					}
-					// 貫通弾は消えない
-				} else {
-					// 通常弾：攻撃側の "hit" ＋ 被弾側（敵）の "hurt" を再生 + 死亡フラグ（実ダメージは CollisionManager 側）
-					PlayHitEffects(spawned, other, hitPos);
-					b.remainingLifetime = -1.0f;
-				}
-				break;
+	IImGuiEditable* bullet = bulletPool_.EntityOf(slot);
+	const Vector3 hitPos = bulletPool_.PositionOf(slot);
+	if (bulletPool_.IsPenetrating(slot)) {
+		// 貫通：damageRate クールタイムが切れていればダメージ + ヒットエフェクト（弾は消えない）
+		if (bulletPool_.TryPenetrateHit(slot, Gameplay::HandleOf(other))) {
+			if (Gameplay::Of(other).GetHP().enabled) {
+				Gameplay::Of(other).GetHP().TakeDamage(bulletPool_.PenetrateDamageOf(slot));
 			}
-			// HPゼロの敵は SweepDeadEntities が後で破棄する
-		};
-	}
-
-	BulletRuntime br{};
-	br.primitive = spawned;
-	br.velocity = vel;
-	br.speed = speed;
-	br.remainingLifetime = lifetime;
-	br.originPos = pos;
-	br.baseColliderRadius = spawned ? Gameplay::Of(spawned).GetCollider().radius : 0.0f;
-	br.colliderGrowthPerMeter = colliderGrowthPerMeter;
-	br.homingTarget = homingTarget;
-	br.homingStrength = homingStrength;
-	br.maxTravelDistance = maxTravelDistance;
-	br.penetrate = penetrate;
-	br.penetrateDamageRate = penetrateDamageRate;
-	br.penetrateEffect = penetrateEffect;
-	br.penetrateDamage = penetrateDamage;
-
-	// 弾追従エフェクト（trail スロット、ループ前提）を再生。弾消滅時に Stop する。
-	if (spawned) {
-		const std::string trailEff = Gameplay::Of(spawned).FindEffect("trail");
-		if (!trailEff.empty()) {
-			br.trailEffectHandle = EffectManager::GetInstance()->Play(trailEff, pos);
-			// エフェクトの向きを弾の進行方向に合わせる
-			EffectManager::GetInstance()->SetRotation(br.trailEffectHandle, bulletEuler);
+			// 攻撃側の "hit" ＋ 被弾側（敵）の "hurt" を再生
+			PlayHitEffects(bullet, other, hitPos);
 		}
+	} else {
+		// 通常弾：攻撃側の "hit" ＋ 被弾側（敵）の "hurt" を再生 + 死亡フラグ（実ダメージは CollisionManager 側）
+		PlayHitEffects(bullet, other, hitPos);
+		bulletPool_.Kill(slot);
 	}
-	bullets_.push_back(br);
+	// HPゼロの敵は SweepDeadEntities が後で破棄する
 }
 
 void GameScene::SpawnPlayerMelee(IImGuiEditable* owner,
@@ -830,8 +677,7 @@ void GameScene::SpawnPlayerMelee(IImGuiEditable* owner,
 
 		for (auto& m : melees_) {
 			if (m.primitive != spawned) continue;
-			if (m.hitTargets.count(other)) return; // この判定では既に当てた敵
-			m.hitTargets.insert(other);
+			if (!m.hitTargets.insert(Gameplay::HandleOf(other)).second) return; // この判定では既に当てた敵
 
 			if (Gameplay::Of(other).GetHP().enabled) {
 				const int dmg = (m.elapsed <= m.cleanWindow) ? m.cleanDamage : m.lateDamage;
@@ -848,7 +694,7 @@ void GameScene::SpawnPlayerMelee(IImGuiEditable* owner,
 
 	MeleeRuntime mr{};
 	mr.primitive = spawned;
-	mr.owner = owner;
+	mr.owner = Gameplay::HandleOf(owner);
 	mr.worldOffset = followOffset; // 追従にも持ち上げ分を含める（足元へ戻らないように）
 	mr.remainingLifetime = activeDuration;
 	mr.elapsed = 0.0f;
@@ -887,7 +733,7 @@ void GameScene::SweepDeadEntities() {
 	for (auto& o : object3DInstances_) collect(o.get());
 	for (auto& a : dynamicAnimated_)   collect(a.get());
 
-	// DestroyDynamicEntity が movingEnemies_ / bullets_.homingTarget も
+	// DestroyDynamicEntity が movingEnemies_ / enemyControllers_ の参照も
 	// 安全にクリアしてくれるので、こちらを経由して破棄する。
 	for (IImGuiEditable* e : dead) {
 		// 死亡エフェクト（"death" スロット）を破棄直前の位置で再生
@@ -903,126 +749,8 @@ void GameScene::SweepDeadEntities() {
 }
 
 void GameScene::UpdateBullets(float deltaTime) {
-	if (bullets_.empty()) return;
-
-	for (auto& b : bullets_) {
-		if (!b.primitive) continue;
-
-		// 貫通弾の多段ヒット用クールタイムを減算
-		if (b.penetrate) {
-			for (auto& kv : b.hitCooldowns) {
-				kv.second -= deltaTime;
-			}
-		}
-
-		Vector3* t = b.primitive->GetEditableTranslate();
-		if (!t) {
-			b.remainingLifetime -= deltaTime;
-			continue;
-		}
-
-		// ----- ホーミング（target が生きていれば velocity を target 方向へ補正） -----
-		// 弾速の大きさは保持し、方向だけを target に向けて指数減衰で寄せる。
-		if (b.homingTarget && b.homingStrength > 0.0f && b.speed > 0.0f) {
-			const Vector3* tp = b.homingTarget->GetEditableTranslate();
-			if (tp) {
-				const float dx = tp->x - t->x;
-				const float dy = tp->y - t->y;
-				const float dz = tp->z - t->z;
-				const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-				if (dist > 1e-4f) {
-					const float wantedX = dx / dist;
-					const float wantedY = dy / dist;
-					const float wantedZ = dz / dist;
-					const float curX = b.velocity.x / b.speed;
-					const float curY = b.velocity.y / b.speed;
-					const float curZ = b.velocity.z / b.speed;
-					const float alpha = 1.0f - std::exp(-b.homingStrength * deltaTime);
-					float nx = curX + (wantedX - curX) * alpha;
-					float ny = curY + (wantedY - curY) * alpha;
-					float nz = curZ + (wantedZ - curZ) * alpha;
-					const float nlen = std::sqrt(nx * nx + ny * ny + nz * nz);
-					if (nlen > 1e-6f) {
-						nx /= nlen; ny /= nlen; nz /= nlen;
-						b.velocity = { nx * b.speed, ny * b.speed, nz * b.speed };
-					}
-				}
-			} else {
-				// target が消えた（コライダー側で destroy 等）→ ホーミング解除
-				b.homingTarget = nullptr;
-			}
-		}
-
-		// 移動
-		t->x += b.velocity.x * deltaTime;
-		t->y += b.velocity.y * deltaTime;
-		t->z += b.velocity.z * deltaTime;
-
-		// 進行方向に弾とエフェクトの向きを合わせる（ホーミングで方向が変わるため毎フレーム更新）
-		if (b.speed > 1e-4f) {
-			const Vector3 d{ b.velocity.x / b.speed, b.velocity.y / b.speed, b.velocity.z / b.speed };
-			const Vector3 rot = DirectionToEuler(d);
-			b.primitive->SetRotate(rot);
-			if (b.trailEffectHandle != 0) {
-				EffectManager::GetInstance()->SetRotation(b.trailEffectHandle, rot);
-			}
-#ifdef USE_IMGUI
-			// デバッグ：プレイヤー弾の進行方向に線を表示（黄色）
-			if (Gameplay::Of(b.primitive).GetTag() == EntityTag::PlayerBullet) {
-				DebugDraw::Ray(*t, d, 5.0f, { 1.0f, 1.0f, 0.0f, 1.0f });
-			}
-#endif
-		}
-
-		// trail エフェクトを弾位置に追従
-		if (b.trailEffectHandle != 0) {
-			EffectManager::GetInstance()->SetPosition(b.trailEffectHandle, *t);
-		}
-
-		// 進行距離（colliderGrowth と maxTravelDistance の両方で使う）
-		float traveled = 0.0f;
-		if (b.colliderGrowthPerMeter > 0.0f || b.maxTravelDistance > 0.0f) {
-			const float dx = t->x - b.originPos.x;
-			const float dy = t->y - b.originPos.y;
-			const float dz = t->z - b.originPos.z;
-			traveled = std::sqrt(dx * dx + dy * dy + dz * dz);
-		}
-
-		// 進行距離に応じて collider 半径を拡大（STG 的「遠距離ほど判定太く」）
-		if (b.colliderGrowthPerMeter > 0.0f) {
-			Gameplay::Of(b.primitive).GetCollider().radius =
-				b.baseColliderRadius + traveled * b.colliderGrowthPerMeter;
-		}
-
-		// 最大到達距離（aim plane）を超えたら消滅
-		if (b.maxTravelDistance > 0.0f && traveled >= b.maxTravelDistance) {
-			b.remainingLifetime = -1.0f;
-		} else {
-			b.remainingLifetime -= deltaTime;
-		}
-	}
-
-	// 寿命切れの弾を削除：bullets_ から外し、対応する dynamicPrimitives_ も deferredDeletes_ へ
-	for (auto it = bullets_.begin(); it != bullets_.end();) {
-		if (it->remainingLifetime > 0.0f && it->primitive) {
-			++it;
-			continue;
-		}
-		// 弾消滅と同時に trail エフェクトを停止
-		if (it->trailEffectHandle != 0) {
-			EffectManager::GetInstance()->Stop(it->trailEffectHandle);
-			it->trailEffectHandle = 0;
-		}
-		// 該当 primitive を dynamicPrimitives_ から取り出す
-		PrimitiveInstance* dead = it->primitive;
-		auto pit = std::find_if(dynamicPrimitives_.begin(), dynamicPrimitives_.end(),
-			[dead](const std::unique_ptr<PrimitiveInstance>& p) { return p.get() == dead; });
-		if (pit != dynamicPrimitives_.end()) {
-			deferredDeletes_.emplace_back(std::shared_ptr<PrimitiveInstance>(pit->release()));
-			dynamicPrimitives_.erase(pit);
-		}
-		it = bullets_.erase(it);
-	}
+	// ホーミング・移動・向き・trail 追従・collider 拡大・寿命と、寿命切れの回収はプール内で 1 パスに済ませる
+	bulletPool_.Update(deltaTime);
 }
 
 void GameScene::UpdateMelees(float deltaTime) {
@@ -1033,8 +761,8 @@ void GameScene::UpdateMelees(float deltaTime) {
 		m.remainingLifetime -= deltaTime;
 
 		// owner（自機）に追従：毎フレーム owner 位置 + worldOffset へ配置（判定＋振りエフェクト）
-		if (m.owner) {
-			if (const Vector3* op = m.owner->GetEditableTranslate()) {
+		if (IImGuiEditable* owner = Gameplay::Resolve(m.owner)) {
+			if (const Vector3* op = owner->GetEditableTranslate()) {
 				const Vector3 pos{ op->x + m.worldOffset.x, op->y + m.worldOffset.y, op->z + m.worldOffset.z };
 				if (m.primitive) {
 					if (Vector3* t = m.primitive->GetEditableTranslate()) {
@@ -1288,6 +1016,38 @@ std::string GameScene::SerializeSceneToString() const {
 	return SceneSerializer::ToString(data);
 }
 
+void GameScene::PrefetchSceneAssets(const SceneData& data) const {
+	// 読み込みリストが決まった時点で OS にページを取りに行かせ、
+	// ApplySceneData 内の Open / View でページフォールトを待たずに済むようにする。
+	// .mesh が参照する .mat / テクスチャはここでは分からないので、ローダー側の読み出しに任せる。
+	std::vector<std::string> paths;
+	paths.reserve(data.entities.size());
+	for (const auto& d : data.entities) {
+		if (ShouldSkipOnLoad(d)) continue;
+		switch (d.kind) {
+		case SceneEntityDesc::Kind::Object3D:
+		case SceneEntityDesc::Kind::AnimatedObject3D:
+			paths.push_back(d.dir + "/" + d.file);
+			break;
+		case SceneEntityDesc::Kind::Primitive:
+		case SceneEntityDesc::Kind::Sprite:
+			if (!d.texture.empty()) paths.push_back(d.texture);
+			break;
+		case SceneEntityDesc::Kind::Prefab:
+			if (const PrefabDef* def = PrefabManager::GetInstance()->Find(d.prefabName)) {
+				if (!def->modelFile.empty()) paths.push_back(def->modelDir + "/" + def->modelFile);
+				if (!def->primitiveParams.texturePath.empty()) paths.push_back(def->primitiveParams.texturePath);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+	paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+	AssetLocator::GetInstance()->Prefetch(paths);
+}
+
 bool GameScene::LoadSceneFromJson(const std::string& filePath) {
 	// 先に読み切る。パースに失敗した時点で return するので、
 	// 書き込み途中のファイルを掴んでも現在のシーンは壊れない。
@@ -1299,6 +1059,7 @@ bool GameScene::LoadSceneFromJson(const std::string& filePath) {
 		return false;
 	}
 
+	PrefetchSceneAssets(data);
 	ClearDynamicEntities();
 	OnBeforeSceneLoad();
 	ApplySceneData(data);
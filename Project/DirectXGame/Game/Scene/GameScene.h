@@ -1,6 +1,8 @@
 #pragma once
 #include "Scene.h"
 #include "SceneSerializer.h"   // SceneData / SceneEntityDesc（保存・読込のフックで使う）
+#include "Components/EntityHandle.h"
+#include "Components/BulletPool.h"
 
 #include <memory>
 #include <string>
@@ -54,6 +56,17 @@ public:
 		const std::string& prefabName = "TemporaryPlayerBullet",
 		int attackPower = 0);
 
+	/// <summary>上と同じ。解決済みのアーキタイプで撃つ版（スポーンのたびにプレハブ名を引かない）。</summary>
+	void SpawnPlayerBullet(const Vector3& pos, const Vector3& direction,
+		float speed, float lifetime, float colliderGrowthPerMeter,
+		IImGuiEditable* homingTarget, float homingStrength,
+		float maxTravelDistance,
+		BulletArchetypeId archetype,
+		int attackPower);
+
+	/// <summary>弾プレハブ名 → アーキタイプ ID。連射する側は 1 回だけ解決して控え、ID で Spawn*Bullet を呼ぶ。</summary>
+	BulletArchetypeId ResolveBulletArchetype(const std::string& prefabName) { return bulletPool_.ResolveArchetype(prefabName); }
+
 	/// <summary>
 	/// プレイヤー近接攻撃の判定を1つスポーン。owner に追従させて持続させる。
 	/// </summary>
@@ -88,6 +101,19 @@ public:
 		IImGuiEditable* homingTarget = nullptr,
 		float homingStrength = -1.0f);
 
+	/// <summary>
+	/// 上と同じ。解決済みのアーキタイプで撃つ版。負数の speed / lifetime / homingStrength は
+	/// アーキタイプが持つプレハブの BulletParams から埋める（プレハブを名前で引かない）。
+	/// </summary>
+	void SpawnEnemyBullet(const Vector3& pos, const Vector3& direction,
+		float speed, float lifetime,
+		BulletArchetypeId archetype,
+		IImGuiEditable* homingTarget = nullptr,
+		float homingStrength = -1.0f);
+
+	/// <summary>既定の敵弾プレハブ（"EnemyBullet"）のアーキタイプ。初回だけ名前で解決し、以降は控えを返す。</summary>
+	BulletArchetypeId GetEnemyBulletArchetype();
+
 	/// <summary>指定プレハブをスプラインなしで指定座標に直接スポーンする。</summary>
 	IImGuiEditable* SpawnEnemyAt(const std::string& prefabName, const Vector3& pos);
 
@@ -144,6 +170,9 @@ protected:
 	/// <summary>SceneData → 全コンテナ。ShouldSkipOnLoad で除外できる。</summary>
 	void ApplySceneData(const SceneData& data);
 
+	/// <summary>SceneData が読むモデル・テクスチャを AssetLocator に先読みさせる（pack (mmap) モードのみ効く）。</summary>
+	void PrefetchSceneAssets(const SceneData& data) const;
+
 	/// <summary>動的エンティティを全て deferredDeletes_ へ退避してコンテナを空にする。</summary>
 	void ClearDynamicEntities();
 
@@ -166,29 +195,19 @@ protected:
 	/// <summary>動的スプラインの DebugDraw キュー積み。</summary>
 	void DrawDynamicSplinesDebug();
 
-	struct BulletRuntime {
-		PrimitiveInstance* primitive = nullptr; // dynamicPrimitives_ 内の生ポインタ
-		Vector3 velocity{ 0.0f, 0.0f, 0.0f };
-		float speed = 0.0f;
-		float remainingLifetime = 0.0f;
-		Vector3 originPos{ 0.0f, 0.0f, 0.0f };
-		float baseColliderRadius = 0.0f;
-		float colliderGrowthPerMeter = 0.0f;
-		IImGuiEditable* homingTarget = nullptr;
-		float homingStrength = 0.0f;
-		float maxTravelDistance = 0.0f;
-		bool        penetrate = false;
-		float       penetrateDamageRate = 0.2f;
-		std::string penetrateEffect;
-		int         penetrateDamage = 0;
-		std::unordered_map<IImGuiEditable*, float> hitCooldowns;
-		uint64_t    trailEffectHandle = 0;
-	};
-	std::vector<BulletRuntime> bullets_;
+	/// <summary>
+	/// 弾がコライダーに当たったときの処理（BulletPool の HitHandler）。
+	/// 敵弾は自機に当たったら消滅、プレイヤー弾は敵/ボスに当たったらヒット演出＋消滅（貫通弾は damageRate 間隔で手動ダメージ）。
+	/// </summary>
+	void OnBulletHit(uint32_t slot, IImGuiEditable* other);
+
+	// 敵弾・プレイヤー弾（dynamicPrimitives_ には入れず、プール内のスロットとして持つ）
+	BulletPool bulletPool_;
+	BulletArchetypeId enemyBulletArchetype_ = kInvalidBulletArchetype; // GetEnemyBulletArchetype の控え
 
 	struct MeleeRuntime {
 		PrimitiveInstance* primitive = nullptr;
-		IImGuiEditable* owner = nullptr;
+		EntityHandle owner{};
 		Vector3 worldOffset{ 0.0f, 0.0f, 0.0f };
 		float remainingLifetime = 0.0f;
 		float elapsed = 0.0f;
@@ -196,7 +215,7 @@ protected:
 		int   cleanDamage = 0;
 		int   lateDamage = 0;
 		uint64_t    swingEffectHandle = 0;
-		std::unordered_set<IImGuiEditable*> hitTargets;
+		std::unordered_set<EntityHandle> hitTargets;
 	};
 	std::vector<MeleeRuntime> melees_;
 
@@ -8,6 +8,7 @@
 #include "Enemy/EnemyCommandFactory.h"
 #include "Enemy/EnemyController.h"
 #include "IImGuiEditable.h"
+#include "Json/JsonDocument.h"
 #include "Json/JsonValue.h"
 #include "LogBuffer.h"
 #include "MathUtility.h"
@@ -463,20 +464,20 @@ float RailStagePart::GetStageSeconds() const {
 	return (railCameraSpeed_ > 1e-8f) ? (t / railCameraSpeed_) : 0.0f;
 }
 
-void RailStagePart::LoadFromJson(const JsonValue& root) {
+void RailStagePart::LoadFromJson(const JsonNode& root) {
 	railCameraSpeed_ = static_cast<float>(
 		root["camera"]["speed"].AsDouble(railCameraSpeed_));
 	{
 		// レールカメラ向きキーの復元
-		const JsonValue& keys = root["camera"]["rotKeys"];
+		const JsonNode& keys = root["camera"]["rotKeys"];
 		if (keys.IsArray()) {
 			cameraRotKeys_.clear();
 			for (size_t i = 0; i < keys.Size(); ++i) {
-				const JsonValue& ko = keys[i];
+				const JsonNode& ko = keys[i];
 				auto key = std::make_unique<CameraRotKey>();
 				key->t = static_cast<float>(ko["t"].AsDouble(0.0));
 
-				const JsonValue& rot = ko["rotate"];
+				const JsonNode& rot = ko["rotate"];
 				if (rot.IsArray() && rot.Size() >= 3) {
 					key->rotate = {
 						static_cast<float>(rot[0].AsDouble(0.0)),
@@ -485,14 +486,14 @@ void RailStagePart::LoadFromJson(const JsonValue& root) {
 					};
 				}
 
-				const JsonValue& ease = ko["ease"];
+				const JsonNode& ease = ko["ease"];
 				if (ease.IsObject()) {
 					key->easeToNext.enabled = ease["enabled"].AsBool(false);
-					const JsonValue& pts = ease["points"];
+					const JsonNode& pts = ease["points"];
 					if (pts.IsArray() && pts.Size() >= 2) {
 						key->easeToNext.points.clear();
 						for (size_t j = 0; j < pts.Size(); ++j) {
-							const JsonValue& pr = pts[j];
+							const JsonNode& pr = pts[j];
 							if (pr.IsArray() && pr.Size() >= 2) {
 								key->easeToNext.points.push_back({
 									static_cast<float>(pr[0].AsDouble(0.0)),
@@ -17,6 +17,7 @@ class RailAimController;
 class IImGuiEditable;
 class EnemyController;
 class JsonValue;
+class JsonNode;
 
 /// <summary>
 /// RailStagePart が GameScene / StagePlayScene に対して必要とする操作だけを切り出した
@@ -111,7 +112,7 @@ public:
 	float GetStageSeconds() const;         // progress / speed。SeekMax比較・ImGui表示に使う
 
 	void OnImGuiTuning(bool& changed);      // "Rail Camera" + (_DEBUG) "Wave Editor"
-	void LoadFromJson(const JsonValue& root);   // root["camera"]（既存キー名を維持、データ非破壊）
+	void LoadFromJson(const JsonNode& root);   // root["camera"]（既存キー名を維持、データ非破壊）
 	void SaveToJson(JsonValue& root) const;
 
 	bool OnViewportPrefabDrop(const std::string& prefabName, float relX, float relY);
@@ -54,6 +54,7 @@
 #include "MouseInput.h"
 #endif
 #include "MathUtility.h"
+#include "Voronoi2D.h"
 #include "WindowsApplication.h"
 #include <algorithm>
 #include "Json/JsonValue.h"
@@ -82,11 +83,11 @@ StagePlayScene::~StagePlayScene() = default;
 
 void StagePlayScene::LoadTuningFromJson() {
 	if (!std::filesystem::exists(kStagePlayTuningPath)) return;
-	auto result = JsonParser::ParseFile(kStagePlayTuningPath);
+	auto result = JsonParser::ParseDocumentFile(kStagePlayTuningPath);
 	if (!result.success) return;
-	const JsonValue& root = result.value;
+	const JsonNode& root = result.document.Root();
 
-	const JsonValue& off = root["player"]["localOffset"];
+	const JsonNode& off = root["player"]["localOffset"];
 	if (off.IsArray() && off.Size() >= 3) {
 		playerLocalOffset_ = {
 			static_cast<float>(off[0].AsDouble(playerLocalOffset_.x)),
@@ -101,9 +102,9 @@ void StagePlayScene::LoadTuningFromJson() {
 		root["player"]["smoothTime"].AsDouble(playerSmoothTime_));
 
 	// ----- skybox -----
-	const JsonValue& sky = root["skybox"];
+	const JsonNode& sky = root["skybox"];
 	if (sky.IsObject()) {
-		const JsonValue& tint = sky["tint"];
+		const JsonNode& tint = sky["tint"];
 		if (tint.IsArray() && tint.Size() >= 4) {
 			skyboxTint_ = {
 				static_cast<float>(tint[0].AsDouble(skyboxTint_.x)),
@@ -112,7 +113,7 @@ void StagePlayScene::LoadTuningFromJson() {
 				static_cast<float>(tint[3].AsDouble(skyboxTint_.w)),
 			};
 		}
-		const JsonValue& dark = sky["specialDarkColor"];
+		const JsonNode& dark = sky["specialDarkColor"];
 		if (dark.IsArray() && dark.Size() >= 4) {
 			specialSkyboxDarkColor_ = {
 				static_cast<float>(dark[0].AsDouble(specialSkyboxDarkColor_.x)),
@@ -128,12 +129,12 @@ void StagePlayScene::LoadTuningFromJson() {
 		if (sky["bossPath"].IsString())    bossSkyboxPath_    = sky["bossPath"].AsString();
 	}
 
-	const JsonValue& spd = root["player"]["moveSpeed"];
+	const JsonNode& spd = root["player"]["moveSpeed"];
 	if (spd.IsArray() && spd.Size() >= 2) {
 		playerMoveSpeed_.x = static_cast<float>(spd[0].AsDouble(playerMoveSpeed_.x));
 		playerMoveSpeed_.y = static_cast<float>(spd[1].AsDouble(playerMoveSpeed_.y));
 	}
-	const JsonValue& mar = root["player"]["clipMargin"];
+	const JsonNode& mar = root["player"]["clipMargin"];
 	if (mar.IsArray() && mar.Size() >= 2) {
 		playerClipMargin_.x = static_cast<float>(mar[0].AsDouble(playerClipMargin_.x));
 		playerClipMargin_.y = static_cast<float>(mar[1].AsDouble(playerClipMargin_.y));
@@ -141,7 +142,7 @@ void StagePlayScene::LoadTuningFromJson() {
 
 
 	// ----- aim -----
-	const JsonValue& aim = root["aim"];
+	const JsonNode& aim = root["aim"];
 	if (aim.IsObject()) {
 		aimPlaneDistance_     = static_cast<float>(aim["planeDistance"].AsDouble(aimPlaneDistance_));
 		aimSmoothTime_        = static_cast<float>(aim["smoothTime"].AsDouble(aimSmoothTime_));
@@ -153,7 +154,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- damage / invincibility -----
-	const JsonValue& dmg = root["damage"];
+	const JsonNode& dmg = root["damage"];
 	if (dmg.IsObject()) {
 		playerInvincibilityDuration_  = static_cast<float>(dmg["invincibilityDuration"].AsDouble(playerInvincibilityDuration_));
 		shootLockoutDuration_         = static_cast<float>(dmg["shootLockoutDuration"].AsDouble(shootLockoutDuration_));
@@ -164,7 +165,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- dodge（回避）-----
-	const JsonValue& dodge = root["dodge"];
+	const JsonNode& dodge = root["dodge"];
 	if (dodge.IsObject()) {
 		dodgeJustWindow_     = static_cast<float>(dodge["justWindow"].AsDouble(dodgeJustWindow_));
 		dodgeIFrameDuration_ = static_cast<float>(dodge["iframeDuration"].AsDouble(dodgeIFrameDuration_));
@@ -175,14 +176,14 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- melee（近接：生成高さ・サイズ倍率）-----
-	const JsonValue& melee = root["melee"];
+	const JsonNode& melee = root["melee"];
 	if (melee.IsObject()) {
 		meleeOriginHeight_  = static_cast<float>(melee["originHeight"].AsDouble(meleeOriginHeight_));
 		meleeBossSizeScale_ = static_cast<float>(melee["bossSizeScale"].AsDouble(meleeBossSizeScale_));
 	}
 
 	// ----- justDodge（ジャスト回避スロー）-----
-	const JsonValue& jd = root["justDodge"];
+	const JsonNode& jd = root["justDodge"];
 	if (jd.IsObject()) {
 		justDodgeSlowWorld_     = static_cast<float>(jd["slowWorld"].AsDouble(justDodgeSlowWorld_));
 		justDodgeReceiptWindow_ = static_cast<float>(jd["receiptWindow"].AsDouble(justDodgeReceiptWindow_));
@@ -201,12 +202,12 @@ void StagePlayScene::LoadTuningFromJson() {
 		jdDodgeReturnDuration_   = static_cast<float>(jd["dodgeReturnDuration"].AsDouble(jdDodgeReturnDuration_));
 		bossFacingTurnSmoothTime_ = static_cast<float>(jd["bossFacingTurnSmooth"].AsDouble(bossFacingTurnSmoothTime_));
 		{
-			const JsonValue& em = jd["dodgeExpandedMargin"];
+			const JsonNode& em = jd["dodgeExpandedMargin"];
 			if (em.IsArray() && em.Size() >= 2) {
 				jdDodgeExpandedMargin_.x = static_cast<float>(em[0].AsDouble(jdDodgeExpandedMargin_.x));
 				jdDodgeExpandedMargin_.y = static_cast<float>(em[1].AsDouble(jdDodgeExpandedMargin_.y));
 			}
-			const JsonValue& mc = jd["meleeCamOffset"];
+			const JsonNode& mc = jd["meleeCamOffset"];
 			if (mc.IsArray() && mc.Size() >= 3) {
 				jdMeleeCameraOffset_ = {
 					static_cast<float>(mc[0].AsDouble(jdMeleeCameraOffset_.x)),
@@ -214,7 +215,7 @@ void StagePlayScene::LoadTuningFromJson() {
 					static_cast<float>(mc[2].AsDouble(jdMeleeCameraOffset_.z)),
 				};
 			}
-			const JsonValue& ml = jd["meleeCamLookOffset"];
+			const JsonNode& ml = jd["meleeCamLookOffset"];
 			if (ml.IsArray() && ml.Size() >= 3) {
 				jdMeleeCameraLookOffset_ = {
 					static_cast<float>(ml[0].AsDouble(jdMeleeCameraLookOffset_.x)),
@@ -223,13 +224,13 @@ void StagePlayScene::LoadTuningFromJson() {
 				};
 			}
 		}
-		const JsonValue& cpArr = jd["clonePaths"];
+		const JsonNode& cpArr = jd["clonePaths"];
 		if (cpArr.IsArray()) {
 			for (size_t i = 0; i < cpArr.Size() && i < 4; ++i) {
 				jdClonePath_[i] = cpArr[i].AsString(jdClonePath_[i]);
 			}
 		}
-		const JsonValue& cc = jd["cloneColor"];
+		const JsonNode& cc = jd["cloneColor"];
 		if (cc.IsArray() && cc.Size() >= 4) {
 			jdCloneColor_.x = static_cast<float>(cc[0].AsDouble(jdCloneColor_.x));
 			jdCloneColor_.y = static_cast<float>(cc[1].AsDouble(jdCloneColor_.y));
@@ -239,7 +240,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- heal（回復）-----
-	const JsonValue& heal = root["heal"];
+	const JsonNode& heal = root["heal"];
 	if (heal.IsObject()) {
 		healAmount_       = static_cast<int>(heal["amount"].AsInt(static_cast<int64_t>(healAmount_)));
 		healSmallAmount_  = static_cast<int>(heal["smallAmount"].AsInt(static_cast<int64_t>(healSmallAmount_)));
@@ -247,7 +248,7 @@ void StagePlayScene::LoadTuningFromJson() {
 		healMaxBoss_      = static_cast<int>(heal["maxBoss"].AsInt(static_cast<int64_t>(healMaxBoss_)));
 	}
 	// ----- special gauge -----
-	const JsonValue& sg = root["special"];
+	const JsonNode& sg = root["special"];
 	if (sg.IsObject()) {
 		// 旧 "max" は傲慢サンダーの上限フォールバックとして読む（後方互換）
 		specialGaugeMaxGouman_    = static_cast<float>(sg["gaugeMaxGouman"].AsDouble(sg["max"].AsDouble(specialGaugeMaxGouman_)));
@@ -301,14 +302,14 @@ void StagePlayScene::LoadTuningFromJson() {
 		disruptorBreakLifeMin_     = static_cast<float>(sg["disruptorBreakLifeMin"].AsDouble(disruptorBreakLifeMin_));
 		disruptorBreakLifeMax_     = static_cast<float>(sg["disruptorBreakLifeMax"].AsDouble(disruptorBreakLifeMax_));
 		{
-			const JsonValue& bd = sg["disruptorBeamDir"];
+			const JsonNode& bd = sg["disruptorBeamDir"];
 			if (bd.IsArray() && bd.Size() >= 3) {
 				disruptorBeamDir_ = { static_cast<float>(bd[0].AsDouble(disruptorBeamDir_.x)),
 				                      static_cast<float>(bd[1].AsDouble(disruptorBeamDir_.y)),
 				                      static_cast<float>(bd[2].AsDouble(disruptorBeamDir_.z)) };
 			}
 			auto loadColor = [&](const char* key, Vector4& c) {
-				const JsonValue& v = sg[key];
+				const JsonNode& v = sg[key];
 				if (v.IsArray() && v.Size() >= 4) {
 					c = { static_cast<float>(v[0].AsDouble(c.x)), static_cast<float>(v[1].AsDouble(c.y)),
 					      static_cast<float>(v[2].AsDouble(c.z)), static_cast<float>(v[3].AsDouble(c.w)) };
@@ -325,10 +326,10 @@ void StagePlayScene::LoadTuningFromJson() {
 		if (sg["barrierEffect"].IsString()) specialBarrierEffectName_ = sg["barrierEffect"].AsString();
 		specialPlayerCenterOffset_ = static_cast<float>(sg["centerOffset"].AsDouble(specialPlayerCenterOffset_));
 		// バリアのワイヤーフレーム球
-		const JsonValue& wf = sg["barrierWire"];
+		const JsonNode& wf = sg["barrierWire"];
 		if (wf.IsObject()) {
 			specialBarrierWireframeOn_   = wf["on"].AsBool(specialBarrierWireframeOn_);
-			const JsonValue& ss = wf["spinSpeed"];
+			const JsonNode& ss = wf["spinSpeed"];
 			if (ss.IsArray() && ss.Size() >= 3) {
 				specialBarrierWireSpinSpeed_.x = static_cast<float>(ss[0].AsDouble(specialBarrierWireSpinSpeed_.x));
 				specialBarrierWireSpinSpeed_.y = static_cast<float>(ss[1].AsDouble(specialBarrierWireSpinSpeed_.y));
@@ -340,7 +341,7 @@ void StagePlayScene::LoadTuningFromJson() {
 			specialBarrierWireMeridians_ = static_cast<int>(wf["meridians"].AsInt(static_cast<int64_t>(specialBarrierWireMeridians_)));
 			specialBarrierWireParallels_ = static_cast<int>(wf["parallels"].AsInt(static_cast<int64_t>(specialBarrierWireParallels_)));
 			specialBarrierWireSegments_  = static_cast<int>(wf["segments"].AsInt(static_cast<int64_t>(specialBarrierWireSegments_)));
-			auto readV4w = [](const JsonValue& a, Vector4& v) {
+			auto readV4w = [](const JsonNode& a, Vector4& v) {
 				if (a.IsArray() && a.Size() >= 4) {
 					v.x = static_cast<float>(a[0].AsDouble(v.x));
 					v.y = static_cast<float>(a[1].AsDouble(v.y));
@@ -352,20 +353,20 @@ void StagePlayScene::LoadTuningFromJson() {
 			readV4w(wf["pink"], specialBarrierWireColorPink_);
 		}
 		// バリアパーティクル
-		const JsonValue& bp = sg["barrierParticle"];
+		const JsonNode& bp = sg["barrierParticle"];
 		if (bp.IsObject()) {
 			specialBarrierParticleOn_   = bp["on"].AsBool(specialBarrierParticleOn_);
 			specialBarrierEmitInterval_ = static_cast<float>(bp["interval"].AsDouble(specialBarrierEmitInterval_));
 			specialBarrierEmitCount_    = static_cast<int>(bp["count"].AsInt(static_cast<int64_t>(specialBarrierEmitCount_)));
 			specialBarrierParticleLife_ = static_cast<float>(bp["life"].AsDouble(specialBarrierParticleLife_));
 			specialBarrierParticleRadiusScale_ = static_cast<float>(bp["radiusScale"].AsDouble(specialBarrierParticleRadiusScale_));
-			auto readV2 = [](const JsonValue& a, Vector2& v) {
+			auto readV2 = [](const JsonNode& a, Vector2& v) {
 				if (a.IsArray() && a.Size() >= 2) {
 					v.x = static_cast<float>(a[0].AsDouble(v.x));
 					v.y = static_cast<float>(a[1].AsDouble(v.y));
 				}
 			};
-			auto readV4 = [](const JsonValue& a, Vector4& v) {
+			auto readV4 = [](const JsonNode& a, Vector4& v) {
 				if (a.IsArray() && a.Size() >= 4) {
 					v.x = static_cast<float>(a[0].AsDouble(v.x));
 					v.y = static_cast<float>(a[1].AsDouble(v.y));
@@ -379,7 +380,7 @@ void StagePlayScene::LoadTuningFromJson() {
 			readV4(bp["color1"], specialBarrierParticleColor1_);
 		}
 		// 光の翼（X字パーティクル）
-		const JsonValue& wg = sg["wing"];
+		const JsonNode& wg = sg["wing"];
 		if (wg.IsObject()) {
 			specialWingOn_          = wg["on"].AsBool(specialWingOn_);
 			specialWingArmCount_    = static_cast<int>(wg["armCount"].AsInt(static_cast<int64_t>(specialWingArmCount_)));
@@ -389,13 +390,13 @@ void StagePlayScene::LoadTuningFromJson() {
 			specialWingBurstCount_  = static_cast<int>(wg["burstCount"].AsInt(static_cast<int64_t>(specialWingBurstCount_)));
 			specialWingJitter_      = static_cast<float>(wg["jitter"].AsDouble(specialWingJitter_));
 			specialWingEmitRadius_  = static_cast<float>(wg["emitRadius"].AsDouble(specialWingEmitRadius_));
-			auto readV2w = [](const JsonValue& a, Vector2& v) {
+			auto readV2w = [](const JsonNode& a, Vector2& v) {
 				if (a.IsArray() && a.Size() >= 2) {
 					v.x = static_cast<float>(a[0].AsDouble(v.x));
 					v.y = static_cast<float>(a[1].AsDouble(v.y));
 				}
 			};
-			auto readV4w2 = [](const JsonValue& a, Vector4& v) {
+			auto readV4w2 = [](const JsonNode& a, Vector4& v) {
 				if (a.IsArray() && a.Size() >= 4) {
 					v.x = static_cast<float>(a[0].AsDouble(v.x));
 					v.y = static_cast<float>(a[1].AsDouble(v.y));
@@ -408,7 +409,7 @@ void StagePlayScene::LoadTuningFromJson() {
 			readV4w2(wg["colorInner"], specialWingColorInner_);
 			readV4w2(wg["colorOuter"], specialWingColorOuter_);
 		}
-		const JsonValue& bc = sg["barrierColor"];
+		const JsonNode& bc = sg["barrierColor"];
 		if (bc.IsArray() && bc.Size() >= 4) {
 			specialBarrierColor_ = {
 				static_cast<float>(bc[0].AsDouble(specialBarrierColor_.x)),
@@ -440,7 +441,7 @@ void StagePlayScene::LoadTuningFromJson() {
 		specialFireEndWidth_       = static_cast<float>(sg["fireEndWidth"].AsDouble(specialFireEndWidth_));
 		specialFireBoltLifetime_   = static_cast<float>(sg["fireBoltLifetime"].AsDouble(specialFireBoltLifetime_));
 		specialEndDuration_        = static_cast<float>(sg["endDuration"].AsDouble(specialEndDuration_));
-		const JsonValue& fc = sg["fireColor"];
+		const JsonNode& fc = sg["fireColor"];
 		if (fc.IsArray() && fc.Size() >= 4) {
 			specialFireColor_ = {
 				static_cast<float>(fc[0].AsDouble(specialFireColor_.x)),
@@ -450,13 +451,13 @@ void StagePlayScene::LoadTuningFromJson() {
 			};
 		}
 		// ゲージ UI
-		const JsonValue& bar = sg["bar"];
+		const JsonNode& bar = sg["bar"];
 		if (bar.IsObject()) {
 			gaugeBarMaxWidth_ = static_cast<float>(bar["maxWidth"].AsDouble(gaugeBarMaxWidth_));
 			gaugeBarHeight_   = static_cast<float>(bar["height"].AsDouble(gaugeBarHeight_));
 			gaugeBarPosX_     = static_cast<float>(bar["posX"].AsDouble(gaugeBarPosX_));
 			gaugeBarPosY_     = static_cast<float>(bar["posY"].AsDouble(gaugeBarPosY_));
-			const JsonValue& bgC = bar["bgColor"];
+			const JsonNode& bgC = bar["bgColor"];
 			if (bgC.IsArray() && bgC.Size() >= 4) {
 				gaugeBarBgColor_ = {
 					static_cast<float>(bgC[0].AsDouble(gaugeBarBgColor_.x)),
@@ -465,7 +466,7 @@ void StagePlayScene::LoadTuningFromJson() {
 					static_cast<float>(bgC[3].AsDouble(gaugeBarBgColor_.w))
 				};
 			}
-			const JsonValue& fgC = bar["fgColor"];
+			const JsonNode& fgC = bar["fgColor"];
 			if (fgC.IsArray() && fgC.Size() >= 4) {
 				gaugeBarFgColor_ = {
 					static_cast<float>(fgC[0].AsDouble(gaugeBarFgColor_.x)),
@@ -474,7 +475,7 @@ void StagePlayScene::LoadTuningFromJson() {
 					static_cast<float>(fgC[3].AsDouble(gaugeBarFgColor_.w))
 				};
 			}
-			const JsonValue& fuC = bar["fullColor"];
+			const JsonNode& fuC = bar["fullColor"];
 			if (fuC.IsArray() && fuC.Size() >= 4) {
 				gaugeBarFullColor_ = {
 					static_cast<float>(fuC[0].AsDouble(gaugeBarFullColor_.x)),
@@ -487,7 +488,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- HP bar UI -----
-	const JsonValue& hpb = root["hpBar"];
+	const JsonNode& hpb = root["hpBar"];
 	if (hpb.IsObject()) {
 		hpBarMaxWidth_  = static_cast<float>(hpb["maxWidth"].AsDouble(hpBarMaxWidth_));
 		hpBarHeight_    = static_cast<float>(hpb["height"].AsDouble(hpBarHeight_));
@@ -497,7 +498,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- Score UI -----
-	auto readColor = [](const JsonValue& arr, Vector4& dst) {
+	auto readColor = [](const JsonNode& arr, Vector4& dst) {
 		if (arr.IsArray() && arr.Size() >= 4) {
 			dst.x = static_cast<float>(arr[0].AsDouble(dst.x));
 			dst.y = static_cast<float>(arr[1].AsDouble(dst.y));
@@ -505,9 +506,9 @@ void StagePlayScene::LoadTuningFromJson() {
 			dst.w = static_cast<float>(arr[3].AsDouble(dst.w));
 		}
 	};
-	const JsonValue& sc = root["score"];
+	const JsonNode& sc = root["score"];
 	if (sc.IsObject()) {
-		const JsonValue& lb = sc["label"];
+		const JsonNode& lb = sc["label"];
 		if (lb.IsObject()) {
 			scoreLabelScale_   = static_cast<float>(lb["scale"].AsDouble(scoreLabelScale_));
 			scoreLabelOffsetX_ = static_cast<float>(lb["offsetX"].AsDouble(scoreLabelOffsetX_));
@@ -516,7 +517,7 @@ void StagePlayScene::LoadTuningFromJson() {
 			scoreLabelOutlineThickness_ = static_cast<float>(lb["outlineThickness"].AsDouble(scoreLabelOutlineThickness_));
 			readColor(lb["outlineColor"], scoreLabelOutlineColor_);
 		}
-		const JsonValue& nb = sc["number"];
+		const JsonNode& nb = sc["number"];
 		if (nb.IsObject()) {
 			scoreNumberScale_   = static_cast<float>(nb["scale"].AsDouble(scoreNumberScale_));
 			scoreNumberOffsetX_ = static_cast<float>(nb["offsetX"].AsDouble(scoreNumberOffsetX_));
@@ -528,7 +529,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- reticle (チャージアニメーション) -----
-	const JsonValue& ret = root["reticle"];
+	const JsonNode& ret = root["reticle"];
 	if (ret.IsObject()) {
 		outerChargeStartRadius_     = static_cast<float>(ret["outerChargeStartRadius"].AsDouble(outerChargeStartRadius_));
 		outerChargeEndRadius_       = static_cast<float>(ret["outerChargeEndRadius"].AsDouble(outerChargeEndRadius_));
@@ -537,10 +538,10 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- precision aim (精密射撃モード) -----
-	const JsonValue& pa = root["precision"];
+	const JsonNode& pa = root["precision"];
 	if (pa.IsObject()) {
 		precisionFovY_            = static_cast<float>(pa["fovY"].AsDouble(precisionFovY_));
-		const JsonValue& co = pa["camOffset"];
+		const JsonNode& co = pa["camOffset"];
 		if (co.IsArray() && co.Size() >= 3) {
 			precisionCamOffset_ = {
 				static_cast<float>(co[0].AsDouble(precisionCamOffset_.x)),
@@ -558,7 +559,7 @@ void StagePlayScene::LoadTuningFromJson() {
 	}
 
 	// ----- phase（ステージ進行ステートマシン）-----
-	const JsonValue& ph = root["phase"];
+	const JsonNode& ph = root["phase"];
 	if (ph.IsObject()) {
 		seekMaxSec_      = static_cast<float>(ph["seekMaxSec"].AsDouble(seekMaxSec_));
 		landingDuration_ = static_cast<float>(ph["landingDurationSec"].AsDouble(landingDuration_));
@@ -2540,6 +2541,15 @@ void StagePlayScene::Initialize() {
 	if (player_) {
 		Gameplay::Of(player_).GetHP().enabled = true;
 	}
+
+	// 弾プールのスロットを弾プレハブごとに先取りしておく（最初の弾幕でコンポーネントのコピーが走らないように）
+	bulletPool_.Prewarm(GetEnemyBulletArchetype(), 256);
+	if (player_) {
+		for (const char* slot : { "normal", "charge1", "charge2" }) {
+			const std::string prefab = Gameplay::Of(player_).FindBulletPrefab(slot);
+			if (!prefab.empty()) bulletPool_.Prewarm(bulletPool_.ResolveArchetype(prefab), 64);
+		}
+	}
 }
 
 void StagePlayScene::Finalize() {
@@ -3501,23 +3511,35 @@ void StagePlayScene::Update() {
 				IImGuiEditable* homeTarget = lockedEnemy_ ? lockedEnemy_ : nearestEnemy_;
 
 				// チャージレベルで弾プレハブを選択（normal / charge1 / charge2）
-				std::string bulletPrefab;
-				if (playerChargeLevel_ >= 2.0f)      bulletPrefab = Gameplay::Of(player_).FindBulletPrefab("charge2");
-				else if (playerChargeLevel_ >= 1.0f) bulletPrefab = Gameplay::Of(player_).FindBulletPrefab("charge1");
-				else                                  bulletPrefab = Gameplay::Of(player_).FindBulletPrefab("normal");
-				if (bulletPrefab.empty()) bulletPrefab = "TemporaryPlayerBullet"; // フォールバック
+				static const char* const kBulletSlots[] = { "normal", "charge1", "charge2" };
+				const int bulletSlot = (playerChargeLevel_ >= 2.0f) ? 2 : (playerChargeLevel_ >= 1.0f) ? 1 : 0;
+
+				// アーキタイプは控えから引く。スロットの名前を引き直すのは、プレイヤーのスロットの版が変わったとき
+				// （Inspector の編集・プレハブの適用・プレイヤーの差し替え）と、前回の解決に失敗していたときだけ
+				const GameplayComponents& playerGameplay = Gameplay::Of(player_);
+				BulletArchetypeCache& archetypeCache = playerBulletArchetypes_[bulletSlot];
+				if (archetypeCache.id == kInvalidBulletArchetype
+					|| archetypeCache.slotsRevision != playerGameplay.GetBulletPrefabsRevision()) {
+					const std::string& slotPrefab = playerGameplay.FindBulletPrefab(kBulletSlots[bulletSlot]);
+					archetypeCache.prefab        = slotPrefab.empty() ? std::string("TemporaryPlayerBullet") : slotPrefab; // フォールバック
+					archetypeCache.id            = ResolveBulletArchetype(archetypeCache.prefab);
+					archetypeCache.slotsRevision = playerGameplay.GetBulletPrefabsRevision();
+				}
+				const BulletArchetypeId bulletArchetype = archetypeCache.id;
 
 				// ロック中（レティクルが敵に重なっている）なら強ホーミング、最近敵のみなら軽ホーミング
 				const bool isLocked = (lockedEnemy_ != nullptr);
 
-				// 弾プレハブの BulletParams から速度・寿命・collider拡大・ホーミングを読む
+				// 弾プレハブの BulletParams（アーキタイプのテンプレートに焼いたもの）から速度・寿命・collider拡大・ホーミングを読む
 				float speed = 80.0f, lifetime = 2.0f, colliderGrowth = 0.0f, homing = 0.0f;
-				if (const PrefabDef* bdef = PrefabManager::GetInstance()->Find(bulletPrefab);
-					bdef && bdef->hasBullet) {
-					speed          = bdef->bulletSpeed;
-					lifetime       = bdef->bulletLifetime;
-					colliderGrowth = bdef->bulletColliderGrowth;
-					homing         = isLocked ? bdef->bulletStrongHomingStrength : bdef->bulletHomingStrength;
+				if (bulletPool_.RefreshArchetype(bulletArchetype)) {
+					const BulletParams& bp = bulletPool_.GetArchetypeComponents(bulletArchetype)->GetBulletParams();
+					if (bp.enabled) {
+						speed          = bp.speed;
+						lifetime       = bp.lifetime;
+						colliderGrowth = bp.colliderGrowth;
+						homing         = isLocked ? bp.strongHomingStrength : bp.homingStrength;
+					}
 				}
 
 				// 精密射撃モードの加算（precisionBlend_ で補間）。
@@ -3533,9 +3555,16 @@ void StagePlayScene::Update() {
 				const float homeStrength = homeTarget ? homing : 0.0f;
 				// 弾は aim plane に到達した時点で消滅させ、面より奥への乱射を防ぐ
 				const int atk = (player_ && Gameplay::Of(player_).HasAttackPower()) ? Gameplay::Of(player_).GetAttackPower() : 0;
-				SpawnPlayerBullet(origin, dir, speed, lifetime,
-					colliderGrowth, homeTarget, homeStrength,
-					aimPlaneDistance_, bulletPrefab, atk);
+				if (bulletArchetype != kInvalidBulletArchetype) {
+					SpawnPlayerBullet(origin, dir, speed, lifetime,
+						colliderGrowth, homeTarget, homeStrength,
+						aimPlaneDistance_, bulletArchetype, atk);
+				} else {
+					// 名前版は解決に失敗した理由をログに出す
+					SpawnPlayerBullet(origin, dir, speed, lifetime,
+						colliderGrowth, homeTarget, homeStrength,
+						aimPlaneDistance_, archetypeCache.prefab, atk);
+				}
 
 				// 連射間隔はプレイヤープレハブの ChargeParams.fireRate から
 				const float fr = Gameplay::Of(player_).GetChargeParams().fireRate;
@@ -3634,11 +3663,10 @@ void StagePlayScene::Update() {
 	if (player_) {
 		const Vector3 p = player_->GetTranslate();
 		const HP& hp = Gameplay::Of(player_).GetHP();
-		SessionLogger::Instance().Write(SessionLogger::Category::State, SessionLogger::Level::Trace,
-			"frame=" + std::to_string(stateFrame_)
-			+ " x=" + std::to_string(p.x) + " y=" + std::to_string(p.y) + " z=" + std::to_string(p.z)
-			+ " hp=" + std::to_string(hp.currentHP) + "/" + std::to_string(hp.maxHP)
-			+ " scene=" + SceneManager::GetInstance()->GetCurrentSceneName());
+		SessionLogger::Instance().Writef(SessionLogger::Category::State, SessionLogger::Level::Trace,
+			"frame=%llu x=%f y=%f z=%f hp=%d/%d scene=%s",
+			static_cast<unsigned long long>(stateFrame_), p.x, p.y, p.z, hp.currentHP, hp.maxHP,
+			SceneManager::GetInstance()->GetCurrentSceneName().c_str());
 		++stateFrame_;
 	}
 }
@@ -3674,6 +3702,8 @@ void StagePlayScene::Draw() {
 	}
 	DrawDynamicAnimated();
 	DrawDynamicPrimitives();
+	// 弾（プレハブごとにインスタンシングで 1 ドローコール）
+	bulletPool_.Draw(GetCamera());
 
 	// LightningRuntime テスト描画
 	if (lightningTest_ && lightningTest_->IsActive()) {
@@ -3842,7 +3872,7 @@ void StagePlayScene::ClearWaveRuntimeState() {
 	enemyControllers_.clear();
 	pendingEnemyControllers_.clear();
 	movingEnemies_.clear();
-	bullets_.clear();
+	bulletPool_.Clear();
 	melees_.clear();
 	meleeComboIndex_ = 0;
 	meleeComboTimer_ = 0.0f;
@@ -3987,7 +4017,7 @@ void StagePlayScene::OnBeforeSceneLoad() {
 	// enemyControllers_ は entity_ がダングリングになるので必ずクリアする（Seek リセットと同様）
 	enemyControllers_.clear();
 	pendingEnemyControllers_.clear();
-	bullets_.clear();
+	bulletPool_.Clear();
 	melees_.clear();
 	ResetDodgeState();
 }
@@ -4104,23 +4134,21 @@ void StagePlayScene::UpdatePlayerDamageAndUI(float deltaTime) {
 
 		bool            hitFound = false;
 		int             incomingDamage = 0;
-		int             hitBulletIndex = -1;
+		uint32_t        hitBulletSlot = BulletPool::kInvalidSlot;
 		IImGuiEditable* attacker = nullptr; // ジャスト演出のハイライト対象
 
 		// 敵弾
-		for (size_t i = 0; i < bullets_.size(); ++i) {
-			auto& b = bullets_[i];
-			if (!b.primitive) continue;
-			if (Gameplay::Of(b.primitive).GetTag() != EntityTag::EnemyAttack) continue;
-			const Vector3* bp = b.primitive->GetEditableTranslate();
-			if (!bp) continue;
-			const float bulletR = Gameplay::Of(b.primitive).GetCollider().radius;
-			float dx = playerPos.x - bp->x, dy = playerPos.y - bp->y, dz = playerPos.z - bp->z;
+		for (uint32_t slot : bulletPool_.ActiveSlots()) {
+			const GameplayComponents& bgp = bulletPool_.ComponentsOf(slot);
+			if (bgp.GetTag() != EntityTag::EnemyAttack) continue;
+			const Vector3& bp = bulletPool_.PositionOf(slot);
+			const float bulletR = bgp.GetCollider().radius;
+			float dx = playerPos.x - bp.x, dy = playerPos.y - bp.y, dz = playerPos.z - bp.z;
 			float sumR = playerR + bulletR;
 			if (dx * dx + dy * dy + dz * dz < sumR * sumR) {
-				incomingDamage = Gameplay::Of(b.primitive).GetDamageDealer().damage;
+				incomingDamage = bgp.GetDamageDealer().damage;
 				if (incomingDamage <= 0) incomingDamage = 10;
-				hitBulletIndex = static_cast<int>(i);
+				hitBulletSlot = slot;
 				attacker = nearestEnemy_; // 弾の発射元は不明なので画面上最近の敵を演出対象に
 				hitFound = true;
 				break;
@@ -4152,18 +4180,18 @@ void StagePlayScene::UpdatePlayerDamageAndUI(float deltaTime) {
 				// ジャスト回避成立（スロー＋演出＋回復ストック＋スコア）
 				TriggerJustDodge(attacker);
 				dodgeActive_ = false; // 回避無敵を消費し、以降はジャスト無敵へ移行
-				if (hitBulletIndex >= 0) bullets_[hitBulletIndex].remainingLifetime = -1.0f;
+				if (hitBulletSlot != BulletPool::kInvalidSlot) bulletPool_.Kill(hitBulletSlot);
 			} else if (dodgeInv || dmgInv || specialInv) {
 				// 無敵中：ダメージ無効（弾はそのまま通過＝既存の被弾無敵と同様）
 			} else {
 				// 通常被弾
 				OnPlayerTakeDamage(incomingDamage);
 				// 被弾エフェクト：攻撃側（敵弾）の "hit" ＋ プレイヤーの "hurt" を再生
-				IImGuiEditable* atkPrefab = (hitBulletIndex >= 0)
-					? static_cast<IImGuiEditable*>(bullets_[hitBulletIndex].primitive)
+				IImGuiEditable* atkPrefab = (hitBulletSlot != BulletPool::kInvalidSlot)
+					? bulletPool_.EntityOf(hitBulletSlot)
 					: attacker;
 				PlayHitEffects(atkPrefab, player_, player_->GetTranslate());
-				if (hitBulletIndex >= 0) bullets_[hitBulletIndex].remainingLifetime = -1.0f;
+				if (hitBulletSlot != BulletPool::kInvalidSlot) bulletPool_.Kill(hitBulletSlot);
 			}
 		}
 	}
@@ -4696,14 +4724,12 @@ void StagePlayScene::ExecuteDisruptorSlash() {
 	disruptorKillsDone_ = false;
 
 	// 敵弾（EnemyAttack）：コライダー中心で判定
-	for (auto& b : bullets_) {
-		if (!b.primitive) continue;
-		if (Gameplay::Of(b.primitive).GetTag() != EntityTag::EnemyAttack) continue;
-		const Vector3* p = b.primitive->GetEditableTranslate();
-		if (!p) continue;
-		const Collider& bc = Gameplay::Of(b.primitive).GetCollider();
-		const Vector3 center{ p->x + bc.offset.x, p->y + bc.offset.y, p->z + bc.offset.z };
-		if (onLine(center, colliderWorldRadius(bc))) disruptorPendingBulletPrims_.push_back(static_cast<IImGuiEditable*>(b.primitive));
+	for (uint32_t slot : bulletPool_.ActiveSlots()) {
+		if (bulletPool_.TagOf(slot) != EntityTag::EnemyAttack) continue;
+		const Vector3& p = bulletPool_.PositionOf(slot);
+		const Collider& bc = bulletPool_.ComponentsOf(slot).GetCollider();
+		const Vector3 center{ p.x + bc.offset.x, p.y + bc.offset.y, p.z + bc.offset.z };
+		if (onLine(center, colliderWorldRadius(bc))) disruptorPendingBulletPrims_.push_back(bulletPool_.EntityOf(slot));
 	}
 
 	// 敵本体（Enemy / Boss）。コライダー中心＋投影半径で判定し、線上なら収集＋焼き付け奥行きに加算。
@@ -4844,12 +4870,7 @@ void StagePlayScene::ExecuteDisruptorKills() {
 
 	// 敵弾：線上に収集済みのものを消滅（まだ生きているものだけ）
 	for (IImGuiEditable* prim : disruptorPendingBulletPrims_) {
-		for (auto& b : bullets_) {
-			if (b.primitive && static_cast<IImGuiEditable*>(b.primitive) == prim) {
-				b.remainingLifetime = -1.0f;
-				break;
-			}
-		}
+		bulletPool_.KillEntity(prim);
 	}
 	disruptorPendingBulletPrims_.clear();
 
@@ -5175,9 +5196,9 @@ void StagePlayScene::DrawAfterPostEffect(ID3D12GraphicsCommandList* /*commandLis
 }
 
 // F1: 事前分割セルの構築（手続き Voronoi）。
-// seed から種点をアスペクト補正空間に撒き、各種点のボロノイ領域を「他種点との垂直二等分線で
-// 半平面クリップ（Sutherland-Hodgman）」して凸多角形セルを得る。重心も計算し、スクリーンUVで格納する。
-// 種点はスクリーン空間固定＝エイム角θに非依存。同じ seed なら同じ割れ方を再現する（O(N^2)・構築1回）。
+// seed から種点をアスペクト補正空間に撒き、Voronoi2D で各種点のボロノイ領域（凸多角形）と重心を求めて
+// スクリーンUVで格納する。近傍グリッドだけを半平面クリップするので、発動時にセル数ぶんの総当たりは走らない。
+// 種点はスクリーン空間固定＝エイム角θに非依存。同じ seed なら同じ割れ方を再現する。
 void StagePlayScene::BuildDisruptorCells() {
 	disruptorCells_.clear();
 	const int n = std::clamp(disruptorCellCount_, 1, 2000);
@@ -5192,65 +5213,15 @@ void StagePlayScene::BuildDisruptorCells() {
 	std::vector<Vector2> seeds(static_cast<size_t>(n));
 	for (int i = 0; i < n; ++i) seeds[i] = { dx(rng), dy(rng) };
 
-	// 画面矩形（初期ポリゴン）
-	const Vector2 rect[4] = { {0.0f,0.0f}, {aspect,0.0f}, {aspect,1.0f}, {0.0f,1.0f} };
-
-	// 半平面クリップ：種点 i 側（dot(p-mid, dir) <= 0、dir = seedJ - seedI）だけ残す
-	auto clipHalfPlane = [](std::vector<Vector2>& poly, const Vector2& mid, const Vector2& dir) {
-		std::vector<Vector2> out;
-		out.reserve(poly.size() + 2);
-		const size_t m = poly.size();
-		for (size_t k = 0; k < m; ++k) {
-			const Vector2& a = poly[k];
-			const Vector2& b = poly[(k + 1) % m];
-			const float fa = (a.x - mid.x) * dir.x + (a.y - mid.y) * dir.y;
-			const float fb = (b.x - mid.x) * dir.x + (b.y - mid.y) * dir.y;
-			const bool inA = fa <= 0.0f;
-			const bool inB = fb <= 0.0f;
-			if (inA) out.push_back(a);
-			if (inA != inB) {
-				const float t = fa / (fa - fb);
-				out.push_back({ a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t });
-			}
-		}
-		poly.swap(out);
-	};
-
-	for (int i = 0; i < n; ++i) {
-		std::vector<Vector2> poly(rect, rect + 4);
-		for (int j = 0; j < n && poly.size() >= 3; ++j) {
-			if (j == i) continue;
-			const Vector2 dir{ seeds[j].x - seeds[i].x, seeds[j].y - seeds[i].y };
-			if (dir.x * dir.x + dir.y * dir.y < 1e-12f) continue;
-			const Vector2 mid{ (seeds[i].x + seeds[j].x) * 0.5f, (seeds[i].y + seeds[j].y) * 0.5f };
-			clipHalfPlane(poly, mid, dir);
-		}
-		if (poly.size() < 3) continue;
-
-		// 面積重み付き重心（縮退時は頂点平均でフォールバック）
-		float area = 0.0f;
-		Vector2 c{ 0.0f, 0.0f };
-		const size_t m = poly.size();
-		for (size_t k = 0; k < m; ++k) {
-			const Vector2& a = poly[k];
-			const Vector2& b = poly[(k + 1) % m];
-			const float cross = a.x * b.y - b.x * a.y;
-			area += cross;
-			c.x += (a.x + b.x) * cross;
-			c.y += (a.y + b.y) * cross;
-		}
-		if (std::abs(area) < 1e-9f) {
-			c = { 0.0f, 0.0f };
-			for (const auto& p : poly) { c.x += p.x; c.y += p.y; }
-			c.x /= static_cast<float>(m); c.y /= static_cast<float>(m);
-		} else {
-			c.x /= (3.0f * area); c.y /= (3.0f * area);
-		}
+	std::vector<Voronoi2D::Cell> cells;
+	Voronoi2D::BuildCells(seeds, aspect, 1.0f, cells);
 
+	disruptorCells_.reserve(cells.size());
+	for (const auto& vc : cells) {
 		DisruptorCell cell;
-		cell.centroidUV = { c.x / aspect, c.y };
-		cell.polyUV.reserve(m);
-		for (const auto& p : poly) cell.polyUV.push_back({ p.x / aspect, p.y });
+		cell.centroidUV = { vc.centroid.x / aspect, vc.centroid.y };
+		cell.polyUV.reserve(vc.polygon.size());
+		for (const auto& p : vc.polygon) cell.polyUV.push_back({ p.x / aspect, p.y });
 		disruptorCells_.push_back(std::move(cell));
 	}
 }
@@ -5337,12 +5308,10 @@ void StagePlayScene::EnterSpecialPhaseBarrier() {
 
 	// バリアのパーティクル群を用意（球状エミッタ）。時間停止中も動くよう TimeGroup=Player。
 	if (auto* gpu = Game::GetGPUParticleManager()) {
-		if (!gpu->HasGroup("special_barrier")) {
-			gpu->CreateGroup("special_barrier", "Resources/Textures/circle.dds");
-		}
-		gpu->SetGroupBillboardMode("special_barrier", BillboardMode::Full);
-		gpu->SetGroupTimeGroup("special_barrier", TimeGroup::Player);
-		specialBarrierGroupReady_ = true;
+		// 既にあれば既存のハンドルが返る
+		specialBarrierGroup_ = gpu->CreateGroup("special_barrier", "Resources/Textures/circle.dds");
+		gpu->SetGroupBillboardMode(specialBarrierGroup_, BillboardMode::Full);
+		gpu->SetGroupTimeGroup(specialBarrierGroup_, TimeGroup::Player);
 	}
 	specialBarrierEmitAccum_ = 0.0f;
 	specialBarrierWireSpin_  = { 0.0f, 0.0f, 0.0f };
@@ -5370,16 +5339,14 @@ void StagePlayScene::UpdateSpecialBarrier() {
 	// バリア当たり判定：球内に侵入した EnemyAttack 弾を消す（距離判定）
 	const float r = specialBarrierRadius_;
 	const float r2 = r * r;
-	for (auto& b : bullets_) {
-		if (!b.primitive) continue;
-		if (Gameplay::Of(b.primitive).GetTag() != EntityTag::EnemyAttack) continue;
-		const Vector3* bp = b.primitive->GetEditableTranslate();
-		if (!bp) continue;
-		float dx = bp->x - playerPos.x;
-		float dy = bp->y - playerPos.y;
-		float dz = bp->z - playerPos.z;
+	for (uint32_t slot : bulletPool_.ActiveSlots()) {
+		if (bulletPool_.TagOf(slot) != EntityTag::EnemyAttack) continue;
+		const Vector3& bp = bulletPool_.PositionOf(slot);
+		float dx = bp.x - playerPos.x;
+		float dy = bp.y - playerPos.y;
+		float dz = bp.z - playerPos.z;
 		if (dx*dx + dy*dy + dz*dz <= r2) {
-			b.remainingLifetime = -1.0f; // 消滅
+			bulletPool_.Kill(slot); // 消滅
 			// 波紋エフェクトはエディター機能準備後に追加
 		}
 	}
@@ -5404,18 +5371,19 @@ void StagePlayScene::UpdateSpecialBarrier() {
 	}
 
 	// バリアのパーティクル：球面内に連続バースト（実時間で進めるので時間停止中もシマー）
-	if (specialBarrierParticleOn_ && specialBarrierGroupReady_) {
+	if (specialBarrierParticleOn_ && specialBarrierGroup_ != kInvalidParticleGroupId) {
 		if (auto* gpu = Game::GetGPUParticleManager()) {
 			const float interval = (specialBarrierEmitInterval_ > 1e-4f) ? specialBarrierEmitInterval_ : 0.02f;
 			const float emitRadius = specialBarrierRadius_ * specialBarrierParticleRadiusScale_;
 			const uint32_t count = static_cast<uint32_t>((std::max)(1, specialBarrierEmitCount_));
-			gpu->SetEmitterTranslate("special_barrier", playerPos);
+			gpu->SetEmitterTranslate(specialBarrierGroup_, playerPos);
 			specialBarrierEmitAccum_ += rdt;
 			int guard = 0; // 1フレームに出し過ぎない安全弁
 			while (specialBarrierEmitAccum_ >= interval && guard < 8) {
 				specialBarrierEmitAccum_ -= interval;
 				++guard;
-				gpu->BurstEmit("special_barrier", playerPos, count, emitRadius,
+				// 同じフレームに複数回呼ばれた分は GPUParticleManager が要求ごとに Emit する（CB は 1 回でまとめて書く）
+				gpu->BurstEmit(specialBarrierGroup_, playerPos, count, emitRadius,
 					1 /*Fixed*/, specialBarrierParticleColor0_, specialBarrierParticleColor1_,
 					specialBarrierParticleScaleMin_, specialBarrierParticleScaleMax_, true,
 					specialBarrierParticleLife_);
@@ -5486,12 +5454,16 @@ void StagePlayScene::UpdateSpecialWings() {
 	const Vector3 camRight = { camRot.m[0][0], camRot.m[0][1], camRot.m[0][2] };
 	const Vector3 camUp    = { camRot.m[1][0], camRot.m[1][1], camRot.m[1][2] };
 
+	// アームごとのグループは初回（とアーム数が増えたとき）だけ名前で作り、以降はハンドルで操作する
+	if (specialWingGroups_.size() < static_cast<size_t>(arms)) {
+		specialWingGroups_.resize(arms, kInvalidParticleGroupId);
+	}
 	for (int i = 0; i < arms; ++i) {
-		const std::string name = "special_wing_" + std::to_string(i);
-		if (!gpu->HasGroup(name)) {
-			gpu->CreateGroup(name, "Resources/Textures/circle.dds");
-			gpu->SetGroupBillboardMode(name, BillboardMode::Full);
-			gpu->SetGroupTimeGroup(name, TimeGroup::Player);
+		ParticleGroupId& group = specialWingGroups_[i];
+		if (!gpu->HasGroup(group)) {
+			group = gpu->CreateGroup("special_wing_" + std::to_string(i), "Resources/Textures/circle.dds");
+			gpu->SetGroupBillboardMode(group, BillboardMode::Full);
+			gpu->SetGroupTimeGroup(group, TimeGroup::Player);
 		}
 		// アーム方向（画面内で均等配置。offset=π/4・arms=4 で X 字）
 		const float a = specialWingAngleOffset_ + static_cast<float>(i) / arms * 2.0f * kPi;
@@ -5501,8 +5473,8 @@ void StagePlayScene::UpdateSpecialWings() {
 			std::cos(a) * camRight.z + std::sin(a) * camUp.z,
 		};
 		const Vector3 vel = { dir.x * specialWingSpeed_, dir.y * specialWingSpeed_, dir.z * specialWingSpeed_ };
-		gpu->SetEmitterVelocity(name, vel, specialWingJitter_, 1); // 外向き初速（方向固定）
-		gpu->BurstEmit(name, center,
+		gpu->SetEmitterVelocity(group, vel, specialWingJitter_, 1); // 外向き初速（方向固定）
+		gpu->BurstEmit(group, center,
 			static_cast<uint32_t>((std::max)(1, specialWingBurstCount_)), specialWingEmitRadius_,
 			1 /*Fixed: 金→ピンク*/, specialWingColorInner_, specialWingColorOuter_,
 			specialWingScaleMin_, specialWingScaleMax_, true, specialWingLife_);
@@ -5571,18 +5543,15 @@ void StagePlayScene::EnumerateLockonTargets() {
 	std::vector<Candidate> cands;
 
 	// 敵弾（EnemyAttack）
-	for (size_t i = 0; i < bullets_.size(); ++i) {
-		auto& b = bullets_[i];
-		if (!b.primitive) continue;
-		if (Gameplay::Of(b.primitive).GetTag() != EntityTag::EnemyAttack) continue;
-		const Vector3* p = b.primitive->GetEditableTranslate();
-		if (!p) continue;
-		if (!isVisibleInClip(*p)) continue;
+	for (uint32_t slot : bulletPool_.ActiveSlots()) {
+		if (bulletPool_.TagOf(slot) != EntityTag::EnemyAttack) continue;
+		const Vector3& p = bulletPool_.PositionOf(slot);
+		if (!isVisibleInClip(p)) continue;
 		Candidate c;
-		c.entity = b.primitive;
-		c.bulletIndex = static_cast<int>(i);
-		c.dist2 = sqDistToPlayer(*p);
-		c.radius = Gameplay::Of(b.primitive).GetCollider().radius;
+		c.entity = bulletPool_.EntityOf(slot);
+		c.bulletIndex = static_cast<int>(slot);
+		c.dist2 = sqDistToPlayer(p);
+		c.radius = bulletPool_.ComponentsOf(slot).GetCollider().radius;
 		cands.push_back(c);
 	}
 
@@ -5986,12 +5955,10 @@ void StagePlayScene::CollectScreenTargets(std::vector<std::pair<IImGuiEditable*,
 	};
 
 	// 敵弾（EnemyAttack）
-	for (auto& b : bullets_) {
-		if (!b.primitive) continue;
-		if (Gameplay::Of(b.primitive).GetTag() != EntityTag::EnemyAttack) continue;
-		const Vector3* p = b.primitive->GetEditableTranslate();
-		if (!p || !isVisibleInClip(*p)) continue;
-		out.emplace_back(static_cast<IImGuiEditable*>(b.primitive), true);
+	for (uint32_t slot : bulletPool_.ActiveSlots()) {
+		if (bulletPool_.TagOf(slot) != EntityTag::EnemyAttack) continue;
+		if (!isVisibleInClip(bulletPool_.PositionOf(slot))) continue;
+		out.emplace_back(bulletPool_.EntityOf(slot), true);
 	}
 	// 敵本体（Enemy / Boss）
 	std::unordered_set<IImGuiEditable*> seen;
@@ -6155,9 +6122,7 @@ void StagePlayScene::UpdateSpecialPhaseFire(float dt) {
 		if (fb.isBullet) {
 			// 敵弾：最低拘束時間で強制消滅
 			if (fb.elapsed >= specialFireMinHold_) {
-				for (auto& b : bullets_) {
-					if (static_cast<IImGuiEditable*>(b.primitive) == fb.entity) { b.remainingLifetime = -1.0f; break; }
-				}
+				bulletPool_.KillEntity(fb.entity);
 				fb.done = true;
 			}
 		} else {
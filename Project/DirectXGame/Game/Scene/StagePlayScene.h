@@ -9,6 +9,7 @@
 #include "BoneSocket.h"
 #include "RailStagePart.h"
 #include "BossStagePart.h"
+#include "ParticleGroupTable.h"
 #include <functional>
 #include <memory>
 #include <string>
@@ -165,6 +166,14 @@ private:
 	// ----- 射撃チューニング -----
 	// 弾パラメータは弾プレハブの BulletParams、連射間隔はプレイヤープレハブの ChargeParams.fireRate に移行済み。
 	float fireTimer_      = 0.0f;    // 次に撃てるまでの残り秒（ランタイム）
+	// 弾スロット → アーキタイプの控え（normal / charge1 / charge2 の順）。
+	// プレイヤーのスロットの版（GameplayComponents::GetBulletPrefabsRevision）が変わったときだけ名前から解決し直す
+	struct BulletArchetypeCache {
+		std::string       prefab;             // 解決に使った名前（フォールバック込み。名前版の Spawn にも渡す）
+		BulletArchetypeId id = kInvalidBulletArchetype;
+		uint32_t          slotsRevision = 0;  // 0 は発行されないので初回は必ず解決する
+	};
+	BulletArchetypeCache playerBulletArchetypes_[3];
 
 	// ----- 照準（aim）チューニング -----
 	// カメラからの「狙いの面」までの距離。弾速・寿命とは独立。
@@ -586,7 +595,7 @@ private:
 	// ----- Phase 2（ロックオン + チャージ）-----
 	struct SpecialLockonTarget {
 		IImGuiEditable* entity = nullptr;        // 敵本体 or 突進敵
-		int   bulletIndex = -1;                   // 弾の場合の bullets_ インデックス（-1=敵）
+		int   bulletIndex = -1;                   // 弾の場合の bulletPool_ スロット（-1=敵）
 		int   patternIndex = 0;                   // 0=A(真上/左下/右下), 1=B(真下/右上/左上)
 		float startTime = 0.0f;                   // Phase 2 経過秒（このターゲットのロック開始時刻）
 		float radius = 0.5f;                      // 敵 collider 半径
@@ -672,6 +681,7 @@ private:
 	Vector2 specialWingScaleMax_{ 0.10f, 0.10f };
 	Vector4 specialWingColorInner_{ 1.0f, 0.85f, 0.20f, 1.0f }; // 金（発生時）
 	Vector4 specialWingColorOuter_{ 1.0f, 0.40f, 0.85f, 0.0f };  // ピンク（寿命末でフェード）
+	std::vector<ParticleGroupId> specialWingGroups_;               // アームごとの GPU パーティクルグループ
 
 	// ----- Phase 4（End = 終了猶予）-----
 	float specialEndDuration_ = 1.0f;            // Fire 終了からバリア消失までの猶予秒
@@ -707,7 +717,7 @@ private:
 	Vector4 specialBarrierParticleColor0_{ 0.5f, 0.85f, 1.0f, 1.0f }; // 発生時の色
 	Vector4 specialBarrierParticleColor1_{ 0.2f, 0.5f,  1.0f, 0.0f }; // 寿命末の色（フェード）
 	float   specialBarrierEmitAccum_  = 0.0f;      // 内部バーストタイマ
-	bool    specialBarrierGroupReady_ = false;     // GPU パーティクルグループ生成済み
+	ParticleGroupId specialBarrierGroup_ = kInvalidParticleGroupId; // GPU パーティクルグループ（生成済みなら有効）
 
 	// ----- 必殺技「ディスラプター」（線・瞬間・最高単発火力型）-----
 	// 傲慢サンダー（SpecialPhase）とは別のフェーズ機で進む。Step 2 はタイマーのみ（ビジュアルなし）。
@@ -838,7 +848,7 @@ private:
 	void DrawDisruptorFragments();                // 最終 RT へ描画（PostEffect 後＝二重反転回避。未割れ＝殻／割れ＝飛散）
 
 	// ----- F1: 事前分割セル（手続き Voronoi）＋割れ順プレビュー -----
-	// Slash→Collapse でスクリーン空間に種点を撒き、半平面クリップで各セルの凸多角形を作る（事前分割）。
+	// Slash→Collapse でスクリーン空間に種点を撒き、近傍の半平面クリップで各セルの凸多角形を作る（事前分割）。
 	// 種点はスクリーン空間固定＝エイム角θに非依存。同じ seed で同じ割れ方が再現される。
 	// 割れ順は「重心の切断線からの垂直距離」で決まり、リビール境界が来た片から順に割れる（飛散駆動はF3）。
 	struct DisruptorCell {
@@ -852,7 +862,7 @@ private:
 	// 割れ順プレビュー（デバッグ）
 	bool     disruptorCellDebugDraw_      = false; // セル境界線を LineRenderer で表示
 	float    disruptorCellPreviewRevealT_ = 0.0f;  // 手動スクラブ：この revealT まで割れたとみなして色分け
-	void BuildDisruptorCells();             // seed から種点スキャッタ→半平面クリップ→重心。disruptorCells_ を作る
+	void BuildDisruptorCells();             // seed から種点スキャッタ→Voronoi2D でセル＋重心。disruptorCells_ を作る
 	void DrawDisruptorCellBordersDebug();   // セル境界線を LineRenderer へ（割れ順で色分け＋スクラブ）
 
 	// ----- F2: セルのワールド形状アップロード＋静止描画（baked UV 検証）-----
@@ -5,14 +5,225 @@
 #include "Json/JsonWriter.h"
 
 namespace {
-	Vector3 JsonToVec3(const JsonValue& v) {
-		if (!v.IsArray() || v.Size() < 3) return {};
-		return {
-			static_cast<float>(v[0].AsDouble()),
-			static_cast<float>(v[1].AsDouble()),
-			static_cast<float>(v[2].AsDouble()),
-		};
+	// 旧データはカメラ速度 0.008 t/秒 ＝ 全体尺 125 秒で作成されていた
+	constexpr double kLegacyStageSeconds = 125.0;
+
+	// 秒指定（*_sec）と旧フォーマット（*_t = カメラ進行度）の両方を受けておき、エントリの終わりで選ぶ
+	struct TimingField {
+		bool hasSec = false;
+		bool hasLegacy = false;
+		double sec = 0.0;
+		double legacy = 0.0;
+	};
+
+	/// <summary>
+	/// ウェーブ JSON を木を作らずに読む SAX ハンドラ。
+	/// 入れ子の位置を文脈スタックで追い、直前のキーに応じて WaveEntry へ直接書き込む。
+	/// 読み方（型が違う値は既定値、旧フォーマットの換算、要素が 3 未満の座標は原点）は DOM 版と同じ。
+	/// </summary>
+	class WaveReader : public JsonParser::Handler {
+	public:
+		WaveDef def;
+		bool hasName = false;
+		bool hasEntries = false;
+
+		bool OnNull() override { return OnValue(nullptr); }
+		bool OnBool(bool) override { return OnValue(nullptr); }
+		bool OnInt(int64_t v) override { double d = static_cast<double>(v); return OnValue(&d); }
+		bool OnDouble(double v) override { return OnValue(&v); }
+		bool OnString(std::string_view s) override {
+			if (stack_.empty()) return false;
+			if (stack_.back() == Context::Root) {
+				if (key_ == "name") {
+					def.name.assign(s);
+					hasName = true;
+				}
+				return true;
+			}
+			if (stack_.back() == Context::Entry) {
+				if (std::string* field = StringField()) field->assign(s);
+				return true;
+			}
+			return OnValue(nullptr);
+		}
+		bool OnKey(std::string_view key) override { key_.assign(key); return true; }
+
+		bool OnStartObject() override { return Open(true); }
+		bool OnStartArray() override { return Open(false); }
+		bool OnEndObject(size_t) override { return Close(); }
+		bool OnEndArray(size_t) override { return Close(); }
+
+	private:
+		enum class Context { Root, Entries, Entry, CameraOffset, Positions, Position, Skip };
+
+		bool Open(bool isObject) {
+			if (stack_.empty()) {
+				// ルートはオブジェクトでなければ読み込み失敗
+				if (!isObject) return false;
+				stack_.push_back(Context::Root);
+				return true;
+			}
+			Context next = Context::Skip;
+			switch (stack_.back()) {
+			case Context::Root:
+				if (!isObject && key_ == "spawn_entries") {
+					hasEntries = true;
+					def.entries.clear();
+					next = Context::Entries;
+				}
+				break;
+			case Context::Entries:
+				// オブジェクト以外の要素も既定値のエントリとして数える
+				BeginEntry();
+				if (isObject) next = Context::Entry;
+				break;
+			case Context::Entry:
+				if (!isObject && key_ == "camera_offset") {
+					vecCount_ = 0;
+					next = Context::CameraOffset;
+				} else if (!isObject && key_ == "positions") {
+					next = Context::Positions;
+				} else if (std::string* field = StringField()) {
+					field->clear();
+				}
+				break;
+			case Context::Positions:
+				vecCount_ = 0;
+				if (!isObject) next = Context::Position;
+				break;
+			case Context::CameraOffset:
+			case Context::Position:
+				AddComponent(0.0);
+				break;
+			case Context::Skip:
+				break;
+			}
+			stack_.push_back(next);
+			return true;
+		}
+
+		bool Close() {
+			const Context closed = stack_.back();
+			stack_.pop_back();
+			if (closed == Context::CameraOffset && vecCount_ >= 3) {
+				entry_.useCameraOffset = true;
+				entry_.cameraOffset = CurrentVec3();
+			}
+			if (!stack_.empty()) {
+				if (stack_.back() == Context::Entries) {
+					EndEntry();
+				} else if (stack_.back() == Context::Positions) {
+					entry_.positions.push_back(vecCount_ >= 3 ? CurrentVec3() : Vector3{});
+				}
+			}
+			return true;
+		}
+
+		// スカラー値（number が null なら数値以外）
+		bool OnValue(const double* number) {
+			if (stack_.empty()) return false;
+			switch (stack_.back()) {
+			case Context::Entries:
+				BeginEntry();
+				EndEntry();
+				break;
+			case Context::Entry:
+				if (std::string* field = StringField()) {
+					field->clear();
+				} else if (number) {
+					SetNumber(*number);
+				}
+				break;
+			case Context::CameraOffset:
+			case Context::Position:
+				AddComponent(number ? *number : 0.0);
+				break;
+			case Context::Positions:
+				entry_.positions.push_back(Vector3{});
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
+		std::string* StringField() {
+			if (key_ == "enemy_type")      return &entry_.enemyType;
+			if (key_ == "prefab")          return &entry_.prefab;
+			if (key_ == "spline_id")       return &entry_.splineId;
+			if (key_ == "child_prefab")    return &entry_.childPrefab;
+			if (key_ == "child_spline_id") return &entry_.childSplineId;
+			return nullptr;
+		}
+
+		void SetNumber(double v) {
+			if      (key_ == "trigger_sec")        { trigger_.hasSec = true; trigger_.sec = v; }
+			else if (key_ == "trigger_t")          { trigger_.hasLegacy = true; trigger_.legacy = v; }
+			else if (key_ == "retreat_sec")        { retreat_.hasSec = true; retreat_.sec = v; }
+			else if (key_ == "retreat_t")          { retreat_.hasLegacy = true; retreat_.legacy = v; }
+			else if (key_ == "traverse_sec")       { traverse_.hasSec = true; traverse_.sec = v; }
+			else if (key_ == "traverse_t")         { traverse_.hasLegacy = true; traverse_.legacy = v; }
+			else if (key_ == "shoot_interval_sec") { shootInterval_.hasSec = true; shootInterval_.sec = v; }
+			else if (key_ == "shoot_interval_t")   { shootInterval_.hasLegacy = true; shootInterval_.legacy = v; }
+			else if (key_ == "count")              entry_.count = static_cast<int>(v);
+			else if (key_ == "spawn_interval_sec") entry_.spawnIntervalSec = static_cast<float>(v);
+			else if (key_ == "spawn_limit")        entry_.spawnLimit = static_cast<int>(v);
+		}
+
+		void BeginEntry() {
+			entry_ = WaveEntry{};
+			trigger_ = retreat_ = traverse_ = shootInterval_ = TimingField{};
+		}
+
+		// 時間系は秒で読む。旧フォーマット（*_t）は 125秒スケールで換算
+		void EndEntry() {
+			if (trigger_.hasSec)             entry_.triggerSec = static_cast<float>(trigger_.sec);
+			else if (trigger_.hasLegacy)     entry_.triggerSec = static_cast<float>(trigger_.legacy * kLegacyStageSeconds);
+			if (retreat_.hasSec)             entry_.retreatSec = static_cast<float>(retreat_.sec);
+			else if (retreat_.hasLegacy)     entry_.retreatSec = (retreat_.legacy < 0.0) ? -1.0f : static_cast<float>(retreat_.legacy * kLegacyStageSeconds);
+			if (traverse_.hasSec)            entry_.traverseSec = static_cast<float>(traverse_.sec);
+			else if (traverse_.hasLegacy)    entry_.traverseSec = static_cast<float>(traverse_.legacy * kLegacyStageSeconds);
+			if (shootInterval_.hasSec)       entry_.shootIntervalSec = static_cast<float>(shootInterval_.sec);
+			else if (shootInterval_.hasLegacy) entry_.shootIntervalSec = static_cast<float>(shootInterval_.legacy * kLegacyStageSeconds);
+			def.entries.push_back(std::move(entry_));
+		}
+
+		void AddComponent(double v) {
+			if (vecCount_ < 3) vec_[vecCount_] = v;
+			++vecCount_;
+		}
+
+		Vector3 CurrentVec3() const {
+			return { static_cast<float>(vec_[0]), static_cast<float>(vec_[1]), static_cast<float>(vec_[2]) };
+		}
+
+		std::vector<Context> stack_;
+		std::string key_;
+		WaveEntry entry_;
+		TimingField trigger_;
+		TimingField retreat_;
+		TimingField traverse_;
+		TimingField shootInterval_;
+		double vec_[3] = {};
+		size_t vecCount_ = 0;
+	};
+
+	/// <summary>
+	/// .defs の 1 レコード。JSON に name / entries が無かったときは out を上書きしないので、その有無も残す
+	/// </summary>
+	struct CookedWave {
+		bool hasName = false;
+		bool hasEntries = false;
+		WaveDef def;
+	};
+
+	template <class Ar>
+	void CookFields(Ar& ar, CookedWave& v) {
+		ar.Field(v.hasName);
+		ar.Field(v.hasEntries);
+		ar.Field(v.def);
 	}
+
 	JsonValue Vec3ToJson(const Vector3& v) {
 		JsonValue arr = JsonValue::MakeArray();
 		arr.Push(JsonValue(static_cast<double>(v.x)));
@@ -22,58 +233,62 @@ namespace {
 	}
 }
 
+template <class Ar>
+void CookFields(Ar& ar, WaveEntry& v) {
+	ar.Field(v.enemyType);
+	ar.Field(v.prefab);
+	ar.Field(v.triggerSec);
+	ar.Field(v.retreatSec);
+	ar.Field(v.traverseSec);
+	ar.Field(v.splineId);
+	ar.Field(v.positions);
+	ar.Field(v.count);
+	ar.Field(v.shootIntervalSec);
+	ar.Field(v.spawnIntervalSec);
+	ar.Field(v.spawnLimit);
+	ar.Field(v.childPrefab);
+	ar.Field(v.childSplineId);
+	ar.Field(v.useCameraOffset);
+	ar.Field(v.cameraOffset);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, WaveDef& v) {
+	ar.Field(v.name);
+	ar.Field(v.entries);
+}
+
+COOKED_DEFS_INSTANTIATE(WaveEntry);
+COOKED_DEFS_INSTANTIATE(WaveDef);
+
 namespace WaveDefIO {
 
-	bool LoadFromFile(const std::string& filePath, WaveDef& out) {
-		auto result = JsonParser::ParseFile(filePath);
-		if (!result.success || !result.value.IsObject()) return false;
-		const JsonValue& root = result.value;
-
-		if (root["name"].IsString()) out.name = root["name"].AsString();
-
-		const JsonValue& arr = root["spawn_entries"];
-		if (arr.IsArray()) {
-			out.entries.clear();
-			out.entries.reserve(arr.Size());
-			for (size_t i = 0; i < arr.Size(); ++i) {
-				const JsonValue& e = arr[i];
-				WaveEntry entry{};
-				entry.enemyType = e["enemy_type"].AsString();
-				entry.prefab    = e["prefab"].AsString();
-				// 時間系は秒で読む。旧フォーマット（*_t = カメラ進行度）は 125秒スケールで換算。
-				// （旧データはカメラ速度 0.008 t/秒 ＝ 全体尺 125 秒で作成されていた）
-				constexpr double kLegacyStageSeconds = 125.0;
-				if (e["trigger_sec"].IsNumber())      entry.triggerSec = static_cast<float>(e["trigger_sec"].AsDouble(entry.triggerSec));
-				else if (e["trigger_t"].IsNumber())   entry.triggerSec = static_cast<float>(e["trigger_t"].AsDouble(0.0) * kLegacyStageSeconds);
-				if (e["retreat_sec"].IsNumber())      entry.retreatSec = static_cast<float>(e["retreat_sec"].AsDouble(entry.retreatSec));
-				else if (e["retreat_t"].IsNumber())   { double rt = e["retreat_t"].AsDouble(-1.0); entry.retreatSec = (rt < 0.0) ? -1.0f : static_cast<float>(rt * kLegacyStageSeconds); }
-				if (e["traverse_sec"].IsNumber())     entry.traverseSec = static_cast<float>(e["traverse_sec"].AsDouble(entry.traverseSec));
-				else if (e["traverse_t"].IsNumber())  entry.traverseSec = static_cast<float>(e["traverse_t"].AsDouble(0.0) * kLegacyStageSeconds);
-				entry.splineId  = e["spline_id"].AsString();
-				entry.count          = static_cast<int>(e["count"].AsDouble(entry.count));
-			if (e["shoot_interval_sec"].IsNumber())    entry.shootIntervalSec = static_cast<float>(e["shoot_interval_sec"].AsDouble(entry.shootIntervalSec));
-			else if (e["shoot_interval_t"].IsNumber()) entry.shootIntervalSec = static_cast<float>(e["shoot_interval_t"].AsDouble(0.0) * kLegacyStageSeconds);
-			entry.spawnIntervalSec = static_cast<float>(e["spawn_interval_sec"].AsDouble(entry.spawnIntervalSec));
-			entry.spawnLimit     = static_cast<int>(e["spawn_limit"].AsDouble(entry.spawnLimit));
-			entry.childPrefab    = e["child_prefab"].AsString();
-			entry.childSplineId  = e["child_spline_id"].AsString();
-
-				const JsonValue& off = e["camera_offset"];
-				if (off.IsArray() && off.Size() >= 3) {
-					entry.useCameraOffset = true;
-					entry.cameraOffset    = JsonToVec3(off);
-				}
+	bool LoadFromFile(const std::string& filePath, WaveDef& out, CookedDefs::Mode mode) {
+		const std::string cookedPath = CookedDefs::CookedPathFor(filePath);
+		std::vector<CookedDefs::SourceInfo> sources(1);
+		if (!CookedDefs::StatSource(filePath, sources[0])) sources.clear();
 
-				const JsonValue& pos = e["positions"];
-				if (pos.IsArray()) {
-					entry.positions.reserve(pos.Size());
-					for (size_t j = 0; j < pos.Size(); ++j) {
-						entry.positions.push_back(JsonToVec3(pos[j]));
-					}
-				}
-				out.entries.push_back(std::move(entry));
+		std::vector<CookedWave> cooked;
+		if (mode != CookedDefs::Mode::JsonOnly) {
+			if (CookedDefs::LoadRecords(cookedPath, kCookedKind, &sources, cooked) && cooked.size() == 1) {
+				CookedWave& wave = cooked.front();
+				if (wave.hasName) out.name = std::move(wave.def.name);
+				if (wave.hasEntries) out.entries = std::move(wave.def.entries);
+				return true;
 			}
+			if (mode == CookedDefs::Mode::CookedOnly) return false;
+		}
+
+		// ウェーブ定義は木を作らずにストリームで読む（失敗時は out を変更しない）
+		WaveReader reader;
+		if (!JsonParser::ParseSaxFile(filePath, reader).success) return false;
+
+		if (mode == CookedDefs::Mode::PreferCooked && !sources.empty()) {
+			cooked.assign(1, CookedWave{ reader.hasName, reader.hasEntries, reader.def });
+			CookedDefs::SaveRecords(cookedPath, kCookedKind, sources, cooked);
 		}
+		if (reader.hasName) out.name = std::move(reader.def.name);
+		if (reader.hasEntries) out.entries = std::move(reader.def.entries);
 		return true;
 	}
 
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "Vector3.h"
+#include "CookedDefs.h"
 
 /// <summary>
 /// ステージの1スポーンエントリ。
@@ -38,7 +39,19 @@ struct WaveDef {
 	std::vector<WaveEntry> entries;
 };
 
+// フィールド並び（CookedDefs の .defs 読み書き用。定義と実体化は WaveDef.cpp）
+template <class Ar> void CookFields(Ar& ar, WaveEntry& v);
+template <class Ar> void CookFields(Ar& ar, WaveDef& v);
+
 namespace WaveDefIO {
-	bool LoadFromFile(const std::string& filePath, WaveDef& out);
+	/// <summary>
+	/// PreferCooked なら焼き込み済みの Resources/Cooked/.../*.defs が元 JSON と一致すればそちらを読み、
+	/// 無い・古いときは JSON から読んで焼き直す。失敗時は out を変更しない。
+	/// </summary>
+	bool LoadFromFile(const std::string& filePath, WaveDef& out,
+		CookedDefs::Mode mode = CookedDefs::Mode::PreferCooked);
 	bool SaveToFile(const std::string& filePath, const WaveDef& def);
+
+	/// <summary>.defs の種別</summary>
+	constexpr uint32_t kCookedKind = CookedDefs::MakeKind('W', 'A', 'V', 'E');
 }
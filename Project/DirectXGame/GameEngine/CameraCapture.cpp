@@ -1,4 +1,5 @@
 #include "CameraCapture.h"
+#include "PepperMacros.h"
 #include <imgui.h>
 #include <cassert>
 
@@ -23,6 +24,7 @@ void CameraCapture::Finalize()
 
 void CameraCapture::CaptureThreadFunc()
 {
+    PEPPER_THREAD_NAME("CameraCapture");
     // ===== COMの初期化（スレッドごとに必要）=====
     // Media FoundationはCOMを使うので、スレッドごとに初期化が必要
     // COINIT_MULTITHREADED: マルチスレッドモードで初期化
@@ -64,6 +66,7 @@ void CameraCapture::CaptureThreadFunc()
         // フレーム取得成功したら処理
         if (SUCCEEDED(result) && pSample)
         {
+            PEPPER_SCOPE("Camera_CopyFrame");
             // ===== フレームデータをバッファに変換 =====
             Microsoft::WRL::ComPtr<IMFMediaBuffer> pBuffer;
             // ConvertToContiguousBuffer(): 複数のバッファを1つにまとめる
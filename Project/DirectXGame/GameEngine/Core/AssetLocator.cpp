@@ -1,13 +1,18 @@
 #include "AssetLocator.h"
+#include "MappedFile.h"
+#include "LogBuffer.h"
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
+#include <random>
 
 namespace {
 // FNV-1a 64bit (pack_assets.py と完全に同じアルゴリズム)
-uint64_t Fnv1a64(const std::string& s) {
+uint64_t Fnv1a64(std::string_view s) {
 	uint64_t h = 0xcbf29ce484222325ULL;
 	for (unsigned char c : s) {
 		h ^= c;
@@ -16,11 +21,62 @@ uint64_t Fnv1a64(const std::string& s) {
 	return h;
 }
 
+// 最小完全ハッシュ (pack_assets.py の mph_mix / mph_bucket / mph_slot と完全に同じ計算)
+uint64_t MphMix(uint64_t h, uint64_t seed) {
+	uint64_t x = h ^ (seed * 0x9E3779B97F4A7C15ULL);
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDULL;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+uint32_t MphSlot(uint64_t h, const std::vector<uint32_t>& seeds, size_t count) {
+	const uint32_t seed = seeds[MphMix(h, 0) % seeds.size()];
+	return static_cast<uint32_t>(MphMix(h, static_cast<uint64_t>(seed) + 1) % count);
+}
+
+std::string ToLower(std::string s) {
+	std::transform(s.begin(), s.end(), s.begin(),
+	               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return s;
+}
+
 // pack_assets.py と一致させるフォーマット定数
 constexpr uint32_t kPackMagic = 0x4B434150;       // "PACK"
-constexpr uint32_t kPackVersion = 1;
-constexpr uint32_t kPackHeaderSize = 16;
+constexpr uint32_t kPackVersion = 2;
+constexpr uint32_t kPackHeaderSize = 48;
 constexpr uint32_t kPackIndexEntrySize = 40;
+constexpr uint32_t kPackExtEntrySize = 16;
+
+// v2 ヘッダー（48 バイト、すべて u32）
+struct PackHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t assetCount;
+	uint32_t indexOffset;
+	uint32_t stringPoolOffset;
+	uint32_t stringPoolSize;
+	uint32_t mphOffset;
+	uint32_t mphBucketCount;
+	uint32_t extTableOffset;
+	uint32_t extCount;
+	uint32_t extListOffset;
+	uint32_t extListCount;
+};
+static_assert(sizeof(PackHeader) == kPackHeaderSize);
+
+// ヘッダーが指すメタデータ領域の終端（ここまで読めば目次が組める）
+uint64_t PackMetaEnd(const PackHeader& hd) {
+	return std::max({
+		static_cast<uint64_t>(hd.indexOffset) + static_cast<uint64_t>(hd.assetCount) * kPackIndexEntrySize,
+		static_cast<uint64_t>(hd.stringPoolOffset) + hd.stringPoolSize,
+		static_cast<uint64_t>(hd.mphOffset) + static_cast<uint64_t>(hd.mphBucketCount) * 4,
+		static_cast<uint64_t>(hd.extTableOffset) + static_cast<uint64_t>(hd.extCount) * kPackExtEntrySize,
+		static_cast<uint64_t>(hd.extListOffset) + static_cast<uint64_t>(hd.extListCount) * 4,
+	});
+}
 }
 
 // =====================================================================
@@ -28,9 +84,16 @@ constexpr uint32_t kPackIndexEntrySize = 40;
 // =====================================================================
 bool AssetHandle::ReadAt(uint64_t offset, void* dst, size_t size)
 {
-	if (!valid_ || !stream_) return false;
+	if (!valid_) return false;
 	if (offset + size > size_) return false;
 
+	if (mapping_) {
+		// mmap: エントリ範囲は開いた時点で検証済み
+		if (size > 0) std::memcpy(dst, view_.data() + offset, size);
+		return true;
+	}
+	if (!stream_) return false;
+
 	stream_->clear();  // 前回の eof 状態をクリア
 	// pack モードでは baseOffset_ + offset、FS モードでは baseOffset_ = 0
 	stream_->seekg(static_cast<std::streamoff>(baseOffset_ + offset));
@@ -73,163 +136,377 @@ void AssetLocator::InitializeFromFilesystem()
 	mode_ = Mode::Filesystem;
 	packPath_.clear();
 	packIndex_.clear();
+	packSeeds_.clear();
+	packStrings_.clear();
+	packExtGroups_.clear();
+	packExtList_.clear();
+	packIO_ = PackIO::Stream;
+	packMapping_.reset();  // 開いているハンドルはマップを共有しているので、そちらが閉じるまで残る
+	++generation_;
+	std::lock_guard<std::mutex> lock(fsPathMutex_);
+	fsPaths_.clear();
+	fsPathIds_.clear();
 }
 
-bool AssetLocator::InitializeFromPack(const std::string& packPath)
+bool AssetLocator::ParsePackIndex(std::span<const uint8_t> meta, uint64_t fileSize)
 {
-	std::ifstream f(packPath, std::ios::binary);
-	if (!f) return false;
+	const uint8_t* data = meta.data();
+	const uint64_t metaSize = meta.size();
+	auto inRange = [](uint64_t offset, uint64_t size, uint64_t limit) {
+		return offset <= limit && size <= limit - offset;
+	};
+	if (!inRange(0, kPackHeaderSize, metaSize)) return false;
 
 	// ---- ヘッダー ----
-	uint32_t magic = 0, version = 0, assetCount = 0, indexOffset = 0;
-	f.read(reinterpret_cast<char*>(&magic), 4);
-	f.read(reinterpret_cast<char*>(&version), 4);
-	f.read(reinterpret_cast<char*>(&assetCount), 4);
-	f.read(reinterpret_cast<char*>(&indexOffset), 4);
-	if (magic != kPackMagic || version != kPackVersion) return false;
-
-	// ---- インデックスを 40 バイト/エントリで直読み ----
-	// C++ の struct はパディングで 48B になるためフィールド直読みする
-	struct ParsedIndex {
-		uint64_t name_hash;
-		uint32_t path_offset;
-		uint16_t path_length;
-		uint8_t  compression;
-		uint64_t compressed_size;
-		uint64_t uncompressed_size;
-		uint64_t payload_offset;
-	};
-	std::vector<ParsedIndex> parsed(assetCount);
-	f.seekg(indexOffset);
-	for (uint32_t i = 0; i < assetCount; ++i) {
-		uint8_t asset_type_skip;
-		ParsedIndex& p = parsed[i];
-		f.read(reinterpret_cast<char*>(&p.name_hash), 8);
-		f.read(reinterpret_cast<char*>(&p.path_offset), 4);
-		f.read(reinterpret_cast<char*>(&p.path_length), 2);
-		f.read(reinterpret_cast<char*>(&p.compression), 1);    // 0=NONE, 1=GDEFLATE
-		f.read(reinterpret_cast<char*>(&asset_type_skip), 1);  // asset_type (現状未使用)
-		f.read(reinterpret_cast<char*>(&p.compressed_size), 8);
-		f.read(reinterpret_cast<char*>(&p.uncompressed_size), 8);
-		f.read(reinterpret_cast<char*>(&p.payload_offset), 8);
+	PackHeader hd{};
+	std::memcpy(&hd, data, kPackHeaderSize);
+	if (hd.magic != kPackMagic || hd.version != kPackVersion) return false;
+	if (PackMetaEnd(hd) > metaSize) return false;
+	if (hd.assetCount > 0 && hd.mphBucketCount == 0) return false;
+
+	// ---- 文字列プール ----
+	std::string strings(reinterpret_cast<const char*>(data + hd.stringPoolOffset), hd.stringPoolSize);
+
+	// ---- 目次（40 バイト/エントリ、MPH スロット順）----
+	std::vector<PackEntry> index(hd.assetCount);
+	for (uint32_t i = 0; i < hd.assetCount; ++i) {
+		const uint8_t* p = data + hd.indexOffset + static_cast<uint64_t>(i) * kPackIndexEntrySize;
+		PackEntry& e = index[i];
+		std::memcpy(&e.name_hash, p + 0, 8);
+		std::memcpy(&e.path_offset, p + 8, 4);
+		std::memcpy(&e.path_length, p + 12, 2);
+		std::memcpy(&e.compression, p + 14, 1);  // 0=NONE, 1=GDEFLATE（p + 15 の asset_type は未使用）
+		std::memcpy(&e.compressed_size, p + 16, 8);
+		std::memcpy(&e.uncompressed_size, p + 24, 8);
+		std::memcpy(&e.payload_offset, p + 32, 8);
+		if (!inRange(e.path_offset, e.path_length, strings.size())) return false;
+		if (!inRange(e.payload_offset, e.compressed_size, fileSize)) return false;
 	}
 
-	// ---- 文字列テーブル ----
-	uint32_t stringTableOffset = indexOffset + assetCount * kPackIndexEntrySize;
-	uint32_t stringTableSize = 0;
-	for (const auto& p : parsed) {
-		uint32_t end = p.path_offset + p.path_length;
-		if (end > stringTableSize) stringTableSize = end;
+	// ---- MPH seed ----
+	std::vector<uint32_t> seeds(hd.mphBucketCount);
+	if (!seeds.empty()) std::memcpy(seeds.data(), data + hd.mphOffset, seeds.size() * 4);
+	// packer と計算がずれていないか（全エントリが自分のスロットに落ちるか）を最初に確かめる
+	for (uint32_t i = 0; i < hd.assetCount; ++i) {
+		if (MphSlot(index[i].name_hash, seeds, index.size()) != i) return false;
 	}
-	std::vector<char> stringTable(stringTableSize);
-	f.seekg(stringTableOffset);
-	f.read(stringTable.data(), stringTableSize);
 
-	// ---- packIndex_ を構築 ----
-	packIndex_.clear();
-	packIndex_.reserve(assetCount);
-	for (const auto& p : parsed) {
-		PackEntry e;
-		e.name_hash = p.name_hash;
-		e.payload_offset = p.payload_offset;
-		e.uncompressed_size = p.uncompressed_size;
-		e.compressed_size = p.compressed_size;
-		e.compression = p.compression;
-		e.path.assign(stringTable.data() + p.path_offset, p.path_length);
-		packIndex_.push_back(std::move(e));
+	// ---- 拡張子別索引 ----
+	std::vector<uint32_t> extList(hd.extListCount);
+	if (!extList.empty()) std::memcpy(extList.data(), data + hd.extListOffset, extList.size() * 4);
+	for (uint32_t slot : extList) {
+		if (slot >= hd.assetCount) return false;
+	}
+	std::vector<PackExtGroup> extGroups;
+	extGroups.reserve(hd.extCount);
+	for (uint32_t i = 0; i < hd.extCount; ++i) {
+		const uint8_t* p = data + hd.extTableOffset + static_cast<uint64_t>(i) * kPackExtEntrySize;
+		uint32_t strOffset = 0;
+		uint16_t strLength = 0;
+		PackExtGroup g;
+		std::memcpy(&strOffset, p + 0, 4);
+		std::memcpy(&strLength, p + 4, 2);
+		std::memcpy(&g.first, p + 8, 4);
+		std::memcpy(&g.count, p + 12, 4);
+		if (!inRange(strOffset, strLength, strings.size())) return false;
+		if (!inRange(g.first, g.count, extList.size())) return false;
+		g.ext.assign(strings, strOffset, strLength);
+		extGroups.push_back(std::move(g));
 	}
-	// 念のためソートを保証（packer 側で済んでいるが）
-	std::sort(packIndex_.begin(), packIndex_.end(),
-	          [](const PackEntry& a, const PackEntry& b) { return a.name_hash < b.name_hash; });
 
-	mode_ = Mode::Pack;
-	packPath_ = packPath;
+	packIndex_ = std::move(index);
+	packSeeds_ = std::move(seeds);
+	packStrings_ = std::move(strings);
+	packExtGroups_ = std::move(extGroups);
+	packExtList_ = std::move(extList);
 	return true;
 }
 
-bool AssetLocator::FindPackEntry(const std::string& path, PackEntry& out) const
+bool AssetLocator::InitializeFromPack(const std::string& packPath, PackIO io)
 {
-	uint64_t h = Fnv1a64(path);
-	auto it = std::lower_bound(packIndex_.begin(), packIndex_.end(), h,
-	                           [](const PackEntry& e, uint64_t k) { return e.name_hash < k; });
-	// ハッシュ衝突対応: 同一ハッシュの中からパス文字列が一致するものを探す
-	while (it != packIndex_.end() && it->name_hash == h) {
-		if (it->path == path) {
-			out = *it;
+	if (io == PackIO::Mapped) {
+		auto mapping = std::make_shared<MappedFile>();
+		if (mapping->Open(packPath) && ParsePackIndex(mapping->GetBytes(), mapping->GetSize())) {
+			mode_ = Mode::Pack;
+			packPath_ = packPath;
+			packIO_ = PackIO::Mapped;
+			packMapping_ = std::move(mapping);
+			++generation_;
 			return true;
 		}
-		++it;
+		// マップできない（32bit のアドレス空間不足など）→ ifstream で開き直す
 	}
-	return false;
+
+	std::ifstream f(packPath, std::ios::binary | std::ios::ate);
+	if (!f) return false;
+	const uint64_t fileSize = static_cast<uint64_t>(f.tellg());
+
+	// ---- ヘッダーを読み、目次まわりのメタデータ領域を 1 回で読む ----
+	PackHeader hd{};
+	f.seekg(0);
+	if (!f.read(reinterpret_cast<char*>(&hd), kPackHeaderSize)) return false;
+	if (hd.magic != kPackMagic || hd.version != kPackVersion) return false;
+	const uint64_t metaEnd = PackMetaEnd(hd);
+	if (metaEnd > fileSize) return false;
+
+	std::vector<uint8_t> meta(static_cast<size_t>(metaEnd));
+	f.seekg(0);
+	if (!f.read(reinterpret_cast<char*>(meta.data()), static_cast<std::streamsize>(meta.size()))) return false;
+	if (!ParsePackIndex(meta, fileSize)) return false;
+
+	mode_ = Mode::Pack;
+	packPath_ = packPath;
+	packIO_ = PackIO::Stream;
+	packMapping_.reset();
+	++generation_;
+	return true;
 }
 
-AssetHandle AssetLocator::Open(const std::string& path)
+uint32_t AssetLocator::FindPackSlot(std::string_view path) const
 {
-	AssetHandle h;
+	if (packIndex_.empty()) return AssetId::kInvalidIndex;
+	const uint64_t h = Fnv1a64(path);
+	const uint32_t slot = MphSlot(h, packSeeds_, packIndex_.size());
+	// 目次に無いパスも何かのスロットに落ちるので、ハッシュとパスで本人か確かめる
+	const PackEntry& e = packIndex_[slot];
+	if (e.name_hash != h || PackPathOf(e) != path) return AssetId::kInvalidIndex;
+	return slot;
+}
+
+const AssetLocator::PackEntry* AssetLocator::FindPackEntry(const std::string& path) const
+{
+	const uint32_t slot = FindPackSlot(path);
+	return (slot != AssetId::kInvalidIndex) ? &packIndex_[slot] : nullptr;
+}
+
+const AssetLocator::PackEntry* AssetLocator::PackEntryOf(AssetId id) const
+{
+	if (mode_ != Mode::Pack || id.generation != generation_ || id.index >= packIndex_.size()) return nullptr;
+	return &packIndex_[id.index];
+}
+
+std::string_view AssetLocator::PackPathOf(const PackEntry& entry) const
+{
+	return std::string_view(packStrings_).substr(entry.path_offset, entry.path_length);
+}
+
+bool AssetLocator::FsPathOf(AssetId id, std::string& out) const
+{
+	if (mode_ != Mode::Filesystem || id.generation != generation_) return false;
+	std::lock_guard<std::mutex> lock(fsPathMutex_);
+	if (id.index >= fsPaths_.size()) return false;
+	out = fsPaths_[id.index];
+	return true;
+}
+
+AssetId AssetLocator::Resolve(const std::string& path) const
+{
+	AssetId id;
+	if (mode_ == Mode::Pack) {
+		id.index = FindPackSlot(path);
+		if (id.IsValid()) id.generation = generation_;
+		return id;
+	}
 	if (mode_ == Mode::Filesystem) {
-		auto stream = std::make_unique<std::ifstream>(path, std::ios::binary | std::ios::ate);
-		if (!stream || !*stream) return h;
-		auto size = stream->tellg();
-		if (size <= 0) return h;
-		stream->seekg(0);
-		h.valid_ = true;
-		h.size_ = static_cast<uint64_t>(size);
-		h.baseOffset_ = 0;
-		h.stream_ = std::move(stream);
-		return h;
+		std::lock_guard<std::mutex> lock(fsPathMutex_);
+		auto [it, inserted] = fsPathIds_.try_emplace(path, static_cast<uint32_t>(fsPaths_.size()));
+		if (inserted) fsPaths_.push_back(path);
+		id.index = it->second;
+		id.generation = generation_;
 	}
-	if (mode_ == Mode::Pack) {
-		PackEntry entry;
-		if (!FindPackEntry(path, entry)) return h;
-		auto stream = std::make_unique<std::ifstream>(packPath_, std::ios::binary);
-		if (!stream || !*stream) return h;
+	return id;
+}
+
+std::string AssetLocator::GetPath(AssetId id) const
+{
+	if (const PackEntry* entry = PackEntryOf(id)) return std::string(PackPathOf(*entry));
+	std::string path;
+	FsPathOf(id, path);
+	return path;
+}
+
+AssetHandle AssetLocator::OpenFile(const std::string& path)
+{
+	AssetHandle h;
+	auto stream = std::make_unique<std::ifstream>(path, std::ios::binary | std::ios::ate);
+	if (!stream || !*stream) return h;
+	auto size = stream->tellg();
+	if (size <= 0) return h;
+	stream->seekg(0);
+	h.valid_ = true;
+	h.size_ = static_cast<uint64_t>(size);
+	h.baseOffset_ = 0;
+	h.stream_ = std::move(stream);
+	return h;
+}
+
+AssetHandle AssetLocator::OpenPackEntry(const PackEntry& entry) const
+{
+	AssetHandle h;
+	if (packMapping_) {
 		h.valid_ = true;
-		// pack 上の実バイト数 (圧縮なしなら uncompressed と同値)。
-		// 圧縮されたエントリでは先頭 N バイト (DDS の場合 148) のみ生で読める前提。
 		h.size_ = entry.compressed_size;
 		h.baseOffset_ = entry.payload_offset;
-		h.stream_ = std::move(stream);
+		h.view_ = ViewPackEntry(entry);
+		h.mapping_ = packMapping_;
 		return h;
 	}
+	auto stream = std::make_unique<std::ifstream>(packPath_, std::ios::binary);
+	if (!stream || !*stream) return h;
+	h.valid_ = true;
+	// pack 上の実バイト数 (圧縮なしなら uncompressed と同値)。
+	// 圧縮されたエントリでは先頭 N バイト (DDS の場合 148) のみ生で読める前提。
+	h.size_ = entry.compressed_size;
+	h.baseOffset_ = entry.payload_offset;
+	h.stream_ = std::move(stream);
 	return h;
 }
 
-std::vector<uint8_t> AssetLocator::LoadAll(const std::string& path)
+AssetHandle AssetLocator::Open(const std::string& path)
+{
+	if (mode_ == Mode::Filesystem) return OpenFile(path);
+	if (mode_ == Mode::Pack) {
+		if (const PackEntry* entry = FindPackEntry(path)) return OpenPackEntry(*entry);
+	}
+	return {};
+}
+
+AssetHandle AssetLocator::Open(AssetId id)
+{
+	if (const PackEntry* entry = PackEntryOf(id)) return OpenPackEntry(*entry);
+	std::string path;
+	if (FsPathOf(id, path)) return OpenFile(path);
+	return {};
+}
+
+std::vector<uint8_t> AssetLocator::LoadFile(const std::string& path)
 {
 	std::vector<uint8_t> buf;
-	if (mode_ == Mode::Filesystem) {
-		std::ifstream f(path, std::ios::binary | std::ios::ate);
-		if (!f) return buf;
-		auto size = f.tellg();
-		if (size <= 0) return buf;
-		buf.resize(static_cast<size_t>(size));
-		f.seekg(0);
-		f.read(reinterpret_cast<char*>(buf.data()), size);
+	std::ifstream f(path, std::ios::binary | std::ios::ate);
+	if (!f) return buf;
+	auto size = f.tellg();
+	if (size <= 0) return buf;
+	buf.resize(static_cast<size_t>(size));
+	f.seekg(0);
+	f.read(reinterpret_cast<char*>(buf.data()), size);
+	return buf;
+}
+
+std::vector<uint8_t> AssetLocator::LoadPackEntry(const PackEntry& entry) const
+{
+	std::vector<uint8_t> buf;
+	if (packMapping_) {
+		const std::span<const uint8_t> view = ViewPackEntry(entry);
+		buf.assign(view.begin(), view.end());
 		return buf;
 	}
+	std::ifstream f(packPath_, std::ios::binary);
+	if (!f) return buf;
+	// 圧縮エントリの場合これは「圧縮済みバイト列」を返す。呼び出し側で解凍が必要。
+	buf.resize(static_cast<size_t>(entry.compressed_size));
+	f.seekg(static_cast<std::streamoff>(entry.payload_offset));
+	f.read(reinterpret_cast<char*>(buf.data()),
+	       static_cast<std::streamsize>(entry.compressed_size));
+	return buf;
+}
+
+std::vector<uint8_t> AssetLocator::LoadAll(const std::string& path)
+{
+	if (mode_ == Mode::Filesystem) return LoadFile(path);
 	if (mode_ == Mode::Pack) {
-		PackEntry entry;
-		if (!FindPackEntry(path, entry)) return buf;
-		std::ifstream f(packPath_, std::ios::binary);
-		if (!f) return buf;
-		// 圧縮エントリの場合これは「圧縮済みバイト列」を返す。呼び出し側で解凍が必要。
-		buf.resize(static_cast<size_t>(entry.compressed_size));
-		f.seekg(static_cast<std::streamoff>(entry.payload_offset));
-		f.read(reinterpret_cast<char*>(buf.data()),
-		       static_cast<std::streamsize>(entry.compressed_size));
-		return buf;
+		if (const PackEntry* entry = FindPackEntry(path)) return LoadPackEntry(*entry);
+	}
+	return {};
+}
+
+std::vector<uint8_t> AssetLocator::LoadAll(AssetId id)
+{
+	if (const PackEntry* entry = PackEntryOf(id)) return LoadPackEntry(*entry);
+	std::string path;
+	if (FsPathOf(id, path)) return LoadFile(path);
+	return {};
+}
+
+AssetBytes AssetLocator::OwnBytes(std::vector<uint8_t>&& bytes)
+{
+	AssetBytes b;
+	b.owned_ = std::move(bytes);
+	b.bytes_ = b.owned_;
+	return b;
+}
+
+AssetBytes AssetLocator::LoadPackBytes(const PackEntry& entry) const
+{
+	if (!packMapping_) return OwnBytes(LoadPackEntry(entry));
+	AssetBytes b;
+	b.bytes_ = ViewPackEntry(entry);
+	b.mapping_ = packMapping_;
+	return b;
+}
+
+AssetBytes AssetLocator::LoadBytes(const std::string& path)
+{
+	if (mode_ == Mode::Filesystem) return OwnBytes(LoadFile(path));
+	if (mode_ == Mode::Pack) {
+		if (const PackEntry* entry = FindPackEntry(path)) return LoadPackBytes(*entry);
+	}
+	return {};
+}
+
+AssetBytes AssetLocator::LoadBytes(AssetId id)
+{
+	if (const PackEntry* entry = PackEntryOf(id)) return LoadPackBytes(*entry);
+	std::string path;
+	if (FsPathOf(id, path)) return OwnBytes(LoadFile(path));
+	return {};
+}
+
+std::span<const uint8_t> AssetLocator::ViewPackEntry(const PackEntry& entry) const
+{
+	if (!packMapping_) return {};
+	return { packMapping_->GetData() + entry.payload_offset, static_cast<size_t>(entry.compressed_size) };
+}
+
+std::span<const uint8_t> AssetLocator::View(const std::string& path) const
+{
+	if (mode_ != Mode::Pack || !packMapping_) return {};
+	const PackEntry* entry = FindPackEntry(path);
+	return entry ? ViewPackEntry(*entry) : std::span<const uint8_t>{};
+}
+
+std::span<const uint8_t> AssetLocator::View(AssetId id) const
+{
+	const PackEntry* entry = PackEntryOf(id);
+	return entry ? ViewPackEntry(*entry) : std::span<const uint8_t>{};
+}
+
+void AssetLocator::Prefetch(const std::vector<std::string>& paths) const
+{
+	if (mode_ != Mode::Pack || !packMapping_) return;
+	for (const auto& path : paths) {
+		if (const PackEntry* entry = FindPackEntry(path)) {
+			packMapping_->WillNeed(entry->payload_offset, entry->compressed_size);
+		}
 	}
-	return buf;
 }
 
 bool AssetLocator::GetPackEntryInfo(const std::string& path,
                                     uint64_t& outPackOffset, uint64_t& outSize) const
 {
 	if (mode_ != Mode::Pack) return false;
-	PackEntry entry;
-	if (!FindPackEntry(path, entry)) return false;
-	outPackOffset = entry.payload_offset;
-	outSize = entry.uncompressed_size;
+	const PackEntry* entry = FindPackEntry(path);
+	if (!entry) return false;
+	outPackOffset = entry->payload_offset;
+	outSize = entry->uncompressed_size;
+	return true;
+}
+
+bool AssetLocator::GetPackEntryInfo(AssetId id, uint64_t& outPackOffset, uint64_t& outSize) const
+{
+	const PackEntry* entry = PackEntryOf(id);
+	if (!entry) return false;
+	outPackOffset = entry->payload_offset;
+	outSize = entry->uncompressed_size;
 	return true;
 }
 
@@ -240,12 +517,27 @@ bool AssetLocator::GetPackEntryInfoEx(const std::string& path,
                                       uint8_t&  outCompression) const
 {
 	if (mode_ != Mode::Pack) return false;
-	PackEntry entry;
-	if (!FindPackEntry(path, entry)) return false;
-	outPackOffset       = entry.payload_offset;
-	outUncompressedSize = entry.uncompressed_size;
-	outCompressedSize   = entry.compressed_size;
-	outCompression      = entry.compression;
+	const PackEntry* entry = FindPackEntry(path);
+	if (!entry) return false;
+	outPackOffset       = entry->payload_offset;
+	outUncompressedSize = entry->uncompressed_size;
+	outCompressedSize   = entry->compressed_size;
+	outCompression      = entry->compression;
+	return true;
+}
+
+bool AssetLocator::GetPackEntryInfoEx(AssetId id,
+                                      uint64_t& outPackOffset,
+                                      uint64_t& outUncompressedSize,
+                                      uint64_t& outCompressedSize,
+                                      uint8_t&  outCompression) const
+{
+	const PackEntry* entry = PackEntryOf(id);
+	if (!entry) return false;
+	outPackOffset       = entry->payload_offset;
+	outUncompressedSize = entry->uncompressed_size;
+	outCompressedSize   = entry->compressed_size;
+	outCompression      = entry->compression;
 	return true;
 }
 
@@ -255,21 +547,25 @@ bool AssetLocator::Exists(const std::string& path) const
 		return std::filesystem::exists(path);
 	}
 	if (mode_ == Mode::Pack) {
-		PackEntry tmp;
-		return FindPackEntry(path, tmp);
+		return FindPackEntry(path) != nullptr;
 	}
 	return false;
 }
 
+bool AssetLocator::Exists(AssetId id) const
+{
+	if (PackEntryOf(id)) return true;
+	std::string path;
+	return FsPathOf(id, path) && std::filesystem::exists(path);
+}
+
 std::vector<std::string> AssetLocator::ListByExtension(
 	const std::string& ext, const std::string& root) const
 {
 	std::vector<std::string> results;
 
 	// 拡張子を小文字に正規化
-	std::string extLower = ext;
-	std::transform(extLower.begin(), extLower.end(), extLower.begin(),
-	               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	const std::string extLower = ToLower(ext);
 
 	if (mode_ == Mode::Filesystem) {
 		const std::filesystem::path rootPath = root;
@@ -280,10 +576,7 @@ std::vector<std::string> AssetLocator::ListByExtension(
 		{
 			if (!it->is_regular_file()) continue;
 			const auto& p = it->path();
-			std::string e = p.extension().string();
-			std::transform(e.begin(), e.end(), e.begin(),
-			               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-			if (e == extLower) {
+			if (ToLower(p.extension().string()) == extLower) {
 				results.push_back(p.generic_string());
 			}
 		}
@@ -295,19 +588,219 @@ std::vector<std::string> AssetLocator::ListByExtension(
 		std::string prefix = root;
 		if (!prefix.empty() && prefix.back() != '/') prefix.push_back('/');
 
-		for (const auto& e : packIndex_) {
-			// 末尾が ext と一致 + 先頭が prefix と一致
-			if (e.path.size() < extLower.size()) continue;
-			std::string entryExt = e.path.substr(e.path.size() - extLower.size());
-			std::transform(entryExt.begin(), entryExt.end(), entryExt.begin(),
-			               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-			if (entryExt != extLower) continue;
-
-			if (!prefix.empty() && e.path.compare(0, prefix.size(), prefix) != 0) continue;
+		// 拡張子のグループを引き、パス昇順のグループ内で prefix に一致する範囲だけを取り出す
+		auto group = std::lower_bound(packExtGroups_.begin(), packExtGroups_.end(), extLower,
+		                              [](const PackExtGroup& g, const std::string& e) { return g.ext < e; });
+		if (group == packExtGroups_.end() || group->ext != extLower) return results;
 
-			results.push_back(e.path);
+		const auto first = packExtList_.begin() + group->first;
+		const auto last = first + group->count;
+		auto it = std::lower_bound(first, last, prefix, [this](uint32_t slot, const std::string& p) {
+			return PackPathOf(packIndex_[slot]) < std::string_view(p);
+		});
+		for (; it != last; ++it) {
+			const std::string_view path = PackPathOf(packIndex_[*it]);
+			if (path.compare(0, prefix.size(), prefix) != 0) break;
+			results.emplace_back(path);
 		}
 		return results;
 	}
 	return results;
 }
+
+// =====================================================================
+// ベンチマーク（ifstream 経路 vs mmap 経路）
+// =====================================================================
+namespace {
+// 読んだバイト列が両経路で同じかを見るための軽いチェックサム（8 バイトずつ足す）
+uint64_t SumBytes(const uint8_t* p, size_t size)
+{
+	uint64_t sum = 0;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t w;
+		std::memcpy(&w, p + i, 8);
+		sum += w;
+	}
+	for (; i < size; ++i) sum += p[i];
+	return sum;
+}
+
+bool IsSceneAsset(const std::string& path)
+{
+	for (const char* ext : { ".mesh", ".skel", ".mat", ".dds" }) {
+		const size_t n = std::strlen(ext);
+		if (path.size() >= n && path.compare(path.size() - n, n, ext) == 0) return true;
+	}
+	return false;
+}
+}
+
+void AssetLocator::RunPackBenchmark(const std::string& requestedPath)
+{
+	using Clock = std::chrono::steady_clock;
+	auto msSince = [](Clock::time_point t0) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	};
+
+	std::string packPath = requestedPath;
+	const AssetLocator* current = GetInstance();
+	if (!packPath.empty()) {
+		if (!std::filesystem::exists(packPath)) {
+			LogBuffer::Instance().Add("[AssetPack] pack not found: " + packPath, LogBuffer::Level::Error);
+			return;
+		}
+	} else if (current->IsPackMode()) {
+		packPath = current->packPath_;
+	} else {
+		for (const char* p : { "../Generated/Assets.pack", "Generated/Assets.pack", "../../Assets.pack" }) {
+			if (std::filesystem::exists(p)) {
+				packPath = p;
+				break;
+			}
+		}
+	}
+	if (packPath.empty()) {
+		LogBuffer::Instance().Add("[AssetPack] Assets.pack not found (build it with tools/Python/pack_assets.py)");
+		return;
+	}
+
+	// シングルトンとは別のインスタンスで比べる
+	AssetLocator stream;
+	AssetLocator mapped;
+
+	// ---- pack を開く（ヘッダー + 目次 + MPH + 拡張子索引 + 文字列プール） ----
+	constexpr int kOpenReps = 20;
+	auto t0 = Clock::now();
+	bool opened = true;
+	for (int r = 0; r < kOpenReps; ++r) opened = stream.InitializeFromPack(packPath, PackIO::Stream) && opened;
+	const double streamOpenMs = msSince(t0) / kOpenReps;
+	t0 = Clock::now();
+	for (int r = 0; r < kOpenReps; ++r) opened = mapped.InitializeFromPack(packPath, PackIO::Mapped) && opened;
+	const double mappedOpenMs = msSince(t0) / kOpenReps;
+	if (!opened || mapped.GetPackIO() != PackIO::Mapped) {
+		LogBuffer::Instance().Add("[AssetPack] failed to open " + packPath + " (mmap " +
+			(mapped.GetPackIO() == PackIO::Mapped ? "ok" : "unavailable") +
+			", pack v2 expected: rebuild with tools/Python/pack_assets.py)", LogBuffer::Level::Error);
+		return;
+	}
+
+	std::vector<std::string> paths;
+	std::vector<uint64_t> sizes;
+	std::vector<std::string> scenePaths;
+	uint64_t sceneBytes = 0;
+	for (const auto& e : mapped.packIndex_) {
+		if (e.compressed_size == 0) continue;
+		paths.emplace_back(mapped.PackPathOf(e));
+		sizes.push_back(e.compressed_size);
+		if (IsSceneAsset(paths.back())) {
+			scenePaths.push_back(paths.back());
+			sceneBytes += e.compressed_size;
+		}
+	}
+	if (paths.empty()) {
+		LogBuffer::Instance().Add("[AssetPack] pack has no entries: " + packPath, LogBuffer::Level::Error);
+		return;
+	}
+
+	// ---- パス検索: 毎回パスをハッシュして引く vs 解決済みの AssetId で引く ----
+	constexpr int kLookupReps = 200;
+	std::vector<AssetId> ids;
+	ids.reserve(paths.size());
+	for (const auto& path : paths) ids.push_back(mapped.Resolve(path));
+	size_t foundByPath = 0;
+	size_t foundById = 0;
+	t0 = Clock::now();
+	for (int r = 0; r < kLookupReps; ++r) {
+		for (const auto& path : paths) foundByPath += mapped.Exists(path) ? 1 : 0;
+	}
+	const double byPathMs = msSince(t0);
+	t0 = Clock::now();
+	for (int r = 0; r < kLookupReps; ++r) {
+		for (AssetId id : ids) foundById += mapped.Exists(id) ? 1 : 0;
+	}
+	const double byIdMs = msSince(t0);
+
+	// ---- ランダムな小さい読み出し（ローダーがヘッダーやパス文字列を拾う読み方）----
+	constexpr int kSmallReads = 20000;
+	constexpr size_t kSmallSize = 64;
+	struct SmallRead { size_t entry; uint64_t offset; size_t size; };
+	std::vector<SmallRead> reads;
+	reads.reserve(kSmallReads);
+	std::mt19937 rng(12345);
+	for (int i = 0; i < kSmallReads; ++i) {
+		const size_t entry = rng() % paths.size();
+		const size_t size = static_cast<size_t>(std::min<uint64_t>(kSmallSize, sizes[entry]));
+		const uint64_t offset = (sizes[entry] > size) ? rng() % (sizes[entry] - size + 1) : 0;
+		reads.push_back({ entry, offset, size });
+	}
+	auto smallReads = [&reads, &paths](AssetLocator& loc) {
+		uint64_t sum = 0;
+		uint8_t buf[kSmallSize];
+		for (const SmallRead& r : reads) {
+			AssetHandle h = loc.Open(paths[r.entry]);
+			if (h.ReadAt(r.offset, buf, r.size)) sum += SumBytes(buf, r.size);
+		}
+		return sum;
+	};
+	t0 = Clock::now();
+	const uint64_t streamSmallSum = smallReads(stream);
+	const double streamSmallMs = msSince(t0);
+	t0 = Clock::now();
+	const uint64_t mappedSmallSum = smallReads(mapped);
+	const double mappedSmallMs = msSince(t0);
+
+	// ---- シーン 1 枚ぶん（.mesh / .skel / .mat / .dds を全部）読む ----
+	// ifstream: Open + バッファへ全体を ReadAt / mmap: LoadAll（コピー）/ mmap: Prefetch + View（その場で読む）
+	auto loadScene = [&scenePaths](AssetLocator& loc, int mode) {
+		uint64_t sum = 0;
+		std::vector<uint8_t> buf;
+		if (mode == 2) loc.Prefetch(scenePaths);
+		for (const auto& path : scenePaths) {
+			if (mode == 0) {
+				AssetHandle h = loc.Open(path);
+				buf.resize(static_cast<size_t>(h.GetSize()));
+				if (h.ReadAt(0, buf.data(), buf.size())) sum += SumBytes(buf.data(), buf.size());
+			} else if (mode == 1) {
+				buf = loc.LoadAll(path);
+				sum += SumBytes(buf.data(), buf.size());
+			} else {
+				const std::span<const uint8_t> view = loc.View(path);
+				sum += SumBytes(view.data(), view.size());
+			}
+		}
+		return sum;
+	};
+	loadScene(stream, 0);  // ページキャッシュを温める（どちらの経路も温まった状態で比べる）
+	t0 = Clock::now();
+	const uint64_t streamSceneSum = loadScene(stream, 0);
+	const double streamSceneMs = msSince(t0);
+	t0 = Clock::now();
+	const uint64_t copySceneSum = loadScene(mapped, 1);
+	const double copySceneMs = msSince(t0);
+	t0 = Clock::now();
+	const uint64_t viewSceneSum = loadScene(mapped, 2);
+	const double viewSceneMs = msSince(t0);
+
+	const bool lookupMatch = foundByPath == foundById && foundById == paths.size() * kLookupReps;
+	const bool smallMatch = streamSmallSum == mappedSmallSum;
+	const bool sceneMatch = streamSceneSum == copySceneSum && streamSceneSum == viewSceneSum;
+	const double sceneMB = static_cast<double>(sceneBytes) / (1024.0 * 1024.0);
+	char buf[256];
+	LogBuffer::Instance().Add("[AssetPack] ifstream vs mmap on " + packPath + " (warm cache)");
+	std::snprintf(buf, sizeof(buf), "  open x%d : ifstream %.3f ms / mmap %.3f ms  (%zu entries)",
+		kOpenReps, streamOpenMs, mappedOpenMs, mapped.packIndex_.size());
+	LogBuffer::Instance().Add(buf);
+	std::snprintf(buf, sizeof(buf), "  lookup x%d (%zu paths) : by path %.3f ms / by AssetId %.3f ms  x%.1f  %s",
+		kLookupReps, paths.size(), byPathMs, byIdMs,
+		(byIdMs > 0.0) ? byPathMs / byIdMs : 0.0, lookupMatch ? "match" : "MISMATCH");
+	LogBuffer::Instance().Add(buf, lookupMatch ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+	std::snprintf(buf, sizeof(buf), "  %d random %zu B reads (Open + ReadAt) : ifstream %.2f ms / mmap %.2f ms  x%.1f  %s",
+		kSmallReads, kSmallSize, streamSmallMs, mappedSmallMs,
+		(mappedSmallMs > 0.0) ? streamSmallMs / mappedSmallMs : 0.0, smallMatch ? "match" : "MISMATCH");
+	LogBuffer::Instance().Add(buf, smallMatch ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+	std::snprintf(buf, sizeof(buf), "  scene load %zu assets %.1f MB : ifstream %.2f ms / mmap copy %.2f ms / mmap view %.2f ms  x%.1f  %s",
+		scenePaths.size(), sceneMB, streamSceneMs, copySceneMs, viewSceneMs,
+		(viewSceneMs > 0.0) ? streamSceneMs / viewSceneMs : 0.0, sceneMatch ? "match" : "MISMATCH");
+	LogBuffer::Instance().Add(buf, sceneMatch ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+}
@@ -1,17 +1,42 @@
 #pragma once
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class AssetLocator;
+class MappedFile;
+
+// =====================================================================
+// AssetId — AssetLocator::Resolve で 1 回だけ解決しておくアセットの番号
+//
+// pack モード: pack 目次のスロット番号（最小完全ハッシュの落ち先）
+// FS モード: Resolve で登録したパスの通し番号
+// 解決済みの id で Open / Exists / GetPackEntryInfo* を呼ぶと、文字列のハッシュも比較もせず配列を 1 回引くだけで済む。
+// Initialize* をやり直すと generation が変わり、古い id は見つからない扱いになる（Resolve し直すこと）。
+// =====================================================================
+struct AssetId {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+	bool operator==(const AssetId&) const = default;
+};
 
 // =====================================================================
 // AssetHandle — 1 アセットに対する読み出しハンドル
 //
 // FS 経路: ifstream を内部に保持し ReadAt で seek + read
-// pack 経路: 共有 pack ファイルへの参照とエントリ内オフセットを保持（B.2 で実装）
+// pack 経路（mmap）: マップ済み pack の中のエントリ範囲を span で持ち、ReadAt は memcpy だけ
+// pack 経路（ifstream）: pack ファイルへのストリームとエントリ先頭オフセットを保持
 // =====================================================================
 class AssetHandle {
 public:
@@ -34,6 +59,10 @@ public:
 	// 読み出し位置を移動する。ifstream::seekg 相当。
 	void Seek(uint64_t offset) { position_ = offset; }
 
+	// pack (mmap) モードのときエントリ全体（pack 上のバイト列）をコピーせずに返す。それ以外は空。
+	// ハンドルがマップを共有して持つので、ハンドルが生きている間は有効。
+	std::span<const uint8_t> GetView() const { return view_; }
+
 private:
 	friend class AssetLocator;
 
@@ -44,8 +73,40 @@ private:
 
 	// FS / pack 共通の入力ストリーム
 	// FS モード: 各アセットファイルへのストリーム
-	// pack モード: pack ファイルへのストリーム（baseOffset_ 起点で読む）
+	// pack モード（ifstream）: pack ファイルへのストリーム（baseOffset_ 起点で読む）
 	std::unique_ptr<std::ifstream> stream_;
+
+	// pack モード（mmap）: エントリ範囲とマップの共有所有（stream_ は持たない）
+	std::span<const uint8_t> view_;
+	std::shared_ptr<const MappedFile> mapping_;
+};
+
+// =====================================================================
+// AssetBytes — 1 アセット全体のバイト列（AssetLocator::LoadBytes が返す）
+//
+// pack 経路（mmap）: マップ上のエントリ範囲を指すだけ（コピーしない）。マップは共有して持つ
+// それ以外: LoadAll と同じく読み込んだバイト列を自前で持つ
+// 中身はどちらの経路でも pack 上のバイト列そのもの（圧縮エントリは圧縮済みのまま）。
+// =====================================================================
+class AssetBytes {
+public:
+	AssetBytes() = default;
+	AssetBytes(const AssetBytes&) = delete;
+	AssetBytes& operator=(const AssetBytes&) = delete;
+	AssetBytes(AssetBytes&&) noexcept = default;
+	AssetBytes& operator=(AssetBytes&&) noexcept = default;
+
+	bool IsValid() const { return !bytes_.empty(); }
+	const uint8_t* GetData() const { return bytes_.data(); }
+	size_t GetSize() const { return bytes_.size(); }
+	std::span<const uint8_t> GetBytes() const { return bytes_; }
+
+private:
+	friend class AssetLocator;
+
+	std::span<const uint8_t> bytes_;  // mapping_ か owned_ の中を指す
+	std::vector<uint8_t> owned_;
+	std::shared_ptr<const MappedFile> mapping_;
 };
 
 // =====================================================================
@@ -58,26 +119,59 @@ class AssetLocator {
 public:
 	static AssetLocator* GetInstance();
 
+	// pack の読み方
+	enum class PackIO {
+		Stream,  // エントリを開くたびに ifstream を作って seek + read（従来）
+		Mapped,  // pack 全体を 1 回メモリマップし、エントリは span で切り出す
+	};
+
 	// 個別ファイル直読みモードで初期化
 	void InitializeFromFilesystem();
 
 	// .pack 経由モードで初期化。失敗で false（pack ファイルなし、フォーマット不正）。
-	bool InitializeFromPack(const std::string& packPath);
+	// Mapped でマップに失敗したときは Stream で開き直す。
+	bool InitializeFromPack(const std::string& packPath, PackIO io = PackIO::Mapped);
+
+	// パスを AssetId に解決する（パスのハッシュはここで 1 回だけ）。
+	// pack モード: 目次に無ければ無効な id。FS モード: パスを登録して返す（ファイルの有無は問わない）。
+	AssetId Resolve(const std::string& path) const;
+
+	// id のパス。無効・古い id なら空。
+	std::string GetPath(AssetId id) const;
 
 	// 主要 API: 部分読み出し用ハンドルを得る
 	AssetHandle Open(const std::string& path);
+	AssetHandle Open(AssetId id);
 
 	// 補助 API: ファイル全体を一括読み込み（小サイズ向け）
 	std::vector<uint8_t> LoadAll(const std::string& path);
+	std::vector<uint8_t> LoadAll(AssetId id);
+
+	// pack (mmap) モードでエントリの pack 上のバイト列をコピーせずに返す（圧縮エントリは圧縮済みのまま）。
+	// それ以外のモード・見つからないときは空。次に Initialize* を呼ぶまで有効。
+	// 空なら LoadAll にフォールバックすること。
+	std::span<const uint8_t> View(const std::string& path) const;
+	std::span<const uint8_t> View(AssetId id) const;
+
+	// ファイル全体のバイト列を得る。pack (mmap) モードではマップを指すだけでコピーせず、
+	// それ以外は LoadAll と同じく読み込む。ヘッダーを読んでから中身を拾う .mesh などのパース用。
+	AssetBytes LoadBytes(const std::string& path);
+	AssetBytes LoadBytes(AssetId id);
+
+	// これから読むエントリをまとめて OS に先読みさせる（pack (mmap) モードのみ。それ以外は何もしない）。
+	// シーンの読み込みリストを確定した時点で呼ぶと、後続の Open / View のページフォールトが減る。
+	void Prefetch(const std::vector<std::string>& paths) const;
 
 	// 存在チェック
 	bool Exists(const std::string& path) const;
+	bool Exists(AssetId id) const;
 
 	// pack 内のエントリ位置情報を取得（DirectStorage 統合用、Phase D）
 	// pack モード時のみ true を返す。FS モードでは常に false。
 	// outSize は uncompressed_size (= 解凍後サイズ)。
 	bool GetPackEntryInfo(const std::string& path,
 	                     uint64_t& outPackOffset, uint64_t& outSize) const;
+	bool GetPackEntryInfo(AssetId id, uint64_t& outPackOffset, uint64_t& outSize) const;
 
 	// 圧縮情報込みの拡張版（GDeflate 対応、Phase B.3）。
 	// outCompression: 0=NONE, 1=GDEFLATE。outCompressedSize は pack 上の実サイズ。
@@ -86,19 +180,31 @@ public:
 	                       uint64_t& outUncompressedSize,
 	                       uint64_t& outCompressedSize,
 	                       uint8_t&  outCompression) const;
+	bool GetPackEntryInfoEx(AssetId id,
+	                       uint64_t& outPackOffset,
+	                       uint64_t& outUncompressedSize,
+	                       uint64_t& outCompressedSize,
+	                       uint8_t&  outCompression) const;
 
 	// 現在のロードモード文字列（"FS" / "Pack" / "Uninitialized"）
 	const char* GetModeName() const;
 	bool IsPackMode() const;
+	PackIO GetPackIO() const { return packIO_; }
 
 	// 拡張子による列挙（SceneEditor 用、ext は "." 含む形式: ".mesh" 等）
 	// root はスキャン起点（既定は "Resources"）。
 	// FS モード: 指定 root 配下を再帰的にスキャン
-	// pack モード: pack の目次から prefix 一致するものを抽出（B.2 で実装）
+	// pack モード: pack の拡張子別索引（パス昇順）から prefix 一致する範囲を取り出す
 	std::vector<std::string> ListByExtension(
 		const std::string& ext,
 		const std::string& root = "Resources") const;
 
+	// pack の開く時間・パス検索（パス / AssetId）・ランダムな小さい読み出し・シーン 1 枚ぶんの全読み込みを
+	// ifstream 経路と mmap 経路で比べて LogBuffer に出す（シングルトンの状態は変えない）。
+	// packPath を渡せばその pack を、空なら現在のモードのもの（FS モードなら ../Generated/Assets.pack などを探す）。
+	// 開けない・経路間で結果が食い違うときは Error で出す（headless_bench の終了コードに効く）。
+	static void RunPackBenchmark(const std::string& packPath = std::string());
+
 private:
 	AssetLocator() = default;
 	~AssetLocator() = default;
@@ -114,12 +220,49 @@ private:
 		uint64_t payload_offset;
 		uint64_t uncompressed_size;
 		uint64_t compressed_size;  // pack 上の実サイズ (圧縮なしなら uncompressed と同じ)
+		uint32_t path_offset;      // packStrings_ 内の位置
+		uint16_t path_length;
 		uint8_t  compression;      // 0=NONE, 1=GDEFLATE
-		std::string path;
+	};
+	// 拡張子別索引の 1 グループ（packExtList_[first, first + count) がその拡張子のスロット、パス昇順）
+	struct PackExtGroup {
+		std::string ext;  // 小文字、"." 含む
+		uint32_t first;
+		uint32_t count;
 	};
 	std::string packPath_;
-	std::vector<PackEntry> packIndex_;  // name_hash 昇順ソート済み
+	std::vector<PackEntry> packIndex_;         // 最小完全ハッシュのスロット順（packIndex_[slot]）
+	std::vector<uint32_t> packSeeds_;          // バケットごとの MPH seed
+	std::string packStrings_;                  // 全パス + 拡張子の文字列プール（pack のものを 1 回コピー）
+	std::vector<PackExtGroup> packExtGroups_;  // ext 昇順
+	std::vector<uint32_t> packExtList_;
+	PackIO packIO_ = PackIO::Stream;
+	std::shared_ptr<const MappedFile> packMapping_;  // Mapped のときだけ
+
+	// Initialize* のたびに進める。AssetId::generation と合わない id は古い。
+	uint32_t generation_ = 0;
+
+	// FS モードで Resolve したパス（AssetId::index はここの添字）。ロードスレッドからも呼ばれるので mutex で守る。
+	mutable std::mutex fsPathMutex_;
+	mutable std::deque<std::string> fsPaths_;
+	mutable std::unordered_map<std::string, uint32_t> fsPathIds_;
+
+	// pack 先頭のメタデータ（ヘッダー・目次・MPH・拡張子索引・文字列プール）から上の pack 用メンバを作る。
+	// fileSize は payload 範囲の検証用。範囲外参照や MPH の不一致があれば false（メンバは変えない）。
+	bool ParsePackIndex(std::span<const uint8_t> meta, uint64_t fileSize);
+
+	// 最小完全ハッシュで 1 回だけ引く。無ければ AssetId::kInvalidIndex。
+	uint32_t FindPackSlot(std::string_view path) const;
+	const PackEntry* FindPackEntry(const std::string& path) const;
+	const PackEntry* PackEntryOf(AssetId id) const;
+	std::string_view PackPathOf(const PackEntry& entry) const;
+	bool FsPathOf(AssetId id, std::string& out) const;
 
-	// pack エントリのバイナリサーチ。見つかれば true、out にコピー。
-	bool FindPackEntry(const std::string& path, PackEntry& out) const;
+	static AssetHandle OpenFile(const std::string& path);
+	static std::vector<uint8_t> LoadFile(const std::string& path);
+	AssetHandle OpenPackEntry(const PackEntry& entry) const;
+	std::vector<uint8_t> LoadPackEntry(const PackEntry& entry) const;
+	AssetBytes LoadPackBytes(const PackEntry& entry) const;
+	static AssetBytes OwnBytes(std::vector<uint8_t>&& bytes);
+	std::span<const uint8_t> ViewPackEntry(const PackEntry& entry) const;
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// =====================================================================
+// ByteReader — メモリ上のバイト列を先頭から読むカーソル
+//
+// AssetLocator::LoadBytes の結果（pack ならマップそのもの）をコピーせずにパースする用。
+// 範囲外を読むと Ok() が落ち、以降の読み出しは 0 を返す（途中で毎回チェックしなくてよい）。
+// =====================================================================
+class ByteReader {
+public:
+	ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+	explicit ByteReader(std::span<const uint8_t> bytes) : data_(bytes.data()), size_(bytes.size()) {}
+
+	template <typename T>
+	T Get() {
+		T value{};
+		GetBytes(&value, sizeof(T));
+		return value;
+	}
+	void GetBytes(void* dst, size_t size) {
+		if (!ok_ || size > size_ - pos_) {
+			ok_ = false;
+			std::memset(dst, 0, size);
+			return;
+		}
+		std::memcpy(dst, data_ + pos_, size);
+		pos_ += size;
+	}
+	// offset から size バイトを読む。現在位置は変えない。
+	void GetBytesAt(size_t offset, void* dst, size_t size) {
+		const size_t saved = pos_;
+		Seek(offset);
+		GetBytes(dst, size);
+		pos_ = saved;
+	}
+	void Seek(size_t pos) {
+		if (pos > size_) ok_ = false;
+		else pos_ = pos;
+	}
+	void Skip(size_t size) { Seek(size > size_ - pos_ ? size_ + 1 : pos_ + size); }
+	size_t GetPosition() const { return pos_; }
+	bool Ok() const { return ok_; }
+
+private:
+	const uint8_t* data_;
+	size_t size_;
+	size_t pos_ = 0;
+	bool ok_ = true;
+};
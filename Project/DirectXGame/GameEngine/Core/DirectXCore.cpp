@@ -755,8 +755,12 @@ void DirectXCore::InitializeFixFPS(){
 void DirectXCore::UpdateFixFPS(){
     // リプレイ再生中は実時計で deltaTime_ を上書きしない（OverrideDeltaTime で供給済み）。
     // ただし記録時と同じ体感速度になるよう、1フレームを deltaTime_ 秒に間延びさせる
-    // （これをしないとフレーム制限が外れて早送りになる）。
+    // （これをしないとフレーム制限が外れて早送りになる）。ヘッドレス再生（replayPacing_ = false）は待たない。
     if (replayMode_) {
+        if (!replayPacing_) {
+            reference_ = std::chrono::steady_clock::now();
+            return;
+        }
         const std::chrono::microseconds target(
             static_cast<long long>(deltaTime_ * 1000000.0f));
         std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
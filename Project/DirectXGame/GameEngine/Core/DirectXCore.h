@@ -136,6 +136,8 @@ public:
 	// リプレイ再生：ON にすると UpdateFixFPS は実時計を読まず、OverrideDeltaTime で
 	// 与えた値をそのまま使う（フレーム制限のスリープも行わず最速で回す）。
 	void SetReplayMode(bool enable) { replayMode_ = enable; }
+	// リプレイ再生で記録時の速度に合わせて待つか（false: ヘッドレス再生用に待たず最速で回す）
+	void SetReplayPacing(bool enable) { replayPacing_ = enable; }
 	void OverrideDeltaTime(float dt) { deltaTime_ = dt; }
 
 	// GPU 完了待機（リソース解放前など、外部からも呼ぶ用）
@@ -239,6 +241,7 @@ private:
 	float deltaTime_ = 1.0f / 60.0f;
 	bool useFixedFrameRate_ = false; // true: 60fps固定, false: 可変(VSyncの上限=モニタリフレッシュまで)
 	bool replayMode_ = false;       // true: dt は外部供給（UpdateFixFPS は実時計を読まない）
+	bool replayPacing_ = true;      // replayMode_ 中、1フレームを deltaTime_ 秒に間延びさせるか
 
 	// グローバルタイムスケール（0で停止、1で等速、0.5でスロー、2で倍速）
 	float timeScale_ = 1.0f;
@@ -0,0 +1,33 @@
+#include "FixedTimestep.h"
+
+void FixedTimestep::SetHz(uint32_t hz)
+{
+    hz_ = hz;
+    stepSeconds_ = (hz > 0) ? 1.0f / static_cast<float>(hz) : 0.0f;
+    step_ = (hz > 0) ? 1.0 / static_cast<double>(hz) : 0.0;
+    accumulator_ = 0.0;
+}
+
+uint32_t FixedTimestep::Advance(double frameSeconds)
+{
+    if (!IsEnabled()) return 1;
+    if (frameSeconds > 0.0) accumulator_ += frameSeconds;
+
+    uint32_t ticks = 0;
+    while (accumulator_ >= step_) {
+        accumulator_ -= step_;
+        if (ticks < maxTicksPerFrame_) {
+            ++ticks;
+        } else {
+            ++droppedTicks_;
+        }
+    }
+    return ticks;
+}
+
+float FixedTimestep::GetAlpha() const
+{
+    if (!IsEnabled()) return 1.0f;
+    const double alpha = accumulator_ / step_;
+    return static_cast<float>(alpha < 1.0 ? alpha : 1.0);
+}
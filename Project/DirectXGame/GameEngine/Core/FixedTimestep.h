@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 固定ステップ更新のアキュムレータ。
+/// 描画フレームごとの実経過時間を積み、刻み幅（1/hz 秒）ぶん溜まるごとに 1 tick 回す。
+/// シミュレーションに渡す dt は常に同じ値になるので、描画レートや PC が違っても
+/// 同じ入力列からは同じ結果になる（リプレイの再現性が dt の揺れに左右されない）。
+/// 処理落ちで溜まりすぎた分は 1 フレームの上限 tick 数を超えたところで捨てる（取り返そうとして更に重くなるのを防ぐ）。
+/// </summary>
+class FixedTimestep {
+public:
+    static constexpr uint32_t kDefaultMaxTicksPerFrame = 8;
+
+    /// <summary>更新レートを設定する。0 で無効（従来どおり 1 描画フレーム 1 更新の可変 dt）。</summary>
+    void SetHz(uint32_t hz);
+    uint32_t GetHz() const { return hz_; }
+    bool IsEnabled() const { return hz_ > 0; }
+
+    /// <summary>1 tick の dt（秒）。シーン更新にはこの値をそのまま渡す。</summary>
+    float GetStepSeconds() const { return stepSeconds_; }
+
+    /// <summary>1 描画フレームで回す tick 数の上限。</summary>
+    void SetMaxTicksPerFrame(uint32_t maxTicks) { maxTicksPerFrame_ = (maxTicks > 0) ? maxTicks : 1; }
+
+    /// <summary>
+    /// 実経過時間 frameSeconds を積み、今フレームで回す tick 数を返す（その分をアキュムレータから引く）。
+    /// </summary>
+    uint32_t Advance(double frameSeconds);
+
+    /// <summary>
+    /// 残りの端数 / 刻み幅（0..1）。描画はこの割合で前 tick と最新 tick の間を補間する。
+    /// </summary>
+    float GetAlpha() const;
+
+    /// <summary>上限を超えて捨てた tick 数の累計。</summary>
+    uint64_t GetDroppedTicks() const { return droppedTicks_; }
+
+    /// <summary>アキュムレータを空にする（シーン切替直後などの大きな dt を持ち越さない）。</summary>
+    void Reset() { accumulator_ = 0.0; }
+
+private:
+    uint32_t hz_ = 0;
+    float stepSeconds_ = 0.0f;
+    double step_ = 0.0;              // 積算は double（float の端数誤差を溜めない）
+    double accumulator_ = 0.0;
+    uint32_t maxTicksPerFrame_ = kDefaultMaxTicksPerFrame;
+    uint64_t droppedTicks_ = 0;
+};
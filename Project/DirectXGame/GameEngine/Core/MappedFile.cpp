@@ -0,0 +1,117 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+	                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data_) UnmapViewOfFile(data_);
+	if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+	if (file_) CloseHandle(static_cast<HANDLE>(file_));
+	data_ = nullptr;
+	size_ = 0;
+	mapping_ = nullptr;
+	file_ = nullptr;
+}
+
+void MappedFile::WillNeed(uint64_t offset, uint64_t size) const
+{
+	if (!data_ || offset >= size_ || size == 0) return;
+	WIN32_MEMORY_RANGE_ENTRY range{};
+	range.VirtualAddress = const_cast<uint8_t*>(data_ + offset);
+	range.NumberOfBytes = static_cast<SIZE_T>((size < size_ - offset) ? size : size_ - offset);
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st{};
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) {
+		::close(fd);
+		return false;
+	}
+	// pack はエントリ単位で飛び飛びに読むので、既定の大きな先読みはさせない（必要な範囲は WillNeed で頼む）
+	madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+	fd_ = fd;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(st.st_size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+	if (fd_ >= 0) ::close(fd_);
+	data_ = nullptr;
+	size_ = 0;
+	fd_ = -1;
+}
+
+void MappedFile::WillNeed(uint64_t offset, uint64_t size) const
+{
+	if (!data_ || offset >= size_ || size == 0) return;
+	// madvise はページ境界から始める必要がある
+	const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	const uint64_t begin = offset & ~(page - 1);
+	const uint64_t end = (size < size_ - offset) ? offset + size : size_;
+	madvise(const_cast<uint8_t*>(data_ + begin), static_cast<size_t>(end - begin), MADV_WILLNEED);
+}
+
+#endif
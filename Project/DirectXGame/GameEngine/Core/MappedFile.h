@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// =====================================================================
+// MappedFile — ファイル全体を読み取り専用でメモリマップする（RAII）
+//
+// pack を 1 回だけマップし、AssetLocator がエントリごとの span を切り出して渡す。
+// Windows: CreateFileMapping / MapViewOfFile、それ以外: mmap
+// =====================================================================
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// ファイルを開いてマップする。失敗で false（空ファイルもマップできないので false）。
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return data_ != nullptr; }
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	std::span<const uint8_t> GetBytes() const { return { data_, size_ }; }
+
+	// [offset, offset + size) をこれから読むというヒント（ページの先読みを OS に頼む）。
+	// Windows: PrefetchVirtualMemory、それ以外: madvise(MADV_WILLNEED)。失敗しても読み出しには影響しない。
+	void WillNeed(uint64_t offset, uint64_t size) const;
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+#ifdef _WIN32
+	void* file_ = nullptr;     // HANDLE
+	void* mapping_ = nullptr;  // HANDLE
+#else
+	int fd_ = -1;
+#endif
+};
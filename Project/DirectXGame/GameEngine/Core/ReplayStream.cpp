@@ -0,0 +1,767 @@
+#include "ReplayStream.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "LogBuffer.h"
+
+namespace {
+    constexpr uint32_t kVersion = 1;
+    constexpr size_t kHeaderSize = 16;
+    constexpr size_t kTrailerSize = 12;           // u64 footerOffset + "REND"
+    constexpr size_t kFlushThreshold = 64 * 1024; // これを超えたらキーフレームを待たずに書き出す
+    constexpr size_t kMaxFrameBytes = 1024;       // 1 フレームの最大サイズの上限（キー全反転 + 全 varint 最大長でも収まる）
+    constexpr int kCrashDrainWaitMs = 100;        // DrainForCrash が書き出し中の終わりを待つ上限
+
+    // フレーム先頭の flags
+    constexpr uint8_t kFlagKeyframe = 1 << 0;
+    constexpr uint8_t kFlagDt = 1 << 1;
+    constexpr uint8_t kFlagKeys = 1 << 2;
+    constexpr uint8_t kFlagMouse = 1 << 3;
+    constexpr uint8_t kFlagPad = 1 << 4;
+
+    // pad の変更マスク
+    constexpr uint8_t kPadConnected = 1 << 0;
+    constexpr uint8_t kPadLX = 1 << 1;
+    constexpr uint8_t kPadLY = 1 << 2;
+    constexpr uint8_t kPadRX = 1 << 3;
+    constexpr uint8_t kPadRY = 1 << 4;
+    constexpr uint8_t kPadLT = 1 << 5;
+    constexpr uint8_t kPadRT = 1 << 6;
+    constexpr uint8_t kPadButtons = 1 << 7;
+
+    // ----- 書き込み -----
+    void PutU8(std::vector<uint8_t>& out, uint8_t v) { out.push_back(v); }
+    void PutRaw(std::vector<uint8_t>& out, const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), p, p + size);
+    }
+    void PutU32(std::vector<uint8_t>& out, uint32_t v) { PutRaw(out, &v, sizeof(v)); }
+    void PutU64(std::vector<uint8_t>& out, uint64_t v) { PutRaw(out, &v, sizeof(v)); }
+    void PutF32(std::vector<uint8_t>& out, float v) { PutRaw(out, &v, sizeof(v)); }
+
+    // LEB128（7bit ずつ、最上位 bit が継続フラグ）
+    void PutVarint(std::vector<uint8_t>& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+    // 符号付きは zigzag（0,-1,1,-2,... → 0,1,2,3,...）にしてから varint
+    void PutZigzag(std::vector<uint8_t>& out, int64_t v) {
+        PutVarint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    }
+
+    // ----- 読み出し（範囲外に出たら ok = false にして以降は 0 を返す） -----
+    struct ByteReader {
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+        bool ok = true;
+
+        bool Has(size_t n) {
+            if (!ok || offset > size || size - offset < n) {
+                ok = false;
+                return false;
+            }
+            return true;
+        }
+        void Raw(void* out, size_t n) {
+            if (Has(n)) {
+                std::memcpy(out, data + offset, n);
+                offset += n;
+            } else {
+                std::memset(out, 0, n);
+            }
+        }
+        uint8_t U8() { uint8_t v = 0; Raw(&v, 1); return v; }
+        uint32_t U32() { uint32_t v = 0; Raw(&v, 4); return v; }
+        uint64_t U64() { uint64_t v = 0; Raw(&v, 8); return v; }
+        float F32() { float v = 0.0f; Raw(&v, 4); return v; }
+        uint64_t Varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const uint8_t b = U8();
+                if (!ok) return 0;
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) return v;
+            }
+            ok = false;
+            return 0;
+        }
+        int64_t Zigzag() {
+            const uint64_t v = Varint();
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+    };
+
+    bool SameMouse(const ReplayFrame& a, const ReplayFrame& b) {
+        return a.mdx == b.mdx && a.mdy == b.mdy && a.mwheel == b.mwheel && a.mbtn == b.mbtn;
+    }
+
+    uint8_t PadMask(const ReplayFrame& a, const ReplayFrame& b) {
+        uint8_t mask = 0;
+        if (a.padConnected != b.padConnected) mask |= kPadConnected;
+        if (a.lx != b.lx) mask |= kPadLX;
+        if (a.ly != b.ly) mask |= kPadLY;
+        if (a.rx != b.rx) mask |= kPadRX;
+        if (a.ry != b.ry) mask |= kPadRY;
+        if (a.lt != b.lt) mask |= kPadLT;
+        if (a.rt != b.rt) mask |= kPadRT;
+        if (a.btns != b.btns) mask |= kPadButtons;
+        return mask;
+    }
+
+    bool SameFrame(const ReplayFrame& a, const ReplayFrame& b) {
+        return std::memcmp(&a.dt, &b.dt, sizeof(float)) == 0
+            && std::memcmp(a.keys, b.keys, sizeof(a.keys)) == 0
+            && SameMouse(a, b) && PadMask(a, b) == 0;
+    }
+
+    // "key=value" トークンから value 文字列を返す（先頭が key= でなければ空）
+    std::string ValueOf(const std::string& token, const char* key) {
+        const size_t klen = std::char_traits<char>::length(key);
+        if (token.size() >= klen && token.compare(0, klen, key) == 0) {
+            return token.substr(klen);
+        }
+        return std::string();
+    }
+
+    // カンマ区切りを int に分解
+    std::vector<long> SplitCsv(const std::string& s) {
+        std::vector<long> out;
+        if (s.empty()) return out;
+        std::stringstream ss(s);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) out.push_back(std::strtol(item.c_str(), nullptr, 10));
+        }
+        return out;
+    }
+}
+
+// =====================================
+// ReplayStreamWriter
+// =====================================
+
+ReplayStreamWriter::~ReplayStreamWriter() {
+    Close();
+}
+
+bool ReplayStreamWriter::Open(const std::string& path, uint32_t seed, uint32_t keyframeInterval) {
+    Close();
+    file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return false;
+    }
+    OpenMemory(seed, keyframeInterval);
+    toFile_ = true;
+    return true;
+}
+
+void ReplayStreamWriter::OpenMemory(uint32_t seed, uint32_t keyframeInterval) {
+    keyframeInterval_ = (keyframeInterval > 0) ? keyframeInterval : kDefaultKeyframeInterval;
+    frameCount_ = 0;
+    flushedBytes_ = 0;
+    buffer_.clear();
+    // 書き出しの閾値 + 2 フレーム分を先に取り、追記で再確保しない（クラッシュ時に別スレッドから読めるように）
+    buffer_.reserve(kFlushThreshold + kMaxFrameBytes * 2);
+    keyframeOffsets_.clear();
+    previous_ = ReplayFrame{};
+    toFile_ = false;
+    fileBusy_.store(false, std::memory_order_relaxed);
+    open_ = true;
+
+    PutRaw(buffer_, "RPLY", 4);
+    PutU32(buffer_, kVersion);
+    PutU32(buffer_, seed);
+    PutU32(buffer_, keyframeInterval_);
+    committedBytes_.store(buffer_.size(), std::memory_order_release);
+}
+
+void ReplayStreamWriter::Append(const ReplayFrame& frame) {
+    // DrainForCrash が書き出しを取ったら以降は積まない（読まれているバッファを再確保させない）
+    if (!open_ || fileBusy_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    if (frameCount_ % keyframeInterval_ == 0) {
+        // キーフレームの手前で書き出しておく（落ちても直前のキーフレームまでは残る）
+        if (toFile_) {
+            FlushToFile();
+        }
+        keyframeOffsets_.push_back(flushedBytes_ + buffer_.size());
+
+        PutU8(buffer_, kFlagKeyframe);
+        PutF32(buffer_, frame.dt);
+        uint8_t bits[32] = {};
+        for (int i = 0; i < 256; ++i) {
+            if (frame.keys[i] & 0x80) bits[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+        }
+        PutRaw(buffer_, bits, sizeof(bits));
+        PutZigzag(buffer_, frame.mdx);
+        PutZigzag(buffer_, frame.mdy);
+        PutZigzag(buffer_, frame.mwheel);
+        PutU8(buffer_, static_cast<uint8_t>(frame.mbtn));
+        PutU8(buffer_, frame.padConnected ? 1 : 0);
+        PutZigzag(buffer_, frame.lx);
+        PutZigzag(buffer_, frame.ly);
+        PutZigzag(buffer_, frame.rx);
+        PutZigzag(buffer_, frame.ry);
+        PutU8(buffer_, frame.lt);
+        PutU8(buffer_, frame.rt);
+        PutVarint(buffer_, frame.btns);
+    } else {
+        const ReplayFrame& prev = previous_;
+
+        // 押下状態が反転したキーだけ拾う
+        uint8_t toggled[256];
+        uint32_t toggledCount = 0;
+        for (int i = 0; i < 256; ++i) {
+            if ((frame.keys[i] ^ prev.keys[i]) & 0x80) toggled[toggledCount++] = static_cast<uint8_t>(i);
+        }
+        const uint8_t padMask = PadMask(frame, prev);
+
+        uint8_t flags = 0;
+        if (std::memcmp(&frame.dt, &prev.dt, sizeof(float)) != 0) flags |= kFlagDt;
+        if (toggledCount > 0) flags |= kFlagKeys;
+        if (!SameMouse(frame, prev)) flags |= kFlagMouse;
+        if (padMask != 0) flags |= kFlagPad;
+
+        PutU8(buffer_, flags);
+        if (flags & kFlagDt) {
+            PutF32(buffer_, frame.dt);
+        }
+        if (flags & kFlagKeys) {
+            PutVarint(buffer_, toggledCount);
+            PutRaw(buffer_, toggled, toggledCount);
+        }
+        if (flags & kFlagMouse) {
+            PutZigzag(buffer_, static_cast<int64_t>(frame.mdx) - prev.mdx);
+            PutZigzag(buffer_, static_cast<int64_t>(frame.mdy) - prev.mdy);
+            PutZigzag(buffer_, static_cast<int64_t>(frame.mwheel) - prev.mwheel);
+            PutU8(buffer_, static_cast<uint8_t>(frame.mbtn));
+        }
+        if (flags & kFlagPad) {
+            PutU8(buffer_, padMask);
+            if (padMask & kPadConnected) PutU8(buffer_, frame.padConnected ? 1 : 0);
+            if (padMask & kPadLX) PutZigzag(buffer_, static_cast<int64_t>(frame.lx) - prev.lx);
+            if (padMask & kPadLY) PutZigzag(buffer_, static_cast<int64_t>(frame.ly) - prev.ly);
+            if (padMask & kPadRX) PutZigzag(buffer_, static_cast<int64_t>(frame.rx) - prev.rx);
+            if (padMask & kPadRY) PutZigzag(buffer_, static_cast<int64_t>(frame.ry) - prev.ry);
+            if (padMask & kPadLT) PutU8(buffer_, frame.lt);
+            if (padMask & kPadRT) PutU8(buffer_, frame.rt);
+            if (padMask & kPadButtons) PutVarint(buffer_, frame.btns);
+        }
+    }
+
+    previous_ = frame;
+    ++frameCount_;
+    committedBytes_.store(buffer_.size(), std::memory_order_release);
+
+    if (toFile_ && buffer_.size() >= kFlushThreshold) {
+        FlushToFile();
+    }
+}
+
+void ReplayStreamWriter::FlushToFile() {
+    if (buffer_.empty()) {
+        return;
+    }
+    if (fileBusy_.exchange(true, std::memory_order_acquire)) {
+        // DrainForCrash が書いている（プロセスはこのまま終わる）
+        return;
+    }
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    flushedBytes_ += buffer_.size();
+    buffer_.clear();
+    committedBytes_.store(0, std::memory_order_relaxed);
+    fileBusy_.store(false, std::memory_order_release);
+}
+
+void ReplayStreamWriter::DrainForCrash() {
+    if (!open_ || !toFile_) {
+        return;
+    }
+    // 記録側が書き出しの途中なら終わるのを少し待つ。
+    // クラッシュしたのが書き出しの途中（＝ファイル書き込み中に落ちた）なら取れないので諦める
+    for (int waited = 0; fileBusy_.exchange(true, std::memory_order_acquire); ++waited) {
+        if (waited >= kCrashDrainWaitMs) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // 書きかけのフレームは出さない（読み込み側は途中で切れたフレームの手前までを使う）
+    const size_t bytes = committedBytes_.load(std::memory_order_acquire);
+    if (bytes > 0) {
+        file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(bytes));
+        file_.flush();
+    }
+    // プロセスはこのまま終了するので fileBusy_ は戻さない（記録側と交互に書かせない）
+}
+
+void ReplayStreamWriter::Close() {
+    if (!open_) {
+        return;
+    }
+
+    const uint64_t footerOffset = flushedBytes_ + buffer_.size();
+    PutRaw(buffer_, "RIDX", 4);
+    PutU32(buffer_, static_cast<uint32_t>(keyframeOffsets_.size()));
+    for (uint64_t offset : keyframeOffsets_) {
+        PutU64(buffer_, offset);
+    }
+    PutU64(buffer_, frameCount_);
+    PutU64(buffer_, footerOffset);
+    PutRaw(buffer_, "REND", 4);
+
+    if (toFile_) {
+        FlushToFile();
+        file_.close();
+    }
+    open_ = false;
+}
+
+// =====================================
+// ReplayStreamReader
+// =====================================
+
+bool ReplayStreamReader::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        return false;
+    }
+    const std::streamsize size = in.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(data.data()), size);
+    if (in.gcount() != size) {
+        return false;
+    }
+    return LoadFromMemory(std::move(data));
+}
+
+bool ReplayStreamReader::LoadFromMemory(std::vector<uint8_t> data) {
+    data_ = std::move(data);
+    keyframeOffsets_.clear();
+    frameCount_ = 0;
+
+    ByteReader r{ data_.data(), data_.size(), 0 };
+    char magic[4];
+    r.Raw(magic, 4);
+    const uint32_t version = r.U32();
+    seed_ = r.U32();
+    keyframeInterval_ = r.U32();
+    if (!r.ok || std::memcmp(magic, "RPLY", 4) != 0 || version != kVersion || keyframeInterval_ == 0) {
+        data_.clear();
+        return false;
+    }
+
+    if (!ReadFooter()) {
+        RebuildIndex();
+    }
+    return Seek(0);
+}
+
+bool ReplayStreamReader::ReadFooter() {
+    if (data_.size() < kHeaderSize + kTrailerSize || std::memcmp(data_.data() + data_.size() - 4, "REND", 4) != 0) {
+        return false;
+    }
+    ByteReader r{ data_.data(), data_.size(), data_.size() - kTrailerSize };
+    const uint64_t footerOffset = r.U64();
+    if (footerOffset < kHeaderSize || footerOffset > data_.size() - kTrailerSize) {
+        return false;
+    }
+
+    r.offset = static_cast<size_t>(footerOffset);
+    char magic[4];
+    r.Raw(magic, 4);
+    const uint32_t count = r.U32();
+    if (!r.ok || std::memcmp(magic, "RIDX", 4) != 0
+        || count > (data_.size() - r.offset) / sizeof(uint64_t)) {
+        return false;
+    }
+    std::vector<uint64_t> offsets(count);
+    for (uint64_t& offset : offsets) {
+        offset = r.U64();
+        if (offset < kHeaderSize || offset >= footerOffset) return false;
+    }
+    const uint64_t frameCount = r.U64();
+    if (!r.ok || r.offset + kTrailerSize != data_.size()
+        || count != (frameCount + keyframeInterval_ - 1) / keyframeInterval_) {
+        return false;
+    }
+
+    keyframeOffsets_ = std::move(offsets);
+    frameCount_ = frameCount;
+    streamEnd_ = static_cast<size_t>(footerOffset);
+    return true;
+}
+
+void ReplayStreamReader::RebuildIndex() {
+    // Footer が無い（記録中に落ちた）: 最後まで読めたフレームまでを有効にする
+    streamEnd_ = data_.size();
+    keyframeOffsets_.clear();
+    size_t offset = kHeaderSize;
+    ReplayFrame state;
+    uint64_t frames = 0;
+    while (offset < streamEnd_) {
+        const size_t start = offset;
+        const bool keyframe = (frames % keyframeInterval_ == 0);
+        if (keyframe && (data_[start] & kFlagKeyframe) == 0) {
+            break;
+        }
+        if (!DecodeFrame(offset, state)) {
+            break;
+        }
+        if (keyframe) {
+            keyframeOffsets_.push_back(start);
+        }
+        ++frames;
+    }
+    frameCount_ = frames;
+    streamEnd_ = offset;
+}
+
+bool ReplayStreamReader::DecodeFrame(size_t& offset, ReplayFrame& state) const {
+    ByteReader r{ data_.data(), streamEnd_, offset };
+    const uint8_t flags = r.U8();
+    if (!r.ok) {
+        return false;
+    }
+
+    ReplayFrame next = state;
+    if (flags & kFlagKeyframe) {
+        next.dt = r.F32();
+        uint8_t bits[32];
+        r.Raw(bits, sizeof(bits));
+        for (int i = 0; i < 256; ++i) {
+            next.keys[i] = (bits[i >> 3] & (1 << (i & 7))) ? 0x80 : 0x00;
+        }
+        next.mdx = static_cast<int32_t>(r.Zigzag());
+        next.mdy = static_cast<int32_t>(r.Zigzag());
+        next.mwheel = static_cast<int32_t>(r.Zigzag());
+        next.mbtn = r.U8();
+        next.padConnected = (r.U8() != 0);
+        next.lx = static_cast<int16_t>(r.Zigzag());
+        next.ly = static_cast<int16_t>(r.Zigzag());
+        next.rx = static_cast<int16_t>(r.Zigzag());
+        next.ry = static_cast<int16_t>(r.Zigzag());
+        next.lt = r.U8();
+        next.rt = r.U8();
+        next.btns = static_cast<uint16_t>(r.Varint());
+    } else {
+        if (flags & kFlagDt) {
+            next.dt = r.F32();
+        }
+        if (flags & kFlagKeys) {
+            const uint64_t count = r.Varint();
+            if (count > 256) return false;
+            for (uint64_t i = 0; i < count; ++i) {
+                next.keys[r.U8()] ^= 0x80;
+            }
+        }
+        if (flags & kFlagMouse) {
+            next.mdx = static_cast<int32_t>(next.mdx + r.Zigzag());
+            next.mdy = static_cast<int32_t>(next.mdy + r.Zigzag());
+            next.mwheel = static_cast<int32_t>(next.mwheel + r.Zigzag());
+            next.mbtn = r.U8();
+        }
+        if (flags & kFlagPad) {
+            const uint8_t mask = r.U8();
+            if (mask & kPadConnected) next.padConnected = (r.U8() != 0);
+            if (mask & kPadLX) next.lx = static_cast<int16_t>(next.lx + r.Zigzag());
+            if (mask & kPadLY) next.ly = static_cast<int16_t>(next.ly + r.Zigzag());
+            if (mask & kPadRX) next.rx = static_cast<int16_t>(next.rx + r.Zigzag());
+            if (mask & kPadRY) next.ry = static_cast<int16_t>(next.ry + r.Zigzag());
+            if (mask & kPadLT) next.lt = r.U8();
+            if (mask & kPadRT) next.rt = r.U8();
+            if (mask & kPadButtons) next.btns = static_cast<uint16_t>(r.Varint());
+        }
+    }
+    if (!r.ok) {
+        return false;
+    }
+
+    state = next;
+    offset = r.offset;
+    return true;
+}
+
+bool ReplayStreamReader::Seek(uint64_t frame) {
+    if (frame > frameCount_) {
+        return false;
+    }
+    const uint64_t key = frame / keyframeInterval_;
+    if (key >= keyframeOffsets_.size()) {
+        // 終端（frame == frameCount_ がちょうどキーフレーム境界）
+        offset_ = streamEnd_;
+        nextFrame_ = frame;
+        return true;
+    }
+
+    // 直前のキーフレームから差分を当てていく（最大 keyframeInterval - 1 フレーム）
+    offset_ = static_cast<size_t>(keyframeOffsets_[key]);
+    nextFrame_ = key * keyframeInterval_;
+    while (nextFrame_ < frame) {
+        if (!DecodeFrame(offset_, state_)) {
+            return false;
+        }
+        ++nextFrame_;
+    }
+    return true;
+}
+
+bool ReplayStreamReader::Next(ReplayFrame& out) {
+    if (nextFrame_ >= frameCount_ || !DecodeFrame(offset_, state_)) {
+        return false;
+    }
+    out = state_;
+    ++nextFrame_;
+    return true;
+}
+
+// =====================================
+// input.log（旧テキスト形式）からの変換
+// =====================================
+
+bool ParseInputLogLine(const std::string& line, ReplayFrame& rec) {
+    // SessionLogger の prefix は "frame=" 以降を探してスキップ
+    const size_t fp = line.find("frame=");
+    if (fp == std::string::npos) {
+        return false;
+    }
+
+    rec = ReplayFrame{};
+    std::stringstream ss(line.substr(fp));
+    std::string token;
+    while (ss >> token) {
+        std::string v;
+        if (!(v = ValueOf(token, "dt=")).empty()) {
+            rec.dt = std::strtof(v.c_str(), nullptr);
+        } else if (token.compare(0, 3, "kb=") == 0) {
+            for (long code : SplitCsv(token.substr(3))) {
+                if (code >= 0 && code < 256) rec.keys[code] = 0x80;
+            }
+        } else if (token.compare(0, 6, "mouse=") == 0) {
+            auto m = SplitCsv(token.substr(6));
+            if (m.size() >= 4) {
+                rec.mdx = static_cast<int32_t>(m[0]); rec.mdy = static_cast<int32_t>(m[1]);
+                rec.mwheel = static_cast<int32_t>(m[2]); rec.mbtn = static_cast<int>(m[3]);
+            }
+        } else if (token.compare(0, 4, "pad=") == 0) {
+            auto p = SplitCsv(token.substr(4));
+            if (p.size() >= 8) {
+                rec.padConnected = (p[0] != 0);
+                rec.lx = static_cast<int16_t>(p[1]); rec.ly = static_cast<int16_t>(p[2]);
+                rec.rx = static_cast<int16_t>(p[3]); rec.ry = static_cast<int16_t>(p[4]);
+                rec.lt = static_cast<uint8_t>(p[5]); rec.rt = static_cast<uint8_t>(p[6]);
+                rec.btns = static_cast<uint16_t>(p[7]);
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> ConvertInputLog(std::istream& in, uint32_t seed, uint32_t keyframeInterval) {
+    ReplayStreamWriter writer;
+    writer.OpenMemory(seed, keyframeInterval);
+    std::string line;
+    ReplayFrame frame;
+    while (std::getline(in, line)) {
+        if (ParseInputLogLine(line, frame)) {
+            writer.Append(frame);
+        }
+    }
+    writer.Close();
+    return writer.GetBuffer();
+}
+
+bool ConvertInputLogFile(const std::string& inputLogPath, const std::string& replayPath, uint32_t seed) {
+    std::ifstream in(inputLogPath);
+    if (!in.is_open()) {
+        return false;
+    }
+    const std::vector<uint8_t> bytes = ConvertInputLog(in, seed);
+    std::ofstream out(replayPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return out.good();
+}
+
+// =====================================
+// ベンチマーク
+// =====================================
+
+namespace {
+    // 旧 ReplaySystem::RecordFrame と同じ 1 行（SessionLogger の prefix 付き）
+    void AppendInputLogLine(std::string& out, uint64_t frame, const ReplayFrame& r) {
+        out += "12:34:56.789 INPUT TRACE frame=" + std::to_string(frame) + " dt=" + std::to_string(r.dt);
+        out += " kb=";
+        bool first = true;
+        for (int i = 0; i < 256; ++i) {
+            if (r.keys[i] & 0x80) {
+                if (!first) out += ",";
+                out += std::to_string(i);
+                first = false;
+            }
+        }
+        out += " mouse=" + std::to_string(r.mdx) + "," + std::to_string(r.mdy)
+            + "," + std::to_string(r.mwheel) + "," + std::to_string(r.mbtn);
+        out += " pad=";
+        if (r.padConnected) {
+            out += "1," + std::to_string(r.lx) + "," + std::to_string(r.ly) + ","
+                + std::to_string(r.rx) + "," + std::to_string(r.ry) + ","
+                + std::to_string(static_cast<int>(r.lt)) + "," + std::to_string(static_cast<int>(r.rt)) + ","
+                + std::to_string(static_cast<int>(r.btns));
+        } else {
+            out += "0,0,0,0,0,0,0,0";
+        }
+        out += "\n";
+    }
+
+    // 1 時間ぶんのそれらしい入力（WASD の押しっぱなし区間、たまのマウス移動、スティックの揺れ）
+    std::vector<ReplayFrame> MakeSyntheticSession(size_t frameCount, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_int_distribution<int> jitter(-3, 3);
+        const int kMoveKeys[] = { 0x11, 0x1E, 0x1F, 0x20 };  // DIK_W/A/S/D
+
+        std::vector<ReplayFrame> frames(frameCount);
+        ReplayFrame state;
+        state.padConnected = true;
+        float stickPhase = 0.0f;
+        for (size_t i = 0; i < frameCount; ++i) {
+            // 可変 dt（16.6ms 前後）
+            state.dt = 1.0f / 60.0f + (unit(rng) - 0.5f) * 0.0004f;
+            // 移動キーはときどき押し替える
+            if (unit(rng) < 0.02f) {
+                const int key = kMoveKeys[rng() % 4];
+                state.keys[key] ^= 0x80;
+            }
+            if (unit(rng) < 0.002f) {
+                state.keys[0x39] ^= 0x80;  // DIK_SPACE
+            }
+            // マウスは 1 割のフレームだけ動く
+            if (unit(rng) < 0.1f) {
+                state.mdx = jitter(rng) * 4;
+                state.mdy = jitter(rng) * 2;
+            } else {
+                state.mdx = state.mdy = 0;
+            }
+            state.mbtn = (unit(rng) < 0.01f) ? (state.mbtn ^ 1) : state.mbtn;
+            // スティックはゆっくり回しつつ小さなノイズ
+            stickPhase += 0.01f;
+            state.lx = static_cast<int16_t>(std::sin(stickPhase) * 20000.0f) + static_cast<int16_t>(jitter(rng));
+            state.ly = static_cast<int16_t>(std::cos(stickPhase) * 20000.0f) + static_cast<int16_t>(jitter(rng));
+            state.rx = static_cast<int16_t>(jitter(rng));
+            state.ry = static_cast<int16_t>(jitter(rng));
+            state.rt = (unit(rng) < 0.01f) ? static_cast<uint8_t>(rng() % 256) : state.rt;
+            if (unit(rng) < 0.005f) state.btns ^= static_cast<uint16_t>(1 << (rng() % 16));
+            frames[i] = state;
+        }
+        return frames;
+    }
+}
+
+void RunReplayStreamBenchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    const size_t kFrameCount = 60 * 60 * 60;  // 60fps × 1 時間
+    const int kSeekCount = 1000;
+
+    const std::vector<ReplayFrame> frames = MakeSyntheticSession(kFrameCount, 1234u);
+
+    // テキスト（旧 input.log）とバイナリ（input.rpl）を作る
+    std::string text;
+    text.reserve(kFrameCount * 160);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        AppendInputLogLine(text, i, frames[i]);
+    }
+    ReplayStreamWriter writer;
+    writer.OpenMemory(1234u);
+    for (const ReplayFrame& frame : frames) {
+        writer.Append(frame);
+    }
+    writer.Close();
+    const std::vector<uint8_t> binary = writer.GetBuffer();
+
+    // 旧経路: 全行をパースして配列に展開（旧 InitializeReplay と同じ）
+    auto t0 = Clock::now();
+    std::vector<ReplayFrame> parsed;
+    {
+        std::istringstream in(text);
+        std::string line;
+        ReplayFrame frame;
+        while (std::getline(in, line)) {
+            if (ParseInputLogLine(line, frame)) parsed.push_back(frame);
+        }
+    }
+    const double textMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    // 新経路: 読み込み（Footer の索引を読むだけ）＋全フレームを順に展開
+    t0 = Clock::now();
+    ReplayStreamReader reader;
+    bool match = reader.LoadFromMemory(binary) && reader.GetFrameCount() == frames.size();
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    ReplayFrame frame;
+    size_t decoded = 0;
+    while (reader.Next(frame)) {
+        if (decoded < frames.size() && !SameFrame(frame, frames[decoded])) match = false;
+        ++decoded;
+    }
+    const double binaryMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    match = match && decoded == frames.size();
+
+    // ランダムシーク
+    std::mt19937 rng(99u);
+    bool seekMatch = true;
+    t0 = Clock::now();
+    for (int i = 0; i < kSeekCount; ++i) {
+        const uint64_t target = rng() % frames.size();
+        seekMatch = seekMatch && reader.Seek(target) && reader.Next(frame) && SameFrame(frame, frames[target]);
+    }
+    const double seekUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / kSeekCount;
+
+    // Footer を落としたファイル（記録中に落ちた想定）でも索引を作り直して読めるか
+    std::vector<uint8_t> truncated(binary.begin(), binary.begin() + static_cast<ptrdiff_t>(binary.size() / 2));
+    ReplayStreamReader recovered;
+    const bool recoverOk = recovered.LoadFromMemory(std::move(truncated)) && recovered.GetFrameCount() > 0
+        && recovered.Seek(recovered.GetFrameCount() - 1) && recovered.Next(frame)
+        && SameFrame(frame, frames[recovered.GetFrameCount() - 1]);
+
+    // 変換: input.log → input.rpl が旧パーサの結果と一致するか
+    std::istringstream textIn(text);
+    ReplayStreamReader converted;
+    bool convertMatch = converted.LoadFromMemory(ConvertInputLog(textIn, 1234u)) && converted.GetFrameCount() == parsed.size();
+    for (size_t i = 0; convertMatch && i < parsed.size(); ++i) {
+        convertMatch = converted.Next(frame) && SameFrame(frame, parsed[i]);
+    }
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Replay] %zu frames (1h @60fps): input.log %.1f MB -> input.rpl %.2f MB (x%.1f, %.1f bytes/frame)",
+        frames.size(), text.size() / (1024.0 * 1024.0), binary.size() / (1024.0 * 1024.0),
+        static_cast<double>(text.size()) / static_cast<double>(binary.size()),
+        static_cast<double>(binary.size()) / static_cast<double>(frames.size()));
+    LogBuffer::Instance().Add(buf);
+    std::snprintf(buf, sizeof(buf), "[Replay] load: text parse %.1f ms | rpl open %.3f ms, decode all %.1f ms (x%.1f)  %s",
+        textMs, loadMs, binaryMs, (binaryMs > 0.0) ? textMs / binaryMs : 0.0, match ? "match" : "MISMATCH");
+    LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    const bool ok = seekMatch && recoverOk && convertMatch;
+    std::snprintf(buf, sizeof(buf), "[Replay] random seek avg %.2f us (keyframe every %u frames)  seek %s  footerless recovery %s  input.log convert %s",
+        seekUs, ReplayStreamWriter::kDefaultKeyframeInterval, seekMatch ? "match" : "MISMATCH",
+        recoverOk ? "ok" : "FAILED", convertMatch ? "match" : "MISMATCH");
+    LogBuffer::Instance().Add(buf, ok ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+// =====================================
+// リプレイの入力ストリーム（input.rpl）
+// =====================================
+//
+//   Header (16 byte) : "RPLY", u32 version(=1), u32 seed, u32 keyframeInterval
+//   Frame            : u8 flags, 中身（flags で決まる）を 1 フレームずつ並べる
+//     キーフレーム   : frame % keyframeInterval == 0。前フレームに依存しない全状態
+//                      f32 dt, キー 256bit (32 byte), mouse(zigzag varint dx,dy,wheel + u8 btn),
+//                      pad(u8 connected, zigzag varint lx,ly,rx,ry, u8 lt,rt, varint btns)
+//     差分フレーム   : 前フレームから変わったものだけ
+//                      dt    : f32（値が変わったときだけ）
+//                      keys  : varint 件数 + 押下状態が反転した DIK コード(u8)×件数
+//                      mouse : 前フレームとの差を zigzag varint（dx,dy,wheel）+ u8 btn
+//                      pad   : u8 変更マスク + 変わった項目（スティックは前フレームとの差の zigzag varint）
+//   Footer           : "RIDX", u32 keyframeCount, u64 offset×keyframeCount, u64 frameCount,
+//                      u64 footerOffset, "REND"
+//
+// キーフレームの位置表（Footer）で任意フレームへ「直前のキーフレーム＋最大 keyframeInterval-1 フレームの差分」で飛べる。
+// 落ちて Footer が無いファイルは読み込み時にフレームを走査して表を作り直す。
+
+/// <summary>
+/// 1フレーム分の入力スナップショット（生デバイス状態）。
+/// </summary>
+struct ReplayFrame {
+    float    dt = 0.0f;
+    uint8_t  keys[256] = {};                 // DIK 押下状態（0x80=押下）
+    int32_t  mdx = 0, mdy = 0, mwheel = 0;   // マウス移動量
+    int      mbtn = 0;                       // マウスボタンマスク
+    bool     padConnected = false;
+    int16_t  lx = 0, ly = 0, rx = 0, ry = 0; // スティック生値
+    uint8_t  lt = 0, rt = 0;                 // トリガー生値
+    uint16_t btns = 0;                       // ボタンビット
+};
+
+/// <summary>
+/// input.rpl の書き込み。フレームはメモリ上のバッファに積み、キーフレームの手前か
+/// バッファが一定量を超えたときにまとめてファイルへ書く。ファイルを開かずに使うとメモリ上に全部残る（変換・ベンチマーク用）。
+/// 落ちたときは DrainForCrash で、まだファイルに出していない書き終わったフレームまでを書き出す。
+/// </summary>
+class ReplayStreamWriter {
+public:
+    static constexpr uint32_t kDefaultKeyframeInterval = 300;  // 60fps で 5 秒ごと
+
+    ~ReplayStreamWriter();
+
+    /// <summary>path を作り直して書き始める。開けなければ false。</summary>
+    bool Open(const std::string& path, uint32_t seed, uint32_t keyframeInterval = kDefaultKeyframeInterval);
+
+    /// <summary>ファイルを持たずにメモリへ書き始める（Close 後に GetBuffer で取り出す）。</summary>
+    void OpenMemory(uint32_t seed, uint32_t keyframeInterval = kDefaultKeyframeInterval);
+
+    /// <summary>1フレーム追記する。</summary>
+    void Append(const ReplayFrame& frame);
+
+    /// <summary>Footer を書いて閉じる。</summary>
+    void Close();
+
+    /// <summary>
+    /// バッファに積んだ書き終わりのフレームをロックを取らずにファイルへ出す（Footer は書かない。読み込み時に索引を作り直す）。
+    /// ファイルへ書き出し中のまま止まっている場合は、一定時間待って諦める。CrashHandler のトップレベル例外フィルタから呼ぶ。
+    /// </summary>
+    void DrainForCrash();
+
+    bool IsOpen() const { return open_; }
+    uint64_t GetFrameCount() const { return frameCount_; }
+    const std::vector<uint8_t>& GetBuffer() const { return buffer_; }
+
+private:
+    void FlushToFile();
+
+    std::ofstream file_;
+    bool open_ = false;
+    bool toFile_ = false;
+    uint32_t keyframeInterval_ = kDefaultKeyframeInterval;
+    uint64_t frameCount_ = 0;
+    uint64_t flushedBytes_ = 0;                 // ファイルへ書き出し済みのバイト数（オフセット計算用）
+    std::vector<uint8_t> buffer_;               // ファイル書き出し時は再確保しない容量を先に取る（DrainForCrash が読む）
+    std::atomic<size_t> committedBytes_{ 0 };   // buffer_ のうち書き終わったフレームまでのバイト数
+    std::atomic<bool> fileBusy_{ false };       // file_ へ書いている最中（DrainForCrash が取ったら以降は書かない）
+    std::vector<uint64_t> keyframeOffsets_;
+    ReplayFrame previous_;
+};
+
+/// <summary>
+/// input.rpl の読み出し。ファイル全体をメモリに置き、フレームは Next で 1 つずつ展開する
+/// （全フレームを FrameRecord の配列にはしない）。Seek で任意フレームへ飛べる。
+/// </summary>
+class ReplayStreamReader {
+public:
+    /// <summary>ファイルを読み込む。形式が違えば false。</summary>
+    bool Load(const std::string& path);
+
+    /// <summary>メモリ上のバイト列を引き取って読む。形式が違えば false。</summary>
+    bool LoadFromMemory(std::vector<uint8_t> data);
+
+    uint64_t GetFrameCount() const { return frameCount_; }
+    uint32_t GetSeed() const { return seed_; }
+    uint32_t GetKeyframeInterval() const { return keyframeInterval_; }
+
+    /// <summary>次に Next で取り出すフレーム番号。</summary>
+    uint64_t GetPosition() const { return nextFrame_; }
+
+    /// <summary>次の Next が frame 番目を返すようにする。範囲外なら false。</summary>
+    bool Seek(uint64_t frame);
+
+    /// <summary>次のフレームを展開する。終端なら false。</summary>
+    bool Next(ReplayFrame& out);
+
+private:
+    // offset から 1 フレーム読んで state に適用する。途中で切れていれば false
+    bool DecodeFrame(size_t& offset, ReplayFrame& state) const;
+    // Footer を読む。無い・壊れていれば false
+    bool ReadFooter();
+    // Footer が無いとき、先頭からフレームを走査してキーフレーム表とフレーム数を作る
+    void RebuildIndex();
+
+    std::vector<uint8_t> data_;
+    size_t streamEnd_ = 0;                      // フレーム列の終端（Footer の手前）
+    uint32_t seed_ = 0;
+    uint32_t keyframeInterval_ = ReplayStreamWriter::kDefaultKeyframeInterval;
+    uint64_t frameCount_ = 0;
+    std::vector<uint64_t> keyframeOffsets_;
+
+    size_t offset_ = 0;
+    uint64_t nextFrame_ = 0;
+    ReplayFrame state_;
+};
+
+/// <summary>
+/// 旧形式 input.log の 1 行（"... frame=N dt=.. kb=.. mouse=.. pad=.."）を ReplayFrame にする。
+/// "frame=" を含まない行なら false。
+/// </summary>
+bool ParseInputLogLine(const std::string& line, ReplayFrame& out);
+
+/// <summary>
+/// 旧形式 input.log のストリームを全部読み、input.rpl と同じバイト列にする。
+/// </summary>
+std::vector<uint8_t> ConvertInputLog(std::istream& in, uint32_t seed,
+    uint32_t keyframeInterval = ReplayStreamWriter::kDefaultKeyframeInterval);
+
+/// <summary>
+/// 旧形式 input.log ファイルを input.rpl ファイルへ変換する。読めない・書けなければ false。
+/// </summary>
+bool ConvertInputLogFile(const std::string& inputLogPath, const std::string& replayPath, uint32_t seed);
+
+/// <summary>
+/// 1 時間ぶんの合成入力で、input.log（テキスト）と input.rpl のサイズ・全フレームの読み込み時間、
+/// 往復の一致とランダムシークの一致を LogBuffer に出す。
+/// </summary>
+void RunReplayStreamBenchmark();
@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 
+#include "ReplayStream.h"
+
 class InputManager;
 
 /// <summary>
@@ -10,10 +12,11 @@ class InputManager;
 /// S.U.N.D.A.Y. が異常を検知したとき、同一シード＋記録した dt 列＋入力で
 /// エンジン内再生して再現性を確認するための土台。
 ///
-/// 記録は1フレーム1行で input.log（SessionLogger の Input カテゴリ）へ出力する。
-/// 生デバイス状態（キー/スティック/トリガー/ボタン/マウス）を丸ごと記録するため、
+/// 記録はセッションフォルダの input.rpl（ReplayStream.h のバイナリ形式）へ、前フレームとの差分だけを
+/// バッファ経由で追記する。生デバイス状態（キー/スティック/トリガー/ボタン/マウス）を丸ごと記録するため、
 /// 移動が生キー直読みでも忠実に再現できる。
-/// 再生は input.log を読み、ハードを読まずに各デバイスへ状態を注入する。
+/// 再生は input.rpl を読み、ハードを読まずに各デバイスへ状態を注入する。
+/// 旧形式（テキストの input.log）しか無いセッションは読み込み時に input.rpl へ変換する。
 /// </summary>
 class ReplaySystem {
 public:
@@ -31,8 +34,8 @@ public:
 
     /// <summary>
     /// Replay モードで初期化する。dir は記録時のセッションフォルダ
-    /// （例: "Logs/2026-06-11_212430"）。input.log を読み込み、
-    /// session.log から記録時シードも取り出す。
+    /// （例: "Logs/2026-06-11_212430"）。input.rpl（無ければ input.log を変換）を読み込み、
+    /// session.log から記録時シードも取り出す（session.log に無ければ input.rpl のヘッダから）。
     /// </summary>
     void InitializeReplay(const std::string& dir);
 
@@ -45,7 +48,7 @@ public:
     uint32_t GetLoadedSeed() const { return loadedSeed_; }
 
     /// <summary>
-    /// 1フレーム分の dt と現在の入力状態を input.log に記録する（Record モード）。
+    /// 1フレーム分の dt と現在の入力状態を input.rpl に記録する（Record モード）。
     /// Framework::Update の末尾で呼ぶ。
     /// </summary>
     void RecordFrame(float dt, InputManager* input);
@@ -57,31 +60,43 @@ public:
     /// </summary>
     bool AdvanceReplay(InputManager* input, float& outDt);
 
+    /// <summary>
+    /// 次の AdvanceReplay が frame 番目の記録を再生するように飛ぶ（Replay モード）。
+    /// 直前のキーフレームから差分を当てるだけなので、記録の長さによらず一定時間で終わる。
+    /// </summary>
+    bool SeekReplay(uint64_t frame);
+
+    /// <summary>
+    /// 再生する記録の総フレーム数（Replay モード）。
+    /// </summary>
+    uint64_t GetReplayFrameCount() const { return reader_.GetFrameCount(); }
+
+    /// <summary>
+    /// 記録中の input.rpl を閉じる（残りのバッファと索引を書き出す）。Framework::Finalize で呼ぶ。
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// 記録中の input.rpl へ、まだ書き出していないフレームをロックを取らずに出す（Footer は書かない）。
+    /// CrashHandler のトップレベル例外フィルタから呼ぶ。
+    /// </summary>
+    void DrainForCrash();
+
 private:
     ReplaySystem() = default;
     ~ReplaySystem() = default;
     ReplaySystem(const ReplaySystem&) = delete;
     ReplaySystem& operator=(const ReplaySystem&) = delete;
 
-    // 1フレーム分の入力スナップショット（生デバイス状態）
-    struct FrameRecord {
-        float    dt = 0.0f;
-        uint8_t  keys[256] = {};                 // DIK 押下状態（0x80=押下）
-        int32_t  mdx = 0, mdy = 0, mwheel = 0;   // マウス移動量
-        int      mbtn = 0;                       // マウスボタンマスク
-        bool     padConnected = false;
-        int16_t  lx = 0, ly = 0, rx = 0, ry = 0; // スティック生値
-        uint8_t  lt = 0, rt = 0;                 // トリガー生値
-        uint16_t btns = 0;                       // ボタンビット
-    };
-
     Mode     mode_ = Mode::Record;
     uint64_t frame_ = 0;          // Record 用の出力フレーム番号
     uint32_t seed_ = 0;
 
+    // Record 用
+    ReplayStreamWriter writer_;
+
     // Replay 用
-    std::vector<FrameRecord> records_;
-    size_t   replayIndex_ = 0;
+    ReplayStreamReader reader_;
     bool     hasLoadedSeed_ = false;
     uint32_t loadedSeed_ = 0;
 
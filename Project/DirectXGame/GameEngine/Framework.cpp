@@ -40,9 +40,17 @@
 #include "ISceneRunner.h"
 #include "CameraCapture.h"
 #include "PrimitivePipeline.h"
+#include "DynamicGeometryStream.h"
 #include "LineRenderer.h"
 #include "SkinningComputeManager.h"
 #include "PepperMacros.h"
+#include "JobSystem.h"
+#include "EngineTime.h"
+
+namespace {
+	// ヘッドレス再生で、描画 1 回あたりにシミュレーションへ使う実時間（この間は描画もメッセージ処理もしない）
+	constexpr std::chrono::milliseconds kHeadlessDrawInterval(250);
+}
 
 void Framework::Run() {
 	// KPI: 計測起点 (Run の入り口 = 実質プロセス開始直後)
@@ -88,9 +96,12 @@ void Framework::Initialize() {
 	SessionLogger::Instance().Initialize();
 
 	// 中央乱数とリプレイの初期化。
-	//   --replay <dir> : そのセッションフォルダの input.log を再生（シードも session.log から復元）
+	//   --replay <dir> : そのセッションフォルダの input.rpl を再生（シードも session.log から復元）
 	//   --seed N        : シードを明示指定（再生時は --replay の復元より優先）
 	//   どちらも無ければ random_device でシード生成し、通常プレイを記録する。
+	//   --fixed-hz N    : シーン更新を N Hz の固定ステップで回す（描画は前後 tick の間を補間）
+	//   --headless-replay <dir> : --replay と同じだが描画を間引いて最速で回し、tick/秒を報告して終了する
+	//   --trace         : 起動から終了まで全区間を記録し、セッションフォルダに trace.json を書き出す（USE_PEPPER 時）
 	{
 		uint32_t seed = 0;
 		bool seedProvided = false;
@@ -102,7 +113,13 @@ void Framework::Initialize() {
 				if (std::wcscmp(argv[i], L"--seed") == 0 && i + 1 < argc) {
 					seed = static_cast<uint32_t>(std::wcstoul(argv[i + 1], nullptr, 10));
 					seedProvided = true;
-				} else if (std::wcscmp(argv[i], L"--replay") == 0 && i + 1 < argc) {
+				} else if (std::wcscmp(argv[i], L"--fixed-hz") == 0 && i + 1 < argc) {
+					fixedStep_.SetHz(static_cast<uint32_t>(std::wcstoul(argv[i + 1], nullptr, 10)));
+				} else if (std::wcscmp(argv[i], L"--trace") == 0) {
+					PEPPER_START_TRACE();
+				} else if ((std::wcscmp(argv[i], L"--replay") == 0 ||
+					std::wcscmp(argv[i], L"--headless-replay") == 0) && i + 1 < argc) {
+					headless_ = (std::wcscmp(argv[i], L"--headless-replay") == 0);
 					const std::wstring w = argv[i + 1];
 					// パスは ASCII 前提。wchar_t→char は明示キャストして C4244 を避ける
 					replayDir.clear();
@@ -115,7 +132,7 @@ void Framework::Initialize() {
 
 		const bool replay = !replayDir.empty();
 		if (replay) {
-			// input.log を読み込み、記録時シードも復元する
+			// input.rpl（旧セッションなら input.log）を読み込み、記録時シードも復元する
 			ReplaySystem::Instance().InitializeReplay(replayDir);
 			if (!seedProvided && ReplaySystem::Instance().HasLoadedSeed()) {
 				seed = ReplaySystem::Instance().GetLoadedSeed();
@@ -134,6 +151,13 @@ void Framework::Initialize() {
 		if (!replay) {
 			ReplaySystem::Instance().InitializeRecord(seed);
 		}
+		headless_ = headless_ && replay;
+
+		// 固定ステップ：記録には tick ごとの dt（= 1/hz）が残るので、再生側は --fixed-hz 無しでも同じ結果になる
+		EngineTime::SetFixedStep(fixedStep_.IsEnabled());
+		if (fixedStep_.IsEnabled()) {
+			Log("[FixedStep] hz=" + std::to_string(fixedStep_.GetHz()) + "\n");
+		}
 	}
 
 	// COMの初期化
@@ -212,6 +236,8 @@ void Framework::Initialize() {
 	// リプレイ再生中は dt を記録値で供給するため、実時計ベースの FPS 制御を止める
 	if (ReplaySystem::Instance().GetMode() == ReplaySystem::Mode::Replay) {
 		dxCore_->SetReplayMode(true);
+		// ヘッドレスは記録時の速度に合わせて待たない
+		dxCore_->SetReplayPacing(!headless_);
 	}
 
 	// DirectStorage 初期化（device 作成後すぐ）
@@ -382,6 +408,9 @@ void Framework::Initialize() {
 	// 初期化時（SoundManagerのInitialize後に呼ぶ）
 	CameraCapture::GetInstance()->Initialize();
 
+	// フレーム内並列処理のワーカースレッド（アニメーション姿勢計算など）
+	JobSystem::GetInstance()->Initialize();
+
 	//==============================
 	// Inputの初期化
 	//==============================
@@ -519,26 +548,90 @@ void Framework::Update() {
 	// ===== ImGuiフレーム開始 =====
 	ImGuiManager::Instance().BeginFrame();
 
+	// このフレームで回す tick 数を決める。
+	//   ヘッドレス再生 : 描画 1 回あたり kHeadlessDrawInterval の間、記録を最速で回す
+	//   通常の再生     : 記録 1 フレーム = 1 tick（速度は UpdateFixFPS が記録の dt に合わせる）
+	//   固定ステップ   : 前フレームの実経過時間をアキュムレータに積み、溜まった tick 数だけ回す
+	//   既定（可変 dt）: 1 フレーム 1 tick
+	if (headless_) {
+		const auto now = std::chrono::steady_clock::now();
+		if (headlessTicks_ == 0) headlessStart_ = now;
+		const auto deadline = now + kHeadlessDrawInterval;
+		do {
+			const auto begin = std::chrono::steady_clock::now();
+			if (!StepSimulation()) {
+				ReportHeadlessReplay();
+				endRequest_ = true;
+				return;
+			}
+			headlessUpdateSeconds_ += std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - begin).count();
+			headlessSimulatedSeconds_ += dxCore_->GetDeltaTime();
+			++headlessTicks_;
+		} while (std::chrono::steady_clock::now() < deadline);
+		EngineTime::BeginRenderFrame(1.0f);
+		return;
+	}
+
+	const bool replay = ReplaySystem::Instance().GetMode() == ReplaySystem::Mode::Replay;
+	uint32_t ticks = 1;
+	float alpha = 1.0f;
+	if (!replay && fixedStep_.IsEnabled()) {
+		// dxCore の dt は前フレームの EndDraw（UpdateFixFPS）で測った実経過時間
+		ticks = fixedStep_.Advance(dxCore_->GetDeltaTime());
+		alpha = fixedStep_.GetAlpha();
+	}
+	for (uint32_t i = 0; i < ticks; ++i) {
+		if (!StepSimulation()) {
+			// 記録を再生し終えた → 終了
+			endRequest_ = true;
+			return;
+		}
+	}
+	EngineTime::BeginRenderFrame(alpha);
+}
+
+bool Framework::StepSimulation() {
 	// 入力の更新（再生中はハードを読まず、記録した入力を注入して dt も差し替える）
 	if (ReplaySystem::Instance().GetMode() == ReplaySystem::Mode::Replay) {
 		float replayDt = 0.0f;
 		if (!ReplaySystem::Instance().AdvanceReplay(input_.get(), replayDt)) {
-			// 記録を再生し終えた → 終了
-			endRequest_ = true;
-			return;
+			return false;
 		}
 		dxCore_->OverrideDeltaTime(replayDt);
 	} else {
 		input_->Update();
+		// 固定ステップ中はシーンに常に同じ dt を見せる（次の UpdateFixFPS で実時計の値に戻る）
+		if (fixedStep_.IsEnabled()) {
+			dxCore_->OverrideDeltaTime(fixedStep_.GetStepSeconds());
+		}
 	}
 
+	// 描画側の補間が「前 tick の状態」を退避できるよう、更新の前に tick を進める
+	EngineTime::AdvanceSimulationTick();
+
 	// シーンランナー（ゲームの SceneManager）の更新
 	if (auto* runner = GetSceneRunner()) runner->Update();
 
-	// リプレイ記録：このフレームが実際に使った dt と入力を input.log へ。
+	// リプレイ記録：この tick が実際に使った dt と入力を input.rpl へ。
 	// 入力・シーン更新の後（dt 確定済み、UpdateFixFPS は Draw 後なので今フレームの値）に記録する。
 	// （RecordFrame は Record モードのときだけ書き込む）
 	ReplaySystem::Instance().RecordFrame(dxCore_->GetDeltaTime(), input_.get());
+	return true;
+}
+
+void Framework::ReportHeadlessReplay() {
+	const double wallSeconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - headlessStart_).count();
+	const double ticksPerSecond = (wallSeconds > 0.0) ? headlessTicks_ / wallSeconds : 0.0;
+	const double updateTicksPerSecond =
+		(headlessUpdateSeconds_ > 0.0) ? headlessTicks_ / headlessUpdateSeconds_ : 0.0;
+	const double speed = (wallSeconds > 0.0) ? headlessSimulatedSeconds_ / wallSeconds : 0.0;
+	Log(std::format(
+		"[HeadlessReplay] ticks={} wall={:.2f}s ticks/s={:.0f} (update only {:.0f}) "
+		"simulated={:.1f}s speed=x{:.1f}\n",
+		headlessTicks_, wallSeconds, ticksPerSecond, updateTicksPerSecond,
+		headlessSimulatedSeconds_, speed));
 }
 
 void Framework::Finalize() {
@@ -562,6 +655,9 @@ void Framework::Finalize() {
 	// 終了時（SoundManagerのFinalize前に呼ぶ）
 	CameraCapture::GetInstance()->Finalize();
 
+	// ワーカースレッドを止める
+	JobSystem::GetInstance()->Finalize();
+
 	// 音声データ解放
 	SoundManager::GetInstance()->Finalize();
 
@@ -571,6 +667,9 @@ void Framework::Finalize() {
 	// プリミティブパイプライン終了処理
 	PrimitivePipeline::GetInstance()->Finalize();
 
+	// 動的ジオメトリ（雷など）のページ解放
+	DynamicGeometryStream::GetInstance()->Finalize();
+
 	// パーティクル終了処理
 	ParticleManager::GetInstance()->Finalize();
 
@@ -595,6 +694,14 @@ void Framework::Finalize() {
 	// 未出力のプロファイルウィンドウを書き出す（ログを閉じる前に）
 	PEPPER_FLUSH();
 
+	if (fixedStep_.GetDroppedTicks() > 0) {
+		Log("[FixedStep] dropped ticks=" + std::to_string(fixedStep_.GetDroppedTicks()) +
+			" (frame spikes beyond " + std::to_string(FixedTimestep::kDefaultMaxTicksPerFrame) + " ticks)\n");
+	}
+
+	// リプレイ記録を閉じる（残りのフレームとシーク用の索引を書き出す）
+	ReplaySystem::Instance().Finalize();
+
 	// セッションログを閉じる（全ファイルを flush）
 	SessionLogger::Instance().Finalize();
 }
\ No newline at end of file
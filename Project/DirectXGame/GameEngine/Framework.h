@@ -24,6 +24,7 @@
 #include "SkyboxManager.h"
 #include "SkinningComputeManager.h"
 #include "ShadowMap.h"
+#include "FixedTimestep.h"
 
 // 前方宣言
 class ConvertStringClass;
@@ -90,12 +91,33 @@ public:
 	ShadowMap* GetShadowMap() const { return shadowMap_.get(); }
 
 protected:
+	/// <summary>
+	/// シミュレーションを 1 tick 進める（入力 or リプレイ注入 → シーン更新 → 記録）。
+	/// リプレイを再生し終えていたら何もせず false。
+	/// </summary>
+	bool StepSimulation();
+
+	/// <summary>
+	/// ヘッドレス再生の結果（tick 数・tick/秒・実時間比）をログに出す。
+	/// </summary>
+	void ReportHeadlessReplay();
+
 	// 終了リクエストフラグ
 	bool endRequest_ = false;
 
 	// CLI フラグ: --no-dstorage で DStorage 経路を封じる (KPI 計測比較用)
 	bool noDStorage_ = false;
 
+	// 固定ステップ更新（--fixed-hz N。未指定なら従来どおり 1 描画フレーム 1 更新の可変 dt）
+	FixedTimestep fixedStep_;
+
+	// ヘッドレス再生（--headless-replay <dir>）：描画を間引いて記録を最速で回し、tick/秒を報告して終了する
+	bool headless_ = false;
+	uint64_t headlessTicks_ = 0;
+	double headlessSimulatedSeconds_ = 0.0;  // 再生した記録の dt 合計（ゲーム内時間）
+	double headlessUpdateSeconds_ = 0.0;     // シーン更新だけに掛かった実時間
+	std::chrono::steady_clock::time_point headlessStart_{};
+
 	// KPI 計測: Run() の冒頭で起点を打ち、最初の Update で経過時間 + VRAM/RAM/CPU をログに出す
 	std::chrono::high_resolution_clock::time_point kpiStartTime_{};
 	uint64_t kpiStartCpuTime100ns_ = 0;  // GetProcessTimes の Kernel+User (100ns 単位)
@@ -75,4 +75,30 @@ void Camera::Update()
 	projectionMatrix_ = MakePerspectiveFovMatrix(horizontalFovY_, aspectRatio_, nearClip_, farClip_);
 
 	viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+
+	history_.Record(shakingTransform);
+	useRenderInterpolation_ = true;
+}
+
+const Matrix4x4& Camera::GetRenderViewProjectionMatrix() const
+{
+	if (!useRenderInterpolation_ || EngineTime::GetInterpolationAlpha() >= 1.0f) {
+		return viewProjectionMatrix_;
+	}
+	// 描画フレームごとに 1 回だけ作り直す（オブジェクトごとに呼ばれるため）
+	if (history_.NeedsRender()) {
+		const Transform t = history_.Interpolated();
+		renderViewProjectionMatrix_ = Multiply(Inverse(MakeAffineMatrix(t)), projectionMatrix_);
+		renderTranslate_ = t.translate;
+	}
+	return renderViewProjectionMatrix_;
+}
+
+Vector3 Camera::GetRenderTranslate() const
+{
+	if (!useRenderInterpolation_ || EngineTime::GetInterpolationAlpha() >= 1.0f) {
+		return transform_.translate;
+	}
+	GetRenderViewProjectionMatrix();
+	return renderTranslate_;
 }
@@ -3,6 +3,7 @@
 #include"Matrix4x4.h"
 #include"MathUtility.h"
 #include"WindowsApplication.h"
+#include"TransformHistory.h"
 
 class Camera
 {
@@ -24,6 +25,12 @@ class Camera
 	float shakeElapsed_ = 0.0f;          // シェイク経過時間
 	Vector3 shakeOffset_{ 0.0f, 0.0f, 0.0f }; // 適用中のオフセット（Update() で加算される）
 
+	// 固定ステップ時の描画補間（シェイク込みの transform を tick ごとに記録する）
+	mutable TransformHistory history_;
+	mutable Matrix4x4 renderViewProjectionMatrix_;
+	mutable Vector3 renderTranslate_{};
+	bool useRenderInterpolation_ = false; // SetExternalMatrices で外部注入された行列は補間しない
+
 public:
 
 	// デフォルトコンストラクタ
@@ -50,6 +57,7 @@ public:
 		projectionMatrix_ = projection;
 		viewProjectionMatrix_ = Multiply(view, projection);
 		transform_.translate = translate;
+		useRenderInterpolation_ = false;
 	}
 	void SetFovY(const float& fovY) { horizontalFovY_ = fovY; }
 	void SetAspectRatio(const float& aspectRatio) { aspectRatio_ = aspectRatio; }
@@ -87,6 +95,18 @@ public:
 	const Matrix4x4& GetViewMatrix() const { return viewMatrix_; }
 	const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
 	const Matrix4x4& GetViewProjectionMatrix() const { return viewProjectionMatrix_; }
+
+	/// <summary>
+	/// 描画用のビュープロジェクション行列。固定ステップ中は前 tick と最新 tick の間を補間したもの
+	/// （それ以外は GetViewProjectionMatrix と同じ）。ゲームロジックは補間しない方を使うこと。
+	/// </summary>
+	const Matrix4x4& GetRenderViewProjectionMatrix() const;
+
+	/// <summary>描画用のカメラ位置（GetRenderViewProjectionMatrix と同じ補間）。</summary>
+	Vector3 GetRenderTranslate() const;
+
+	/// <summary>カットの切り替えなどでカメラを飛ばした直後に呼ぶ（その間を補間で通らない）。</summary>
+	void ResetInterpolation() { history_.Reset(); }
 	const Vector3& GetRotate() const { return transform_.rotate; }
 	const Vector3& GetTranslate() const { return transform_.translate; }
 	Vector3 GetForward() const { return Normalize(Vector3{ worldMatrix_.m[2][0], worldMatrix_.m[2][1], worldMatrix_.m[2][2] }); }
@@ -1,7 +1,21 @@
 #pragma once
 #include <cstdint>
 #include <cstring>
+#ifdef _WIN32
 #include <dxgiformat.h>
+#else
+// Windows SDK の無い環境（tools/cpp/headless_bench の CPU 側ベンチマーク）向けに、ここで使う値だけ同じ番号で定義する
+enum DXGI_FORMAT : uint32_t {
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_BC1_UNORM = 71,
+	DXGI_FORMAT_BC2_UNORM = 74,
+	DXGI_FORMAT_BC3_UNORM = 77,
+	DXGI_FORMAT_BC4_UNORM = 80,
+	DXGI_FORMAT_BC4_SNORM = 81,
+	DXGI_FORMAT_BC5_UNORM = 83,
+	DXGI_FORMAT_BC5_SNORM = 84,
+};
+#endif
 
 // =====================================================================
 // DDS ファイルヘッダー解析ユーティリティ
@@ -0,0 +1,327 @@
+#include "EffectCurveLut.h"
+#include "EffectDef.h"
+#include "LogBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <emmintrin.h>
+#include <random>
+#include <string>
+
+namespace {
+    bool gExactEvaluation = false;
+
+    // t(0..1) → 表の添字 i（0..count-2）と i..i+1 間の補間係数。t=1 は i=count-2, fr=1 で最後のサンプルになる
+    inline float SampleClamped(const float* lut, uint32_t count, float t) {
+        if (!(t > 0.0f)) return lut[0];   // NaN もここで先頭へ
+        if (t > 1.0f) t = 1.0f;
+        const float f = t * static_cast<float>(count - 1);
+        uint32_t i = static_cast<uint32_t>(f);
+        if (i > count - 2) i = count - 2;
+        const float fr = f - static_cast<float>(i);
+        return lut[i] + (lut[i + 1] - lut[i]) * fr;
+    }
+
+    Vector4 LerpColor(const Vector4& a, const Vector4& b, float u) {
+        return {
+            a.x + (b.x - a.x) * u,
+            a.y + (b.y - a.y) * u,
+            a.z + (b.z - a.z) * u,
+            a.w + (b.w - a.w) * u,
+        };
+    }
+}
+
+//==========================================================
+// EffectLut
+//==========================================================
+
+namespace EffectLut {
+
+    void BakeCurve(const EffectCurve& curve, float* out, uint32_t count) {
+        if (count < 2) return;
+        const float step = 1.0f / static_cast<float>(count - 1);
+        for (uint32_t i = 0; i < count; ++i) {
+            out[i] = curve.Evaluate(static_cast<float>(i) * step);
+        }
+    }
+
+    float Sample(const float* lut, uint32_t count, float t) {
+        return SampleClamped(lut, count, t);
+    }
+
+    void SampleBatch(const float* lut, uint32_t count, const float* t, float* out, size_t n) {
+        if (count < 2) return;
+        size_t k = 0;
+        const __m128  zero  = _mm_setzero_ps();
+        const __m128  one   = _mm_set1_ps(1.0f);
+        const __m128  scale = _mm_set1_ps(static_cast<float>(count - 1));
+        const __m128i last  = _mm_set1_epi32(static_cast<int>(count - 2));
+        alignas(16) int32_t idx[4];
+        for (; k + 4 <= n; k += 4) {
+            // max(t, 0) は t が NaN なら 0 を返す（スカラー版と同じく先頭サンプルになる）
+            const __m128 tv = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(t + k), zero), one);
+            const __m128 f = _mm_mul_ps(tv, scale);
+            __m128i i = _mm_cvttps_epi32(f);  // f >= 0 なので切り捨て = floor
+            // min(i, count - 2)（SSE2 に整数 min が無いので比較で選ぶ）
+            const __m128i over = _mm_cmpgt_epi32(i, last);
+            i = _mm_or_si128(_mm_and_si128(over, last), _mm_andnot_si128(over, i));
+            const __m128 fr = _mm_sub_ps(f, _mm_cvtepi32_ps(i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(idx), i);
+            const __m128 a = _mm_setr_ps(lut[idx[0]], lut[idx[1]], lut[idx[2]], lut[idx[3]]);
+            const __m128 b = _mm_setr_ps(lut[idx[0] + 1], lut[idx[1] + 1], lut[idx[2] + 1], lut[idx[3] + 1]);
+            _mm_storeu_ps(out + k, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), fr)));
+        }
+        for (; k < n; ++k) out[k] = SampleClamped(lut, count, t[k]);
+    }
+
+    float MaxKnotError(const EffectCurve& curve, const float* lut, uint32_t count) {
+        if (count < 2) return 0.0f;
+        float maxErr = 0.0f;
+        auto probe = [&](float t) {
+            if (!(t >= 0.0f && t <= 1.0f)) return;
+            maxErr = std::max(maxErr, std::abs(SampleClamped(lut, count, t) - curve.Evaluate(t)));
+        };
+        // 表のサンプル点では差が 0 なので、残る折れ目は制御点だけ（同じ x の制御点による段差は前後で拾う）
+        for (const Vector2& p : curve.points) {
+            probe(p.x);
+            probe(std::nextafter(p.x, -1.0f));
+            probe(std::nextafter(p.x, 2.0f));
+        }
+        return maxErr;
+    }
+
+    void SetExactEvaluation(bool exact) { gExactEvaluation = exact; }
+    bool IsExactEvaluation() { return gExactEvaluation; }
+
+} // namespace EffectLut
+
+//==========================================================
+// EffectCurveLut
+//==========================================================
+
+void EffectCurveLut::Bake(const EffectCurve& curve) {
+    identity = !curve.enabled || curve.points.size() < 2;
+    exact = false;
+    tableError = 0.0f;
+    if (identity) return;
+    EffectLut::BakeCurve(curve, samples, kSamples);
+    tableError = EffectLut::MaxKnotError(curve, samples, kSamples);
+
+    // 値の変わる区間が 2 セルより短いと、その区間の形（鋭い立ち上がり・山の頂点）は表に残らないので誤差によらず直接評価
+    constexpr float kMinSpan = 2.0f / static_cast<float>(kSamples - 1);
+    for (size_t i = 1; i < curve.points.size() && !exact; ++i) {
+        const Vector2& a = curve.points[i - 1];
+        const Vector2& b = curve.points[i];
+        exact = (b.x - a.x) < kMinSpan && a.y != b.y && b.x > 0.0f && a.x < 1.0f;
+    }
+    if (tableError > kMaxTableError) exact = true;
+}
+
+float EffectCurveLut::Sample(float t) const {
+    if (identity) return t;
+    return SampleClamped(samples, kSamples, t);
+}
+
+float EffectCurveLut::Evaluate(const EffectCurve& source, float t) const {
+    return (exact || gExactEvaluation) ? source.Evaluate(t) : Sample(t);
+}
+
+//==========================================================
+// EffectGradientLut
+//==========================================================
+
+void EffectGradientLut::Bake(const Vector4& startColor, const std::vector<EffectColorKey>& midKeys, const Vector4& endColor) {
+    // Start(loc=0) / End(loc=1) を両端キー、colorKeys を中間キーとして location 昇順に並べる
+    struct Key { float location; Vector4 color; };
+    std::vector<Key> keys;
+    keys.reserve(midKeys.size() + 2);
+    keys.push_back({ 0.0f, startColor });
+    for (const EffectColorKey& k : midKeys) keys.push_back({ k.location, k.color });
+    keys.push_back({ 1.0f, endColor });
+    std::stable_sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) { return a.location < b.location; });
+
+    // GPU の定数バッファに入るぶんだけ（従来どおり先頭から kMaxKeys 個）
+    keyCount = static_cast<uint32_t>(std::min<size_t>(keys.size(), kMaxKeys));
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        keyLocation[i] = keys[i].location;
+        keyColor[i] = keys[i].color;
+    }
+}
+
+Vector4 EffectGradientLut::EvaluateExact(float t) const {
+    if (keyCount == 0) return { 1.0f, 1.0f, 1.0f, 1.0f };
+    if (t <= keyLocation[0]) return keyColor[0];
+    for (uint32_t i = 0; i + 1 < keyCount; ++i) {
+        const float l0 = keyLocation[i];
+        const float l1 = keyLocation[i + 1];
+        if (t <= l1) {
+            const float u = (l1 > l0) ? (t - l0) / (l1 - l0) : 0.0f;
+            return LerpColor(keyColor[i], keyColor[i + 1], u);
+        }
+    }
+    return keyColor[keyCount - 1];
+}
+
+//==========================================================
+// EffectDefLuts
+//==========================================================
+
+std::shared_ptr<const EffectDefLuts> EffectDefLuts::Bake(const EffectDef& def) {
+    auto luts = std::make_shared<EffectDefLuts>();
+    auto bake = [&luts](EffectCurveLut& lut, const EffectCurve& curve) {
+        lut.Bake(curve);
+        if (lut.identity) return;
+        ++luts->bakedCurveCount;
+        if (lut.exact) {
+            ++luts->exactCurveCount;
+        } else {
+            luts->maxTableError = std::max(luts->maxTableError, lut.tableError);
+        }
+    };
+    luts->primitives.resize(def.primitives.size());
+    for (size_t i = 0; i < def.primitives.size(); ++i) {
+        const EffectPrimitiveComponent& pc = def.primitives[i];
+        Primitive& lut = luts->primitives[i];
+        bake(lut.scale, pc.scaleCurve);
+        bake(lut.pos, pc.posCurve);
+        bake(lut.dissolve, pc.dissolveCurve);
+    }
+    luts->particles.resize(def.particles.size());
+    for (size_t i = 0; i < def.particles.size(); ++i) {
+        const EffectParticleComponent& pc = def.particles[i];
+        Particle& lut = luts->particles[i];
+        EffectLut::BakeCurve(pc.convergeCurve, lut.convergeLut, kConvergeSamples);
+        luts->maxConvergeError = std::max(luts->maxConvergeError,
+            EffectLut::MaxKnotError(pc.convergeCurve, lut.convergeLut, kConvergeSamples));
+        for (float& v : lut.convergeLut) v = std::clamp(v, 0.0f, 1.0f);
+        lut.gradient.Bake(pc.startColor, pc.colorKeys, pc.endColor);
+    }
+    return luts;
+}
+
+//==========================================================
+// ベンチマーク
+//==========================================================
+
+namespace {
+    volatile float gBenchSink = 0.0f;
+
+    EffectCurve MakeRandomCurve(std::mt19937& rng, uint32_t pointCount) {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        EffectCurve c;
+        c.enabled = true;
+        c.points.resize(pointCount);
+        std::vector<float> xs(pointCount);
+        xs.front() = 0.0f;
+        xs.back() = 1.0f;
+        for (uint32_t i = 1; i + 1 < pointCount; ++i) xs[i] = unit(rng);
+        std::sort(xs.begin(), xs.end());
+        for (uint32_t i = 0; i < pointCount; ++i) c.points[i] = { xs[i], unit(rng) };
+        return c;
+    }
+}
+
+void RunEffectCurveBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kCurvesPerSize = 64;
+    constexpr size_t kEvalsPerCurve = 16384;
+
+    std::mt19937 rng(20260417u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> ts(kEvalsPerCurve);
+    for (float& t : ts) t = unit(rng);
+    std::vector<float> out(kEvalsPerCurve);
+    std::vector<float> outBatch(kEvalsPerCurve);
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Effect] Curve eval: %u random curves x %zu t per point count (ns per eval)",
+        kCurvesPerSize, kEvalsPerCurve);
+    LogBuffer::Instance().Add(buf);
+
+    auto nsPerEval = [&](Clock::time_point t0) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / (double(kCurvesPerSize) * kEvalsPerCurve);
+    };
+
+    std::vector<EffectCurve> allCurves;
+    for (uint32_t pointCount : { 2u, 4u, 8u, 16u }) {
+        std::vector<EffectCurve> curves;
+        std::vector<EffectCurveLut> luts(kCurvesPerSize);
+        for (uint32_t c = 0; c < kCurvesPerSize; ++c) {
+            curves.push_back(MakeRandomCurve(rng, pointCount));
+            luts[c].Bake(curves.back());
+        }
+
+        float sink = 0.0f;
+        auto t0 = Clock::now();
+        for (const EffectCurve& curve : curves) {
+            for (size_t k = 0; k < kEvalsPerCurve; ++k) out[k] = curve.Evaluate(ts[k]);
+            sink += out[kEvalsPerCurve - 1];
+        }
+        const double exactNs = nsPerEval(t0);
+
+        t0 = Clock::now();
+        for (const EffectCurveLut& lut : luts) {
+            for (size_t k = 0; k < kEvalsPerCurve; ++k) out[k] = lut.Sample(ts[k]);
+            sink += out[kEvalsPerCurve - 1];
+        }
+        const double lutNs = nsPerEval(t0);
+
+        t0 = Clock::now();
+        for (const EffectCurveLut& lut : luts) {
+            EffectLut::SampleBatch(lut.samples, EffectCurveLut::kSamples, ts.data(), outBatch.data(), kEvalsPerCurve);
+            sink += outBatch[kEvalsPerCurve - 1];
+        }
+        const double batchNs = nsPerEval(t0);
+        gBenchSink = sink;
+
+        // まとめ引きはスカラーの表引きと同じ値になるはず（最後のカーブで確認）
+        float batchDiff = 0.0f;
+        for (size_t k = 0; k < kEvalsPerCurve; ++k) batchDiff = std::max(batchDiff, std::abs(out[k] - outBatch[k]));
+        const bool match = batchDiff < 1e-6f;
+
+        std::snprintf(buf, sizeof(buf), "[Effect]  %2u pts: exact %.2f  lut %.2f (x%.1f)  lut SSE2 batch %.2f (x%.1f)  %s",
+            pointCount, exactNs, lutNs, (lutNs > 0.0) ? exactNs / lutNs : 0.0,
+            batchNs, (batchNs > 0.0) ? exactNs / batchNs : 0.0, match ? "match" : "MISMATCH");
+        LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+        allCurves.insert(allCurves.end(), curves.begin(), curves.end());
+    }
+
+    // 精度：サンプル数ごとに、表引きと直接評価の差（全カーブ・等間隔 4096 点）
+    constexpr uint32_t kProbe = 4096;
+    for (uint32_t count : { 32u, 65u, 129u, 257u }) {
+        std::vector<float> lut(count);
+        double maxErr = 0.0;
+        double sumErr = 0.0;
+        for (const EffectCurve& curve : allCurves) {
+            EffectLut::BakeCurve(curve, lut.data(), count);
+            for (uint32_t k = 0; k <= kProbe; ++k) {
+                const float t = static_cast<float>(k) / kProbe;
+                const double err = std::abs(double(EffectLut::Sample(lut.data(), count, t)) - curve.Evaluate(t));
+                maxErr = std::max(maxErr, err);
+                sumErr += err;
+            }
+        }
+        std::snprintf(buf, sizeof(buf), "[Effect] LUT %3u samples%s: max err %.4f  avg err %.5f",
+            count, count == EffectCurveLut::kSamples ? " (CPU)" : (count == 32 ? " (GPU converge)" : ""),
+            maxErr, sumErr / (double(allCurves.size()) * (kProbe + 1)));
+        LogBuffer::Instance().Add(buf);
+    }
+
+    // EffectCurveLut として焼いたとき：exact に回るカーブ数と、Evaluate（表か直接評価）の最大誤差
+    uint32_t exactCount = 0;
+    float evalMaxErr = 0.0f;
+    for (const EffectCurve& curve : allCurves) {
+        EffectCurveLut lut;
+        lut.Bake(curve);
+        if (lut.exact) {
+            ++exactCount;
+        } else {
+            evalMaxErr = std::max(evalMaxErr, lut.tableError);
+        }
+    }
+    std::snprintf(buf, sizeof(buf), "[Effect] LUT %3u samples knot-aware: %u / %zu curves exact, Evaluate max err %.4f",
+        EffectCurveLut::kSamples, exactCount, allCurves.size(), evalMaxErr);
+    LogBuffer::Instance().Add(buf);
+}
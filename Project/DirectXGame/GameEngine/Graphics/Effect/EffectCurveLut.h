@@ -0,0 +1,120 @@
+#pragma once
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct EffectCurve;
+struct EffectColorKey;
+struct EffectDef;
+
+/// <summary>
+/// EffectCurve / 色グラデーションを等間隔サンプルの表に焼いて引くための共通処理。
+/// 表の並びは GPU の収束 LUT（UpdateParticle.CS の SampleConvergeLUT）と同じで、
+/// count 個のサンプル i が t = i / (count - 1) に対応し、間は線形補間する。
+/// CPU 側の表（EffectCurveLut）も GPU へ渡す 32 サンプルも BakeCurve で焼く。
+/// </summary>
+namespace EffectLut {
+
+    /// <summary>curve を count 個（2 以上）のサンプルに焼いて out に書く。値は 0..1 にクランプしない（カーブのまま）。</summary>
+    void BakeCurve(const EffectCurve& curve, float* out, uint32_t count);
+
+    /// <summary>焼いた表を t(0..1 にクランプ) で引く。SampleConvergeLUT と同じ式。</summary>
+    float Sample(const float* lut, uint32_t count, float t);
+
+    /// <summary>
+    /// 同じ表を n 個の t でまとめて引く（out[k] = Sample(lut, count, t[k])）。
+    /// 添字と補間係数の計算・補間は SSE2 で 4 個ずつ、表の読み出しだけスカラー。
+    /// </summary>
+    void SampleBatch(const float* lut, uint32_t count, const float* t, float* out, size_t n);
+
+    /// <summary>
+    /// 焼いた表と curve の最大誤差。区分線形どうしの差は制御点で最大になるので、制御点とその直前・直後だけを見る。
+    /// </summary>
+    float MaxKnotError(const EffectCurve& curve, const float* lut, uint32_t count);
+
+    /// <summary>
+    /// true なら EffectCurveLut::Evaluate が表を使わず元のカーブを直接評価する
+    /// （見た目の差を確かめる用。既定 false）。メインスレッドからだけ触る。
+    /// </summary>
+    void SetExactEvaluation(bool exact);
+    bool IsExactEvaluation();
+
+} // namespace EffectLut
+
+/// <summary>
+/// EffectCurve を kSamples 個に焼いた表。def ごとに 1 回焼き（EffectDefLuts）、
+/// 毎フレームの評価は区間探索なしの O(1) で引く。カーブ無効（恒等）なら表を持たず t をそのまま返す。
+/// 表は制御点の間をまたぐセルで角を削るので、2 セルより短い区間がある・制御点での誤差が kMaxTableError を超える
+/// カーブは exact にして元のカーブを直接評価する（立ち上がりの鋭いカーブを表が鈍らせないように）。
+/// </summary>
+struct EffectCurveLut {
+    static constexpr uint32_t kSamples = 65;  // 64 区間（0.5 / 0.25 など切りのいい位置の制御点がサンプルに乗る）
+    static constexpr float    kMaxTableError = 1.0f / 256.0f;
+
+    bool  identity = true;
+    bool  exact = false;         // true なら Evaluate は表を使わない
+    float tableError = 0.0f;     // 焼いた表の最大誤差（exact でも表は焼くので、その表の値）
+    float samples[kSamples] = {};
+
+    void  Bake(const EffectCurve& curve);
+    /// <summary>表だけを引く（exact かどうかは見ない）。</summary>
+    float Sample(float t) const;
+
+    /// <summary>通常は Sample。exact か EffectLut::IsExactEvaluation() なら source.Evaluate(t)（source は焼いた元のカーブ）。</summary>
+    float Evaluate(const EffectCurve& source, float t) const;
+};
+
+/// <summary>
+/// 多色グラデーション（start / 中間キー / end）を並べたもの。
+/// keyLocation / keyColor は location 昇順に並べ、GPUParticleManager::kMaxGradientKeys 個までに詰めた GPU 用のキー
+/// （バーストのたびに並べ替えずにそのまま SetEmitterGradient へ渡す）。色は GPU だけが引くので CPU 側の表は持たない。
+/// </summary>
+struct EffectGradientLut {
+    static constexpr uint32_t kMaxKeys = 8;   // GPUParticleManager::kMaxGradientKeys と同じ
+
+    uint32_t keyCount = 0;
+    float    keyLocation[kMaxKeys] = {};
+    Vector4  keyColor[kMaxKeys] = {};
+
+    void    Bake(const Vector4& startColor, const std::vector<EffectColorKey>& midKeys, const Vector4& endColor);
+    /// <summary>キーを線形に探して補間する（GPU の EvalGradient と同じ結果）。</summary>
+    Vector4 EvaluateExact(float t) const;
+};
+
+/// <summary>
+/// 1 つの EffectDef のカーブ・グラデーションを成分ごとに焼いたもの。primitives / particles は def の成分と同じ並び。
+/// EffectManager が def を登録・差し替えたあと最初に使うときに 1 回だけ焼き、そこから再生するインスタンスは
+/// 同じものを shared_ptr で参照する（インスタンスごとには焼かない）。
+/// </summary>
+struct EffectDefLuts {
+    static constexpr uint32_t kConvergeSamples = 32;  // GPUParticleManager::kConvergeLutSamples と同じ
+
+    struct Primitive {
+        EffectCurveLut scale;
+        EffectCurveLut pos;
+        EffectCurveLut dissolve;
+    };
+    struct Particle {
+        float convergeLut[kConvergeSamples] = {};  // convergeCurve を 0..1 にクランプして焼いた GPU 用の表
+        EffectGradientLut gradient;
+    };
+
+    std::vector<Primitive> primitives;
+    std::vector<Particle>  particles;
+
+    // 読み込み時の報告用（EffectManager がログに出す）
+    uint32_t bakedCurveCount = 0;     // 表を焼いたカーブ（恒等を除く）
+    uint32_t exactCurveCount = 0;     // そのうち exact にしたもの
+    float    maxTableError = 0.0f;    // exact にしなかったカーブの表の最大誤差
+    float    maxConvergeError = 0.0f; // GPU へ渡す収束 LUT の最大誤差（GPU 側は直接評価に切り替えられない）
+
+    static std::shared_ptr<const EffectDefLuts> Bake(const EffectDef& def);
+};
+
+/// <summary>
+/// ランダムなカーブで、直接評価 / 表（スカラー）/ 表（SSE2 まとめ引き）の速さと、
+/// 32〜257 サンプルでの誤差（最大・平均）、exact に切り替えたあとの Evaluate の誤差を計って LogBuffer に出す。
+/// </summary>
+void RunEffectCurveBenchmark();
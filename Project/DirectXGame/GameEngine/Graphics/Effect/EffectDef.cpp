@@ -20,10 +20,189 @@ float EffectCurve::Evaluate(float t) const {
     return points.back().y;
 }
 
+//==========================================================
+// .defs のフィールド並び（EffectDef.h の宣言順と同じに保つ）
+//==========================================================
+
+template <class Ar>
+void CookFields(Ar& ar, EffectCurve& v) {
+    ar.Field(v.enabled);
+    ar.Field(v.points);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectColorKey& v) {
+    ar.Field(v.location);
+    ar.Field(v.color);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectPrimitiveComponent& v) {
+    ar.Field(v.displayName);
+    ar.Field(v.meshType);
+    ar.Field(v.ringParams);
+    ar.Field(v.cylinderParams);
+    ar.Field(v.helixParams);
+    ar.Field(v.beamParams);
+    ar.Field(v.lightningParams);
+    ar.Field(v.frameParams);
+    ar.Field(v.offset);
+    ar.Field(v.rotate);
+    ar.Field(v.randomRotateOnSpawn);
+    ar.Field(v.randomRotateRange);
+    ar.Field(v.rotateSpeed);
+    ar.Field(v.startTime);
+    ar.Field(v.lifetime);
+    ar.Field(v.startScale);
+    ar.Field(v.endScale);
+    ar.Field(v.startColor);
+    ar.Field(v.endColor);
+    ar.Field(v.scaleCurve);
+    ar.Field(v.hueShiftEnable);
+    ar.Field(v.hueShiftSpeed);
+    ar.Field(v.usePositionAnim);
+    ar.Field(v.startPos);
+    ar.Field(v.endPos);
+    ar.Field(v.posCurve);
+    ar.Field(v.texturePath);
+    ar.Field(v.blendMode);
+    ar.Field(v.timeGroup);
+    ar.Field(v.billboardMode);
+    ar.Field(v.depthWrite);
+    ar.Field(v.alphaReference);
+    ar.Field(v.cullBackface);
+    ar.Field(v.samplerMode);
+    ar.Field(v.viewAngleFadePower);
+    ar.Field(v.uvAutoScroll);
+    ar.Field(v.uvScrollSpeed);
+    ar.Field(v.uvOffset);
+    ar.Field(v.uvScale);
+    ar.Field(v.uvFlipU);
+    ar.Field(v.uvFlipV);
+    ar.Field(v.useDistortion);
+    ar.Field(v.distortionTexturePath);
+    ar.Field(v.distortionStrength);
+    ar.Field(v.distortionUvAutoScroll);
+    ar.Field(v.distortionUvScrollSpeed);
+    ar.Field(v.distortionUvOffset);
+    ar.Field(v.distortionUvScale);
+    ar.Field(v.distortionUvFlipU);
+    ar.Field(v.distortionUvFlipV);
+    ar.Field(v.useDissolve);
+    ar.Field(v.dissolveMaskPath);
+    ar.Field(v.dissolveInEnable);
+    ar.Field(v.dissolveInStartTime);
+    ar.Field(v.dissolveInDuration);
+    ar.Field(v.dissolveOutEnable);
+    ar.Field(v.dissolveOutStartTime);
+    ar.Field(v.dissolveOutDuration);
+    ar.Field(v.dissolveCurve);
+    ar.Field(v.dissolveEdgeEnable);
+    ar.Field(v.dissolveEdgeColor);
+    ar.Field(v.dissolveEdgeWidth);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectParticleComponent& v) {
+    ar.Field(v.displayName);
+    ar.Field(v.gpuParticleGroupName);
+    ar.Field(v.texturePath);
+    ar.Field(v.offset);
+    ar.Field(v.startTime);
+    ar.Field(v.duration);
+    ar.Field(v.burstCount);
+    ar.Field(v.billboardMode);
+    ar.Field(v.blendMode);
+    ar.Field(v.timeGroup);
+    ar.Field(v.colorMode);
+    ar.Field(v.startColor);
+    ar.Field(v.endColor);
+    ar.Field(v.colorKeys);
+    ar.Field(v.hueShiftEnable);
+    ar.Field(v.hueShiftSpeed);
+    ar.Field(v.hueShiftRandomPhase);
+    ar.Field(v.scaleMin);
+    ar.Field(v.scaleMax);
+    ar.Field(v.uniformScale);
+    ar.Field(v.startScale);
+    ar.Field(v.endScale);
+    ar.Field(v.emitRadius);
+    ar.Field(v.particleLifeTime);
+    ar.Field(v.emitShape);
+    ar.Field(v.ringNormal);
+    ar.Field(v.ringThickness);
+    ar.Field(v.velocityMode);
+    ar.Field(v.velocityDir);
+    ar.Field(v.velocitySpeed);
+    ar.Field(v.velocityJitter);
+    ar.Field(v.randomRotateOnSpawn);
+    ar.Field(v.randomRotateRange);
+    ar.Field(v.rotateSpeed);
+    ar.Field(v.orbitEnabled);
+    ar.Field(v.orbitSpinSpeed);
+    ar.Field(v.orbitTumbleSpeed);
+    ar.Field(v.orbitTumbleAxis);
+    ar.Field(v.convergeEnable);
+    ar.Field(v.convergeCurve);
+    ar.Field(v.useDissolve);
+    ar.Field(v.dissolveMaskPath);
+    ar.Field(v.dissolveInEnable);
+    ar.Field(v.dissolveInEnd);
+    ar.Field(v.dissolveOutEnable);
+    ar.Field(v.dissolveOutStart);
+    ar.Field(v.dissolveEdgeEnable);
+    ar.Field(v.dissolveEdgeColor);
+    ar.Field(v.dissolveEdgeWidth);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectLightComponent& v) {
+    ar.Field(v.displayName);
+    ar.Field(v.kind);
+    ar.Field(v.offset);
+    ar.Field(v.direction);
+    ar.Field(v.startTime);
+    ar.Field(v.lifetime);
+    ar.Field(v.color);
+    ar.Field(v.startIntensity);
+    ar.Field(v.endIntensity);
+    ar.Field(v.range);
+    ar.Field(v.spotCosAngle);
+    ar.Field(v.spotCosFalloffStart);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectSoundComponent& v) {
+    ar.Field(v.displayName);
+    ar.Field(v.soundName);
+    ar.Field(v.offset);
+    ar.Field(v.startTime);
+    ar.Field(v.distanceScale);
+    ar.Field(v.volume);
+}
+
+template <class Ar>
+void CookFields(Ar& ar, EffectDef& v) {
+    ar.Field(v.name);
+    ar.Field(v.totalDuration);
+    ar.Field(v.loop);
+    ar.Field(v.primitives);
+    ar.Field(v.particles);
+    ar.Field(v.lights);
+    ar.Field(v.sounds);
+}
+
+COOKED_DEFS_INSTANTIATE(EffectCurve);
+COOKED_DEFS_INSTANTIATE(EffectPrimitiveComponent);
+COOKED_DEFS_INSTANTIATE(EffectParticleComponent);
+COOKED_DEFS_INSTANTIATE(EffectLightComponent);
+COOKED_DEFS_INSTANTIATE(EffectSoundComponent);
+COOKED_DEFS_INSTANTIATE(EffectDef);
+
 namespace {
     // ===== 小さなパースヘルパ =====
 
-    Vector3 AsVec3(const JsonValue& v, const Vector3& fallback) {
+    Vector3 AsVec3(const JsonNode& v, const Vector3& fallback) {
         if (!v.IsArray() || v.Size() < 3) return fallback;
         return {
             static_cast<float>(v[0].AsDouble(fallback.x)),
@@ -32,7 +211,7 @@ namespace {
         };
     }
 
-    Vector2 AsVec2(const JsonValue& v, const Vector2& fallback) {
+    Vector2 AsVec2(const JsonNode& v, const Vector2& fallback) {
         if (!v.IsArray() || v.Size() < 2) return fallback;
         return {
             static_cast<float>(v[0].AsDouble(fallback.x)),
@@ -40,7 +219,7 @@ namespace {
         };
     }
 
-    Vector4 AsVec4(const JsonValue& v, const Vector4& fallback) {
+    Vector4 AsVec4(const JsonNode& v, const Vector4& fallback) {
         if (!v.IsArray() || v.Size() < 4) return fallback;
         return {
             static_cast<float>(v[0].AsDouble(fallback.x)),
@@ -50,17 +229,17 @@ namespace {
         };
     }
 
-    float AsFloat(const JsonValue& v, float fallback) {
+    float AsFloat(const JsonNode& v, float fallback) {
         if (!v.IsNumber()) return fallback;
         return static_cast<float>(v.AsDouble(fallback));
     }
 
     // EffectCurve をパース。{ "enabled": bool, "points": [[x,y], ...] }
-    EffectCurve AsCurve(const JsonValue& v, const EffectCurve& fallback) {
+    EffectCurve AsCurve(const JsonNode& v, const EffectCurve& fallback) {
         if (!v.IsObject()) return fallback;
         EffectCurve c;
         if (v["enabled"].IsBool()) c.enabled = v["enabled"].AsBool(c.enabled);
-        const JsonValue& pts = v["points"];
+        const JsonNode& pts = v["points"];
         if (pts.IsArray() && pts.Size() >= 2) {
             c.points.clear();
             for (size_t i = 0; i < pts.Size(); ++i) {
@@ -70,21 +249,21 @@ namespace {
         return c;
     }
 
-    int AsInt(const JsonValue& v, int fallback) {
+    int AsInt(const JsonNode& v, int fallback) {
         if (!v.IsNumber()) return fallback;
         return static_cast<int>(v.AsInt(fallback));
     }
 
-    uint32_t AsUInt(const JsonValue& v, uint32_t fallback) {
+    uint32_t AsUInt(const JsonNode& v, uint32_t fallback) {
         if (!v.IsNumber()) return fallback;
         int64_t i = v.AsInt(static_cast<int64_t>(fallback));
         if (i < 0) return 0;
         return static_cast<uint32_t>(i);
     }
 
-    BillboardMode AsBillboardMode(const JsonValue& v, BillboardMode fallback) {
+    BillboardMode AsBillboardMode(const JsonNode& v, BillboardMode fallback) {
         if (v.IsString()) {
-            const std::string& s = v.AsString();
+            const std::string_view s = v.AsStringView();
             if (s == "None")  return BillboardMode::None;
             if (s == "Full")  return BillboardMode::Full;
             if (s == "YAxis") return BillboardMode::YAxis;
@@ -95,9 +274,9 @@ namespace {
         return fallback;
     }
 
-    EffectLightKind AsLightKind(const JsonValue& v, EffectLightKind fallback) {
+    EffectLightKind AsLightKind(const JsonNode& v, EffectLightKind fallback) {
         if (v.IsString()) {
-            const std::string& s = v.AsString();
+            const std::string_view s = v.AsStringView();
             if (s == "Point") return EffectLightKind::Point;
             if (s == "Spot")  return EffectLightKind::Spot;
         }
@@ -106,7 +285,7 @@ namespace {
 
     // ===== 形状パラメータのパース =====
 
-    void ParseFrameParams(const JsonValue& o, PrimitiveGenerator::FrameParams& p) {
+    void ParseFrameParams(const JsonNode& o, PrimitiveGenerator::FrameParams& p) {
         if (!o.IsObject()) return;
         p.outerWidth  = AsFloat(o["outerWidth"],  p.outerWidth);
         p.outerHeight = AsFloat(o["outerHeight"], p.outerHeight);
@@ -115,7 +294,7 @@ namespace {
         p.color       = AsVec4(o["color"], p.color);
     }
 
-    void ParseRingParams(const JsonValue& o, PrimitiveGenerator::RingParams& p) {
+    void ParseRingParams(const JsonNode& o, PrimitiveGenerator::RingParams& p) {
         if (!o.IsObject()) return;
         p.outerRadius = AsFloat(o["outerRadius"], p.outerRadius);
         p.innerRadius = AsFloat(o["innerRadius"], p.innerRadius);
@@ -126,7 +305,7 @@ namespace {
         p.endAngle    = AsFloat(o["endAngle"], p.endAngle);
     }
 
-    void ParseCylinderParams(const JsonValue& o, PrimitiveGenerator::CylinderParams& p) {
+    void ParseCylinderParams(const JsonNode& o, PrimitiveGenerator::CylinderParams& p) {
         if (!o.IsObject()) return;
         p.topRadius    = AsFloat(o["topRadius"], p.topRadius);
         p.bottomRadius = AsFloat(o["bottomRadius"], p.bottomRadius);
@@ -138,7 +317,7 @@ namespace {
         p.endAngle     = AsFloat(o["endAngle"], p.endAngle);
     }
 
-    void ParseBeamAppearance(const JsonValue& o, PrimitiveGenerator::BeamAppearance& a) {
+    void ParseBeamAppearance(const JsonNode& o, PrimitiveGenerator::BeamAppearance& a) {
         if (!o.IsObject()) return;
         a.startWidth      = AsFloat(o["startWidth"], a.startWidth);
         a.endWidth        = AsFloat(o["endWidth"], a.endWidth);
@@ -151,7 +330,7 @@ namespace {
         a.uvTilesPerUnit  = AsFloat(o["uvTilesPerUnit"], a.uvTilesPerUnit);
     }
 
-    void ParseBeamParams(const JsonValue& o, PrimitiveGenerator::BeamParams& p) {
+    void ParseBeamParams(const JsonNode& o, PrimitiveGenerator::BeamParams& p) {
         if (!o.IsObject()) return;
         p.startPos       = AsVec3(o["startPos"], p.startPos);
         p.endPos         = AsVec3(o["endPos"], p.endPos);
@@ -159,7 +338,7 @@ namespace {
         ParseBeamAppearance(o["appearance"], p.appearance);
     }
 
-    void ParseLightningParams(const JsonValue& o, PrimitiveGenerator::LightningBoltParams& p) {
+    void ParseLightningParams(const JsonNode& o, PrimitiveGenerator::LightningBoltParams& p) {
         if (!o.IsObject()) return;
         p.startPos          = AsVec3(o["startPos"], p.startPos);
         p.endPos            = AsVec3(o["endPos"], p.endPos);
@@ -174,7 +353,7 @@ namespace {
         ParseBeamAppearance(o["appearance"], p.appearance);
     }
 
-    void ParseHelixParams(const JsonValue& o, PrimitiveGenerator::HelixParams& p) {
+    void ParseHelixParams(const JsonNode& o, PrimitiveGenerator::HelixParams& p) {
         if (!o.IsObject()) return;
         p.startHelixRadius = AsFloat(o["startHelixRadius"], p.startHelixRadius);
         p.endHelixRadius   = AsFloat(o["endHelixRadius"], p.endHelixRadius);
@@ -190,7 +369,7 @@ namespace {
 
     // ===== コンポーネント別パース =====
 
-    void ParsePrimitive(const JsonValue& o, EffectPrimitiveComponent& c) {
+    void ParsePrimitive(const JsonNode& o, EffectPrimitiveComponent& c) {
         if (o["displayName"].IsString()) c.displayName = o["displayName"].AsString();
         c.meshType   = AsInt(o["meshType"], c.meshType);
         // 形状ごとのジオメトリパラメータ
@@ -274,7 +453,7 @@ namespace {
         c.dissolveEdgeWidth = AsFloat(o["dissolveEdgeWidth"], c.dissolveEdgeWidth);
     }
 
-    void ParseParticle(const JsonValue& o, EffectParticleComponent& c) {
+    void ParseParticle(const JsonNode& o, EffectParticleComponent& c) {
         if (o["displayName"].IsString()) c.displayName = o["displayName"].AsString();
         if (o["gpuParticleGroupName"].IsString()) {
             c.gpuParticleGroupName = o["gpuParticleGroupName"].AsString();
@@ -332,10 +511,10 @@ namespace {
         c.dissolveEdgeWidth = AsFloat(o["dissolveEdgeWidth"], c.dissolveEdgeWidth);
         // 多色グラデーションキー
         c.colorKeys.clear();
-        const JsonValue& ck = o["colorKeys"];
+        const JsonNode& ck = o["colorKeys"];
         if (ck.IsArray()) {
             for (size_t i = 0; i < ck.Size(); ++i) {
-                const JsonValue& k = ck[i];
+                const JsonNode& k = ck[i];
                 EffectColorKey key;
                 key.location = AsFloat(k["location"], key.location);
                 key.color    = AsVec4(k["color"], key.color);
@@ -348,7 +527,7 @@ namespace {
         if (o["hueShiftRandomPhase"].IsBool()) c.hueShiftRandomPhase = o["hueShiftRandomPhase"].AsBool(c.hueShiftRandomPhase);
     }
 
-    void ParseSound(const JsonValue& o, EffectSoundComponent& c) {
+    void ParseSound(const JsonNode& o, EffectSoundComponent& c) {
         if (o["displayName"].IsString()) c.displayName = o["displayName"].AsString();
         if (o["soundName"].IsString()) c.soundName = o["soundName"].AsString();
         c.offset        = AsVec3(o["offset"], c.offset);
@@ -357,7 +536,7 @@ namespace {
         c.volume        = AsFloat(o["volume"], c.volume);
     }
 
-    void ParseLight(const JsonValue& o, EffectLightComponent& c) {
+    void ParseLight(const JsonNode& o, EffectLightComponent& c) {
         if (o["displayName"].IsString()) c.displayName = o["displayName"].AsString();
         c.kind           = AsLightKind(o["kind"], c.kind);
         c.offset         = AsVec3(o["offset"], c.offset);
@@ -376,12 +555,12 @@ namespace {
 namespace EffectDefIO {
 
     bool LoadFromFile(const std::string& filePath, EffectDef& out) {
-        auto result = JsonParser::ParseFile(filePath);
-        if (!result.success || !result.value.IsObject()) {
+        auto result = JsonParser::ParseDocumentFile(filePath);
+        if (!result.success || !result.document.Root().IsObject()) {
             return false;
         }
 
-        const JsonValue& root = result.value;
+        const JsonNode& root = result.document.Root();
 
         if (root["name"].IsString()) {
             out.name = root["name"].AsString();
@@ -390,7 +569,7 @@ namespace EffectDefIO {
         if (root["loop"].IsBool()) out.loop = root["loop"].AsBool(out.loop);
 
         // primitives
-        const JsonValue& prims = root["primitives"];
+        const JsonNode& prims = root["primitives"];
         if (prims.IsArray()) {
             out.primitives.clear();
             out.primitives.reserve(prims.Size());
@@ -402,7 +581,7 @@ namespace EffectDefIO {
         }
 
         // particles
-        const JsonValue& parts = root["particles"];
+        const JsonNode& parts = root["particles"];
         if (parts.IsArray()) {
             out.particles.clear();
             out.particles.reserve(parts.Size());
@@ -414,7 +593,7 @@ namespace EffectDefIO {
         }
 
         // lights
-        const JsonValue& lights = root["lights"];
+        const JsonNode& lights = root["lights"];
         if (lights.IsArray()) {
             out.lights.clear();
             out.lights.reserve(lights.Size());
@@ -426,7 +605,7 @@ namespace EffectDefIO {
         }
 
         // sounds
-        const JsonValue& sounds = root["sounds"];
+        const JsonNode& sounds = root["sounds"];
         if (sounds.IsArray()) {
             out.sounds.clear();
             out.sounds.reserve(sounds.Size());
@@ -756,4 +935,31 @@ namespace EffectDefIO {
         return JsonWriter::WriteFile(filePath, root, { true, 2 });
     }
 
+    bool LoadAllInDirectory(const std::string& dirPath, std::vector<EffectDef>& out,
+        CookedDefs::Mode mode, std::vector<std::string>* failedPaths) {
+        const std::string cookedPath = CookedDefs::CookedPathFor(dirPath);
+        const std::vector<CookedDefs::SourceInfo> sources = CookedDefs::ScanSources(dirPath);
+
+        if (mode != CookedDefs::Mode::JsonOnly) {
+            if (CookedDefs::LoadRecords(cookedPath, kCookedKind, &sources, out)) return true;
+            if (mode == CookedDefs::Mode::CookedOnly) return false;
+        }
+
+        std::vector<EffectDef> defs;
+        defs.reserve(sources.size());
+        for (const CookedDefs::SourceInfo& source : sources) {
+            EffectDef def{};
+            if (!LoadFromFile(source.path, def)) {
+                if (failedPaths) failedPaths->push_back(source.path);
+                continue;
+            }
+            defs.push_back(std::move(def));
+        }
+        if (mode == CookedDefs::Mode::PreferCooked) {
+            CookedDefs::SaveRecords(cookedPath, kCookedKind, sources, defs);
+        }
+        out = std::move(defs);
+        return true;
+    }
+
 }
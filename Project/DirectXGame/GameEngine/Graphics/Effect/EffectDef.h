@@ -4,6 +4,7 @@
 #include "Vector4.h"
 #include "BillboardMode.h"
 #include "PrimitiveGenerator.h"  // RingParams / CylinderParams / HelixParams
+#include "CookedDefs.h"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -345,6 +346,15 @@ struct EffectDef {
     std::vector<EffectSoundComponent>     sounds;
 };
 
+// フィールド並び（CookedDefs の .defs 読み書き用。定義と実体化は EffectDef.cpp）
+template <class Ar> void CookFields(Ar& ar, EffectCurve& v);
+template <class Ar> void CookFields(Ar& ar, EffectColorKey& v);
+template <class Ar> void CookFields(Ar& ar, EffectPrimitiveComponent& v);
+template <class Ar> void CookFields(Ar& ar, EffectParticleComponent& v);
+template <class Ar> void CookFields(Ar& ar, EffectLightComponent& v);
+template <class Ar> void CookFields(Ar& ar, EffectSoundComponent& v);
+template <class Ar> void CookFields(Ar& ar, EffectDef& v);
+
 namespace EffectDefIO {
     /// <summary>
     /// 1ファイルからEffectDefを読み込む。失敗時はfalse。
@@ -356,4 +366,16 @@ namespace EffectDefIO {
     /// EffectDef を JSON ファイルに保存する。失敗時はfalse。
     /// </summary>
     bool SaveToFile(const std::string& filePath, const EffectDef& def);
+
+    /// <summary>
+    /// dirPath 直下の *.json をすべて読む（パス順）。
+    /// PreferCooked なら焼き込み済みの .defs（Resources/Cooked/...）が元 JSON と一致すればそちらを使い、
+    /// 無い・古いときは JSON から読んで焼き直す。読めなかった JSON は failedPaths に入れる。
+    /// </summary>
+    bool LoadAllInDirectory(const std::string& dirPath, std::vector<EffectDef>& out,
+        CookedDefs::Mode mode = CookedDefs::Mode::PreferCooked,
+        std::vector<std::string>* failedPaths = nullptr);
+
+    /// <summary>.defs の種別</summary>
+    constexpr uint32_t kCookedKind = CookedDefs::MakeKind('E', 'F', 'C', 'T');
 }
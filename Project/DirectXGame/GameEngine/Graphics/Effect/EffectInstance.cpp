@@ -143,6 +143,11 @@ namespace {
         }
     }
 
+    // 出現ごとにメッシュの形が変わるか（乱数シード 0 の雷は毎回別のボルトにする）
+    bool PrimitiveMeshIsRandomPerSpawn(const EffectPrimitiveComponent& pc) {
+        return pc.meshType == 7 && pc.lightningParams.randomSeed == 0;
+    }
+
     // メッシュ再生成不要な静的パラメータ（blend / billboard / material / UV / distortion）を
     // 既存レンダラへ適用する。spawn 時と SyncFromDef のライブ反映で共用する。
     void ApplyPrimitiveStaticParams(EffectPrimitiveRenderer& r, const EffectPrimitiveComponent& pc) {
@@ -181,7 +186,8 @@ namespace {
     }
 }
 
-void EffectInstance::Initialize(const EffectDef& def, const Vector3& worldPos, GPUParticleManager* gpu) {
+void EffectInstance::Initialize(const EffectDef& def, const Vector3& worldPos, GPUParticleManager* gpu,
+                                std::shared_ptr<const EffectDefLuts> luts) {
     def_ = def;
     worldPos_ = worldPos;
     elapsedTime_ = 0.0f;
@@ -195,6 +201,39 @@ void EffectInstance::Initialize(const EffectDef& def, const Vector3& worldPos, G
     for (auto& l : lights_) {
         l.slot = kInvalidLightSlot;
     }
+    AdoptLuts(std::move(luts));
+}
+
+void EffectInstance::AdoptLuts(std::shared_ptr<const EffectDefLuts> luts) {
+    static_assert(EffectDefLuts::kConvergeSamples == GPUParticleManager::kConvergeLutSamples,
+                  "convergeLut must match the GPU LUT size");
+    luts_ = luts ? std::move(luts) : EffectDefLuts::Bake(def_);
+    for (ParticleRuntime& rt : particles_) {
+        // グループ名が変わったかもしれないので、次の Update で引き直す
+        rt.groupNameResolved = false;
+        rt.groupId = kInvalidParticleGroupId;
+    }
+}
+
+void EffectInstance::Prewarm() {
+    for (size_t i = 0; i < def_.primitives.size(); ++i) {
+        const EffectPrimitiveComponent& pc = def_.primitives[i];
+        PrimitiveRuntime& rt = primitives_[i];
+        if (rt.renderer) continue;
+        rt.rendererShown = false;
+        rt.renderer = std::make_unique<EffectPrimitiveRenderer>();
+        rt.renderer->Initialize(pc.meshType, pc.texturePath,
+                                pc.ringParams, pc.cylinderParams, pc.helixParams, pc.beamParams,
+                                pc.lightningParams, pc.frameParams);
+        ApplyPrimitiveStaticParams(*rt.renderer, pc);
+    }
+}
+
+void EffectInstance::Restart(const Vector3& worldPos) {
+    Rewind();
+    worldPos_ = worldPos;
+    worldRotation_ = { 0.0f, 0.0f, 0.0f };
+    handle_ = 0;
 }
 
 std::string EffectInstance::EffGroupName(const std::string& name) const {
@@ -202,11 +241,40 @@ std::string EffectInstance::EffGroupName(const std::string& name) const {
     return std::string(GPUParticleManager::kPreviewPrefix) + name;
 }
 
-void EffectInstance::CollectPreviewGroupNames(std::vector<std::string>& out) const {
-    if (!isPreview_) return;
-    for (const auto& pc : def_.particles) {
-        if (pc.gpuParticleGroupName.empty()) continue;
-        out.push_back(EffGroupName(pc.gpuParticleGroupName));
+void EffectInstance::SetPreview(bool p) {
+    if (isPreview_ == p) return;
+    isPreview_ = p;
+    // プレフィックスの有無が変わるので、グループは次の Update で引き直す
+    for (auto& rt : particles_) {
+        rt.groupNameResolved = false;
+        rt.groupId = kInvalidParticleGroupId;
+    }
+}
+
+ParticleGroupId EffectInstance::ResolveParticleGroup(size_t index) {
+    ParticleRuntime& rt = particles_[index];
+    if (gpu_->HasGroup(rt.groupId)) return rt.groupId;
+    if (!rt.groupNameResolved) {
+        rt.groupName = EffGroupName(def_.particles[index].gpuParticleGroupName);
+        rt.groupNameResolved = true;
+    }
+    rt.groupId = rt.groupName.empty() ? kInvalidParticleGroupId : gpu_->FindGroup(rt.groupName);
+    return rt.groupId;
+}
+
+void EffectInstance::CollectPreviewGroups(std::vector<ParticleGroupId>& out) const {
+    if (!isPreview_ || !gpu_) return;
+    for (size_t i = 0; i < particles_.size() && i < def_.particles.size(); ++i) {
+        const ParticleRuntime& rt = particles_[i];
+        if (gpu_->HasGroup(rt.groupId)) {
+            out.push_back(rt.groupId);
+            continue;
+        }
+        // まだ引いていない（作られたばかり / def が変わった直後）なら名前で引く
+        const std::string name = rt.groupNameResolved ? rt.groupName : EffGroupName(def_.particles[i].gpuParticleGroupName);
+        if (name.empty()) continue;
+        const ParticleGroupId id = gpu_->FindGroup(name);
+        if (id != kInvalidParticleGroupId) out.push_back(id);
     }
 }
 
@@ -234,12 +302,23 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
         float local = rt.clock - pc.startTime;
         if (local < 0.0f) continue;
 
-        // 開始：レンダラ生成
+        // 開始：レンダラが無ければ生成（ループ・プール再生では前回のものを使い回す）
         if (!rt.started) {
-            rt.renderer = std::make_unique<EffectPrimitiveRenderer>();
-            rt.renderer->Initialize(pc.meshType, pc.texturePath,
-                                    pc.ringParams, pc.cylinderParams, pc.helixParams, pc.beamParams,
-                                    pc.lightningParams, pc.frameParams);
+            // 乱数シード 0 の雷は、前回表示したメッシュを使い回さず新しい乱数で作り直す（従来どおり毎回別の形）
+            if (rt.renderer && rt.rendererShown && PrimitiveMeshIsRandomPerSpawn(pc)) {
+                rt.renderer.reset();
+            }
+            if (!rt.renderer) {
+                rt.renderer = std::make_unique<EffectPrimitiveRenderer>();
+                rt.renderer->Initialize(pc.meshType, pc.texturePath,
+                                        pc.ringParams, pc.cylinderParams, pc.helixParams, pc.beamParams,
+                                        pc.lightningParams, pc.frameParams);
+                // blend / billboard / material / UV / distortion（SyncFromDef のライブ反映と共用）
+                ApplyPrimitiveStaticParams(*rt.renderer, pc);
+            } else {
+                rt.renderer->ResetUVScroll();
+            }
+            rt.rendererShown = true;
 
             // 向きの初期化：基準 rotate（× 出現時ランダム）をクオータニオンで合成。
             Quaternion baseQ = QuaternionFromEuler(pc.rotate);
@@ -250,9 +329,6 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
                 baseQ = Multiply(baseQ, randQ);
             }
             rt.orientation = Normalize(baseQ);
-
-            // blend / billboard / material / UV / distortion（SyncFromDef のライブ反映と共用）
-            ApplyPrimitiveStaticParams(*rt.renderer, pc);
             rt.started = true;
         }
 
@@ -263,7 +339,7 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
 
         float t = Saturate(local / life);
         // Scale はカーブ（イージング）で t を再マップしてから補間（既定 enabled=false なら線形）
-        Vector3 scale = LerpV3(pc.startScale, pc.endScale, pc.scaleCurve.Evaluate(t));
+        Vector3 scale = LerpV3(pc.startScale, pc.endScale, luts_->primitives[i].scale.Evaluate(pc.scaleCurve, t));
         Vector4 color = LerpV4(pc.startColor, pc.endColor, t);
         // Hue 回転（生存中のシームレス色変化）。経過秒に沿って色相を回す（彩度/明度/α保持）。
         if (pc.hueShiftEnable) {
@@ -286,7 +362,7 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
         const bool hasWorldRot = (worldRotation_.x != 0.0f || worldRotation_.y != 0.0f || worldRotation_.z != 0.0f);
         // 位置：usePositionAnim なら StartPos→EndPos をカーブで補間、そうでなければ静的 offset。
         Vector3 baseOffset = pc.usePositionAnim
-            ? LerpV3(pc.startPos, pc.endPos, pc.posCurve.Evaluate(t))
+            ? LerpV3(pc.startPos, pc.endPos, luts_->primitives[i].pos.Evaluate(pc.posCurve, t))
             : pc.offset;
         Vector3 offset = baseOffset;
         Quaternion finalQ = rt.orientation;
@@ -311,7 +387,7 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
                 float d = pc.dissolveInDuration > 0.0001f ? pc.dissolveInDuration : 0.0001f;
                 // 進行度 progress(0→1) をカーブで再マップ。In は threshold = 1 - progress。
                 float p = Saturate(t / d);
-                float inTh = (t <= 0.0f) ? 1.0f : 1.0f - pc.dissolveCurve.Evaluate(p);
+                float inTh = (t <= 0.0f) ? 1.0f : 1.0f - luts_->primitives[i].dissolve.Evaluate(pc.dissolveCurve, p);
                 if (inTh > th) th = inTh;
             }
             if (pc.dissolveOutEnable) {
@@ -319,7 +395,7 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
                 float d = pc.dissolveOutDuration > 0.0001f ? pc.dissolveOutDuration : 0.0001f;
                 // 進行度 progress(0→1) をカーブで再マップ。Out は threshold = progress。
                 float p = Saturate(t / d);
-                float outTh = (t <= 0.0f) ? 0.0f : pc.dissolveCurve.Evaluate(p);
+                float outTh = (t <= 0.0f) ? 0.0f : luts_->primitives[i].dissolve.Evaluate(pc.dissolveCurve, p);
                 if (outTh > th) th = outTh;
             }
             bool active = pc.useDissolve && !pc.dissolveMaskPath.empty()
@@ -329,9 +405,8 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
 
         rt.renderer->Update(camera, compDt);
 
-        // 寿命終了（totalDuration を超えた場合も含む）
+        // 寿命終了（totalDuration を超えた場合も含む）。レンダラは残して非表示にするだけ
         if (local >= life || elapsedTime_ >= def_.totalDuration) {
-            rt.renderer.reset();
             rt.finished = true;
         }
     }
@@ -346,8 +421,8 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
         // （Effect グループなら必殺技の World 停止中でも startTime に達して発射できる）。
         rt.clock += groupDt(pc.timeGroup);
 
-        // プレビューインスタンスならグループ名にプレフィックスを付け、シーンと物理バッファを分離する。
-        const std::string groupName = EffGroupName(pc.gpuParticleGroupName);
+        // グループはハンドルで持つ（プレビューインスタンスならプレフィックス付きの名前で引き、シーンと物理バッファを分離する）。
+        ParticleGroupId group = ResolveParticleGroup(i);
 
         // orbit 有効時、発生平面(ringNormal)を tumble と同じ回転で回す（帯が首を振り、発生と粒子が同期）。
         // spin（帯上の流れ）の軸＝この「現在のリング法線」。
@@ -357,60 +432,51 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
         }
 
         // 周回（orbit）は burst 後も毎フレーム更新（中心はエフェクト位置＋offset に追従）。
-        if (gpu_->HasGroup(groupName)) {
+        if (group != kInvalidParticleGroupId) {
             const Vector3 center = { worldPos_.x + pc.offset.x, worldPos_.y + pc.offset.y, worldPos_.z + pc.offset.z };
-            gpu_->SetGroupOrbit(groupName, pc.orbitEnabled, center,
+            gpu_->SetGroupOrbit(group, pc.orbitEnabled, center,
                                 effRingNormal, pc.orbitSpinSpeed,        // spin：帯上を流れる（現在のリング法線まわり）
                                 pc.orbitTumbleAxis, pc.orbitTumbleSpeed); // tumble：帯自体の回転
             if (pc.orbitEnabled) {
-                gpu_->SetEmitterShape(groupName, pc.emitShape, effRingNormal, pc.ringThickness);
+                gpu_->SetEmitterShape(group, pc.emitShape, effRingNormal, pc.ringThickness);
             }
             // テクスチャのライブ反映（エディタで Texture を差し替えたら既存グループにも適用）
-            gpu_->SetGroupTexture(groupName, pc.texturePath);
+            gpu_->SetGroupTexture(group, pc.texturePath);
             // ブレンドモードのライブ反映（時間非依存。エディタで切替えたら即反映）
-            gpu_->SetGroupBlendMode(groupName, pc.blendMode);
+            gpu_->SetGroupBlendMode(group, pc.blendMode);
             // 時間グループのライブ反映。シーン用粒子は gpu->Update が EngineTime でこのグループの倍率で進める
             // （プレビュー粒子は UpdatePreviewSim が raw delta で進めるのでこの設定の影響を受けない）。
-            gpu_->SetGroupTimeGroup(groupName, static_cast<TimeGroup>(pc.timeGroup));
+            gpu_->SetGroupTimeGroup(group, static_cast<TimeGroup>(pc.timeGroup));
             // ディゾルブ（粒子ごとの寿命）。時間非依存なので毎フレーム設定でライブ反映も効く。
-            gpu_->SetGroupDissolve(groupName, pc.useDissolve, pc.dissolveMaskPath,
+            gpu_->SetGroupDissolve(group, pc.useDissolve, pc.dissolveMaskPath,
                                    pc.dissolveInEnable, pc.dissolveInEnd,
                                    pc.dissolveOutEnable, pc.dissolveOutStart,
                                    pc.dissolveEdgeEnable, pc.dissolveEdgeColor, pc.dissolveEdgeWidth);
             // 収束（移動をカーブで制御）。orbit と排他（シェーダは converge を優先）。中心はエフェクト位置＋offset。
-            // convergeCurve を 32 サンプルに焼いて渡す（時間非依存＝毎フレーム設定でライブ反映）。
-            float convLut[32];
-            for (int s = 0; s < 32; ++s) {
-                const float tt = static_cast<float>(s) / 31.0f;
-                convLut[s] = Saturate(pc.convergeCurve.Evaluate(tt));
-            }
-            gpu_->SetGroupConverge(groupName, pc.convergeEnable, center, convLut);
+            // convergeCurve は def ごとに焼いた表を渡す（時間非依存＝毎フレーム設定でライブ反映）。
+            gpu_->SetGroupConverge(group, pc.convergeEnable, center, luts_->particles[i].convergeLut);
         }
 
         if (rt.burstFired) continue;
         if (rt.clock < pc.startTime) continue;
 
         // グループ名が指定されていて未登録なら、texturePath で自動生成（エディタで完結できるように）
-        if (!groupName.empty() && !gpu_->HasGroup(groupName)) {
-            gpu_->CreateGroup(groupName,
+        if (group == kInvalidParticleGroupId && !rt.groupName.empty()) {
+            group = gpu_->CreateGroup(rt.groupName,
                 pc.texturePath.empty() ? "Resources/Textures/circle.dds" : pc.texturePath);
+            rt.groupId = group;
         }
 
         // 1回だけバースト発射（duration は将来の拡張用、現状未使用）
-        if (gpu_->HasGroup(groupName)) {
-            gpu_->SetGroupBillboardMode(groupName, pc.billboardMode);
+        if (group != kInvalidParticleGroupId) {
+            gpu_->SetGroupBillboardMode(group, pc.billboardMode);
             Vector3 pos = { worldPos_.x + pc.offset.x, worldPos_.y + pc.offset.y, worldPos_.z + pc.offset.z };
 
             // 収束モードは初速を持たず、velocityMode=4 で emit 時に spawn 位置を velocity フィールドへ保持させる。
             // この発射フレームでも converge CB を確実に設定しておく（次の Emit+Update CS が同フレームで走るため）。
             if (pc.convergeEnable) {
-                gpu_->SetEmitterVelocity(groupName, { 0.0f, 0.0f, 0.0f }, 0.0f, 4);
-                float convLut[32];
-                for (int s = 0; s < 32; ++s) {
-                    const float tt = static_cast<float>(s) / 31.0f;
-                    convLut[s] = Saturate(pc.convergeCurve.Evaluate(tt));
-                }
-                gpu_->SetGroupConverge(groupName, true, pos, convLut);
+                gpu_->SetEmitterVelocity(group, { 0.0f, 0.0f, 0.0f }, 0.0f, 4);
+                gpu_->SetGroupConverge(group, true, pos, luts_->particles[i].convergeLut);
             }
             // 初速モード（0=ランダム / 1=方向固定 / 2=放射）。mode に応じた baseVelocity を渡す。
             else if (pc.velocityMode == 1) {
@@ -422,36 +488,31 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
                                pc.velocityDir.y / len * pc.velocitySpeed,
                                pc.velocityDir.z / len * pc.velocitySpeed }
                     : Vector3{ 0.0f, pc.velocitySpeed, 0.0f };
-                gpu_->SetEmitterVelocity(groupName, v, pc.velocityJitter, 1);
+                gpu_->SetEmitterVelocity(group, v, pc.velocityJitter, 1);
             } else if (pc.velocityMode == 2) {
-                gpu_->SetEmitterVelocity(groupName, { pc.velocitySpeed, 0.0f, 0.0f }, pc.velocityJitter, 2);
+                gpu_->SetEmitterVelocity(group, { pc.velocitySpeed, 0.0f, 0.0f }, pc.velocityJitter, 2);
             } else if (pc.velocityMode == 3) {
                 // 接線（公転）：speed を baseVelocity.x に。方向はシェーダが ringNormal から接線を計算
-                gpu_->SetEmitterVelocity(groupName, { pc.velocitySpeed, 0.0f, 0.0f }, pc.velocityJitter, 3);
+                gpu_->SetEmitterVelocity(group, { pc.velocitySpeed, 0.0f, 0.0f }, pc.velocityJitter, 3);
             } else {
-                gpu_->SetEmitterVelocity(groupName, { 0.0f, 0.0f, 0.0f }, 0.0f, 0);
+                gpu_->SetEmitterVelocity(group, { 0.0f, 0.0f, 0.0f }, 0.0f, 0);
             }
 
             // 発生形状（Sphere / Ring）。orbit 時は回転済みの法線で発生させ、粒子と同期させる。
-            gpu_->SetEmitterShape(groupName, pc.emitShape, effRingNormal, pc.ringThickness);
+            gpu_->SetEmitterShape(group, pc.emitShape, effRingNormal, pc.ringThickness);
 
             // 多色グラデーション（Fixed カラーモード）。
             // Start(loc=0)/End(loc=1) を常に両端キーとして使い、colorKeys はその間に挿入する中間キー。
             // → 中間キー0個=Start→End の2色、1個=3色…（Random モードでは無効）。
+            // キーは def ごとに昇順に並べ済み（バーストのたびに確保・ソートしない）。
             if (pc.colorMode == 1) {
-                std::vector<std::pair<float, Vector4>> keys;
-                keys.reserve(pc.colorKeys.size() + 2);
-                keys.emplace_back(0.0f, pc.startColor);
-                for (const auto& k : pc.colorKeys) keys.emplace_back(k.location, k.color);
-                keys.emplace_back(1.0f, pc.endColor);
-                std::sort(keys.begin(), keys.end(),
-                    [](const std::pair<float, Vector4>& a, const std::pair<float, Vector4>& b) { return a.first < b.first; });
-                gpu_->SetEmitterGradient(groupName, keys);
+                const EffectGradientLut& gradient = luts_->particles[i].gradient;
+                gpu_->SetEmitterGradient(group, gradient.keyLocation, gradient.keyColor, gradient.keyCount);
             } else {
-                gpu_->SetEmitterGradient(groupName, {});
+                gpu_->SetEmitterGradient(group, {});
             }
             // Hue 回転（生存中のシームレス色変化）。時間非依存なので毎フレーム設定でライブ反映が効く。
-            gpu_->SetGroupHueShift(groupName, pc.hueShiftEnable, pc.hueShiftSpeed, pc.hueShiftRandomPhase);
+            gpu_->SetGroupHueShift(group, pc.hueShiftEnable, pc.hueShiftSpeed, pc.hueShiftRandomPhase);
 
             // 粒子寿命：ループ時は周期を超えて生き残らせる（境界で全消えしないように）。
             // 非ループ時のみ totalDuration を超えないようにクランプ。
@@ -461,7 +522,7 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
                 particleLife = min(particleLife, remaining);
             }
             Vector3 rotRange = pc.randomRotateOnSpawn ? pc.randomRotateRange : Vector3{ 0.0f, 0.0f, 0.0f };
-            gpu_->BurstEmit(groupName, pos, pc.burstCount, pc.emitRadius,
+            gpu_->BurstEmit(group, pos, pc.burstCount, pc.emitRadius,
                             static_cast<uint32_t>(pc.colorMode), pc.startColor, pc.endColor,
                             pc.scaleMin, pc.scaleMax, pc.uniformScale, particleLife,
                             pc.startScale, pc.endScale,
@@ -598,8 +659,8 @@ void EffectInstance::Update(Camera* camera, float deltaTime) {
 }
 
 void EffectInstance::ResetForLoop() {
-    // 現在確保中のライト・サウンドはここで解放（Primitive renderer は Update 内で
-    // 自分の finished と共に reset 済みなので再生成される）
+    // 現在確保中のライト・サウンドはここで解放（Primitive renderer は残し、次の spawn で使い回す。
+    // 乱数シード 0 の雷だけは次の spawn で作り直す）
     LightManager* lm = LightManager::GetInstance();
     for (auto& rt : lights_) {
         if (rt.slot != kInvalidLightSlot) {
@@ -617,7 +678,6 @@ void EffectInstance::ResetForLoop() {
         rt = SoundRuntime{};
     }
     for (auto& rt : primitives_) {
-        rt.renderer.reset();
         rt.started = false;
         rt.finished = false;
         rt.clock = 0.0f;
@@ -629,7 +689,7 @@ void EffectInstance::ResetForLoop() {
     elapsedTime_ = 0.0f;
 }
 
-void EffectInstance::SyncFromDef(const EffectDef& newDef) {
+void EffectInstance::SyncFromDef(const EffectDef& newDef, std::shared_ptr<const EffectDefLuts> luts) {
     // ----- Primitive -----
     if (newDef.primitives.size() != def_.primitives.size()) {
         // 数が変わった（パーツ追加/削除）→ index ずれ事故を避けるため、この型の runtime を作り直す。
@@ -637,14 +697,16 @@ void EffectInstance::SyncFromDef(const EffectDef& newDef) {
         primitives_.clear();
         primitives_.resize(newDef.primitives.size());
     } else {
-        // 数が同じ → started 済みは、メッシュ変更なら部分リビルド、それ以外はライブ setter で反映。
+        // 数が同じ → レンダラがあるものは、メッシュ変更なら部分リビルド、それ以外はライブ setter で反映。
+        // （寿命後・spawn 前でもレンダラは残っているので、表示中かどうかに関係なく反映する）
         for (size_t i = 0; i < newDef.primitives.size(); ++i) {
             PrimitiveRuntime& rt = primitives_[i];
-            if (!rt.started || !rt.renderer) continue; // 未spawnは新 def_ から自然に生成される
+            if (!rt.renderer) continue; // 未生成は新 def_ から自然に生成される
             if (PrimitiveMeshNeedsRebuild(def_.primitives[i], newDef.primitives[i])) {
                 rt.renderer.reset();
-                rt.started = false;   // 次 Update で新メッシュとして再生成（elapsedTime_ は保持）
-                rt.finished = false;
+                if (rt.started && !rt.finished) {
+                    rt.started = false;   // 表示中なら次 Update で新メッシュとして再生成（elapsedTime_ は保持）
+                }
             } else {
                 ApplyPrimitiveStaticParams(*rt.renderer, newDef.primitives[i]);
             }
@@ -683,6 +745,7 @@ void EffectInstance::SyncFromDef(const EffectDef& newDef) {
 
     // 新 def を採用。毎フレーム読みの値（scale/color/timing/offset 等）はこれで即ライブ反映される。
     def_ = newDef;
+    AdoptLuts(std::move(luts));
 }
 
 void EffectInstance::Rewind() {
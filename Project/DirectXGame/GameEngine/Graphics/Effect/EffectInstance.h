@@ -1,6 +1,8 @@
 #pragma once
 #include "EffectDef.h"
+#include "EffectCurveLut.h"
 #include "EffectPrimitiveRenderer.h"
+#include "ParticleGroupTable.h"
 #include "Vector3.h"
 #include "Matrix4x4.h"
 #include "Quaternion.h"
@@ -20,8 +22,22 @@ class EffectInstance {
 public:
     /// <summary>
     /// 初期化。defはインスタンスにコピーして所有する（呼び出し元のdef破棄に依存しない）。
+    /// luts は def を焼いた表（EffectManager が def ごとに 1 回焼いたもの）。nullptr ならここで焼く。
     /// </summary>
-    void Initialize(const EffectDef& def, const Vector3& worldPos, GPUParticleManager* gpu);
+    void Initialize(const EffectDef& def, const Vector3& worldPos, GPUParticleManager* gpu,
+                    std::shared_ptr<const EffectDefLuts> luts = nullptr);
+
+    /// <summary>
+    /// 全 primitive 成分のレンダラ（メッシュ・定数バッファ・テクスチャ参照）を今作っておく。
+    /// EffectManager がプールを作り置きするときに呼び、初回 spawn での生成を無くす。
+    /// </summary>
+    void Prewarm();
+
+    /// <summary>
+    /// プールから取り出して worldPos で頭から再生し直す。def とレンダラはそのまま使い回す
+    /// （Initialize と違い def のコピーもレンダラ生成もしないので、メモリ確保が起きない）。
+    /// </summary>
+    void Restart(const Vector3& worldPos);
 
     void Update(Camera* camera, float deltaTime);
     void Draw();
@@ -31,9 +47,9 @@ public:
     /// 値（scale/color/timing 等の毎フレーム読みフィールド）は def_ 差し替えで即反映。
     /// コンポーネント数が変わった型はその型の runtime を作り直す。
     /// meshType / ジオメトリ params が変わった primitive runtime だけレンダラを部分リビルド。
-    /// elapsedTime_ は保持する。
+    /// elapsedTime_ は保持する。luts は newDef を焼いた表（nullptr ならここで焼く）。
     /// </summary>
-    void SyncFromDef(const EffectDef& newDef);
+    void SyncFromDef(const EffectDef& newDef, std::shared_ptr<const EffectDefLuts> luts = nullptr);
 
     /// <summary>
     /// t=0 へ巻き戻す（runtime を片付けて最初から再生し直す）。「Restart」の実体。
@@ -94,14 +110,14 @@ public:
     /// プレビュー（エディタ）インスタンスとして扱うか。true の場合、GPUパーティクルの
     /// グループ名にプレフィックスを付けてシーンと物理バッファを分離する。
     /// </summary>
-    void SetPreview(bool p) { isPreview_ = p; }
+    void SetPreview(bool p);
     bool IsPreview() const { return isPreview_; }
 
     /// <summary>
-    /// このインスタンスが使用する GPUパーティクルグループ名（プレビューならプレフィックス込み）を
+    /// このインスタンスが使用する GPUパーティクルグループ（プレビュー用）のハンドルを
     /// out に追加する。EffectManager がプレビューグループのリサイクル keep set を作るのに使う。
     /// </summary>
-    void CollectPreviewGroupNames(std::vector<std::string>& out) const;
+    void CollectPreviewGroups(std::vector<ParticleGroupId>& out) const;
 
 private:
     /// <summary>
@@ -115,7 +131,20 @@ private:
     /// </summary>
     std::string EffGroupName(const std::string& name) const;
 
+    /// <summary>
+    /// index 番目の particle 成分が使うグループのハンドルを返す（未生成なら無効値）。
+    /// 持っているハンドルが生きていればそのまま返し、名前を作る・引くのは無効になったときだけ。
+    /// </summary>
+    ParticleGroupId ResolveParticleGroup(size_t index);
+
+    /// <summary>
+    /// def_ を焼いた表を持つ（Initialize / SyncFromDef で def_ を受け取ったとき。nullptr なら def_ から焼く）。
+    /// プールからの Restart では def_ が変わらないので持ち替えない。
+    /// </summary>
+    void AdoptLuts(std::shared_ptr<const EffectDefLuts> luts);
+
     EffectDef def_{};
+    std::shared_ptr<const EffectDefLuts> luts_;  // def_ の成分と同じ並び
     Vector3 worldPos_ = { 0.0f, 0.0f, 0.0f };
     Vector3 worldRotation_ = { 0.0f, 0.0f, 0.0f }; // エフェクト全体の向き（オイラー角・ラジアン）
     float elapsedTime_ = 0.0f;
@@ -128,6 +157,7 @@ private:
 
     struct PrimitiveRuntime {
         std::unique_ptr<EffectPrimitiveRenderer> renderer;
+        bool rendererShown = false; // renderer を一度でも出現させたか（乱数メッシュの作り直し判定用）
         bool started = false;
         bool finished = false;
         float clock = 0.0f; // この成分の TimeGroup でスケールした専用経過時間（spawn/アニメ進行に使う）
@@ -139,6 +169,11 @@ private:
     struct ParticleRuntime {
         bool burstFired = false;
         float clock = 0.0f; // この成分の TimeGroup でスケールした専用経過時間（burst スケジュールに使う）
+        // 使うグループ。名前（EffGroupName 済み）は一度だけ作り、毎フレームはハンドルで操作する。
+        // def_ やプレビュー指定が変わったら groupNameResolved を下ろして作り直す。
+        std::string groupName;
+        bool groupNameResolved = false;
+        ParticleGroupId groupId = kInvalidParticleGroupId;
     };
     std::vector<ParticleRuntime> particles_;
 
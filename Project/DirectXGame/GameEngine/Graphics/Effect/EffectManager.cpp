@@ -1,7 +1,11 @@
 #include "EffectManager.h"
 #include "GPUParticleManager.h"
+#include "EffectCurveLut.h"
 #include "Camera.h"
 #include "Log.h"
+#include "LogBuffer.h"
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -10,6 +14,23 @@
 #include "imgui.h"
 #endif
 
+namespace {
+    // def 読み込み時に作り置きする数と、プールに溜めておく既定の上限
+    constexpr uint32_t kPoolPrewarmCount = 4;
+    constexpr uint32_t kPoolDefaultCapacity = 32;
+
+    // EffectHandle = 上位 32bit 世代 / 下位 32bit スロット番号
+    EffectHandle MakeHandle(uint32_t index, uint32_t generation) {
+        return (static_cast<EffectHandle>(generation) << 32) | index;
+    }
+    uint32_t HandleIndex(EffectHandle h) { return static_cast<uint32_t>(h & 0xFFFFFFFFu); }
+    uint32_t HandleGeneration(EffectHandle h) { return static_cast<uint32_t>(h >> 32); }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+}
+
 EffectManager* EffectManager::GetInstance() {
     static EffectManager instance;
     return &instance;
@@ -19,23 +40,25 @@ void EffectManager::Initialize(GPUParticleManager* gpuParticleManager) {
     gpuParticleManager_ = gpuParticleManager;
     defs_.clear();
     activeInstances_.clear();
-    pendingDelete_.clear();
-    handleToInstance_.clear();
+    pendingRelease_.clear();
+    handleSlots_.clear();
+    freeHandleSlots_.clear();
     previewInstances_.clear();
     previewPendingDelete_.clear();
-    previewHandleToInstance_.clear();
-    nextHandle_ = 1;
+    poolStats_ = {};
+    stress_ = {};
 }
 
 void EffectManager::Finalize() {
     StopAll();
     StopAllPreview();
-    // シーン終了時は GPU が待たれている前提なので pendingDelete もここで安全に解放
-    pendingDelete_.clear();
+    // シーン終了時は GPU が待たれている前提なので解放予約・プールもここで安全に解放
+    pendingRelease_.clear();
     previewPendingDelete_.clear();
     defs_.clear();
-    handleToInstance_.clear();
-    previewHandleToInstance_.clear();
+    handleSlots_.clear();
+    freeHandleSlots_.clear();
+    stress_ = {};
 }
 
 //==========================================================
@@ -47,7 +70,7 @@ void EffectManager::RegisterDef(const EffectDef& def) {
         Log("EffectManager: RegisterDef skipped — name is empty");
         return;
     }
-    defs_[def.name] = def;
+    StoreDef(EffectDef(def));
 }
 
 bool EffectManager::LoadDef(const std::string& filePath) {
@@ -60,7 +83,7 @@ bool EffectManager::LoadDef(const std::string& filePath) {
         Log(std::string("EffectManager: LoadDef skipped — no name in ") + filePath);
         return false;
     }
-    defs_[def.name] = std::move(def);
+    StoreDef(std::move(def));
     return true;
 }
 
@@ -69,12 +92,19 @@ void EffectManager::LoadAllDefsInDirectory(const std::string& dirPath) {
     std::error_code ec;
     if (!fs::exists(dirPath, ec) || !fs::is_directory(dirPath, ec)) return;
 
-    for (const auto& entry : fs::directory_iterator(dirPath, ec)) {
-        if (ec) break;
-        if (!entry.is_regular_file()) continue;
-        const auto& path = entry.path();
-        if (path.extension() != ".json") continue;
-        LoadDef(path.string());
+    // 焼き込み済みの .defs が新しければそちらから一括で読む（無い・古いときは JSON から読んで焼き直す）
+    std::vector<EffectDef> defs;
+    std::vector<std::string> failedPaths;
+    EffectDefIO::LoadAllInDirectory(dirPath, defs, CookedDefs::Mode::PreferCooked, &failedPaths);
+    for (const std::string& path : failedPaths) {
+        Log(std::string("EffectManager: LoadDef failed — ") + path);
+    }
+    for (EffectDef& def : defs) {
+        if (def.name.empty()) {
+            Log("EffectManager: LoadDef skipped — no name");
+            continue;
+        }
+        StoreDef(std::move(def));
     }
 }
 
@@ -84,12 +114,17 @@ bool EffectManager::HasDef(const std::string& name) const {
 
 const EffectDef* EffectManager::FindDef(const std::string& name) const {
     auto it = defs_.find(name);
-    return it == defs_.end() ? nullptr : &it->second;
+    return it == defs_.end() ? nullptr : &it->second.def;
 }
 
 EffectDef* EffectManager::FindDefMutable(const std::string& name) {
     auto it = defs_.find(name);
-    return it == defs_.end() ? nullptr : &it->second;
+    if (it == defs_.end()) return nullptr;
+    // 書き換えられる前提で、今のプールと再生中のものは古い def として扱う（戻ってきても捨てる）
+    ++it->second.revision;
+    it->second.luts.reset();
+    FlushPool(it->second);
+    return &it->second.def;
 }
 
 std::string EffectManager::SaveDef(EffectDef def, bool allowOverwrite) {
@@ -111,12 +146,155 @@ std::string EffectManager::SaveDef(EffectDef def, bool allowOverwrite) {
         return std::string();
     }
 
-    defs_[finalName] = std::move(def);
+    StoreDef(std::move(def));
     return finalName;
 }
 
 void EffectManager::UnregisterDef(const std::string& name) {
-    defs_.erase(name);
+    auto it = defs_.find(name);
+    if (it == defs_.end()) return;
+    // 再生中・解放待ちのものはプールへ戻さず破棄させる（entry は消えるので参照を外す）
+    for (auto& active : activeInstances_) {
+        if (active.entry == &it->second) active.entry = nullptr;
+    }
+    for (auto& active : pendingRelease_) {
+        if (active.entry == &it->second) active.entry = nullptr;
+    }
+    poolStats_.discarded += it->second.pool.size();
+    defs_.erase(it);
+}
+
+//==========================================================
+// インスタンスプール
+//==========================================================
+
+void EffectManager::StoreDef(EffectDef&& def) {
+    // unordered_map のノードは再ハッシュで動かないので、ActiveEffect::entry はそのまま有効
+    DefEntry& entry = defs_[def.name];
+    entry.def = std::move(def);
+    ++entry.revision;
+    entry.luts.reset();
+    ReportLutError(entry.def.name, *LutsOf(entry));
+    if (entry.capacity < kPoolDefaultCapacity) entry.capacity = kPoolDefaultCapacity;
+    FlushPool(entry);
+    // ループするエフェクトは Stop されるまで戻らず、同時に出る数も少ないので作り置きしない
+    if (!entry.def.loop) PrewarmPool(entry, kPoolPrewarmCount);
+}
+
+void EffectManager::ReportLutError(const std::string& name, const EffectDefLuts& luts) {
+    if (luts.bakedCurveCount == 0 && luts.maxConvergeError == 0.0f) return;
+    // 表の誤差は exact に回らなかったカーブのぶん（exact なカーブは直接評価なので誤差なし）。
+    // GPU の収束 LUT は切り替えられないので、許容を超えたら警告にする
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Effect] %s: curve LUT max err %.4f (%u / %u curves exact)  converge LUT max err %.4f",
+        name.c_str(), luts.maxTableError, luts.exactCurveCount, luts.bakedCurveCount, luts.maxConvergeError);
+    LogBuffer::Instance().Add(buf, (luts.maxConvergeError > EffectCurveLut::kMaxTableError)
+        ? LogBuffer::Level::Warning : LogBuffer::Level::Info);
+}
+
+const std::shared_ptr<const EffectDefLuts>& EffectManager::LutsOf(DefEntry& entry) {
+    if (!entry.luts) entry.luts = EffectDefLuts::Bake(entry.def);
+    return entry.luts;
+}
+
+void EffectManager::PrewarmPool(DefEntry& entry, uint32_t count) {
+    if (!poolingEnabled_) return;
+    entry.pool.reserve(count);
+    while (entry.pool.size() < count) {
+        auto inst = std::make_unique<EffectInstance>();
+        inst->Initialize(entry.def, { 0.0f, 0.0f, 0.0f }, gpuParticleManager_, LutsOf(entry));
+        inst->Prewarm();
+        entry.pool.push_back(std::move(inst));
+        ++poolStats_.prewarmed;
+    }
+}
+
+void EffectManager::FlushPool(DefEntry& entry) {
+    poolStats_.discarded += entry.pool.size();
+    entry.pool.clear();
+}
+
+void EffectManager::ReservePool(const std::string& effectName, uint32_t count) {
+    auto it = defs_.find(effectName);
+    if (it == defs_.end()) {
+        Log(std::string("EffectManager: ReservePool — no def for ") + effectName);
+        return;
+    }
+    DefEntry& entry = it->second;
+    if (entry.capacity < count) entry.capacity = count;
+    PrewarmPool(entry, count);
+    // 取り出したインスタンスの置き場所も先に確保しておく（Play 中に vector が伸びないように）
+    activeInstances_.reserve(activeInstances_.size() + count);
+    pendingRelease_.reserve(pendingRelease_.size() + count);
+    handleSlots_.reserve(handleSlots_.size() + count);
+    freeHandleSlots_.reserve(freeHandleSlots_.size() + count);
+}
+
+size_t EffectManager::GetPooledInstanceCount() const {
+    size_t count = 0;
+    for (const auto& pair : defs_) count += pair.second.pool.size();
+    return count;
+}
+
+void EffectManager::RecyclePendingReleases() {
+    for (ActiveEffect& active : pendingRelease_) {
+        if (!active.instance || !active.entry) continue;  // プール外のものはここで破棄
+        DefEntry& entry = *active.entry;
+        if (poolingEnabled_ && active.revision == entry.revision && entry.pool.size() < entry.capacity) {
+            entry.pool.push_back(std::move(active.instance));
+            ++poolStats_.recycled;
+        } else {
+            ++poolStats_.discarded;
+        }
+    }
+    pendingRelease_.clear();
+}
+
+//==========================================================
+// ハンドル表
+//==========================================================
+
+EffectHandle EffectManager::AllocateHandle(EffectInstance* instance, bool preview) {
+    uint32_t index;
+    if (!freeHandleSlots_.empty()) {
+        index = freeHandleSlots_.back();
+        freeHandleSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(handleSlots_.size());
+        handleSlots_.emplace_back();
+    }
+    HandleSlot& slot = handleSlots_[index];
+    slot.instance = instance;
+    slot.preview = preview;
+    const EffectHandle h = MakeHandle(index, slot.generation);
+    instance->SetHandle(h);
+    return h;
+}
+
+void EffectManager::ReleaseHandle(EffectHandle handle) {
+    const uint32_t index = HandleIndex(handle);
+    if (index >= handleSlots_.size()) return;
+    HandleSlot& slot = handleSlots_[index];
+    if (slot.generation != HandleGeneration(handle) || !slot.instance) return;
+    slot.instance = nullptr;
+    // 世代 0 はハンドル 0（無効値）と紛れるので飛ばす
+    if (++slot.generation == 0) slot.generation = 1;
+    freeHandleSlots_.push_back(index);
+}
+
+EffectInstance* EffectManager::FindByHandle(EffectHandle handle, bool preview) const {
+    const uint32_t index = HandleIndex(handle);
+    if (index >= handleSlots_.size()) return nullptr;
+    const HandleSlot& slot = handleSlots_[index];
+    if (slot.generation != HandleGeneration(handle) || slot.preview != preview) return nullptr;
+    return slot.instance;
+}
+
+EffectInstance* EffectManager::GetInstanceByHandle(EffectHandle handle) const {
+    const uint32_t index = HandleIndex(handle);
+    if (index >= handleSlots_.size()) return nullptr;
+    const HandleSlot& slot = handleSlots_[index];
+    return (slot.generation == HandleGeneration(handle)) ? slot.instance : nullptr;
 }
 
 std::vector<std::string> EffectManager::ListDefNames() const {
@@ -131,27 +309,41 @@ std::vector<std::string> EffectManager::ListDefNames() const {
 //==========================================================
 
 EffectHandle EffectManager::Play(const std::string& effectName, const Vector3& worldPos) {
-    const EffectDef* def = FindDef(effectName);
-    if (!def) {
+    auto it = defs_.find(effectName);
+    if (it == defs_.end()) {
         Log(std::string("EffectManager: Play — no def for ") + effectName);
         return kInvalidEffectHandle;
     }
-    auto inst = std::make_unique<EffectInstance>();
-    inst->Initialize(*def, worldPos, gpuParticleManager_);
-    EffectHandle h = nextHandle_++;
-    inst->SetHandle(h);
-    handleToInstance_[h] = inst.get();
-    activeInstances_.push_back(std::move(inst));
+    return PlayFromEntry(it->second, worldPos);
+}
+
+EffectHandle EffectManager::PlayFromEntry(DefEntry& entry, const Vector3& worldPos) {
+    ActiveEffect active;
+    active.entry = &entry;
+    active.revision = entry.revision;
+    if (poolingEnabled_ && !entry.pool.empty()) {
+        // プールから取り出す：def のコピーもレンダラ生成もしない
+        active.instance = std::move(entry.pool.back());
+        entry.pool.pop_back();
+        active.instance->Restart(worldPos);
+        ++poolStats_.hits;
+    } else {
+        active.instance = std::make_unique<EffectInstance>();
+        active.instance->Initialize(entry.def, worldPos, gpuParticleManager_, LutsOf(entry));
+        ++poolStats_.misses;
+    }
+    const EffectHandle h = AllocateHandle(active.instance.get(), false);
+    activeInstances_.push_back(std::move(active));
     return h;
 }
 
 EffectHandle EffectManager::PlayWithDef(const EffectDef& def, const Vector3& worldPos) {
-    auto inst = std::make_unique<EffectInstance>();
-    inst->Initialize(def, worldPos, gpuParticleManager_);
-    EffectHandle h = nextHandle_++;
-    inst->SetHandle(h);
-    handleToInstance_[h] = inst.get();
-    activeInstances_.push_back(std::move(inst));
+    // 未保存の def なのでプールは使わない（終了したら破棄）
+    ActiveEffect active;
+    active.instance = std::make_unique<EffectInstance>();
+    active.instance->Initialize(def, worldPos, gpuParticleManager_);
+    const EffectHandle h = AllocateHandle(active.instance.get(), false);
+    activeInstances_.push_back(std::move(active));
     return h;
 }
 
@@ -159,9 +351,7 @@ EffectHandle EffectManager::PlayPreview(const EffectDef& def, const Vector3& wor
     auto inst = std::make_unique<EffectInstance>();
     inst->SetPreview(true); // GPUパーティクルを $preview$ グループへ隔離する
     inst->Initialize(def, worldPos, gpuParticleManager_);
-    EffectHandle h = nextHandle_++;
-    inst->SetHandle(h);
-    previewHandleToInstance_[h] = inst.get();
+    const EffectHandle h = AllocateHandle(inst.get(), true);
     previewInstances_.push_back(std::move(inst));
     return h;
 }
@@ -172,46 +362,40 @@ void EffectManager::StopAllPreview() {
     }
     // Primitive renderer の解放は Draw のコマンドより遅らせる（次フレーム頭で解放）。
     for (auto& inst : previewInstances_) {
-        if (inst) previewPendingDelete_.push_back(std::move(inst));
+        if (!inst) continue;
+        ReleaseHandle(inst->GetHandle());
+        previewPendingDelete_.push_back(std::move(inst));
     }
     previewInstances_.clear();
-    previewHandleToInstance_.clear();
 }
 
 void EffectManager::Stop(EffectHandle handle) {
-    auto it = handleToInstance_.find(handle);
-    if (it == handleToInstance_.end()) return;
-    if (it->second) it->second->RequestStop();
+    if (EffectInstance* inst = FindByHandle(handle, false)) inst->RequestStop();
 }
 
 void EffectManager::SetPosition(EffectHandle handle, const Vector3& pos) {
-    auto it = handleToInstance_.find(handle);
-    if (it == handleToInstance_.end()) return;
-    if (it->second) it->second->SetWorldPosition(pos);
+    if (EffectInstance* inst = FindByHandle(handle, false)) inst->SetWorldPosition(pos);
 }
 
 void EffectManager::SetRotation(EffectHandle handle, const Vector3& rotate) {
-    auto it = handleToInstance_.find(handle);
-    if (it == handleToInstance_.end()) return;
-    if (it->second) it->second->SetWorldRotation(rotate);
+    if (EffectInstance* inst = FindByHandle(handle, false)) inst->SetWorldRotation(rotate);
 }
 
 bool EffectManager::IsAlive(EffectHandle handle) const {
-    return handleToInstance_.find(handle) != handleToInstance_.end();
+    return FindByHandle(handle, false) != nullptr;
 }
 
 void EffectManager::StopAll() {
     // ライト等のスロット予約はその場で解放してOK（GPU描画が参照しないため）。
-    for (auto& inst : activeInstances_) {
-        if (inst) inst->Cleanup();
-    }
-    // Primitive renderer の解放だけは Draw のコマンドより遅らせる必要があるので
-    // 次フレーム頭まで pendingDelete_ で保持する。
-    for (auto& inst : activeInstances_) {
-        if (inst) pendingDelete_.push_back(std::move(inst));
+    // Primitive renderer の解放・再利用だけは Draw のコマンドより遅らせる必要があるので
+    // 次フレーム頭まで pendingRelease_ で保持する。
+    for (auto& active : activeInstances_) {
+        if (!active.instance) continue;
+        active.instance->Cleanup();
+        ReleaseHandle(active.instance->GetHandle());
+        pendingRelease_.push_back(std::move(active));
     }
     activeInstances_.clear();
-    handleToInstance_.clear();
 }
 
 //==========================================================
@@ -219,27 +403,44 @@ void EffectManager::StopAll() {
 //==========================================================
 
 void EffectManager::Update(float deltaTime) {
-    // 前フレームの「描画後に解放したい」インスタンスをここで安全に破棄。
+    const auto updateStart = std::chrono::steady_clock::now();
+
+    // 前フレームの「描画後に解放したい」インスタンスをここでプールへ戻す（または破棄する）。
     // ここに来た時点で GPU は前フレームのコマンド消化を待ち合わせ済み（フレーム境界）。
-    pendingDelete_.clear();
+    RecyclePendingReleases();
+
+    // 負荷試験の計測対象フレームか（フェーズ切り替えで作り置きするフレームは数えない）
+    const bool stressMeasuring = stress_.phase == StressPhase::NoPool || stress_.phase == StressPhase::Pool;
+    double stressPlayMs = 0.0;
+    if (stress_.phase != StressPhase::Idle) TickStressBenchmark(deltaTime, stressPlayMs);
 
     // 各インスタンスを更新
-    for (auto& inst : activeInstances_) {
-        if (inst) inst->Update(camera_, deltaTime);
+    for (auto& active : activeInstances_) {
+        if (active.instance) active.instance->Update(camera_, deltaTime);
     }
 
-    // 終了したインスタンスを取り出して pendingDelete_ へ移送（即破棄しない）。
-    for (auto it = activeInstances_.begin(); it != activeInstances_.end();) {
-        if (!(*it) || (*it)->IsFinished()) {
-            if (*it) {
-                handleToInstance_.erase((*it)->GetHandle());
-                (*it)->Cleanup(); // ライトはここで解放してOK
-                pendingDelete_.push_back(std::move(*it));
-            }
-            it = activeInstances_.erase(it);
-        } else {
-            ++it;
+    // 終了したインスタンスを pendingRelease_ へ移し（即破棄・即再利用しない）、末尾の要素で穴を埋める。
+    for (size_t i = 0; i < activeInstances_.size();) {
+        ActiveEffect& active = activeInstances_[i];
+        if (active.instance && !active.instance->IsFinished()) {
+            ++i;
+            continue;
         }
+        if (active.instance) {
+            ReleaseHandle(active.instance->GetHandle());
+            active.instance->Cleanup(); // ライトはここで解放してOK
+            pendingRelease_.push_back(std::move(active));
+        }
+        if (i + 1 < activeInstances_.size()) {
+            activeInstances_[i] = std::move(activeInstances_.back());
+        }
+        activeInstances_.pop_back();
+    }
+
+    if (stressMeasuring) {
+        const double updateMs = ElapsedMs(updateStart) - stressPlayMs;
+        if (updateMs > stress_.worstUpdateMs) stress_.worstUpdateMs = updateMs;
+        if (activeInstances_.size() > stress_.peakActive) stress_.peakActive = activeInstances_.size();
     }
 }
 
@@ -263,7 +464,7 @@ void EffectManager::UpdatePreview(float deltaTime) {
                 ++it;
                 continue;
             }
-            previewHandleToInstance_.erase((*it)->GetHandle());
+            ReleaseHandle((*it)->GetHandle());
             (*it)->Cleanup();
             previewPendingDelete_.push_back(std::move(*it));
             it = previewInstances_.erase(it);
@@ -275,19 +476,22 @@ void EffectManager::UpdatePreview(float deltaTime) {
     // GPUパーティクルのプレビューグループをエディタの unscaled delta で独立シミュレートし、
     // 今プレビュー中のエフェクトが使わなくなったグループは遅延リサイクルする（working set を有界化）。
     if (gpuParticleManager_) {
-        std::vector<std::string> keepNames;
+        std::vector<ParticleGroupId> keepGroups;
         for (const auto& inst : previewInstances_) {
-            if (inst) inst->CollectPreviewGroupNames(keepNames);
+            if (inst) inst->CollectPreviewGroups(keepGroups);
         }
         gpuParticleManager_->UpdatePreviewSim(deltaTime);
-        gpuParticleManager_->RecyclePreviewGroups(keepNames);
+        gpuParticleManager_->RecyclePreviewGroups(keepGroups);
     }
 }
 
 void EffectManager::SyncPreview(const EffectDef& def, const Vector3& worldPos) {
+    if (previewInstances_.empty()) return;
+    // 編集中の def は毎フレーム変わりうるので呼ぶたびに焼くが、プレビュー全体で 1 回だけ
+    const std::shared_ptr<const EffectDefLuts> luts = EffectDefLuts::Bake(def);
     for (auto& inst : previewInstances_) {
         if (!inst) continue;
-        inst->SyncFromDef(def);
+        inst->SyncFromDef(def, luts);
         inst->SetWorldPosition(worldPos);
     }
 }
@@ -317,14 +521,14 @@ void EffectManager::SeekPreview(float targetTime) {
 }
 
 void EffectManager::Draw() {
-    for (auto& inst : activeInstances_) {
-        if (inst) inst->Draw();
+    for (auto& active : activeInstances_) {
+        if (active.instance) active.instance->Draw();
     }
 }
 
 void EffectManager::DrawDistortionPass() {
-    for (auto& inst : activeInstances_) {
-        if (inst) inst->DrawDistortionPass();
+    for (auto& active : activeInstances_) {
+        if (active.instance) active.instance->DrawDistortionPass();
     }
 }
 
@@ -335,8 +539,8 @@ void EffectManager::DrawDistortionPassPreview() {
 }
 
 bool EffectManager::HasActiveDistortionSource() const {
-    for (const auto& inst : activeInstances_) {
-        if (inst && inst->HasActiveDistortionSource()) return true;
+    for (const auto& active : activeInstances_) {
+        if (active.instance && active.instance->HasActiveDistortionSource()) return true;
     }
     return false;
 }
@@ -370,9 +574,22 @@ void EffectManager::OnImGui() {
 #ifdef USE_IMGUI
     ImGui::Text("Active Instances: %zu", activeInstances_.size());
     ImGui::Text("Registered Defs: %zu", defs_.size());
+    ImGui::Text("Pool: %zu idle  hits %llu / misses %llu  (recycled %llu, discarded %llu)",
+        GetPooledInstanceCount(),
+        static_cast<unsigned long long>(poolStats_.hits), static_cast<unsigned long long>(poolStats_.misses),
+        static_cast<unsigned long long>(poolStats_.recycled), static_cast<unsigned long long>(poolStats_.discarded));
     if (ImGui::Button("Stop All")) {
         StopAll();
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Pool Stats")) {
+        ResetPoolStats();
+    }
+    // カーブ・グラデーションを焼いた表を使わず直接評価する（表との見た目の差を確かめる用）
+    bool exactCurves = EffectLut::IsExactEvaluation();
+    if (ImGui::Checkbox("Exact Curve Evaluation (no LUT)", &exactCurves)) {
+        EffectLut::SetExactEvaluation(exactCurves);
+    }
     ImGui::Separator();
 
     // 再生位置（テスト用）
@@ -392,3 +609,121 @@ void EffectManager::OnImGui() {
     }
 #endif
 }
+
+//==========================================================
+// 負荷試験（Benchmarks ウィンドウから起動）
+//==========================================================
+
+void EffectManager::StartStressBenchmark(const std::string& effectName, float playsPerSecond, float secondsPerPhase) {
+    if (stress_.phase != StressPhase::Idle) {
+        LogBuffer::Instance().Add("[Effect] Stress benchmark is already running", LogBuffer::Level::Warning);
+        return;
+    }
+    auto it = defs_.find(effectName);
+    if (it == defs_.end() || it->second.def.loop) {
+        LogBuffer::Instance().Add("[Effect] Stress benchmark needs a non-loop effect def: " + effectName,
+            LogBuffer::Level::Error);
+        return;
+    }
+    stress_ = {};
+    stress_.effectName = effectName;
+    stress_.playsPerSecond = playsPerSecond;
+    stress_.secondsPerPhase = secondsPerPhase;
+    stress_.poolingBefore = poolingEnabled_;
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Effect] Stress: '%s' x %.0f/s, %.1f s per phase (no pool -> pool)",
+        effectName.c_str(), playsPerSecond, secondsPerPhase);
+    LogBuffer::Instance().Add(buf);
+    BeginStressPhase(StressPhase::NoPool);
+}
+
+void EffectManager::BeginStressPhase(StressPhase phase) {
+    stress_.phase = phase;
+    stress_.phaseTime = 0.0f;
+    stress_.playDebt = 0.0f;
+    stress_.plays = 0;
+    stress_.frames = 0;
+    stress_.playMs = 0.0;
+    stress_.worstFramePlayMs = 0.0;
+    stress_.worstUpdateMs = 0.0;
+    stress_.peakActive = 0;
+
+    if (phase == StressPhase::NoPool) {
+        SetPoolingEnabled(false);
+    } else if (phase == StressPhase::Pool) {
+        SetPoolingEnabled(true);
+        // 同時に生きる数（毎秒の回数 x 寿命）まで作り置きしておく
+        auto it = defs_.find(stress_.effectName);
+        if (it != defs_.end()) {
+            const float concurrent = stress_.playsPerSecond * it->second.def.totalDuration;
+            ReservePool(stress_.effectName, static_cast<uint32_t>(concurrent * 1.25f) + 16);
+        }
+    } else if (phase == StressPhase::Cooldown) {
+        // 前半で出したものが消え切るまで待つ（後半の計測に破棄が混ざらないように）
+        auto it = defs_.find(stress_.effectName);
+        stress_.cooldown = (it != defs_.end()) ? it->second.def.totalDuration + 0.25f : 0.25f;
+    }
+    stress_.statsAtStart = poolStats_;
+}
+
+void EffectManager::TickStressBenchmark(float deltaTime, double& playMs) {
+    if (stress_.phase == StressPhase::Cooldown) {
+        stress_.cooldown -= deltaTime;
+        if (stress_.cooldown <= 0.0f) BeginStressPhase(StressPhase::Pool);
+        return;
+    }
+    auto it = defs_.find(stress_.effectName);
+    if (it == defs_.end()) {
+        // 計測中に def が消えた
+        SetPoolingEnabled(stress_.poolingBefore);
+        stress_.phase = StressPhase::Idle;
+        return;
+    }
+
+    stress_.phaseTime += deltaTime;
+    stress_.playDebt += stress_.playsPerSecond * deltaTime;
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t played = 0;
+    while (stress_.playDebt >= 1.0f) {
+        stress_.playDebt -= 1.0f;
+        // 原点まわり 20m 四方にばらまく（xorshift。乱数のためにメモリ確保しない）
+        stress_.rng ^= stress_.rng << 13;
+        stress_.rng ^= stress_.rng >> 17;
+        stress_.rng ^= stress_.rng << 5;
+        const float x = static_cast<float>(stress_.rng & 0xFFFF) / 65535.0f * 20.0f - 10.0f;
+        const float z = static_cast<float>((stress_.rng >> 16) & 0xFFFF) / 65535.0f * 20.0f - 10.0f;
+        PlayFromEntry(it->second, { x, 1.0f, z });
+        ++played;
+    }
+    playMs = ElapsedMs(start);
+    stress_.plays += played;
+    stress_.playMs += playMs;
+    ++stress_.frames;
+    if (playMs > stress_.worstFramePlayMs) stress_.worstFramePlayMs = playMs;
+
+    if (stress_.phaseTime >= stress_.secondsPerPhase) {
+        if (stress_.phase == StressPhase::NoPool) {
+            EndStressPhase("no pool");
+            BeginStressPhase(StressPhase::Cooldown);
+        } else {
+            EndStressPhase("pool   ");
+            SetPoolingEnabled(stress_.poolingBefore);
+            stress_.phase = StressPhase::Idle;
+        }
+    }
+}
+
+void EffectManager::EndStressPhase(const char* label) {
+    const uint64_t hits = poolStats_.hits - stress_.statsAtStart.hits;
+    const uint64_t misses = poolStats_.misses - stress_.statsAtStart.misses;
+    const double usPerPlay = (stress_.plays > 0) ? stress_.playMs * 1000.0 / static_cast<double>(stress_.plays) : 0.0;
+    char buf[320];
+    std::snprintf(buf, sizeof(buf),
+        "[Effect] %s: %llu plays / %llu frames, %.2f us/play, worst frame Play %.2f ms / Update %.2f ms, "
+        "peak %zu live, hits %llu misses %llu",
+        label, static_cast<unsigned long long>(stress_.plays), static_cast<unsigned long long>(stress_.frames),
+        usPerPlay, stress_.worstFramePlayMs, stress_.worstUpdateMs, stress_.peakActive,
+        static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses));
+    LogBuffer::Instance().Add(buf);
+}
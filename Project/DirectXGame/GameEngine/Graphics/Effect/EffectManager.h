@@ -2,6 +2,7 @@
 #include "EffectDef.h"
 #include "EffectInstance.h"
 #include "Vector3.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -14,10 +15,23 @@ class GPUParticleManager;
 /// 再生中のエフェクトを外部から制御するためのハンドル。
 /// Play 系 API が返す値で、Stop / SetPosition / IsAlive に使う。
 /// 0 は無効値。
+/// 下位 32bit がハンドル表のスロット番号、上位 32bit がそのスロットの世代。
+/// インスタンスが終わるとスロットの世代が進むので、古いハンドルが別のエフェクトを指すことはない。
 /// </summary>
 using EffectHandle = uint64_t;
 constexpr EffectHandle kInvalidEffectHandle = 0;
 
+/// <summary>
+/// インスタンスプールの累計（ImGui / ベンチマーク表示用）。
+/// </summary>
+struct EffectPoolStats {
+    uint64_t hits = 0;       // プールから取り出せた Play
+    uint64_t misses = 0;     // プールが空（またはプール無効）で新規生成した Play
+    uint64_t prewarmed = 0;  // def 読み込み時・ReservePool で作り置きした数
+    uint64_t recycled = 0;   // 終了後にプールへ戻した数
+    uint64_t discarded = 0;  // def の差し替え・プール上限超えで破棄した数
+};
+
 /// <summary>
 /// エフェクト定義の登録・再生・更新を担うシングルトン。
 /// </summary>
@@ -75,6 +89,38 @@ public:
     /// </summary>
     void UnregisterDef(const std::string& name);
 
+    // ===== インスタンスプール =====
+    // def ごとに EffectInstance（primitive レンダラ・定数バッファ込み）を作り置きし、
+    // Play はそこから取り出す。終了したインスタンスは 1 フレーム遅れでプールへ戻る。
+    // def を登録し直すとそれまでのプールは捨てて作り直す。
+
+    /// <summary>
+    /// 指定 def のプールを count 個まで作り置きし、プールの上限も count 以上に広げる
+    /// （同時にたくさん出る弾着・撃破エフェクトをシーン開始時に用意しておく用）。
+    /// </summary>
+    void ReservePool(const std::string& effectName, uint32_t count);
+
+    /// <summary>
+    /// false にすると Play は毎回新規生成し、終了したインスタンスは破棄する（比較計測用）。
+    /// </summary>
+    void SetPoolingEnabled(bool enabled) { poolingEnabled_ = enabled; }
+    bool IsPoolingEnabled() const { return poolingEnabled_; }
+
+    const EffectPoolStats& GetPoolStats() const { return poolStats_; }
+    void ResetPoolStats() { poolStats_ = {}; }
+
+    // 全 def のプールに待機中のインスタンス数
+    size_t GetPooledInstanceCount() const;
+
+    /// <summary>
+    /// 負荷試験：effectName を毎秒 playsPerSecond 回ランダムな位置で Play し続ける。
+    /// プール無効 → （前半の残りが消えるまで待機）→ プール有効の順に secondsPerPhase 秒ずつ回し、
+    /// Play の平均時間・フレーム内最悪値・Update の最悪値・プールのヒット数を LogBuffer に出す。
+    /// 実際のフレームの Update に乗せて進めるので、呼んだ後はシーンを回し続けること。
+    /// </summary>
+    void StartStressBenchmark(const std::string& effectName, float playsPerSecond = 1000.0f, float secondsPerPhase = 3.0f);
+    bool IsStressBenchmarkRunning() const { return stress_.phase != StressPhase::Idle; }
+
     // ===== 再生 =====
     /// <summary>
     /// 指定名のエフェクトを worldPos に再生開始。defがなければ kInvalidEffectHandle。
@@ -194,19 +240,15 @@ public:
     /// 先頭の再生中インスタンスを返す（Timeline表示用）。無ければnullptr。
     /// </summary>
     EffectInstance* GetFirstActiveInstance() {
-        for (auto& inst : activeInstances_) if (inst) return inst.get();
+        for (auto& active : activeInstances_) if (active.instance) return active.instance.get();
         return nullptr;
     }
 
     /// <summary>
-    /// 指定ハンドルの再生中インスタンスを返す（EffectEditor のプレビュー Timeline 表示用）。無ければnullptr。
+    /// 指定ハンドルの再生中インスタンスを返す（ゲーム・プレビューどちらも。EffectEditor のプレビュー Timeline 表示用）。
+    /// 無ければnullptr。
     /// </summary>
-    EffectInstance* GetInstanceByHandle(EffectHandle handle) {
-        auto pit = previewHandleToInstance_.find(handle);
-        if (pit != previewHandleToInstance_.end()) return pit->second;
-        auto it = handleToInstance_.find(handle);
-        return (it != handleToInstance_.end()) ? it->second : nullptr;
-    }
+    EffectInstance* GetInstanceByHandle(EffectHandle handle) const;
 
     // 登録済みエフェクト名一覧（デバッグ用）
     std::vector<std::string> ListDefNames() const;
@@ -217,29 +259,102 @@ private:
     EffectManager(const EffectManager&) = delete;
     EffectManager& operator=(const EffectManager&) = delete;
 
+    // def 1 つ分の登録内容と、そこから再生するインスタンスのプール
+    struct DefEntry {
+        EffectDef def;
+        // def を差し替えるたびに進める。プールへ戻すときに取り出した時点の値と比べ、古い def のものは捨てる
+        uint32_t revision = 0;
+        // def を焼いた表。インスタンスはこれを共有する。def を登録・差し替えたときに焼き直す（StoreDef → LutsOf。誤差を読み込み時にログへ出すため）
+        std::shared_ptr<const EffectDefLuts> luts;
+        uint32_t capacity = 0;  // pool に溜めておく上限
+        std::vector<std::unique_ptr<EffectInstance>> pool;
+    };
+
+    // 再生中（または解放待ち）のインスタンスと、その取り出し元
+    struct ActiveEffect {
+        std::unique_ptr<EffectInstance> instance;
+        DefEntry* entry = nullptr;  // PlayWithDef・def 削除後は nullptr（プールへ戻さない）
+        uint32_t revision = 0;
+    };
+
+    // ハンドル表の 1 スロット。generation はスロットを返すたびに進める
+    struct HandleSlot {
+        EffectInstance* instance = nullptr;
+        uint32_t generation = 1;
+        bool preview = false;
+    };
+
+    // 負荷試験の進行状態
+    enum class StressPhase { Idle, NoPool, Cooldown, Pool };
+    struct StressBenchmark {
+        StressPhase phase = StressPhase::Idle;
+        std::string effectName;
+        float playsPerSecond = 0.0f;
+        float secondsPerPhase = 0.0f;
+        float phaseTime = 0.0f;
+        float playDebt = 0.0f;     // まだ Play していない回数（端数を次フレームへ持ち越す）
+        float cooldown = 0.0f;
+        uint32_t rng = 1;
+        bool poolingBefore = true;
+        // フェーズごとの計測
+        uint64_t plays = 0;
+        uint64_t frames = 0;
+        double playMs = 0.0;
+        double worstFramePlayMs = 0.0;
+        double worstUpdateMs = 0.0;
+        size_t peakActive = 0;
+        EffectPoolStats statsAtStart;
+    };
+
+    // 同名の def を登録（既存なら中身を差し替えてプールを作り直す）
+    void StoreDef(EffectDef&& def);
+    // entry.def を焼いた表（無ければここで 1 回だけ焼く）
+    const std::shared_ptr<const EffectDefLuts>& LutsOf(DefEntry& entry);
+    // 焼いた表の誤差（exact に回したカーブ数・GPU 収束 LUT の誤差）を def ごとに 1 行ログへ出す
+    static void ReportLutError(const std::string& name, const EffectDefLuts& luts);
+    // entry.pool を count 個まで作り置きする
+    void PrewarmPool(DefEntry& entry, uint32_t count);
+    // entry.pool を空にする（中身は 1 フレーム以上描画されていないので即破棄してよい）
+    void FlushPool(DefEntry& entry);
+    // entry から 1 つ取り出して（無ければ作って）worldPos で再生開始する
+    EffectHandle PlayFromEntry(DefEntry& entry, const Vector3& worldPos);
+
+    EffectHandle AllocateHandle(EffectInstance* instance, bool preview);
+    void ReleaseHandle(EffectHandle handle);
+    // preview が一致するスロットだけ返す（ゲーム向け API はプレビューを触らない）
+    EffectInstance* FindByHandle(EffectHandle handle, bool preview) const;
+
+    // pendingRelease_ をプールへ戻す / 破棄する（フレーム頭で呼ぶ）
+    void RecyclePendingReleases();
+
+    void TickStressBenchmark(float deltaTime, double& playMs);
+    void BeginStressPhase(StressPhase phase);
+    void EndStressPhase(const char* label);
+
     GPUParticleManager* gpuParticleManager_ = nullptr;
     Camera* camera_ = nullptr;
     Camera* previewCamera_ = nullptr;
 
-    std::unordered_map<std::string, EffectDef> defs_;
-    std::vector<std::unique_ptr<EffectInstance>> activeInstances_;
+    std::unordered_map<std::string, DefEntry> defs_;
+    // 再生中。終了したものは末尾と入れ替えて詰める（描画順は変わるが、エフェクトは加算合成が既定で順序に依存しない）
+    std::vector<ActiveEffect> activeInstances_;
 
-    // ハンドル発行用カウンタ（0は無効値なので 1 から開始）。
-    // プレビューとゲームでハンドル空間は共有（重複しない）。
-    EffectHandle nextHandle_ = 1;
+    // ハンドル表。ゲームとプレビューで共有（ハンドルは重複しない）
+    std::vector<HandleSlot> handleSlots_;
+    std::vector<uint32_t> freeHandleSlots_;
 
-    // ハンドル → activeInstances_ の生ポインタ。インスタンス破棄時に erase する。
-    std::unordered_map<EffectHandle, EffectInstance*> handleToInstance_;
+    // 解放予約：このフレームの Draw で参照されたPrimitiveMeshリソースを
+    // CloseCommandList より先に解放・書き換えすると D3D12 ERROR #921 になるため、
+    // 次フレームの Update 冒頭まで保持してからプールへ戻す（または破棄する）。
+    std::vector<ActiveEffect> pendingRelease_;
 
-    // 破棄予約：このフレームの Draw で参照されたPrimitiveMeshリソースを
-    // CloseCommandList より先に解放すると D3D12 ERROR #921 になるため、
-    // 次フレームの Update 冒頭まで保持する。
-    std::vector<std::unique_ptr<EffectInstance>> pendingDelete_;
+    bool poolingEnabled_ = true;
+    EffectPoolStats poolStats_;
+    StressBenchmark stress_;
 
     // ===== プレビュー専用（EffectEditor）。activeInstances_ とは別系統で、
-    // シーンの Update/Draw には一切載らない。更新はエディタの UpdatePreview のみ。
+    // シーンの Update/Draw には一切載らない。更新はエディタの UpdatePreview のみ。プールは使わない。
     std::vector<std::unique_ptr<EffectInstance>> previewInstances_;
-    std::unordered_map<EffectHandle, EffectInstance*> previewHandleToInstance_;
     std::vector<std::unique_ptr<EffectInstance>> previewPendingDelete_;
 
     // プレビューを寿命終了で消さず自動 Rewind してループ表示するか（編集中の常時プレビュー用）。
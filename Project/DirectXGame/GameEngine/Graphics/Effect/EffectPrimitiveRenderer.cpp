@@ -38,7 +38,16 @@ void EffectPrimitiveRenderer::Initialize(int primitiveType, const std::string& t
     primitiveType_ = primitiveType;
     MeshData md = GenerateByType(primitiveType, ringParams, cylinderParams, helixParams, beamParams, lightningParams, frameParams);
     mesh_.Initialize(md);
+    ApplyDefaultSettings(texturePath);
+}
+
+void EffectPrimitiveRenderer::InitializeDynamic(int primitiveType, const std::string& texturePath) {
+    primitiveType_ = primitiveType;
+    mesh_.InitializeWithoutGeometry();
+    ApplyDefaultSettings(texturePath);
+}
 
+void EffectPrimitiveRenderer::ApplyDefaultSettings(const std::string& texturePath) {
     // エフェクト用既定：加算ブレンド・深度書き込みなし・背面カリング無効
     mesh_.SetBlendMode(PrimitivePipeline::kBlendModeAdd);
     mesh_.SetDepthWrite(false);
@@ -14,7 +14,8 @@ class Camera;
 /// <summary>
 /// エフェクト1個分のPrimitive描画を担う軽量Renderer。
 /// PrimitiveInstanceと違い、Hierarchy/Inspector/Tag/Colliderを持たない。
-/// EffectInstance内部で動的生成→寿命でreset()される短命なもの想定。
+/// EffectInstance が primitive 成分ごとに 1 つ持ち、寿命が来ても破棄せず非表示にしておき、
+/// ループ・プールからの再生で同じメッシュ / 定数バッファを使い回す。
 /// </summary>
 class EffectPrimitiveRenderer {
 public:
@@ -34,6 +35,16 @@ public:
                     const PrimitiveGenerator::LightningBoltParams& lightningParams = {},
                     const PrimitiveGenerator::FrameParams& frameParams = {});
 
+    /// <summary>
+    /// 形状を持たずに初期化（雷など、形状を DynamicGeometryStream へ直接書き換えるもの用）。
+    /// 形状は SetGeometryViews で毎回指し直す。既定の描画設定とテクスチャは Initialize と同じ。
+    /// </summary>
+    void InitializeDynamic(int primitiveType, const std::string& texturePath);
+    void SetGeometryViews(const D3D12_VERTEX_BUFFER_VIEW& vbv, const D3D12_INDEX_BUFFER_VIEW& ibv,
+                          uint32_t vertexCount, uint32_t indexCount) {
+        mesh_.SetGeometryViews(vbv, ibv, vertexCount, indexCount);
+    }
+
     void Update(Camera* camera, float deltaTime);
     void Draw();
 
@@ -63,6 +74,9 @@ public:
     void SetUVFlipV(bool b)            { mesh_.SetUVFlipV(b); }
     void SetTexture(const std::string& path) { mesh_.SetTexture(path); }
 
+    // 使い回して再 spawn するときに UV スクロールを頭に戻す
+    void ResetUVScroll() { mesh_.ResetUVScroll(); }
+
     // ===== Dissolve（オブジェクト単位のディゾルブ）=====
     void SetDissolveMask(const std::string& path) { mesh_.SetDissolveMask(path); }
     void SetDissolve(bool enable, float threshold) { mesh_.SetDissolve(enable, threshold); }
@@ -86,6 +100,9 @@ public:
     void DrawDistortionPassPreview();
 
 private:
+    // Initialize / InitializeDynamic 共通の既定設定（ブレンド・深度・カリング・テクスチャ）
+    void ApplyDefaultSettings(const std::string& texturePath);
+
     PrimitiveMesh mesh_;
     int primitiveType_ = 0;
 
@@ -0,0 +1,171 @@
+#include "LightningBatch.h"
+#include "JobSystem.h"
+#include "LogBuffer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    volatile size_t gBenchSink = 0;
+
+    void GenerateRange(LightningBoltJob* jobs, uint32_t begin, uint32_t end) {
+        // スレッドごとの作業バッファ（一度伸びたら縮めない）
+        thread_local PrimitiveGenerator::LightningScratch scratch;
+        for (uint32_t i = begin; i < end; ++i) {
+            LightningBoltJob& job = jobs[i];
+            const PrimitiveGenerator::MeshWriteResult written = PrimitiveGenerator::WriteLightningBolt(
+                job.params, job.maxBranches, scratch,
+                job.vertices, job.vertexCapacity, job.indices, job.indexCapacity);
+            job.vertexCount = written.vertexCount;
+            job.indexCount = written.indexCount;
+        }
+    }
+
+    // 計測用の雷（チャージ / 炎上で使っている設定に近いもの）。seed 固定で毎回同じ形
+    std::vector<PrimitiveGenerator::LightningBoltParams> MakeBenchmarkBolts(uint32_t count) {
+        std::vector<PrimitiveGenerator::LightningBoltParams> bolts(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            PrimitiveGenerator::LightningBoltParams& p = bolts[i];
+            const float a = static_cast<float>(i) * 0.37f;
+            p.startPos = { std::cos(a) * 2.0f, 0.5f, std::sin(a) * 2.0f };
+            p.endPos = { std::cos(a) * 0.2f, 3.0f + static_cast<float>(i % 5), std::sin(a) * 0.2f };
+            p.appearance.planeCount = 3;
+            p.generations = (i % 2 == 0) ? 5 : 6;
+            p.branchProbability = (i % 2 == 0) ? 0.2f : 0.3f;
+            p.randomSeed = i + 1;
+        }
+        return bolts;
+    }
+}
+
+namespace LightningBatch {
+
+    void Generate(LightningBoltJob* jobs, uint32_t count, uint32_t maxThreads) {
+        if (count == 0) return;
+        if (count == 1 || maxThreads == 1) {
+            GenerateRange(jobs, 0, count);
+            return;
+        }
+        JobSystem::GetInstance()->ParallelFor(count, 1, [jobs](uint32_t begin, uint32_t end) {
+            GenerateRange(jobs, begin, end);
+        }, maxThreads);
+    }
+
+    uint32_t EstimateMaxBranches(const PrimitiveGenerator::LightningBoltParams& params) {
+        return PrimitiveGenerator::EstimateLightningMaxBranches(params);
+    }
+
+} // namespace LightningBatch
+
+void RunLightningBoltBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kBolts = 256;
+    constexpr int kReps = 8;
+
+    const std::vector<PrimitiveGenerator::LightningBoltParams> bolts = MakeBenchmarkBolts(kBolts);
+
+    // 直接書き込み先：1 本ずつ最悪ケース容量を並べた 1 本のバッファ（一致確認のため枝は捨てない）
+    std::vector<LightningBoltJob> jobs(kBolts);
+    std::vector<uint32_t> vertexOffsets(kBolts);
+    std::vector<uint32_t> indexOffsets(kBolts);
+    uint32_t totalVertices = 0;
+    uint32_t totalIndices = 0;
+    for (uint32_t i = 0; i < kBolts; ++i) {
+        uint32_t maxVertices = 0;
+        uint32_t maxIndices = 0;
+        PrimitiveGenerator::GetLightningBoltCapacity(bolts[i], UINT32_MAX, maxVertices, maxIndices);
+        vertexOffsets[i] = totalVertices;
+        indexOffsets[i] = totalIndices;
+        jobs[i].params = bolts[i];
+        jobs[i].maxBranches = UINT32_MAX;
+        jobs[i].vertexCapacity = maxVertices;
+        jobs[i].indexCapacity = maxIndices;
+        totalVertices += maxVertices;
+        totalIndices += maxIndices;
+    }
+    std::vector<MeshVertex> vertices(totalVertices);
+    std::vector<uint32_t> indices(totalIndices);
+    for (uint32_t i = 0; i < kBolts; ++i) {
+        jobs[i].vertices = vertices.data() + vertexOffsets[i];
+        jobs[i].indices = indices.data() + indexOffsets[i];
+    }
+
+    auto msPerRep = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kReps;
+    };
+
+    // 旧方式：1 本ごとに MeshData を確保して返す
+    std::vector<MeshData> reference(kBolts);
+    auto t0 = Clock::now();
+    for (int r = 0; r < kReps; ++r) {
+        for (uint32_t i = 0; i < kBolts; ++i) reference[i] = PrimitiveGenerator::CreateLightningBolt(bolts[i]);
+    }
+    const double meshDataMs = msPerRep(t0);
+
+    // 直接書き込み（直列）
+    t0 = Clock::now();
+    for (int r = 0; r < kReps; ++r) LightningBatch::Generate(jobs.data(), kBolts, 1);
+    const double serialMs = msPerRep(t0);
+
+    auto matchesReference = [&]() {
+        for (uint32_t i = 0; i < kBolts; ++i) {
+            const LightningBoltJob& job = jobs[i];
+            const MeshData& ref = reference[i];
+            if (job.vertexCount != ref.vertices.size() || job.indexCount != ref.indices.size()) return false;
+            if (job.vertexCount > 0 && std::memcmp(job.vertices, ref.vertices.data(), sizeof(MeshVertex) * job.vertexCount) != 0) return false;
+            if (job.indexCount > 0 && std::memcmp(job.indices, ref.indices.data(), sizeof(uint32_t) * job.indexCount) != 0) return false;
+        }
+        return true;
+    };
+    bool match = matchesReference();
+
+    uint64_t writtenVertices = 0;
+    for (const LightningBoltJob& job : jobs) writtenVertices += job.vertexCount;
+
+    JobSystem* jobSystem = JobSystem::GetInstance();
+    if (!jobSystem->IsInitialized()) jobSystem->Initialize();
+    const uint32_t maxThreads = jobSystem->GetWorkerCount() + 1;
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t t = 2; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    if (maxThreads > 1) threadCounts.push_back(maxThreads);
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Effect] Lightning: %u bolts (gen 5/6, 3 planes, %.1f verts avg), %u threads available",
+        kBolts, static_cast<double>(writtenVertices) / kBolts, maxThreads);
+    LogBuffer::Instance().Add(buf);
+
+    std::snprintf(buf, sizeof(buf), "[Effect] Lightning MeshData per bolt %.2f ms | direct write serial %.2f ms (x%.1f) |",
+        meshDataMs, serialMs, (serialMs > 0.0) ? meshDataMs / serialMs : 0.0);
+    std::string line = buf;
+    for (uint32_t threads : threadCounts) {
+        t0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) LightningBatch::Generate(jobs.data(), kBolts, threads);
+        const double ms = msPerRep(t0);
+        match = match && matchesReference();
+        std::snprintf(buf, sizeof(buf), "  %ut %.2fms (x%.1f)", threads, ms, (ms > 0.0) ? meshDataMs / ms : 0.0);
+        line += buf;
+    }
+    LogBuffer::Instance().Add(line + (match ? "  match" : "  MISMATCH"),
+        match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+
+    // 枝の上限（平均 + 4σ）で確保した場合の容量と、実際に捨てた枝の有無
+    uint64_t worstVertices = 0;
+    uint64_t estimatedVertices = 0;
+    uint32_t clipped = 0;
+    for (uint32_t i = 0; i < kBolts; ++i) {
+        uint32_t maxVertices = 0;
+        uint32_t maxIndices = 0;
+        PrimitiveGenerator::GetLightningBoltCapacity(bolts[i], UINT32_MAX, maxVertices, maxIndices);
+        worstVertices += maxVertices;
+        PrimitiveGenerator::GetLightningBoltCapacity(bolts[i], LightningBatch::EstimateMaxBranches(bolts[i]), maxVertices, maxIndices);
+        estimatedVertices += maxVertices;
+        if (reference[i].vertices.size() > maxVertices) ++clipped;
+    }
+    gBenchSink = reference.back().vertices.size();
+    std::snprintf(buf, sizeof(buf), "[Effect] Lightning capacity per bolt: worst %.0f verts, branch cap (mean+4sd) %.0f verts, %u/%u bolts over cap",
+        static_cast<double>(worstVertices) / kBolts, static_cast<double>(estimatedVertices) / kBolts, clipped, kBolts);
+    LogBuffer::Instance().Add(buf);
+}
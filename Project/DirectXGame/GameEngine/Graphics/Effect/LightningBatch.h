@@ -0,0 +1,44 @@
+#pragma once
+#include "Primitive/PrimitiveGenerator.h"
+#include <cstdint>
+
+/// <summary>
+/// 雷 1 本ぶんの生成ジョブ。書き込み先（DynamicGeometryStream のスロットなど）は呼び出し側が用意する。
+/// vertexCount / indexCount に書いた数が返る（本線が容量に入らなければ 0）。
+/// </summary>
+struct LightningBoltJob {
+    PrimitiveGenerator::LightningBoltParams params;
+    uint32_t    maxBranches = 0;
+    MeshVertex* vertices = nullptr;
+    uint32_t    vertexCapacity = 0;
+    uint32_t*   indices = nullptr;
+    uint32_t    indexCapacity = 0;
+
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+};
+
+/// <summary>
+/// 複数の雷をまとめて生成する（D3D に依存しない CPU 部分）。
+/// 1 本ずつ JobSystem::ParallelFor で分担し、作業バッファはスレッドごとに使い回すので、
+/// 温まったあとは生成中にヒープ確保をしない。
+/// </summary>
+namespace LightningBatch {
+
+    /// <summary>jobs[0..count) を生成する。maxThreads > 0 なら呼び出し元を含めてその本数まで（計測用）。</summary>
+    void Generate(LightningBoltJob* jobs, uint32_t count, uint32_t maxThreads = 0);
+
+    /// <summary>
+    /// 想定される枝の本数の上限（本線の隣接点ごとの分岐を二項分布とみて平均 + 4σ、最悪ケース以下）。
+    /// 最悪ケースで確保するより容量がずっと小さく、超えた枝は捨てるだけなので見た目はほぼ変わらない。
+    /// </summary>
+    uint32_t EstimateMaxBranches(const PrimitiveGenerator::LightningBoltParams& params);
+
+} // namespace LightningBatch
+
+/// <summary>
+/// 雷の生成速度を計って LogBuffer に出す。
+/// 旧方式（CreateLightningBolt で毎回 MeshData を確保）と、作業バッファを使い回して直接書く方式の直列・スレッド数ごとの速さと、
+/// 同じ seed で同じ形になるか（旧方式との一致）を確かめる。
+/// </summary>
+void RunLightningBoltBenchmark();
@@ -1,23 +1,79 @@
 #include "LightningRuntime.h"
+#include "LightningBatch.h"
 #include "Primitive/PrimitivePipeline.h"
+#include "Primitive/DynamicGeometryStream.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // 再生成の予約（全ランタイム共通、メインスレッドからだけ触る）
+    struct PendingBolt {
+        LightningRuntime* owner;
+        uint32_t boltIndex;
+    };
+    std::vector<PendingBolt> gPendingBolts;
+    // FlushPendingBolts の作業用（毎フレーム使い回す）
+    std::vector<LightningBoltJob> gBoltJobs;
+}
+
+LightningRuntime::~LightningRuntime() {
+    ReleaseBolts();
+}
 
 void LightningRuntime::Initialize(const PrimitiveGenerator::LightningBoltParams& templateParams,
                                   const std::string& texturePath,
                                   int blendMode) {
+    ReleaseBolts();
+
     params_ = templateParams;
     texturePath_ = texturePath;
     blendMode_ = blendMode;
 
+    // レンダラは一度だけ作り、形状はスロットを指し直して使い回す
+    for (auto& bolt : bolts_) {
+        if (!hasRenderers_) {
+            bolt.renderer.InitializeDynamic(7 /*Lightning*/, texturePath_);
+        } else {
+            bolt.renderer.SetTexture(texturePath_.empty() ? std::string("Resources/Textures/white1x1.dds") : texturePath_);
+        }
+    }
+    hasRenderers_ = true;
+
+    // 最悪ケース（枝は平均 + 4σ 本まで）の容量でスロットを借りる
+    maxBranches_ = LightningBatch::EstimateMaxBranches(params_);
+    uint32_t maxVertices = 0;
+    uint32_t maxIndices = 0;
+    PrimitiveGenerator::GetLightningBoltCapacity(params_, maxBranches_, maxVertices, maxIndices);
+    DynamicGeometryStream* stream = DynamicGeometryStream::GetInstance();
+    for (auto& bolt : bolts_) {
+        bolt.slot = stream->Acquire(maxVertices, maxIndices);
+    }
+
     // 位相をずらすため、2本目の初期残寿命を半分にする（1本目=満タン、2本目=半分）
     bolts_[0].remaining = boltLifetime_;
     bolts_[1].remaining = boltLifetime_ - overlapOffset_;
     bolts_[0].initialized = false;
     bolts_[1].initialized = false;
-    bolts_[0].renderer.reset();
-    bolts_[1].renderer.reset();
     active_ = true;
 }
 
+void LightningRuntime::ReleaseBolts() {
+    gPendingBolts.erase(
+        std::remove_if(gPendingBolts.begin(), gPendingBolts.end(),
+            [this](const PendingBolt& p) { return p.owner == this; }),
+        gPendingBolts.end());
+
+    DynamicGeometryStream* stream = DynamicGeometryStream::GetInstance();
+    for (auto& bolt : bolts_) {
+        if (bolt.slot != DynamicGeometryStream::kInvalidSlot) {
+            stream->Release(bolt.slot);
+            bolt.slot = DynamicGeometryStream::kInvalidSlot;
+        }
+        bolt.pending = false;
+        bolt.initialized = false;
+    }
+}
+
 void LightningRuntime::SetEndpoints(const Vector3& start, const Vector3& end) {
     startPos_ = start;
     endPos_ = end;
@@ -25,23 +81,71 @@ void LightningRuntime::SetEndpoints(const Vector3& start, const Vector3& end) {
 
 void LightningRuntime::SetViewAngleFadePower(float p) {
     viewAngleFadePower_ = p;
+    if (!hasRenderers_) return;
     for (auto& bolt : bolts_) {
-        if (bolt.renderer) bolt.renderer->SetViewAngleFadePower(p);
+        bolt.renderer.SetViewAngleFadePower(p);
     }
 }
 
 void LightningRuntime::Regenerate(BoltState& bolt) {
-    // 始終点を現在値に差し替えてシード=0（=毎回ランダム）でメッシュ生成
-    PrimitiveGenerator::LightningBoltParams p = params_;
-    p.startPos = startPos_;
-    p.endPos   = endPos_;
-    p.randomSeed = 0;
-
-    bolt.renderer = std::make_unique<EffectPrimitiveRenderer>();
-    bolt.renderer->Initialize(7 /*Lightning*/, texturePath_, {}, {}, {}, {}, p);
-    bolt.renderer->SetBlendMode(static_cast<PrimitivePipeline::BlendMode>(blendMode_));
-    bolt.renderer->SetViewAngleFadePower(viewAngleFadePower_);
-    bolt.initialized = true;
+    // 始終点を現在値に差し替えてシード=0（=毎回ランダム）で生成を予約
+    bolt.pendingParams = params_;
+    bolt.pendingParams.startPos = startPos_;
+    bolt.pendingParams.endPos   = endPos_;
+    bolt.pendingParams.randomSeed = 0;
+
+    // 同じフレームに 2 回予約されたら後の始終点で 1 回だけ作る
+    if (!bolt.pending) {
+        bolt.pending = true;
+        gPendingBolts.push_back({ this, static_cast<uint32_t>(&bolt - bolts_) });
+    }
+}
+
+void LightningRuntime::FlushPendingBolts() {
+    if (gPendingBolts.empty()) return;
+
+    DynamicGeometryStream* stream = DynamicGeometryStream::GetInstance();
+
+    // スロットの次の版を書き込み先にしたジョブを作る（版の切り替えはメインスレッドで）
+    gBoltJobs.clear();
+    for (const PendingBolt& p : gPendingBolts) {
+        BoltState& bolt = p.owner->bolts_[p.boltIndex];
+        LightningBoltJob job;
+        if (bolt.slot != DynamicGeometryStream::kInvalidSlot) {
+            const DynamicGeometryStream::WriteTarget target = stream->BeginWrite(bolt.slot);
+            job.params = bolt.pendingParams;
+            job.maxBranches = p.owner->maxBranches_;
+            job.vertices = target.vertices;
+            job.vertexCapacity = target.vertexCapacity;
+            job.indices = target.indices;
+            job.indexCapacity = target.indexCapacity;
+        }
+        gBoltJobs.push_back(job);
+    }
+
+    // 雷ごとに並列で生成（書き込み先は雷ごとに別の領域）
+    LightningBatch::Generate(gBoltJobs.data(), static_cast<uint32_t>(gBoltJobs.size()));
+
+    for (size_t i = 0; i < gPendingBolts.size(); ++i) {
+        LightningRuntime* owner = gPendingBolts[i].owner;
+        BoltState& bolt = owner->bolts_[gPendingBolts[i].boltIndex];
+        const LightningBoltJob& job = gBoltJobs[i];
+        bolt.pending = false;
+        if (bolt.slot == DynamicGeometryStream::kInvalidSlot) continue;
+
+        stream->EndWrite(bolt.slot, job.vertexCount, job.indexCount);
+        D3D12_VERTEX_BUFFER_VIEW vbv{};
+        D3D12_INDEX_BUFFER_VIEW ibv{};
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        if (stream->GetViews(bolt.slot, vbv, ibv, vertexCount, indexCount)) {
+            bolt.renderer.SetGeometryViews(vbv, ibv, vertexCount, indexCount);
+        }
+        bolt.renderer.SetBlendMode(static_cast<PrimitivePipeline::BlendMode>(owner->blendMode_));
+        bolt.renderer.SetViewAngleFadePower(owner->viewAngleFadePower_);
+        bolt.initialized = true;
+    }
+    gPendingBolts.clear();
 }
 
 void LightningRuntime::Update(Camera* camera, float deltaTime) {
@@ -50,22 +154,24 @@ void LightningRuntime::Update(Camera* camera, float deltaTime) {
     for (auto& bolt : bolts_) {
         // 寿命を進める
         bolt.remaining -= deltaTime;
-        if (bolt.remaining <= 0.0f || !bolt.initialized) {
-            // 寿命切れ or 未初期化 → 再生成
+        if (bolt.remaining <= 0.0f || (!bolt.initialized && !bolt.pending)) {
+            // 寿命切れ or 未初期化 → 再生成（Draw の頭でまとめて作る）
             Regenerate(bolt);
             bolt.remaining = boltLifetime_;
         }
         // 通常 Update（UVスクロールや CB 書き込み）
-        if (bolt.renderer) {
-            bolt.renderer->Update(camera, deltaTime);
-        }
+        bolt.renderer.Update(camera, deltaTime);
     }
 }
 
 void LightningRuntime::Draw() {
     if (!active_) return;
+
+    // このフレームに予約された雷（全ランタイム分）をまとめて生成
+    FlushPendingBolts();
+
     for (auto& bolt : bolts_) {
-        if (bolt.renderer && bolt.initialized) {
+        if (bolt.initialized) {
             // 寿命が後半に入っているほど α を落とすことで「フェードアウト中の古い雷」を演出。
             // 簡易：寿命 1.0 → 0.5 で 1.0 から 0.0 へ線形フェード（half-life で消える）
             // ※ Update で color CB を毎フレ更新しているので、ここでは SetColor で被せても OK
@@ -76,12 +182,9 @@ void LightningRuntime::Draw() {
                 if (fade < 0.0f) fade = 0.0f;
             }
             // 元の頂点αは既に焼き込まれている。ここでは MaterialColor の α を fade に。
-            // bolt.renderer->SetColor は SetTranslate/Scale と並ぶ動的設定
             // ※ Material.color が頂点αと乗算されるため、ここでフェードを反映できる
-            // 注: 既存 EffectPrimitiveRenderer に SetColor が無ければ追加が必要
-            // → ある（SetColor(Vector4) 経由で mesh_.SetColor）
-            bolt.renderer->SetColor({ 1.0f, 1.0f, 1.0f, fade });
-            bolt.renderer->Draw();
+            bolt.renderer.SetColor({ 1.0f, 1.0f, 1.0f, fade });
+            bolt.renderer.Draw();
         }
     }
 }
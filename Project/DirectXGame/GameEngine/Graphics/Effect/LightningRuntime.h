@@ -2,7 +2,7 @@
 #include "EffectPrimitiveRenderer.h"
 #include "Primitive/PrimitiveGenerator.h"
 #include "Vector3.h"
-#include <memory>
+#include <cstdint>
 #include <string>
 
 class Camera;
@@ -12,11 +12,18 @@ class Camera;
 /// 内部で 2 本のレンダラを位相ずらしで交互再生成し、寿命毎にメッシュを作り直す
 /// （= シードを毎回ランダムにして"パチパチ"する見た目を出す）。
 /// 必殺技「傲慢サンダー」のように敵やプレイヤーを追従する電撃で使う想定。
+///
+/// レンダラは Initialize で一度だけ作り、形状は DynamicGeometryStream に借りたスロットへ直接書く。
+/// 寿命切れの雷は Update で予約だけしておき、そのフレーム最初の Draw で全ランタイムの予約分を
+/// まとめて並列生成する（FlushPendingBolts）。
 /// </summary>
 class LightningRuntime {
 public:
     LightningRuntime() = default;
-    ~LightningRuntime() = default;
+    ~LightningRuntime();
+
+    LightningRuntime(const LightningRuntime&) = delete;
+    LightningRuntime& operator=(const LightningRuntime&) = delete;
 
     /// <summary>
     /// テンプレートとなる LightningBoltParams（始終点以外の見た目／フラクタル／枝の設定）と
@@ -40,19 +47,31 @@ public:
     void SetViewAngleFadePower(float p);
     void SetBlendMode(int mode)           { blendMode_ = mode; }
 
+    /// <summary>
+    /// 全ランタイムで再生成を予約された雷をまとめて生成し、スロットへ書く。
+    /// Draw の頭で自動で呼ばれるので、通常は呼ばなくてよい（予約がなければ何もしない）。
+    /// </summary>
+    static void FlushPendingBolts();
+
 private:
     // 1本ぶんの状態
     struct BoltState {
-        std::unique_ptr<EffectPrimitiveRenderer> renderer;
+        EffectPrimitiveRenderer renderer;
+        uint32_t slot = 0xFFFFFFFFu;  // DynamicGeometryStream のスロット
+        PrimitiveGenerator::LightningBoltParams pendingParams{};  // 予約時点の始終点で作る
         float remaining = 0.0f;   // 寿命の残り（0以下で再生成）
         bool initialized = false; // 初回生成済みか
+        bool pending = false;     // 再生成を予約済み（FlushPendingBolts 待ち）
     };
 
-    // 渡された始終点で renderer を作り直す（毎回シード=0 で乱数化）
+    // 渡された始終点で再生成を予約する（毎回シード=0 で乱数化）
     void Regenerate(BoltState& bolt);
+    // スロットを返して予約を取り消す
+    void ReleaseBolts();
 
     BoltState bolts_[2];
     PrimitiveGenerator::LightningBoltParams params_{};
+    uint32_t maxBranches_ = 0;
     std::string texturePath_;
     int   blendMode_ = 2;
     float viewAngleFadePower_ = 0.0f;
@@ -61,4 +80,5 @@ private:
     Vector3 startPos_{ 0.0f, 0.0f, 0.0f };
     Vector3 endPos_{ 0.0f, 0.0f, 1.0f };
     bool active_ = false;
+    bool hasRenderers_ = false;
 };
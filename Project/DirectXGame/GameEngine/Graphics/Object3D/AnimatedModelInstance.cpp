@@ -3,6 +3,8 @@
 #include <cstring>
 #include "SkinCluster.h"
 #include "AssetLocator.h"
+#include "ByteReader.h"
+#include "AnimationCodec.h"
 #include "DStorageManager.h"
 #include "PepperMacros.h"
 
@@ -52,6 +54,18 @@ void AnimatedModelInstance::Initialize(ModelCore* modelCore, const std::string&
     // マテリアルデータ作成（submesh 数ぶんの Material CBV を作る）
     CreateMaterialData(modelCore_->GetDXCore());
 
+    // 全 submesh のテクスチャ／法線マップを先にまとめて読む（デコードとミップ生成はワーカーで並列）。
+    // 下のループの LoadTexture / LoadTextureLinear は読み込み済みなら即戻る
+    {
+        std::vector<TextureManager::TextureRequest> requests;
+        requests.reserve(submeshes_.size() * 2);
+        for (const auto& sm : submeshes_) {
+            if (!sm.textureFilePath.empty()) requests.push_back({ sm.textureFilePath, false });
+            if (!sm.normalMapFilePath.empty()) requests.push_back({ sm.normalMapFilePath, true });
+        }
+        TextureManager::GetInstance()->LoadTextures(requests);
+    }
+
     // submesh ごとに .mat 値を反映し、テクスチャ／法線マップをロードする
     for (auto& sm : submeshes_) {
         // .mat の値（color / metallic / roughness / shadingModel / useNormalMap 等）を反映
@@ -198,7 +212,7 @@ void AnimatedModelInstance::CreateVertexData(DirectXCore* dxCore)
         assert(SUCCEEDED(hr));
 
         uint64_t packOffset = 0, packSize = 0;
-        AssetLocator::GetInstance()->GetPackEntryInfo(meshFilePath_, packOffset, packSize);
+        AssetLocator::GetInstance()->GetPackEntryInfo(meshAssetId_, packOffset, packSize);
         auto* ds = DStorageManager::GetInstance();
         ds->EnqueueBufferRead(ds->GetPackFile(),
             packOffset + vertexFileOffset_,
@@ -264,7 +278,7 @@ void AnimatedModelInstance::CreateIndexData(DirectXCore* dxCore)
         assert(SUCCEEDED(hr));
 
         uint64_t packOffset = 0, packSize = 0;
-        AssetLocator::GetInstance()->GetPackEntryInfo(meshFilePath_, packOffset, packSize);
+        AssetLocator::GetInstance()->GetPackEntryInfo(meshAssetId_, packOffset, packSize);
         auto* ds = DStorageManager::GetInstance();
         ds->EnqueueBufferRead(ds->GetPackFile(),
             packOffset + indexFileOffset_,
@@ -416,34 +430,32 @@ namespace {
 // .mat から base_color テクスチャパスを取り出すヘルパー
 std::string ReadMatBaseColorPath_V2(const std::string& matPath)
 {
-    auto h = AssetLocator::GetInstance()->Open(matPath);
-    if (!h.IsValid()) return {};
+    const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(matPath);
+    ByteReader r(bytes.GetBytes());
     char magic[4]{};
-    h.Read(magic, 4);
-    if (std::memcmp(magic, "MATL", 4) != 0) return {};
-    uint32_t version = 0;
-    h.Read(&version, 4);
+    r.GetBytes(magic, 4);
+    if (!r.Ok() || std::memcmp(magic, "MATL", 4) != 0) return {};
+    const uint32_t version = r.Get<uint32_t>();
     // base_color_path は version 直後で全バージョン共通オフセット。v1〜v3 を許容
     if (version < 1 || version > 3) return {};
     char path[256]{};
-    h.Read(path, 256);
+    r.GetBytes(path, 256);
     return std::string(path);
 }
 
 // .mat v3 から normal_map_path を取り出すヘルパー（固定オフセット 308）
 std::string ReadMatNormalMapPath_V2(const std::string& matPath)
 {
-    auto h = AssetLocator::GetInstance()->Open(matPath);
-    if (!h.IsValid()) return {};
+    const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(matPath);
+    ByteReader r(bytes.GetBytes());
     char magic[4]{};
-    h.Read(magic, 4);
-    if (std::memcmp(magic, "MATL", 4) != 0) return {};
-    uint32_t version = 0;
-    h.Read(&version, 4);
+    r.GetBytes(magic, 4);
+    if (!r.Ok() || std::memcmp(magic, "MATL", 4) != 0) return {};
+    const uint32_t version = r.Get<uint32_t>();
     if (version < 3) return {};  // v3 から normal_map_path
-    h.Seek(308);
+    r.Seek(308);
     char path[256]{};
-    h.Read(path, 256);
+    r.GetBytes(path, 256);
     return std::string(path);
 }
 
@@ -461,20 +473,20 @@ struct SkelJoint {
 std::vector<SkelJoint> ReadSkelFile(const std::string& skelPath)
 {
     std::vector<SkelJoint> joints;
-    auto h = AssetLocator::GetInstance()->Open(skelPath);
-    if (!h.IsValid()) return joints;
+    const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(skelPath);
+    ByteReader r(bytes.GetBytes());
 
     char magic[4]{};
-    h.Read(magic, 4);
-    if (std::memcmp(magic, "SKEL", 4) != 0) return joints;
-    uint32_t version = 0, jointCount = 0, reserved = 0;
-    h.Read(&version, 4);
-    h.Read(&jointCount, 4);
-    h.Read(&reserved, 4);
-    if (version != 1) return joints;
+    r.GetBytes(magic, 4);
+    if (!r.Ok() || std::memcmp(magic, "SKEL", 4) != 0) return joints;
+    const uint32_t version = r.Get<uint32_t>();
+    const uint32_t jointCount = r.Get<uint32_t>();
+    r.Get<uint32_t>();  // reserved
+    if (!r.Ok() || version != 1) return joints;
 
     joints.resize(jointCount);
-    h.Read(joints.data(), static_cast<size_t>(jointCount) * sizeof(SkelJoint));
+    r.GetBytes(joints.data(), static_cast<size_t>(jointCount) * sizeof(SkelJoint));
+    if (!r.Ok()) joints.clear();
     return joints;
 }
 
@@ -520,105 +532,41 @@ Node BuildNodeTreeFromSkel(const std::vector<SkelJoint>& joints)
     return std::move(tempNodes[rootIdx]);
 }
 
-// .anim を読んで Animation を構築する
-Animation ReadAnimFile(const std::string& animPath)
-{
-    Animation anim{};
-    anim.duration = 0.0f;
-    auto h = AssetLocator::GetInstance()->Open(animPath);
-    if (!h.IsValid()) return anim;
-
-    char magic[4]{};
-    h.Read(magic, 4);
-    if (std::memcmp(magic, "ANIM", 4) != 0) return anim;
-    uint32_t version = 0, channelCount = 0, channelsOffset = 0, reserved = 0;
-    float duration = 0.0f;
-    h.Read(&version, 4);
-    h.Read(&duration, 4);
-    h.Read(&channelCount, 4);
-    h.Read(&channelsOffset, 4);
-    h.Read(&reserved, 4);
-    if (version != 1) return anim;
-
-    anim.duration = duration;
-
-    // Channel テーブルを全部読み込む
-    struct ChannelHeader {
-        char     joint_name[64];
-        uint32_t t_count, r_count, s_count;
-        uint32_t t_offset, r_offset, s_offset;
-    };
-    std::vector<ChannelHeader> channelHeaders(channelCount);
-    h.Seek(channelsOffset);
-    h.Read(channelHeaders.data(), static_cast<size_t>(channelCount) * sizeof(ChannelHeader));
-
-    // 各チャンネルのキーフレームを読み込む
-    for (const auto& ch : channelHeaders) {
-        std::string jointName(ch.joint_name);
-        NodeAnimation& na = anim.nodeAnimations[jointName];
-
-        na.translate.keyframes.resize(ch.t_count);
-        h.Seek(ch.t_offset);
-        for (uint32_t i = 0; i < ch.t_count; ++i) {
-            float t; Vector3 v;
-            h.Read(&t, 4);
-            h.Read(&v, sizeof(Vector3));
-            na.translate.keyframes[i] = { t, v };
-        }
-        na.rotate.keyframes.resize(ch.r_count);
-        h.Seek(ch.r_offset);
-        for (uint32_t i = 0; i < ch.r_count; ++i) {
-            float t; float q[4];
-            h.Read(&t, 4);
-            h.Read(q, sizeof(q));
-            na.rotate.keyframes[i] = { t, Quaternion(q[0], q[1], q[2], q[3]) };
-        }
-        na.scale.keyframes.resize(ch.s_count);
-        h.Seek(ch.s_offset);
-        for (uint32_t i = 0; i < ch.s_count; ++i) {
-            float t; Vector3 v;
-            h.Read(&t, 4);
-            h.Read(&v, sizeof(Vector3));
-            na.scale.keyframes[i] = { t, v };
-        }
-    }
-    return anim;
-}
-
 } // anonymous namespace
 
 void AnimatedModelInstance::LoadModelV2(const std::string& directoryPath, const std::string& filename)
 {
     const std::string meshPath = directoryPath + "/" + filename;
-    auto h = AssetLocator::GetInstance()->Open(meshPath);
-    assert(h.IsValid() && "failed to open .mesh file");
+    const AssetId meshId = AssetLocator::GetInstance()->Resolve(meshPath);
+    // pack (mmap) モードではマップ上のバイト列をそのままパースする（ファイル全体を読み込まない）
+    const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(meshId);
+    assert(bytes.IsValid() && "failed to open .mesh file");
+    ByteReader r(bytes.GetBytes());
 
     char magic[4]{};
-    h.Read(magic, 4);
+    r.GetBytes(magic, 4);
     assert(std::memcmp(magic, "MESH", 4) == 0);
 
-    uint32_t version = 0, flags = 0;
-    uint32_t vertexCount = 0, indexCount = 0, submeshCount = 0;
-    uint32_t vertexOffset = 0, indexOffset = 0, skinOffset = 0, submeshOffset = 0;
-    h.Read(&version, 4);
-    h.Read(&flags, 4);
-    h.Read(&vertexCount, 4);
-    h.Read(&indexCount, 4);
-    h.Read(&submeshCount, 4);
-    h.Read(&vertexOffset, 4);
-    h.Read(&indexOffset, 4);
-    h.Read(&skinOffset, 4);
-    h.Read(&submeshOffset, 4);
+    const uint32_t version       = r.Get<uint32_t>();
+    const uint32_t flags         = r.Get<uint32_t>();
+    const uint32_t vertexCount   = r.Get<uint32_t>();
+    const uint32_t indexCount    = r.Get<uint32_t>();
+    const uint32_t submeshCount  = r.Get<uint32_t>();
+    const uint32_t vertexOffset  = r.Get<uint32_t>();
+    const uint32_t indexOffset   = r.Get<uint32_t>();
+    const uint32_t skinOffset    = r.Get<uint32_t>();
+    const uint32_t submeshOffset = r.Get<uint32_t>();
     assert(version == 3 && "expected .mesh v3");
 
     char skeletonPathBuf[256]{};
-    h.Read(skeletonPathBuf, 256);
+    r.GetBytes(skeletonPathBuf, 256);
     std::string skeletonPath(skeletonPathBuf);
 
     const bool hasSkinning = (flags & 0x1) != 0;
 
     // GPU フェーズ / SkinCluster で使うメタ情報を保持
     meshFilePath_     = meshPath;
+    meshAssetId_      = meshId;
     vertexFileOffset_ = vertexOffset;
     vertexCount_      = vertexCount;
     indexFileOffset_  = indexOffset;
@@ -634,13 +582,13 @@ void AnimatedModelInstance::LoadModelV2(const std::string& directoryPath, const
     if (!useDirectStorage_) {
         // --- 頂点 ---
         modelData_.vertices.resize(vertexCount);
-        h.ReadAt(vertexOffset, modelData_.vertices.data(),
-                 static_cast<size_t>(vertexCount) * sizeof(VertexData));
+        r.GetBytesAt(vertexOffset, modelData_.vertices.data(),
+                     static_cast<size_t>(vertexCount) * sizeof(VertexData));
 
         // --- インデックス ---
         modelData_.indices.resize(indexCount);
-        h.ReadAt(indexOffset, modelData_.indices.data(),
-                 static_cast<size_t>(indexCount) * sizeof(uint32_t));
+        r.GetBytesAt(indexOffset, modelData_.indices.data(),
+                     static_cast<size_t>(indexCount) * sizeof(uint32_t));
     }
 
     // --- .skel を読んで rootNode を構築 ---
@@ -673,15 +621,15 @@ void AnimatedModelInstance::LoadModelV2(const std::string& directoryPath, const
             uint32_t joint_indices[4];
             float    weights[4];
         };
-        std::vector<SkinVertex> skinData(vertexCount);
-        h.ReadAt(skinOffset, skinData.data(),
-                 static_cast<size_t>(vertexCount) * sizeof(SkinVertex));
-
+        // 一時配列へ写さず、バイト列から 1 頂点ずつ読む
+        r.Seek(skinOffset);
         for (uint32_t v = 0; v < vertexCount; ++v) {
+            const SkinVertex skin = r.Get<SkinVertex>();
+            if (!r.Ok()) break;
             for (int k = 0; k < 4; ++k) {
-                float w = skinData[v].weights[k];
+                float w = skin.weights[k];
                 if (w <= 0.0f) continue;
-                uint32_t jointIdx = skinData[v].joint_indices[k];
+                uint32_t jointIdx = skin.joint_indices[k];
                 if (jointIdx >= skelJoints.size()) continue;
                 const std::string jointName(skelJoints[jointIdx].name);
                 auto& jwd = modelData_.skinClusterData[jointName];
@@ -693,15 +641,14 @@ void AnimatedModelInstance::LoadModelV2(const std::string& directoryPath, const
 
     // --- 全 submesh を読み、部位別マテリアルとして保持する ---
     if (submeshCount > 0) {
-        h.Seek(submeshOffset);
+        r.Seek(submeshOffset);
         submeshes_.clear();
         submeshes_.reserve(submeshCount);
         for (uint32_t i = 0; i < submeshCount; ++i) {
-            uint32_t idxStart = 0, idxCount = 0;
-            h.Read(&idxStart, 4);
-            h.Read(&idxCount, 4);
+            const uint32_t idxStart = r.Get<uint32_t>();
+            const uint32_t idxCount = r.Get<uint32_t>();
             char matPath[256]{};
-            h.Read(matPath, 256);
+            r.GetBytes(matPath, 256);
 
             RenderSubmesh sm;
             sm.indexStart = idxStart;
@@ -726,7 +673,7 @@ void AnimatedModelInstance::LoadModelV2(const std::string& directoryPath, const
         (std::filesystem::path(filename).stem().string() + ".anim");
     std::string animPathStr = animPath.generic_string();
     if (AssetLocator::GetInstance()->Exists(animPathStr)) {
-        animation_ = ReadAnimFile(animPathStr);
+        animation_ = LoadAnimationAsset(animPathStr);
         animationPath_ = animPathStr;
     }
 
@@ -737,6 +684,6 @@ void AnimatedModelInstance::ReplaceAnimation(const std::string& animPath)
 {
     if (animPath.empty()) return;
     if (!AssetLocator::GetInstance()->Exists(animPath)) return;
-    animation_ = ReadAnimFile(animPath);
+    animation_ = LoadAnimationAsset(animPath);
     animationPath_ = animPath;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "ModelCore.h"
 #include "VertexData.h"
 #include "Material.h"
+#include "AssetLocator.h"
 #include <fstream>
 #include <cassert>
 #include "TextureManager.h"
@@ -58,6 +59,7 @@ class AnimatedModelInstance
     // ON のとき modelData_.vertices / .indices / .skinClusterData は CPU に持たない。
     bool        useDirectStorage_ = false;
     std::string meshFilePath_;
+    AssetId     meshAssetId_;  // meshFilePath_ を Resolve 済み（GPU フェーズ / SkinCluster で引き直さない）
     uint32_t    vertexFileOffset_ = 0;
     uint32_t    vertexCount_      = 0;
     uint32_t    indexFileOffset_  = 0;
@@ -125,6 +127,7 @@ public:
     uint32_t GetVertexCount() const { return vertexCount_; }
     uint32_t GetIndexCount()  const { return indexCount_; }
     const std::string& GetMeshFilePath() const { return meshFilePath_; }
+    AssetId GetMeshAssetId() const { return meshAssetId_; }
     uint32_t GetSkinFileOffset() const { return skinFileOffset_; }
     bool HasSkinning() const { return hasSkinning_; }
     ID3D12Resource* GetVertexResource() const { return vertexResource_.Get(); }
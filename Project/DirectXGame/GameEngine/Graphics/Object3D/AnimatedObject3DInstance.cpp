@@ -48,6 +48,8 @@ void AnimatedObject3DInstance::Initialize(Object3DManager* object3DManager,
     if (animatedModelInstance_) {
         skeleton_ = CreateSkeleton(animatedModelInstance_->GetModelData().rootNode);
         hasSkeleton_ = true;
+        sampler_.Reset();
+        prevSampler_.Reset();
 
         // SkinCluster構築
         skinCluster_ = CreateSkinCluster(
@@ -61,8 +63,8 @@ void AnimatedObject3DInstance::Initialize(Object3DManager* object3DManager,
 #ifdef USE_IMGUI
     // デバッグ描画用の球メッシュをJoint数分準備
     if (hasSkeleton_) {
-        debugSpheres_.resize(skeleton_.joints.size());
-        for (size_t i = 0; i < skeleton_.joints.size(); ++i) {
+        debugSpheres_.resize(skeleton_.JointCount());
+        for (size_t i = 0; i < skeleton_.JointCount(); ++i) {
             debugSpheres_[i] = std::make_unique<PrimitiveMesh>();
             MeshData sphereMesh = PrimitiveGenerator::CreateSphere(jointSphereRadius_, 8);
             debugSpheres_[i]->Initialize(sphereMesh);
@@ -84,6 +86,7 @@ void AnimatedObject3DInstance::PlayAnimation(const std::string& animPath, float
         // 現在のアニメを snapshot して旧クリップ側に。フェード中の再ドロップは prev を上書き
         prevAnimation_ = animatedModelInstance_->GetAnimation();
         prevAnimationTime_ = animationTime_;
+        prevSampler_ = sampler_;  // snapshot は同じ clipId なので、解決結果とカーソルをそのまま使える
         hasPrevAnimation_ = (prevAnimation_.duration > 0.0f);
         fadeTimer_ = 0.0f;
         fadeDuration_ = fadeTime;
@@ -145,11 +148,11 @@ void AnimatedObject3DInstance::Update(float deltaTime)
         if (hasPrevAnimation_ && fadeDuration_ > 0.0f) {
             const float w = fadeTimer_ / fadeDuration_;
             ApplyAnimationBlended(skeleton_,
-                prevAnimation_, prevAnimationTime_,
-                animatedModelInstance_->GetAnimation(), animationTime_,
+                prevAnimation_, prevAnimationTime_, prevSampler_,
+                animatedModelInstance_->GetAnimation(), animationTime_, sampler_,
                 w);
         } else {
-            ApplyAnimation(skeleton_, animatedModelInstance_->GetAnimation(), animationTime_);
+            ApplyAnimation(skeleton_, animatedModelInstance_->GetAnimation(), animationTime_, sampler_);
         }
         UpdateSkeleton(skeleton_);
 
@@ -159,11 +162,12 @@ void AnimatedObject3DInstance::Update(float deltaTime)
         }
     }
 
-    Matrix4x4 worldMatrix = MakeAffineMatrix(transform_);
+    history_.Record(transform_);
 
     // Skinning用Boneがないモデルの場合、rootJointのskeletonSpaceMatrixを掛ける
     // ノードアニメーションを反映するため
-    if (hasSkeleton_ && !skeleton_.joints.empty()) {
+    hasRigidRoot_ = false;
+    if (hasSkeleton_ && skeleton_.JointCount() > 0) {
         // 先頭頂点のweightが0 = Skinningなしモデルと判定
         bool isRigidAnimation = false;
         if (hasSkinCluster_ && !skinCluster_.mappedInfluence.empty()) {
@@ -177,16 +181,31 @@ void AnimatedObject3DInstance::Update(float deltaTime)
 
         if (isRigidAnimation) {
             // Skinningなし：rootJointのskeletonSpaceMatrixをworldMatrixに掛ける
-            const Matrix4x4& rootMatrix = skeleton_.joints[skeleton_.root].skeletonSpaceMatrix;
-            worldMatrix = Multiply(rootMatrix, worldMatrix);
+            rigidRootMatrix_ = skeleton_.skeletonSpaceMatrices[skeleton_.root];
+            hasRigidRoot_ = true;
         }
     }
 
+    WriteTransformationMatrices(MakeAffineMatrix(transform_), false);
+}
+
+void AnimatedObject3DInstance::ApplyRenderInterpolation()
+{
+    // 姿勢（スキニング）は最新 tick のまま。置き場所とカメラだけ補間する
+    if (!history_.NeedsRender()) return;
+    WriteTransformationMatrices(MakeAffineMatrix(history_.Interpolated()), true);
+}
+
+void AnimatedObject3DInstance::WriteTransformationMatrices(const Matrix4x4& objectMatrix, bool forRender)
+{
+    const Matrix4x4 worldMatrix = hasRigidRoot_ ? Multiply(rigidRootMatrix_, objectMatrix) : objectMatrix;
+
     Matrix4x4 worldViewProjectionMatrix;
     if (camera_) {
-        const Matrix4x4& viewProjectionMatrix = camera_->GetViewProjectionMatrix();
+        const Matrix4x4& viewProjectionMatrix =
+            forRender ? camera_->GetRenderViewProjectionMatrix() : camera_->GetViewProjectionMatrix();
         worldViewProjectionMatrix = Multiply(worldMatrix, viewProjectionMatrix);
-        cameraData_->worldPosition = camera_->GetTranslate();
+        cameraData_->worldPosition = forRender ? camera_->GetRenderTranslate() : camera_->GetTranslate();
     } else {
         worldViewProjectionMatrix = worldMatrix;
     }
@@ -265,6 +284,8 @@ void AnimatedObject3DInstance::Draw(DirectXCore* dxCore)
         return;
     }
 
+    ApplyRenderInterpolation();
+
     // CS実行（バリア込み）
     DispatchSkinning(dxCore);
 
@@ -321,6 +342,7 @@ void AnimatedObject3DInstance::DrawIdPass(DirectXCore* dxCore)
     if (!visibleInEditor_) return;
 #endif
     if (!animatedModelInstance_ || !hasSkinCluster_ || !object3DManager_) return;
+    ApplyRenderInterpolation();
 
     auto* cmd = dxCore->GetCommandList();
     cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -343,9 +365,8 @@ void AnimatedObject3DInstance::DrawSkeletonDebug(DirectXCore* dxCore)
     Matrix4x4 worldMatrix = MakeAffineMatrix(transform_);
 
     // 各Joint位置に球を描画（Joint数分のメッシュを使う）
-    for (size_t i = 0; i < skeleton_.joints.size(); ++i) {
-        const Joint& joint = skeleton_.joints[i];
-        Matrix4x4 jointWorld = Multiply(joint.skeletonSpaceMatrix, worldMatrix);
+    for (size_t i = 0; i < skeleton_.JointCount(); ++i) {
+        Matrix4x4 jointWorld = Multiply(skeleton_.skeletonSpaceMatrices[i], worldMatrix);
         Vector3 jointPos = { jointWorld.m[3][0], jointWorld.m[3][1], jointWorld.m[3][2] };
 
         debugSpheres_[i]->GetTransform().translate = jointPos;
@@ -357,12 +378,11 @@ void AnimatedObject3DInstance::DrawSkeletonDebug(DirectXCore* dxCore)
     }
 
     // 親子間に線を引く
-    for (const Joint& joint : skeleton_.joints) {
-        if (joint.parent.has_value()) {
-            const Joint& parent = skeleton_.joints[*joint.parent];
-
-            Matrix4x4 jWorld = Multiply(joint.skeletonSpaceMatrix, worldMatrix);
-            Matrix4x4 pWorld = Multiply(parent.skeletonSpaceMatrix, worldMatrix);
+    for (size_t i = 0; i < skeleton_.JointCount(); ++i) {
+        const int32_t parent = skeleton_.parents[i];
+        if (parent >= 0) {
+            Matrix4x4 jWorld = Multiply(skeleton_.skeletonSpaceMatrices[i], worldMatrix);
+            Matrix4x4 pWorld = Multiply(skeleton_.skeletonSpaceMatrices[parent], worldMatrix);
 
             Vector3 jPos = { jWorld.m[3][0], jWorld.m[3][1], jWorld.m[3][2] };
             Vector3 pPos = { pWorld.m[3][0], pWorld.m[3][1], pWorld.m[3][2] };
@@ -379,6 +399,7 @@ void AnimatedObject3DInstance::DrawShadowPass(DirectXCore* dxCore)
     if (!visibleInEditor_) return;
 #endif
     if (!animatedModelInstance_ || !hasSkinCluster_) return;
+    ApplyRenderInterpolation();
 
     // VS CBV b0 = TransformationMatrix（シャドウVSは .World を使う）
     dxCore->GetCommandList()->SetGraphicsRootConstantBufferView(
@@ -518,22 +539,21 @@ void AnimatedObject3DInstance::OnImGuiInspector()
         ImGui::ColorEdit4("Joint Sphere Color", &jointSphereColor_.x);
         ImGui::ColorEdit4("Joint Line Color", &jointLineColor_.x);
         if (hasSkeleton_) {
-            ImGui::Text("Joint Count: %zu", skeleton_.joints.size());
+            ImGui::Text("Joint Count: %zu", skeleton_.JointCount());
 
             // Rootの位置とサンプルJointの位置を表示
-            if (!skeleton_.joints.empty()) {
+            if (skeleton_.JointCount() > 0) {
                 Matrix4x4 worldMatrix = MakeAffineMatrix(transform_);
-                const Joint& root = skeleton_.joints[skeleton_.root];
-                Matrix4x4 rootWorld = Multiply(root.skeletonSpaceMatrix, worldMatrix);
+                Matrix4x4 rootWorld = Multiply(skeleton_.skeletonSpaceMatrices[skeleton_.root], worldMatrix);
                 ImGui::Text("Root: (%.2f, %.2f, %.2f)",
                     rootWorld.m[3][0], rootWorld.m[3][1], rootWorld.m[3][2]);
 
                 // 末端Joint
-                size_t lastIdx = skeleton_.joints.size() - 1;
+                size_t lastIdx = skeleton_.JointCount() - 1;
                 Matrix4x4 lastWorld = Multiply(
-                    skeleton_.joints[lastIdx].skeletonSpaceMatrix, worldMatrix);
+                    skeleton_.skeletonSpaceMatrices[lastIdx], worldMatrix);
                 ImGui::Text("Joint[%zu] '%s': (%.2f, %.2f, %.2f)",
-                    lastIdx, skeleton_.joints[lastIdx].name.c_str(),
+                    lastIdx, skeleton_.names[lastIdx].c_str(),
                     lastWorld.m[3][0], lastWorld.m[3][1], lastWorld.m[3][2]);
             }
 
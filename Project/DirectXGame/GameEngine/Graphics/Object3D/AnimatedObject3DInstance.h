@@ -17,6 +17,7 @@
 #include "AnimatedModelInstance.h"
 #include "Camera.h"
 #include "CameraForGPU.h"
+#include "TransformHistory.h"
 #include "Skeleton.h"
 #include "Animation.h"
 #include <memory>
@@ -58,6 +59,12 @@ class AnimatedObject3DInstance : public IImGuiEditable {
     Transform transform_;
     Transform cameraTransform_;
 
+    // 固定ステップ時の描画補間（前 tick と最新 tick の transform_）
+    TransformHistory history_;
+    // スキニングなし（ノードアニメーションのみ）のモデルで world に掛ける root joint の行列
+    bool hasRigidRoot_ = false;
+    Matrix4x4 rigidRootMatrix_{};
+
     std::string textureFilePath_;
     std::string modelFileName_;
     std::string directoryPath_;  // ロード元 dirPath（シーンJSON保存用。明示的に SetSourcePath で設定）
@@ -80,6 +87,11 @@ class AnimatedObject3DInstance : public IImGuiEditable {
     float fadeDuration_ = 0.0f;        // 0 ならフェード未進行
     float defaultFadeTime_ = 0.25f;    // .anim ドロップ時のデフォルト
 
+    // ----- サンプリング状態（チャンネル→joint の解決結果とキーフレームカーソル） -----
+    // クリップが変わると Apply 時に自動で解決し直す。フェード開始時は現クリップ側をそのまま prev へ引き継ぐ
+    AnimationSampler sampler_;
+    AnimationSampler prevSampler_;
+
     //==============================
     // Skeleton関連
     //==============================
@@ -108,6 +120,13 @@ class AnimatedObject3DInstance : public IImGuiEditable {
     void CreateTransformationMatrixResource(DirectXCore* dxCore);
     void CreateCameraResource(DirectXCore* dxCore);
 
+    // transform 由来の行列から定数バッファを書く（rigid root はここで掛ける）。
+    // forRender = true なら補間済みのカメラを使う
+    void WriteTransformationMatrices(const Matrix4x4& objectMatrix, bool forRender);
+
+    // 固定ステップ中、この描画フレームでまだなら補間した transform で定数バッファを書き直す
+    void ApplyRenderInterpolation();
+
 public:
     AnimatedObject3DInstance() = default;
     ~AnimatedObject3DInstance() override;
@@ -132,6 +151,8 @@ public:
     void SetScale(const Vector3& scale) { transform_.scale = scale; }
     void SetRotate(const Vector3& rotate) { transform_.rotate = rotate; }
     void SetTranslate(const Vector3& translate) { transform_.translate = translate; }
+    // 瞬間移動の直後に呼ぶと、固定ステップの描画補間で移動前との間を通らない
+    void ResetInterpolation() { history_.Reset(); }
 
     // Material関連
     void SetUseEnvironmentMap(bool use);
@@ -204,7 +225,7 @@ public:
         if (!hasSkeleton_) return world;
         auto it = skeleton_.jointMap.find(jointName);
         if (it == skeleton_.jointMap.end()) return world;
-        return Multiply(skeleton_.joints[it->second].skeletonSpaceMatrix, world);
+        return Multiply(skeleton_.skeletonSpaceMatrices[it->second], world);
     }
 
     /// <summary>
@@ -235,7 +256,10 @@ public:
         AnimatedModelInstance* animatedModel,
         const std::string& name = "");
 
-    void Update(float deltaTime);  // 引数にdeltaTimeを追加（可変フレーム対応）
+    // 引数にdeltaTimeを追加（可変フレーム対応）。
+    // 書き込みは自インスタンスのメンバと定数バッファ・パレットだけなので、別インスタンス同士なら
+    // 並列に呼んでよい（Scene::UpdateDynamicAnimated が JobSystem で回す）。PlayAnimation はメインスレッドから
+    void Update(float deltaTime);
 
     // ComputeShader版でSkinning計算をDispatchする（Drawの前に呼ぶ）
     void DispatchSkinning(DirectXCore* dxCore);
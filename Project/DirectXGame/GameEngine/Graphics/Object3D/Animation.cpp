@@ -1,110 +1,120 @@
 #include "Animation.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 
-// assimp
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+NodeAnimation& Animation::AddChannel(const std::string& nodeName)
+{
+    auto [it, inserted] = channelIndex.try_emplace(nodeName, static_cast<uint32_t>(channels.size()));
+    if (inserted) {
+        channels.emplace_back();
+        channelNames.push_back(nodeName);
+    }
+    return channels[it->second];
+}
 
-Animation LoadAnimationFile(const std::string& directoryPath, const std::string& filename)
+int32_t Animation::FindChannel(const std::string& nodeName) const
 {
-    Animation animation;  // 今回作るアニメーション
+    auto it = channelIndex.find(nodeName);
+    return (it != channelIndex.end()) ? static_cast<int32_t>(it->second) : -1;
+}
 
-    Assimp::Importer importer;
-    std::string filePath = directoryPath + "/" + filename;
-    const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
+uint32_t IssueAnimationClipId()
+{
+    static std::atomic<uint32_t> next{ 1 };
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
 
-    assert(scene->mNumAnimations != 0);  // アニメーションがない
+namespace {
 
-    // 最初のアニメーションだけ採用
-    aiAnimation* animationAssimp = scene->mAnimations[0];
+// カーソルからこの区間数だけ前方を線形に見る（可変フレームや再生速度 2〜3 倍でも大抵ここで当たる）
+constexpr uint32_t kCursorForwardSteps = 4;
 
-    // 時間の単位を「秒」に変換
-    animation.duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond);
+// time を含む区間 [i, i + 1] の i を返す。keyframes.size() >= 2 かつ
+// keyframes[0].time < time < keyframes.back().time の前提（範囲外は呼び出し側で処理済み）
+template <typename tValue>
+size_t FindKeyframeSegment(const std::vector<Keyframe<tValue>>& keyframes, float time, uint32_t& cursor)
+{
+    const size_t last = keyframes.size() - 1;
+
+    // 順再生：前回の区間から数区間だけ前へ進めて探す
+    size_t index = cursor;
+    if (index < last && keyframes[index].time <= time) {
+        for (uint32_t step = 0; step < kCursorForwardSteps && index < last; ++step, ++index) {
+            if (time <= keyframes[index + 1].time) {
+                cursor = static_cast<uint32_t>(index);
+                return index;
+            }
+        }
+    }
 
-    // assimpでは個々のNodeのAnimationをchannelと呼んでいる
-    for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
-        aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
-        NodeAnimation& nodeAnimation = animation.nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
+    // シーク・ループの巻き戻し：time より後ろの最初のキーを二分探索し、その 1 つ手前を区間の先頭にする
+    auto it = std::upper_bound(keyframes.begin() + 1, keyframes.end(), time,
+        [](float t, const Keyframe<tValue>& key) { return t < key.time; });
+    index = static_cast<size_t>(it - keyframes.begin()) - 1;
+    if (index >= last) index = last - 1;
+    cursor = static_cast<uint32_t>(index);
+    return index;
+}
 
-        // ----- Translate -----
-        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
-            aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
-            KeyframeVector3 keyframe;
-            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-            // 右手 -> 左手 変換（xを反転）
-            keyframe.value = { -keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
-            nodeAnimation.translate.keyframes.push_back(keyframe);
-        }
+// 区間内の補間係数（時刻が重複したキーでも 0 除算しない）
+template <typename tValue>
+float SegmentRatio(const Keyframe<tValue>& a, const Keyframe<tValue>& b, float time)
+{
+    const float span = b.time - a.time;
+    return (span > 0.0f) ? (time - a.time) / span : 0.0f;
+}
 
-        // ----- Rotate -----
-        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
-            aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
-            KeyframeQuaternion keyframe;
-            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-            // 右手 -> 左手 変換（y, zを反転）
-            keyframe.value = {
-                keyAssimp.mValue.x,
-                -keyAssimp.mValue.y,
-                -keyAssimp.mValue.z,
-                keyAssimp.mValue.w
-            };
-            nodeAnimation.rotate.keyframes.push_back(keyframe);
-        }
+} // namespace
 
-        // ----- Scale -----
-        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
-            aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
-            KeyframeVector3 keyframe;
-            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-            // Scaleはそのまま
-            keyframe.value = { keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
-            nodeAnimation.scale.keyframes.push_back(keyframe);
-        }
-    }
+Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time)
+{
+    uint32_t cursor = 0;
+    return CalculateValue(keyframes, time, cursor);
+}
 
-    return animation;
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time)
+{
+    uint32_t cursor = 0;
+    return CalculateValue(keyframes, time, cursor);
 }
 
-Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time)
+Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time, uint32_t& cursor)
 {
     assert(!keyframes.empty());  // キーがないものは返す値がわからない
 
     // キーが1つか、時刻が最初のキーフレーム前なら最初の値とする
     if (keyframes.size() == 1 || time <= keyframes[0].time) {
+        cursor = 0;
         return keyframes[0].value;
     }
 
-    // 順番に時刻を調べて、範囲内なら線形補間
-    for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-            // 範囲内を補間
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            return Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
-        }
+    // 一番後の時刻より後ろなら、最後の値を返す
+    if (time >= keyframes.back().time) {
+        return keyframes.back().value;
     }
 
-    // 一番後の時刻より後ろなら、最後の値を返す
-    return (*keyframes.rbegin()).value;
+    // 範囲内を線形補間
+    const size_t index = FindKeyframeSegment(keyframes, time, cursor);
+    const float t = SegmentRatio(keyframes[index], keyframes[index + 1], time);
+    return Lerp(keyframes[index].value, keyframes[index + 1].value, t);
 }
 
-Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time)
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time, uint32_t& cursor)
 {
     assert(!keyframes.empty());
 
     if (keyframes.size() == 1 || time <= keyframes[0].time) {
+        cursor = 0;
         return keyframes[0].value;
     }
 
-    for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            // Quaternionは球面線形補間
-            return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
-        }
+    if (time >= keyframes.back().time) {
+        return keyframes.back().value;
     }
 
-    return (*keyframes.rbegin()).value;
-}
\ No newline at end of file
+    // Quaternionは球面線形補間
+    const size_t index = FindKeyframeSegment(keyframes, time, cursor);
+    const float t = SegmentRatio(keyframes[index], keyframes[index + 1], time);
+    return Slerp(keyframes[index].value, keyframes[index + 1].value, t);
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <cstdint>
 
 // =====================================
 // Keyframe（時刻と値のセット）
@@ -38,20 +39,53 @@ struct NodeAnimation {
 // Animation（アニメーション全体）
 // =====================================
 struct Animation {
-    float duration;  // アニメーション全体の長さ（秒）
-    // Node名 → そのNodeのアニメーション
-    std::map<std::string, NodeAnimation> nodeAnimations;
+    float duration = 0.0f;  // アニメーション全体の長さ（秒）
+    // チャンネル（Node ごとのアニメーション）の平坦配列。channelNames と同じ順
+    std::vector<NodeAnimation> channels;
+    std::vector<std::string> channelNames;
+    // Node名 → channels の index（バインド時にだけ引く）
+    std::map<std::string, uint32_t> channelIndex;
+    // 読み込みごとに振られる ID（コピーは同じ ID を持つ）。0 は空のアニメーション。
+    // AnimationSampler はこれが変わったときだけチャンネルを解決し直す
+    uint32_t clipId = 0;
+
+    // 名前のチャンネルを返す（無ければ末尾に追加する）
+    NodeAnimation& AddChannel(const std::string& nodeName);
+    // 名前のチャンネル index を返す（無ければ -1）
+    int32_t FindChannel(const std::string& nodeName) const;
+};
+
+// =====================================
+// KeyframeCursor（チャンネルごとのキーフレーム探索位置）
+// =====================================
+// 前回見つかった区間 [index, index + 1] の先頭を curve ごとに覚えておく。
+// 順再生なら次のフレームは同じ区間か数区間先にあるので、先頭からの走査をせずに済む。
+struct KeyframeCursor {
+    uint32_t translate = 0;
+    uint32_t rotate = 0;
+    uint32_t scale = 0;
 };
 
 // =====================================
 // 関数宣言
 // =====================================
 
-// アニメーションファイルを読み込む
+// アニメーションファイルを読み込む（assimp を使うので AnimationLoader.cpp に分けてある）
 Animation LoadAnimationFile(const std::string& directoryPath, const std::string& filename);
 
+// 新しいクリップ ID を発行する（読み込み直後の Animation に振る）
+uint32_t IssueAnimationClipId();
+
 // 任意の時刻のVector3値を計算（線形補間）
 Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time);
 
 // 任意の時刻のQuaternion値を計算（球面線形補間）
-Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time);
\ No newline at end of file
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time);
+
+/// <summary>
+/// カーソル付きの値計算。cursor の区間から前方へ数区間だけ探し、外れたら（シーク・ループの巻き戻し）二分探索する。
+/// 見つかった区間を cursor に書き戻すので、順再生なら 1 回あたり償却 O(1)。
+/// </summary>
+Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time, uint32_t& cursor);
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time, uint32_t& cursor);
+
@@ -0,0 +1,600 @@
+#include "AnimationCodec.h"
+#include "AssetLocator.h"
+#include "ByteReader.h"
+#include "LogBuffer.h"
+#include "MathUtility.h"
+#include "Quaternion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kAnimVersion1 = 1;
+constexpr uint32_t kAnimVersion2 = 2;
+constexpr uint32_t kHeaderSize = 24;
+
+constexpr uint8_t kTrackEmpty = 0;
+constexpr uint8_t kTrackConstant = 1;
+constexpr uint8_t kTrackQuantized = 2;
+constexpr uint8_t kTrackRaw = 3;
+constexpr uint8_t kTrackFloatTime = 0x4;
+
+// 時刻を u16 にしてよい最大誤差（秒）。約 13 秒を超えるクリップは f32 で持つ
+// （ルートモーションは時刻のずれがそのまま位置の誤差になるため、0.1ms 程度に抑える）
+constexpr float kTimeTolerance = 0.0001f;
+// smallest-three の残り 3 成分が取りうる範囲 [-1/√2, 1/√2]
+constexpr float kSmallestThreeRange = 0.70710678f;
+constexpr float kQuatStep = 32767.0f;
+constexpr float kVec3Step = 65535.0f;
+
+// ----- 書き出し -----
+class Writer {
+public:
+    template <typename T>
+    void Put(const T& value) {
+        const size_t at = bytes_.size();
+        bytes_.resize(at + sizeof(T));
+        std::memcpy(bytes_.data() + at, &value, sizeof(T));
+    }
+    void PutBytes(const void* data, size_t size) {
+        const size_t at = bytes_.size();
+        bytes_.resize(at + size);
+        std::memcpy(bytes_.data() + at, data, size);
+    }
+    std::vector<uint8_t>& Bytes() { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+// ----- 誤差と補間 -----
+float Vec3Error(const Vector3& a, const Vector3& b) {
+    return std::max({ std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z) });
+}
+
+// 2 つの回転の角度差（ラジアン。q と -q は同じ回転）
+float QuatError(const Quaternion& a, const Quaternion& b) {
+    const float d = std::min(1.0f, std::abs(Dot(a, b)));
+    return 2.0f * std::acos(d);
+}
+
+Vector3 Interp(const Vector3& a, const Vector3& b, float t) { return Lerp(a, b, t); }
+Quaternion Interp(const Quaternion& a, const Quaternion& b, float t) { return Slerp(a, b, t); }
+float Error(const Vector3& a, const Vector3& b) { return Vec3Error(a, b); }
+float Error(const Quaternion& a, const Quaternion& b) { return QuatError(a, b); }
+
+// 全キーが先頭キーと許容値以内なら定数トラック
+template <typename tValue>
+bool IsConstantTrack(const std::vector<Keyframe<tValue>>& keys, float tolerance) {
+    for (const auto& key : keys) {
+        if (Error(keys[0].value, key.value) > tolerance) return false;
+    }
+    return true;
+}
+
+// 残すキーの index を返す。区間 [a, b] を補間し直したとき、間の全キーが許容値以内なら b を 1 つ先へ伸ばす
+template <typename tValue>
+std::vector<uint32_t> ReduceKeys(const std::vector<Keyframe<tValue>>& keys, float tolerance, uint32_t maxSegmentKeys) {
+    const uint32_t count = static_cast<uint32_t>(keys.size());
+    std::vector<uint32_t> kept{ 0 };
+    uint32_t a = 0;
+    uint32_t b = 2;
+    while (b < count) {
+        bool fits = (b - a) <= maxSegmentKeys;
+        const float span = keys[b].time - keys[a].time;
+        for (uint32_t j = a + 1; fits && j < b; ++j) {
+            const float t = (span > 0.0f) ? (keys[j].time - keys[a].time) / span : 0.0f;
+            fits = Error(Interp(keys[a].value, keys[b].value, t), keys[j].value) <= tolerance;
+        }
+        if (fits) {
+            ++b;
+        } else {
+            a = b - 1;
+            kept.push_back(a);
+            b = a + 2;
+        }
+    }
+    if (count > 1) kept.push_back(count - 1);
+    return kept;
+}
+
+uint16_t QuantizeUnit(float value, float step) {
+    const float q = std::floor(std::clamp(value, 0.0f, 1.0f) * step + 0.5f);
+    return static_cast<uint16_t>(q);
+}
+
+// smallest-three: 最大成分を正にして落とし、残り 3 成分を 15bit ずつ詰める（48bit）
+void EncodeQuat(Writer& w, Quaternion q) {
+    q = Normalize(q);
+    const float c[4] = { q.x, q.y, q.z, q.w };
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) largest = i;
+    }
+    const float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+    uint64_t bits = static_cast<uint64_t>(largest) << 45;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float u = (c[i] * sign + kSmallestThreeRange) / (2.0f * kSmallestThreeRange);
+        bits |= static_cast<uint64_t>(QuantizeUnit(u, kQuatStep)) << shift;
+        shift -= 15;
+    }
+    w.Put(static_cast<uint16_t>(bits & 0xFFFF));
+    w.Put(static_cast<uint16_t>((bits >> 16) & 0xFFFF));
+    w.Put(static_cast<uint16_t>((bits >> 32) & 0xFFFF));
+}
+
+Quaternion DecodeQuat(const uint16_t packed[3]) {
+    const uint64_t bits = static_cast<uint64_t>(packed[0])
+        | (static_cast<uint64_t>(packed[1]) << 16)
+        | (static_cast<uint64_t>(packed[2]) << 32);
+    const int largest = static_cast<int>((bits >> 45) & 0x3);
+    float c[4]{};
+    float sumSq = 0.0f;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float u = static_cast<float>((bits >> shift) & 0x7FFF) / kQuatStep;
+        c[i] = u * (2.0f * kSmallestThreeRange) - kSmallestThreeRange;
+        sumSq += c[i] * c[i];
+        shift -= 15;
+    }
+    c[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+    return Normalize(Quaternion{ c[0], c[1], c[2], c[3] });
+}
+
+void PutValue(Writer& w, const Vector3& v) { w.Put(v); }
+void PutValue(Writer& w, const Quaternion& q) { w.Put(q.x); w.Put(q.y); w.Put(q.z); w.Put(q.w); }
+
+// 残すキーの時刻。u16 に丸めても単調増加で誤差が kTimeTolerance 以内なら u16、そうでなければ f32
+void EncodeTimes(Writer& w, const std::vector<float>& times, float duration, uint8_t& kind) {
+    bool useU16 = duration > 0.0f && duration / (2.0f * kVec3Step) <= kTimeTolerance;
+    std::vector<uint16_t> q(times.size());
+    for (size_t i = 0; useU16 && i < times.size(); ++i) {
+        q[i] = QuantizeUnit(times[i] / duration, kVec3Step);
+        useU16 = (i == 0 || q[i] > q[i - 1]);
+    }
+    if (!useU16) kind |= kTrackFloatTime;
+    w.Put(kind);
+    w.Put(static_cast<uint32_t>(times.size()));
+    if (useU16) {
+        w.PutBytes(q.data(), q.size() * sizeof(uint16_t));
+    } else {
+        w.PutBytes(times.data(), times.size() * sizeof(float));
+    }
+}
+
+void EncodeVec3Track(Writer& w, const std::vector<KeyframeVector3>& keys, float duration,
+    float tolerance, uint32_t maxSegmentKeys) {
+    if (keys.empty()) {
+        w.Put(kTrackEmpty);
+        return;
+    }
+    if (IsConstantTrack(keys, tolerance)) {
+        w.Put(kTrackConstant);
+        PutValue(w, keys[0].value);
+        return;
+    }
+
+    const std::vector<uint32_t> kept = ReduceKeys(keys, tolerance, maxSegmentKeys);
+    std::vector<float> times;
+    times.reserve(kept.size());
+    Vector3 lo = keys[kept[0]].value, hi = lo;
+    for (uint32_t i : kept) {
+        const Vector3& v = keys[i].value;
+        times.push_back(keys[i].time);
+        lo = { std::min(lo.x, v.x), std::min(lo.y, v.y), std::min(lo.z, v.z) };
+        hi = { std::max(hi.x, v.x), std::max(hi.y, v.y), std::max(hi.z, v.z) };
+    }
+    const Vector3 extent = { hi.x - lo.x, hi.y - lo.y, hi.z - lo.z };
+
+    // 範囲が広すぎて 16bit の刻みが許容値を超える（長いルートモーション等）なら値は f32 のまま持つ
+    const float maxExtent = std::max({ extent.x, extent.y, extent.z });
+    if (maxExtent / (2.0f * kVec3Step) > tolerance) {
+        uint8_t kind = kTrackRaw;
+        EncodeTimes(w, times, duration, kind);
+        for (uint32_t i : kept) PutValue(w, keys[i].value);
+        return;
+    }
+
+    uint8_t kind = kTrackQuantized;
+    EncodeTimes(w, times, duration, kind);
+    w.Put(lo);
+    w.Put(extent);
+    auto unit = [](float v, float l, float e) { return (e > 0.0f) ? (v - l) / e : 0.0f; };
+    for (uint32_t i : kept) {
+        const Vector3& v = keys[i].value;
+        w.Put(QuantizeUnit(unit(v.x, lo.x, extent.x), kVec3Step));
+        w.Put(QuantizeUnit(unit(v.y, lo.y, extent.y), kVec3Step));
+        w.Put(QuantizeUnit(unit(v.z, lo.z, extent.z), kVec3Step));
+    }
+}
+
+void EncodeQuatTrack(Writer& w, const std::vector<KeyframeQuaternion>& keys, float duration,
+    float tolerance, uint32_t maxSegmentKeys) {
+    if (keys.empty()) {
+        w.Put(kTrackEmpty);
+        return;
+    }
+    if (IsConstantTrack(keys, tolerance)) {
+        w.Put(kTrackConstant);
+        PutValue(w, keys[0].value);
+        return;
+    }
+
+    const std::vector<uint32_t> kept = ReduceKeys(keys, tolerance, maxSegmentKeys);
+    std::vector<float> times;
+    times.reserve(kept.size());
+    for (uint32_t i : kept) times.push_back(keys[i].time);
+
+    uint8_t kind = kTrackQuantized;
+    EncodeTimes(w, times, duration, kind);
+    for (uint32_t i : kept) EncodeQuat(w, keys[i].value);
+}
+
+// 量子化トラックの時刻列を読む
+bool DecodeTimes(ByteReader& r, uint8_t kind, float duration, uint32_t& count, std::vector<float>& times) {
+    count = r.Get<uint32_t>();
+    if (!r.Ok() || count == 0) return false;
+    times.resize(count);
+    if (kind & kTrackFloatTime) {
+        r.GetBytes(times.data(), count * sizeof(float));
+    } else {
+        std::vector<uint16_t> q(count);
+        r.GetBytes(q.data(), count * sizeof(uint16_t));
+        const float scale = duration / kVec3Step;
+        for (uint32_t i = 0; i < count; ++i) times[i] = static_cast<float>(q[i]) * scale;
+    }
+    return r.Ok();
+}
+
+bool DecodeVec3Track(ByteReader& r, float duration, std::vector<KeyframeVector3>& out) {
+    const uint8_t kind = r.Get<uint8_t>();
+    switch (kind & 0x3) {
+    case kTrackEmpty:
+        out.clear();
+        return r.Ok();
+    case kTrackConstant:
+        out.assign(1, KeyframeVector3{ 0.0f, r.Get<Vector3>() });
+        return r.Ok();
+    case kTrackQuantized: {
+        uint32_t count = 0;
+        std::vector<float> times;
+        if (!DecodeTimes(r, kind, duration, count, times)) return false;
+        const Vector3 lo = r.Get<Vector3>();
+        const Vector3 extent = r.Get<Vector3>();
+        std::vector<uint16_t> q(static_cast<size_t>(count) * 3);
+        r.GetBytes(q.data(), q.size() * sizeof(uint16_t));
+        if (!r.Ok()) return false;
+        const Vector3 step = { extent.x / kVec3Step, extent.y / kVec3Step, extent.z / kVec3Step };
+        out.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint16_t* k = &q[static_cast<size_t>(i) * 3];
+            out[i] = { times[i], { lo.x + k[0] * step.x, lo.y + k[1] * step.y, lo.z + k[2] * step.z } };
+        }
+        return true;
+    }
+    case kTrackRaw: {
+        uint32_t count = 0;
+        std::vector<float> times;
+        if (!DecodeTimes(r, kind, duration, count, times)) return false;
+        out.resize(count);
+        for (uint32_t i = 0; i < count; ++i) out[i] = { times[i], r.Get<Vector3>() };
+        return r.Ok();
+    }
+    default:
+        return false;
+    }
+}
+
+bool DecodeQuatTrack(ByteReader& r, float duration, std::vector<KeyframeQuaternion>& out) {
+    const uint8_t kind = r.Get<uint8_t>();
+    switch (kind & 0x3) {
+    case kTrackEmpty:
+        out.clear();
+        return r.Ok();
+    case kTrackConstant: {
+        float c[4];
+        r.GetBytes(c, sizeof(c));
+        out.assign(1, KeyframeQuaternion{ 0.0f, Quaternion{ c[0], c[1], c[2], c[3] } });
+        return r.Ok();
+    }
+    case kTrackQuantized: {
+        uint32_t count = 0;
+        std::vector<float> times;
+        if (!DecodeTimes(r, kind, duration, count, times)) return false;
+        std::vector<uint16_t> q(static_cast<size_t>(count) * 3);
+        r.GetBytes(q.data(), q.size() * sizeof(uint16_t));
+        if (!r.Ok()) return false;
+        out.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            out[i] = { times[i], DecodeQuat(&q[static_cast<size_t>(i) * 3]) };
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool DecodeV2(ByteReader& r, float duration, uint32_t channelCount, Animation& out) {
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        const uint8_t nameLength = r.Get<uint8_t>();
+        std::string name(nameLength, '\0');
+        r.GetBytes(name.data(), nameLength);
+        if (!r.Ok()) return false;
+
+        NodeAnimation& na = out.AddChannel(name);
+        if (!DecodeVec3Track(r, duration, na.translate.keyframes)) return false;
+        if (!DecodeQuatTrack(r, duration, na.rotate.keyframes)) return false;
+        if (!DecodeVec3Track(r, duration, na.scale.keyframes)) return false;
+    }
+    return true;
+}
+
+bool DecodeV1(ByteReader& r, uint32_t channelCount, uint32_t channelsOffset, Animation& out) {
+    // Channel テーブルを全部読み込む
+    struct ChannelHeader {
+        char     joint_name[64];
+        uint32_t t_count, r_count, s_count;
+        uint32_t t_offset, r_offset, s_offset;
+    };
+    std::vector<ChannelHeader> channelHeaders(channelCount);
+    r.Seek(channelsOffset);
+    r.GetBytes(channelHeaders.data(), static_cast<size_t>(channelCount) * sizeof(ChannelHeader));
+    if (!r.Ok()) return false;
+
+    // 各チャンネルのキーフレームを読み込む
+    for (const auto& ch : channelHeaders) {
+        std::string jointName(ch.joint_name, strnlen(ch.joint_name, sizeof(ch.joint_name)));
+        NodeAnimation& na = out.AddChannel(jointName);
+
+        na.translate.keyframes.resize(ch.t_count);
+        r.Seek(ch.t_offset);
+        for (auto& key : na.translate.keyframes) {
+            key.time = r.Get<float>();
+            key.value = r.Get<Vector3>();
+        }
+        na.rotate.keyframes.resize(ch.r_count);
+        r.Seek(ch.r_offset);
+        for (auto& key : na.rotate.keyframes) {
+            key.time = r.Get<float>();
+            float q[4];
+            r.GetBytes(q, sizeof(q));
+            key.value = Quaternion(q[0], q[1], q[2], q[3]);
+        }
+        na.scale.keyframes.resize(ch.s_count);
+        r.Seek(ch.s_offset);
+        for (auto& key : na.scale.keyframes) {
+            key.time = r.Get<float>();
+            key.value = r.Get<Vector3>();
+        }
+        if (!r.Ok()) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<uint8_t> EncodeAnimationV2(const Animation& animation, const AnimationQuantizeSettings& settings)
+{
+    Writer w;
+    w.PutBytes("ANIM", 4);
+    w.Put(kAnimVersion2);
+    w.Put(animation.duration);
+    w.Put(static_cast<uint32_t>(animation.channels.size()));
+    w.Put(kHeaderSize);
+    w.Put(uint32_t{ 0 });  // reserved
+
+    for (size_t c = 0; c < animation.channels.size(); ++c) {
+        const std::string& name = animation.channelNames[c];
+        const uint8_t nameLength = static_cast<uint8_t>(std::min<size_t>(name.size(), 255));
+        w.Put(nameLength);
+        w.PutBytes(name.data(), nameLength);
+
+        const NodeAnimation& na = animation.channels[c];
+        EncodeVec3Track(w, na.translate.keyframes, animation.duration, settings.translateTolerance, settings.maxSegmentKeys);
+        EncodeQuatTrack(w, na.rotate.keyframes, animation.duration, settings.rotateTolerance, settings.maxSegmentKeys);
+        EncodeVec3Track(w, na.scale.keyframes, animation.duration, settings.scaleTolerance, settings.maxSegmentKeys);
+    }
+    return std::move(w.Bytes());
+}
+
+bool DecodeAnimation(const uint8_t* data, size_t size, Animation& out)
+{
+    out = Animation{};
+    ByteReader r(data, size);
+
+    char magic[4]{};
+    r.GetBytes(magic, 4);
+    if (!r.Ok() || std::memcmp(magic, "ANIM", 4) != 0) return false;
+    const uint32_t version = r.Get<uint32_t>();
+    const float duration = r.Get<float>();
+    const uint32_t channelCount = r.Get<uint32_t>();
+    const uint32_t channelsOffset = r.Get<uint32_t>();
+    r.Get<uint32_t>();  // reserved
+    if (!r.Ok()) return false;
+
+    out.duration = duration;
+    out.channels.reserve(channelCount);
+    out.channelNames.reserve(channelCount);
+
+    bool ok = false;
+    if (version == kAnimVersion2) {
+        r.Seek(channelsOffset);
+        ok = DecodeV2(r, duration, channelCount, out);
+    } else if (version == kAnimVersion1) {
+        ok = DecodeV1(r, channelCount, channelsOffset, out);
+    }
+    if (ok) out.clipId = IssueAnimationClipId();
+    return ok;
+}
+
+Animation LoadAnimationAsset(const std::string& animPath)
+{
+    Animation anim{};
+    // キーごとの小さな Read を繰り返さず、全体（pack ならマップそのもの）をメモリ上で展開する
+    const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(animPath);
+    if (!bytes.IsValid()) return anim;
+
+    if (!DecodeAnimation(bytes.GetData(), bytes.GetSize(), anim)) {
+        LogBuffer::Instance().Add("[Animation] invalid .anim: " + animPath, LogBuffer::Level::Error);
+        return Animation{};
+    }
+    return anim;
+}
+
+namespace {
+
+// ----- ベンチマーク用の v1 書き出し（cook_assets.py の _write_anim_v1 と同じレイアウト） -----
+std::vector<uint8_t> EncodeAnimationV1(const Animation& animation)
+{
+    constexpr uint32_t kChannelSize = 64 + 6 * 4;
+    Writer w;
+    w.PutBytes("ANIM", 4);
+    w.Put(kAnimVersion1);
+    w.Put(animation.duration);
+    w.Put(static_cast<uint32_t>(animation.channels.size()));
+    w.Put(kHeaderSize);
+    w.Put(uint32_t{ 0 });
+
+    uint32_t cursor = kHeaderSize + static_cast<uint32_t>(animation.channels.size()) * kChannelSize;
+    for (size_t c = 0; c < animation.channels.size(); ++c) {
+        const NodeAnimation& na = animation.channels[c];
+        char name[64]{};
+        std::memcpy(name, animation.channelNames[c].data(), std::min<size_t>(animation.channelNames[c].size(), 63));
+        w.PutBytes(name, sizeof(name));
+        const uint32_t tc = static_cast<uint32_t>(na.translate.keyframes.size());
+        const uint32_t rc = static_cast<uint32_t>(na.rotate.keyframes.size());
+        const uint32_t sc = static_cast<uint32_t>(na.scale.keyframes.size());
+        w.Put(tc); w.Put(rc); w.Put(sc);
+        w.Put(cursor); cursor += tc * 16;
+        w.Put(cursor); cursor += rc * 20;
+        w.Put(cursor); cursor += sc * 16;
+    }
+    for (const NodeAnimation& na : animation.channels) {
+        for (const auto& key : na.translate.keyframes) { w.Put(key.time); PutValue(w, key.value); }
+        for (const auto& key : na.rotate.keyframes) { w.Put(key.time); PutValue(w, key.value); }
+        for (const auto& key : na.scale.keyframes) { w.Put(key.time); PutValue(w, key.value); }
+    }
+    return std::move(w.Bytes());
+}
+
+size_t KeyMemoryBytes(const Animation& animation)
+{
+    size_t bytes = 0;
+    for (const NodeAnimation& na : animation.channels) {
+        bytes += na.translate.keyframes.size() * sizeof(KeyframeVector3);
+        bytes += na.rotate.keyframes.size() * sizeof(KeyframeQuaternion);
+        bytes += na.scale.keyframes.size() * sizeof(KeyframeVector3);
+    }
+    return bytes;
+}
+
+// モーションキャプチャ風のクリップ：ルートだけ移動、各関節は数本の正弦波を重ねた回転に
+// センサー由来の細かい揺れを乗せる。末端の関節と全スケールは動かない（定数トラック）
+Animation MakeMocapLikeClip(int jointCount, int keyCount, float fps, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::normal_distribution<float> jitter(0.0f, 5.0e-4f);
+
+    Animation clip{};
+    clip.duration = static_cast<float>(keyCount - 1) / fps;
+    for (int j = 0; j < jointCount; ++j) {
+        NodeAnimation& na = clip.AddChannel("mixamorig:Joint" + std::to_string(j));
+        const bool leaf = (j % 5 == 4);
+        const Vector3 axis = Normalize(Vector3{ unit(rng), unit(rng), unit(rng) });
+        const float freq[3] = { 0.3f + 0.5f * std::abs(unit(rng)), 1.1f + std::abs(unit(rng)), 2.7f + std::abs(unit(rng)) };
+        const float amp[3] = { 0.6f * std::abs(unit(rng)), 0.2f * std::abs(unit(rng)), 0.05f * std::abs(unit(rng)) };
+        const Vector3 offset = { 0.0f, 0.1f + 0.1f * std::abs(unit(rng)), 0.0f };
+
+        for (int k = 0; k < keyCount; ++k) {
+            const float t = static_cast<float>(k) / fps;
+            Vector3 translate = offset;
+            if (j == 0) translate = { 0.8f * std::sin(0.5f * t), 0.95f + 0.03f * std::sin(6.0f * t), 1.2f * t };
+            float angle = 0.0f;
+            if (!leaf) {
+                for (int h = 0; h < 3; ++h) angle += amp[h] * std::sin(freq[h] * t + static_cast<float>(j));
+                angle += jitter(rng);
+            }
+            na.translate.keyframes.push_back({ t, translate });
+            na.rotate.keyframes.push_back({ t, MakeRotateAxisAngleQuaternion(axis, angle) });
+            na.scale.keyframes.push_back({ t, { 1.0f, 1.0f, 1.0f } });
+        }
+    }
+    clip.clipId = IssueAnimationClipId();
+    return clip;
+}
+
+} // namespace
+
+void RunAnimationCodecBenchmark()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    struct Case { int joints; int keys; float fps; };
+    const Case kCases[] = { { 30, 300, 30.0f }, { 65, 1800, 60.0f }, { 65, 7200, 120.0f } };
+    const int kDecodeRuns = 20;
+    const AnimationQuantizeSettings settings{};
+
+    LogBuffer::Instance().Add("[AnimCodec] .anim v1 (float keys) vs v2 (quantized + reduced)");
+    for (const Case& c : kCases) {
+        const Animation clip = MakeMocapLikeClip(c.joints, c.keys, c.fps, static_cast<uint32_t>(c.keys));
+        const std::vector<uint8_t> v1 = EncodeAnimationV1(clip);
+
+        const auto e0 = Clock::now();
+        const std::vector<uint8_t> v2 = EncodeAnimationV2(clip, settings);
+        const auto e1 = Clock::now();
+
+        Animation decodedV1, decodedV2;
+        bool ok = true;
+        const auto d0 = Clock::now();
+        for (int i = 0; i < kDecodeRuns; ++i) ok = DecodeAnimation(v1.data(), v1.size(), decodedV1) && ok;
+        const auto d1 = Clock::now();
+        for (int i = 0; i < kDecodeRuns; ++i) ok = DecodeAnimation(v2.data(), v2.size(), decodedV2) && ok;
+        const auto d2 = Clock::now();
+
+        // 往復誤差：元クリップの全キー時刻と、キーの中間時刻で両者をサンプリングして比べる
+        float maxT = 0.0f, maxR = 0.0f, maxS = 0.0f;
+        for (size_t ch = 0; ok && ch < clip.channels.size(); ++ch) {
+            const NodeAnimation& src = clip.channels[ch];
+            const int32_t dc = decodedV2.FindChannel(clip.channelNames[ch]);
+            if (dc < 0) { ok = false; break; }
+            const NodeAnimation& dst = decodedV2.channels[dc];
+            uint32_t ct = 0, cr = 0, cs = 0;
+            for (int k = 0; k < 2 * c.keys - 1; ++k) {
+                const float t = 0.5f * static_cast<float>(k) / c.fps;
+                maxT = std::max(maxT, Vec3Error(CalculateValue(src.translate.keyframes, t), CalculateValue(dst.translate.keyframes, t, ct)));
+                maxR = std::max(maxR, QuatError(CalculateValue(src.rotate.keyframes, t), CalculateValue(dst.rotate.keyframes, t, cr)));
+                maxS = std::max(maxS, Vec3Error(CalculateValue(src.scale.keyframes, t), CalculateValue(dst.scale.keyframes, t, cs)));
+            }
+        }
+        // 削減の許容値に、量子化の刻み（位置は許容値以内に収まる範囲だけ量子化、回転は 15bit ≒ 1e-4 rad）と時刻の丸めぶんの余裕を足した上限
+        const bool withinBound = ok
+            && maxT <= 2.0f * settings.translateTolerance + 1.0e-4f
+            && maxR <= 2.0f * settings.rotateTolerance + 2.0e-4f
+            && maxS <= 2.0f * settings.scaleTolerance + 1.0e-4f;
+
+        const double encodeMs = std::chrono::duration<double, std::milli>(e1 - e0).count();
+        const double decodeV1Ms = std::chrono::duration<double, std::milli>(d1 - d0).count() / kDecodeRuns;
+        const double decodeV2Ms = std::chrono::duration<double, std::milli>(d2 - d1).count() / kDecodeRuns;
+        const size_t memV1 = KeyMemoryBytes(decodedV1);
+        const size_t memV2 = KeyMemoryBytes(decodedV2);
+
+        char buf[320];
+        std::snprintf(buf, sizeof(buf),
+            "[AnimCodec] %d joints x %d keys  file %zu -> %zu KB (x%.1f)  keys in memory %zu -> %zu KB (x%.1f)  "
+            "decode %.2f -> %.2f ms  encode %.1f ms  err T %.2e R %.2e rad S %.2e  %s",
+            c.joints, c.keys, v1.size() / 1024, v2.size() / 1024,
+            v2.empty() ? 0.0 : static_cast<double>(v1.size()) / v2.size(),
+            memV1 / 1024, memV2 / 1024, memV2 ? static_cast<double>(memV1) / memV2 : 0.0,
+            decodeV1Ms, decodeV2Ms, encodeMs, maxT, maxR, maxS,
+            withinBound ? "within tolerance" : "OUT OF TOLERANCE");
+        LogBuffer::Instance().Add(buf, withinBound ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Animation.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =====================================
+// .anim（Cooker 出力のアニメーションクリップ）の読み書き
+// =====================================
+//
+// v1: キーごとに time(f32) + 値(f32×3/4) をそのまま並べた形式（チャンネル名は 64 byte 固定）
+// v2: 量子化＋キー削減した圧縮形式。tools/Python/cook_assets.py の _write_anim_v2 と同じレイアウト
+//
+//   Header (24 byte) : "ANIM", u32 version(=2), f32 duration, u32 channelCount, u32 channelsOffset, u32 reserved
+//   Channel          : u8 nameLength, char name[nameLength], Track translate, Track rotate, Track scale
+//   Track            : u8 kind（下位 2bit: 0=空 1=定数 2=量子化 3=f32 値、bit2: 時刻を f32 で持つ）
+//     定数           : f32 value[3 or 4]（時刻 0 の 1 キーになる）
+//     量子化         : u32 keyCount, 時刻（u16 で duration を 65535 等分 / bit2 なら f32）×keyCount,
+//       vec3         : f32 min[3], f32 extent[3], u16 q[3]×keyCount（min + q / 65535 * extent）
+//       quat         : u16[3]×keyCount（smallest-three: 最大成分の index 2bit + 残り 3 成分 15bit ずつの 48bit）
+//     f32 値         : u32 keyCount, 時刻×keyCount, f32 value[3]×keyCount（範囲が広く 16bit では許容値を守れない vec3）
+//
+// キー削減は「前後のキーで補間し直しても元のキーとの誤差が許容値以内」のキーを落とす。
+
+/// <summary>v2 書き出しの許容誤差（キー削減・定数トラック判定に使う）。</summary>
+struct AnimationQuantizeSettings {
+    float translateTolerance = 1.0e-4f; // 位置（ワールド単位）
+    float rotateTolerance = 1.0e-3f;    // 回転（ラジアン）
+    float scaleTolerance = 1.0e-4f;     // スケール
+    uint32_t maxSegmentKeys = 256;      // 1 区間で削れるキー数の上限（削減処理の計算量を抑える）
+};
+
+/// <summary>Animation を .anim v2 のバイト列にする（ランタイムでの再クックとベンチマーク用）。</summary>
+std::vector<uint8_t> EncodeAnimationV2(const Animation& animation,
+    const AnimationQuantizeSettings& settings = {});
+
+/// <summary>
+/// .anim（v1 / v2）をメモリ上のバイト列から Animation に展開する。
+/// 形式が壊れていれば false（out は途中までの内容になる）。成功時は新しい clipId を振る。
+/// </summary>
+bool DecodeAnimation(const uint8_t* data, size_t size, Animation& out);
+
+/// <summary>
+/// AssetHandle 経由で .anim を 1 回の読み出しで取り込み、DecodeAnimation で展開する（assimp を通らない）。
+/// 開けない・形式不正なら duration 0 の空アニメーション。
+/// </summary>
+Animation LoadAnimationAsset(const std::string& animPath);
+
+/// <summary>
+/// 合成したモーションキャプチャ風クリップで v1 / v2 のサイズ・展開時間と、
+/// v2 の往復誤差（位置・回転・スケールの最大誤差が許容値に収まるか）を LogBuffer に出す。
+/// </summary>
+void RunAnimationCodecBenchmark();
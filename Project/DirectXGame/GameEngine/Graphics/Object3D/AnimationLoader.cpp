@@ -0,0 +1,68 @@
+#include "Animation.h"
+#include <cassert>
+
+// assimp
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+Animation LoadAnimationFile(const std::string& directoryPath, const std::string& filename)
+{
+    Animation animation;  // 今回作るアニメーション
+
+    Assimp::Importer importer;
+    std::string filePath = directoryPath + "/" + filename;
+    const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
+
+    assert(scene->mNumAnimations != 0);  // アニメーションがない
+
+    // 最初のアニメーションだけ採用
+    aiAnimation* animationAssimp = scene->mAnimations[0];
+
+    // 時間の単位を「秒」に変換
+    animation.duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond);
+
+    // assimpでは個々のNodeのAnimationをchannelと呼んでいる
+    for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
+        aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
+        NodeAnimation& nodeAnimation = animation.AddChannel(nodeAnimationAssimp->mNodeName.C_Str());
+
+        // ----- Translate -----
+        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
+            aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
+            KeyframeVector3 keyframe;
+            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+            // 右手 -> 左手 変換（xを反転）
+            keyframe.value = { -keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
+            nodeAnimation.translate.keyframes.push_back(keyframe);
+        }
+
+        // ----- Rotate -----
+        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
+            aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
+            KeyframeQuaternion keyframe;
+            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+            // 右手 -> 左手 変換（y, zを反転）
+            keyframe.value = {
+                keyAssimp.mValue.x,
+                -keyAssimp.mValue.y,
+                -keyAssimp.mValue.z,
+                keyAssimp.mValue.w
+            };
+            nodeAnimation.rotate.keyframes.push_back(keyframe);
+        }
+
+        // ----- Scale -----
+        for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
+            aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
+            KeyframeVector3 keyframe;
+            keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+            // Scaleはそのまま
+            keyframe.value = { keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
+            nodeAnimation.scale.keyframes.push_back(keyframe);
+        }
+    }
+
+    animation.clipId = IssueAnimationClipId();
+    return animation;
+}
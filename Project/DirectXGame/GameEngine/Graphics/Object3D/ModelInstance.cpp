@@ -2,6 +2,7 @@
 #include <filesystem> // std::filesystem::path を使うために必要
 #include <cstring>
 #include "AssetLocator.h"
+#include "ByteReader.h"
 #include "DStorageManager.h"
 #include "PepperMacros.h"
 
@@ -77,6 +78,18 @@ void ModelInstance::InitializeGPU(ModelCore* modelCore, DirectXCore* dxCore)
 	CreateIndexData(dxCore);
 	CreateMaterialData(dxCore);
 
+	// 全 submesh のテクスチャ／法線マップを先にまとめて読む（デコードとミップ生成はワーカーで並列）。
+	// 下のループの LoadTexture / LoadTextureLinear は読み込み済みなら即戻る
+	{
+		std::vector<TextureManager::TextureRequest> requests;
+		requests.reserve(submeshes_.size() * 2);
+		for (const auto& sm : submeshes_) {
+			if (!sm.textureFilePath.empty()) requests.push_back({ sm.textureFilePath, false });
+			if (!sm.normalMapFilePath.empty()) requests.push_back({ sm.normalMapFilePath, true });
+		}
+		TextureManager::GetInstance()->LoadTextures(requests);
+	}
+
 	// submesh ごとに .mat 値を GPU material へ反映し、テクスチャ／法線マップをロードする
 	for (auto& sm : submeshes_) {
 		// .mat の値（color / metallic / roughness / shadingModel / useNormalMap 等）を反映。
@@ -202,7 +215,7 @@ void ModelInstance::CreateVertexData(DirectXCore* dxCore)
 
 		// pack 内 .mesh のオフセットを取得して DStorage で直接 VRAM へ転送
 		uint64_t packOffset = 0, packSize = 0;
-		AssetLocator::GetInstance()->GetPackEntryInfo(meshFilePath_, packOffset, packSize);
+		AssetLocator::GetInstance()->GetPackEntryInfo(meshAssetId_, packOffset, packSize);
 		auto* ds = DStorageManager::GetInstance();
 		ds->EnqueueBufferRead(ds->GetPackFile(),
 			packOffset + vertexFileOffset_,
@@ -287,7 +300,7 @@ void ModelInstance::CreateIndexData(DirectXCore* dxCore)
 		assert(SUCCEEDED(hr));
 
 		uint64_t packOffset = 0, packSize = 0;
-		AssetLocator::GetInstance()->GetPackEntryInfo(meshFilePath_, packOffset, packSize);
+		AssetLocator::GetInstance()->GetPackEntryInfo(meshAssetId_, packOffset, packSize);
 		auto* ds = DStorageManager::GetInstance();
 		ds->EnqueueBufferRead(ds->GetPackFile(),
 			packOffset + indexFileOffset_,
@@ -345,39 +358,37 @@ Node ModelInstance::ReadNode(aiNode* node)
 // base_color_path は version 直後で全バージョン共通オフセットなので v1〜v3 を許容する。
 static std::string ReadMatBaseColorPath(const std::string& matPath)
 {
-	auto h = AssetLocator::GetInstance()->Open(matPath);
-	if (!h.IsValid()) return {};
+	const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(matPath);
+	ByteReader r(bytes.GetBytes());
 
 	char magic[4]{};
-	h.Read(magic, 4);
-	if (std::memcmp(magic, "MATL", 4) != 0) return {};
+	r.GetBytes(magic, 4);
+	if (!r.Ok() || std::memcmp(magic, "MATL", 4) != 0) return {};
 
-	uint32_t version = 0;
-	h.Read(&version, 4);
+	const uint32_t version = r.Get<uint32_t>();
 	if (version < 1 || version > 3) return {};
 
 	char baseColorPath[256]{};
-	h.Read(baseColorPath, 256);
+	r.GetBytes(baseColorPath, 256);
 	return std::string(baseColorPath);
 }
 
 // .mat (MATL) v3 から normal_map_path を抽出するヘルパー（固定オフセット 308）
 static std::string ReadMatNormalMapPath(const std::string& matPath)
 {
-	auto h = AssetLocator::GetInstance()->Open(matPath);
-	if (!h.IsValid()) return {};
+	const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(matPath);
+	ByteReader r(bytes.GetBytes());
 
 	char magic[4]{};
-	h.Read(magic, 4);
-	if (std::memcmp(magic, "MATL", 4) != 0) return {};
+	r.GetBytes(magic, 4);
+	if (!r.Ok() || std::memcmp(magic, "MATL", 4) != 0) return {};
 
-	uint32_t version = 0;
-	h.Read(&version, 4);
+	const uint32_t version = r.Get<uint32_t>();
 	if (version < 3) return {};  // v3 から normal_map_path
 
-	h.Seek(308);  // magic+ver+base(256)+color(16)+enable+shininess+env+useenv+metallic+roughness+shading
+	r.Seek(308);  // magic+ver+base(256)+color(16)+enable+shininess+env+useenv+metallic+roughness+shading
 	char normalPath[256]{};
-	h.Read(normalPath, 256);
+	r.GetBytes(normalPath, 256);
 	return std::string(normalPath);
 }
 
@@ -394,35 +405,36 @@ void ModelInstance::LoadMeshBinary(const std::string& directoryPath, const std::
 	//   [Submesh Data]  Submesh × submesh_count (index_start + index_count + material_path[256])
 	// 頂点は既に LH 座標系・V 反転済み、インデックスも winding 反転済み。
 	std::string filePath = directoryPath + "/" + filename;
-	auto h = AssetLocator::GetInstance()->Open(filePath);
-	if (!h.IsValid()) return;
+	const AssetId meshId = AssetLocator::GetInstance()->Resolve(filePath);
+	// pack (mmap) モードではマップ上のバイト列をそのままパースする（ファイル全体を読み込まない）
+	const AssetBytes bytes = AssetLocator::GetInstance()->LoadBytes(meshId);
+	ByteReader r(bytes.GetBytes());
 
 	char magic[4]{};
-	h.Read(magic, 4);
-	if (std::memcmp(magic, "MESH", 4) != 0) return;
-
-	uint32_t version = 0, flags = 0, vertexCount = 0, indexCount = 0, submeshCount = 0;
-	uint32_t vertexOffset = 0, indexOffset = 0, skinOffset = 0, submeshOffset = 0;
-	h.Read(&version, 4);
-	h.Read(&flags, 4);
-	h.Read(&vertexCount, 4);
-	h.Read(&indexCount, 4);
-	h.Read(&submeshCount, 4);
-	h.Read(&vertexOffset, 4);
-	h.Read(&indexOffset, 4);
-	h.Read(&skinOffset, 4);
-	h.Read(&submeshOffset, 4);
-
-	if (version != 3) return;  // v3 のみサポート（tangent 付き）
+	r.GetBytes(magic, 4);
+	if (!r.Ok() || std::memcmp(magic, "MESH", 4) != 0) return;
+
+	const uint32_t version       = r.Get<uint32_t>();
+	r.Get<uint32_t>();  // flags（静的メッシュでは使わない）
+	const uint32_t vertexCount   = r.Get<uint32_t>();
+	const uint32_t indexCount    = r.Get<uint32_t>();
+	const uint32_t submeshCount  = r.Get<uint32_t>();
+	const uint32_t vertexOffset  = r.Get<uint32_t>();
+	const uint32_t indexOffset   = r.Get<uint32_t>();
+	r.Get<uint32_t>();  // skin_offset
+	const uint32_t submeshOffset = r.Get<uint32_t>();
+
+	if (!r.Ok() || version != 3) return;  // v3 のみサポート（tangent 付き）
 
 	// skeleton_path は今は使わない（スキニングモデルは別経路）
-	h.Seek(h.GetPosition() + 256);
+	r.Skip(256);
 
 	// 静的 .mesh はノード階層を持たないので rootNode の localMatrix を単位行列にしておく
 	modelData_.rootNode.localMatrix = MakeIdentity4x4();
 
 	// GPU フェーズで使うメタ情報を保持
 	meshFilePath_     = filePath;
+	meshAssetId_      = meshId;
 	vertexFileOffset_ = vertexOffset;
 	vertexCount_      = vertexCount;
 	indexFileOffset_  = indexOffset;
@@ -436,26 +448,25 @@ void ModelInstance::LoadMeshBinary(const std::string& directoryPath, const std::
 	if (!useDirectStorage_) {
 		// 頂点
 		modelData_.vertices.resize(vertexCount);
-		h.ReadAt(vertexOffset, modelData_.vertices.data(),
-		         static_cast<size_t>(vertexCount) * sizeof(VertexData));
+		r.GetBytesAt(vertexOffset, modelData_.vertices.data(),
+		             static_cast<size_t>(vertexCount) * sizeof(VertexData));
 
 		// インデックス
 		modelData_.indices.resize(indexCount);
-		h.ReadAt(indexOffset, modelData_.indices.data(),
-		         static_cast<size_t>(indexCount) * sizeof(uint32_t));
+		r.GetBytesAt(indexOffset, modelData_.indices.data(),
+		             static_cast<size_t>(indexCount) * sizeof(uint32_t));
 	}
 
 	// 全 submesh を読み、部位別マテリアルとして保持する
 	if (submeshCount > 0) {
-		h.Seek(submeshOffset);
+		r.Seek(submeshOffset);
 		submeshes_.clear();
 		submeshes_.reserve(submeshCount);
 		for (uint32_t i = 0; i < submeshCount; ++i) {
-			uint32_t idxStart = 0, idxCount = 0;
-			h.Read(&idxStart, 4);
-			h.Read(&idxCount, 4);
+			const uint32_t idxStart = r.Get<uint32_t>();
+			const uint32_t idxCount = r.Get<uint32_t>();
 			char matPath[256]{};
-			h.Read(matPath, 256);
+			r.GetBytes(matPath, 256);
 
 			RenderSubmesh sm;
 			sm.indexStart = idxStart;
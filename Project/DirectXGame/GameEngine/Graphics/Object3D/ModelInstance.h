@@ -4,11 +4,13 @@
 #include"ModelCore.h"
 #include"VertexData.h"
 #include "Material.h"
+#include "AssetLocator.h"
 #include <fstream>
 #include <cassert>
 #include"TextureManager.h"
 #include"MathUtility.h"
 #include "QuaternionTransform.h"
+#include "Node.h"
 #include <map>
 #include <vector>
 
@@ -17,13 +19,6 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
-struct Node{
-	QuaternionTransform transform;
-	Matrix4x4 localMatrix;
-	std::string name;
-	std::vector<Node>children;
-};
-
 // Skinning用のデータ構造
 struct VertexWeightData {
 	float weight;
@@ -95,6 +90,7 @@ class ModelInstance
 	// ON のときは modelData_.vertices/indices を CPU に持たず、pack から直接 VRAM に転送する。
 	bool        useDirectStorage_ = false;
 	std::string meshFilePath_;
+	AssetId     meshAssetId_;  // meshFilePath_ を Resolve 済み（GPU フェーズで pack 目次を引き直さない）
 	uint32_t    vertexFileOffset_ = 0;
 	uint32_t    vertexCount_      = 0;
 	uint32_t    indexFileOffset_  = 0;
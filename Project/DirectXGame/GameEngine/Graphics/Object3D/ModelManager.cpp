@@ -1,4 +1,5 @@
 #include "ModelManager.h"
+#include "PepperMacros.h"
 #include <thread>
 
 //ModelManager* ModelManager::instance = nullptr;
@@ -88,6 +89,7 @@ void ModelManager::Finalize()
 
 void ModelManager::PreloadCPU(const std::string& directoryPath, const std::string& filePath)
 {
+	PEPPER_SCOPE("Model_PreloadCPU");
 	// 既にエントリがあれば、メインスレッドの所有なのでスキップ
 	// （二重ロードや LoadCPU の競合を避けるため、エントリ作成者だけが LoadCPU を呼ぶ）
 	ModelInstance* target = nullptr;
@@ -0,0 +1,14 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "QuaternionTransform.h"
+#include <string>
+#include <vector>
+
+// モデルのノード階層（ModelInstance が読み込み、CreateSkeleton が Skeleton に平たくする）。
+// D3D12 / assimp に依存しないよう ModelInstance.h から分けてある。
+struct Node{
+	QuaternionTransform transform;
+	Matrix4x4 localMatrix;
+	std::string name;
+	std::vector<Node>children;
+};
@@ -41,18 +41,35 @@ void Object3DInstance::Initialize(Object3DManager* object3DManager, DirectXCore*
 
 void Object3DInstance::Update()
 {
+    history_.Record(transform_);
+
     Matrix4x4 worldMatrix = hasWorldOverride_ ? worldOverride_ : MakeAffineMatrix(transform_);
+    WriteTransformationMatrices(worldMatrix, false);
+}
+
+void Object3DInstance::ApplyRenderInterpolation()
+{
+    if (!history_.NeedsRender()) return;
+
+    // ワールド行列の上書き（ボーン追従）は最新 tick のまま。カメラ側の補間だけ効かせる
+    Matrix4x4 worldMatrix = hasWorldOverride_ ? worldOverride_ : MakeAffineMatrix(history_.Interpolated());
+    WriteTransformationMatrices(worldMatrix, true);
+}
+
+void Object3DInstance::WriteTransformationMatrices(const Matrix4x4& worldMatrix, bool forRender)
+{
     Matrix4x4 worldViewProjectionMatrix;
 
     if (camera_) {
-        const Matrix4x4& viewProjectionMatrix = camera_->GetViewProjectionMatrix();
+        const Matrix4x4& viewProjectionMatrix =
+            forRender ? camera_->GetRenderViewProjectionMatrix() : camera_->GetViewProjectionMatrix();
 
         // RootNodeのlocalMatrixを適用
         Matrix4x4 localMatrix = modelInstance_->GetModelData().rootNode.localMatrix;
         worldViewProjectionMatrix = Multiply(localMatrix, Multiply(worldMatrix, viewProjectionMatrix));
 
         // カメラ位置をGPUに送る
-        cameraData_->worldPosition = camera_->GetTranslate();
+        cameraData_->worldPosition = forRender ? camera_->GetRenderTranslate() : camera_->GetTranslate();
     } else {
         worldViewProjectionMatrix = worldMatrix;
     }
@@ -69,6 +86,8 @@ void Object3DInstance::Draw(DirectXCore* dxCore)
 #ifdef _DEBUG
     if (!visibleInEditor_) return;
 #endif
+    ApplyRenderInterpolation();
+
   // Materialのフラグに応じてPSOを切り替え
     if (modelInstance_) {
         Material* mat = modelInstance_->GetMaterialPointer();
@@ -108,6 +127,7 @@ void Object3DInstance::DrawIdPass(DirectXCore* dxCore)
     if (!visibleInEditor_) return;
 #endif
     if (!modelInstance_) return;
+    ApplyRenderInterpolation();
 
     auto* cmd = dxCore->GetCommandList();
     cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -130,6 +150,7 @@ void Object3DInstance::DrawShadowPass(DirectXCore* dxCore)
     if (!visibleInEditor_) return;
 #endif
     if (!modelInstance_) return;
+    ApplyRenderInterpolation();
 
     // VS CBV b0 = TransformationMatrix（シャドウVSは .World を使う）
     dxCore->GetCommandList()->SetGraphicsRootConstantBufferView(
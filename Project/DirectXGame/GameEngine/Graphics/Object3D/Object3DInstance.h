@@ -17,6 +17,7 @@
 #include "ModelManager.h"
 #include "Camera.h"
 #include "CameraForGPU.h"
+#include "TransformHistory.h"
 
 // ImGui対応
 #include "IImGuiEditable.h"
@@ -53,6 +54,9 @@ class Object3DInstance : public IImGuiEditable {
     bool hasWorldOverride_ = false;
     Matrix4x4 worldOverride_{};
 
+    // 固定ステップ時の描画補間（前 tick と最新 tick の transform_）
+    TransformHistory history_;
+
     // テクスチャファイルパス（テクスチャ変更機能用）
     std::string textureFilePath_;
     std::string modelFileName_;
@@ -67,6 +71,13 @@ class Object3DInstance : public IImGuiEditable {
 
     void CreateCameraResource(DirectXCore* dxCore);
 
+    // ワールド行列から定数バッファ（World / WVP / WorldInverseTranspose / カメラ位置）を書く。
+    // forRender = true なら補間済みのカメラを使う
+    void WriteTransformationMatrices(const Matrix4x4& worldMatrix, bool forRender);
+
+    // 固定ステップ中、この描画フレームでまだなら補間した transform で定数バッファを書き直す
+    void ApplyRenderInterpolation();
+
 public:
     //==============================
     // コンストラクタ・デストラクタ
@@ -106,6 +117,9 @@ public:
     void SetWorldMatrixOverride(const Matrix4x4& m) { worldOverride_ = m; hasWorldOverride_ = true; }
     void ClearWorldMatrixOverride() { hasWorldOverride_ = false; }
 
+    // 瞬間移動の直後に呼ぶと、固定ステップの描画補間で移動前との間を通らない
+    void ResetInterpolation() { history_.Reset(); }
+
     //==============================
     // Material関連セッター（環境マッピング関連）
     //==============================
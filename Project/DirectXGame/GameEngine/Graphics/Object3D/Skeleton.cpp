@@ -1,16 +1,87 @@
 #include "Skeleton.h"
-#include "ModelInstance.h"  // Node の定義
+#include "Node.h"
 #include "Animation.h"      // Animation, NodeAnimation, CalculateValue
 #include "MathUtility.h"
 #include "Quaternion.h"
+#include "LogBuffer.h"
+#include "JobSystem.h"
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <emmintrin.h>
+
+namespace {
+
+// 再帰で Joint を追加する。自身の Index を返す
+int32_t AddJoint(const Node& node, int32_t parent, Skeleton& skeleton) {
+    const int32_t index = static_cast<int32_t>(skeleton.parents.size()); // 現在の末尾Index
+    skeleton.parents.push_back(parent);
+    skeleton.transforms.push_back(node.transform);
+    skeleton.localMatrices.push_back(node.localMatrix);
+    skeleton.skeletonSpaceMatrices.push_back(MakeIdentity4x4());
+    skeleton.names.push_back(node.name);
+
+    // 子Jointを再帰的に作る（前順なので子は必ず親より後ろ）
+    for (const Node& child : node.children) {
+        AddJoint(child, index, skeleton);
+    }
+    return index;
+}
+
+// S・R(Quaternion)・T からローカル行列を直接組み立てる（MakeAffineMatrix の S×R×T と同じ値、行列積 2 回を省く）
+void ComposeLocalMatrix(const QuaternionTransform& t, Matrix4x4& out) {
+    const Quaternion& q = t.rotate;
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    out.m[0][0] = t.scale.x * (1.0f - 2.0f * (yy + zz));
+    out.m[0][1] = t.scale.x * (2.0f * (xy + wz));
+    out.m[0][2] = t.scale.x * (2.0f * (xz - wy));
+    out.m[0][3] = 0.0f;
+    out.m[1][0] = t.scale.y * (2.0f * (xy - wz));
+    out.m[1][1] = t.scale.y * (1.0f - 2.0f * (xx + zz));
+    out.m[1][2] = t.scale.y * (2.0f * (yz + wx));
+    out.m[1][3] = 0.0f;
+    out.m[2][0] = t.scale.z * (2.0f * (xz + wy));
+    out.m[2][1] = t.scale.z * (2.0f * (yz - wx));
+    out.m[2][2] = t.scale.z * (1.0f - 2.0f * (xx + yy));
+    out.m[2][3] = 0.0f;
+    out.m[3][0] = t.translate.x;
+    out.m[3][1] = t.translate.y;
+    out.m[3][2] = t.translate.z;
+    out.m[3][3] = 1.0f;
+}
+
+// out = a × b（行ベクトル規約）。b の 4 行を SSE レジスタに載せ、a の各行の成分でスカラー倍して足し込む
+void MultiplySse(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& out) {
+    const __m128 b0 = _mm_loadu_ps(b.m[0]);
+    const __m128 b1 = _mm_loadu_ps(b.m[1]);
+    const __m128 b2 = _mm_loadu_ps(b.m[2]);
+    const __m128 b3 = _mm_loadu_ps(b.m[3]);
+    for (int r = 0; r < 4; ++r) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a.m[r][0]), b0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[r][1]), b1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[r][2]), b2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[r][3]), b3));
+        _mm_storeu_ps(out.m[r], row);
+    }
+}
+
+} // namespace
 
 Skeleton CreateSkeleton(const Node& rootNode) {
     Skeleton skeleton;
-    skeleton.root = CreateJoint(rootNode, std::nullopt, skeleton.joints);
+    skeleton.root = AddJoint(rootNode, -1, skeleton);
 
     // 名前 → Index のマップを作る
-    for (const Joint& joint : skeleton.joints) {
-        skeleton.jointMap.emplace(joint.name, joint.index);
+    skeleton.jointMap.reserve(skeleton.names.size());
+    for (size_t i = 0; i < skeleton.names.size(); ++i) {
+        skeleton.jointMap.emplace(skeleton.names[i], static_cast<int32_t>(i));
     }
 
     // 初期状態を更新しておく
@@ -18,56 +89,68 @@ Skeleton CreateSkeleton(const Node& rootNode) {
     return skeleton;
 }
 
-int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent,
-    std::vector<Joint>& joints) {
-    Joint joint;
-    joint.name = node.name;
-    joint.localMatrix = node.localMatrix;
-    joint.skeletonSpaceMatrix = MakeIdentity4x4();
-    joint.transform = node.transform;
-    joint.index = static_cast<int32_t>(joints.size()); // 現在の末尾Index
-    joint.parent = parent;
-    joints.push_back(joint);
-
-    // 子Jointを再帰的に作る
-    for (const Node& child : node.children) {
-        int32_t childIndex = CreateJoint(child, joint.index, joints);
-        joints[joint.index].children.push_back(childIndex);
-    }
-
-    return joint.index;
-}
-
 void UpdateSkeleton(Skeleton& skeleton) {
-    // 親が必ず先に来るように構築されているため、配列を先頭から舐めるだけでOK
-    for (Joint& joint : skeleton.joints) {
-        joint.localMatrix = MakeAffineMatrix(
-            joint.transform.scale,
-            joint.transform.rotate,
-            joint.transform.translate);
+    // 親が必ず先に来るので、配列を先頭から 1 回舐めるだけで親の skeletonSpace は計算済み
+    const size_t count = skeleton.parents.size();
+    const int32_t* parents = skeleton.parents.data();
+    const QuaternionTransform* transforms = skeleton.transforms.data();
+    Matrix4x4* locals = skeleton.localMatrices.data();
+    Matrix4x4* models = skeleton.skeletonSpaceMatrices.data();
 
-        if (joint.parent) {
+    for (size_t i = 0; i < count; ++i) {
+        ComposeLocalMatrix(transforms[i], locals[i]);
+        const int32_t parent = parents[i];
+        if (parent >= 0) {
             // 親があれば 自分のlocal × 親のskeletonSpace
-            joint.skeletonSpaceMatrix = Multiply(
-                joint.localMatrix,
-                skeleton.joints[*joint.parent].skeletonSpaceMatrix);
+            assert(static_cast<size_t>(parent) < i);
+            MultiplySse(locals[i], models[parent], models[i]);
         } else {
             // 親がなければ skeletonSpaceMatrix = localMatrix
-            joint.skeletonSpaceMatrix = joint.localMatrix;
+            models[i] = locals[i];
         }
     }
 }
 
+void BindAnimationSampler(AnimationSampler& sampler, const Skeleton& skeleton, const Animation& animation) {
+    if (sampler.bound && sampler.skeleton == &skeleton && sampler.clipId == animation.clipId
+        && sampler.jointChannels.size() == skeleton.JointCount()) {
+        return;
+    }
+
+    // joint 名 → チャンネル index をここで一度だけ引いておく
+    sampler.skeleton = &skeleton;
+    sampler.clipId = animation.clipId;
+    sampler.jointChannels.resize(skeleton.JointCount());
+    for (size_t i = 0; i < skeleton.JointCount(); ++i) {
+        sampler.jointChannels[i] = animation.FindChannel(skeleton.names[i]);
+    }
+    sampler.cursors.assign(animation.channels.size(), KeyframeCursor{});
+    sampler.bound = true;
+}
+
+namespace {
+
+// 1 チャンネルを cursor 付きで評価して out に書く
+void SampleChannel(const NodeAnimation& nodeAnim, float time, KeyframeCursor& cursor, QuaternionTransform& out) {
+    out.translate = CalculateValue(nodeAnim.translate.keyframes, time, cursor.translate);
+    out.rotate    = CalculateValue(nodeAnim.rotate.keyframes, time, cursor.rotate);
+    out.scale     = CalculateValue(nodeAnim.scale.keyframes, time, cursor.scale);
+}
+
+} // namespace
+
 void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime) {
-    for (Joint& joint : skeleton.joints) {
-        // C++17の初期化付きif
-        if (auto it = animation.nodeAnimations.find(joint.name);
-            it != animation.nodeAnimations.end()) {
-            const NodeAnimation& nodeAnim = it->second;
-            joint.transform.translate = CalculateValue(nodeAnim.translate.keyframes, animationTime);
-            joint.transform.rotate = CalculateValue(nodeAnim.rotate.keyframes, animationTime);
-            joint.transform.scale = CalculateValue(nodeAnim.scale.keyframes, animationTime);
-        }
+    AnimationSampler sampler;
+    ApplyAnimation(skeleton, animation, animationTime, sampler);
+}
+
+void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime,
+    AnimationSampler& sampler) {
+    BindAnimationSampler(sampler, skeleton, animation);
+    for (size_t i = 0; i < skeleton.JointCount(); ++i) {
+        const int32_t channel = sampler.jointChannels[i];
+        if (channel < 0) continue;
+        SampleChannel(animation.channels[channel], animationTime, sampler.cursors[channel], skeleton.transforms[i]);
     }
 }
 
@@ -75,32 +158,392 @@ void ApplyAnimationBlended(Skeleton& skeleton,
     const Animation& a, float timeA,
     const Animation& b, float timeB,
     float weight)
+{
+    AnimationSampler samplerA;
+    AnimationSampler samplerB;
+    ApplyAnimationBlended(skeleton, a, timeA, samplerA, b, timeB, samplerB, weight);
+}
+
+void ApplyAnimationBlended(Skeleton& skeleton,
+    const Animation& a, float timeA, AnimationSampler& samplerA,
+    const Animation& b, float timeB, AnimationSampler& samplerB,
+    float weight)
 {
     // weight を [0, 1] に拘束
     if (weight < 0.0f) weight = 0.0f;
     if (weight > 1.0f) weight = 1.0f;
 
-    for (Joint& joint : skeleton.joints) {
+    BindAnimationSampler(samplerA, skeleton, a);
+    BindAnimationSampler(samplerB, skeleton, b);
+
+    for (size_t i = 0; i < skeleton.JointCount(); ++i) {
+        QuaternionTransform& transform = skeleton.transforms[i];
+
         // a 側: 無ければ現在の transform をそのまま使う
-        QuaternionTransform va = joint.transform;
-        if (auto it = a.nodeAnimations.find(joint.name); it != a.nodeAnimations.end()) {
-            const NodeAnimation& na = it->second;
-            va.translate = CalculateValue(na.translate.keyframes, timeA);
-            va.rotate    = CalculateValue(na.rotate.keyframes, timeA);
-            va.scale     = CalculateValue(na.scale.keyframes, timeA);
+        QuaternionTransform va = transform;
+        if (const int32_t ca = samplerA.jointChannels[i]; ca >= 0) {
+            SampleChannel(a.channels[ca], timeA, samplerA.cursors[ca], va);
         }
 
         // b 側
         QuaternionTransform vb = va;  // a を初期値にしておけば、b 側に無いキーは a を維持
-        if (auto it = b.nodeAnimations.find(joint.name); it != b.nodeAnimations.end()) {
-            const NodeAnimation& nb = it->second;
-            vb.translate = CalculateValue(nb.translate.keyframes, timeB);
-            vb.rotate    = CalculateValue(nb.rotate.keyframes, timeB);
-            vb.scale     = CalculateValue(nb.scale.keyframes, timeB);
+        if (const int32_t cb = samplerB.jointChannels[i]; cb >= 0) {
+            SampleChannel(b.channels[cb], timeB, samplerB.cursors[cb], vb);
         }
 
-        joint.transform.translate = Lerp(va.translate, vb.translate, weight);
-        joint.transform.rotate    = Slerp(va.rotate,    vb.rotate,    weight);
-        joint.transform.scale     = Lerp(va.scale,     vb.scale,     weight);
+        transform.translate = Lerp(va.translate, vb.translate, weight);
+        transform.rotate    = Slerp(va.rotate,    vb.rotate,    weight);
+        transform.scale     = Lerp(va.scale,     vb.scale,     weight);
+    }
+}
+
+namespace {
+
+// ----- ベンチマーク用の旧経路（名前検索＋先頭からのキー走査） -----
+template <typename tValue, typename tInterp>
+tValue SampleLinearScan(const std::vector<Keyframe<tValue>>& keyframes, float time, tInterp interp) {
+    if (keyframes.size() == 1 || time <= keyframes[0].time) {
+        return keyframes[0].value;
     }
-}
\ No newline at end of file
+    for (size_t index = 0; index < keyframes.size() - 1; ++index) {
+        size_t nextIndex = index + 1;
+        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
+            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
+            return interp(keyframes[index].value, keyframes[nextIndex].value, t);
+        }
+    }
+    return (*keyframes.rbegin()).value;
+}
+
+void ApplyAnimationLinearScan(Skeleton& skeleton, const Animation& animation, float time) {
+    auto lerp3 = [](const Vector3& a, const Vector3& b, float t) { return Lerp(a, b, t); };
+    auto slerp = [](const Quaternion& a, const Quaternion& b, float t) { return Slerp(a, b, t); };
+    for (size_t i = 0; i < skeleton.JointCount(); ++i) {
+        if (auto it = animation.channelIndex.find(skeleton.names[i]); it != animation.channelIndex.end()) {
+            const NodeAnimation& nodeAnim = animation.channels[it->second];
+            QuaternionTransform& transform = skeleton.transforms[i];
+            transform.translate = SampleLinearScan(nodeAnim.translate.keyframes, time, lerp3);
+            transform.rotate    = SampleLinearScan(nodeAnim.rotate.keyframes, time, slerp);
+            transform.scale     = SampleLinearScan(nodeAnim.scale.keyframes, time, lerp3);
+        }
+    }
+}
+
+bool SamePose(const Skeleton& a, const Skeleton& b) {
+    const float kEps = 1e-4f;
+    auto near = [kEps](float x, float y) { return std::abs(x - y) < kEps; };
+    for (size_t i = 0; i < a.JointCount(); ++i) {
+        const QuaternionTransform& p = a.transforms[i];
+        const QuaternionTransform& q = b.transforms[i];
+        if (!near(p.translate.x, q.translate.x) || !near(p.translate.y, q.translate.y) || !near(p.translate.z, q.translate.z)
+            || !near(p.rotate.x, q.rotate.x) || !near(p.rotate.y, q.rotate.y) || !near(p.rotate.z, q.rotate.z) || !near(p.rotate.w, q.rotate.w)
+            || !near(p.scale.x, q.scale.x) || !near(p.scale.y, q.scale.y) || !near(p.scale.z, q.scale.z)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 二分木状の骨（親が必ず先に来る）
+Skeleton MakeBenchmarkSkeleton(int jointCount) {
+    Skeleton skeleton{};
+    skeleton.root = 0;
+    for (int i = 0; i < jointCount; ++i) {
+        skeleton.parents.push_back(i > 0 ? (i - 1) / 2 : -1);
+        skeleton.transforms.push_back({ { 1.0f, 1.0f, 1.0f }, IdentityQuaternion(), { 0.0f, 0.0f, 0.0f } });
+        skeleton.localMatrices.push_back(MakeIdentity4x4());
+        skeleton.skeletonSpaceMatrices.push_back(MakeIdentity4x4());
+        skeleton.names.push_back("joint_" + std::to_string(i));
+        skeleton.jointMap.emplace(skeleton.names.back(), i);
+    }
+    return skeleton;
+}
+
+// 30fps のランダムなキーを持つクリップ。最後の 1 本の骨にはチャンネルを作らない
+Animation MakeBenchmarkClip(int jointCount, int keyCount, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    Animation clip{};
+    clip.duration = static_cast<float>(keyCount - 1) / 30.0f;
+    for (int j = 0; j < jointCount - 1; ++j) {
+        NodeAnimation& na = clip.AddChannel("joint_" + std::to_string(j));
+        na.translate.keyframes.resize(keyCount);
+        na.rotate.keyframes.resize(keyCount);
+        na.scale.keyframes.resize(keyCount);
+        for (int k = 0; k < keyCount; ++k) {
+            const float t = static_cast<float>(k) / 30.0f;
+            na.translate.keyframes[k] = { t, { unit(rng), unit(rng), unit(rng) } };
+            na.rotate.keyframes[k] = { t, Normalize(Quaternion{ unit(rng), unit(rng), unit(rng), unit(rng) + 2.0f }) };
+            na.scale.keyframes[k] = { t, { 1.0f + 0.1f * unit(rng), 1.0f, 1.0f } };
+        }
+    }
+    clip.clipId = IssueAnimationClipId();
+    return clip;
+}
+
+} // namespace
+
+void RunAnimationSamplingBenchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    const int kJointCount = 60;
+    const int kInstanceCount = 32;
+    const int kFrames = 240;
+    const float kDeltaTime = 1.0f / 60.0f;
+    const int kKeyCounts[] = { 300, 3000, 12000 }; // 30fps で 10 秒 / 100 秒 / 400 秒
+
+    const Skeleton skeleton = MakeBenchmarkSkeleton(kJointCount);
+
+    LogBuffer::Instance().Add("[Animation] Sampling benchmark (name lookup + linear scan vs sampler + cursor)");
+    for (int keyCount : kKeyCounts) {
+        std::mt19937 rng(static_cast<uint32_t>(keyCount) * 31u);
+        const Animation clip = MakeBenchmarkClip(kJointCount, keyCount, static_cast<uint32_t>(keyCount));
+
+        // インスタンスごとに再生位置をずらし、各インスタンスが 97 フレームに 1 回シークする
+        std::vector<float> startTimes(kInstanceCount);
+        std::uniform_real_distribution<float> phase(0.0f, clip.duration);
+        for (float& t : startTimes) t = phase(rng);
+        std::vector<std::vector<float>> times(kFrames, std::vector<float>(kInstanceCount));
+        for (int i = 0; i < kInstanceCount; ++i) {
+            float t = startTimes[i];
+            for (int f = 0; f < kFrames; ++f) {
+                t = std::fmod(t + kDeltaTime, clip.duration);
+                if ((f + i) % 97 == 0) t = phase(rng);
+                times[f][i] = t;
+            }
+        }
+
+        std::vector<Skeleton> refPoses(kInstanceCount, skeleton);
+        std::vector<Skeleton> fastPoses(kInstanceCount, skeleton);
+        std::vector<AnimationSampler> samplers(kInstanceCount);
+
+        bool match = true;
+        double refMs = 0.0, fastMs = 0.0;
+        for (int f = 0; f < kFrames; ++f) {
+            const auto t0 = Clock::now();
+            for (int i = 0; i < kInstanceCount; ++i) {
+                ApplyAnimationLinearScan(refPoses[i], clip, times[f][i]);
+            }
+            const auto t1 = Clock::now();
+            for (int i = 0; i < kInstanceCount; ++i) {
+                ApplyAnimation(fastPoses[i], clip, times[f][i], samplers[i]);
+            }
+            const auto t2 = Clock::now();
+            refMs  += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            fastMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+            for (int i = 0; match && i < kInstanceCount; ++i) {
+                match = SamePose(refPoses[i], fastPoses[i]);
+            }
+        }
+
+        refMs /= kFrames;
+        fastMs /= kFrames;
+        char buf[192];
+        std::snprintf(buf, sizeof(buf),
+            "[Animation] keys=%5d x%d inst  scan %.3f ms/frame  cursor %.3f ms/frame  (x%.1f)  %s",
+            keyCount, kInstanceCount, refMs, fastMs, (fastMs > 0.0) ? refMs / fastMs : 0.0,
+            match ? "match" : "MISMATCH");
+        LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    }
+}
+
+void RunPoseEvaluationBenchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    const int kJointCount = 65;
+    const int kKeyCount = 1800;
+    const int kFrames = 30;
+    const float kDeltaTime = 1.0f / 60.0f;
+    const int kInstanceCounts[] = { 50, 100, 200 };
+
+    const Skeleton skeleton = MakeBenchmarkSkeleton(kJointCount);
+    const Animation clip = MakeBenchmarkClip(kJointCount, kKeyCount, 2024u);
+
+    // インスタンス 1 体ぶんの状態（AnimatedObject3DInstance::Update の姿勢計算部分と同じ書き込み先の分け方）
+    struct PoseInstance {
+        Skeleton skeleton;
+        AnimationSampler sampler;
+        float time = 0.0f;
+        std::vector<Matrix4x4> inverseBind;
+        std::vector<Matrix4x4> palette;      // SkinCluster::mappedPalette 相当（行列 + 逆転置）
+    };
+    auto evaluate = [&](PoseInstance& inst) {
+        inst.time = std::fmod(inst.time + kDeltaTime, clip.duration);
+        ApplyAnimation(inst.skeleton, clip, inst.time, inst.sampler);
+        UpdateSkeleton(inst.skeleton);
+        for (size_t j = 0; j < inst.skeleton.JointCount(); ++j) {
+            const Matrix4x4 m = Multiply(inst.inverseBind[j], inst.skeleton.skeletonSpaceMatrices[j]);
+            inst.palette[2 * j] = m;
+            inst.palette[2 * j + 1] = Transpose(Inverse(m));
+        }
+    };
+    auto makeInstances = [&](int count) {
+        std::vector<PoseInstance> instances(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            PoseInstance& inst = instances[i];
+            inst.skeleton = skeleton;
+            inst.time = clip.duration * static_cast<float>(i) / static_cast<float>(count);
+            inst.inverseBind.assign(skeleton.JointCount(), MakeIdentity4x4());
+            inst.palette.assign(skeleton.JointCount() * 2, MakeIdentity4x4());
+        }
+        return instances;
+    };
+
+    JobSystem* jobs = JobSystem::GetInstance();
+    if (!jobs->IsInitialized()) jobs->Initialize();
+    const uint32_t maxThreads = jobs->GetWorkerCount() + 1;
+
+    // 1, 2, 4, ... と使える全スレッド
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    char buf[192];
+    std::snprintf(buf, sizeof(buf), "[Animation] Pose evaluation benchmark (%d joints, %u threads available)",
+        kJointCount, maxThreads);
+    LogBuffer::Instance().Add(buf);
+    for (int count : kInstanceCounts) {
+        // 直列の結果を正解にする
+        std::vector<PoseInstance> reference = makeInstances(count);
+        double serialMs = 0.0;
+        for (int f = 0; f < kFrames; ++f) {
+            const auto t0 = Clock::now();
+            for (PoseInstance& inst : reference) evaluate(inst);
+            serialMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        }
+        serialMs /= kFrames;
+
+        std::string line;
+        bool match = true;
+        for (uint32_t threads : threadCounts) {
+            std::vector<PoseInstance> instances = makeInstances(count);
+            double ms = 0.0;
+            for (int f = 0; f < kFrames; ++f) {
+                const auto t0 = Clock::now();
+                jobs->ParallelFor(static_cast<uint32_t>(count), 1, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i) evaluate(instances[i]);
+                }, threads);
+                ms += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            }
+            ms /= kFrames;
+            for (int i = 0; match && i < count; ++i) {
+                match = std::memcmp(instances[i].palette.data(), reference[i].palette.data(),
+                    reference[i].palette.size() * sizeof(Matrix4x4)) == 0;
+            }
+            std::snprintf(buf, sizeof(buf), "  %ut %.2fms (x%.1f)", threads, ms, (ms > 0.0) ? serialMs / ms : 0.0);
+            line += buf;
+        }
+
+        std::snprintf(buf, sizeof(buf), "[Animation] %3d skeletons  serial %.2f ms |", count, serialMs);
+        LogBuffer::Instance().Add(std::string(buf) + line + (match ? "  match" : "  MISMATCH"),
+            match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    }
+}
+
+namespace {
+
+// ----- ベンチマーク用の旧レイアウト（Joint 構造体の配列。名前・子リストが姿勢データと同じ行に並ぶ） -----
+struct LegacyJoint {
+    QuaternionTransform transform;
+    Matrix4x4 localMatrix;
+    Matrix4x4 skeletonSpaceMatrix;
+    std::string name;
+    std::vector<int32_t> children;
+    int32_t index;
+    std::optional<int32_t> parent;
+};
+
+std::vector<LegacyJoint> MakeLegacyJoints(const Skeleton& skeleton) {
+    std::vector<LegacyJoint> joints(skeleton.JointCount());
+    for (size_t i = 0; i < joints.size(); ++i) {
+        LegacyJoint& joint = joints[i];
+        joint.transform = skeleton.transforms[i];
+        joint.localMatrix = skeleton.localMatrices[i];
+        joint.skeletonSpaceMatrix = skeleton.skeletonSpaceMatrices[i];
+        joint.name = skeleton.names[i];
+        joint.index = static_cast<int32_t>(i);
+        if (skeleton.parents[i] >= 0) {
+            joint.parent = skeleton.parents[i];
+            joints[skeleton.parents[i]].children.push_back(joint.index);
+        }
+    }
+    return joints;
+}
+
+// 旧 UpdateSkeleton（MakeAffineMatrix で S×R×T を行列積 2 回で作り、親の行列と掛ける）
+void UpdateLegacyJoints(std::vector<LegacyJoint>& joints) {
+    for (LegacyJoint& joint : joints) {
+        joint.localMatrix = MakeAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
+        if (joint.parent) {
+            joint.skeletonSpaceMatrix = Multiply(joint.localMatrix, joints[*joint.parent].skeletonSpaceMatrix);
+        } else {
+            joint.skeletonSpaceMatrix = joint.localMatrix;
+        }
+    }
+}
+
+} // namespace
+
+void RunSkeletonLayoutBenchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    const int kKeyCount = 600;
+    const int kFrames = 60;
+    const float kDeltaTime = 1.0f / 60.0f;
+    const int kJointCounts[] = { 65, 150 };
+    const int kSkeletonCount = 100;
+
+    LogBuffer::Instance().Add("[Animation] Skeleton layout benchmark (Joint AoS vs flat SoA)");
+    for (int jointCount : kJointCounts) {
+        const Skeleton source = MakeBenchmarkSkeleton(jointCount);
+        const Animation clip = MakeBenchmarkClip(jointCount, kKeyCount, 7u);
+
+        // 両レイアウトに同じ姿勢を流し込んでから UpdateSkeleton 部分だけを計る
+        std::vector<Skeleton> flat(kSkeletonCount, source);
+        std::vector<std::vector<LegacyJoint>> legacy(kSkeletonCount, MakeLegacyJoints(source));
+        std::vector<AnimationSampler> samplers(kSkeletonCount);
+
+        double flatMs = 0.0;
+        double legacyMs = 0.0;
+        float maxError = 0.0f;
+        for (int f = 0; f < kFrames; ++f) {
+            for (int s = 0; s < kSkeletonCount; ++s) {
+                const float time = std::fmod(kDeltaTime * static_cast<float>(f + s * 13), clip.duration);
+                ApplyAnimation(flat[s], clip, time, samplers[s]);
+                for (size_t j = 0; j < flat[s].JointCount(); ++j) {
+                    legacy[s][j].transform = flat[s].transforms[j];
+                }
+            }
+
+            auto t0 = Clock::now();
+            for (Skeleton& skeleton : flat) UpdateSkeleton(skeleton);
+            flatMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            t0 = Clock::now();
+            for (std::vector<LegacyJoint>& joints : legacy) UpdateLegacyJoints(joints);
+            legacyMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            // 行列積の組み立て順が違うので完全一致ではなく、行列の大きさに対する相対誤差で比べる
+            for (int s = 0; s < kSkeletonCount; ++s) {
+                for (size_t j = 0; j < flat[s].JointCount(); ++j) {
+                    const Matrix4x4& a = flat[s].skeletonSpaceMatrices[j];
+                    const Matrix4x4& b = legacy[s][j].skeletonSpaceMatrix;
+                    for (int r = 0; r < 4; ++r) {
+                        for (int c = 0; c < 4; ++c) {
+                            const float error = std::abs(a.m[r][c] - b.m[r][c]) / (1.0f + std::abs(b.m[r][c]));
+                            if (error > maxError) maxError = error;
+                        }
+                    }
+                }
+            }
+        }
+        flatMs /= kFrames;
+        legacyMs /= kFrames;
+
+        const bool match = maxError < 1e-4f;
+        char buf[192];
+        std::snprintf(buf, sizeof(buf),
+            "[Animation] %3d joints x %d  legacy %.3f ms  flat %.3f ms (x%.2f)  max rel err %.2e  %s",
+            jointCount, kSkeletonCount, legacyMs, flatMs, (flatMs > 0.0) ? legacyMs / flatMs : 0.0,
+            maxError, match ? "match" : "MISMATCH");
+        LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    }
+}
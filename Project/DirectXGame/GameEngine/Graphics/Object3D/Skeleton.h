@@ -2,46 +2,69 @@
 #include "Matrix4x4.h"
 #include "QuaternionTransform.h"
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <string>
-#include <optional>
 #include <cstdint>
 
 // 前方宣言
 struct Node;
 struct Animation;
+struct KeyframeCursor;
 
-// 1本の骨
-struct Joint {
-    QuaternionTransform transform;          // SRT
-    Matrix4x4 localMatrix;                  // ローカル行列
-    Matrix4x4 skeletonSpaceMatrix;          // Skeleton空間への変換行列
-    std::string name;                       // 名前
-    std::vector<int32_t> children;          // 子のIndex
-    int32_t index;                          // 自身のIndex
-    std::optional<int32_t> parent;          // 親のIndex（無ければnullopt）
-};
-
-// 骨の集合
+/// <summary>
+/// 骨の集合（ランタイム用の平坦なレイアウト）。
+/// joint index i の情報は各配列の i 番目にあり、親は必ず子より前に並ぶ（parents[i] < i）。
+/// 毎フレーム触る SRT・ローカル行列・Skeleton 空間行列は別々の配列に分け、名前などの文字列は持たせない。
+/// UpdateSkeleton は先頭から 1 回舐めるだけで階層を解決できる。
+/// </summary>
 struct Skeleton {
-    int32_t root;                           // RootJointのIndex
-    std::map<std::string, int32_t> jointMap;// 名前→Indexの辞書
-    std::vector<Joint> joints;              // 全Joint
+    int32_t root = 0;                                 // RootJointのIndex（常に 0）
+
+    // ----- 姿勢計算で毎フレーム触るデータ -----
+    std::vector<int32_t> parents;                     // 親のIndex（root は -1）
+    std::vector<QuaternionTransform> transforms;      // ローカル SRT（ApplyAnimation の書き込み先）
+    std::vector<Matrix4x4> localMatrices;             // ローカル行列
+    std::vector<Matrix4x4> skeletonSpaceMatrices;     // Skeleton空間への変換行列
+
+    // ----- 名前引き・表示用（毎フレームは触らない） -----
+    std::vector<std::string> names;                   // 名前
+    std::unordered_map<std::string, int32_t> jointMap;// 名前→Indexの辞書
+
+    size_t JointCount() const { return parents.size(); }
 };
 
-// Nodeの階層からSkeletonを構築する
+// Nodeの階層からSkeletonを構築する（深さ優先の前順＝親が先）
 Skeleton CreateSkeleton(const Node& rootNode);
 
-// 再帰でJointを作りjointsに登録する。自身のIndexを返す
-int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent,
-    std::vector<Joint>& joints);
-
 // Skeleton全体のlocalMatrix・skeletonSpaceMatrixを更新する
 void UpdateSkeleton(Skeleton& skeleton);
 
-// SkeletonにAnimationを適用する（Joint.transformに値を流し込む）
+/// <summary>
+/// インスタンスごとのアニメーション再生状態。クリップのチャンネルを joint index に一度だけ解決した表と、
+/// チャンネルごとのキーフレームカーソルを持つ。クリップ（Animation::clipId）か Skeleton が変わったときだけ
+/// 解決し直すので、毎フレームの名前検索・先頭からのキー走査が無くなる。
+/// </summary>
+struct AnimationSampler {
+    const Skeleton* skeleton = nullptr;     // バインド先
+    uint32_t clipId = 0;                    // バインド済みクリップ
+    bool bound = false;
+    std::vector<int32_t> jointChannels;     // joint index → channel index（-1 ならチャンネル無し）
+    std::vector<KeyframeCursor> cursors;    // channel index ごと
+
+    // 次の Apply で必ず解決し直す
+    void Reset() { bound = false; }
+};
+
+// skeleton / animation と食い違っていれば sampler を解決し直す（一致していれば何もしない）
+void BindAnimationSampler(AnimationSampler& sampler, const Skeleton& skeleton, const Animation& animation);
+
+// SkeletonにAnimationを適用する（Skeleton::transformsに値を流し込む）
 void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime);
 
+// sampler のバインドとカーソルを使って適用する（毎フレーム呼ぶ経路はこちら）
+void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime,
+    AnimationSampler& sampler);
+
 /// <summary>
 /// 2つのアニメーションをブレンドして適用する（クロスフェード用）。
 /// weight: 0.0 で a そのまま、1.0 で b そのまま。translate/scale は Lerp、rotate は Slerp。
@@ -49,4 +72,28 @@ void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animat
 void ApplyAnimationBlended(Skeleton& skeleton,
     const Animation& a, float timeA,
     const Animation& b, float timeB,
-    float weight);
\ No newline at end of file
+    float weight);
+
+// sampler 付きのブレンド適用（samplerA は a 用、samplerB は b 用）
+void ApplyAnimationBlended(Skeleton& skeleton,
+    const Animation& a, float timeA, AnimationSampler& samplerA,
+    const Animation& b, float timeB, AnimationSampler& samplerB,
+    float weight);
+
+/// <summary>
+/// 長いクリップ（60 ジョイント×数千キー）を複数インスタンスで再生したときの、旧経路（名前検索＋先頭からのキー走査）と
+/// AnimationSampler 経路の姿勢の一致と 1 フレームあたりの時間を LogBuffer に出す。
+/// </summary>
+void RunAnimationSamplingBenchmark();
+
+/// <summary>
+/// 50〜200 体ぶんの姿勢計算（サンプリング → UpdateSkeleton → パレット生成）を、直列と JobSystem の
+/// スレッド数違いで回して 1 フレームあたりの時間・倍率と、直列との結果一致を LogBuffer に出す。
+/// </summary>
+void RunPoseEvaluationBenchmark();
+
+/// <summary>
+/// 旧レイアウト（Joint 構造体の配列）と平坦な SoA レイアウトで UpdateSkeleton の時間を比べ、
+/// 両者の Skeleton 空間行列が一致するか（相対誤差 1e-4 以内）を LogBuffer に出す。
+/// </summary>
+void RunSkeletonLayoutBenchmark();
@@ -28,7 +28,7 @@ SkinCluster CreateSkinCluster(
     skinCluster.numVertices = numVertices;
 
     // DStorage 経路では palette / IBM を .skel 順にして影響度バッファ (.mesh の skin
-    // セクション = .skel index 参照) と一致させる。skeleton.joints は CreateSkeleton の
+    // セクション = .skel index 参照) と一致させる。skeleton の joint 順は CreateSkeleton の
     // DFS で別順になるため、skel-index → skeleton-index の remap を作って毎フレームの
     // palette 更新時に lookup する。
     const auto& jointNames = model->GetJointNames();
@@ -42,7 +42,7 @@ SkinCluster CreateSkinCluster(
     }
     const size_t paletteCount = !skinCluster.jointSkelToSkeletonRemap.empty()
         ? skinCluster.jointSkelToSkeletonRemap.size()
-        : skeleton.joints.size();
+        : skeleton.JointCount();
 
     // ===== palette用Resource (UPLOAD heap, 毎フレーム CPU から書く) =====
     skinCluster.paletteResource = dxCore->CreateBufferResource(
@@ -86,7 +86,7 @@ SkinCluster CreateSkinCluster(
         if (model->HasSkinning()) {
             uint64_t packOffset = 0, packSize = 0;
             AssetLocator::GetInstance()->GetPackEntryInfo(
-                model->GetMeshFilePath(), packOffset, packSize);
+                model->GetMeshAssetId(), packOffset, packSize);
             auto* ds = DStorageManager::GetInstance();
             ds->EnqueueBufferRead(ds->GetPackFile(),
                 packOffset + model->GetSkinFileOffset(),
@@ -200,18 +200,18 @@ SkinCluster CreateSkinCluster(
 void UpdateSkinCluster(SkinCluster& skinCluster, const Skeleton& skeleton)
 {
     const auto& remap = skinCluster.jointSkelToSkeletonRemap;
-    const size_t count = !remap.empty() ? remap.size() : skeleton.joints.size();
+    const size_t count = !remap.empty() ? remap.size() : skeleton.JointCount();
 
     for (size_t i = 0; i < count; ++i) {
         // remap がある場合は palette[i] が .skel index i に対応し、
-        // 対応する skeleton.joints のアニメ済み skeletonSpaceMatrix を引いてくる。
+        // 対応する skeleton.skeletonSpaceMatrices のアニメ済み行列を引いてくる。
         const size_t skeletonIdx = !remap.empty() ? static_cast<size_t>(remap[i]) : i;
-        if (skeletonIdx >= skeleton.joints.size()) continue;
+        if (skeletonIdx >= skeleton.JointCount()) continue;
 
         // T_i = B_i^-1 * S_i
         skinCluster.mappedPalette[i].skeletonSpaceMatrix = Multiply(
             skinCluster.inverseBindPoseMatrices[i],
-            skeleton.joints[skeletonIdx].skeletonSpaceMatrix);
+            skeleton.skeletonSpaceMatrices[skeletonIdx]);
 
         // 法線用：InverseTranspose
         skinCluster.mappedPalette[i].skeletonSpaceInverseTransposeMatrix =
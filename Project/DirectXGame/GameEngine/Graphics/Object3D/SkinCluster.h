@@ -75,10 +75,10 @@ struct SkinCluster {
     // 描画用の頂点数（Dispatch計算に利用）
     uint32_t numVertices = 0;
 
-    // skel-index → skeleton.joints index の remap テーブル。
+    // skel-index → skeleton の joint index の remap テーブル。
     // 非空なら palette / IBM は .skel 順 (= .mesh の影響度 joint インデックスと一致) で
     // インデックスされ、UpdateSkinCluster はこの remap で skeleton 側の matrix を引く。
-    // 空なら従来の skeleton.joints 順 indexing。
+    // 空なら従来の skeleton の joint 順 indexing。
     std::vector<int32_t> jointSkelToSkeletonRemap;
 };
 
@@ -7,8 +7,8 @@ void SpringBone::Initialize(const Skeleton& skeleton, const std::string& rootBon
     params_ = params;
 
     // Phase 1 で実装：
-    //   rootBoneName を起点に Skeleton.joints を再帰収集し、
-    //   particles_ / jointIndices_ を構築する（poseLocation は skeletonSpaceMatrix から）。
+    //   rootBoneName を起点に Skeleton.parents を辿って子孫を収集し、
+    //   particles_ / jointIndices_ を構築する（poseLocation は skeletonSpaceMatrices から）。
     (void)skeleton;
     (void)rootBoneName;
     initialized_ = false;
@@ -21,7 +21,7 @@ void SpringBone::Update(Skeleton& skeleton, float dt)
     }
 
     // Phase 2-3 で実装：
-    //   1. skeletonSpaceMatrix から各質点の poseLocation を読む
+    //   1. skeletonSpaceMatrices から各質点の poseLocation を読む
     //   2. solver_.Step(particles_, params_, colliders_, dt)
     //   3. 揺れた location から各親ジョイントのローカル回転を逆算し書き戻す
     (void)skeleton;
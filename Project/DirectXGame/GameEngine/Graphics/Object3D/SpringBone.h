@@ -33,7 +33,7 @@ public:
 
 private:
     std::vector<VerletParticle> particles_;     // シミュ対象の質点列
-    std::vector<int32_t>        jointIndices_;  // particle index -> Skeleton.joints の index
+    std::vector<int32_t>        jointIndices_;  // particle index -> Skeleton の joint index
     std::vector<SphereCollider> colliders_;
     VerletParams                params_;
     VerletSolver                solver_;
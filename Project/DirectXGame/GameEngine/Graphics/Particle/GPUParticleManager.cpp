@@ -9,6 +9,7 @@
 #include "PepperMacros.h"
 #include <cassert>
 #include <algorithm>
+#include <cstring>
 
 #ifdef USE_IMGUI
 #include "imgui.h"
@@ -30,15 +31,27 @@ void GPUParticleManager::Initialize(DirectXCore* dxCore, SRVManager* srvManager)
 
 void GPUParticleManager::Finalize()
 {
-    for (auto& g : previewGroupPendingDelete_) {
-        ReleaseGroupResources(g);
+    for (uint32_t slot : previewGroupPendingDelete_) {
+        ReleaseGroupResources(groups_.At(slot));
     }
     previewGroupPendingDelete_.clear();
 
-    for (auto& pair : groups_) {
-        ReleaseGroupResources(pair.second);
+    groups_.ForEach([this](ParticleGroupId, GPUParticleGroup& g) {
+        ReleaseGroupResources(g);
+    });
+    groups_.Clear();
+
+    for (size_t i = 0; i < constantsPages_.size(); ++i) {
+        if (constantsPages_[i] && constantsPagesMapped_[i]) constantsPages_[i]->Unmap(0, nullptr);
+    }
+    constantsPages_.clear();
+    constantsPagesMapped_.clear();
+    for (BurstPages& bursts : burstPages_) {
+        for (size_t i = 0; i < bursts.pages.size(); ++i) {
+            if (bursts.pages[i] && bursts.mapped[i]) bursts.pages[i]->Unmap(0, nullptr);
+        }
+        bursts = BurstPages{};
     }
-    groups_.clear();
 
     materialResource_.Reset();
     vertexResource_.Reset();
@@ -63,66 +76,70 @@ bool GPUParticleManager::IsPreviewName(const std::string& name)
            name.compare(0, prefix.size(), prefix) == 0;
 }
 
-void GPUParticleManager::CreateGroup(const std::string& name, const std::string& texturePath)
+ParticleGroupId GPUParticleManager::CreateGroup(const std::string& name, const std::string& texturePath)
 {
-    if (groups_.find(name) != groups_.end()) return;
-
-    GPUParticleGroup g{};
-    g.isPreview = IsPreviewName(name);
-    CreateGroupResources(g, texturePath);
-    groups_.emplace(name, std::move(g));
+    const ParticleGroupId existing = groups_.Find(name);
+    if (existing != kInvalidParticleGroupId) return existing;
+
+    const ParticleGroupId id = groups_.Add(name, GPUParticleGroup{});
+    GPUParticleGroup* g = groups_.Get(id);
+    if (!g) return kInvalidParticleGroupId;
+    g->isPreview = IsPreviewName(name);
+    CreateGroupResources(*g, ParticleGroupTable<GPUParticleGroup>::SlotOf(id), texturePath);
+    return id;
 }
 
-void GPUParticleManager::RemoveGroup(const std::string& name)
+ParticleGroupId GPUParticleManager::FindGroup(const std::string& name) const
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
-    ReleaseGroupResources(it->second);
-    groups_.erase(it);
+    return groups_.Find(name);
 }
 
-bool GPUParticleManager::HasGroup(const std::string& name) const
+void GPUParticleManager::RemoveGroup(ParticleGroupId group)
 {
-    return groups_.find(name) != groups_.end();
+    const uint32_t slot = groups_.Detach(group);
+    if (slot == ParticleGroupTable<GPUParticleGroup>::kInvalidSlot) return;
+    ReleaseGroupResources(groups_.At(slot));
+    groups_.Free(slot);
 }
 
 //==========================================================
 // 発射API
 //==========================================================
 
-void GPUParticleManager::BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius)
+void GPUParticleManager::BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius)
 {
     // 色指定なしは Random モードで委譲
-    BurstEmit(name, position, count, radius, 0, Vector4{ 1, 1, 1, 1 }, Vector4{ 1, 1, 1, 0 });
+    BurstEmit(group, position, count, radius, 0, Vector4{ 1, 1, 1, 1 }, Vector4{ 1, 1, 1, 0 });
 }
 
-void GPUParticleManager::BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+void GPUParticleManager::BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                                     uint32_t colorMode, const Vector4& startColor, const Vector4& endColor)
 {
     // スケール範囲なしの版は現状のCB既定値（0.1〜0.5, uniform=true）に委譲
-    BurstEmit(name, position, count, radius, colorMode, startColor, endColor,
+    BurstEmit(group, position, count, radius, colorMode, startColor, endColor,
               Vector2{ 0.1f, 0.1f }, Vector2{ 0.5f, 0.5f }, true);
 }
 
-void GPUParticleManager::BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+void GPUParticleManager::BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                                     uint32_t colorMode, const Vector4& startColor, const Vector4& endColor,
                                     const Vector2& scaleMin, const Vector2& scaleMax, bool uniformScale)
 {
-    BurstEmit(name, position, count, radius, colorMode, startColor, endColor,
+    BurstEmit(group, position, count, radius, colorMode, startColor, endColor,
               scaleMin, scaleMax, uniformScale, 1.0f);
 }
 
-void GPUParticleManager::BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+void GPUParticleManager::BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                                     uint32_t colorMode, const Vector4& startColor, const Vector4& endColor,
                                     const Vector2& scaleMin, const Vector2& scaleMax, bool uniformScale,
                                     float particleLifeTime,
                                     float lifeScaleStart, float lifeScaleEnd,
                                     const Vector3& rotRandomRange, const Vector3& rotateSpeed)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.emitterData) return;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
 
-    auto& e = *it->second.emitterData;
+    // 初速・形状などグループの設定は呼び出し時点の値を写し、発射ごとの値で上書きした要求を積む
+    EmitterSphere e = g->emitter;
     e.translate = position;
     e.radius = radius;
     e.count = count;
@@ -137,82 +154,95 @@ void GPUParticleManager::BurstEmit(const std::string& name, const Vector3& posit
     e.lifeScaleEnd = lifeScaleEnd;
     e.rotRandomRange = { rotRandomRange.x, rotRandomRange.y, rotRandomRange.z, 0.0f };
     e.rotateSpeed = { rotateSpeed.x, rotateSpeed.y, rotateSpeed.z, 0.0f };
-    // emit フラグは Update() で CB に転写（CPU/GPU レース回避）
-    it->second.pendingBurst = true;
+    QueueBurst(*g, e);
 }
 
-void GPUParticleManager::SetContinuousEmit(const std::string& name, bool enabled, float frequency, uint32_t countPerEmit, float radius)
+void GPUParticleManager::QueueBurst(GPUParticleGroup& g, const EmitterSphere& emitter)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
-    it->second.continuousEnabled = enabled;
-    if (it->second.emitterData) {
-        it->second.emitterData->frequency = frequency;
-        it->second.emitterData->count = countPerEmit;
-        it->second.emitterData->radius = radius;
-    }
+    if (g.pendingBursts.size() >= kMaxBurstsPerFrame) return;
+    g.pendingBursts.push_back(emitter);
+    EmitterSphere& e = g.pendingBursts.back();
+    e.emit = 1;
+    // 同じフレームの Emit CS は同じ時刻で種を作るので、要求ごとにずらして同じ並びの粒子を重ねない（0 は連続発射用）
+    e.seedOffset = static_cast<float>(g.pendingBursts.size());
 }
 
-void GPUParticleManager::SetEmitterTranslate(const std::string& name, const Vector3& translate)
+void GPUParticleManager::SetContinuousEmit(ParticleGroupId group, bool enabled, float frequency, uint32_t countPerEmit, float radius)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.emitterData) return;
-    it->second.emitterData->translate = translate;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    g->continuousEnabled = enabled;
+    g->emitter.frequency = frequency;
+    g->emitter.count = countPerEmit;
+    g->emitter.radius = radius;
+    g->dirtyConstants |= kDirtyEmitter;
 }
 
-void GPUParticleManager::SetEmitterVelocity(const std::string& name, const Vector3& baseVelocity, float jitter, int mode)
+void GPUParticleManager::SetEmitterTranslate(ParticleGroupId group, const Vector3& translate)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.emitterData) return;
-    auto& e = *it->second.emitterData;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    g->emitter.translate = translate;
+    g->dirtyConstants |= kDirtyEmitter;
+}
+
+void GPUParticleManager::SetEmitterVelocity(ParticleGroupId group, const Vector3& baseVelocity, float jitter, int mode)
+{
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    auto& e = g->emitter;
     e.baseVelocity = baseVelocity;
     e.velocityJitter = jitter;
     e.velocityMode = static_cast<float>(mode);
+    g->dirtyConstants |= kDirtyEmitter;
 }
 
-void GPUParticleManager::SetEmitterShape(const std::string& name, int mode, const Vector3& ringNormal, float ringThickness)
+void GPUParticleManager::SetEmitterShape(ParticleGroupId group, int mode, const Vector3& ringNormal, float ringThickness)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.emitterData) return;
-    auto& e = *it->second.emitterData;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    auto& e = g->emitter;
     e.shapeMode = static_cast<float>(mode);
     e.ringNormal = ringNormal;
     e.ringThickness = ringThickness;
+    g->dirtyConstants |= kDirtyEmitter;
 }
 
-void GPUParticleManager::SetGroupOrbit(const std::string& name, bool enabled, const Vector3& center,
+void GPUParticleManager::SetGroupOrbit(ParticleGroupId group, bool enabled, const Vector3& center,
                                        const Vector3& spinAxis, float spinSpeed,
                                        const Vector3& tumbleAxis, float tumbleSpeed)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.orbitData) return;
-    auto& o = *it->second.orbitData;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    auto& o = g->orbit;
     o.enabled = enabled ? 1.0f : 0.0f;
     o.center = center;
     o.spinAxis = spinAxis;
     o.spinSpeed = spinSpeed;
     o.tumbleAxis = tumbleAxis;
     o.tumbleSpeed = tumbleSpeed;
+    g->dirtyConstants |= kDirtyOrbit;
 }
 
-void GPUParticleManager::SetGroupConverge(const std::string& name, bool enable, const Vector3& center, const float lut32[32])
+void GPUParticleManager::SetGroupConverge(ParticleGroupId group, bool enable, const Vector3& center, const float lut32[kConvergeLutSamples])
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.orbitData) return;
-    auto& o = *it->second.orbitData;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    auto& o = g->orbit;
     o.convergeEnable = enable ? 1.0f : 0.0f;
     o.convergeCenter = center;
     // 32 サンプルを float4[8] にパック（.x..w=連続4サンプル）
     for (int i = 0; i < 8; ++i) {
         o.convergeLUT[i] = { lut32[i * 4 + 0], lut32[i * 4 + 1], lut32[i * 4 + 2], lut32[i * 4 + 3] };
     }
+    g->dirtyConstants |= kDirtyOrbit;
 }
 
-void GPUParticleManager::SetEmitterGradient(const std::string& name, const std::vector<std::pair<float, Vector4>>& keys)
+void GPUParticleManager::SetEmitterGradient(ParticleGroupId group, const std::vector<std::pair<float, Vector4>>& keys)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.gradientData) return;
-    auto& g = *it->second.gradientData;
+    GPUParticleGroup* grp = groups_.Get(group);
+    if (!grp) return;
+    auto& g = grp->gradient;
     const uint32_t n = (keys.size() < kMaxGradientKeys) ? static_cast<uint32_t>(keys.size()) : kMaxGradientKeys;
     // 2個未満は無効化（粒子の start/end 2色補間に戻す）
     g.keyCount = (n >= 2) ? n : 0;
@@ -220,34 +250,51 @@ void GPUParticleManager::SetEmitterGradient(const std::string& name, const std::
         g.keyLoc[i]   = { keys[i].first, 0.0f, 0.0f, 0.0f };
         g.keyColor[i] = keys[i].second;
     }
+    grp->dirtyConstants |= kDirtyGradient;
+}
+
+void GPUParticleManager::SetEmitterGradient(ParticleGroupId group, const float* locations, const Vector4* colors, uint32_t count)
+{
+    GPUParticleGroup* grp = groups_.Get(group);
+    if (!grp) return;
+    auto& g = grp->gradient;
+    const uint32_t n = (count < kMaxGradientKeys) ? count : kMaxGradientKeys;
+    g.keyCount = (n >= 2) ? n : 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        g.keyLoc[i]   = { locations[i], 0.0f, 0.0f, 0.0f };
+        g.keyColor[i] = colors[i];
+    }
+    grp->dirtyConstants |= kDirtyGradient;
 }
 
-void GPUParticleManager::SetGroupHueShift(const std::string& name, bool enable, float speed, bool randomPhase)
+void GPUParticleManager::SetGroupHueShift(ParticleGroupId group, bool enable, float speed, bool randomPhase)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.gradientData) return;
-    auto& g = *it->second.gradientData;
+    GPUParticleGroup* grp = groups_.Get(group);
+    if (!grp) return;
+    auto& g = grp->gradient;
     g.hueEnable      = enable ? 1.0f : 0.0f;
     g.hueSpeed       = speed;
     g.hueRandomPhase = randomPhase ? 1.0f : 0.0f;
+    grp->dirtyConstants |= kDirtyGradient;
 }
 
-void GPUParticleManager::SetGroupDissolve(const std::string& name, bool enable, const std::string& maskPath,
+void GPUParticleManager::SetGroupDissolve(ParticleGroupId group, bool enable, const std::string& maskPath,
                                           bool inEnable, float inEnd, bool outEnable, float outStart,
                                           bool edgeEnable, const Vector4& edgeColor, float edgeWidth)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end() || !it->second.dissolveData) return;
-    auto& g = it->second;
-
-    g.dissolveData->enable     = enable ? 1 : 0;
-    g.dissolveData->inEnable   = inEnable ? 1 : 0;
-    g.dissolveData->outEnable  = outEnable ? 1 : 0;
-    g.dissolveData->edgeEnable = edgeEnable ? 1 : 0;
-    g.dissolveData->inEnd      = inEnd;
-    g.dissolveData->outStart   = outStart;
-    g.dissolveData->edgeWidth  = edgeWidth;
-    g.dissolveData->edgeColor  = edgeColor;
+    GPUParticleGroup* grp = groups_.Get(group);
+    if (!grp) return;
+    auto& g = *grp;
+
+    g.dissolve.enable     = enable ? 1 : 0;
+    g.dissolve.inEnable   = inEnable ? 1 : 0;
+    g.dissolve.outEnable  = outEnable ? 1 : 0;
+    g.dissolve.edgeEnable = edgeEnable ? 1 : 0;
+    g.dissolve.inEnd      = inEnd;
+    g.dissolve.outStart   = outStart;
+    g.dissolve.edgeWidth  = edgeWidth;
+    g.dissolve.edgeColor  = edgeColor;
+    g.dirtyConstants |= kDirtyDissolve;
 
     // マスク（変化時のみロード）。enable かつパスありのときだけ t1 をマスクに、それ以外は white1x1。
     if (enable && !maskPath.empty()) {
@@ -262,42 +309,41 @@ void GPUParticleManager::SetGroupDissolve(const std::string& name, bool enable,
     }
 }
 
-void GPUParticleManager::SetGroupTexture(const std::string& name, const std::string& texturePath)
+void GPUParticleManager::SetGroupTexture(ParticleGroupId group, const std::string& texturePath)
 {
     if (texturePath.empty()) return;
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
-    auto& g = it->second;
-    if (g.textureFilePath == texturePath) return; // 変化なし
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    if (g->textureFilePath == texturePath) return; // 変化なし
     TextureManager::GetInstance()->LoadTexture(texturePath);
-    g.textureSrvIndex = TextureManager::GetInstance()->GetSrvIndex(texturePath);
-    g.textureFilePath = texturePath;
+    g->textureSrvIndex = TextureManager::GetInstance()->GetSrvIndex(texturePath);
+    g->textureFilePath = texturePath;
 }
 
 //==========================================================
 // ビルボード / TimeGroup
 //==========================================================
 
-void GPUParticleManager::SetGroupBlendMode(const std::string& name, int mode)
+void GPUParticleManager::SetGroupBlendMode(ParticleGroupId group, int mode)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
     if (mode < 0 || mode >= kCountOfBlendMode) mode = kBlendModeAdd;
-    it->second.blendMode = static_cast<BlendMode>(mode);
+    g->blendMode = static_cast<BlendMode>(mode);
 }
 
-void GPUParticleManager::SetGroupBillboardMode(const std::string& name, BillboardMode mode)
+void GPUParticleManager::SetGroupBillboardMode(ParticleGroupId group, BillboardMode mode)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
-    it->second.billboardMode = mode;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    g->billboardMode = mode;
 }
 
-void GPUParticleManager::SetGroupTimeGroup(const std::string& name, TimeGroup group)
+void GPUParticleManager::SetGroupTimeGroup(ParticleGroupId group, TimeGroup timeGroup)
 {
-    auto it = groups_.find(name);
-    if (it == groups_.end()) return;
-    it->second.timeGroup = group;
+    GPUParticleGroup* g = groups_.Get(group);
+    if (!g) return;
+    g->timeGroup = timeGroup;
 }
 
 //==========================================================
@@ -318,23 +364,21 @@ void GPUParticleManager::Update(const Camera* camera, float deltaTime)
         cameraPosition_ = camera->GetTranslate();
     }
 
-    // 各グループのCBを更新（プレビュー用は UpdatePreviewSim で別途進めるのでスキップ）
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        if (g.isPreview) continue;
+    // 各グループの定数を更新（プレビュー用は UpdatePreviewSim で別途進めるのでスキップ）
+    groups_.ForEach([this, deltaTime](ParticleGroupId, GPUParticleGroup& g) {
+        if (g.isPreview) return;
 
         // TimeGroup連動dt。供給元（シーン）が無ければ deltaTime にフォールバック。
         const float dt = EngineTime::ScaledDeltaTime(g.timeGroup, deltaTime);
         UpdateGroupSim(g, dt);
 
         // PerView（メイン用）
-        if (g.perViewData) {
-            g.perViewData->viewProjection = viewProjectionMatrix_;
-            g.perViewData->billboardMatrix = fullBillboardMatrix_;
-            g.perViewData->cameraPosition = cameraPosition_;
-            g.perViewData->billboardMode = static_cast<uint32_t>(g.billboardMode);
-        }
-    }
+        g.perView.viewProjection = viewProjectionMatrix_;
+        g.perView.billboardMatrix = fullBillboardMatrix_;
+        g.perView.cameraPosition = cameraPosition_;
+        g.perView.billboardMode = static_cast<uint32_t>(g.billboardMode);
+        g.dirtyConstants |= kDirtyPerView;
+    });
 }
 
 void GPUParticleManager::UpdateGroupSim(GPUParticleGroup& g, float dt)
@@ -342,108 +386,146 @@ void GPUParticleManager::UpdateGroupSim(GPUParticleGroup& g, float dt)
     g.elapsedTime += dt;
 
     // PerFrame
-    if (g.perFrameData) {
-        g.perFrameData->time = g.elapsedTime;
-        g.perFrameData->deltaTime = dt;
-    }
+    g.perFrame.time = g.elapsedTime;
+    g.perFrame.deltaTime = dt;
 
-    // Emitter の emit フラグをこのフレームの最終値で確定させる
-    //   - pendingBurst が立っていれば 1（その後フラグを下ろす）
+    // 積まれたバースト要求をこのフレームの分として確定させる（配列を入れ替えるだけで確保し直さない）
+    g.frameBursts.swap(g.pendingBursts);
+    g.pendingBursts.clear();
+
+    // 連続発射の emit フラグをこのフレームの最終値で確定させる
     //   - 連続発射なら frequency に従って 0/1
     //   - それ以外は 0
-    if (g.emitterData) {
-        if (g.pendingBurst) {
-            g.emitterData->emit = 1;
-            g.pendingBurst = false;
-        } else if (g.continuousEnabled) {
-            g.emitterData->frequencyTime += dt;
-            if (g.emitterData->frequency <= g.emitterData->frequencyTime) {
-                g.emitterData->frequencyTime -= g.emitterData->frequency;
-                g.emitterData->emit = 1;
-            } else {
-                g.emitterData->emit = 0;
-            }
+    if (g.continuousEnabled) {
+        g.emitter.frequencyTime += dt;
+        if (g.emitter.frequency <= g.emitter.frequencyTime) {
+            g.emitter.frequencyTime -= g.emitter.frequency;
+            g.emitter.emit = 1;
         } else {
-            g.emitterData->emit = 0;
+            g.emitter.emit = 0;
         }
+    } else {
+        g.emitter.emit = 0;
     }
+    g.dirtyConstants |= kDirtyEmitter | kDirtyPerFrame;
 }
 
 void GPUParticleManager::UpdatePreviewSim(float deltaTime)
 {
     // 前フレームに遅延予約したプレビューグループをここ（描画コマンドを積む前）で実解放。
-    for (auto& g : previewGroupPendingDelete_) {
-        ReleaseGroupResources(g);
+    for (uint32_t slot : previewGroupPendingDelete_) {
+        ReleaseGroupResources(groups_.At(slot));
+        groups_.Free(slot);
     }
     previewGroupPendingDelete_.clear();
 
     // プレビュー用グループだけを unscaled な実 delta で進める（シーンのタイムスケール非依存）。
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        if (!g.isPreview) continue;
+    groups_.ForEach([this, deltaTime](ParticleGroupId, GPUParticleGroup& g) {
+        if (!g.isPreview) return;
         UpdateGroupSim(g, deltaTime);
-    }
+    });
 }
 
-void GPUParticleManager::RecyclePreviewGroups(const std::vector<std::string>& keepNames)
+void GPUParticleManager::RecyclePreviewGroups(const std::vector<ParticleGroupId>& keepGroups)
 {
-    for (auto it = groups_.begin(); it != groups_.end();) {
-        GPUParticleGroup& g = it->second;
-        if (!g.isPreview) { ++it; continue; }
-
-        const bool keep = std::find(keepNames.begin(), keepNames.end(), it->first) != keepNames.end();
-        if (keep) { ++it; continue; }
-
-        // 今プレビュー中のエフェクトが参照していないプレビューグループは遅延解放へ。
-        previewGroupPendingDelete_.push_back(std::move(g));
-        it = groups_.erase(it);
+    // 今プレビュー中のエフェクトが参照していないプレビューグループは遅延解放へ。
+    // ハンドルはここで無効になり、スロットは実解放まで再利用されない。
+    std::vector<ParticleGroupId> recycle;
+    groups_.ForEach([&keepGroups, &recycle](ParticleGroupId id, GPUParticleGroup& g) {
+        if (!g.isPreview) return;
+        if (std::find(keepGroups.begin(), keepGroups.end(), id) == keepGroups.end()) {
+            recycle.push_back(id);
+        }
+    });
+    for (ParticleGroupId id : recycle) {
+        previewGroupPendingDelete_.push_back(groups_.Detach(id));
     }
 }
 
 void GPUParticleManager::UpdatePreviewView(const Matrix4x4& viewMatrix, const Matrix4x4& viewProjectionMatrix, const Vector3& cameraPos)
 {
-    // プレビューカメラから billboard / cameraPosition / VP を計算してプレビュー用CBに書き込む
+    // プレビューカメラから billboard / cameraPosition / VP を計算してプレビュー用の定数に書き込む
     Matrix4x4 bb = MakeIdentity4x4();
     bb.m[0][0] = viewMatrix.m[0][0]; bb.m[0][1] = viewMatrix.m[1][0]; bb.m[0][2] = viewMatrix.m[2][0];
     bb.m[1][0] = viewMatrix.m[0][1]; bb.m[1][1] = viewMatrix.m[1][1]; bb.m[1][2] = viewMatrix.m[2][1];
     bb.m[2][0] = viewMatrix.m[0][2]; bb.m[2][1] = viewMatrix.m[1][2]; bb.m[2][2] = viewMatrix.m[2][2];
 
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        if (!g.perViewPreviewData) continue;
-        g.perViewPreviewData->viewProjection = viewProjectionMatrix;
-        g.perViewPreviewData->billboardMatrix = bb;
-        g.perViewPreviewData->cameraPosition = cameraPos;
-        g.perViewPreviewData->billboardMode = static_cast<uint32_t>(g.billboardMode);
-    }
+    groups_.ForEach([&](ParticleGroupId, GPUParticleGroup& g) {
+        g.perViewPreview.viewProjection = viewProjectionMatrix;
+        g.perViewPreview.billboardMatrix = bb;
+        g.perViewPreview.cameraPosition = cameraPos;
+        g.perViewPreview.billboardMode = static_cast<uint32_t>(g.billboardMode);
+        g.dirtyConstants |= kDirtyPerViewPreview;
+    });
 }
 
 void GPUParticleManager::DrawPreview()
 {
-    if (groups_.empty()) return;
+    if (groups_.Empty()) return;
 
-    // プレビュー用グループを独立してシミュレート＋描画する（シーンの Draw からは完全に分離）。
+    // プレビュー用グループの定数をまとめて写してから、独立してシミュレート＋描画する（シーンの Draw からは完全に分離）。
     // シーンが停止していても、プレビューは UpdatePreviewSim の unscaled delta で進んだ状態が描かれる。
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        if (!g.isPreview) continue;
-        SimulateAndDrawGroup(g, g.perViewPreviewResource.Get());
-    }
+    FlushGroupConstants(true);
+    groups_.ForEach([this](ParticleGroupId, GPUParticleGroup& g) {
+        if (!g.isPreview) return;
+        SimulateAndDrawGroup(g, g.constantsAddress + kPerViewPreviewOffset);
+    });
 }
 
 void GPUParticleManager::Draw()
 {
-    if (groups_.empty()) return;
+    if (groups_.Empty()) return;
 
     // シーン用グループのみ（プレビュー用は DrawPreview 側で独立処理）。
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        if (g.isPreview) continue;
-        SimulateAndDrawGroup(g, g.perViewResource.Get());
-    }
+    FlushGroupConstants(false);
+    groups_.ForEach([this](ParticleGroupId, GPUParticleGroup& g) {
+        if (g.isPreview) return;
+        SimulateAndDrawGroup(g, g.constantsAddress + kPerViewOffset);
+    });
+}
+
+void GPUParticleManager::FlushGroupConstants(bool preview)
+{
+    // setter は CPU 側の控えだけを書いているので、ここで変わった区画を 1 フレーム 1 回まとめて写す
+    // （バースト要求も含め、全グループぶんを描画コマンドを積む直前の 1 パスで書く）。
+    BurstPages& bursts = burstPages_[preview ? 1 : 0];
+    bursts.used = 0;
+    groups_.ForEach([this, preview, &bursts](ParticleGroupId, GPUParticleGroup& g) {
+        if (g.isPreview != preview || !g.constantsMapped) return;
+
+        // バースト要求は 1 件ずつ別の区画へ（足りなければページを足す。既存のページは動かさない）
+        g.frameBurstAddresses.clear();
+        for (const EmitterSphere& burst : g.frameBursts) {
+            const uint32_t index = bursts.used++;
+            const uint32_t page = index / kBurstsPerPage;
+            while (bursts.pages.size() <= page) {
+                Microsoft::WRL::ComPtr<ID3D12Resource> resource =
+                    dxCore_->CreateBufferResource(static_cast<size_t>(kBurstStride) * kBurstsPerPage);
+                uint8_t* mapped = nullptr;
+                resource->Map(0, nullptr, reinterpret_cast<void**>(&mapped));
+                bursts.pages.push_back(resource);
+                bursts.mapped.push_back(mapped);
+            }
+            const uint32_t offsetInPage = (index % kBurstsPerPage) * kBurstStride;
+            std::memcpy(bursts.mapped[page] + offsetInPage, &burst, sizeof(EmitterSphere));
+            g.frameBurstAddresses.push_back(bursts.pages[page]->GetGPUVirtualAddress() + offsetInPage);
+        }
+
+        if (g.dirtyConstants == 0) return;
+        uint8_t* dst = g.constantsMapped;
+        const uint32_t dirty = g.dirtyConstants;
+        if (dirty & kDirtyEmitter)        std::memcpy(dst + kEmitterOffset, &g.emitter, sizeof(EmitterSphere));
+        if (dirty & kDirtyGradient)       std::memcpy(dst + kGradientOffset, &g.gradient, sizeof(ParticleGradient));
+        if (dirty & kDirtyOrbit)          std::memcpy(dst + kOrbitOffset, &g.orbit, sizeof(ParticleOrbit));
+        if (dirty & kDirtyPerFrame)       std::memcpy(dst + kPerFrameOffset, &g.perFrame, sizeof(PerFrame));
+        if (dirty & kDirtyPerView)        std::memcpy(dst + kPerViewOffset, &g.perView, sizeof(PerView));
+        if (dirty & kDirtyPerViewPreview) std::memcpy(dst + kPerViewPreviewOffset, &g.perViewPreview, sizeof(PerView));
+        if (dirty & kDirtyDissolve)       std::memcpy(dst + kDissolveOffset, &g.dissolve, sizeof(DissolveParticle));
+        g.dirtyConstants = 0;
+    });
 }
 
-void GPUParticleManager::SimulateAndDrawGroup(GPUParticleGroup& g, ID3D12Resource* perViewCB)
+void GPUParticleManager::SimulateAndDrawGroup(GPUParticleGroup& g, D3D12_GPU_VIRTUAL_ADDRESS perViewAddress)
 {
     auto commandList = dxCore_->GetCommandList();
 
@@ -490,7 +572,7 @@ void GPUParticleManager::SimulateAndDrawGroup(GPUParticleGroup& g, ID3D12Resourc
         TransitionParticle(g, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
     }
 
-    // Emit （emit フラグは Update で確定済み。Draw中に CB を書き換えると GPU 実行前にレースするので触らない）
+    // Emit （emit フラグ・バースト要求は Update で確定済み。Draw中に CB を書き換えると GPU 実行前にレースするので触らない）
     DispatchEmitCS(g);
 
     {
@@ -517,11 +599,11 @@ void GPUParticleManager::SimulateAndDrawGroup(GPUParticleGroup& g, ID3D12Resourc
     commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
 
     srvManager_->SetGraphicsRootDescriptorTable(0, g.particleSrvIndex);
-    commandList->SetGraphicsRootConstantBufferView(1, perViewCB->GetGPUVirtualAddress());
+    commandList->SetGraphicsRootConstantBufferView(1, perViewAddress);
     commandList->SetGraphicsRootConstantBufferView(2, materialResource_->GetGPUVirtualAddress());
     srvManager_->SetGraphicsRootDescriptorTable(3, g.textureSrvIndex);
     // [5] PS b2: Dissolve（per-group）、[6] PS t1: マスク（未設定時は white1x1）
-    commandList->SetGraphicsRootConstantBufferView(5, g.dissolveResource->GetGPUVirtualAddress());
+    commandList->SetGraphicsRootConstantBufferView(5, g.constantsAddress + kDissolveOffset);
     srvManager_->SetGraphicsRootDescriptorTable(6, g.hasDissolveMask ? g.dissolveMaskSrvIndex : whiteSrvIndex_);
 
     PEPPER_COUNT("DrawCall");
@@ -531,16 +613,16 @@ void GPUParticleManager::SimulateAndDrawGroup(GPUParticleGroup& g, ID3D12Resourc
 void GPUParticleManager::OnImGui()
 {
 #ifdef USE_IMGUI
-    ImGui::Text("Groups: %zu", groups_.size());
+    ImGui::Text("Groups: %zu", groups_.Size());
     ImGui::Separator();
 
     const char* billboardItems[] = { "None", "Full", "YAxis" };
     const char* timeGroupItems[] = { "World", "Player", "UI", "Effect" };
 
-    for (auto& pair : groups_) {
-        GPUParticleGroup& g = pair.second;
-        ImGui::PushID(pair.first.c_str());
-        if (ImGui::CollapsingHeader(pair.first.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+    groups_.ForEach([&](ParticleGroupId id, GPUParticleGroup& g) {
+        const std::string& name = groups_.GetName(id);
+        ImGui::PushID(name.c_str());
+        if (ImGui::CollapsingHeader(name.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
             ImGui::Text("Texture: %s", g.textureFilePath.c_str());
             ImGui::Text("Elapsed: %.2f s", g.elapsedTime);
 
@@ -553,22 +635,21 @@ void GPUParticleManager::OnImGui()
                 g.timeGroup = static_cast<TimeGroup>(tg);
             }
 
+            // emitter は毎フレーム UpdateGroupSim で写し直すので、ここで控えを書き換えるだけでよい
             ImGui::Checkbox("Continuous Emit", &g.continuousEnabled);
-            if (g.emitterData) {
-                ImGui::DragFloat3("Translate", &g.emitterData->translate.x, 0.1f);
-                ImGui::DragFloat("Radius", &g.emitterData->radius, 0.05f, 0.0f, 100.0f);
-                int count = static_cast<int>(g.emitterData->count);
-                if (ImGui::DragInt("Count per Emit", &count, 1, 0, static_cast<int>(kMaxParticles))) {
-                    g.emitterData->count = static_cast<uint32_t>(count);
-                }
-                ImGui::DragFloat("Frequency (s)", &g.emitterData->frequency, 0.01f, 0.01f, 10.0f);
-                if (ImGui::Button("Burst Now")) {
-                    g.pendingBurst = true;
-                }
+            ImGui::DragFloat3("Translate", &g.emitter.translate.x, 0.1f);
+            ImGui::DragFloat("Radius", &g.emitter.radius, 0.05f, 0.0f, 100.0f);
+            int count = static_cast<int>(g.emitter.count);
+            if (ImGui::DragInt("Count per Emit", &count, 1, 0, static_cast<int>(kMaxParticles))) {
+                g.emitter.count = static_cast<uint32_t>(count);
+            }
+            ImGui::DragFloat("Frequency (s)", &g.emitter.frequency, 0.01f, 0.01f, 10.0f);
+            if (ImGui::Button("Burst Now")) {
+                QueueBurst(g, g.emitter);
             }
         }
         ImGui::PopID();
-    }
+    });
 #endif
 }
 
@@ -598,10 +679,17 @@ void GPUParticleManager::DispatchEmitCS(GPUParticleGroup& g)
     commandList->SetComputeRootDescriptorTable(0, srvManager_->GetGPUDescriptorHandle(g.particleUavIndex));
     commandList->SetComputeRootDescriptorTable(1, srvManager_->GetGPUDescriptorHandle(g.freeListIndexUavIndex));
     commandList->SetComputeRootDescriptorTable(2, srvManager_->GetGPUDescriptorHandle(g.freeListUavIndex));
-    commandList->SetComputeRootConstantBufferView(3, g.emitterResource->GetGPUVirtualAddress());
-    commandList->SetComputeRootConstantBufferView(4, g.perFrameResource->GetGPUVirtualAddress());
+    commandList->SetComputeRootConstantBufferView(4, g.constantsAddress + kPerFrameOffset);
 
+    // 連続発射（emit=0 なら CS 側で何もしない）
+    commandList->SetComputeRootConstantBufferView(3, g.constantsAddress + kEmitterOffset);
     commandList->Dispatch(1, 1, 1);
+
+    // バースト要求を 1 件ずつ。粒子の確保は FreeList の InterlockedAdd なので、Emit 同士の間に UAV バリアは要らない
+    for (D3D12_GPU_VIRTUAL_ADDRESS address : g.frameBurstAddresses) {
+        commandList->SetComputeRootConstantBufferView(3, address);
+        commandList->Dispatch(1, 1, 1);
+    }
 }
 
 void GPUParticleManager::DispatchUpdateCS(GPUParticleGroup& g)
@@ -613,9 +701,9 @@ void GPUParticleManager::DispatchUpdateCS(GPUParticleGroup& g)
     commandList->SetComputeRootDescriptorTable(0, srvManager_->GetGPUDescriptorHandle(g.particleUavIndex));
     commandList->SetComputeRootDescriptorTable(1, srvManager_->GetGPUDescriptorHandle(g.freeListIndexUavIndex));
     commandList->SetComputeRootDescriptorTable(2, srvManager_->GetGPUDescriptorHandle(g.freeListUavIndex));
-    commandList->SetComputeRootConstantBufferView(3, g.perFrameResource->GetGPUVirtualAddress());
-    commandList->SetComputeRootConstantBufferView(4, g.gradientResource->GetGPUVirtualAddress());
-    commandList->SetComputeRootConstantBufferView(5, g.orbitResource->GetGPUVirtualAddress());
+    commandList->SetComputeRootConstantBufferView(3, g.constantsAddress + kPerFrameOffset);
+    commandList->SetComputeRootConstantBufferView(4, g.constantsAddress + kGradientOffset);
+    commandList->SetComputeRootConstantBufferView(5, g.constantsAddress + kOrbitOffset);
 
     commandList->Dispatch(1, 1, 1);
 }
@@ -635,7 +723,7 @@ void GPUParticleManager::TransitionParticle(GPUParticleGroup& g, D3D12_RESOURCE_
 // グループ別リソース確保・解放
 //==========================================================
 
-void GPUParticleManager::CreateGroupResources(GPUParticleGroup& g, const std::string& texturePath)
+void GPUParticleManager::CreateGroupResources(GPUParticleGroup& g, uint32_t slot, const std::string& texturePath)
 {
     // テクスチャ
     g.textureFilePath = texturePath;
@@ -659,111 +747,72 @@ void GPUParticleManager::CreateGroupResources(GPUParticleGroup& g, const std::st
     g.freeListUavIndex = srvManager_->Allocate();
     srvManager_->CreateUAVForStructuredBuffer(g.freeListUavIndex, g.freeListResource.Get(), kMaxParticles, sizeof(uint32_t));
 
-    // Emitter CB
-    g.emitterResource = dxCore_->CreateBufferResource(sizeof(EmitterSphere));
-    g.emitterResource->Map(0, nullptr, reinterpret_cast<void**>(&g.emitterData));
-    g.emitterData->translate = { 0.0f, 0.0f, 0.0f };
-    g.emitterData->radius = 1.0f;
-    g.emitterData->count = 10;
-    g.emitterData->frequency = 0.5f;
-    g.emitterData->frequencyTime = 0.0f;
-    g.emitterData->emit = 0;
-    g.emitterData->colorMode = 0;
-    g.emitterData->baseVelocity = { 0.0f, 0.0f, 0.0f };
-    g.emitterData->startColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-    g.emitterData->endColor   = { 1.0f, 1.0f, 1.0f, 0.0f };
-    g.emitterData->scaleMin = { 0.1f, 0.1f };
-    g.emitterData->scaleMax = { 0.5f, 0.5f };
-    g.emitterData->uniformScale = 1;
-    g.emitterData->particleLifeTime = 1.0f;
-    g.emitterData->velocityMode = 0.0f;
-    g.emitterData->velocityJitter = 0.0f;
-    g.emitterData->shapeMode = 0.0f;
-    g.emitterData->ringNormal = { 0.0f, 0.0f, 1.0f };
-    g.emitterData->ringThickness = 0.0f;
-    g.emitterData->lifeScaleStart = 1.0f;
-    g.emitterData->lifeScaleEnd = 1.0f;
-    g.emitterData->rotRandomRange = { 0.0f, 0.0f, 0.0f, 0.0f };
-    g.emitterData->rotateSpeed = { 0.0f, 0.0f, 0.0f, 0.0f };
-
-    // Gradient CB（Update CS b1）。既定 keyCount=0（無効＝粒子の start/end 2色補間）
-    // CBV は 256 バイト境界なのでサイズを 256 の倍数に丸める
-    g.gradientResource = dxCore_->CreateBufferResource((sizeof(ParticleGradient) + 255) & ~static_cast<size_t>(255));
-    g.gradientResource->Map(0, nullptr, reinterpret_cast<void**>(&g.gradientData));
-    *g.gradientData = ParticleGradient{};
-
-    // Orbit CB（Update CS b2）。既定 enabled=0（従来の velocity 直線移動）
-    g.orbitResource = dxCore_->CreateBufferResource((sizeof(ParticleOrbit) + 255) & ~static_cast<size_t>(255));
-    g.orbitResource->Map(0, nullptr, reinterpret_cast<void**>(&g.orbitData));
-    *g.orbitData = ParticleOrbit{};
-
-    // PerFrame CB
-    g.perFrameResource = dxCore_->CreateBufferResource(sizeof(PerFrame));
-    g.perFrameResource->Map(0, nullptr, reinterpret_cast<void**>(&g.perFrameData));
-    g.perFrameData->time = 0.0f;
-    g.perFrameData->deltaTime = 0.0f;
-    g.perFrameData->pad[0] = 0.0f;
-    g.perFrameData->pad[1] = 0.0f;
-
-    // PerView CB（メイン用）
-    g.perViewResource = dxCore_->CreateBufferResource(sizeof(PerView));
-    g.perViewResource->Map(0, nullptr, reinterpret_cast<void**>(&g.perViewData));
-    g.perViewData->viewProjection = MakeIdentity4x4();
-    g.perViewData->billboardMatrix = MakeIdentity4x4();
-    g.perViewData->cameraPosition = { 0.0f, 0.0f, 0.0f };
-    g.perViewData->billboardMode = static_cast<uint32_t>(BillboardMode::Full);
-
-    // PerView CB（プレビュー用）
-    g.perViewPreviewResource = dxCore_->CreateBufferResource(sizeof(PerView));
-    g.perViewPreviewResource->Map(0, nullptr, reinterpret_cast<void**>(&g.perViewPreviewData));
-    g.perViewPreviewData->viewProjection = MakeIdentity4x4();
-    g.perViewPreviewData->billboardMatrix = MakeIdentity4x4();
-    g.perViewPreviewData->cameraPosition = { 0.0f, 0.0f, 0.0f };
-    g.perViewPreviewData->billboardMode = static_cast<uint32_t>(BillboardMode::Full);
-
-    // Dissolve CB（描画 PS b2）。既定 enable=0（無効）
-    g.dissolveResource = dxCore_->CreateBufferResource(sizeof(DissolveParticle));
-    g.dissolveResource->Map(0, nullptr, reinterpret_cast<void**>(&g.dissolveData));
-    *g.dissolveData = DissolveParticle{};
+    // 定数の区画：スロット番号で共有アップロードバッファの位置が決まる（足りなければページを足す）
+    const uint32_t page = slot / kGroupsPerConstantsPage;
+    while (constantsPages_.size() <= page) {
+        Microsoft::WRL::ComPtr<ID3D12Resource> resource =
+            dxCore_->CreateBufferResource(static_cast<size_t>(kGroupConstantsStride) * kGroupsPerConstantsPage);
+        uint8_t* mapped = nullptr;
+        resource->Map(0, nullptr, reinterpret_cast<void**>(&mapped));
+        constantsPages_.push_back(resource);
+        constantsPagesMapped_.push_back(mapped);
+    }
+    const uint32_t offsetInPage = (slot % kGroupsPerConstantsPage) * kGroupConstantsStride;
+    g.constantsMapped = constantsPagesMapped_[page] + offsetInPage;
+    g.constantsAddress = constantsPages_[page]->GetGPUVirtualAddress() + offsetInPage;
+
+    // Emitter
+    g.emitter.translate = { 0.0f, 0.0f, 0.0f };
+    g.emitter.radius = 1.0f;
+    g.emitter.count = 10;
+    g.emitter.frequency = 0.5f;
+    g.emitter.frequencyTime = 0.0f;
+    g.emitter.emit = 0;
+    g.emitter.colorMode = 0;
+    g.emitter.baseVelocity = { 0.0f, 0.0f, 0.0f };
+    g.emitter.startColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+    g.emitter.endColor   = { 1.0f, 1.0f, 1.0f, 0.0f };
+    g.emitter.scaleMin = { 0.1f, 0.1f };
+    g.emitter.scaleMax = { 0.5f, 0.5f };
+    g.emitter.uniformScale = 1;
+    g.emitter.particleLifeTime = 1.0f;
+    g.emitter.velocityMode = 0.0f;
+    g.emitter.velocityJitter = 0.0f;
+    g.emitter.shapeMode = 0.0f;
+    g.emitter.ringNormal = { 0.0f, 0.0f, 1.0f };
+    g.emitter.ringThickness = 0.0f;
+    g.emitter.lifeScaleStart = 1.0f;
+    g.emitter.lifeScaleEnd = 1.0f;
+    g.emitter.rotRandomRange = { 0.0f, 0.0f, 0.0f, 0.0f };
+    g.emitter.rotateSpeed = { 0.0f, 0.0f, 0.0f, 0.0f };
+    g.emitter.seedOffset = 0.0f;
+
+    // Gradient（既定 keyCount=0：無効＝粒子の start/end 2色補間）/ Orbit（既定 enabled=0：従来の velocity 直線移動）
+    g.gradient = ParticleGradient{};
+    g.orbit = ParticleOrbit{};
+
+    // PerFrame
+    g.perFrame = PerFrame{};
+
+    // PerView（メイン用 / プレビュー用）
+    g.perView.viewProjection = MakeIdentity4x4();
+    g.perView.billboardMatrix = MakeIdentity4x4();
+    g.perView.cameraPosition = { 0.0f, 0.0f, 0.0f };
+    g.perView.billboardMode = static_cast<uint32_t>(BillboardMode::Full);
+    g.perViewPreview = g.perView;
+
+    // Dissolve（既定 enable=0：無効）
+    g.dissolve = DissolveParticle{};
+
+    // 最初の Flush で全区画を写す
+    g.dirtyConstants = kDirtyAll;
 }
 
 void GPUParticleManager::ReleaseGroupResources(GPUParticleGroup& g)
 {
-    if (g.emitterResource && g.emitterData) {
-        g.emitterResource->Unmap(0, nullptr);
-        g.emitterData = nullptr;
-    }
-    if (g.gradientResource && g.gradientData) {
-        g.gradientResource->Unmap(0, nullptr);
-        g.gradientData = nullptr;
-    }
-    if (g.orbitResource && g.orbitData) {
-        g.orbitResource->Unmap(0, nullptr);
-        g.orbitData = nullptr;
-    }
-    if (g.perFrameResource && g.perFrameData) {
-        g.perFrameResource->Unmap(0, nullptr);
-        g.perFrameData = nullptr;
-    }
-    if (g.perViewResource && g.perViewData) {
-        g.perViewResource->Unmap(0, nullptr);
-        g.perViewData = nullptr;
-    }
-    if (g.perViewPreviewResource && g.perViewPreviewData) {
-        g.perViewPreviewResource->Unmap(0, nullptr);
-        g.perViewPreviewData = nullptr;
-    }
-    if (g.dissolveResource && g.dissolveData) {
-        g.dissolveResource->Unmap(0, nullptr);
-        g.dissolveData = nullptr;
-    }
-    g.emitterResource.Reset();
-    g.gradientResource.Reset();
-    g.orbitResource.Reset();
-    g.perFrameResource.Reset();
-    g.perViewResource.Reset();
-    g.perViewPreviewResource.Reset();
-    g.dissolveResource.Reset();
+    // 定数の区画は共有アップロードバッファのもの（スロットごと再利用する）なのでここでは返さない
+    g.constantsMapped = nullptr;
+    g.constantsAddress = 0;
     g.freeListResource.Reset();
     g.freeListIndexResource.Reset();
     g.particleResource.Reset();
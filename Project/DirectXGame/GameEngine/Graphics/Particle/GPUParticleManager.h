@@ -7,10 +7,10 @@
 #include "Matrix4x4.h"
 #include "BillboardMode.h"
 #include "TimeGroup.h"
+#include "ParticleGroupTable.h"
 #include <wrl.h>
 #include <d3d12.h>
 #include <string>
-#include <unordered_map>
 #include <cstdint>
 #include <vector>
 #include <utility>
@@ -19,13 +19,18 @@
 class Camera;
 
 // GPU Particle 管理クラス
-// - グループ名でN個のパーティクルプールを管理
+// - グループは名前で作り（CreateGroup / FindGroup）、以降は ParticleGroupId で操作する
+// - setter は CPU 側の控えを書くだけで、定数は Draw / DrawPreview の頭で全グループ分を共有バッファへまとめて写す
 // - 各グループ 1024個のParticleをDEFAULT heapに保持
 // - 初期化/Emit/Update は ComputeShader で行い、描画はStructuredBufferをVSで参照
 class GPUParticleManager
 {
 public:
     static const uint32_t kMaxParticles = 1024;
+    // 1 グループが 1 フレームに積めるバースト要求の数
+    static constexpr uint32_t kMaxBurstsPerFrame = 32;
+    // 収束カーブの LUT サンプル数（UpdateParticle.CS の SampleConvergeLUT。サンプル i は t = i / 31）
+    static constexpr uint32_t kConvergeLutSamples = 32;
 
     // ブレンドモード（EffectDef の int 値と互換。None=0, Normal=1, Add=2, Subtract=3, Multiply=4, Screen=5）
     enum BlendMode {
@@ -49,35 +54,43 @@ public:
 
     // ===== グループ管理 =====
     /// <summary>
-    /// 新しいパーティクルグループを生成。同名が既にあれば何もしない。
+    /// 新しいパーティクルグループを生成してハンドルを返す。同名が既にあればそのハンドルを返す（テクスチャは変えない）。
     /// </summary>
-    void CreateGroup(const std::string& name, const std::string& texturePath);
-    void RemoveGroup(const std::string& name);
-    bool HasGroup(const std::string& name) const;
+    ParticleGroupId CreateGroup(const std::string& name, const std::string& texturePath);
+    /// <summary>
+    /// 名前からハンドルを引く（無ければ kInvalidParticleGroupId）。毎フレーム呼ばず、結果を持っておくこと。
+    /// </summary>
+    ParticleGroupId FindGroup(const std::string& name) const;
+    void RemoveGroup(ParticleGroupId group);
+    // ハンドルが生きているグループを指しているか（消えたグループの古いハンドルは false）
+    bool HasGroup(ParticleGroupId group) const { return groups_.Get(group) != nullptr; }
 
     // ===== 発射API =====
     /// <summary>
-    /// 1回だけバースト発射（次フレームの Emit CS で N個を一括生成）
+    /// 1回だけバースト発射（次フレームの Emit CS で N個を一括生成）。
+    /// 呼び出しごとに発射要求（位置・個数・色など + その時点の初速・形状）を積み、同じフレームの要求は
+    /// FlushGroupConstants でまとめて書いて 1 件ずつ Emit する（別の位置の要求を 1 つに混ぜない）。
+    /// 1 グループ 1 フレームあたり kMaxBurstsPerFrame 件まで（超えた分は捨てる）。
     /// </summary>
-    void BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius = 0.5f);
+    void BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius = 0.5f);
 
     /// <summary>
     /// 色指定付きのバースト発射。colorMode=0でRandom（startColor/endColor無視）、=1でstartColor→endColor補間
     /// </summary>
-    void BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+    void BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                    uint32_t colorMode, const Vector4& startColor, const Vector4& endColor);
 
     /// <summary>
     /// 色 + サイズ範囲指定のバースト。uniformScale=true で幅=高さ（Xレンジを共用）。
     /// </summary>
-    void BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+    void BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                    uint32_t colorMode, const Vector4& startColor, const Vector4& endColor,
                    const Vector2& scaleMin, const Vector2& scaleMax, bool uniformScale);
 
     /// <summary>
     /// 粒子寿命まで指定するバージョン。Effect の totalDuration でクランプしたいとき等に使う。
     /// </summary>
-    void BurstEmit(const std::string& name, const Vector3& position, uint32_t count, float radius,
+    void BurstEmit(ParticleGroupId group, const Vector3& position, uint32_t count, float radius,
                    uint32_t colorMode, const Vector4& startColor, const Vector4& endColor,
                    const Vector2& scaleMin, const Vector2& scaleMax, bool uniformScale,
                    float particleLifeTime,
@@ -88,51 +101,53 @@ public:
     /// <summary>
     /// 連続発射のON/OFFと頻度設定
     /// </summary>
-    void SetContinuousEmit(const std::string& name, bool enabled, float frequency = 0.5f, uint32_t countPerEmit = 10, float radius = 1.0f);
-    void SetEmitterTranslate(const std::string& name, const Vector3& translate);
+    void SetContinuousEmit(ParticleGroupId group, bool enabled, float frequency = 0.5f, uint32_t countPerEmit = 10, float radius = 1.0f);
+    void SetEmitterTranslate(ParticleGroupId group, const Vector3& translate);
 
     /// <summary>
     /// 初速モードを設定。mode: 0=全方向ランダム(従来) / 1=baseVelocity固定 / 2=放射(中心から外、baseVelocity.x=速さ)。
     /// </summary>
-    void SetEmitterVelocity(const std::string& name, const Vector3& baseVelocity, float jitter, int mode = 1);
+    void SetEmitterVelocity(ParticleGroupId group, const Vector3& baseVelocity, float jitter, int mode = 1);
 
     /// <summary>
     /// 発生形状を設定。mode: 0=Sphere(従来) / 1=Ring（normal まわりの円周 + thickness の散らばり）。
     /// </summary>
-    void SetEmitterShape(const std::string& name, int mode, const Vector3& ringNormal, float ringThickness);
+    void SetEmitterShape(ParticleGroupId group, int mode, const Vector3& ringNormal, float ringThickness);
 
     /// <summary>
     /// 周回（orbit）を設定。enabled なら粒子を center まわりに axis で angularSpeed[rad/s] 回す（外に出さない）。
     /// center は毎フレ更新（プレイヤー追従など）して良い。
     /// </summary>
-    void SetGroupOrbit(const std::string& name, bool enabled, const Vector3& center,
+    void SetGroupOrbit(ParticleGroupId group, bool enabled, const Vector3& center,
                        const Vector3& spinAxis, float spinSpeed,
                        const Vector3& tumbleAxis, float tumbleSpeed);
 
     /// <summary>
     /// 収束（移動をカーブで制御）を設定。enable で各粒子を spawn 位置から center へ寄せる。
-    /// lut32 は convergeCurve(0..1) を 32 サンプルに焼いた配列（0=spawn, 1=center）。
+    /// lut32 は convergeCurve(0..1) を kConvergeLutSamples 個に焼いた配列（EffectLut::BakeCurve。0=spawn, 1=center）。
     /// 併せて velocityMode=4（emit 時に spawn 位置を保持）にしておくこと。
     /// </summary>
-    void SetGroupConverge(const std::string& name, bool enable, const Vector3& center, const float lut32[32]);
+    void SetGroupConverge(ParticleGroupId group, bool enable, const Vector3& center, const float lut32[kConvergeLutSamples]);
 
     /// <summary>
     /// 多色グラデーションを設定。locations(0..1) と colors の組を最大 kMaxGradientKeys 個。
     /// 2個未満なら無効化（粒子の start/end 2色補間に戻る）。CPU 側で location 昇順にソートして渡す。
     /// </summary>
-    void SetEmitterGradient(const std::string& name, const std::vector<std::pair<float, Vector4>>& keys);
+    void SetEmitterGradient(ParticleGroupId group, const std::vector<std::pair<float, Vector4>>& keys);
+    // 上と同じ。昇順に並べ済みのキーを配列で渡す版（EffectGradientLut の焼き済みキーをそのまま渡す）。
+    void SetEmitterGradient(ParticleGroupId group, const float* locations, const Vector4* colors, uint32_t count);
 
     /// <summary>
     /// 生存中のシームレスな色変化（Hue 回転）を設定。enable で寿命補間色の色相を時間に沿って回す。
     /// speed=1秒あたりの回転数（1.0=毎秒1周）。randomPhase で粒子ごとに位相をばらす（虹色ドリフト）。
     /// </summary>
-    void SetGroupHueShift(const std::string& name, bool enable, float speed, bool randomPhase);
+    void SetGroupHueShift(ParticleGroupId group, bool enable, float speed, bool randomPhase);
 
     /// <summary>
     /// グループの「粒子ごとの寿命ディゾルブ」を設定。各粒子が自分の寿命比率(0..1)に応じて
     /// In(出現:[0,inEnd]) / Out(消滅:[outStart,1]) でマスク discard される。maskPath 空 or enable=false で無効。
     /// </summary>
-    void SetGroupDissolve(const std::string& name, bool enable, const std::string& maskPath,
+    void SetGroupDissolve(ParticleGroupId group, bool enable, const std::string& maskPath,
                           bool inEnable, float inEnd, bool outEnable, float outStart,
                           bool edgeEnable, const Vector4& edgeColor, float edgeWidth);
 
@@ -140,15 +155,15 @@ public:
     /// 既存グループのテクスチャを差し替える（パスが変われば SRV を貼り直す）。
     /// グループ生成時のテクスチャを後から変更したいとき（エディタの D&D 等）に使う。
     /// </summary>
-    void SetGroupTexture(const std::string& name, const std::string& texturePath);
+    void SetGroupTexture(ParticleGroupId group, const std::string& texturePath);
 
     // ===== ブレンド / ビルボード / TimeGroup =====
     /// <summary>
     /// グループの描画ブレンドモードを設定（None=0..Screen=5）。加算では黒系粒子が映らないため Normal 等を選ぶ。
     /// </summary>
-    void SetGroupBlendMode(const std::string& name, int mode);
-    void SetGroupBillboardMode(const std::string& name, BillboardMode mode);
-    void SetGroupTimeGroup(const std::string& name, TimeGroup group);
+    void SetGroupBlendMode(ParticleGroupId group, int mode);
+    void SetGroupBillboardMode(ParticleGroupId group, BillboardMode mode);
+    void SetGroupTimeGroup(ParticleGroupId group, TimeGroup timeGroup);
 
     // ===== 毎フレーム =====
     // シーン用グループのみを更新する（プレビュー用グループはスキップ）。
@@ -162,9 +177,9 @@ public:
     // 併せて前フレームに遅延予約したプレビューグループを安全に解放する。
     void UpdatePreviewSim(float deltaTime);
 
-    // keepNames に無いプレビュー用グループを遅延解放キューへ移す（次フレーム頭で実解放）。
+    // keepGroups に無いプレビュー用グループを遅延解放キューへ移す（次フレーム頭で実解放）。
     // 「今プレビュー中のエフェクトが使うグループ」だけを残し、working set を有界化する。
-    void RecyclePreviewGroups(const std::vector<std::string>& keepNames);
+    void RecyclePreviewGroups(const std::vector<ParticleGroupId>& keepGroups);
 
     // プレビュー用 PerView（カメラ）を更新（メインの Update とは独立）
     void UpdatePreviewView(const Matrix4x4& viewMatrix, const Matrix4x4& viewProjectionMatrix, const Vector3& cameraPos);
@@ -223,7 +238,7 @@ private:
         float ringThickness;    // Ring の太さ
         float lifeScaleStart;   // 寿命開始時のサイズ倍率
         float lifeScaleEnd;     // 寿命終了時のサイズ倍率
-        float pad2;             // 16B境界合わせ
+        float seedOffset;       // 乱数の種ずらし（同じフレームの Emit が同じ並びにならないよう要求ごとに変える）
         Vector4 rotRandomRange; // .xyz=出現時ランダム初期姿勢の各軸最大角（rad）
         Vector4 rotateSpeed;    // .xyz=各軸の角速度（rad/s）
     };
@@ -283,6 +298,33 @@ private:
         Vector4 edgeColor = { 1.0f, 0.4f, 0.1f, 1.0f };
     };
 
+    // 共有アップロードバッファ内の 1 グループぶんの区画。CBV は 256 バイト境界なので各定数を 256 の倍数に丸めて並べる
+    static constexpr uint32_t kEmitterOffset        = 0;
+    static constexpr uint32_t kGradientOffset       = kEmitterOffset + ((sizeof(EmitterSphere) + 255) & ~255u);
+    static constexpr uint32_t kOrbitOffset          = kGradientOffset + ((sizeof(ParticleGradient) + 255) & ~255u);
+    static constexpr uint32_t kPerFrameOffset       = kOrbitOffset + ((sizeof(ParticleOrbit) + 255) & ~255u);
+    static constexpr uint32_t kPerViewOffset        = kPerFrameOffset + ((sizeof(PerFrame) + 255) & ~255u);
+    static constexpr uint32_t kPerViewPreviewOffset = kPerViewOffset + ((sizeof(PerView) + 255) & ~255u);
+    static constexpr uint32_t kDissolveOffset       = kPerViewPreviewOffset + ((sizeof(PerView) + 255) & ~255u);
+    static constexpr uint32_t kGroupConstantsStride = kDissolveOffset + ((sizeof(DissolveParticle) + 255) & ~255u);
+    // 共有アップロードバッファ 1 枚あたりのグループ数（足りなくなったら 1 枚ずつ足す。既存の区画は動かさない）
+    static constexpr uint32_t kGroupsPerConstantsPage = 64;
+    // バースト要求 1 件ぶんの EmitterSphere の区画と、バースト用アップロードバッファ 1 枚あたりの件数
+    static constexpr uint32_t kBurstStride = (sizeof(EmitterSphere) + 255) & ~255u;
+    static constexpr uint32_t kBurstsPerPage = 256;
+
+    // 控えのうち共有バッファへ写す必要がある区画
+    enum ConstantsDirtyBit : uint32_t {
+        kDirtyEmitter        = 1u << 0,
+        kDirtyGradient       = 1u << 1,
+        kDirtyOrbit          = 1u << 2,
+        kDirtyPerFrame       = 1u << 3,
+        kDirtyPerView        = 1u << 4,
+        kDirtyPerViewPreview = 1u << 5,
+        kDirtyDissolve       = 1u << 6,
+        kDirtyAll            = (1u << 7) - 1,
+    };
+
     // 1グループ分のリソース束
     struct GPUParticleGroup
     {
@@ -298,37 +340,26 @@ private:
         Microsoft::WRL::ComPtr<ID3D12Resource> freeListResource;
         uint32_t freeListUavIndex = 0;
 
-        // Emitter CB
-        Microsoft::WRL::ComPtr<ID3D12Resource> emitterResource;
-        EmitterSphere* emitterData = nullptr;
-
-        // Gradient CB（Update CS b1。多色グラデーション）
-        Microsoft::WRL::ComPtr<ID3D12Resource> gradientResource;
-        ParticleGradient* gradientData = nullptr;
-
-        // Orbit CB（Update CS b2。周回運動）
-        Microsoft::WRL::ComPtr<ID3D12Resource> orbitResource;
-        ParticleOrbit* orbitData = nullptr;
-
-        // PerFrame CB（TimeGroup によって dt が異なるため per-group）
-        Microsoft::WRL::ComPtr<ID3D12Resource> perFrameResource;
-        PerFrame* perFrameData = nullptr;
-
-        // PerView CB（メイン用）
-        Microsoft::WRL::ComPtr<ID3D12Resource> perViewResource;
-        PerView* perViewData = nullptr;
-
-        // PerView CB（プレビュー用、同じ粒子をプレビュー RT に別カメラで描画する）
-        Microsoft::WRL::ComPtr<ID3D12Resource> perViewPreviewResource;
-        PerView* perViewPreviewData = nullptr;
+        // 定数の CPU 側の控え。setter はここだけを書き、dirtyConstants の立った区画を
+        // FlushGroupConstants が共有アップロードバッファ（constantsPages_）の自グループの区画へ写す。
+        EmitterSphere    emitter{};        // Emit CS b0
+        ParticleGradient gradient{};       // Update CS b1（多色グラデーション）
+        ParticleOrbit    orbit{};          // Update CS b2（周回運動）
+        PerFrame         perFrame{};       // TimeGroup によって dt が異なるため per-group
+        PerView          perView{};        // メイン用
+        PerView          perViewPreview{}; // プレビュー用（同じ粒子をプレビュー RT に別カメラで描画する）
+        DissolveParticle dissolve{};       // 描画 PS b2
+        uint32_t         dirtyConstants = kDirtyAll;
+
+        // 共有アップロードバッファ内のこのグループの区画（kGroupConstantsStride バイト）
+        uint8_t* constantsMapped = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS constantsAddress = 0;
 
         // テクスチャ
         std::string textureFilePath;
         uint32_t textureSrvIndex = 0;
 
-        // ディゾルブ（描画 PS b2）＋マスク(t1)
-        Microsoft::WRL::ComPtr<ID3D12Resource> dissolveResource;
-        DissolveParticle* dissolveData = nullptr;
+        // ディゾルブのマスク(t1)
         std::string dissolveMaskPath;
         uint32_t dissolveMaskSrvIndex = 0;
         bool     hasDissolveMask = false;
@@ -340,9 +371,12 @@ private:
         bool          continuousEnabled = false;
         float         elapsedTime = 0.0f;
 
-        // バースト要求（Update で CB.emit に転写）。
-        // CPU 側で持つ理由：CB は persistent-mapped で、GPU が Emit CS を実行する前に CPU が書き換えるとレースになる。
-        bool          pendingBurst = false;
+        // バースト要求。BurstEmit が pendingBursts に積み、UpdateGroupSim で frameBursts へ移す。
+        // FlushGroupConstants が frameBursts を 1 件ずつバースト用アップロードバッファへ書き、その位置を
+        // frameBurstAddresses に控える（SimulateAndDrawGroup がその分だけ Emit CS を回す）。
+        std::vector<EmitterSphere>             pendingBursts;
+        std::vector<EmitterSphere>             frameBursts;
+        std::vector<D3D12_GPU_VIRTUAL_ADDRESS> frameBurstAddresses;
 
         // プレビュー専用グループ（名前が kPreviewPrefix 付き）。シーン用とは
         // 更新経路（unscaled delta）も描画経路（プレビュー PerView）も分ける。
@@ -375,12 +409,25 @@ private:
     Matrix4x4 fullBillboardMatrix_ = {};
     Vector3   cameraPosition_ = { 0.0f, 0.0f, 0.0f };
 
-    // グループ群
-    std::unordered_map<std::string, GPUParticleGroup> groups_;
+    // グループ群（名前は CreateGroup / FindGroup のときだけ引く）
+    ParticleGroupTable<GPUParticleGroup> groups_;
+
+    // 全グループの定数を置く persistent-mapped なアップロードバッファ（スロット番号で区画が決まる）
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> constantsPages_;
+    std::vector<uint8_t*> constantsPagesMapped_;
+
+    // バースト要求の EmitterSphere を置く persistent-mapped なアップロードバッファ（[0]=シーン用 / [1]=プレビュー用）。
+    // FlushGroupConstants のたびに先頭から詰め直す（前フレームの GPU は終わっている前提は constantsPages_ と同じ）。
+    struct BurstPages {
+        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> pages;
+        std::vector<uint8_t*> mapped;
+        uint32_t used = 0;
+    };
+    BurstPages burstPages_[2];
 
-    // 遅延解放待ちのプレビューグループ（フレーム途中の GPU 使用中バッファ解放を避けるため
-    // RecyclePreviewGroups で一旦ここへ退避し、次フレーム頭の UpdatePreviewSim で実解放する）。
-    std::vector<GPUParticleGroup> previewGroupPendingDelete_;
+    // 遅延解放待ちのプレビューグループのスロット（フレーム途中の GPU 使用中バッファ解放を避けるため
+    // RecyclePreviewGroups でハンドルだけ無効にしてここへ積み、次フレーム頭の UpdatePreviewSim で実解放する）。
+    std::vector<uint32_t> previewGroupPendingDelete_;
 
     // 内部ヘルパ
     void CreateInitializePipeline();
@@ -390,17 +437,22 @@ private:
     void CreateVertexData();
     void CreateMaterial();
 
-    void CreateGroupResources(GPUParticleGroup& g, const std::string& texturePath);
+    void CreateGroupResources(GPUParticleGroup& g, uint32_t slot, const std::string& texturePath);
     void ReleaseGroupResources(GPUParticleGroup& g);
 
     void DispatchInitializeCS(GPUParticleGroup& g);
+    // 連続発射の Emit と、このフレームのバースト要求ぶんの Emit を回す
     void DispatchEmitCS(GPUParticleGroup& g);
     void DispatchUpdateCS(GPUParticleGroup& g);
 
-    // 1グループ分の emit フラグ確定 + PerFrame(dt) 書き込み（Update / UpdatePreviewSim 共用）。
+    // バースト要求を 1 件積む（上限を超えたら捨てる）。
+    static void QueueBurst(GPUParticleGroup& g, const EmitterSphere& emitter);
+    // 1グループ分の emit フラグ・バースト要求の確定 + PerFrame(dt) 書き込み（Update / UpdatePreviewSim 共用）。
     void UpdateGroupSim(GPUParticleGroup& g, float dt);
+    // preview が一致するグループの変わった定数を共有アップロードバッファへ写す（Draw / DrawPreview の頭で 1 回）。
+    void FlushGroupConstants(bool preview);
     // 1グループを Init/Emit/Update CS でシミュレートし、指定 PerView CB で描画（Draw / DrawPreview 共用）。
-    void SimulateAndDrawGroup(GPUParticleGroup& g, ID3D12Resource* perViewCB);
+    void SimulateAndDrawGroup(GPUParticleGroup& g, D3D12_GPU_VIRTUAL_ADDRESS perViewAddress);
 
     void TransitionParticle(GPUParticleGroup& g, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after);
 };
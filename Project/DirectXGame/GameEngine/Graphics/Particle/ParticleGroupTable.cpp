@@ -0,0 +1,100 @@
+#include "ParticleGroupTable.h"
+#include "LogBuffer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    volatile uint32_t gBenchSink = 0;
+
+    // 計測用のグループ定数（エミッタ / 周回 / 収束 LUT / グラデーションの代わり）
+    struct BenchGroupConstants {
+        float translate[4];
+        float velocity[4];
+        float orbit[12];
+        float converge[32];
+        float gradient[16];
+        uint32_t flags[4];
+    };
+
+    // EffectInstance の 1 成分が毎フレーム行う setter 呼び出しを真似る（12 回）。Get は名前でもハンドルでも引ける関数
+    template <class GetFn>
+    void ApplyComponentSetters(GetFn&& get, uint32_t frame, uint32_t component) {
+        const float t = static_cast<float>(frame) * 0.016f + static_cast<float>(component);
+        if (BenchGroupConstants* c = get()) { for (int k = 0; k < 12; ++k) c->orbit[k] = t + k; }
+        if (BenchGroupConstants* c = get()) { c->flags[0] = frame; }
+        if (BenchGroupConstants* c = get()) { c->flags[1] = component; }
+        if (BenchGroupConstants* c = get()) { c->flags[2] = 2; }
+        if (BenchGroupConstants* c = get()) { c->flags[3] = frame ^ component; }
+        if (BenchGroupConstants* c = get()) { for (int k = 0; k < 32; ++k) c->converge[k] = k / 31.0f; }
+        if (BenchGroupConstants* c = get()) { c->velocity[0] = t; c->velocity[1] = 1.0f; c->velocity[2] = 0.0f; c->velocity[3] = 1.0f; }
+        if (BenchGroupConstants* c = get()) { c->velocity[3] = 2.0f; }
+        if (BenchGroupConstants* c = get()) { for (int k = 0; k < 16; ++k) c->gradient[k] = t * 0.5f + k; }
+        if (BenchGroupConstants* c = get()) { c->gradient[0] = t; }
+        if (BenchGroupConstants* c = get()) { c->translate[0] = t; c->translate[1] = 0.5f; c->translate[2] = -t; }
+        if (BenchGroupConstants* c = get()) { c->translate[3] = 1.0f; }
+    }
+}
+
+void RunParticleGroupLookupBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kGroups = 64;
+    constexpr uint32_t kFrames = 2000;
+    const char* kPrefix = "$preview$";  // GPUParticleManager::kPreviewPrefix と同じ
+
+    std::vector<std::string> baseNames(kGroups);
+    for (uint32_t i = 0; i < kGroups; ++i) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "effect_particle_component_%u", i);
+        baseNames[i] = name;
+    }
+
+    // 旧方式：毎フレーム成分ごとにプレフィックス付きの名前を作り、setter ごとに unordered_map を引いて
+    // 書き込み先（persistent-mapped な定数バッファの代わり）へ直接書く
+    std::unordered_map<std::string, BenchGroupConstants*> byName;
+    std::vector<BenchGroupConstants> mappedByName(kGroups);
+    for (uint32_t i = 0; i < kGroups; ++i) byName.emplace(kPrefix + baseNames[i], &mappedByName[i]);
+
+    auto t0 = Clock::now();
+    for (uint32_t frame = 0; frame < kFrames; ++frame) {
+        for (uint32_t i = 0; i < kGroups; ++i) {
+            const std::string groupName = std::string(kPrefix) + baseNames[i];
+            ApplyComponentSetters([&]() -> BenchGroupConstants* {
+                auto it = byName.find(groupName);
+                return (it != byName.end()) ? it->second : nullptr;
+            }, frame, i);
+        }
+    }
+    const double nameMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    // 新方式：ハンドルは一度だけ解決し、setter は CPU 側の控えへ書いて、フレーム末に全グループを 1 回で写す
+    ParticleGroupTable<BenchGroupConstants> table;
+    std::vector<ParticleGroupId> ids(kGroups);
+    for (uint32_t i = 0; i < kGroups; ++i) ids[i] = table.Add(kPrefix + baseNames[i], BenchGroupConstants{});
+    std::vector<BenchGroupConstants> mappedByHandle(kGroups);
+
+    t0 = Clock::now();
+    for (uint32_t frame = 0; frame < kFrames; ++frame) {
+        for (uint32_t i = 0; i < kGroups; ++i) {
+            const ParticleGroupId id = ids[i];
+            ApplyComponentSetters([&]() { return table.Get(id); }, frame, i);
+        }
+        uint32_t slot = 0;
+        table.ForEach([&](ParticleGroupId, BenchGroupConstants& c) {
+            std::memcpy(&mappedByHandle[slot++], &c, sizeof(BenchGroupConstants));
+        });
+    }
+    const double handleMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    const bool match = std::memcmp(mappedByName.data(), mappedByHandle.data(),
+                                   sizeof(BenchGroupConstants) * kGroups) == 0;
+    gBenchSink = mappedByHandle.back().flags[0];
+
+    const double calls = static_cast<double>(kFrames) * kGroups * 12.0;
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+        "[Particle] Group setters %u groups x 12 calls x %u frames: name lookup %.1f ns/call | handle + batched upload %.1f ns/call (x%.1f)  %s",
+        kGroups, kFrames, nameMs * 1e6 / calls, handleMs * 1e6 / calls,
+        (handleMs > 0.0) ? nameMs / handleMs : 0.0, match ? "match" : "MISMATCH");
+    LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// GPUParticleManager のグループを指すハンドル。CreateGroup / FindGroup が返す値で、以降の操作はこれで行う。
+/// 0 は無効値。下位 16bit がグループ表のスロット番号、上位 16bit がそのスロットの世代。
+/// グループが消えるとスロットの世代が進むので、古いハンドルが別のグループを指すことはない。
+/// </summary>
+using ParticleGroupId = uint32_t;
+constexpr ParticleGroupId kInvalidParticleGroupId = 0;
+
+/// <summary>
+/// 名前付きグループの世代つきスロット表。名前を引くのは登録と解決（Add / Find）のときだけで、
+/// 毎フレームの操作はハンドルからスロットを直接引く（文字列を作らない・ハッシュしない）。
+/// Detach したスロットは Free するまで再利用しないので、GPU が使い終わってから中身を片付けられる。
+/// </summary>
+template <class T>
+class ParticleGroupTable {
+public:
+    static constexpr uint32_t kMaxSlots = 0xFFFFu;
+    static constexpr uint32_t kInvalidSlot = 0xFFFFFFFFu;
+
+    /// <summary>name で value を登録してハンドルを返す。同名があればそのハンドルを返す（value は捨てる）。満杯なら無効値。</summary>
+    ParticleGroupId Add(const std::string& name, T&& value) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+
+        uint32_t slot = kInvalidSlot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            if (slots_.size() >= kMaxSlots) return kInvalidParticleGroupId;
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& s = slots_[slot];
+        s.value = std::move(value);
+        s.name = name;
+        s.alive = true;
+        const ParticleGroupId id = MakeId(slot, s.generation);
+        ids_.emplace(name, id);
+        ++aliveCount_;
+        return id;
+    }
+
+    ParticleGroupId Find(const std::string& name) const {
+        auto it = ids_.find(name);
+        return (it != ids_.end()) ? it->second : kInvalidParticleGroupId;
+    }
+
+    T* Get(ParticleGroupId id) {
+        const uint32_t slot = SlotOf(id);
+        if (slot >= slots_.size()) return nullptr;
+        Slot& s = slots_[slot];
+        return (s.alive && s.generation == GenerationOf(id)) ? &s.value : nullptr;
+    }
+    const T* Get(ParticleGroupId id) const {
+        return const_cast<ParticleGroupTable*>(this)->Get(id);
+    }
+
+    /// <summary>名前とハンドルを無効にし、スロット番号を返す（中身は Free まで残る）。無効なハンドルなら kInvalidSlot。</summary>
+    uint32_t Detach(ParticleGroupId id) {
+        if (!Get(id)) return kInvalidSlot;
+        const uint32_t slot = SlotOf(id);
+        Slot& s = slots_[slot];
+        ids_.erase(s.name);
+        s.name.clear();
+        s.alive = false;
+        s.generation = (s.generation + 1) & 0xFFFFu;
+        if (s.generation == 0) s.generation = 1;
+        --aliveCount_;
+        return slot;
+    }
+
+    /// <summary>Detach したスロットの中身を捨てて空きに戻す。</summary>
+    void Free(uint32_t slot) {
+        if (slot >= slots_.size() || slots_[slot].alive) return;
+        slots_[slot].value = T{};
+        freeSlots_.push_back(slot);
+    }
+
+    /// <summary>スロット番号で中身を引く（Detach 済みでも引ける）。</summary>
+    T& At(uint32_t slot) { return slots_[slot].value; }
+
+    /// <summary>ハンドルが指すグループの登録名（無効なハンドルなら空）。</summary>
+    const std::string& GetName(ParticleGroupId id) const {
+        static const std::string kEmpty;
+        return Get(id) ? slots_[SlotOf(id)].name : kEmpty;
+    }
+
+    /// <summary>生きているグループを f(id, value) で巡回（スロット順）。</summary>
+    template <class F>
+    void ForEach(F&& f) {
+        for (uint32_t slot = 0; slot < slots_.size(); ++slot) {
+            Slot& s = slots_[slot];
+            if (s.alive) f(MakeId(slot, s.generation), s.value);
+        }
+    }
+
+    void Clear() {
+        slots_.clear();
+        freeSlots_.clear();
+        ids_.clear();
+        aliveCount_ = 0;
+    }
+
+    size_t Size() const { return aliveCount_; }
+    bool Empty() const { return aliveCount_ == 0; }
+
+    static uint32_t SlotOf(ParticleGroupId id) { return id & 0xFFFFu; }
+    static uint32_t GenerationOf(ParticleGroupId id) { return id >> 16; }
+
+private:
+    static ParticleGroupId MakeId(uint32_t slot, uint32_t generation) {
+        return (generation << 16) | slot;
+    }
+
+    struct Slot {
+        T value{};
+        std::string name;
+        uint32_t generation = 1;
+        bool alive = false;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<std::string, ParticleGroupId> ids_;
+    size_t aliveCount_ = 0;
+};
+
+/// <summary>
+/// EffectInstance が 1 フレームに行うグループ操作（粒子成分ごとにプレフィックス付きの名前を作り、setter ごとに引く）を、
+/// 名前の unordered_map とハンドル表で比べて LogBuffer に出す。両方で書き込んだ値の一致も確かめる。
+/// </summary>
+void RunParticleGroupLookupBenchmark();
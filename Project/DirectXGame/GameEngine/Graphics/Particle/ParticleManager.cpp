@@ -32,6 +32,7 @@ void ParticleManager::Initialize(DirectXCore* dxCore, SRVManager* srvManager)
     // 共通リソース作成
     CreateVertexData();
     CreateMaterialResource();
+    CreatePerViewResource();
 
     // 乱数生成器の初期化
     std::random_device rd;
@@ -51,13 +52,18 @@ void ParticleManager::Finalize()
 
     vertexResource_.Reset();
     materialResource_.Reset();
+    if (perViewResource_) {
+        perViewResource_->Unmap(0, nullptr);
+        perViewResource_.Reset();
+    }
+    perViewData_ = nullptr;
     rootSignature_.Reset();
     for (auto& pso : pipelineStates_) {
         pso.Reset();
     }
 }
 
-void ParticleManager::CreateParticleGroup(const std::string& name, const std::string& textureFilePath)
+void ParticleManager::CreateParticleGroup(const std::string& name, const std::string& textureFilePath, uint32_t capacity)
 {
     // 登録済みの名前かチェック
     assert(particleGroups_.find(name) == particleGroups_.end());
@@ -74,8 +80,12 @@ void ParticleManager::CreateParticleGroup(const std::string& name, const std::st
     // マテリアルデータにテクスチャのSRVインデックスを記録
     group.textureSrvIndex = TextureManager::GetInstance()->GetSrvIndex(textureFilePath);
 
+    // 粒子の器（以降は確保しない）
+    group.capacity = capacity > 0 ? capacity : 1;
+    group.pool.Reserve(group.capacity);
+
     // インスタンシング用リソースの生成
-    group.instancingResource = dxCore_->CreateBufferResource(sizeof(ParticleForGPU) * kMaxInstanceCount);
+    group.instancingResource = dxCore_->CreateBufferResource(sizeof(ParticleInstanceGPU) * group.capacity);
 
     // インスタンシング用にSRVを確保してSRVインデックスを記録
     group.instancingSrvIndex = srvManager_->Allocate();
@@ -84,19 +94,15 @@ void ParticleManager::CreateParticleGroup(const std::string& name, const std::st
     srvManager_->CreateSRVForStructuredBuffer(
         group.instancingSrvIndex,
         group.instancingResource.Get(),
-        kMaxInstanceCount,
-        sizeof(ParticleForGPU)
+        group.capacity,
+        sizeof(ParticleInstanceGPU)
     );
 
     // インスタンシングデータを書き込むためのポインタを取得
     group.instancingResource->Map(0, nullptr, reinterpret_cast<void**>(&group.instancingData));
 
-    // 初期化
+    // 初期化（instanceCount 個より先は読まれないので中身はそのまま）
     group.instanceCount = 0;
-    for (uint32_t i = 0; i < kMaxInstanceCount; ++i) {
-        group.instancingData[i].WVP = MakeIdentity4x4();
-        group.instancingData[i].World = MakeIdentity4x4();
-    }
 
     // コンテナに登録
     particleGroups_[name] = std::move(group);
@@ -129,7 +135,7 @@ void ParticleManager::Emit(const std::string& name, const Vector3& position, uin
     std::uniform_real_distribution<float> distColor(0.0f, 1.0f);
 
     for (uint32_t i = 0; i < count; ++i) {
-        if (group.particles.size() >= kMaxInstanceCount) {
+        if (group.pool.GetCount() >= group.capacity) {
             break;
         }
 
@@ -180,7 +186,7 @@ void ParticleManager::Emit(const std::string& name, const Vector3& position, uin
         particle.lifeTime = 2.0f;
         particle.currentTime = 0.0f;
 
-        group.particles.push_back(particle);
+        group.pool.Push(particle);
     }
 }
 
@@ -199,7 +205,7 @@ void ParticleManager::Emit(const std::string& name, const EmitParam& param)
     std::uniform_real_distribution<float> distColor(0.0f, 1.0f);
 
     for (uint32_t i = 0; i < param.count; ++i) {
-        if (group.particles.size() >= kMaxInstanceCount) {
+        if (group.pool.GetCount() >= group.capacity) {
             break;
         }
 
@@ -250,7 +256,7 @@ void ParticleManager::Emit(const std::string& name, const EmitParam& param)
         // ビルボードモード
         particle.billboardMode = param.billboardMode;
 
-        group.particles.push_back(particle);
+        group.pool.Push(particle);
     }
 }
 
@@ -264,10 +270,8 @@ void ParticleManager::Update(float deltaTime)
 
     Matrix4x4 viewMatrix = camera_->GetViewMatrix();
     Matrix4x4 projectionMatrix = camera_->GetProjectionMatrix();
-    Matrix4x4 viewProjectionMatrix = Multiply(viewMatrix, projectionMatrix);
-    Vector3 cameraPos = camera_->GetTranslate();
 
-    // Full ビルボード行列（全パーティクル共通）
+    // Full ビルボード行列（全パーティクル共通）。YAxis はパーティクル位置に依存するので VS で組む
     Matrix4x4 billboardMatrix = MakeIdentity4x4();
     billboardMatrix.m[0][0] = viewMatrix.m[0][0];
     billboardMatrix.m[0][1] = viewMatrix.m[1][0];
@@ -279,103 +283,25 @@ void ParticleManager::Update(float deltaTime)
     billboardMatrix.m[2][1] = viewMatrix.m[1][2];
     billboardMatrix.m[2][2] = viewMatrix.m[2][2];
 
-    // YAxis ビルボード行列（パーティクル位置に依存するためラムダで都度計算）
-    auto makeYAxisBillboard = [&](const Vector3& objPos) -> Matrix4x4 {
-        float fx = cameraPos.x - objPos.x;
-        float fz = cameraPos.z - objPos.z;
-        float len = std::sqrt(fx * fx + fz * fz);
-        if (len < 1e-5f) {
-            // カメラが真上/真下にいる退避ケース：Z+方向を向ける
-            fx = 0.0f; fz = 1.0f;
-        } else {
-            fx /= len; fz /= len;
-        }
-        // forward=(fx,0,fz)、up=(0,1,0)、right=cross(up,forward)=(fz,0,-fx)
-        Matrix4x4 m = MakeIdentity4x4();
-        m.m[0][0] = fz;   m.m[0][1] = 0.0f; m.m[0][2] = -fx;
-        m.m[1][0] = 0.0f; m.m[1][1] = 1.0f; m.m[1][2] = 0.0f;
-        m.m[2][0] = fx;   m.m[2][1] = 0.0f; m.m[2][2] = fz;
-        return m;
-        };
+    perViewData_->viewProjection = Multiply(viewMatrix, projectionMatrix);
+    perViewData_->billboardMatrix = billboardMatrix;
+    perViewData_->cameraPosition = camera_->GetTranslate();
+    perViewData_->padding = 0.0f;
+
+    const AccelerationField* field = isAccelerationFieldEnabled_ ? &accelerationField_ : nullptr;
 
     // 全てのパーティクルグループについて処理する
     for (auto& pair : particleGroups_) {
         ParticleGroup& group = pair.second;
-        uint32_t instanceIndex = 0;
 
         // このグループの実dt（TimeGroup連動）。供給元（シーン）が無ければ deltaTime にフォールバック
         float groupDt = EngineTime::ScaledDeltaTime(group.timeGroup, deltaTime);
 
-        // グループ内の全てのパーティクルについて処理する
-        auto it = group.particles.begin();
-        while (it != group.particles.end()) {
-            Particle& particle = *it;
-
-            // 経過時間を加算
-            particle.currentTime += groupDt;
-
-            // 寿命に達していたらグループから外す
-            if (particle.currentTime >= particle.lifeTime) {
-                it = group.particles.erase(it);
-                continue;
-            }
-
-            // 場の影響を計算（加速）
-            if (isAccelerationFieldEnabled_) {
-                // Fieldの範囲内のParticleには加速度を適用する
-                if (IsCollision(accelerationField_.area, particle.transform.translate)) {
-                    particle.velocity.x += accelerationField_.acceleration.x * groupDt;
-                    particle.velocity.y += accelerationField_.acceleration.y * groupDt;
-                    particle.velocity.z += accelerationField_.acceleration.z * groupDt;
-                }
-            }
-
-            // 移動処理（速度を座標に加算）
-            particle.transform.translate.x += particle.velocity.x * groupDt;
-            particle.transform.translate.y += particle.velocity.y * groupDt;
-            particle.transform.translate.z += particle.velocity.z * groupDt;
-
-            Matrix4x4 scaleMatrix = MakeScaleMatrix(particle.transform);
-            Matrix4x4 translateMatrix = MakeTranslateMatrix(particle.transform);
-
-            // 回転行列を作成（XYZ統合）
-            Matrix4x4 rotateMatrix = MakeRotateMatrix(particle.transform.rotate);
-
-            // ビルボードの適用有無で処理を分岐
-            Matrix4x4 worldMatrix;
-            if (particle.billboardMode == BillboardMode::Full) {
-                // Scale → Rotate（自己回転）→ Billboard（カメラ向き）→ Translate
-                worldMatrix = Multiply(
-                    Multiply(Multiply(scaleMatrix, rotateMatrix), billboardMatrix),
-                    translateMatrix);
-            } else if (particle.billboardMode == BillboardMode::YAxis) {
-                Matrix4x4 yBillboard = makeYAxisBillboard(particle.transform.translate);
-                worldMatrix = Multiply(
-                    Multiply(Multiply(scaleMatrix, rotateMatrix), yBillboard),
-                    translateMatrix);
-            } else {
-                // Scale → Rotate → Translate（ビルボードなし）
-                worldMatrix = Multiply(
-                    Multiply(scaleMatrix, rotateMatrix),
-                    translateMatrix);
-            }
-
-            // ワールドビュープロジェクション行列を合成
-            Matrix4x4 wvpMatrix = Multiply(worldMatrix, viewProjectionMatrix);
-
-            // インスタンシング用データ1個分の書き込み
-            if (instanceIndex < kMaxInstanceCount) {
-                group.instancingData[instanceIndex].WVP = wvpMatrix;
-                group.instancingData[instanceIndex].World = worldMatrix;
-                group.instancingData[instanceIndex].color = particle.color;
-                instanceIndex++;
-            }
-
-            ++it;
-        }
+        // 経過時間・場の加速・移動・寿命切れの除去（SoA のまままとめて）
+        group.pool.Update(groupDt, field);
 
-        // インスタンス数を記録
-        group.instanceCount = instanceIndex;
+        // インスタンシング用データの書き込み（行列は VS で組む）
+        group.instanceCount = group.pool.WriteInstances(group.instancingData, group.capacity);
     }
 }
 
@@ -400,6 +326,9 @@ void ParticleManager::Draw()
     // マテリアルCBVをセット（RootParameter[1]）
     commandList->SetGraphicsRootConstantBufferView(1, materialResource_->GetGPUVirtualAddress());
 
+    // カメラ情報CBVをセット（RootParameter[4]）
+    commandList->SetGraphicsRootConstantBufferView(4, perViewResource_->GetGPUVirtualAddress());
+
     // 全てのパーティクルグループについて処理する
     for (auto& pair : particleGroups_) {
         ParticleGroup& group = pair.second;
@@ -436,7 +365,7 @@ void ParticleManager::OnImGui()
             const char* timeGroupItems[] = { "World", "Player", "UI", "Effect" };
             for (auto& pair : particleGroups_) {
                 ImGui::PushID(pair.first.c_str());
-                ImGui::Text("%s (%zu)", pair.first.c_str(), pair.second.particles.size());
+                ImGui::Text("%s (%u / %u)", pair.first.c_str(), pair.second.pool.GetCount(), pair.second.capacity);
                 int tg = static_cast<int>(pair.second.timeGroup);
                 if (ImGui::Combo("Time Group", &tg, timeGroupItems, IM_ARRAYSIZE(timeGroupItems))) {
                     pair.second.timeGroup = static_cast<TimeGroup>(tg);
@@ -483,7 +412,7 @@ void ParticleManager::OnImGui()
     //    ImGui::Text("Particle Info");
     //    uint32_t totalCount = 0;
     //    for (const auto& pair : particleGroups_) {
-    //        totalCount += static_cast<uint32_t>(pair.second.particles.size());
+    //        totalCount += pair.second.pool.GetCount();
     //    }
     //    ImGui::Text("Total Particles: %u", totalCount);
     //}
@@ -492,16 +421,6 @@ void ParticleManager::OnImGui()
 #endif // DEBUG
 }
 
-bool ParticleManager::IsCollision(const AABB& aabb, const Vector3& point)
-{
-    if (point.x >= aabb.min.x && point.x <= aabb.max.x &&
-        point.y >= aabb.min.y && point.y <= aabb.max.y &&
-        point.z >= aabb.min.z && point.z <= aabb.max.z) {
-        return true;
-    }
-    return false;
-}
-
 void ParticleManager::CreateRootSignature()
 {
     HRESULT hr;
@@ -520,7 +439,7 @@ void ParticleManager::CreateRootSignature()
     descriptorRangeTexture[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
     descriptorRangeTexture[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-    D3D12_ROOT_PARAMETER rootParameters[4] = {};
+    D3D12_ROOT_PARAMETER rootParameters[5] = {};
 
     // [0] VS: DescriptorTable - インスタンシングデータ(t0)
     rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
@@ -544,6 +463,11 @@ void ParticleManager::CreateRootSignature()
     rootParameters[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
     rootParameters[3].Descriptor.ShaderRegister = 1;
 
+    // [4] VS: CBV(b0) - カメラ情報（PerView）
+    rootParameters[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+    rootParameters[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+    rootParameters[4].Descriptor.ShaderRegister = 0;
+
     // Sampler
     D3D12_STATIC_SAMPLER_DESC staticSamplers[1] = {};
     staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -755,4 +679,15 @@ void ParticleManager::CreateMaterialResource()
     materialData->uvTransform = MakeIdentity4x4();
 
     materialResource_->Unmap(0, nullptr);
+}
+
+void ParticleManager::CreatePerViewResource()
+{
+    // カメラ情報用バッファ作成（Update で毎フレーム書くので Map したまま）
+    perViewResource_ = dxCore_->CreateBufferResource(sizeof(ParticlePerView));
+    perViewResource_->Map(0, nullptr, reinterpret_cast<void**>(&perViewData_));
+    perViewData_->viewProjection = MakeIdentity4x4();
+    perViewData_->billboardMatrix = MakeIdentity4x4();
+    perViewData_->cameraPosition = { 0.0f, 0.0f, 0.0f };
+    perViewData_->padding = 0.0f;
 }
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include <d3d12.h>
 #include <array>
 #include <unordered_map>
-#include <list>
 #include <string>
 #include "SRVManager.h"
 #include "Vector3.h"
@@ -14,39 +13,20 @@
 #include "EmitParam.h"
 #include "BillboardMode.h"
 #include "TimeGroup.h"
+#include "ParticlePool.h"
 #include <random>
 
 // 前方宣言
 class Camera;
 
-// パーティクル1個分のデータ
-struct Particle {
-    Transform transform;
-    Vector3 velocity;
-    Vector4 color;
-    float lifeTime;
-    float currentTime;
-    BillboardMode billboardMode = BillboardMode::Full;
-};
-
-// AABB
-struct AABB {
-    Vector3 min; //!< 最小点
-    Vector3 max; //!< 最大点
-};
-
-// 加速度フィールド
-struct AccelerationField {
-    Vector3 acceleration; //!< 加速度
-    AABB area;            //!< 範囲
-};
-
+// Particle / AABB / AccelerationField / ParticleInstanceGPU は ParticlePool.h
 
-// GPU送信用の行列データ
-struct ParticleForGPU {
-    Matrix4x4 WVP;
-    Matrix4x4 World;
-    Vector4 color;
+// VS 用のカメラ情報（Particle.VS.hlsl の PerView と同レイアウト）
+struct ParticlePerView {
+    Matrix4x4 viewProjection;
+    Matrix4x4 billboardMatrix;  // Full ビルボード用
+    Vector3   cameraPosition;   // YAxis ビルボード用
+    float     padding;
 };
 
 // エミッター設定
@@ -63,14 +43,15 @@ struct ParticleGroup {
     std::string textureFilePath;
     uint32_t textureSrvIndex;
 
-    // パーティクルのリスト
-    std::list<Particle> particles;
+    // パーティクル（SoA、capacity 個まで）
+    ParticlePool pool;
+    uint32_t capacity = 0;
 
-    // インスタンシング用データ
+    // インスタンシング用データ（位置・スケール・回転・色だけ送り、行列は VS で組む）
     uint32_t instancingSrvIndex;
     Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource;
     uint32_t instanceCount;
-    ParticleForGPU* instancingData;
+    ParticleInstanceGPU* instancingData;
 
     // このグループの時間グループ（World/Player/UI 別倍率）
     TimeGroup timeGroup = TimeGroup::World;
@@ -99,8 +80,12 @@ public:
     // 終了処理
     void Finalize();
 
-    // パーティクルグループの生成
-    void CreateParticleGroup(const std::string& name, const std::string& textureFilePath);
+    // グループ容量の既定値（CreateParticleGroup で capacity を省略したとき）
+    static constexpr uint32_t kDefaultGroupCapacity = 1000;
+
+    // パーティクルグループの生成（capacity 個ぶんの粒子とインスタンスバッファを先に確保する）
+    void CreateParticleGroup(const std::string& name, const std::string& textureFilePath,
+                             uint32_t capacity = kDefaultGroupCapacity);
 
     /// <summary>
     /// 指定した名前のパーティクルグループを削除する
@@ -183,9 +168,6 @@ private:
     std::random_device seedGenerator_;
     std::mt19937 randomEngine_{ seedGenerator_() };
 
-    // AABBと点の当たり判定
-    bool IsCollision(const AABB& aabb, const Vector3& point);
-
     // 加速度フィールド
     AccelerationField accelerationField_;
     bool isAccelerationFieldEnabled_ = false;
@@ -205,12 +187,14 @@ private:
     // マテリアルリソース（全グループ共通）
     Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
 
-    // 最大インスタンス数
-    static const uint32_t kMaxInstanceCount = 1000;
+    // カメラ情報（全グループ共通、Update で書く）
+    Microsoft::WRL::ComPtr<ID3D12Resource> perViewResource_;
+    ParticlePerView* perViewData_ = nullptr;
 
 private:
     void CreateRootSignature();
     void CreateGraphicsPipelineState(BlendMode mode);
     void CreateVertexData();
     void CreateMaterialResource();
+    void CreatePerViewResource();
 };
\ No newline at end of file
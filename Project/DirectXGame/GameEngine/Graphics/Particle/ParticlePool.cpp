@@ -0,0 +1,382 @@
+#include "ParticlePool.h"
+#include "MathUtility.h"
+#include "LogBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <emmintrin.h>
+#include <list>
+#include <random>
+#include <string>
+
+void ParticlePool::Reserve(uint32_t capacity) {
+    const size_t padded = (static_cast<size_t>(capacity) + 3) & ~size_t{ 3 };
+    for (std::vector<float>* v : { &translateX_, &translateY_, &translateZ_,
+                                   &velocityX_, &velocityY_, &velocityZ_,
+                                   &scaleX_, &scaleY_, &scaleZ_,
+                                   &rotateX_, &rotateY_, &rotateZ_,
+                                   &lifeTime_, &currentTime_ }) {
+        v->assign(padded, 0.0f);
+    }
+    color_.assign(padded, Vector4{ 0.0f, 0.0f, 0.0f, 0.0f });
+    billboardMode_.assign(padded, 0u);
+    capacity_ = capacity;
+    count_ = 0;
+}
+
+bool ParticlePool::Push(const Particle& particle) {
+    if (count_ >= capacity_) return false;
+    const uint32_t i = count_++;
+    translateX_[i] = particle.transform.translate.x;
+    translateY_[i] = particle.transform.translate.y;
+    translateZ_[i] = particle.transform.translate.z;
+    velocityX_[i] = particle.velocity.x;
+    velocityY_[i] = particle.velocity.y;
+    velocityZ_[i] = particle.velocity.z;
+    scaleX_[i] = particle.transform.scale.x;
+    scaleY_[i] = particle.transform.scale.y;
+    scaleZ_[i] = particle.transform.scale.z;
+    rotateX_[i] = particle.transform.rotate.x;
+    rotateY_[i] = particle.transform.rotate.y;
+    rotateZ_[i] = particle.transform.rotate.z;
+    color_[i] = particle.color;
+    lifeTime_[i] = particle.lifeTime;
+    currentTime_[i] = particle.currentTime;
+    billboardMode_[i] = static_cast<uint32_t>(particle.billboardMode);
+    return true;
+}
+
+void ParticlePool::Move(uint32_t src, uint32_t dst) {
+    translateX_[dst] = translateX_[src];
+    translateY_[dst] = translateY_[src];
+    translateZ_[dst] = translateZ_[src];
+    velocityX_[dst] = velocityX_[src];
+    velocityY_[dst] = velocityY_[src];
+    velocityZ_[dst] = velocityZ_[src];
+    scaleX_[dst] = scaleX_[src];
+    scaleY_[dst] = scaleY_[src];
+    scaleZ_[dst] = scaleZ_[src];
+    rotateX_[dst] = rotateX_[src];
+    rotateY_[dst] = rotateY_[src];
+    rotateZ_[dst] = rotateZ_[src];
+    color_[dst] = color_[src];
+    lifeTime_[dst] = lifeTime_[src];
+    currentTime_[dst] = currentTime_[src];
+    billboardMode_[dst] = billboardMode_[src];
+}
+
+void ParticlePool::Update(float deltaTime, const AccelerationField* field) {
+    if (count_ == 0) return;
+
+    // 経過時間・加速・移動（寿命切れもまとめて進めて、あとで捨てる）
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    float* px = translateX_.data();
+    float* py = translateY_.data();
+    float* pz = translateZ_.data();
+    float* vx = velocityX_.data();
+    float* vy = velocityY_.data();
+    float* vz = velocityZ_.data();
+    float* time = currentTime_.data();
+
+    if (field) {
+        const __m128 minX = _mm_set1_ps(field->area.min.x);
+        const __m128 minY = _mm_set1_ps(field->area.min.y);
+        const __m128 minZ = _mm_set1_ps(field->area.min.z);
+        const __m128 maxX = _mm_set1_ps(field->area.max.x);
+        const __m128 maxY = _mm_set1_ps(field->area.max.y);
+        const __m128 maxZ = _mm_set1_ps(field->area.max.z);
+        const __m128 accX = _mm_mul_ps(_mm_set1_ps(field->acceleration.x), dt);
+        const __m128 accY = _mm_mul_ps(_mm_set1_ps(field->acceleration.y), dt);
+        const __m128 accZ = _mm_mul_ps(_mm_set1_ps(field->acceleration.z), dt);
+        for (uint32_t i = 0; i < count_; i += 4) {
+            _mm_storeu_ps(time + i, _mm_add_ps(_mm_loadu_ps(time + i), dt));
+
+            __m128 x = _mm_loadu_ps(px + i);
+            __m128 y = _mm_loadu_ps(py + i);
+            __m128 z = _mm_loadu_ps(pz + i);
+            // 範囲内（境界を含む）のものだけ加速
+            __m128 inside = _mm_and_ps(_mm_cmpge_ps(x, minX), _mm_cmple_ps(x, maxX));
+            inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(y, minY), _mm_cmple_ps(y, maxY)));
+            inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, minZ), _mm_cmple_ps(z, maxZ)));
+            __m128 velX = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_and_ps(inside, accX));
+            __m128 velY = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_and_ps(inside, accY));
+            __m128 velZ = _mm_add_ps(_mm_loadu_ps(vz + i), _mm_and_ps(inside, accZ));
+            _mm_storeu_ps(vx + i, velX);
+            _mm_storeu_ps(vy + i, velY);
+            _mm_storeu_ps(vz + i, velZ);
+
+            _mm_storeu_ps(px + i, _mm_add_ps(x, _mm_mul_ps(velX, dt)));
+            _mm_storeu_ps(py + i, _mm_add_ps(y, _mm_mul_ps(velY, dt)));
+            _mm_storeu_ps(pz + i, _mm_add_ps(z, _mm_mul_ps(velZ, dt)));
+        }
+    } else {
+        for (uint32_t i = 0; i < count_; i += 4) {
+            _mm_storeu_ps(time + i, _mm_add_ps(_mm_loadu_ps(time + i), dt));
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt)));
+            _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt)));
+            _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(_mm_loadu_ps(vz + i), dt)));
+        }
+    }
+
+    // 寿命切れを末尾と入れ替えて詰める。4 個とも生きている塊は比較 1 回で飛ばす
+    const float* life = lifeTime_.data();
+    uint32_t i = 0;
+    while (i < count_) {
+        if (i + 4 <= count_) {
+            const int dead = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(time + i), _mm_loadu_ps(life + i)));
+            if (dead == 0) {
+                i += 4;
+                continue;
+            }
+            // 塊の中で最初の寿命切れまで進める
+            uint32_t lane = 0;
+            while (!(dead & (1 << lane))) ++lane;
+            i += lane;
+        } else if (time[i] < life[i]) {
+            ++i;
+            continue;
+        }
+        --count_;
+        if (i != count_) Move(count_, i);
+    }
+}
+
+uint32_t ParticlePool::WriteInstances(ParticleInstanceGPU* out, uint32_t maxCount) const {
+    const uint32_t n = count_ < maxCount ? count_ : maxCount;
+    for (uint32_t i = 0; i < n; ++i) {
+        // 書き込み先はアップロードヒープ（write-combined）なので 1 個ぶんを組んでから一度に書く
+        ParticleInstanceGPU instance;
+        instance.translate = { translateX_[i], translateY_[i], translateZ_[i] };
+        instance.billboardMode = billboardMode_[i];
+        instance.scale = { scaleX_[i], scaleY_[i], scaleZ_[i] };
+        instance.padding0 = 0.0f;
+        instance.rotate = { rotateX_[i], rotateY_[i], rotateZ_[i] };
+        instance.padding1 = 0.0f;
+        instance.color = color_[i];
+        out[i] = instance;
+    }
+    return n;
+}
+
+namespace {
+    volatile float gBenchSink = 0.0f;
+
+    // 旧方式の GPU データ（ParticleManager が以前送っていたもの）
+    struct LegacyParticleForGPU {
+        Matrix4x4 WVP;
+        Matrix4x4 World;
+        Vector4 color;
+    };
+
+    Matrix4x4 MakeFullBillboard(const Matrix4x4& viewMatrix) {
+        Matrix4x4 m = MakeIdentity4x4();
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) m.m[r][c] = viewMatrix.m[c][r];
+        }
+        return m;
+    }
+
+    Matrix4x4 MakeYAxisBillboard(const Vector3& cameraPos, const Vector3& objPos) {
+        float fx = cameraPos.x - objPos.x;
+        float fz = cameraPos.z - objPos.z;
+        float len = std::sqrt(fx * fx + fz * fz);
+        if (len < 1e-5f) {
+            fx = 0.0f; fz = 1.0f;
+        } else {
+            fx /= len; fz /= len;
+        }
+        Matrix4x4 m = MakeIdentity4x4();
+        m.m[0][0] = fz;   m.m[0][1] = 0.0f; m.m[0][2] = -fx;
+        m.m[1][0] = 0.0f; m.m[1][1] = 1.0f; m.m[1][2] = 0.0f;
+        m.m[2][0] = fx;   m.m[2][1] = 0.0f; m.m[2][2] = fz;
+        return m;
+    }
+
+    // 旧 ParticleManager::Update と同じ処理（list を回して寿命切れを erase、粒子ごとに行列を組む）
+    uint32_t LegacyUpdate(std::list<Particle>& particles, float dt, const AccelerationField* field,
+                          const Matrix4x4& viewProjection, const Matrix4x4& billboard, const Vector3& cameraPos,
+                          LegacyParticleForGPU* out, uint32_t maxCount) {
+        uint32_t instanceIndex = 0;
+        auto it = particles.begin();
+        while (it != particles.end()) {
+            Particle& particle = *it;
+            particle.currentTime += dt;
+            if (particle.currentTime >= particle.lifeTime) {
+                it = particles.erase(it);
+                continue;
+            }
+            if (field) {
+                const Vector3& p = particle.transform.translate;
+                if (p.x >= field->area.min.x && p.x <= field->area.max.x &&
+                    p.y >= field->area.min.y && p.y <= field->area.max.y &&
+                    p.z >= field->area.min.z && p.z <= field->area.max.z) {
+                    particle.velocity.x += field->acceleration.x * dt;
+                    particle.velocity.y += field->acceleration.y * dt;
+                    particle.velocity.z += field->acceleration.z * dt;
+                }
+            }
+            particle.transform.translate.x += particle.velocity.x * dt;
+            particle.transform.translate.y += particle.velocity.y * dt;
+            particle.transform.translate.z += particle.velocity.z * dt;
+
+            Matrix4x4 scaleMatrix = MakeScaleMatrix(particle.transform);
+            Matrix4x4 translateMatrix = MakeTranslateMatrix(particle.transform);
+            Matrix4x4 rotateMatrix = MakeRotateMatrix(particle.transform.rotate);
+            Matrix4x4 worldMatrix;
+            if (particle.billboardMode == BillboardMode::Full) {
+                worldMatrix = Multiply(Multiply(Multiply(scaleMatrix, rotateMatrix), billboard), translateMatrix);
+            } else if (particle.billboardMode == BillboardMode::YAxis) {
+                worldMatrix = Multiply(Multiply(Multiply(scaleMatrix, rotateMatrix),
+                    MakeYAxisBillboard(cameraPos, particle.transform.translate)), translateMatrix);
+            } else {
+                worldMatrix = Multiply(Multiply(scaleMatrix, rotateMatrix), translateMatrix);
+            }
+            if (instanceIndex < maxCount) {
+                out[instanceIndex].WVP = Multiply(worldMatrix, viewProjection);
+                out[instanceIndex].World = worldMatrix;
+                out[instanceIndex].color = particle.color;
+                ++instanceIndex;
+            }
+            ++it;
+        }
+        return instanceIndex;
+    }
+
+    // Particle.VS.hlsl と同じ手順で World を組む（シェーダーの式の確認用）
+    Matrix4x4 BuildWorldLikeVS(const ParticleInstanceGPU& p, const Matrix4x4& billboard, const Vector3& cameraPos) {
+        Matrix4x4 basis = MakeRotateMatrix(p.rotate);
+        if (p.billboardMode == static_cast<uint32_t>(BillboardMode::Full)) {
+            basis = Multiply(basis, billboard);
+        } else if (p.billboardMode == static_cast<uint32_t>(BillboardMode::YAxis)) {
+            basis = Multiply(basis, MakeYAxisBillboard(cameraPos, p.translate));
+        }
+        const float scale[3] = { p.scale.x, p.scale.y, p.scale.z };
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) basis.m[r][c] *= scale[r];
+        }
+        basis.m[3][0] = p.translate.x;
+        basis.m[3][1] = p.translate.y;
+        basis.m[3][2] = p.translate.z;
+        return basis;
+    }
+
+    Particle MakeRandomParticle(std::mt19937& rng) {
+        std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> vel(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        Particle p;
+        p.transform.translate = { pos(rng), pos(rng), pos(rng) };
+        p.transform.scale = { 0.2f + unit(rng), 0.2f + unit(rng), 1.0f };
+        // 1/4 だけ自己回転あり
+        p.transform.rotate = (rng() % 4 == 0) ? Vector3{ unit(rng) * 3.0f, unit(rng) * 3.0f, unit(rng) * 3.0f } : Vector3{ 0.0f, 0.0f, 0.0f };
+        p.velocity = { vel(rng), vel(rng), vel(rng) };
+        p.color = { unit(rng), unit(rng), unit(rng), 1.0f };
+        p.lifeTime = 0.3f + unit(rng) * 2.0f;
+        p.currentTime = 0.0f;
+        const uint32_t mode = rng() % 8;
+        p.billboardMode = (mode < 6) ? BillboardMode::Full : (mode == 6 ? BillboardMode::YAxis : BillboardMode::None);
+        return p;
+    }
+
+    bool LessXYZ(const Vector3& a, const Vector3& b) {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    }
+}
+
+void RunParticlePoolBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kFrames = 60;
+    constexpr float kDt = 1.0f / 60.0f;
+
+    const Vector3 cameraPos = { 4.0f, 6.0f, -25.0f };
+    const Matrix4x4 viewMatrix = MakeLookAtMatrix(cameraPos, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    const Matrix4x4 viewProjection = Multiply(viewMatrix, MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f));
+    const Matrix4x4 billboard = MakeFullBillboard(viewMatrix);
+
+    AccelerationField field;
+    field.acceleration = { 0.0f, -9.8f, 2.0f };
+    field.area = { { -10.0f, 0.0f, -10.0f }, { 10.0f, 10.0f, 10.0f } };
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Particle] CPU particles: %d frames, field on, GPU data %zu -> %zu bytes/particle (ms per frame)",
+        kFrames, sizeof(LegacyParticleForGPU), sizeof(ParticleInstanceGPU));
+    LogBuffer::Instance().Add(buf);
+
+    for (uint32_t count : { 10000u, 100000u }) {
+        std::mt19937 rng(20261017u + count);
+        std::list<Particle> legacy;
+        ParticlePool pool;
+        pool.Reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const Particle p = MakeRandomParticle(rng);
+            legacy.push_back(p);
+            pool.Push(p);
+        }
+        std::vector<LegacyParticleForGPU> legacyOut(count);
+        std::vector<ParticleInstanceGPU> poolOut(count);
+
+        uint32_t legacyInstances = 0;
+        auto t0 = Clock::now();
+        for (int f = 0; f < kFrames; ++f) {
+            legacyInstances = LegacyUpdate(legacy, kDt, &field, viewProjection, billboard, cameraPos, legacyOut.data(), count);
+        }
+        const double legacyMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kFrames;
+
+        uint32_t poolInstances = 0;
+        t0 = Clock::now();
+        for (int f = 0; f < kFrames; ++f) {
+            pool.Update(kDt, &field);
+            poolInstances = pool.WriteInstances(poolOut.data(), count);
+        }
+        const double poolMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kFrames;
+
+        // 生存数と位置（並び順は違うので並べ替えて）が旧方式と完全に一致するか
+        bool match = legacyInstances == poolInstances && legacy.size() == pool.GetCount();
+        if (match) {
+            std::vector<Vector3> a;
+            std::vector<Vector3> b;
+            a.reserve(legacy.size());
+            b.reserve(pool.GetCount());
+            for (const Particle& p : legacy) a.push_back(p.transform.translate);
+            for (uint32_t i = 0; i < pool.GetCount(); ++i) b.push_back(pool.GetTranslate(i));
+            std::sort(a.begin(), a.end(), LessXYZ);
+            std::sort(b.begin(), b.end(), LessXYZ);
+            for (size_t i = 0; match && i < a.size(); ++i) {
+                match = a[i].x == b[i].x && a[i].y == b[i].y && a[i].z == b[i].z;
+            }
+        }
+
+        std::snprintf(buf, sizeof(buf), "[Particle] %6u: list + matrices %.3f ms | SoA SSE2 + compact %.3f ms (x%.1f) | alive %u  %s",
+            count, legacyMs, poolMs, (poolMs > 0.0) ? legacyMs / poolMs : 0.0, pool.GetCount(), match ? "match" : "MISMATCH");
+        LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+        if (poolInstances > 0) gBenchSink = poolOut[poolInstances - 1].translate.x + legacyOut[0].WVP.m[0][0];
+    }
+
+    // VS で組む World（Scale → Rotate → Billboard → Translate）が旧方式の行列と同じになるか
+    std::mt19937 rng(7u);
+    float maxErr = 0.0f;
+    for (int i = 0; i < 4096; ++i) {
+        const Particle p = MakeRandomParticle(rng);
+        ParticlePool one;
+        one.Reserve(1);
+        one.Push(p);
+        ParticleInstanceGPU instance;
+        one.WriteInstances(&instance, 1);
+
+        std::list<Particle> list{ p };
+        list.front().lifeTime = 1.0f;
+        LegacyParticleForGPU legacyOut;
+        LegacyUpdate(list, 0.0f, nullptr, viewProjection, billboard, cameraPos, &legacyOut, 1);
+
+        const Matrix4x4 world = BuildWorldLikeVS(instance, billboard, cameraPos);
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) maxErr = std::max(maxErr, std::abs(world.m[r][c] - legacyOut.World.m[r][c]));
+        }
+    }
+    const bool ok = maxErr < 1e-4f;
+    std::snprintf(buf, sizeof(buf), "[Particle] VS world matrix vs legacy CPU matrix: max err %.2e  %s", maxErr, ok ? "ok" : "WRONG");
+    LogBuffer::Instance().Add(buf, ok ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Transform.h"
+#include "BillboardMode.h"
+#include <cstdint>
+#include <vector>
+
+// パーティクル1個分のデータ（発生時の指定に使う。保持は ParticlePool の SoA）
+struct Particle {
+    Transform transform;
+    Vector3 velocity;
+    Vector4 color;
+    float lifeTime;
+    float currentTime;
+    BillboardMode billboardMode = BillboardMode::Full;
+};
+
+// AABB
+struct AABB {
+    Vector3 min; //!< 最小点
+    Vector3 max; //!< 最大点
+};
+
+// 加速度フィールド
+struct AccelerationField {
+    Vector3 acceleration; //!< 加速度
+    AABB area;            //!< 範囲
+};
+
+// GPU送信用のインスタンスデータ（Particle.VS.hlsl の ParticleInstance と同レイアウト、64 バイト）。
+// 行列は送らず、VS で Scale → Rotate → Billboard → Translate を組む。
+struct ParticleInstanceGPU {
+    Vector3  translate;
+    uint32_t billboardMode;  // BillboardMode の値（0=None, 1=Full, 2=YAxis）
+    Vector3  scale;
+    float    padding0;
+    Vector3  rotate;
+    float    padding1;
+    Vector4  color;
+};
+
+/// <summary>
+/// CPU パーティクルの SoA プール。要素ごとに別配列で持ち、容量ぶんを先に確保する（以降は確保しない）。
+/// 経過時間・加速度フィールド・移動は SSE2 で 4 個ずつ進め、寿命切れは末尾と入れ替えて詰める
+/// （そのため並び順は発生順を保たない）。D3D に依存しないので単体で計れる。
+/// </summary>
+class ParticlePool {
+public:
+    /// <summary>capacity 個ぶん確保し直す（中身は捨てる）。</summary>
+    void Reserve(uint32_t capacity);
+
+    void Clear() { count_ = 0; }
+
+    /// <summary>1 個追加。満杯なら false（捨てる）。</summary>
+    bool Push(const Particle& particle);
+
+    /// <summary>経過時間を進め、field があれば範囲内の速度に加速度を足し、移動し、寿命切れを取り除く。</summary>
+    void Update(float deltaTime, const AccelerationField* field);
+
+    /// <summary>生きている粒子を out に書く（最大 maxCount 個）。書いた数を返す。</summary>
+    uint32_t WriteInstances(ParticleInstanceGPU* out, uint32_t maxCount) const;
+
+    uint32_t GetCount() const { return count_; }
+    uint32_t GetCapacity() const { return capacity_; }
+
+    // 単体計測・確認用の読み出し
+    Vector3 GetTranslate(uint32_t index) const { return { translateX_[index], translateY_[index], translateZ_[index] }; }
+    float GetCurrentTime(uint32_t index) const { return currentTime_[index]; }
+
+private:
+    // src 番目を dst 番目へ写す（寿命切れの詰め用）
+    void Move(uint32_t src, uint32_t dst);
+
+    uint32_t count_ = 0;
+    uint32_t capacity_ = 0;
+
+    // 配列は 4 の倍数に切り上げて確保し、端数も 4 個単位で回す（末尾の余りは計算しても捨てる）
+    std::vector<float> translateX_, translateY_, translateZ_;
+    std::vector<float> velocityX_, velocityY_, velocityZ_;
+    std::vector<float> scaleX_, scaleY_, scaleZ_;
+    std::vector<float> rotateX_, rotateY_, rotateZ_;
+    std::vector<Vector4> color_;
+    std::vector<float> lifeTime_, currentTime_;
+    std::vector<uint32_t> billboardMode_;
+};
+
+/// <summary>
+/// 旧方式（std::list + 粒子ごとに WVP / World を CPU で計算）と ParticlePool（SoA + SSE2 + 位置・スケール・色だけ送る）を
+/// 1 万 / 10 万個で比べて LogBuffer に出す。生存数・位置の一致と、VS で組む World 行列と旧方式の行列の差も確かめる。
+/// </summary>
+void RunParticlePoolBenchmark();
@@ -0,0 +1,148 @@
+#include "DynamicGeometryStream.h"
+#include "PrimitivePipeline.h"
+#include <cassert>
+
+DynamicGeometryStream* DynamicGeometryStream::GetInstance() {
+    static DynamicGeometryStream instance;
+    return &instance;
+}
+
+void DynamicGeometryStream::Finalize() {
+    for (Page& page : pages_) {
+        if (page.vertexResource && page.vertices) page.vertexResource->Unmap(0, nullptr);
+        if (page.indexResource && page.indices) page.indexResource->Unmap(0, nullptr);
+    }
+    pages_.clear();
+    slots_.clear();
+}
+
+uint32_t DynamicGeometryStream::Acquire(uint32_t maxVertices, uint32_t maxIndices) {
+    if (maxVertices == 0 || maxIndices == 0) return kInvalidSlot;
+
+    DirectXCore* dxCore = PrimitivePipeline::GetInstance()->GetDxCore();
+    const uint64_t completed = dxCore ? dxCore->GetCompletedFenceValue() : 0;
+
+    // 返却済みで GPU が読み終えたスロットのうち、容量が足りて一番小さいものを使い回す
+    uint32_t best = kInvalidSlot;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(slots_.size()); ++i) {
+        const Slot& slot = slots_[i];
+        if (slot.inUse || slot.releaseFence > completed) continue;
+        if (slot.vertexCapacity < maxVertices || slot.indexCapacity < maxIndices) continue;
+        if (best == kInvalidSlot || slot.vertexCapacity < slots_[best].vertexCapacity) best = i;
+    }
+    if (best != kInvalidSlot) {
+        Slot& slot = slots_[best];
+        slot.inUse = true;
+        slot.written = false;
+        slot.vertexCount = 0;
+        slot.indexCount = 0;
+        return best;
+    }
+
+    // ページ末尾から版の数ぶんまとめて切り出す
+    const uint64_t vertexSpan = static_cast<uint64_t>(maxVertices) * kVersions;
+    const uint64_t indexSpan = static_cast<uint64_t>(maxIndices) * kVersions;
+    if (vertexSpan > UINT32_MAX || indexSpan > UINT32_MAX) return kInvalidSlot;
+
+    const uint32_t pageIndex = FindOrCreatePage(static_cast<uint32_t>(vertexSpan), static_cast<uint32_t>(indexSpan));
+    if (pageIndex == UINT32_MAX) return kInvalidSlot;
+    Page& page = pages_[pageIndex];
+
+    Slot slot;
+    slot.page = pageIndex;
+    slot.vertexOffset = page.vertexUsed;
+    slot.indexOffset = page.indexUsed;
+    slot.vertexCapacity = maxVertices;
+    slot.indexCapacity = maxIndices;
+    slot.version = kVersions - 1;  // 最初の BeginWrite で版 0 になる
+    slot.inUse = true;
+    page.vertexUsed += static_cast<uint32_t>(vertexSpan);
+    page.indexUsed += static_cast<uint32_t>(indexSpan);
+
+    slots_.push_back(slot);
+    return static_cast<uint32_t>(slots_.size() - 1);
+}
+
+void DynamicGeometryStream::Release(uint32_t slot) {
+    if (slot >= slots_.size() || !slots_[slot].inUse) return;
+    Slot& s = slots_[slot];
+    DirectXCore* dxCore = PrimitivePipeline::GetInstance()->GetDxCore();
+    s.releaseFence = dxCore ? dxCore->GetNextFenceValue() : 0;
+    s.inUse = false;
+    s.written = false;
+    s.vertexCount = 0;
+    s.indexCount = 0;
+}
+
+DynamicGeometryStream::WriteTarget DynamicGeometryStream::BeginWrite(uint32_t slot) {
+    WriteTarget target;
+    if (slot >= slots_.size() || !slots_[slot].inUse) return target;
+
+    Slot& s = slots_[slot];
+    s.version = (s.version + 1) % kVersions;
+    const Page& page = pages_[s.page];
+    target.vertices = page.vertices + s.vertexOffset + s.version * s.vertexCapacity;
+    target.indices = page.indices + s.indexOffset + s.version * s.indexCapacity;
+    target.vertexCapacity = s.vertexCapacity;
+    target.indexCapacity = s.indexCapacity;
+    return target;
+}
+
+void DynamicGeometryStream::EndWrite(uint32_t slot, uint32_t vertexCount, uint32_t indexCount) {
+    if (slot >= slots_.size() || !slots_[slot].inUse) return;
+    Slot& s = slots_[slot];
+    assert(vertexCount <= s.vertexCapacity && indexCount <= s.indexCapacity);
+    s.vertexCount = vertexCount;
+    s.indexCount = indexCount;
+    s.written = true;
+}
+
+bool DynamicGeometryStream::GetViews(uint32_t slot, D3D12_VERTEX_BUFFER_VIEW& vbv, D3D12_INDEX_BUFFER_VIEW& ibv,
+                                     uint32_t& vertexCount, uint32_t& indexCount) const {
+    if (slot >= slots_.size()) return false;
+    const Slot& s = slots_[slot];
+    if (!s.inUse || !s.written) return false;
+
+    const Page& page = pages_[s.page];
+    const uint64_t vertexStart = static_cast<uint64_t>(s.vertexOffset) + s.version * s.vertexCapacity;
+    const uint64_t indexStart = static_cast<uint64_t>(s.indexOffset) + s.version * s.indexCapacity;
+
+    vbv.BufferLocation = page.vertexResource->GetGPUVirtualAddress() + vertexStart * sizeof(MeshVertex);
+    vbv.SizeInBytes = static_cast<UINT>(sizeof(MeshVertex) * s.vertexCapacity);
+    vbv.StrideInBytes = sizeof(MeshVertex);
+
+    ibv.BufferLocation = page.indexResource->GetGPUVirtualAddress() + indexStart * sizeof(uint32_t);
+    ibv.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * s.indexCapacity);
+    ibv.Format = DXGI_FORMAT_R32_UINT;
+
+    vertexCount = s.vertexCount;
+    indexCount = s.indexCount;
+    return true;
+}
+
+uint32_t DynamicGeometryStream::FindOrCreatePage(uint32_t vertexCount, uint32_t indexCount) {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(pages_.size()); ++i) {
+        const Page& page = pages_[i];
+        if (page.vertexCapacity - page.vertexUsed >= vertexCount &&
+            page.indexCapacity - page.indexUsed >= indexCount) {
+            return i;
+        }
+    }
+
+    DirectXCore* dxCore = PrimitivePipeline::GetInstance()->GetDxCore();
+    if (!dxCore) return UINT32_MAX;
+
+    Page page;
+    page.vertexCapacity = vertexCount > kPageVertexCount ? vertexCount : kPageVertexCount;
+    page.indexCapacity = indexCount > kPageIndexCount ? indexCount : kPageIndexCount;
+    page.vertexResource = dxCore->CreateBufferResource(sizeof(MeshVertex) * static_cast<size_t>(page.vertexCapacity));
+    page.indexResource = dxCore->CreateBufferResource(sizeof(uint32_t) * static_cast<size_t>(page.indexCapacity));
+    if (!page.vertexResource || !page.indexResource) return UINT32_MAX;
+
+    // 書き込み用に Map したままにする（Finalize で Unmap）
+    page.vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&page.vertices));
+    page.indexResource->Map(0, nullptr, reinterpret_cast<void**>(&page.indices));
+
+    pages_.push_back(std::move(page));
+    return static_cast<uint32_t>(pages_.size() - 1);
+}
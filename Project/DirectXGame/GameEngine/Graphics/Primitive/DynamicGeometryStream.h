@@ -0,0 +1,94 @@
+#pragma once
+#include "MeshData.h"
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 毎フレーム〜数フレームごとに形が変わるメッシュ（雷など）用の動的頂点・インデックスストリーム。
+/// アップロードヒープのページを Map したまま持ち、利用者ごとに最悪ケース容量の領域（スロット）を貸し出す。
+/// 生成側はスロットの領域へ直接書くので、作り直しのたびにバッファを作ったり MeshData を経由したりしない。
+///
+/// 各スロットは kVersions 個の版を持ち、BeginWrite ごとに版を切り替える（GPU がまだ読んでいる版には書かない）。
+/// インデックスはスロット先頭の頂点からの相対で書く（VBV の先頭をスロットに合わせる）。
+/// 解放したスロットの領域は、そのフレームの GPU 完了後に同じ容量以下の Acquire で再利用する。
+/// </summary>
+class DynamicGeometryStream {
+public:
+    static constexpr uint32_t kInvalidSlot = 0xFFFFFFFFu;
+    static constexpr uint32_t kVersions = 2;
+
+    // 1 ページの容量（これより大きい要求は専用ページを作る）
+    static constexpr uint32_t kPageVertexCount = 65536;
+    static constexpr uint32_t kPageIndexCount = 65536 * 3;
+
+    /// <summary>BeginWrite で返す書き込み先。</summary>
+    struct WriteTarget {
+        MeshVertex* vertices = nullptr;
+        uint32_t*   indices = nullptr;
+        uint32_t    vertexCapacity = 0;
+        uint32_t    indexCapacity = 0;
+    };
+
+    static DynamicGeometryStream* GetInstance();
+
+    /// <summary>ページをすべて解放する（GPU 完了後、PrimitivePipeline の Finalize のあとに呼ぶ）。</summary>
+    void Finalize();
+
+    /// <summary>頂点 maxVertices / インデックス maxIndices まで書けるスロットを借りる。失敗時 kInvalidSlot。</summary>
+    uint32_t Acquire(uint32_t maxVertices, uint32_t maxIndices);
+
+    /// <summary>スロットを返す（領域は今フレームの GPU 完了後に再利用される）。</summary>
+    void Release(uint32_t slot);
+
+    /// <summary>次の版へ切り替えて書き込み先を返す。同じスロットを複数スレッドから同時に書かないこと。</summary>
+    WriteTarget BeginWrite(uint32_t slot);
+
+    /// <summary>BeginWrite で書いた頂点数・インデックス数を確定する（以降 GetViews がこの版を返す）。</summary>
+    void EndWrite(uint32_t slot, uint32_t vertexCount, uint32_t indexCount);
+
+    /// <summary>最後に確定した版の VBV / IBV と数を返す。未確定なら false。</summary>
+    bool GetViews(uint32_t slot, D3D12_VERTEX_BUFFER_VIEW& vbv, D3D12_INDEX_BUFFER_VIEW& ibv,
+                  uint32_t& vertexCount, uint32_t& indexCount) const;
+
+    uint32_t GetPageCount() const { return static_cast<uint32_t>(pages_.size()); }
+    uint32_t GetSlotCount() const { return static_cast<uint32_t>(slots_.size()); }
+
+private:
+    DynamicGeometryStream() = default;
+    ~DynamicGeometryStream() = default;
+    DynamicGeometryStream(const DynamicGeometryStream&) = delete;
+    DynamicGeometryStream& operator=(const DynamicGeometryStream&) = delete;
+
+    struct Page {
+        Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
+        Microsoft::WRL::ComPtr<ID3D12Resource> indexResource;
+        MeshVertex* vertices = nullptr;
+        uint32_t*   indices = nullptr;
+        uint32_t    vertexCapacity = 0;
+        uint32_t    indexCapacity = 0;
+        uint32_t    vertexUsed = 0;
+        uint32_t    indexUsed = 0;
+    };
+
+    struct Slot {
+        uint32_t page = 0;
+        uint32_t vertexOffset = 0;     // 版 0 の先頭（版 k は + k * vertexCapacity）
+        uint32_t indexOffset = 0;
+        uint32_t vertexCapacity = 0;   // 1 版あたり
+        uint32_t indexCapacity = 0;
+        uint32_t version = 0;          // 最後に書いた版
+        uint32_t vertexCount = 0;      // 確定した数（0 なら描かない）
+        uint32_t indexCount = 0;
+        bool     inUse = false;
+        bool     written = false;
+        uint64_t releaseFence = 0;     // Release 時の GetNextFenceValue（これが完了するまで再利用しない）
+    };
+
+    // 要求を満たすページを探し、なければ作る。失敗時 UINT32_MAX
+    uint32_t FindOrCreatePage(uint32_t vertexCount, uint32_t indexCount);
+
+    std::vector<Page> pages_;
+    std::vector<Slot> slots_;
+};
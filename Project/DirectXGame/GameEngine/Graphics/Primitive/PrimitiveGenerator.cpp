@@ -2,6 +2,7 @@
 #include <cmath>
 #include <random>
 #include <chrono>
+#include <atomic>
 
 namespace PrimitiveGenerator {
 
@@ -541,155 +542,179 @@ namespace PrimitiveGenerator {
         return mesh;
     }
 
-    MeshData CreateBeamFromPolyline(const std::vector<Vector3>& polyline, const BeamAppearance& app) {
-        MeshData mesh;
-        if (polyline.size() < 2) return mesh;
-
-        const float kPi = 3.14159265358979323846f;
-        const uint32_t planeCount = app.planeCount < 1 ? 1 : app.planeCount;
-
-        auto length3 = [](const Vector3& v) {
-            return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
-            };
-        auto normalize3 = [&](const Vector3& v) -> Vector3 {
-            float len = length3(v);
-            if (len < 1e-6f) return { 1.0f, 0.0f, 0.0f };
-            return { v.x / len, v.y / len, v.z / len };
-            };
-        auto cross3 = [](const Vector3& a, const Vector3& b) -> Vector3 {
-            return {
-                a.y * b.z - a.z * b.y,
-                a.z * b.x - a.x * b.z,
-                a.x * b.y - a.y * b.x
-            };
-            };
-        auto lerpV4 = [](const Vector4& a, const Vector4& b, float t) {
-            return Vector4{
-                a.x + (b.x - a.x) * t,
-                a.y + (b.y - a.y) * t,
-                a.z + (b.z - a.z) * t,
-                a.w + (b.w - a.w) * t
-            };
-            };
-
-        // 各頂点ごとの累積長
-        const size_t n = polyline.size();
-        std::vector<float> cumLen(n, 0.0f);
-        for (size_t i = 1; i < n; ++i) {
-            cumLen[i] = cumLen[i - 1] + length3({
-                polyline[i].x - polyline[i - 1].x,
-                polyline[i].y - polyline[i - 1].y,
-                polyline[i].z - polyline[i - 1].z });
-        }
-        const float totalLen = cumLen.back();
-        if (totalLen < 1e-6f) return mesh;
-
-        // 各点での接線とその直交基底（right, up）を事前計算
-        std::vector<Vector3> tangents(n), rights(n), ups(n);
-        for (size_t i = 0; i < n; ++i) {
-            Vector3 t;
-            if (i == 0) {
-                t = { polyline[1].x - polyline[0].x, polyline[1].y - polyline[0].y, polyline[1].z - polyline[0].z };
-            } else if (i == n - 1) {
-                t = { polyline[i].x - polyline[i - 1].x, polyline[i].y - polyline[i - 1].y, polyline[i].z - polyline[i - 1].z };
-            } else {
-                t = { polyline[i + 1].x - polyline[i - 1].x, polyline[i + 1].y - polyline[i - 1].y, polyline[i + 1].z - polyline[i - 1].z };
-            }
-            tangents[i] = normalize3(t);
-            Vector3 up = (std::abs(tangents[i].y) > 0.99f) ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
-            rights[i] = normalize3(cross3(tangents[i], up));
-            ups[i] = cross3(rights[i], tangents[i]);
-        }
-
-        // Plane を軸まわりに均等配置（pi/planeCount 刻みで180度未満を埋める：両面で360度カバー）
-        for (uint32_t p = 0; p < planeCount; ++p) {
-            float angleRot = kPi * static_cast<float>(p) / static_cast<float>(planeCount);
-            float cosA = std::cos(angleRot);
-            float sinA = std::sin(angleRot);
-
-            uint32_t baseIdx = static_cast<uint32_t>(mesh.vertices.size());
-
-            for (size_t i = 0; i < n; ++i) {
-                // 軸まわり回転後のオフセット方向
-                Vector3 offsetDir = {
-                    rights[i].x * cosA + ups[i].x * sinA,
-                    rights[i].y * cosA + ups[i].y * sinA,
-                    rights[i].z * cosA + ups[i].z * sinA
+    namespace {
+        // 折れ線 n 点の帯メッシュの頂点数・インデックス数
+        uint64_t BeamVertexCount(uint64_t n, uint32_t planeCount) { return n < 2 ? 0 : planeCount * n * 2; }
+        uint64_t BeamIndexCount(uint64_t n, uint32_t planeCount)  { return n < 2 ? 0 : planeCount * (n - 1) * 6; }
+
+        // 折れ線→交差Plane帯を vertices / indices へ直接書く（CreateBeamFromPolyline と雷の共通実装）。
+        // インデックスは baseIndex から振る。容量（BeamVertexCount / BeamIndexCount）は呼び出し側で確保済みの前提。
+        MeshWriteResult WriteBeamFromPolyline(const Vector3* polyline, size_t n, const BeamAppearance& app,
+                                              LightningScratch& scratch,
+                                              MeshVertex* vertices, uint32_t* indices, uint32_t baseIndex) {
+            MeshWriteResult result{};
+            if (n < 2) return result;
+
+            const float kPi = 3.14159265358979323846f;
+            const uint32_t planeCount = app.planeCount < 1 ? 1 : app.planeCount;
+
+            auto length3 = [](const Vector3& v) {
+                return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+                };
+            auto normalize3 = [&](const Vector3& v) -> Vector3 {
+                float len = length3(v);
+                if (len < 1e-6f) return { 1.0f, 0.0f, 0.0f };
+                return { v.x / len, v.y / len, v.z / len };
+                };
+            auto cross3 = [](const Vector3& a, const Vector3& b) -> Vector3 {
+                return {
+                    a.y * b.z - a.z * b.y,
+                    a.z * b.x - a.x * b.z,
+                    a.x * b.y - a.y * b.x
                 };
-                // 面法線（接線 × オフセット = 面に垂直）
-                Vector3 faceNormal = normalize3(cross3(tangents[i], offsetDir));
-
-                float t = cumLen[i] / totalLen;
-                float w = app.startWidth + (app.endWidth - app.startWidth) * t;
-                Vector4 col = lerpV4(app.startColor, app.endColor, t);
-
-                // 両端フェード（αに焼き込み）
-                float fadeAlpha = 1.0f;
-                if (app.fadeStartLength > 1e-6f && cumLen[i] < app.fadeStartLength) {
-                    fadeAlpha *= cumLen[i] / app.fadeStartLength;
-                }
-                float distFromEnd = totalLen - cumLen[i];
-                if (app.fadeEndLength > 1e-6f && distFromEnd < app.fadeEndLength) {
-                    fadeAlpha *= distFromEnd / app.fadeEndLength;
-                }
-                col.w *= fadeAlpha;
-
-                float u = app.uvWrapByLength ? (cumLen[i] * app.uvTilesPerUnit) : t;
-
-                MeshVertex v0{}, v1{};
-                float halfW = w * 0.5f;
-                v0.position = {
-                    polyline[i].x + offsetDir.x * halfW,
-                    polyline[i].y + offsetDir.y * halfW,
-                    polyline[i].z + offsetDir.z * halfW
                 };
-                v0.normal = faceNormal;
-                v0.color = col;
-                v0.texcoord = { u, 0.0f };
-
-                v1.position = {
-                    polyline[i].x - offsetDir.x * halfW,
-                    polyline[i].y - offsetDir.y * halfW,
-                    polyline[i].z - offsetDir.z * halfW
+            auto lerpV4 = [](const Vector4& a, const Vector4& b, float t) {
+                return Vector4{
+                    a.x + (b.x - a.x) * t,
+                    a.y + (b.y - a.y) * t,
+                    a.z + (b.z - a.z) * t,
+                    a.w + (b.w - a.w) * t
+                };
                 };
-                v1.normal = faceNormal;
-                v1.color = col;
-                v1.texcoord = { u, 1.0f };
 
-                mesh.vertices.push_back(v0);
-                mesh.vertices.push_back(v1);
+            // 各頂点ごとの累積長
+            std::vector<float>& cumLen = scratch.cumLength;
+            cumLen.assign(n, 0.0f);
+            for (size_t i = 1; i < n; ++i) {
+                cumLen[i] = cumLen[i - 1] + length3({
+                    polyline[i].x - polyline[i - 1].x,
+                    polyline[i].y - polyline[i - 1].y,
+                    polyline[i].z - polyline[i - 1].z });
+            }
+            const float totalLen = cumLen.back();
+            if (totalLen < 1e-6f) return result;
+
+            // 各点での接線とその直交基底（right, up）を事前計算
+            std::vector<Vector3>& tangents = scratch.tangents;
+            std::vector<Vector3>& rights = scratch.rights;
+            std::vector<Vector3>& ups = scratch.ups;
+            tangents.resize(n);
+            rights.resize(n);
+            ups.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                Vector3 t;
+                if (i == 0) {
+                    t = { polyline[1].x - polyline[0].x, polyline[1].y - polyline[0].y, polyline[1].z - polyline[0].z };
+                } else if (i == n - 1) {
+                    t = { polyline[i].x - polyline[i - 1].x, polyline[i].y - polyline[i - 1].y, polyline[i].z - polyline[i - 1].z };
+                } else {
+                    t = { polyline[i + 1].x - polyline[i - 1].x, polyline[i + 1].y - polyline[i - 1].y, polyline[i + 1].z - polyline[i - 1].z };
+                }
+                tangents[i] = normalize3(t);
+                Vector3 up = (std::abs(tangents[i].y) > 0.99f) ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+                rights[i] = normalize3(cross3(tangents[i], up));
+                ups[i] = cross3(rights[i], tangents[i]);
             }
 
-            // セグメントごとに2三角形
-            for (size_t i = 0; i < n - 1; ++i) {
-                uint32_t i0 = baseIdx + static_cast<uint32_t>(i) * 2;
-                uint32_t i1 = i0 + 1;
-                uint32_t i2 = i0 + 2;
-                uint32_t i3 = i0 + 3;
+            // Plane を軸まわりに均等配置（pi/planeCount 刻みで180度未満を埋める：両面で360度カバー）
+            for (uint32_t p = 0; p < planeCount; ++p) {
+                float angleRot = kPi * static_cast<float>(p) / static_cast<float>(planeCount);
+                float cosA = std::cos(angleRot);
+                float sinA = std::sin(angleRot);
+
+                uint32_t baseIdx = baseIndex + result.vertexCount;
+
+                for (size_t i = 0; i < n; ++i) {
+                    // 軸まわり回転後のオフセット方向
+                    Vector3 offsetDir = {
+                        rights[i].x * cosA + ups[i].x * sinA,
+                        rights[i].y * cosA + ups[i].y * sinA,
+                        rights[i].z * cosA + ups[i].z * sinA
+                    };
+                    // 面法線（接線 × オフセット = 面に垂直）
+                    Vector3 faceNormal = normalize3(cross3(tangents[i], offsetDir));
+
+                    float t = cumLen[i] / totalLen;
+                    float w = app.startWidth + (app.endWidth - app.startWidth) * t;
+                    Vector4 col = lerpV4(app.startColor, app.endColor, t);
+
+                    // 両端フェード（αに焼き込み）
+                    float fadeAlpha = 1.0f;
+                    if (app.fadeStartLength > 1e-6f && cumLen[i] < app.fadeStartLength) {
+                        fadeAlpha *= cumLen[i] / app.fadeStartLength;
+                    }
+                    float distFromEnd = totalLen - cumLen[i];
+                    if (app.fadeEndLength > 1e-6f && distFromEnd < app.fadeEndLength) {
+                        fadeAlpha *= distFromEnd / app.fadeEndLength;
+                    }
+                    col.w *= fadeAlpha;
+
+                    float u = app.uvWrapByLength ? (cumLen[i] * app.uvTilesPerUnit) : t;
+
+                    MeshVertex v0{}, v1{};
+                    float halfW = w * 0.5f;
+                    v0.position = {
+                        polyline[i].x + offsetDir.x * halfW,
+                        polyline[i].y + offsetDir.y * halfW,
+                        polyline[i].z + offsetDir.z * halfW
+                    };
+                    v0.normal = faceNormal;
+                    v0.color = col;
+                    v0.texcoord = { u, 0.0f };
+
+                    v1.position = {
+                        polyline[i].x - offsetDir.x * halfW,
+                        polyline[i].y - offsetDir.y * halfW,
+                        polyline[i].z - offsetDir.z * halfW
+                    };
+                    v1.normal = faceNormal;
+                    v1.color = col;
+                    v1.texcoord = { u, 1.0f };
+
+                    // 書き込み先はアップロードヒープ（write-combined）のこともあるので、頂点ごとに一度に書く
+                    vertices[result.vertexCount++] = v0;
+                    vertices[result.vertexCount++] = v1;
+                }
 
-                mesh.indices.push_back(i0);
-                mesh.indices.push_back(i2);
-                mesh.indices.push_back(i1);
-                mesh.indices.push_back(i1);
-                mesh.indices.push_back(i2);
-                mesh.indices.push_back(i3);
+                // セグメントごとに2三角形
+                for (size_t i = 0; i < n - 1; ++i) {
+                    uint32_t i0 = baseIdx + static_cast<uint32_t>(i) * 2;
+                    uint32_t i1 = i0 + 1;
+                    uint32_t i2 = i0 + 2;
+                    uint32_t i3 = i0 + 3;
+
+                    uint32_t* dst = indices + result.indexCount;
+                    dst[0] = i0;
+                    dst[1] = i2;
+                    dst[2] = i1;
+                    dst[3] = i1;
+                    dst[4] = i2;
+                    dst[5] = i3;
+                    result.indexCount += 6;
+                }
             }
+
+            return result;
         }
+    }
+
+    MeshData CreateBeamFromPolyline(const std::vector<Vector3>& polyline, const BeamAppearance& app) {
+        MeshData mesh;
+        if (polyline.size() < 2) return mesh;
 
+        const uint32_t planeCount = app.planeCount < 1 ? 1 : app.planeCount;
+        mesh.vertices.resize(static_cast<size_t>(BeamVertexCount(polyline.size(), planeCount)));
+        mesh.indices.resize(static_cast<size_t>(BeamIndexCount(polyline.size(), planeCount)));
+
+        LightningScratch scratch;
+        const MeshWriteResult written = WriteBeamFromPolyline(polyline.data(), polyline.size(), app, scratch,
+                                                              mesh.vertices.data(), mesh.indices.data(), 0);
+        mesh.vertices.resize(written.vertexCount);
+        mesh.indices.resize(written.indexCount);
         return mesh;
     }
 
     namespace {
-        // 2つの MeshData を結合（v2 のインデックスをオフセット）
-        void AppendMesh(MeshData& dst, const MeshData& src) {
-            uint32_t baseIdx = static_cast<uint32_t>(dst.vertices.size());
-            dst.vertices.insert(dst.vertices.end(), src.vertices.begin(), src.vertices.end());
-            dst.indices.reserve(dst.indices.size() + src.indices.size());
-            for (uint32_t i : src.indices) {
-                dst.indices.push_back(i + baseIdx);
-            }
-        }
-
         // 線分 (a,b) のフラクタル分割。生成された折れ線を out へ追加（始点を含む）
         // depth=0 で end を含めて push する。
         void SubdivideSegment(const Vector3& a, const Vector3& b,
@@ -741,42 +766,91 @@ namespace PrimitiveGenerator {
             SubdivideSegment(mid, b, nextOffset, depth - 1, rng, out);
         }
 
-        // 始点→終点のフラクタル折れ線を生成（始点を含み、終点を含む）
-        std::vector<Vector3> GenerateFractalPolyline(const Vector3& start, const Vector3& end,
-                                                     float maxOffset, uint32_t generations,
-                                                     std::mt19937& rng) {
-            std::vector<Vector3> out;
+        // 始点→終点のフラクタル折れ線を out に作り直す（始点を含み、終点を含む）。out の容量は使い回す
+        void GenerateFractalPolyline(const Vector3& start, const Vector3& end,
+                                     float maxOffset, uint32_t generations,
+                                     std::mt19937& rng, std::vector<Vector3>& out) {
+            out.clear();
             out.push_back(start);
             SubdivideSegment(start, end, maxOffset, generations, rng, out);
-            return out;
         }
-    }
 
-    MeshData CreateLightningBolt(const LightningBoltParams& params) {
-        MeshData mesh;
+        // フラクタル折れ線の点数の上限（途中で長さ 0 の線分があると減る）
+        uint64_t FractalPointCount(uint32_t generations) {
+            return (uint64_t{ 1 } << (generations < 24 ? generations : 24)) + 1;
+        }
 
-        // RNG（seed=0 なら現在時刻、それ以外は固定）
-        uint32_t seed = params.randomSeed;
-        if (seed == 0) {
+        uint32_t BranchGenerations(const LightningBoltParams& params) {
+            return params.generations > 1 ? params.generations - 1 : 1;
+        }
+
+        // RNG の seed（0 なら現在時刻、それ以外はそのまま）。
+        // 同じ時刻に別スレッドで作っても同じ形にならないよう、呼び出しごとの通し番号も混ぜる
+        uint32_t ResolveLightningSeed(uint32_t seed) {
+            if (seed != 0) return seed;
+            static std::atomic<uint32_t> callCount{ 0 };
             seed = static_cast<uint32_t>(
-                std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                std::chrono::high_resolution_clock::now().time_since_epoch().count())
+                ^ (callCount.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B9u);
+            return seed != 0 ? seed : 1;
         }
-        std::mt19937 rng(seed);
+    }
+
+    void GetLightningBoltCapacity(const LightningBoltParams& params, uint32_t maxBranches,
+                                  uint32_t& maxVertices, uint32_t& maxIndices) {
+        const uint32_t planeCount = params.appearance.planeCount < 1 ? 1 : params.appearance.planeCount;
+        const uint64_t mainPoints = FractalPointCount(params.generations);
+        const uint64_t branchPoints = FractalPointCount(BranchGenerations(params));
+        // 枝は本線の隣接点ごとに最大 1 本
+        uint64_t branches = (params.branchProbability > 0.0f) ? mainPoints - 1 : 0;
+        if (branches > maxBranches) branches = maxBranches;
+
+        const uint64_t vertices = BeamVertexCount(mainPoints, planeCount) + branches * BeamVertexCount(branchPoints, planeCount);
+        const uint64_t indices = BeamIndexCount(mainPoints, planeCount) + branches * BeamIndexCount(branchPoints, planeCount);
+        maxVertices = static_cast<uint32_t>(vertices < UINT32_MAX ? vertices : UINT32_MAX);
+        maxIndices = static_cast<uint32_t>(indices < UINT32_MAX ? indices : UINT32_MAX);
+    }
+
+    uint32_t EstimateLightningMaxBranches(const LightningBoltParams& params) {
+        if (params.branchProbability <= 0.0f) return 0;
+        const uint32_t generations = params.generations < 24 ? params.generations : 24;
+        const double segments = static_cast<double>(uint64_t{ 1 } << generations);
+        const double p = params.branchProbability < 1.0f ? params.branchProbability : 1.0;
+        const double mean = segments * p;
+        const double sigma = std::sqrt(segments * p * (1.0 - p));
+        const double estimate = std::ceil(mean + 4.0 * sigma) + 1.0;
+        return static_cast<uint32_t>(estimate < segments ? estimate : segments);
+    }
+
+    MeshWriteResult WriteLightningBolt(const LightningBoltParams& params, uint32_t maxBranches,
+                                       LightningScratch& scratch,
+                                       MeshVertex* vertices, uint32_t vertexCapacity,
+                                       uint32_t* indices, uint32_t indexCapacity) {
+        MeshWriteResult result{};
+
+        std::mt19937 rng(ResolveLightningSeed(params.randomSeed));
 
         // 始終点距離 → maxOffset
         Vector3 d = { params.endPos.x - params.startPos.x,
                       params.endPos.y - params.startPos.y,
                       params.endPos.z - params.startPos.z };
         float totalLen = std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
-        if (totalLen < 1e-6f) return mesh;
+        if (totalLen < 1e-6f) return result;
         float maxOffset = totalLen * params.maxOffsetRatio;
 
-        // 本線
-        std::vector<Vector3> mainPoly =
-            GenerateFractalPolyline(params.startPos, params.endPos, maxOffset, params.generations, rng);
+        const uint32_t planeCount = params.appearance.planeCount < 1 ? 1 : params.appearance.planeCount;
+        // 残りの容量に n 点の帯が入るか
+        auto fits = [&](size_t n) {
+            return result.vertexCount + BeamVertexCount(n, planeCount) <= vertexCapacity
+                && result.indexCount + BeamIndexCount(n, planeCount) <= indexCapacity;
+        };
 
-        MeshData mainMesh = CreateBeamFromPolyline(mainPoly, params.appearance);
-        AppendMesh(mesh, mainMesh);
+        // 本線（入らなければ何も書かない）
+        std::vector<Vector3>& mainPoly = scratch.mainPolyline;
+        GenerateFractalPolyline(params.startPos, params.endPos, maxOffset, params.generations, rng, mainPoly);
+        if (!fits(mainPoly.size())) return result;
+        result = WriteBeamFromPolyline(mainPoly.data(), mainPoly.size(), params.appearance, scratch,
+                                       vertices, indices, 0);
 
         // 枝：本線の隣接点 (i, i+1) で確率的に分岐
         // 枝の終点 = mid + Rotate(dir) * lengthScale * |segment|
@@ -797,7 +871,9 @@ namespace PrimitiveGenerator {
             branchApp.endColor.z *= params.branchColorScale;
             branchApp.endColor.w *= params.branchColorScale;
 
+            uint32_t branchCount = 0;
             for (size_t i = 0; i + 1 < mainPoly.size(); ++i) {
+                if (branchCount >= maxBranches) break;
                 if (dist01(rng) > params.branchProbability) continue;
 
                 Vector3 a = mainPoly[i];
@@ -841,16 +917,59 @@ namespace PrimitiveGenerator {
                 };
 
                 // 枝にもフラクタル（世代は本線より浅く）
-                uint32_t branchGen = params.generations > 1 ? params.generations - 1 : 1;
                 float branchMaxOffset = branchLen * params.maxOffsetRatio;
-                std::vector<Vector3> branchPoly =
-                    GenerateFractalPolyline(b, branchEnd, branchMaxOffset, branchGen, rng);
+                std::vector<Vector3>& branchPoly = scratch.branchPolyline;
+                GenerateFractalPolyline(b, branchEnd, branchMaxOffset, BranchGenerations(params), rng, branchPoly);
+                if (!fits(branchPoly.size())) {
+                    result.branchesDropped = true;
+                    continue;
+                }
 
-                MeshData branchMesh = CreateBeamFromPolyline(branchPoly, branchApp);
-                AppendMesh(mesh, branchMesh);
+                const MeshWriteResult branch = WriteBeamFromPolyline(branchPoly.data(), branchPoly.size(), branchApp, scratch,
+                                                                     vertices + result.vertexCount,
+                                                                     indices + result.indexCount, result.vertexCount);
+                result.vertexCount += branch.vertexCount;
+                result.indexCount += branch.indexCount;
+                ++branchCount;
             }
         }
 
+        return result;
+    }
+
+    MeshData CreateLightningBolt(const LightningBoltParams& params) {
+        // 最悪ケース（全隣接点で分岐）で確保すると世代が深いと数百 MB になるので、平均 + 4σ 本分で書いてみて、
+        // 枝が入りきらなかったときだけ最悪ケースで書き直す。seed を先に決めておくので書き直しても同じ形になる
+        LightningBoltParams resolved = params;
+        resolved.randomSeed = ResolveLightningSeed(params.randomSeed);
+
+        MeshData mesh;
+        LightningScratch scratch;
+        uint32_t maxVertices = 0;
+        uint32_t maxIndices = 0;
+        GetLightningBoltCapacity(resolved, EstimateLightningMaxBranches(resolved), maxVertices, maxIndices);
+        for (;;) {
+            mesh.vertices.resize(maxVertices);
+            mesh.indices.resize(maxIndices);
+            const MeshWriteResult written = WriteLightningBolt(resolved, UINT32_MAX, scratch,
+                                                               mesh.vertices.data(), maxVertices,
+                                                               mesh.indices.data(), maxIndices);
+            if (written.branchesDropped) {
+                uint32_t worstVertices = 0;
+                uint32_t worstIndices = 0;
+                GetLightningBoltCapacity(resolved, UINT32_MAX, worstVertices, worstIndices);
+                if (worstVertices > maxVertices || worstIndices > maxIndices) {
+                    maxVertices = worstVertices;
+                    maxIndices = worstIndices;
+                    continue;
+                }
+            }
+            mesh.vertices.resize(written.vertexCount);
+            mesh.indices.resize(written.indexCount);
+            break;
+        }
+        mesh.vertices.shrink_to_fit();
+        mesh.indices.shrink_to_fit();
         return mesh;
     }
 
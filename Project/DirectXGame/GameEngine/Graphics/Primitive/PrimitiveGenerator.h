@@ -52,6 +52,22 @@ namespace PrimitiveGenerator {
     // RingParams版（拡張機能を利用可能）
     MeshData CreateRing(const RingParams& params);
 
+    // RingParams のフィールド並び（CookedDefs の .defs 読み書き用。outerRadiusPerDivision があるため丸写しできない）
+    template <class Ar>
+    void CookFields(Ar& ar, RingParams& v) {
+        ar.Field(v.outerRadius);
+        ar.Field(v.innerRadius);
+        ar.Field(v.divisions);
+        ar.Field(v.innerColor);
+        ar.Field(v.outerColor);
+        ar.Field(v.startAngle);
+        ar.Field(v.endAngle);
+        ar.Field(v.uvHorizon);
+        ar.Field(v.fadeStart);
+        ar.Field(v.fadeEnd);
+        ar.Field(v.outerRadiusPerDivision);
+    }
+
     // Cylinderの生成パラメータ
     struct CylinderParams {
         float topRadius = 1.0f;
@@ -68,6 +84,19 @@ namespace PrimitiveGenerator {
         float endAngle   = 2.0f * 3.14159265358979323846f;
     };
 
+    // CylinderParams のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, CylinderParams& v) {
+        ar.Field(v.topRadius);
+        ar.Field(v.bottomRadius);
+        ar.Field(v.height);
+        ar.Field(v.divisions);
+        ar.Field(v.topColor);
+        ar.Field(v.bottomColor);
+        ar.Field(v.startAngle);
+        ar.Field(v.endAngle);
+    }
+
     // Cylinderを生成（Y軸方向の筒、上下面なし、中心が原点）
     MeshData CreateCylinder(
         float topRadius = 1.0f,
@@ -105,6 +134,16 @@ namespace PrimitiveGenerator {
         Vector4 color       = { 1.0f, 1.0f, 1.0f, 1.0f };
     };
 
+    // FrameParams のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, FrameParams& v) {
+        ar.Field(v.outerWidth);
+        ar.Field(v.outerHeight);
+        ar.Field(v.innerWidth);
+        ar.Field(v.innerHeight);
+        ar.Field(v.color);
+    }
+
     // Frame（額縁状の枠）を生成。外周と内側穴の差分を4つの台形でタイル化する。
     MeshData CreateFrame(const FrameParams& params);
 
@@ -132,6 +171,21 @@ namespace PrimitiveGenerator {
         Vector4 endColor   = { 1.0f, 0.3f, 0.0f, 0.2f };
     };
 
+    // HelixParams のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, HelixParams& v) {
+        ar.Field(v.startHelixRadius);
+        ar.Field(v.endHelixRadius);
+        ar.Field(v.startTubeRadius);
+        ar.Field(v.endTubeRadius);
+        ar.Field(v.pitch);
+        ar.Field(v.turns);
+        ar.Field(v.circleSegments);
+        ar.Field(v.lengthSegments);
+        ar.Field(v.startColor);
+        ar.Field(v.endColor);
+    }
+
     // Helix（螺旋チューブ）を生成
     MeshData CreateHelix(const HelixParams& params);
 
@@ -148,6 +202,20 @@ namespace PrimitiveGenerator {
         float  uvTilesPerUnit = 1.0f;       // uvWrapByLength=true時、1ユニットあたりのUタイル数
     };
 
+    // BeamAppearance のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, BeamAppearance& v) {
+        ar.Field(v.startWidth);
+        ar.Field(v.endWidth);
+        ar.Field(v.planeCount);
+        ar.Field(v.fadeStartLength);
+        ar.Field(v.fadeEndLength);
+        ar.Field(v.startColor);
+        ar.Field(v.endColor);
+        ar.Field(v.uvWrapByLength);
+        ar.Field(v.uvTilesPerUnit);
+    }
+
     // 直線ビーム（レーザー）の生成パラメータ
     struct BeamParams {
         Vector3 startPos = { 0.0f, 0.0f, 0.0f };
@@ -157,6 +225,15 @@ namespace PrimitiveGenerator {
         uint32_t lengthSegments = 16;
     };
 
+    // BeamParams のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, BeamParams& v) {
+        ar.Field(v.startPos);
+        ar.Field(v.endPos);
+        ar.Field(v.appearance);
+        ar.Field(v.lengthSegments);
+    }
+
     // 折れ線→交差Plane帯メッシュ（雷の内部実装でも使う共通関数）
     MeshData CreateBeamFromPolyline(const std::vector<Vector3>& polyline, const BeamAppearance& app);
 
@@ -183,7 +260,55 @@ namespace PrimitiveGenerator {
         float branchColorScale  = 0.5f;   // 枝の明るさ倍率（α含む）
     };
 
+    // LightningBoltParams のフィールド並び（.defs へは丸写し。スキーマハッシュ用）
+    template <class Ar>
+    void CookFields(Ar& ar, LightningBoltParams& v) {
+        ar.Field(v.startPos);
+        ar.Field(v.endPos);
+        ar.Field(v.appearance);
+        ar.Field(v.generations);
+        ar.Field(v.maxOffsetRatio);
+        ar.Field(v.randomSeed);
+        ar.Field(v.branchProbability);
+        ar.Field(v.branchLengthScale);
+        ar.Field(v.branchMaxAngle);
+        ar.Field(v.branchWidthScale);
+        ar.Field(v.branchColorScale);
+    }
+
     // 雷メッシュを生成（本線＋枝を合成した1つの MeshData を返す）
     MeshData CreateLightningBolt(const LightningBoltParams& params);
 
+    // 直接書き込み版の結果（書いた頂点数・インデックス数）
+    struct MeshWriteResult {
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        bool branchesDropped = false;  // 容量に入らず捨てた枝があった
+    };
+
+    // 雷生成の作業バッファ。使い回すと再生成のたびのヒープ確保がなくなる（スレッドごとに1つ）
+    struct LightningScratch {
+        std::vector<Vector3> mainPolyline;
+        std::vector<Vector3> branchPolyline;
+        std::vector<float>   cumLength;
+        std::vector<Vector3> tangents;
+        std::vector<Vector3> rights;
+        std::vector<Vector3> ups;
+    };
+
+    // 枝を最大 maxBranches 本までにしたときの最悪ケースの頂点数・インデックス数
+    void GetLightningBoltCapacity(const LightningBoltParams& params, uint32_t maxBranches,
+                                  uint32_t& maxVertices, uint32_t& maxIndices);
+
+    // 想定される枝の本数の上限（本線の隣接点ごとの分岐を二項分布とみて平均 + 4σ、最悪ケース以下）
+    uint32_t EstimateLightningMaxBranches(const LightningBoltParams& params);
+
+    // 雷メッシュを vertices / indices へ直接書く（インデックスは vertices 先頭からの相対）。
+    // 本線が容量に入らなければ何も書かず、入らない枝・maxBranches を超える枝は捨てる。
+    // 乱数の使い方は CreateLightningBolt と同じなので、同じ seed なら同じ形になる。
+    MeshWriteResult WriteLightningBolt(const LightningBoltParams& params, uint32_t maxBranches,
+                                       LightningScratch& scratch,
+                                       MeshVertex* vertices, uint32_t vertexCapacity,
+                                       uint32_t* indices, uint32_t indexCapacity);
+
 }
\ No newline at end of file
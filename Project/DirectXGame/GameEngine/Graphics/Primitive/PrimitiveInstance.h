@@ -31,6 +31,11 @@ public:
     };
 
     PrimitiveInstance() = default;
+
+    /// <summary>
+    /// Hierarchy / Collision / Gameplay に登録しない生成（描画テンプレート等、シーンに置かない用途）。
+    /// </summary>
+    explicit PrimitiveInstance(NoAutoRegister tag) : IImGuiEditable(tag) {}
     ~PrimitiveInstance() override = default;
 
     /// <summary>
@@ -0,0 +1,59 @@
+#include "PrimitiveInstanceBatch.h"
+#include "PrimitiveMesh.h"
+#include "PrimitivePipeline.h"
+#include "SRVManager.h"
+#include <cassert>
+
+PrimitiveInstanceBatch::~PrimitiveInstanceBatch() {
+    Finalize();
+}
+
+void PrimitiveInstanceBatch::Initialize(uint32_t capacity) {
+    Finalize();
+    if (capacity == 0) return;
+
+    PrimitivePipeline* pipeline = PrimitivePipeline::GetInstance();
+    DirectXCore* dxCore = pipeline->GetDxCore();
+    SRVManager* srvManager = pipeline->GetSRVManager();
+    assert(dxCore && srvManager);
+
+    capacity_ = capacity;
+    resource_ = dxCore->CreateBufferResource(sizeof(InstanceData) * capacity_);
+
+    srvIndex_ = srvManager->Allocate();
+    hasSrv_ = true;
+    srvManager->CreateSRVForStructuredBuffer(srvIndex_, resource_.Get(), capacity_, sizeof(InstanceData));
+
+    // 書き込み用に Map したままにする（Finalize で Unmap）
+    resource_->Map(0, nullptr, reinterpret_cast<void**>(&data_));
+    count_ = 0;
+}
+
+void PrimitiveInstanceBatch::Finalize() {
+    if (resource_) {
+        if (data_) resource_->Unmap(0, nullptr);
+        resource_.Reset();
+    }
+    data_ = nullptr;
+    if (hasSrv_) {
+        if (SRVManager* srvManager = PrimitivePipeline::GetInstance()->GetSRVManager()) {
+            srvManager->Free(srvIndex_);
+        }
+        hasSrv_ = false;
+    }
+    capacity_ = 0;
+    count_ = 0;
+}
+
+bool PrimitiveInstanceBatch::Push(const Matrix4x4& world, const Matrix4x4& wvp) {
+    if (count_ >= capacity_) return false;
+    data_[count_].WVP = wvp;
+    data_[count_].World = world;
+    ++count_;
+    return true;
+}
+
+void PrimitiveInstanceBatch::Draw(PrimitiveMesh& mesh) {
+    if (!hasSrv_ || count_ == 0) return;
+    mesh.DrawInstanced(srvIndex_, count_);
+}
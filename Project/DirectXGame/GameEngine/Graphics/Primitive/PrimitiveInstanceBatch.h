@@ -0,0 +1,55 @@
+#pragma once
+#include "Matrix4x4.h"
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstdint>
+
+class PrimitiveMesh;
+
+/// <summary>
+/// 同じメッシュ・マテリアルを持つ多数のプリミティブを 1 ドローコールで描くためのインスタンスバッファ。
+/// 容量ぶんの変換行列（WVP / World）を StructuredBuffer として確保し、Map したまま毎フレーム書き換える
+/// （ParticleManager のインスタンシングと同じ構成）。
+/// 描画は PrimitiveMesh::DrawInstanced に委譲するので、色・テクスチャ・ブレンドはそのメッシュの設定を共有する。
+/// </summary>
+class PrimitiveInstanceBatch {
+public:
+    // GPU 送信用（Primitive.hlsli の TransformationMatrix と同レイアウト）
+    struct InstanceData {
+        Matrix4x4 WVP;
+        Matrix4x4 World;
+    };
+
+    PrimitiveInstanceBatch() = default;
+    ~PrimitiveInstanceBatch();
+
+    PrimitiveInstanceBatch(const PrimitiveInstanceBatch&) = delete;
+    PrimitiveInstanceBatch& operator=(const PrimitiveInstanceBatch&) = delete;
+
+    /// <summary>capacity 個ぶんのバッファと SRV を確保する（以降は確保しない）。</summary>
+    void Initialize(uint32_t capacity);
+
+    /// <summary>バッファと SRV を解放する（GPU 完了後に呼ぶこと）。</summary>
+    void Finalize();
+
+    /// <summary>今フレームのインスタンスを空にする。</summary>
+    void Clear() { count_ = 0; }
+
+    /// <summary>1 インスタンス追加。容量を超えたら false（捨てる）。</summary>
+    bool Push(const Matrix4x4& world, const Matrix4x4& wvp);
+
+    /// <summary>積んだインスタンスを mesh の形状・マテリアルでまとめて描画する。</summary>
+    void Draw(PrimitiveMesh& mesh);
+
+    uint32_t GetCount() const { return count_; }
+    uint32_t GetCapacity() const { return capacity_; }
+    bool IsInitialized() const { return data_ != nullptr; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+    InstanceData* data_ = nullptr;
+    uint32_t srvIndex_ = 0;
+    bool     hasSrv_ = false;
+    uint32_t capacity_ = 0;
+    uint32_t count_ = 0;
+};
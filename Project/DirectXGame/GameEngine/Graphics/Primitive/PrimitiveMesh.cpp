@@ -13,6 +13,25 @@ void PrimitiveMesh::Initialize(const MeshData& meshData) {
     CreateMaterialResource();
 }
 
+void PrimitiveMesh::InitializeWithoutGeometry() {
+    vertexResource_.Reset();
+    indexResource_.Reset();
+    vertexBufferView_ = {};
+    indexBufferView_ = {};
+    vertexCount_ = 0;
+    indexCount_ = 0;
+    CreateTransformResource();
+    CreateMaterialResource();
+}
+
+void PrimitiveMesh::SetGeometryViews(const D3D12_VERTEX_BUFFER_VIEW& vbv, const D3D12_INDEX_BUFFER_VIEW& ibv,
+                                     uint32_t vertexCount, uint32_t indexCount) {
+    vertexBufferView_ = vbv;
+    indexBufferView_ = ibv;
+    vertexCount_ = vertexCount;
+    indexCount_ = indexCount;
+}
+
 void PrimitiveMesh::Update(Camera* camera) {
     // 旧API: dxCore のグローバル時間
     const float dt = PrimitivePipeline::GetInstance()->GetDxCore()->GetScaledDeltaTime();
@@ -124,28 +143,7 @@ Matrix4x4 PrimitiveMesh::BuildWorldMatrixFromMatrices(const Matrix4x4& viewMatri
     Matrix4x4 scaleMat     = MakeScaleMatrix(transform_);
     Matrix4x4 rotateMat    = useQuatRotation_ ? MakeRotateMatrix(rotateQuat_) : MakeRotateMatrix(transform_.rotate);
     Matrix4x4 translateMat = MakeTranslateMatrix(transform_);
-
-    Matrix4x4 billboardMat = MakeIdentity4x4();
-    if (billboardMode_ == BillboardMode::Full) {
-        billboardMat.m[0][0] = viewMatrix.m[0][0];
-        billboardMat.m[0][1] = viewMatrix.m[1][0];
-        billboardMat.m[0][2] = viewMatrix.m[2][0];
-        billboardMat.m[1][0] = viewMatrix.m[0][1];
-        billboardMat.m[1][1] = viewMatrix.m[1][1];
-        billboardMat.m[1][2] = viewMatrix.m[2][1];
-        billboardMat.m[2][0] = viewMatrix.m[0][2];
-        billboardMat.m[2][1] = viewMatrix.m[1][2];
-        billboardMat.m[2][2] = viewMatrix.m[2][2];
-    } else { // YAxis
-        float fx = cameraPos.x - transform_.translate.x;
-        float fz = cameraPos.z - transform_.translate.z;
-        float len = std::sqrt(fx * fx + fz * fz);
-        if (len < 1e-5f) { fx = 0.0f; fz = 1.0f; }
-        else             { fx /= len; fz /= len; }
-        billboardMat.m[0][0] = fz;   billboardMat.m[0][1] = 0.0f; billboardMat.m[0][2] = -fx;
-        billboardMat.m[1][0] = 0.0f; billboardMat.m[1][1] = 1.0f; billboardMat.m[1][2] = 0.0f;
-        billboardMat.m[2][0] = fx;   billboardMat.m[2][1] = 0.0f; billboardMat.m[2][2] = fz;
-    }
+    Matrix4x4 billboardMat = BuildBillboardMatrix(viewMatrix, cameraPos, transform_.translate);
 
     return Multiply(Multiply(Multiply(scaleMat, rotateMat), billboardMat), translateMat);
 }
@@ -161,23 +159,39 @@ Matrix4x4 PrimitiveMesh::BuildWorldMatrix(Camera* camera) const {
     Matrix4x4 scaleMat     = MakeScaleMatrix(transform_);
     Matrix4x4 rotateMat    = useQuatRotation_ ? MakeRotateMatrix(rotateQuat_) : MakeRotateMatrix(transform_.rotate);
     Matrix4x4 translateMat = MakeTranslateMatrix(transform_);
+    Matrix4x4 billboardMat = BuildBillboardMatrix(camera->GetViewMatrix(), camera->GetTranslate(), transform_.translate);
+
+    return Multiply(Multiply(Multiply(scaleMat, rotateMat), billboardMat), translateMat);
+}
+
+Matrix4x4 PrimitiveMesh::BuildInstanceWorldMatrix(Camera* camera, const Vector3& scale, const Vector3& rotate, const Vector3& translate) const {
+    const Transform transform{ scale, rotate, translate };
+    if (billboardMode_ == BillboardMode::None || !camera) {
+        return MakeAffineMatrix(transform);
+    }
+    Matrix4x4 scaleMat     = MakeScaleMatrix(transform);
+    Matrix4x4 rotateMat    = MakeRotateMatrix(rotate);
+    Matrix4x4 translateMat = MakeTranslateMatrix(transform);
+    Matrix4x4 billboardMat = BuildBillboardMatrix(camera->GetViewMatrix(), camera->GetTranslate(), translate);
+
+    return Multiply(Multiply(Multiply(scaleMat, rotateMat), billboardMat), translateMat);
+}
 
+Matrix4x4 PrimitiveMesh::BuildBillboardMatrix(const Matrix4x4& viewMatrix, const Vector3& cameraPos, const Vector3& translate) const {
     Matrix4x4 billboardMat = MakeIdentity4x4();
     if (billboardMode_ == BillboardMode::Full) {
-        const Matrix4x4& view = camera->GetViewMatrix();
-        billboardMat.m[0][0] = view.m[0][0];
-        billboardMat.m[0][1] = view.m[1][0];
-        billboardMat.m[0][2] = view.m[2][0];
-        billboardMat.m[1][0] = view.m[0][1];
-        billboardMat.m[1][1] = view.m[1][1];
-        billboardMat.m[1][2] = view.m[2][1];
-        billboardMat.m[2][0] = view.m[0][2];
-        billboardMat.m[2][1] = view.m[1][2];
-        billboardMat.m[2][2] = view.m[2][2];
-    } else { // YAxis
-        Vector3 camPos = camera->GetTranslate();
-        float fx = camPos.x - transform_.translate.x;
-        float fz = camPos.z - transform_.translate.z;
+        billboardMat.m[0][0] = viewMatrix.m[0][0];
+        billboardMat.m[0][1] = viewMatrix.m[1][0];
+        billboardMat.m[0][2] = viewMatrix.m[2][0];
+        billboardMat.m[1][0] = viewMatrix.m[0][1];
+        billboardMat.m[1][1] = viewMatrix.m[1][1];
+        billboardMat.m[1][2] = viewMatrix.m[2][1];
+        billboardMat.m[2][0] = viewMatrix.m[0][2];
+        billboardMat.m[2][1] = viewMatrix.m[1][2];
+        billboardMat.m[2][2] = viewMatrix.m[2][2];
+    } else if (billboardMode_ == BillboardMode::YAxis) {
+        float fx = cameraPos.x - translate.x;
+        float fz = cameraPos.z - translate.z;
         float len = std::sqrt(fx * fx + fz * fz);
         if (len < 1e-5f) { fx = 0.0f; fz = 1.0f; }
         else             { fx /= len; fz /= len; }
@@ -185,8 +199,7 @@ Matrix4x4 PrimitiveMesh::BuildWorldMatrix(Camera* camera) const {
         billboardMat.m[1][0] = 0.0f; billboardMat.m[1][1] = 1.0f; billboardMat.m[1][2] = 0.0f;
         billboardMat.m[2][0] = fx;   billboardMat.m[2][1] = 0.0f; billboardMat.m[2][2] = fz;
     }
-
-    return Multiply(Multiply(Multiply(scaleMat, rotateMat), billboardMat), translateMat);
+    return billboardMat;
 }
 
 void PrimitiveMesh::Draw() {
@@ -230,6 +243,38 @@ void PrimitiveMesh::Draw() {
     commandList->DrawIndexedInstanced(indexCount_, 1, 0, 0, 0);
 }
 
+void PrimitiveMesh::DrawInstanced(uint32_t instancingSrvIndex, uint32_t instanceCount) {
+    if (indexCount_ == 0 || vertexCount_ == 0 || instanceCount == 0) return;
+
+    // インスタンシング版のパイプライン（[0] が StructuredBuffer テーブル）
+    PrimitivePipeline::GetInstance()->PreDrawInstanced(blendMode_, depthWrite_, cullBackface_);
+
+    DirectXCore* dxCore = PrimitivePipeline::GetInstance()->GetDxCore();
+    ID3D12GraphicsCommandList* commandList = dxCore->GetCommandList();
+    SRVManager* srvManager = PrimitivePipeline::GetInstance()->GetSRVManager();
+
+    commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+    commandList->IASetIndexBuffer(&indexBufferView_);
+
+    // [0] VS: インスタンスごとの変換行列 (t0)
+    commandList->SetGraphicsRootDescriptorTable(0, srvManager->GetGPUDescriptorHandle(instancingSrvIndex));
+
+    // [1] PS: Material (b0)。全インスタンスで共通
+    commandList->SetGraphicsRootConstantBufferView(1, materialResource_->GetGPUVirtualAddress());
+
+    // [2] PS: テクスチャ（設定されている場合のみ）
+    if (hasTexture_) {
+        commandList->SetGraphicsRootDescriptorTable(2, srvManager->GetGPUDescriptorHandle(textureSrvIndex_));
+    }
+
+    // [3] PS: ディゾルブマスク（t1）。未設定時は white1x1 を必ずバインド。
+    uint32_t maskIdx = hasDissolveMask_ ? dissolveMaskSrvIndex_ : whiteSrvIndex_;
+    commandList->SetGraphicsRootDescriptorTable(3, srvManager->GetGPUDescriptorHandle(maskIdx));
+
+    PEPPER_COUNT("DrawCall");
+    commandList->DrawIndexedInstanced(indexCount_, instanceCount, 0, 0, 0);
+}
+
 void PrimitiveMesh::DrawIdPass(uint32_t objectId) {
     if (!transformResource_) return;
 
@@ -23,6 +23,14 @@ public:
     // 初期化（MeshDataを受け取ってGPUバッファ化）
     void Initialize(const MeshData& meshData);
 
+    // 形状バッファを持たずに初期化（変換行列・マテリアルの CB だけ作る）。
+    // 形状は SetGeometryViews で外部のバッファ（DynamicGeometryStream など）を指す。
+    void InitializeWithoutGeometry();
+
+    // 描画に使う VBV / IBV を差し替える（バッファの寿命は呼び出し側が持つ）。数が 0 なら描画しない
+    void SetGeometryViews(const D3D12_VERTEX_BUFFER_VIEW& vbv, const D3D12_INDEX_BUFFER_VIEW& ibv,
+                          uint32_t vertexCount, uint32_t indexCount);
+
     // 毎フレーム更新（WVP行列計算）
     // 旧版: dxCore のグローバル時間で UV スクロールが進む
     void Update(Camera* camera);
@@ -37,6 +45,13 @@ public:
     // 描画（メイン用 CB を bind）
     void Draw();
 
+    // インスタンシング描画。instancingSrvIndex は TransformationMatrix の StructuredBuffer の SRV。
+    // マテリアル・テクスチャ・ブレンド設定はこのメッシュのもの（Update で書いた値）を全インスタンスで共有する。
+    void DrawInstanced(uint32_t instancingSrvIndex, uint32_t instanceCount);
+
+    // インスタンス 1 個分のワールド行列（このメッシュの billboardMode を適用、transform_ は使わない）
+    Matrix4x4 BuildInstanceWorldMatrix(Camera* camera, const Vector3& scale, const Vector3& rotate, const Vector3& translate) const;
+
     // ID Pass：idMaskRT に objectId を書き込む
     void DrawIdPass(uint32_t objectId);
 
@@ -99,6 +114,9 @@ public:
     // per-instance の歪み強度（0..1）。 distortionMaterialData_->color.a に書かれ、シェーダーで texture.a × vertex.color.a × strength として使われる。
     void SetDistortionStrength(float s) { distortionStrength_ = s; }
 
+    // UV スクロールの累積を 0 に戻す（使い回すメッシュを再生の頭から流し直すとき用）
+    void ResetUVScroll() { uvScrollAccumulated_ = { 0.0f, 0.0f }; distortionUVScrollAccumulated_ = { 0.0f, 0.0f }; }
+
     // Transformアクセス（translate/rotate/scaleを外部から書き換え可能）
     Transform& GetTransform() { return transform_; }
     const Transform& GetTransform() const { return transform_; }
@@ -126,6 +144,9 @@ private:
     // ビュー行列とカメラ位置から billboard 補正込みのワールド行列を構築
     Matrix4x4 BuildWorldMatrixFromMatrices(const Matrix4x4& viewMatrix, const Vector3& cameraPos) const;
 
+    // billboardMode に応じた回転補正行列（None なら単位行列）。translate は YAxis の向き計算に使う
+    Matrix4x4 BuildBillboardMatrix(const Matrix4x4& viewMatrix, const Vector3& cameraPos, const Vector3& translate) const;
+
     // GPU送信用の変換行列構造体
     struct TransformationMatrix {
         Matrix4x4 WVP;
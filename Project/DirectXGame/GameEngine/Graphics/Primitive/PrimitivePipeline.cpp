@@ -11,15 +11,18 @@ void PrimitivePipeline::Initialize(DirectXCore* dxCore, SRVManager* srvManager)
     dxCore_ = dxCore;
     srvManager_ = srvManager;
 
-    CreateRootSignature();
-
-    // BlendMode × DepthWrite × CullBackface の3軸でPSOを作成
-    for (int i = 0; i < kCountOfBlendMode; ++i) {
-        BlendMode bm = static_cast<BlendMode>(i);
-        CreateGraphicsPipelineState(bm, false, false);
-        CreateGraphicsPipelineState(bm, false, true);
-        CreateGraphicsPipelineState(bm, true,  false);
-        CreateGraphicsPipelineState(bm, true,  true);
+    CreateRootSignature(false);
+    CreateRootSignature(true);
+
+    // BlendMode × DepthWrite × CullBackface の3軸でPSOを作成（通常版とインスタンシング版）
+    for (int inst = 0; inst < 2; ++inst) {
+        for (int i = 0; i < kCountOfBlendMode; ++i) {
+            BlendMode bm = static_cast<BlendMode>(i);
+            CreateGraphicsPipelineState(bm, false, false, inst != 0);
+            CreateGraphicsPipelineState(bm, false, true,  inst != 0);
+            CreateGraphicsPipelineState(bm, true,  false, inst != 0);
+            CreateGraphicsPipelineState(bm, true,  true,  inst != 0);
+        }
     }
 
     CreateIdPassObjects();
@@ -34,6 +37,14 @@ void PrimitivePipeline::Finalize() {
             }
         }
     }
+    for (auto& dim2 : instancedPipelineStates_) {
+        for (auto& dim1 : dim2) {
+            for (auto& pso : dim1) {
+                pso.Reset();
+            }
+        }
+    }
+    instancedRootSignature_.Reset();
     idPipelineState_.Reset();
     idRootSignature_.Reset();
     distortionPipelineState_.Reset();
@@ -51,9 +62,27 @@ void PrimitivePipeline::PreDraw(BlendMode blendMode, bool depthWrite, bool cullB
     commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
-void PrimitivePipeline::CreateRootSignature() {
+void PrimitivePipeline::PreDrawInstanced(BlendMode blendMode, bool depthWrite, bool cullBackface) {
+    ID3D12GraphicsCommandList* commandList = dxCore_->GetCommandList();
+
+    int depthIndex = depthWrite   ? 1 : 0;
+    int cullIndex  = cullBackface ? 1 : 0;
+
+    commandList->SetGraphicsRootSignature(instancedRootSignature_.Get());
+    commandList->SetPipelineState(instancedPipelineStates_[blendMode][depthIndex][cullIndex].Get());
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void PrimitivePipeline::CreateRootSignature(bool instanced) {
     HRESULT hr;
 
+    // DescriptorRange: SRV(t0) - インスタンスごとの変換行列（VS、インスタンシング版のみ）
+    D3D12_DESCRIPTOR_RANGE descriptorRangeInstancing[1] = {};
+    descriptorRangeInstancing[0].BaseShaderRegister = 0;
+    descriptorRangeInstancing[0].NumDescriptors = 1;
+    descriptorRangeInstancing[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    descriptorRangeInstancing[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
     // DescriptorRange: SRV(t0) - テクスチャ用（PS）
     D3D12_DESCRIPTOR_RANGE descriptorRangeTexture[1] = {};
     descriptorRangeTexture[0].BaseShaderRegister = 0;
@@ -70,10 +99,18 @@ void PrimitivePipeline::CreateRootSignature() {
 
     D3D12_ROOT_PARAMETER rootParameters[4] = {};
 
-    // [0] VS: CBV(b0) - TransformationMatrix
-    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-    rootParameters[0].Descriptor.ShaderRegister = 0;
+    if (instanced) {
+        // [0] VS: DescriptorTable - StructuredBuffer<TransformationMatrix>(t0)
+        rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameters[0].DescriptorTable.pDescriptorRanges = descriptorRangeInstancing;
+        rootParameters[0].DescriptorTable.NumDescriptorRanges = 1;
+    } else {
+        // [0] VS: CBV(b0) - TransformationMatrix
+        rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+        rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameters[0].Descriptor.ShaderRegister = 0;
+    }
 
     // [1] PS: CBV(b0) - Material
     rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -128,18 +165,20 @@ void PrimitivePipeline::CreateRootSignature() {
         assert(false);
     }
 
+    Microsoft::WRL::ComPtr<ID3D12RootSignature>& target = instanced ? instancedRootSignature_ : rootSignature_;
     hr = dxCore_->GetDevice()->CreateRootSignature(
         0,
         signatureBlob->GetBufferPointer(),
         signatureBlob->GetBufferSize(),
-        IID_PPV_ARGS(&rootSignature_));
+        IID_PPV_ARGS(&target));
     assert(SUCCEEDED(hr));
 }
 
-void PrimitivePipeline::CreateGraphicsPipelineState(BlendMode blendMode, bool depthWrite, bool cullBackface) {
-    // シェーダーコンパイル
+void PrimitivePipeline::CreateGraphicsPipelineState(BlendMode blendMode, bool depthWrite, bool cullBackface, bool instanced) {
+    // シェーダーコンパイル（PS は通常版と共通）
     IDxcBlob* vs = dxCore_->CompileShader(
-        L"Resources/Shaders/Primitive/Primitive.VS.hlsl",
+        instanced ? L"Resources/Shaders/Primitive/PrimitiveInstanced.VS.hlsl"
+                  : L"Resources/Shaders/Primitive/Primitive.VS.hlsl",
         L"vs_6_0"
     );
     IDxcBlob* ps = dxCore_->CompileShader(
@@ -232,7 +271,7 @@ void PrimitivePipeline::CreateGraphicsPipelineState(BlendMode blendMode, bool de
 
     // PSO
     D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
-    desc.pRootSignature = rootSignature_.Get();
+    desc.pRootSignature = instanced ? instancedRootSignature_.Get() : rootSignature_.Get();
     desc.VS = { vs->GetBufferPointer(), vs->GetBufferSize() };
     desc.PS = { ps->GetBufferPointer(), ps->GetBufferSize() };
     desc.InputLayout = inputLayout;
@@ -248,8 +287,9 @@ void PrimitivePipeline::CreateGraphicsPipelineState(BlendMode blendMode, bool de
 
     int depthIndex = depthWrite   ? 1 : 0;
     int cullIndex  = cullBackface ? 1 : 0;
+    auto& psoTable = instanced ? instancedPipelineStates_ : pipelineStates_;
     HRESULT hr = dxCore_->GetDevice()->CreateGraphicsPipelineState(
-        &desc, IID_PPV_ARGS(&pipelineStates_[blendMode][depthIndex][cullIndex]));
+        &desc, IID_PPV_ARGS(&psoTable[blendMode][depthIndex][cullIndex]));
     assert(SUCCEEDED(hr));
 }
 
@@ -30,6 +30,10 @@ public:
     // 描画前の共通設定（RootSig / PSO / Topology をセット）
     void PreDraw(BlendMode blendMode, bool depthWrite = false, bool cullBackface = false);
 
+    // インスタンシング描画用の PreDraw。[0] が VS の StructuredBuffer(t0) テーブルになる以外は
+    // 通常版と同じルートシグネチャ配置（[1] Material / [2] Texture / [3] DissolveMask）
+    void PreDrawInstanced(BlendMode blendMode, bool depthWrite = false, bool cullBackface = false);
+
     ID3D12RootSignature* GetRootSignature() const { return rootSignature_.Get(); }
 
     // ID Pass
@@ -45,8 +49,8 @@ private:
     PrimitivePipeline(const PrimitivePipeline&) = delete;
     PrimitivePipeline& operator=(const PrimitivePipeline&) = delete;
 
-    void CreateRootSignature();
-    void CreateGraphicsPipelineState(BlendMode mode, bool depthWrite, bool cullBackface);
+    void CreateRootSignature(bool instanced);
+    void CreateGraphicsPipelineState(BlendMode mode, bool depthWrite, bool cullBackface, bool instanced);
     void CreateIdPassObjects();
     void CreateDistortionPassObjects();
 
@@ -57,6 +61,10 @@ private:
     // pipelineStates_[BlendMode][DepthWrite(0/1)][CullBackface(0/1)]
     std::array<std::array<std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, 2>, 2>, kCountOfBlendMode> pipelineStates_;
 
+    // インスタンシング描画用（VS が SV_InstanceID で StructuredBuffer の変換行列を引く）
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> instancedRootSignature_;
+    std::array<std::array<std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, 2>, 2>, kCountOfBlendMode> instancedPipelineStates_;
+
     // ID Pass 用
     Microsoft::WRL::ComPtr<ID3D12RootSignature> idRootSignature_;
     Microsoft::WRL::ComPtr<ID3D12PipelineState> idPipelineState_;
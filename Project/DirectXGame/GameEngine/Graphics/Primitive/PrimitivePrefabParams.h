@@ -46,3 +46,29 @@ struct PrimitivePrefabParams {
 	PrimitiveGenerator::CylinderParams cylinderParams{};
 	PrimitiveGenerator::HelixParams    helixParams{};
 };
+
+/// <summary>
+/// PrimitivePrefabParams のフィールド並び（CookedDefs の .defs 読み書き用）
+/// </summary>
+template <class Ar>
+void CookFields(Ar& ar, PrimitivePrefabParams& v) {
+	ar.Field(v.primitiveType);
+	ar.Field(v.texturePath);
+	ar.Field(v.color);
+	ar.Field(v.blendMode);
+	ar.Field(v.depthWrite);
+	ar.Field(v.alphaReference);
+	ar.Field(v.cullBackface);
+	ar.Field(v.samplerMode);
+	ar.Field(v.uvAutoScroll);
+	ar.Field(v.uvScrollSpeed);
+	ar.Field(v.uvOffset);
+	ar.Field(v.uvScale);
+	ar.Field(v.uvFlipU);
+	ar.Field(v.uvFlipV);
+	ar.Field(v.billboardMode);
+	ar.Field(v.timeGroup);
+	ar.Field(v.ringParams);
+	ar.Field(v.cylinderParams);
+	ar.Field(v.helixParams);
+}
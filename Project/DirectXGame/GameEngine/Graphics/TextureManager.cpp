@@ -2,11 +2,57 @@
 #include "DDSHeader.h"
 #include "AssetLocator.h"
 #include "DStorageManager.h"
+#include "JobSystem.h"
+#include "TextureMips.h"
 #include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_set>
 //TextureManager* TextureManager::instance = nullptr;
 
 uint32_t TextureManager::kSRVIndexTop = 1;
 
+namespace {
+
+// 8bit RGBA / BGRA の 2D 1 枚ならミップを TextureMips で作る（DirectXTex の GenerateMipMaps より軽く、
+// 画像ごとに独立しているのでワーカースレッドで並べて回せる）。対象外の形式なら false を返す。
+bool GenerateMipsRGBA8(const DirectX::ScratchImage& image, bool linear, DirectX::ScratchImage& out)
+{
+    const DirectX::TexMetadata& meta = image.GetMetadata();
+    if (meta.dimension != DirectX::TEX_DIMENSION_TEXTURE2D || meta.mipLevels != 1
+        || meta.arraySize != 1 || meta.depth != 1 || meta.IsCubemap()) {
+        return false;
+    }
+    switch (meta.format) {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        break;
+    default:
+        return false;
+    }
+
+    const DirectX::Image* src = image.GetImage(0, 0, 0);
+    std::vector<TextureMips::Level> levels;
+    TextureMips::GenerateMipChain(src->pixels, static_cast<uint32_t>(src->width), static_cast<uint32_t>(src->height),
+                                  src->rowPitch, !linear, TextureMips::Filter::Box, levels);
+    if (FAILED(out.Initialize2D(meta.format, meta.width, meta.height, 1, levels.size()))) {
+        return false;
+    }
+    for (size_t mip = 0; mip < levels.size(); ++mip) {
+        const DirectX::Image* dst = out.GetImage(mip, 0, 0);
+        const TextureMips::Level& level = levels[mip];
+        const size_t rowBytes = static_cast<size_t>(level.width) * 4;
+        for (uint32_t y = 0; y < level.height; ++y) {
+            std::memcpy(dst->pixels + y * dst->rowPitch, level.pixels.data() + y * rowBytes, rowBytes);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 void TextureManager::Initialize(SpriteManager* spriteManager, DirectXCore* dxCore, SRVManager* srvManager)
 {
     spriteManager_ = spriteManager;
@@ -320,10 +366,13 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
         }
         // プレースホルダエントリを置いて多重ロードを防ぐ
         TextureData& slot = textureDatas[filePath];
-        slot.loadState = TextureData::LoadState::Unloaded;
+        slot.loadState = TextureData::LoadState::Decoding;
         slot.isLinear = linear;
     }
 
+    // パスのハッシュと目次引きはここで 1 回だけ。以降の DStorage / View / LoadAll は id で引く
+    const AssetId assetId = AssetLocator::GetInstance()->Resolve(filePath);
+
     // --- pack モード + DirectStorage 利用可能 + .dds なら DirectStorage 経路 ---
     // 診断用フラグ: false の間は DStorage 経路をスキップし AssetLocator::LoadAll 経由にする
     constexpr bool kEnableDirectStoragePath = true;
@@ -337,12 +386,12 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
         if (isDDS && loc->IsPackMode() && ds->IsInitialized() && ds->GetPackFile()) {
             uint64_t packOffset = 0, uncompressedSize = 0, compressedSize = 0;
             uint8_t  compression = 0;
-            if (loc->GetPackEntryInfoEx(filePath, packOffset,
+            if (loc->GetPackEntryInfoEx(assetId, packOffset,
                                         uncompressedSize, compressedSize, compression)) {
                 // DDS ヘッダーは pack 上で常に raw 格納 (148B)。
                 // Open() の AssetHandle.size_ は compressed_size を指しているが、
                 // 先頭 148B は uncompressed 領域なので普通に ReadAt 可能。
-                AssetHandle h = loc->Open(filePath);
+                AssetHandle h = loc->Open(assetId);
                 uint8_t headerBytes[200]{};
                 const uint32_t headerReadSize = static_cast<uint32_t>(
                     std::min<uint64_t>(sizeof(headerBytes), h.GetSize()));
@@ -411,8 +460,14 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
     }
 
     // --- AssetLocator 経由でバイト列取得（FS/Pack 両モード対応）→ Memory API でデコード ---
-    std::vector<uint8_t> bytes = AssetLocator::GetInstance()->LoadAll(filePath);
-    if (bytes.empty()) {
+    // pack (mmap) モードではマップ上のバイト列をそのままデコーダに渡す（コピーしない）
+    std::vector<uint8_t> bytes;
+    std::span<const uint8_t> src = AssetLocator::GetInstance()->View(assetId);
+    if (src.empty()) {
+        bytes = AssetLocator::GetInstance()->LoadAll(assetId);
+        src = bytes;
+    }
+    if (src.empty()) {
         OutputDebugStringA(("LoadTextureCPU: LoadAll returned empty for '" + filePath
                             + "' (mode=" + AssetLocator::GetInstance()->GetModeName()
                             + ")\n").c_str());
@@ -431,11 +486,11 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
                    });
     if (isDDS) {
         hr = DirectX::LoadFromDDSMemory(
-            bytes.data(), bytes.size(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+            src.data(), src.size(), DirectX::DDS_FLAGS_NONE, nullptr, image);
     } else {
         auto wicFlags = linear ? DirectX::WIC_FLAGS_IGNORE_SRGB : DirectX::WIC_FLAGS_FORCE_SRGB;
         hr = DirectX::LoadFromWICMemory(
-            bytes.data(), bytes.size(), wicFlags, nullptr, image);
+            src.data(), src.size(), wicFlags, nullptr, image);
     }
     if (FAILED(hr)) {
         char hrbuf[64];
@@ -451,6 +506,8 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
     if (DirectX::IsCompressed(image.GetMetadata().format)) {
         // 圧縮フォーマット（BC7/BC6H など）は既存ミップを使う
         mipImages = std::move(image);
+    } else if (GenerateMipsRGBA8(image, linear, mipImages)) {
+        // 8bit RGBA / BGRA は TextureMips で生成済み
     } else {
         auto filter = linear ? DirectX::TEX_FILTER_DEFAULT : DirectX::TEX_FILTER_SRGB;
         hr = DirectX::GenerateMipMaps(
@@ -476,16 +533,23 @@ void TextureManager::LoadTextureCPU(const std::string& filePath, bool linear)
 
 void TextureManager::LoadTextureGPU(const std::string& filePath)
 {
-    // メインスレッド専用。CPU フェーズが先に完了している前提。
+    // メインスレッド専用。別スレッドが CPU フェーズ中なら終わるまで待つ
+    // （失敗するとエントリごと消えるので、毎回引き直す）。
     TextureData* data = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(textureDatasMutex_);
-        auto it = textureDatas.find(filePath);
-        if (it == textureDatas.end()) return;
-        if (it->second.loadState == TextureData::LoadState::GPUReady) return;
-        assert(it->second.loadState == TextureData::LoadState::CPUReady
-               && "LoadTextureGPU called before LoadTextureCPU");
-        data = &it->second;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(textureDatasMutex_);
+            auto it = textureDatas.find(filePath);
+            if (it == textureDatas.end()) return;
+            if (it->second.loadState == TextureData::LoadState::GPUReady) return;
+            if (it->second.loadState != TextureData::LoadState::Decoding) {
+                assert(it->second.loadState == TextureData::LoadState::CPUReady
+                       && "LoadTextureGPU called before LoadTextureCPU");
+                data = &it->second;
+                break;
+            }
+        }
+        std::this_thread::yield();
     }
     // ※ unordered_map は要素を挿入してもポインタ無効化しないため
     //   ロック外で data を経由して触ってよい（同じエントリへは他から触らない契約）
@@ -642,6 +706,34 @@ void TextureManager::LoadTextureLinear(const std::string& filePath)
     LoadTextureGPU(filePath);
 }
 
+void TextureManager::LoadTextures(const std::vector<TextureRequest>& requests)
+{
+    // 重複と読み込み済みを除く（同じパスは最初の指定の linear を使う。LoadTexture を続けて呼んだときと同じ）
+    std::vector<const TextureRequest*> pending;
+    pending.reserve(requests.size());
+    std::unordered_set<std::string> seen;
+    for (const TextureRequest& req : requests) {
+        if (req.filePath.empty() || !seen.insert(req.filePath).second) continue;
+        if (IsGPUReady(req.filePath)) continue;
+        pending.push_back(&req);
+    }
+    if (pending.empty()) return;
+
+    // CPU フェーズ（ファイル読み込み・デコード・ミップ生成）は 1 枚ずつワーカーに配る。
+    // textureDatas へ触るのは LoadTextureCPU 内のロック区間だけなので、body 側でロックは要らない
+    JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(pending.size()), 1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                LoadTextureCPU(pending[i]->filePath, pending[i]->linear);
+            }
+        });
+
+    // GPU フェーズはコマンドリストと SRV の確保があるので呼び出し元で順に
+    for (const TextureRequest* req : pending) {
+        LoadTextureGPU(req->filePath);
+    }
+}
+
 TextureManager* TextureManager::GetInstance()
 {
     //if (instance == nullptr) {
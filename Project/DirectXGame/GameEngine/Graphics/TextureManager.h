@@ -9,6 +9,7 @@
 #include "DirectXCore.h"
 #include"SRVManager.h"
 #include<cassert>
+#include <vector>
 
 class TextureManager
 {
@@ -16,8 +17,9 @@ private:
 
 	// 既存のprivateセクションのTextureData構造体を修正:
 	struct TextureData {
-		// CPU/GPU 二段ロードの状態。Unloaded → CPUReady → GPUReady と遷移する。
-		enum class LoadState { Unloaded, CPUReady, GPUReady };
+		// CPU/GPU 二段ロードの状態。Unloaded → Decoding → CPUReady → GPUReady と遷移する。
+		// Decoding はエントリを確保したスレッドがデコード / ミップ生成をロック外で進めている間。
+		enum class LoadState { Unloaded, Decoding, CPUReady, GPUReady };
 		LoadState loadState = LoadState::Unloaded;
 
 		DirectX::TexMetadata metadata;
@@ -97,9 +99,23 @@ public:
 	/// <summary>
 	/// GPU フェーズ: ID3D12Resource 作成 / アップロード / SRV 作成。
 	/// メインスレッド専用。事前に LoadTextureCPU を呼んでおくこと。
+	/// 別スレッドの CPU フェーズがまだ終わっていなければ、終わるまで待つ。
 	/// </summary>
 	void LoadTextureGPU(const std::string& filePath);
 
+	/// <summary>LoadTextures に渡す 1 枚分の指定。</summary>
+	struct TextureRequest {
+		std::string filePath;
+		bool linear = false;  // true なら LoadTextureLinear 相当（ノーマルマップ・マスク用）
+	};
+
+	/// <summary>
+	/// 複数テクスチャの一括同期ロード。CPU フェーズ（読み込み + デコード + ミップ生成）を
+	/// JobSystem で並列に回し、GPU フェーズは呼び出し元（メインスレッド）でまとめて行う。
+	/// 同じパスの重複・読み込み済みのものは飛ばす。
+	/// </summary>
+	void LoadTextures(const std::vector<TextureRequest>& requests);
+
 	// 非同期ロードの状態クエリ
 	bool IsCPUReady(const std::string& filePath) const;
 	bool IsGPUReady(const std::string& filePath) const;
@@ -0,0 +1,385 @@
+#include "TextureMips.h"
+#include "DDSHeader.h"
+#include "JobSystem.h"
+#include "LogBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+constexpr float kKaiserRadius = 2.0f;  // 出力画素単位の半径（縮小率 2 なら元画素 ±4）
+constexpr float kKaiserAlpha = 4.0f;
+constexpr int kLinearToSrgbSize = 16384;
+
+// sRGB <-> 線形の変換表（起動後最初の呼び出しで 1 回だけ作る）
+struct SrgbTables {
+    float toLinear[256];
+    uint8_t toSrgb[kLinearToSrgbSize];
+
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) {
+            const float c = static_cast<float>(i) / 255.0f;
+            toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < kLinearToSrgbSize; ++i) {
+            const float l = static_cast<float>(i) / static_cast<float>(kLinearToSrgbSize - 1);
+            const float c = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+};
+
+const SrgbTables& Tables() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+uint8_t EncodeUnorm(float v) {
+    return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+uint8_t EncodeSrgb(const SrgbTables& t, float v) {
+    const int i = static_cast<int>(std::clamp(v, 0.0f, 1.0f) * static_cast<float>(kLinearToSrgbSize - 1) + 0.5f);
+    return t.toSrgb[i];
+}
+
+// 第 1 種変形ベッセル関数 I0（級数展開）
+float BesselI0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    const float q = x * x * 0.25f;
+    for (int k = 1; k < 32; ++k) {
+        term *= q / static_cast<float>(k * k);
+        sum += term;
+        if (term < sum * 1e-7f) break;
+    }
+    return sum;
+}
+
+float KaiserSinc(float x) {
+    const float t = x / kKaiserRadius;
+    if (t <= -1.0f || t >= 1.0f) return 0.0f;
+    const float sinc = (x == 0.0f) ? 1.0f : std::sin(kPi * x) / (kPi * x);
+    return sinc * BesselI0(kKaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kKaiserAlpha);
+}
+
+// 1 軸ぶんの縮小タップ。出力 i は taps[begin[i], begin[i + 1]) の (元添字, 重み) の和
+struct AxisTaps {
+    std::vector<uint32_t> begin;
+    std::vector<uint32_t> index;
+    std::vector<float> weight;
+    uint32_t span = 1;  // 1 つの出力が参照する元添字の幅（最大）
+};
+
+AxisTaps MakeTaps(uint32_t srcSize, uint32_t dstSize, TextureMips::Filter filter) {
+    AxisTaps taps;
+    taps.begin.reserve(dstSize + 1);
+    const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const int32_t last = static_cast<int32_t>(srcSize) - 1;
+    for (uint32_t i = 0; i < dstSize; ++i) {
+        taps.begin.push_back(static_cast<uint32_t>(taps.index.size()));
+        const size_t first = taps.index.size();
+        int32_t lo = 0;
+        int32_t hi = 0;
+        if (filter == TextureMips::Filter::Box) {
+            // [i * scale, (i + 1) * scale) に元画素がどれだけ被るか
+            const double x0 = i * scale;
+            const double x1 = (i + 1) * scale;
+            lo = static_cast<int32_t>(std::floor(x0));
+            hi = std::min(static_cast<int32_t>(std::ceil(x1)) - 1, last);
+            for (int32_t j = lo; j <= hi; ++j) {
+                const double overlap = std::min<double>(x1, j + 1) - std::max<double>(x0, j);
+                if (overlap <= 0.0) continue;
+                taps.index.push_back(static_cast<uint32_t>(j));
+                taps.weight.push_back(static_cast<float>(overlap));
+            }
+        } else {
+            // 出力画素の中心から元画素の中心までの距離（出力画素単位）で重みを決める。端は端の画素を繰り返す
+            const double center = (i + 0.5) * scale;
+            const double radius = kKaiserRadius * scale;
+            lo = static_cast<int32_t>(std::floor(center - radius));
+            hi = static_cast<int32_t>(std::ceil(center + radius));
+            for (int32_t j = lo; j <= hi; ++j) {
+                const float w = KaiserSinc(static_cast<float>((j + 0.5 - center) / scale));
+                if (w == 0.0f) continue;
+                taps.index.push_back(static_cast<uint32_t>(std::clamp(j, 0, last)));
+                taps.weight.push_back(w);
+            }
+        }
+        float sum = 0.0f;
+        for (size_t k = first; k < taps.weight.size(); ++k) sum += taps.weight[k];
+        for (size_t k = first; k < taps.weight.size(); ++k) taps.weight[k] /= sum;
+        taps.span = std::max(taps.span, static_cast<uint32_t>(std::clamp(hi, 0, last) - std::clamp(lo, 0, last) + 1));
+    }
+    taps.begin.push_back(static_cast<uint32_t>(taps.index.size()));
+    return taps;
+}
+
+// src を縦横それぞれ MakeTaps の重みで縮めて dst に書く。
+// 横に縮めた行をリングに持ち、縦のタップが被る隣の出力行で使い回す。
+void Downsample(const TextureMips::Level& src, TextureMips::Level& dst, bool srgb, TextureMips::Filter filter) {
+    const SrgbTables& t = Tables();
+    const AxisTaps hTaps = MakeTaps(src.width, dst.width, filter);
+    const AxisTaps vTaps = MakeTaps(src.height, dst.height, filter);
+    const size_t dstRowFloats = static_cast<size_t>(dst.width) * 4;
+
+    std::vector<float> decoded(static_cast<size_t>(src.width) * 4);
+    std::vector<float> ring(vTaps.span * dstRowFloats);
+    std::vector<int64_t> ringRow(vTaps.span, -1);
+    std::vector<float> acc(dstRowFloats);
+
+    auto filteredRow = [&](uint32_t y) -> const float* {
+        const size_t slot = y % vTaps.span;
+        float* out = ring.data() + slot * dstRowFloats;
+        if (ringRow[slot] == y) return out;
+        ringRow[slot] = y;
+
+        const uint8_t* row = src.pixels.data() + static_cast<size_t>(y) * src.width * 4;
+        for (uint32_t x = 0; x < src.width; ++x) {
+            const uint8_t* p = row + x * 4;
+            float* d = decoded.data() + x * 4;
+            if (srgb) {
+                d[0] = t.toLinear[p[0]];
+                d[1] = t.toLinear[p[1]];
+                d[2] = t.toLinear[p[2]];
+            } else {
+                d[0] = p[0] / 255.0f;
+                d[1] = p[1] / 255.0f;
+                d[2] = p[2] / 255.0f;
+            }
+            d[3] = p[3] / 255.0f;
+        }
+        for (uint32_t x = 0; x < dst.width; ++x) {
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+            for (uint32_t k = hTaps.begin[x]; k < hTaps.begin[x + 1]; ++k) {
+                const float* s = decoded.data() + hTaps.index[k] * 4;
+                const float w = hTaps.weight[k];
+                r += s[0] * w;
+                g += s[1] * w;
+                b += s[2] * w;
+                a += s[3] * w;
+            }
+            out[x * 4 + 0] = r;
+            out[x * 4 + 1] = g;
+            out[x * 4 + 2] = b;
+            out[x * 4 + 3] = a;
+        }
+        return out;
+    };
+
+    for (uint32_t y = 0; y < dst.height; ++y) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (uint32_t k = vTaps.begin[y]; k < vTaps.begin[y + 1]; ++k) {
+            const float* row = filteredRow(vTaps.index[k]);
+            const float w = vTaps.weight[k];
+            for (size_t i = 0; i < dstRowFloats; ++i) acc[i] += row[i] * w;
+        }
+        uint8_t* out = dst.pixels.data() + static_cast<size_t>(y) * dst.width * 4;
+        for (uint32_t x = 0; x < dst.width; ++x) {
+            const float* a = acc.data() + x * 4;
+            if (srgb) {
+                out[x * 4 + 0] = EncodeSrgb(t, a[0]);
+                out[x * 4 + 1] = EncodeSrgb(t, a[1]);
+                out[x * 4 + 2] = EncodeSrgb(t, a[2]);
+            } else {
+                out[x * 4 + 0] = EncodeUnorm(a[0]);
+                out[x * 4 + 1] = EncodeUnorm(a[1]);
+                out[x * 4 + 2] = EncodeUnorm(a[2]);
+            }
+            out[x * 4 + 3] = EncodeUnorm(a[3]);
+        }
+    }
+}
+
+} // namespace
+
+namespace TextureMips {
+
+uint32_t CountLevels(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+void GenerateMipChain(const uint8_t* src, uint32_t width, uint32_t height, size_t rowPitch,
+                      bool srgb, Filter filter, std::vector<Level>& out) {
+    out.clear();
+    if (!src || width == 0 || height == 0) return;
+    out.resize(CountLevels(width, height));
+
+    Level& top = out[0];
+    top.width = width;
+    top.height = height;
+    top.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        std::memcpy(top.pixels.data() + static_cast<size_t>(y) * width * 4, src + y * rowPitch,
+                    static_cast<size_t>(width) * 4);
+    }
+
+    for (size_t i = 1; i < out.size(); ++i) {
+        const Level& prev = out[i - 1];
+        Level& level = out[i];
+        level.width = std::max(1u, prev.width / 2);
+        level.height = std::max(1u, prev.height / 2);
+        level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+        Downsample(prev, level, srgb, filter);
+    }
+}
+
+} // namespace TextureMips
+
+// =====================================================================
+// ベンチマーク
+// =====================================================================
+namespace {
+
+constexpr uint32_t kDxgiR8G8B8A8UnormSrgb = 29;
+
+// 非圧縮 R8G8B8A8_UNORM_SRGB の DDS（DX10 拡張ヘッダー付き）をメモリ上に作る。中身はグラデーション + ノイズ
+std::vector<uint8_t> MakeSyntheticDDS(uint32_t width, uint32_t height, uint32_t seed) {
+    const size_t headerSize = 4 + DDS::kHeaderSize + DDS::kDXT10HeaderSize;
+    std::vector<uint8_t> file(headerSize + static_cast<size_t>(width) * height * 4);
+
+    DDS::Header header{};
+    header.size = DDS::kHeaderSize;
+    header.flags = 0x1 | 0x2 | 0x4 | 0x1000;  // CAPS | HEIGHT | WIDTH | PIXELFORMAT
+    header.height = height;
+    header.width = width;
+    header.pitchOrLinearSize = width * 4;
+    header.mipMapCount = 1;
+    header.ddspf.size = DDS::kPixelFormatSize;
+    header.ddspf.flags = DDS::kDDPF_FOURCC;
+    header.ddspf.fourCC = DDS::kFourCC_DX10;
+    header.caps = 0x1000;  // TEXTURE
+    DDS::HeaderDXT10 dxt10{};
+    dxt10.dxgiFormat = kDxgiR8G8B8A8UnormSrgb;
+    dxt10.resourceDimension = 3;
+    dxt10.arraySize = 1;
+    std::memcpy(file.data(), &DDS::kMagic, 4);
+    std::memcpy(file.data() + 4, &header, DDS::kHeaderSize);
+    std::memcpy(file.data() + 4 + DDS::kHeaderSize, &dxt10, DDS::kDXT10HeaderSize);
+
+    std::mt19937 rng(seed);
+    uint8_t* p = file.data() + headerSize;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x, p += 4) {
+            const uint32_t noise = rng();
+            p[0] = static_cast<uint8_t>(x * 255 / width ^ (noise & 0x1F));
+            p[1] = static_cast<uint8_t>(y * 255 / height ^ ((noise >> 8) & 0x1F));
+            p[2] = static_cast<uint8_t>(((x / 16 + y / 16) & 1) ? 230 : 25);
+            p[3] = static_cast<uint8_t>(255 - ((noise >> 16) & 0x3F));
+        }
+    }
+    return file;
+}
+
+// テクスチャ 1 枚ぶんの CPU フェーズ（TextureManager::LoadTextureCPU の DDS 非圧縮経路と同じ順番）
+bool DecodeAndMip(const std::vector<uint8_t>& file, TextureMips::Filter filter,
+                  std::vector<TextureMips::Level>& out) {
+    DDS::ParsedDDS info;
+    if (!DDS::ParseDDS(file.data(), file.size(), info)) return false;
+    if (static_cast<uint32_t>(info.format) != kDxgiR8G8B8A8UnormSrgb) return false;
+    const size_t rowPitch = static_cast<size_t>(info.width) * 4;
+    if (file.size() < info.payloadOffset + rowPitch * info.height) return false;
+    TextureMips::GenerateMipChain(file.data() + info.payloadOffset, info.width, info.height, rowPitch,
+                                  true, filter, out);
+    return true;
+}
+
+bool SameChain(const std::vector<TextureMips::Level>& a, const std::vector<TextureMips::Level>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].pixels != b[i].pixels) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void RunTextureMipBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kReps = 3;
+
+    // 大きいものから並べる（ParallelFor は添字順にチャンクを配るので、重いものを先に捌く）
+    struct Spec { uint32_t size; int count; };
+    const Spec specs[] = { { 2048, 2 }, { 1024, 6 }, { 512, 16 } };
+    std::vector<std::vector<uint8_t>> files;
+    uint64_t totalBytes = 0;
+    for (const Spec& s : specs) {
+        for (int i = 0; i < s.count; ++i) {
+            files.push_back(MakeSyntheticDDS(s.size, s.size, static_cast<uint32_t>(files.size() + 1)));
+            totalBytes += files.back().size();
+        }
+    }
+    const uint32_t count = static_cast<uint32_t>(files.size());
+
+    JobSystem* jobs = JobSystem::GetInstance();
+    if (!jobs->IsInitialized()) jobs->Initialize();
+    const uint32_t maxThreads = jobs->GetWorkerCount() + 1;
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[Texture] CPU decode + mips: %u sRGB RGBA8 DDS (2x2048 6x1024 16x512, %.1f MB), %u threads available",
+        count, totalBytes / (1024.0 * 1024.0), maxThreads);
+    LogBuffer::Instance().Add(buf);
+
+    for (TextureMips::Filter filter : { TextureMips::Filter::Box, TextureMips::Filter::Kaiser }) {
+        // 直列の結果を正解にする
+        std::vector<std::vector<TextureMips::Level>> reference(count);
+        bool ok = true;
+        auto t0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) {
+            for (uint32_t i = 0; i < count; ++i) ok = DecodeAndMip(files[i], filter, reference[i]) && ok;
+        }
+        const double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kReps;
+
+        std::string line;
+        bool match = ok;
+        for (uint32_t threads : threadCounts) {
+            std::vector<std::vector<TextureMips::Level>> results(count);
+            t0 = Clock::now();
+            for (int r = 0; r < kReps; ++r) {
+                jobs->ParallelFor(count, 1, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i) DecodeAndMip(files[i], filter, results[i]);
+                }, threads);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / kReps;
+            for (uint32_t i = 0; match && i < count; ++i) match = SameChain(results[i], reference[i]);
+            std::snprintf(buf, sizeof(buf), "  %ut %.1fms (x%.1f)", threads, ms, (ms > 0.0) ? serialMs / ms : 0.0);
+            line += buf;
+        }
+        std::snprintf(buf, sizeof(buf), "[Texture] %-6s serial %.1f ms |",
+            filter == TextureMips::Filter::Box ? "Box" : "Kaiser", serialMs);
+        LogBuffer::Instance().Add(std::string(buf) + line + (match ? "  match" : "  MISMATCH"),
+            match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+    }
+
+    // sRGB 平均の確認: 0 / 255 の市松模様を 1 段縮めると、線形で平均すれば sRGB 188 前後（ガンマのまま平均すると 128）
+    std::vector<uint8_t> checker(4 * 4 * 4);
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint8_t v = ((i % 4 + i / 4) & 1) ? 255 : 0;
+        checker[i * 4 + 0] = checker[i * 4 + 1] = checker[i * 4 + 2] = v;
+        checker[i * 4 + 3] = 255;
+    }
+    std::vector<TextureMips::Level> srgbChain;
+    std::vector<TextureMips::Level> linearChain;
+    TextureMips::GenerateMipChain(checker.data(), 4, 4, 16, true, TextureMips::Filter::Box, srgbChain);
+    TextureMips::GenerateMipChain(checker.data(), 4, 4, 16, false, TextureMips::Filter::Box, linearChain);
+    const int srgbValue = srgbChain[1].pixels[0];
+    const bool srgbOk = srgbValue >= 186 && srgbValue <= 189;
+    std::snprintf(buf, sizeof(buf), "[Texture] sRGB check: 0/255 checker -> mip1 %d as sRGB (expect ~188), %d as linear data  %s",
+        srgbValue, linearChain[1].pixels[0], srgbOk ? "ok" : "WRONG");
+    LogBuffer::Instance().Add(buf, srgbOk ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 8bit RGBA（BGRA でも可。チャンネル 3 を alpha として扱う）画像のミップ生成。
+/// DirectXTex に依存しないので、テクスチャ読み込みの CPU フェーズを Windows 以外でも回して計れる。
+///
+/// 各レベルは 1 つ上のレベルから縦横 1/2 に縮小して作る（奇数サイズは範囲の被り率で重み付け）。
+/// srgb = true なら RGB を線形に戻してから平均し、sRGB に戻して書く（alpha は常に線形のまま）。
+/// </summary>
+namespace TextureMips {
+
+    enum class Filter {
+        Box,     // 元画素の被り面積で平均（DirectXTex の TEX_FILTER_DEFAULT / BOX と同じ見た目）
+        Kaiser,  // Kaiser 窓付き sinc（半径 2 出力画素）。Box よりシャープで、エイリアスも少ない
+    };
+
+    /// <summary>1 レベル分の画像。pixels は width * height * 4 バイトで行間の詰め物なし。</summary>
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    /// <summary>1x1 まで縮めたときのレベル数（level 0 を含む）。</summary>
+    uint32_t CountLevels(uint32_t width, uint32_t height);
+
+    /// <summary>
+    /// src（rowPitch バイト間隔の width x height）を level 0 としてコピーし、1x1 までのミップを out に作る。
+    /// スレッドセーフ（共有するのは読み取り専用の変換表だけ）なので、画像ごとに別スレッドで呼んでよい。
+    /// </summary>
+    void GenerateMipChain(const uint8_t* src, uint32_t width, uint32_t height, size_t rowPitch,
+                          bool srgb, Filter filter, std::vector<Level>& out);
+
+} // namespace TextureMips
+
+/// <summary>
+/// 合成した非圧縮 sRGB の DDS をまとめて読む CPU フェーズ（ヘッダー解析 + コピー + ミップ生成）を、
+/// Box / Kaiser それぞれ JobSystem のスレッド数を振って計り、直列との一致と sRGB 平均の確認結果を LogBuffer に出す。
+/// </summary>
+void RunTextureMipBenchmark();
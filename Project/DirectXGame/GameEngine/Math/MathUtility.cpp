@@ -2,6 +2,7 @@
 #include <math.h>
 #define _USE_MATH_DEFINES
 #include <cassert>
+#include <cmath>
 
 float Cotangent(float theta)
 {
@@ -667,4 +668,24 @@ Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t)
 	result.y = v1.y + (v2.y - v1.y) * t;
 	result.z = v1.z + (v2.z - v1.z) * t;
 	return result;
+}
+
+Transform LerpTransform(const Transform& t1, const Transform& t2, float t)
+{
+	// オイラー角は 2π 周期なので、差を [-π, π] に畳んでから補間する（-π と π の間で 1 回転しないように）
+	auto lerpAngle = [t](float a, float b) {
+		float d = std::fmod(b - a, 2.0f * kPi);
+		if (d > kPi) d -= 2.0f * kPi;
+		else if (d < -kPi) d += 2.0f * kPi;
+		return a + d * t;
+	};
+
+	Transform result;
+	result.scale = Lerp(t1.scale, t2.scale, t);
+	result.rotate = {
+		lerpAngle(t1.rotate.x, t2.rotate.x),
+		lerpAngle(t1.rotate.y, t2.rotate.y),
+		lerpAngle(t1.rotate.z, t2.rotate.z) };
+	result.translate = Lerp(t1.translate, t2.translate, t);
+	return result;
 }
\ No newline at end of file
@@ -136,4 +136,7 @@ float Length(const Vector3& vector);
 Vector3 Normalize(const Vector3& vector);
 
 // 線形補間（Vector3）
-Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t);
\ No newline at end of file
+Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t);
+
+// Transform の補間（scale/translate は線形、rotate は成分ごとに近い回り方で補間する）
+Transform LerpTransform(const Transform& t1, const Transform& t2, float t);
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include "Transform.h"
+#include "MathUtility.h"
+#include "EngineTime.h"
+
+/// <summary>
+/// 固定ステップ更新の描画補間用に、直前 2 tick 分の Transform を持つ。
+/// 更新側は毎回 Record を呼ぶだけ（同じ tick 内で何度呼んでも「前 tick の値」は 1 回しか退避しない）。
+/// 描画側は NeedsRender で今の描画フレームで未補間かを確かめ、Interpolated で補間済み Transform を得る。
+/// 最新 tick で Record されていない（ポーズ中・毎 tick 更新しないオブジェクト）なら補間せず最新値のまま止める。
+/// </summary>
+class TransformHistory {
+public:
+    static constexpr uint64_t kNone = UINT64_MAX;
+
+    /// <summary>この tick の最新 Transform を記録する。</summary>
+    void Record(const Transform& transform) {
+        const uint64_t tick = EngineTime::GetSimulationTick();
+        if (tick != tick_) {
+            previous_ = (tick_ == kNone) ? transform : current_;
+            tick_ = tick;
+        }
+        current_ = transform;
+        renderedFrame_ = kNone;
+        settled_ = false;
+    }
+
+    /// <summary>瞬間移動などの直後に呼ぶ。次の Record で前 tick の値も最新値にそろえ、補間で間を通らないようにする。</summary>
+    void Reset() { tick_ = kNone; }
+
+    /// <summary>
+    /// 補間が必要で、かつこの描画フレームではまだ補間していないなら true（呼ぶと補間済みとして印を付ける）。
+    /// 最新 tick で Record されていなければ、最新値を書き直す 1 回だけ true を返し、以降は false。
+    /// </summary>
+    bool NeedsRender() {
+        if (tick_ == kNone || EngineTime::GetInterpolationAlpha() >= 1.0f) return false;
+        const uint64_t frame = EngineTime::GetRenderFrame();
+        if (renderedFrame_ == frame) return false;
+        if (!IsRecordedThisTick()) {
+            // 途中の補間値で止まらないよう最新値へそろえるのは 1 回だけ（補間係数が動いても揺らさない）
+            if (settled_) return false;
+            settled_ = true;
+        }
+        renderedFrame_ = frame;
+        return true;
+    }
+
+    /// <summary>前 tick と最新 tick を現在の補間係数で補間した Transform。最新 tick で Record されていなければ最新値。</summary>
+    Transform Interpolated() const {
+        if (!IsRecordedThisTick()) return current_;
+        return LerpTransform(previous_, current_, EngineTime::GetInterpolationAlpha());
+    }
+
+    /// <summary>最新の simulation tick で Record されたか（tick は更新の前に進むので、同じ tick 番号なら最新）。</summary>
+    bool IsRecordedThisTick() const { return tick_ == EngineTime::GetSimulationTick(); }
+
+    const Transform& GetCurrent() const { return current_; }
+
+private:
+    Transform previous_{};
+    Transform current_{};
+    uint64_t tick_ = kNone;
+    uint64_t renderedFrame_ = kNone;
+    bool settled_ = false;
+};
@@ -0,0 +1,285 @@
+#include "Voronoi2D.h"
+#include "JobSystem.h"
+#include "LogBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+	// これ未満の種点数はワーカーへ配るほうが高くつくので呼び出し元だけで組む
+	constexpr size_t kParallelThreshold = 256;
+	// ParallelFor の 1 チャンクの種点数（チャンクごとに作業用の頂点配列を確保するので細かくしすぎない）
+	constexpr uint32_t kSitesPerChunk = 64;
+
+	/// 種点をグリッドに振り分けた索引（セルごとの種点 index を 1 本の配列に詰める）。
+	struct SiteGrid {
+		int cols = 1;
+		int rows = 1;
+		float cellW = 1.0f;
+		float cellH = 1.0f;
+		std::vector<uint32_t> start; // グリッド (x,y) の種点は items[start[k] .. start[k+1])
+		std::vector<uint32_t> items;
+
+		int ColOf(float x) const { return std::clamp(static_cast<int>(x / cellW), 0, cols - 1); }
+		int RowOf(float y) const { return std::clamp(static_cast<int>(y / cellH), 0, rows - 1); }
+
+		void Build(const std::vector<Vector2>& sites, float width, float height) {
+			const float n = static_cast<float>(sites.size());
+			// 1 グリッドに種点が 1〜2 個入るくらい（セルが正方形に近くなるよう縦横比で割り振る）
+			const float aspect = (height > 0.0f) ? width / height : 1.0f;
+			cols = (std::max)(1, static_cast<int>(std::sqrt(n * aspect)));
+			rows = (std::max)(1, static_cast<int>(std::sqrt(n / aspect)));
+			cellW = width / static_cast<float>(cols);
+			cellH = height / static_cast<float>(rows);
+
+			// 計数ソート（2 パス）
+			start.assign(static_cast<size_t>(cols) * rows + 1, 0);
+			for (const Vector2& s : sites) ++start[RowOf(s.y) * cols + ColOf(s.x) + 1];
+			for (size_t k = 1; k < start.size(); ++k) start[k] += start[k - 1];
+			items.resize(sites.size());
+			std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+			for (uint32_t i = 0; i < sites.size(); ++i) {
+				items[cursor[RowOf(sites[i].y) * cols + ColOf(sites[i].x)]++] = i;
+			}
+		}
+	};
+
+	/// 種点 i 側（dot(p-mid, dir) <= 0、dir = seedJ - seedI）だけ残す（Sutherland-Hodgman）。
+	/// 全頂点が内側なら何もしない。結果は poly に入れ直し、scratch は作業用（確保を使い回す）。
+	void ClipHalfPlane(std::vector<Vector2>& poly, std::vector<Vector2>& scratch, const Vector2& mid, const Vector2& dir) {
+		const size_t m = poly.size();
+		bool anyOut = false;
+		for (size_t k = 0; k < m && !anyOut; ++k) {
+			anyOut = (poly[k].x - mid.x) * dir.x + (poly[k].y - mid.y) * dir.y > 0.0f;
+		}
+		if (!anyOut) return;
+
+		scratch.clear();
+		for (size_t k = 0; k < m; ++k) {
+			const Vector2& a = poly[k];
+			const Vector2& b = poly[(k + 1) % m];
+			const float fa = (a.x - mid.x) * dir.x + (a.y - mid.y) * dir.y;
+			const float fb = (b.x - mid.x) * dir.x + (b.y - mid.y) * dir.y;
+			const bool inA = fa <= 0.0f;
+			const bool inB = fb <= 0.0f;
+			if (inA) scratch.push_back(a);
+			if (inA != inB) {
+				const float t = fa / (fa - fb);
+				scratch.push_back({ a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t });
+			}
+		}
+		poly.swap(scratch);
+	}
+
+	void ClipBySite(std::vector<Vector2>& poly, std::vector<Vector2>& scratch, const Vector2& si, const Vector2& sj) {
+		const Vector2 dir{ sj.x - si.x, sj.y - si.y };
+		if (dir.x * dir.x + dir.y * dir.y < 1e-12f) return; // 同一点
+		const Vector2 mid{ (si.x + sj.x) * 0.5f, (si.y + sj.y) * 0.5f };
+		ClipHalfPlane(poly, scratch, mid, dir);
+	}
+
+	/// 面積重み付き重心（縮退時は頂点平均でフォールバック）。
+	/// 小さなセルで外積が桁落ちしないよう、先頭頂点を原点にした座標で積算する。
+	Vector2 Centroid(const std::vector<Vector2>& poly, float* outArea = nullptr) {
+		const Vector2 o = poly[0];
+		float area = 0.0f;
+		Vector2 c{ 0.0f, 0.0f };
+		const size_t m = poly.size();
+		for (size_t k = 0; k < m; ++k) {
+			const Vector2 a{ poly[k].x - o.x, poly[k].y - o.y };
+			const Vector2 b{ poly[(k + 1) % m].x - o.x, poly[(k + 1) % m].y - o.y };
+			const float cross = a.x * b.y - b.x * a.y;
+			area += cross;
+			c.x += (a.x + b.x) * cross;
+			c.y += (a.y + b.y) * cross;
+		}
+		if (outArea) *outArea = area * 0.5f;
+		if (std::abs(area) < 1e-12f) {
+			c = { 0.0f, 0.0f };
+			for (const auto& p : poly) { c.x += p.x; c.y += p.y; }
+			c.x /= static_cast<float>(m); c.y /= static_cast<float>(m);
+		} else {
+			c.x = o.x + c.x / (3.0f * area);
+			c.y = o.y + c.y / (3.0f * area);
+		}
+		return c;
+	}
+
+	float MaxDistSq(const std::vector<Vector2>& poly, const Vector2& s) {
+		float r2 = 0.0f;
+		for (const Vector2& p : poly) {
+			const float dx = p.x - s.x, dy = p.y - s.y;
+			r2 = (std::max)(r2, dx * dx + dy * dy);
+		}
+		return r2;
+	}
+
+	/// 種点 i のセルを組む。poly / scratch は呼び出し側の使い回しバッファ。
+	void BuildOne(const std::vector<Vector2>& sites, const SiteGrid& grid, uint32_t i,
+		float width, float height, std::vector<Vector2>& poly, std::vector<Vector2>& scratch) {
+		const Vector2& si = sites[i];
+		poly.clear();
+		poly.push_back({ 0.0f, 0.0f });
+		poly.push_back({ width, 0.0f });
+		poly.push_back({ width, height });
+		poly.push_back({ 0.0f, height });
+
+		const int cx = grid.ColOf(si.x);
+		const int cy = grid.RowOf(si.y);
+		const int maxRing = (std::max)(grid.cols, grid.rows);
+
+		for (int r = 0; r <= maxRing && poly.size() >= 3; ++r) {
+			// リング r より外の種点は、(2r+1)^2 ブロックの外にある＝種点からブロック境界までの距離以上離れている。
+			// それが 2R（R = 種点からセル最遠頂点）を超えたら、もう誰もセルを削れない。
+			if (r > 0) {
+				const float left   = si.x - static_cast<float>(cx - (r - 1)) * grid.cellW;
+				const float right  = static_cast<float>(cx + r) * grid.cellW - si.x;
+				const float bottom = si.y - static_cast<float>(cy - (r - 1)) * grid.cellH;
+				const float top    = static_cast<float>(cy + r) * grid.cellH - si.y;
+				const float lb = (std::min)((std::min)(left, right), (std::min)(bottom, top));
+				if (lb > 0.0f && lb * lb >= 4.0f * MaxDistSq(poly, si)) break;
+			}
+
+			const int x0 = cx - r, x1 = cx + r, y0 = cy - r, y1 = cy + r;
+			for (int gy = (std::max)(y0, 0); gy <= (std::min)(y1, grid.rows - 1); ++gy) {
+				const bool edgeRow = (gy == y0 || gy == y1);
+				// リングの外周だけを回る（内側は前のリングで処理済み）
+				const int step = edgeRow ? 1 : (x1 - x0);
+				for (int gx = x0; gx <= x1; gx += (step > 0 ? step : 1)) {
+					if (gx < 0 || gx >= grid.cols) continue;
+					const size_t k = static_cast<size_t>(gy) * grid.cols + gx;
+					for (uint32_t a = grid.start[k]; a < grid.start[k + 1]; ++a) {
+						const uint32_t j = grid.items[a];
+						if (j != i) ClipBySite(poly, scratch, si, sites[j]);
+					}
+				}
+			}
+		}
+	}
+}
+
+namespace Voronoi2D {
+
+	void BuildCells(const std::vector<Vector2>& sites, float width, float height, std::vector<Cell>& out) {
+		out.clear();
+		if (sites.empty() || width <= 0.0f || height <= 0.0f) return;
+
+		SiteGrid grid;
+		grid.Build(sites, width, height);
+
+		// 種点ごとに結果を置く（チャンクは担当範囲にだけ書く）→ 最後に潰れたセルを詰める
+		std::vector<Cell> cells(sites.size());
+		auto work = [&](uint32_t begin, uint32_t end) {
+			std::vector<Vector2> poly, scratch;
+			poly.reserve(32);
+			scratch.reserve(32);
+			for (uint32_t i = begin; i < end; ++i) {
+				BuildOne(sites, grid, i, width, height, poly, scratch);
+				Cell& c = cells[i];
+				c.site = i;
+				if (poly.size() < 3) continue;
+				c.centroid = Centroid(poly);
+				c.polygon.assign(poly.begin(), poly.end());
+			}
+		};
+
+		const uint32_t n = static_cast<uint32_t>(sites.size());
+		if (sites.size() < kParallelThreshold) {
+			work(0, n);
+		} else {
+			// 呼び出しのたびにスレッドを作らず、起動時に作ったワーカーで分担する
+			JobSystem::GetInstance()->ParallelFor(n, kSitesPerChunk, work);
+		}
+
+		out.reserve(cells.size());
+		for (Cell& c : cells) {
+			if (c.polygon.size() >= 3) out.push_back(std::move(c));
+		}
+	}
+
+	void BuildCellsBruteForce(const std::vector<Vector2>& sites, float width, float height, std::vector<Cell>& out) {
+		out.clear();
+		const Vector2 rect[4] = { {0.0f,0.0f}, {width,0.0f}, {width,height}, {0.0f,height} };
+		std::vector<Vector2> scratch;
+		const size_t n = sites.size();
+		for (size_t i = 0; i < n; ++i) {
+			std::vector<Vector2> poly(rect, rect + 4);
+			for (size_t j = 0; j < n && poly.size() >= 3; ++j) {
+				if (j == i) continue;
+				ClipBySite(poly, scratch, sites[i], sites[j]);
+			}
+			if (poly.size() < 3) continue;
+			Cell c;
+			c.site = static_cast<uint32_t>(i);
+			c.centroid = Centroid(poly);
+			c.polygon = std::move(poly);
+			out.push_back(std::move(c));
+		}
+	}
+
+	void RunBenchmark() {
+		using Clock = std::chrono::high_resolution_clock;
+		const int kCounts[] = { 100, 500, 2000 };
+		const uint32_t kSeeds[] = { 1u, 7u, 12345u };
+		const float aspect = 16.0f / 9.0f;
+		const float kEps = 1e-4f;
+
+		LogBuffer::Instance().Add("[Voronoi2D] Cell build benchmark (grid + security radius vs brute force)");
+		for (int count : kCounts) {
+			for (uint32_t seed : kSeeds) {
+				// StagePlayScene::BuildDisruptorCells と同じ撒き方
+				std::mt19937 rng(seed);
+				std::uniform_real_distribution<float> dx(0.0f, aspect);
+				std::uniform_real_distribution<float> dy(0.0f, 1.0f);
+				std::vector<Vector2> sites(static_cast<size_t>(count));
+				for (auto& s : sites) s = { dx(rng), dy(rng) };
+
+				std::vector<Cell> fast, ref;
+				const auto t0 = Clock::now();
+				BuildCells(sites, aspect, 1.0f, fast);
+				const auto t1 = Clock::now();
+				BuildCellsBruteForce(sites, aspect, 1.0f, ref);
+				const auto t2 = Clock::now();
+
+				// 一致判定：同じ種点のセルが、重心・面積・頂点集合（許容誤差内）で一致するか。
+				// クリップ順が違うので開始頂点や浮動小数の端数は揃わない。
+				bool match = (fast.size() == ref.size());
+				for (size_t c = 0; match && c < fast.size(); ++c) {
+					const Cell& a = fast[c];
+					const Cell& b = ref[c];
+					float areaA = 0.0f, areaB = 0.0f;
+					Centroid(a.polygon, &areaA);
+					Centroid(b.polygon, &areaB);
+					match = a.site == b.site
+						&& std::abs(a.centroid.x - b.centroid.x) < kEps
+						&& std::abs(a.centroid.y - b.centroid.y) < kEps
+						&& std::abs(areaA - areaB) < kEps;
+					auto covered = [kEps](const std::vector<Vector2>& from, const std::vector<Vector2>& to) {
+						for (const Vector2& p : from) {
+							bool found = false;
+							for (const Vector2& q : to) {
+								if (std::abs(p.x - q.x) < kEps && std::abs(p.y - q.y) < kEps) { found = true; break; }
+							}
+							if (!found) return false;
+						}
+						return true;
+					};
+					match = match && covered(a.polygon, b.polygon) && covered(b.polygon, a.polygon);
+				}
+
+				const double fastMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+				const double refMs  = std::chrono::duration<double, std::milli>(t2 - t1).count();
+				char buf[192];
+				std::snprintf(buf, sizeof(buf),
+					"[Voronoi2D] n=%4d seed=%5u  grid %.2f ms  brute %.2f ms  (x%.1f)  %s",
+					count, seed, fastMs, refMs, (fastMs > 0.0) ? refMs / fastMs : 0.0,
+					match ? "match" : "MISMATCH");
+				LogBuffer::Instance().Add(buf, match ? LogBuffer::Level::Info : LogBuffer::Level::Error);
+			}
+		}
+	}
+
+} // namespace Voronoi2D
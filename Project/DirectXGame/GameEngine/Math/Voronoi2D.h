@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Vector2.h"
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 矩形 [0,width]×[0,height] 内の 2D ボロノイ分割（各種点のセルを凸多角形で返す）。
+///
+/// BuildCells は種点を一様グリッドに振り分け、各種点について近いグリッドから順に
+/// 「他種点との垂直二等分線で半平面クリップ」する。セルの最遠頂点までの距離を R とすると、
+/// 距離 2R 以上の種点はセルを削れないので、その手前でリングの探索を打ち切る（セキュリティ半径）。
+/// 一様な種点なら 1 セルあたりの近傍は定数個＝全体でほぼ O(N)。セル同士は独立なので JobSystem::ParallelFor で分けて構築する。
+/// BuildCellsBruteForce は全種点と総当たりでクリップする旧実装（O(N^2)）で、比較用に残している。
+/// </summary>
+namespace Voronoi2D {
+
+	struct Cell {
+		std::vector<Vector2> polygon;    // 凸多角形の頂点（矩形と同じ回り順）
+		Vector2 centroid{ 0.0f, 0.0f };  // 面積重み付き重心（縮退時は頂点平均）
+		uint32_t site = 0;               // 元の種点 index
+	};
+
+	/// <summary>
+	/// 種点ごとのセルを out に詰める（種点の順。頂点が 3 未満に潰れたセルは含まない）。
+	/// 同じ種点列なら常に同じ結果になる（スレッド数に依存しない）。
+	/// </summary>
+	void BuildCells(const std::vector<Vector2>& sites, float width, float height, std::vector<Cell>& out);
+
+	/// <summary>全種点と総当たりで半平面クリップする参照実装（出力形式は BuildCells と同じ）。</summary>
+	void BuildCellsBruteForce(const std::vector<Vector2>& sites, float width, float height, std::vector<Cell>& out);
+
+	/// <summary>
+	/// 固定シードの種点で BuildCells と BuildCellsBruteForce を比べ、セル数・重心・面積・頂点の一致と
+	/// 1 回あたりの構築時間を LogBuffer に出す。
+	/// </summary>
+	void RunBenchmark();
+
+} // namespace Voronoi2D
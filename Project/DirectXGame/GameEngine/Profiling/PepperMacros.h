@@ -15,8 +15,15 @@
 #define PEPPER_CONCAT(a, b) PEPPER_CONCAT_INNER(a, b)
 
 // CPU 区間計測。関数先頭などに1行。ブロックを抜けた瞬間に区間時間が確定する。
+// 区間名は呼び出し箇所ごとに初回だけ ID へ変換して static に持つ（name は文字列リテラルにすること）。
+// どのスレッドからでも使える。
 #define PEPPER_SCOPE(name) \
-    ProfileScope PEPPER_CONCAT(pepperScope_, __LINE__)((name), __FILE__, __LINE__)
+    static const uint32_t PEPPER_CONCAT(pepperSite_, __LINE__) = \
+        Profiler::Instance().RegisterSite((name), __FILE__, __LINE__); \
+    ProfileScope PEPPER_CONCAT(pepperScope_, __LINE__)(PEPPER_CONCAT(pepperSite_, __LINE__))
+
+// 呼び出しスレッドの表示名（区間テーブルと trace.json のスレッド名）。スレッド関数の先頭で1回。
+#define PEPPER_THREAD_NAME(name) Profiler::Instance().SetThreadName((name))
 
 // GPU 区間計測。commandList に begin/end タイムスタンプを積む。EndDraw をまたがない位置に置くこと。
 #define PEPPER_GPU_SCOPE(commandList, name) \
@@ -35,9 +42,13 @@
 // 1フレーム分の集計をウィンドウへ畳み込み、1秒ごとに profile.log へ書き出す。フレームループ末尾で1回。
 #define PEPPER_END_FRAME() Profiler::Instance().EndFrame()
 
-// 未出力ウィンドウを強制書き出し。終了処理で1回。
+// 未出力ウィンドウを強制書き出し（トレース中なら trace.json も）。終了処理で1回。
 #define PEPPER_FLUSH() Profiler::Instance().Flush()
 
+// 全区間のタイムライン記録を開始 / 停止して trace.json（Chrome trace 形式）へ書き出す。
+#define PEPPER_START_TRACE() Profiler::Instance().StartTrace()
+#define PEPPER_STOP_TRACE() Profiler::Instance().StopTrace()
+
 // GPU 計測の初期化（device/queue）。DirectXCore::Initialize 末尾で1回。
 #define PEPPER_GPU_INIT(device, queue) GpuProfiler::Instance().Initialize((device), (queue))
 // タイムスタンプの解決。コマンドリストを Close する直前に。
@@ -48,6 +59,7 @@
 #else
 
 #define PEPPER_SCOPE(name) ((void)0)
+#define PEPPER_THREAD_NAME(name) ((void)0)
 #define PEPPER_GPU_SCOPE(commandList, name) ((void)0)
 #define PEPPER_COUNT(name) ((void)0)
 #define PEPPER_COUNT_N(name, n) ((void)0)
@@ -55,6 +67,8 @@
 #define PEPPER_SAMPLE_MEMORY() ((void)0)
 #define PEPPER_END_FRAME() ((void)0)
 #define PEPPER_FLUSH() ((void)0)
+#define PEPPER_START_TRACE() ((void)0)
+#define PEPPER_STOP_TRACE() ((void)0)
 #define PEPPER_GPU_INIT(device, queue) ((void)0)
 #define PEPPER_GPU_RESOLVE(commandList) ((void)0)
 #define PEPPER_GPU_READBACK() ((void)0)
@@ -1,9 +1,15 @@
 #include "Profiler.h"
 
 #include <Windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <thread>
 
+#include "LogBuffer.h"
 #include "SessionLogger.h"
 
 namespace {
@@ -26,6 +32,40 @@ namespace {
         QueryPerformanceCounter(&now);
         return now.QuadPart;
     }
+
+    // JSON 文字列として書けるようにエスケープする（区間名・スレッド名用）
+    std::string JsonEscape(const std::string& s) {
+        std::string out;
+        out.reserve(s.size());
+        for (const char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    // 呼び出しスレッドのリング（計測の高速経路はこれだけを見る）
+    thread_local Profiler::ThreadBuffer* tBuffer = nullptr;
+
+    // スレッド終了時にリングを「持ち主なし」にする（リング自体は Profiler が持ち続ける）
+    struct ThreadSlot {
+        Profiler::ThreadBuffer* buffer = nullptr;
+        ~ThreadSlot() {
+            if (buffer) {
+                buffer->depth = 0;
+                buffer->alive.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadSlot tSlot;
 }
 
 Profiler& Profiler::Instance() {
@@ -41,55 +81,158 @@ Profiler::Profiler() {
     windowStartTicks_ = NowTicks();
 }
 
-void Profiler::BeginSection(const char* name, const char* file, int line) {
-    size_t index;
-    auto it = indexByName_.find(name);
-    if (it == indexByName_.end()) {
-        index = stats_.size();
-        SectionStat s;
-        s.name = name;
-        s.file = file;
-        s.line = line;
-        s.depth = static_cast<int>(activeStack_.size());
-        stats_.push_back(std::move(s));
-        indexByName_.emplace(name, index);
-    } else {
-        index = it->second;
+uint32_t Profiler::RegisterSite(const char* name, const char* file, int line) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return RegisterSiteLocked(name, file, line);
+}
+
+uint32_t Profiler::RegisterSiteLocked(const char* name, const char* file, int line) {
+    auto it = siteByName_.find(name);
+    if (it != siteByName_.end()) {
+        Site& site = sites_[it->second];
+        if (!site.file && file) {
+            // GPU 区間として先に登録されていた名前に CPU 側の位置を付ける
+            site.file = file;
+            site.line = line;
+        }
+        return it->second;
+    }
+    const uint32_t id = static_cast<uint32_t>(sites_.size());
+    sites_.push_back({ name, file, line });
+    siteByName_.emplace(name, id);
+    return id;
+}
+
+Profiler::ThreadBuffer* Profiler::AcquireThreadBuffer() {
+    if (tBuffer) {
+        return tBuffer;
     }
+    ThreadBuffer* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        // 終了したスレッドのリングで、回収し終わったものがあれば使い回す
+        for (auto& candidate : threads_) {
+            if (!candidate->alive.load(std::memory_order_acquire) &&
+                candidate->head.load(std::memory_order_acquire) ==
+                candidate->tail.load(std::memory_order_relaxed)) {
+                buffer = candidate.get();
+                buffer->depth = 0;
+                buffer->name.clear();
+                buffer->collect.store(true, std::memory_order_relaxed);
+                buffer->alive.store(true, std::memory_order_release);
+                break;
+            }
+        }
+        if (!buffer) {
+            auto created = std::make_unique<ThreadBuffer>();
+            created->events = std::make_unique<Event[]>(ThreadBuffer::kCapacity);
+            created->index = static_cast<uint32_t>(threads_.size());
+            buffer = created.get();
+            threads_.push_back(std::move(created));
+        }
+    }
+    tBuffer = buffer;
+    tSlot.buffer = buffer;
+    return buffer;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = AcquireThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer->name = name;
+}
 
-    activeStack_.push_back({ NowTicks(), index });
+void Profiler::BeginSection(uint32_t site) {
+    ThreadBuffer* buffer = tBuffer ? tBuffer : AcquireThreadBuffer();
+    const uint32_t depth = buffer->depth++;
+    if (depth < ThreadBuffer::kMaxDepth) {
+        buffer->stackSite[depth] = site;
+        buffer->stackStart[depth] = NowTicks();
+    }
 }
 
 void Profiler::EndSection() {
-    if (activeStack_.empty()) {
+    ThreadBuffer* buffer = tBuffer;
+    if (!buffer || buffer->depth == 0) {
         return;
     }
     const int64_t now = NowTicks();
+    const uint32_t depth = --buffer->depth;
+    if (depth >= ThreadBuffer::kMaxDepth) {
+        return;  // スタックより深い区間は記録しない
+    }
 
-    const ActiveScope scope = activeStack_.back();
-    activeStack_.pop_back();
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    const uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= ThreadBuffer::kCapacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event& e = buffer->events[head & (ThreadBuffer::kCapacity - 1)];
+    e.startTicks = buffer->stackStart[depth];
+    e.endTicks = now;
+    e.site = buffer->stackSite[depth];
+    e.depth = depth;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
 
-    SectionStat& s = stats_[scope.index];
-    s.cpuMs += static_cast<double>(now - scope.startTicks) * tickToMs_;
-    s.calls += 1;
+Profiler::SectionStat& Profiler::FrameStat(uint32_t thread, uint32_t site, int depth, int64_t startTicks) {
+    if (statIndex_.size() <= thread) {
+        statIndex_.resize(thread + 1);
+    }
+    std::vector<int32_t>& row = statIndex_[thread];
+    if (row.size() <= site) {
+        row.resize((std::max)(sites_.size(), static_cast<size_t>(site) + 1), -1);
+    }
+    int32_t& index = row[site];
+    if (index < 0) {
+        index = static_cast<int32_t>(stats_.size());
+        SectionStat s;
+        s.thread = thread;
+        s.site = site;
+        s.depth = depth;
+        s.firstStartTicks = startTicks;
+        stats_.push_back(s);
+    }
+    return stats_[index];
 }
 
-void Profiler::AddGpuMs(const char* name, double gpuMs) {
-    auto it = indexByName_.find(name);
-    if (it != indexByName_.end()) {
-        stats_[it->second].gpuMs += gpuMs;
-        return;
+void Profiler::DrainBuffer(ThreadBuffer& buffer) {
+    droppedEvents_ += buffer.dropped.exchange(0, std::memory_order_relaxed);
+
+    uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+        const Event& e = buffer.events[tail & (ThreadBuffer::kCapacity - 1)];
+        SectionStat& s = FrameStat(buffer.index, e.site, static_cast<int>(e.depth), e.startTicks);
+        if (s.calls == 0) {
+            s.depth = static_cast<int>(e.depth);  // GPU 専用として先に作られた行は CPU 側の深さに揃える
+        }
+        s.firstStartTicks = (std::min)(s.firstStartTicks, e.startTicks);
+        s.cpuMs += static_cast<double>(e.endTicks - e.startTicks) * tickToMs_;
+        s.calls += 1;
+
+        if (tracing_ && e.startTicks >= traceStartTicks_ && traceEvents_.size() < kMaxTraceEvents) {
+            traceEvents_.push_back({ e, buffer.index });
+        }
     }
-    // CPU 区間に同名が無い GPU 専用区間（depth=0、cpu/calls は 0 のまま）
-    const size_t index = stats_.size();
-    SectionStat s;
-    s.name = name;
-    s.file = nullptr;
-    s.line = 0;
-    s.depth = 0;
-    s.gpuMs = gpuMs;
-    stats_.push_back(std::move(s));
-    indexByName_.emplace(name, index);
+    buffer.tail.store(head, std::memory_order_release);
+}
+
+std::string Profiler::ThreadNameLocked(uint32_t thread) const {
+    if (thread < threads_.size() && !threads_[thread]->name.empty()) {
+        return threads_[thread]->name;
+    }
+    return "Thread#" + std::to_string(thread);
+}
+
+void Profiler::AddGpuMs(const char* name, double gpuMs) {
+    ThreadBuffer* self = AcquireThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    // CPU 区間に同名があればその行へ、無ければ GPU 専用区間（cpu/calls は 0 のまま）
+    const uint32_t site = RegisterSiteLocked(name, nullptr, 0);
+    const uint32_t thread = (mainThread_ != UINT32_MAX) ? mainThread_ : self->index;
+    FrameStat(thread, site, 0, INT64_MAX).gpuMs += gpuMs;
 }
 
 void Profiler::Count(const char* name, int64_t n) {
@@ -125,19 +268,52 @@ void Profiler::EndFrame() {
     }
     lastEndFrameTicks_ = nowFrameTicks;
 
+    ThreadBuffer* self = AcquireThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    if (mainThread_ == UINT32_MAX) {
+        mainThread_ = self->index;
+        if (self->name.empty()) {
+            self->name = "Main";
+        }
+    }
+
+    // 全スレッドのリングを回収してフレーム集計を作る
+    for (auto& buffer : threads_) {
+        if (buffer->collect.load(std::memory_order_acquire)) {
+            DrainBuffer(*buffer);
+        }
+    }
+    if (tracing_ && traceFrameTicks_.size() < kMaxTraceEvents) {
+        traceFrameTicks_.push_back(nowFrameTicks);
+    }
+
+    // 表示順: メインスレッド → 他スレッド（番号順）、スレッド内は開始時刻順（＝親→子）
+    auto threadRank = [this](uint32_t thread) {
+        return (thread == mainThread_) ? 0u : thread + 1u;
+    };
+    std::sort(stats_.begin(), stats_.end(), [&](const SectionStat& a, const SectionStat& b) {
+        if (a.thread != b.thread) {
+            return threadRank(a.thread) < threadRank(b.thread);
+        }
+        if (a.firstStartTicks != b.firstStartTicks) {
+            return a.firstStartTicks < b.firstStartTicks;
+        }
+        return a.depth < b.depth;
+    });
+
     // このフレームの各区間をウィンドウ集計へ畳み込む
     for (const auto& s : stats_) {
+        const uint64_t key = (static_cast<uint64_t>(s.thread) << 32) | s.site;
         size_t index;
-        auto it = windowIndexByName_.find(s.name);
-        if (it == windowIndexByName_.end()) {
+        auto it = windowIndexByKey_.find(key);
+        if (it == windowIndexByKey_.end()) {
             index = windowStats_.size();
             WindowStat w;
-            w.name = s.name;
-            w.file = s.file;
-            w.line = s.line;
+            w.thread = s.thread;
+            w.site = s.site;
             w.depth = s.depth;
-            windowStats_.push_back(std::move(w));
-            windowIndexByName_.emplace(s.name, index);
+            windowStats_.push_back(w);
+            windowIndexByKey_.emplace(key, index);
         } else {
             index = it->second;
         }
@@ -193,8 +369,10 @@ void Profiler::EndFrame() {
     ++windowFrames_;
 
     ++frame_;
+    for (const auto& s : stats_) {
+        statIndex_[s.thread][s.site] = -1;
+    }
     stats_.clear();
-    indexByName_.clear();
     counters_.clear();
     counterIndexByName_.clear();
     gauges_.clear();
@@ -208,7 +386,13 @@ void Profiler::EndFrame() {
 }
 
 void Profiler::Flush() {
-    FlushWindow();
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        FlushWindow();
+    }
+    if (tracing_) {
+        StopTrace();
+    }
 }
 
 void Profiler::FlushWindow() {
@@ -219,7 +403,16 @@ void Profiler::FlushWindow() {
     const double windowSec =
         static_cast<double>(NowTicks() - windowStartTicks_) * tickToMs_ / 1000.0;
 
+    // 後から出てきたスレッドの行も、スレッドごとにまとまるよう並べ直す（スレッド内は出現順のまま）
+    std::stable_sort(windowStats_.begin(), windowStats_.end(),
+        [this](const WindowStat& a, const WindowStat& b) {
+            const uint32_t ra = (a.thread == mainThread_) ? 0u : a.thread + 1u;
+            const uint32_t rb = (b.thread == mainThread_) ? 0u : b.thread + 1u;
+            return ra < rb;
+        });
+
     for (const auto& w : windowStats_) {
+        const Site& site = sites_[w.site];
         const double avgMs =
             (w.presentFrames > 0) ? (w.sumCpuMs / w.presentFrames) : 0.0;
         const double gpuAvgMs =
@@ -230,7 +423,8 @@ void Profiler::FlushWindow() {
             << "frame=" << frame_
             << " window_s=" << std::setprecision(2) << windowSec
             << " frames=" << windowFrames_
-            << " section=" << w.name
+            << " section=" << site.name
+            << " thread=" << ThreadNameLocked(w.thread)
             << " depth=" << w.depth
             << " present=" << w.presentFrames
             << " calls=" << w.totalCalls
@@ -240,8 +434,8 @@ void Profiler::FlushWindow() {
             << " gpu_sum_ms=" << w.sumGpuMs
             << " gpu_avg_ms=" << gpuAvgMs
             << " gpu_max_ms=" << w.maxGpuMs
-            << " file=" << BaseName(w.file)
-            << " line=" << w.line;
+            << " file=" << BaseName(site.file)
+            << " line=" << site.line;
         SessionLogger::Instance().Write(
             SessionLogger::Category::Profile, SessionLogger::Level::Trace, oss.str());
     }
@@ -279,6 +473,13 @@ void Profiler::FlushWindow() {
             SessionLogger::Category::Profile, SessionLogger::Level::Trace, oss.str());
     }
 
+    // リングが埋まって捨てた区間があれば、ウィンドウごとに1行残す
+    if (droppedEvents_ > 0) {
+        SessionLogger::Instance().Writef(SessionLogger::Category::Profile, SessionLogger::Level::Trace,
+            "frame=%llu dropped_events=%llu",
+            static_cast<unsigned long long>(frame_), static_cast<unsigned long long>(droppedEvents_));
+    }
+
     // ---- ライブ表示用スナップショットを作る（クリア前に確定値をコピー）----
     liveWindowSec_ = windowSec;
     liveWindowFrames_ = windowFrames_;
@@ -286,10 +487,12 @@ void Profiler::FlushWindow() {
     liveSections_.clear();
     liveSections_.reserve(windowStats_.size());
     for (const auto& w : windowStats_) {
+        const Site& site = sites_[w.site];
         LiveSection ls;
-        ls.name = w.name;
-        ls.file = w.file;
-        ls.line = w.line;
+        ls.name = site.name;
+        ls.thread = ThreadNameLocked(w.thread);
+        ls.file = site.file;
+        ls.line = site.line;
         ls.depth = w.depth;
         ls.presentFrames = w.presentFrames;
         ls.totalCalls = w.totalCalls;
@@ -324,7 +527,7 @@ void Profiler::FlushWindow() {
     }
 
     windowStats_.clear();
-    windowIndexByName_.clear();
+    windowIndexByKey_.clear();
     windowCounters_.clear();
     windowCounterIndexByName_.clear();
     windowGauges_.clear();
@@ -332,3 +535,197 @@ void Profiler::FlushWindow() {
     windowFrames_ = 0;
     windowStartTicks_ = NowTicks();
 }
+
+void Profiler::StartTrace() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    if (tracing_) {
+        return;
+    }
+    tracing_ = true;
+    traceStartTicks_ = NowTicks();
+    traceEvents_.clear();
+    traceEvents_.reserve(1 << 16);
+    traceFrameTicks_.clear();
+    SessionLogger::Instance().Write(SessionLogger::Category::Session, SessionLogger::Level::Info,
+        "PEPPER trace started");
+}
+
+std::string Profiler::StopTrace() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    if (!tracing_) {
+        return std::string();
+    }
+    // まだリングに残っている分も取り込む（フレーム集計には次の EndFrame で入る）
+    for (auto& buffer : threads_) {
+        if (buffer->collect.load(std::memory_order_acquire)) {
+            DrainBuffer(*buffer);
+        }
+    }
+    tracing_ = false;
+
+    const std::string& sessionDir = SessionLogger::Instance().GetSessionDir();
+    const std::string path = (sessionDir.empty() ? std::string(".") : sessionDir) + "/trace.json";
+    std::ofstream out(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out) {
+        SessionLogger::Instance().Write(SessionLogger::Category::Error, SessionLogger::Level::Error,
+            "PEPPER trace: failed to open " + path);
+        traceEvents_ = std::vector<TraceEvent>();
+        traceFrameTicks_ = std::vector<int64_t>();
+        return std::string();
+    }
+
+    // Chrome trace-event 形式（ts/dur はマイクロ秒）。区間は "X"（完了イベント）、フレーム境界は "i"
+    const double tickToUs = tickToMs_ * 1000.0;
+    std::vector<std::string> names(sites_.size());
+    for (size_t i = 0; i < sites_.size(); ++i) {
+        names[i] = JsonEscape(sites_[i].name);
+    }
+    const uint32_t mainTid = (mainThread_ != UINT32_MAX) ? mainThread_ : 0;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << mainTid
+        << ",\"args\":{\"name\":\"DirectXGame\"}}";
+    for (const auto& buffer : threads_) {
+        const uint32_t rank = (buffer->index == mainThread_) ? 0u : buffer->index + 1u;
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->index
+            << ",\"args\":{\"name\":\"" << JsonEscape(ThreadNameLocked(buffer->index)) << "\"}}"
+            << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->index
+            << ",\"args\":{\"sort_index\":" << rank << "}}";
+    }
+
+    char line[512];
+    for (const auto& te : traceEvents_) {
+        const Site& site = sites_[te.event.site];
+        const double ts = static_cast<double>(te.event.startTicks - traceStartTicks_) * tickToUs;
+        const double dur = static_cast<double>(te.event.endTicks - te.event.startTicks) * tickToUs;
+        std::snprintf(line, sizeof(line),
+            ",\n{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"file\":\"%s\",\"line\":%d}}",
+            names[te.event.site].c_str(), ts, dur, te.thread, BaseName(site.file), site.line);
+        out << line;
+    }
+    for (size_t i = 0; i < traceFrameTicks_.size(); ++i) {
+        const double ts = static_cast<double>(traceFrameTicks_[i] - traceStartTicks_) * tickToUs;
+        std::snprintf(line, sizeof(line),
+            ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"index\":%zu}}",
+            ts, mainTid, i);
+        out << line;
+    }
+    out << "\n]}\n";
+    out.close();
+
+    SessionLogger::Instance().Writef(SessionLogger::Category::Session, SessionLogger::Level::Info,
+        "PEPPER trace written: %s events=%zu frames=%zu%s", path.c_str(), traceEvents_.size(),
+        traceFrameTicks_.size(), (traceEvents_.size() >= kMaxTraceEvents) ? " (truncated)" : "");
+
+    traceEvents_ = std::vector<TraceEvent>();
+    traceFrameTicks_ = std::vector<int64_t>();
+    return path;
+}
+
+void Profiler::RunOverheadBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const int kScopesPerBatch = 4096;   // リング容量の半分（バッチごとに回収するので捨てが出ない）
+    const int kBatches = 256;
+    const double scopeCount = static_cast<double>(kScopesPerBatch) * kBatches;
+
+    double baselineNs = 0.0;
+    double legacyNs = 0.0;
+    double ringNs = 0.0;
+    uint64_t ringEvents = 0;
+
+    // フレーム集計に混ざらないよう、回収対象外にしたリングを持つ専用スレッドで測る
+    std::thread worker([&]() {
+        Profiler& profiler = Instance();
+        ThreadBuffer* buffer = profiler.AcquireThreadBuffer();
+        buffer->collect.store(false, std::memory_order_release);
+        profiler.SetThreadName("PepperBench");
+        const uint32_t site = profiler.RegisterSite("PepperOverheadBench", __FILE__, __LINE__);
+
+        auto timeBatches = [&](const auto& batch, const auto& between) {
+            double seconds = 0.0;
+            for (int b = 0; b < kBatches; ++b) {
+                const auto t0 = Clock::now();
+                batch();
+                seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+                between();
+            }
+            return seconds * 1e9 / scopeCount;
+        };
+
+        // 区間なしのループ（ループ自体のコスト）
+        volatile int sink = 0;
+        baselineNs = timeBatches([&]() {
+            for (int i = 0; i < kScopesPerBatch; ++i) {
+                sink = i;
+            }
+        }, []() {});
+
+        // 旧方式: 呼び出しごとに区間名から std::string を作ってハッシュ表を引き、スタックに積む
+        {
+            struct LegacyStat {
+                std::string name;
+                int calls = 0;
+                double cpuMs = 0.0;
+            };
+            std::vector<LegacyStat> stats;
+            std::unordered_map<std::string, size_t> indexByName;
+            std::vector<std::pair<int64_t, size_t>> activeStack;
+            const char* name = "PepperOverheadBench";
+            const double tickToMs = profiler.tickToMs_;
+            legacyNs = timeBatches([&]() {
+                for (int i = 0; i < kScopesPerBatch; ++i) {
+                    size_t index;
+                    auto it = indexByName.find(name);
+                    if (it == indexByName.end()) {
+                        index = stats.size();
+                        stats.push_back({ name });
+                        indexByName.emplace(name, index);
+                    } else {
+                        index = it->second;
+                    }
+                    activeStack.push_back({ NowTicks(), index });
+                    sink = i;
+                    const int64_t now = NowTicks();
+                    const auto scope = activeStack.back();
+                    activeStack.pop_back();
+                    stats[scope.second].cpuMs += static_cast<double>(now - scope.first) * tickToMs;
+                    stats[scope.second].calls += 1;
+                }
+            }, [&]() {
+                // 旧方式はフレームごとに表を作り直していた
+                stats.clear();
+                indexByName.clear();
+            });
+        }
+
+        // 新方式: 区間 ID を積むだけ（このスレッドのリングを自分で空にしながら回す）
+        ringNs = timeBatches([&]() {
+            for (int i = 0; i < kScopesPerBatch; ++i) {
+                ProfileScope scope(site);
+                sink = i;
+            }
+        }, [&]() {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            ringEvents += head - buffer->tail.load(std::memory_order_relaxed);
+            buffer->tail.store(head, std::memory_order_release);
+        });
+    });
+    worker.join();
+
+    char buf[256];
+    LogBuffer::Instance().Add("[Profiler] Scope overhead benchmark (string-hash per call vs interned id + thread-local ring)");
+    std::snprintf(buf, sizeof(buf), "  scopes=%.0f  empty loop=%.2f ns", scopeCount, baselineNs);
+    LogBuffer::Instance().Add(buf);
+    std::snprintf(buf, sizeof(buf), "  old (std::string hash + stack) : %.2f ns/scope (net %.2f ns)",
+        legacyNs, legacyNs - baselineNs);
+    LogBuffer::Instance().Add(buf);
+    std::snprintf(buf, sizeof(buf), "  new (interned id + TLS ring)   : %.2f ns/scope (net %.2f ns)  x%.2f",
+        ringNs, ringNs - baselineNs,
+        (ringNs - baselineNs > 0.0) ? (legacyNs - baselineNs) / (ringNs - baselineNs) : 0.0);
+    LogBuffer::Instance().Add(buf);
+    std::snprintf(buf, sizeof(buf), "  events recorded=%llu (%s)",
+        static_cast<unsigned long long>(ringEvents),
+        (ringEvents == static_cast<uint64_t>(scopeCount)) ? "match" : "MISMATCH");
+    LogBuffer::Instance().Add(buf);
+}
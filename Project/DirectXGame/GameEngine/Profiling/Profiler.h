@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <cstdint>
 
@@ -11,32 +14,54 @@
 /// 1秒ウィンドウで集計（avg/max/sum/calls）して SessionLogger の
 /// Profile カテゴリ（profile.log）へ書き出す。毎フレーム書くとログが爆発するため、
 /// 区間ごとに集計してウィンドウ終端でまとめて1行ずつ出力する。
-/// メインスレッド前提（区間スタックの順序保証のため）。
+///
+/// 区間はどのスレッドからでも計測できる。区間名は呼び出し箇所ごとに一度だけ ID に変換し
+/// （PEPPER_SCOPE が関数内 static に保持）、計測中は文字列を扱わない。
+/// 各スレッドは自分専用のイベントリング（単一生産者・単一消費者、ロックなし）に
+/// 「区間 ID・開始/終了 tick・深さ」を積むだけで、集計は EndFrame（メインスレッド）がまとめて行う。
+/// 集計はスレッド×区間ごと。StartTrace 中は全イベントを保持し、StopTrace で
+/// Chrome trace 形式の trace.json（chrome://tracing / Perfetto UI で開ける）に書き出す。
+/// カウンタ・ゲージ・GPU 区間はメインスレッド専用。
 /// </summary>
 class Profiler {
 public:
     static Profiler& Instance();
 
     /// <summary>
-    /// 区間の計測開始。__FILE__/__LINE__ を一緒に記録し、後で該当箇所へ飛べるようにする。
-    /// 同名区間は1フレーム内で合算（呼び出し回数も集計）。
+    /// 区間名を ID に変換する（同名なら同じ ID。初出時の __FILE__/__LINE__ を記録する）。
+    /// PEPPER_SCOPE が呼び出し箇所ごとに一度だけ呼ぶ。どのスレッドからでもよい（内部でロック）。
+    /// name は静的な文字列であること（ポインタではなく中身をコピーして保持はする）。
     /// </summary>
-    void BeginSection(const char* name, const char* file, int line);
+    uint32_t RegisterSite(const char* name, const char* file, int line);
 
     /// <summary>
-    /// 直近に開始した区間を閉じ、経過時間を加算する（RAII で対応）。
+    /// 区間の計測開始。どのスレッドからでもよい（呼び出しスレッドのリングに積む。ロックなし）。
+    /// 同じ区間が1フレーム内に何度あっても合算（呼び出し回数も集計）。
+    /// </summary>
+    void BeginSection(uint32_t site);
+
+    /// <summary>
+    /// 呼び出しスレッドで直近に開始した区間を閉じ、イベントとして積む（RAII で対応）。
+    /// リングが埋まっていればそのイベントは捨てて数える。
     /// </summary>
     void EndSection();
 
     /// <summary>
-    /// 1フレームの集計をウィンドウへ畳み込む。1秒経過していればウィンドウを
-    /// profile.log へ書き出してリセットする。フレームループの末尾で1回だけ呼ぶ。
+    /// 呼び出しスレッドの表示名を付ける（テーブル・trace.json のスレッド名になる）。
+    /// 名前を付けていないワーカーは "Thread N" になる。
+    /// </summary>
+    void SetThreadName(const std::string& name);
+
+    /// <summary>
+    /// 全スレッドのリングから今までのイベントを回収してフレーム集計し、ウィンドウへ畳み込む。
+    /// 1秒経過していればウィンドウを profile.log へ書き出してリセットする。
+    /// フレームループの末尾で1回だけ呼ぶ（呼んだスレッドをメインスレッドとみなす）。
     /// </summary>
     void EndFrame();
 
     /// <summary>
     /// GPU 計測結果（区間名・ms）を現フレームの集計へ加算する。
-    /// GpuProfiler がフレーム末リードバック時に呼ぶ。CPU と同名なら同じ行にまとまる。
+    /// GpuProfiler がフレーム末リードバック時に呼ぶ。CPU と同名ならメインスレッドの同じ行にまとまる。
     /// </summary>
     void AddGpuMs(const char* name, double gpuMs);
 
@@ -53,19 +78,49 @@ public:
     void SetGauge(const char* name, double value);
 
     /// <summary>
-    /// 未出力のウィンドウを強制的に書き出す。終了処理（Framework::Finalize）で呼ぶ。
+    /// 未出力のウィンドウを強制的に書き出す。トレース中なら trace.json も書き出す。
+    /// 終了処理（Framework::Finalize）で呼ぶ。
     /// </summary>
     void Flush();
 
+    // ============================================================
+    // トレース（全イベントをタイムラインとして残す）
+    // ============================================================
+
+    /// <summary>
+    /// 全イベントの記録を始める（既に記録中なら何もしない）。メインスレッドから呼ぶ。
+    /// 記録は kMaxTraceEvents 件で打ち切る（それ以降は集計だけ続く）。
+    /// </summary>
+    void StartTrace();
+
+    /// <summary>
+    /// 記録を止め、セッションフォルダの trace.json（Chrome trace-event 形式）へ書き出す。
+    /// 書き出したパスを返す（記録していなければ空文字）。
+    /// </summary>
+    std::string StopTrace();
+
+    bool IsTracing() const { return tracing_; }
+    size_t GetTraceEventCount() const { return traceEvents_.size(); }
+
+    /// <summary>リングが埋まって捨てたイベント数の累計（全スレッド合計）。</summary>
+    uint64_t GetDroppedEventCount() const { return droppedEvents_; }
+
+    /// <summary>
+    /// 区間 1 回あたりの計測コストを、区間なしのループ・旧方式（区間名の std::string ハッシュ）と比べて
+    /// LogBuffer に出す。専用スレッドで回し、その結果はフレーム集計に混ぜない。
+    /// </summary>
+    static void RunOverheadBenchmark();
+
     // ============================================================
     // ライブ表示用 API（PEPPER ImGui ウィンドウが毎フレーム読む）。
     // 直近に確定した1秒ウィンドウの集計スナップショットを保持する（毎秒更新＝数値は安定）。
     // 将来 EMA(毎フレーム平滑化) へ移行する場合も、ウィンドウUI・グラフ・カウンタ/ゲージは
     // そのまま流用でき、区間テーブルのデータソースだけ差し替えればよい設計。
-    // 計測層はメインスレッド専用、ImGui もメインスレッド描画なのでロック不要。
+    // スナップショットは EndFrame（メインスレッド）が作り、ImGui もメインスレッド描画なのでロック不要。
     // ============================================================
     struct LiveSection {
         std::string name;
+        std::string thread;      // 計測したスレッドの表示名
         const char* file = nullptr;
         int line = 0;
         int depth = 0;
@@ -103,28 +158,67 @@ public:
     int    GetFrameMsRingHead()   const { return frameRingHead_; } // 次に書く位置(=最古)
     double GetLastFrameMs()       const { return lastFrameMs_; }
 
+    static constexpr size_t kMaxTraceEvents = 2000000;  // 約 48MB
+
 private:
     Profiler();
     ~Profiler() = default;
     Profiler(const Profiler&) = delete;
     Profiler& operator=(const Profiler&) = delete;
 
-    // 区間ごとの「1フレーム」集計
-    struct SectionStat {
+    // 区間名の登録情報（ID = sites_ の添字）
+    struct Site {
         std::string name;
         const char* file = nullptr;  // __FILE__（静的文字列なのでポインタ保持で十分）
         int line = 0;
+    };
+
+    // 1 区間の計測結果（スレッドのリングに積む単位）
+    struct Event {
+        int64_t startTicks = 0;
+        int64_t endTicks = 0;
+        uint32_t site = 0;
+        uint32_t depth = 0;
+    };
+
+public:
+    // スレッドごとのイベントリング（所有スレッドが積み、EndFrame が回収する）。
+    // スレッド終了後も破棄せず、空になったら次に来たスレッドへ使い回す
+    struct ThreadBuffer {
+        static constexpr uint32_t kCapacity = 8192;  // 2 の累乗
+        static constexpr uint32_t kMaxDepth = 64;
+
+        std::unique_ptr<Event[]> events;
+        alignas(64) std::atomic<uint64_t> head{ 0 };  // 所有スレッドだけが進める
+        alignas(64) std::atomic<uint64_t> tail{ 0 };  // 回収側だけが進める
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<bool> alive{ true };              // 所有スレッドが生きているか
+        std::atomic<bool> collect{ true };            // false の間は EndFrame が回収しない（ベンチマーク用）
+        uint32_t index = 0;                           // スレッド番号（trace.json の tid）
+        std::string name;                             // registryMutex_ で保護
+
+        // 所有スレッド専用：開いている区間のスタック
+        uint32_t depth = 0;
+        uint32_t stackSite[kMaxDepth] = {};
+        int64_t stackStart[kMaxDepth] = {};
+    };
+
+private:
+    // 区間ごとの「1フレーム」集計（スレッド×区間）
+    struct SectionStat {
+        uint32_t thread = 0;
+        uint32_t site = 0;
         int depth = 0;               // 区間スタックの深さ（初出時に確定）
         int calls = 0;
+        int64_t firstStartTicks = 0; // 表示順（親→子）を決めるための最初の開始時刻
         double cpuMs = 0.0;
         double gpuMs = 0.0;          // GPU タイムスタンプ計測（同名区間に加算）
     };
 
     // 区間ごとの「1秒ウィンドウ」集計
     struct WindowStat {
-        std::string name;
-        const char* file = nullptr;
-        int line = 0;
+        uint32_t thread = 0;
+        uint32_t site = 0;
         int depth = 0;
         int presentFrames = 0;   // この区間が出現したフレーム数（avg の分母）
         int64_t totalCalls = 0;  // ウィンドウ内の総呼び出し回数
@@ -134,10 +228,10 @@ private:
         double maxGpuMs = 0.0;   // 1フレームあたり gpu_ms の最大
     };
 
-    // 計測中の区間（開始時刻と集計先インデックス）
-    struct ActiveScope {
-        int64_t startTicks = 0;
-        size_t index = 0;
+    // トレース用に保持するイベント（どのスレッドのものか付きで）
+    struct TraceEvent {
+        Event event;
+        uint32_t thread = 0;
     };
 
     // 名前付きカウンタの「1フレーム」値
@@ -168,6 +262,15 @@ private:
         int count = 0;
     };
 
+    // 呼び出しスレッドのリングを返す（無ければ登録する）
+    ThreadBuffer* AcquireThreadBuffer();
+    // registryMutex_ を持った状態で区間名を登録する
+    uint32_t RegisterSiteLocked(const char* name, const char* file, int line);
+    // 1 リング分のイベントを回収してフレーム集計へ（registryMutex_ を持った状態で呼ぶ）
+    void DrainBuffer(ThreadBuffer& buffer);
+    // フレーム集計の (thread, site) 行を返す（無ければ作る）
+    SectionStat& FrameStat(uint32_t thread, uint32_t site, int depth, int64_t startTicks);
+    std::string ThreadNameLocked(uint32_t thread) const;
     void FlushWindow();  // 現ウィンドウを書き出してリセット
 
     static constexpr double kWindowMs = 1000.0;  // 集計ウィンドウ長（1秒）
@@ -175,17 +278,30 @@ private:
     double tickToMs_ = 0.0;          // QPC tick → ms 変換係数（起動時に1回取得）
     uint64_t frame_ = 0;
 
-    // フレーム内集計
+    // 区間名とスレッドの登録簿（登録時と EndFrame の回収時だけロックする）
+    mutable std::mutex registryMutex_;
+    std::vector<Site> sites_;
+    std::unordered_map<std::string, uint32_t> siteByName_;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+    uint32_t mainThread_ = UINT32_MAX;   // EndFrame を呼ぶスレッドの番号
+    uint64_t droppedEvents_ = 0;
+
+    // フレーム内集計（statIndex_[thread][site] = stats_ の添字、-1 は未出現）
     std::vector<SectionStat> stats_;
-    std::unordered_map<std::string, size_t> indexByName_;
-    std::vector<ActiveScope> activeStack_;
+    std::vector<std::vector<int32_t>> statIndex_;
 
-    // ウィンドウ集計
+    // ウィンドウ集計（キーは (thread << 32) | site）
     std::vector<WindowStat> windowStats_;
-    std::unordered_map<std::string, size_t> windowIndexByName_;
+    std::unordered_map<uint64_t, size_t> windowIndexByKey_;
     int windowFrames_ = 0;
     int64_t windowStartTicks_ = 0;
 
+    // トレース
+    bool tracing_ = false;
+    int64_t traceStartTicks_ = 0;
+    std::vector<TraceEvent> traceEvents_;
+    std::vector<int64_t> traceFrameTicks_;   // フレーム境界（EndFrame の時刻）
+
     // カウンタ（フレーム内 / ウィンドウ）
     std::vector<FrameCounter> counters_;
     std::unordered_map<std::string, size_t> counterIndexByName_;
@@ -218,8 +334,8 @@ private:
 /// </summary>
 class ProfileScope {
 public:
-    ProfileScope(const char* name, const char* file, int line) {
-        Profiler::Instance().BeginSection(name, file, line);
+    explicit ProfileScope(uint32_t site) {
+        Profiler::Instance().BeginSection(site);
     }
     ~ProfileScope() {
         Profiler::Instance().EndSection();
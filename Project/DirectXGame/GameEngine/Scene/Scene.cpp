@@ -20,6 +20,7 @@
 #include "TextureManager.h"
 #include "ModelManager.h"
 #include "PepperMacros.h"
+#include "JobSystem.h"
 #include <algorithm>
 #include <cmath>
 
@@ -497,9 +498,14 @@ void Scene::DrawShadowCasters() {
 
 void Scene::UpdateDynamicAnimated(float deltaTime) {
 	PEPPER_SCOPE("Scene::UpdateDynamicAnimated");
-	for (auto& a : dynamicAnimated_) {
-		a->Update(deltaTime);
-	}
+	// 姿勢計算（サンプリング → UpdateSkeleton → パレット生成）は各インスタンスが自分のバッファにだけ書くので、
+	// インスタンス単位でワーカーに振る。ParallelFor は全件終わるまで戻らない＝スキニング Dispatch 前に join 済み
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(dynamicAnimated_.size()), 1,
+		[this, deltaTime](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				dynamicAnimated_[i]->Update(deltaTime);
+			}
+		});
 }
 
 void Scene::DispatchDynamicAnimatedSkinning() {
@@ -0,0 +1,278 @@
+#include "CookedDefs.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "AssetLocator.h"
+
+namespace CookedDefs {
+
+    namespace {
+        constexpr std::string_view kJsonRoot = "Resources/Json/";
+        constexpr std::string_view kCookedRoot = "Resources/Cooked/";
+        constexpr size_t kDataAlign = 8;
+
+        size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        void AppendBytes(std::vector<uint8_t>& out, const void* p, size_t bytes) {
+            const uint8_t* src = static_cast<const uint8_t*>(p);
+            out.insert(out.end(), src, src + bytes);
+        }
+
+        // [offset, offset + bytes) がファイル内に収まるか
+        bool InRange(size_t fileSize, uint64_t offset, uint64_t bytes) {
+            return offset <= fileSize && bytes <= fileSize - offset;
+        }
+    }
+
+    //==================================================
+    // パス・元ファイル
+    //==================================================
+
+    std::string CookedPathFor(const std::string& jsonPath) {
+        std::string path = std::filesystem::path(jsonPath).generic_string();
+        if (path.compare(0, kJsonRoot.size(), kJsonRoot) != 0) return {};
+        while (!path.empty() && path.back() == '/') {
+            path.pop_back();
+        }
+        std::string cooked = std::string(kCookedRoot) + path.substr(kJsonRoot.size());
+        const std::string_view ext = ".json";
+        if (cooked.size() > ext.size() && cooked.compare(cooked.size() - ext.size(), ext.size(), ext) == 0) {
+            cooked.resize(cooked.size() - ext.size());
+        }
+        return cooked + ".defs";
+    }
+
+    bool StatSource(const std::string& path, SourceInfo& out) {
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec) return false;
+        const auto time = std::filesystem::last_write_time(path, ec);
+        if (ec) return false;
+        out.path = std::filesystem::path(path).generic_string();
+        out.size = size;
+        out.writeTime = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    std::vector<SourceInfo> ScanSources(const std::string& dir) {
+        std::vector<SourceInfo> sources;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            if (ec) break;
+            if (!entry.is_regular_file()) continue;
+            if (entry.path().extension() != ".json") continue;
+            SourceInfo info;
+            if (StatSource(entry.path().generic_string(), info)) {
+                sources.push_back(std::move(info));
+            }
+        }
+        std::sort(sources.begin(), sources.end(),
+            [](const SourceInfo& a, const SourceInfo& b) { return a.path < b.path; });
+        return sources;
+    }
+
+    std::vector<uint8_t> LoadBytes(const std::string& cookedPath) {
+        AssetLocator* locator = AssetLocator::GetInstance();
+        if (locator->IsPackMode() || locator->Exists(cookedPath)) {
+            return locator->LoadAll(cookedPath);
+        }
+        return {};
+    }
+
+    bool IsPackMode() {
+        return AssetLocator::GetInstance()->IsPackMode();
+    }
+
+    //==================================================
+    // RecordWriter / RecordReader
+    //==================================================
+
+    void RecordWriter::Field(const std::string& value) {
+        const Ref ref = bundle_.AddString(value);
+        Append(&ref, sizeof(ref));
+    }
+
+    void RecordWriter::Field(const std::unordered_map<std::string, std::string>& value) {
+        // 書き出し結果が毎回同じになるようキー順に並べる
+        std::vector<const std::pair<const std::string, std::string>*> sorted;
+        sorted.reserve(value.size());
+        for (const auto& kv : value) {
+            sorted.push_back(&kv);
+        }
+        std::sort(sorted.begin(), sorted.end(),
+            [](const auto* a, const auto* b) { return a->first < b->first; });
+
+        std::vector<Ref> pairs;
+        pairs.reserve(sorted.size() * 2);
+        for (const auto* kv : sorted) {
+            pairs.push_back(bundle_.AddString(kv->first));
+            pairs.push_back(bundle_.AddString(kv->second));
+        }
+        const Ref ref = bundle_.AddData(pairs.data(), pairs.size() * sizeof(Ref), sorted.size());
+        Append(&ref, sizeof(ref));
+    }
+
+    void RecordReader::Field(std::string& value) {
+        Ref ref{};
+        Read(&ref, sizeof(ref));
+        if (ok_ && !bundle_.ReadString(ref, value)) {
+            ok_ = false;
+        }
+    }
+
+    void RecordReader::Field(std::unordered_map<std::string, std::string>& value) {
+        Ref ref{};
+        Read(&ref, sizeof(ref));
+        if (!ok_) return;
+        const uint8_t* p = bundle_.DataAt(ref, sizeof(Ref) * 2);
+        if (!p) {
+            ok_ = false;
+            return;
+        }
+        value.clear();
+        value.reserve(ref.count);
+        std::string key;
+        std::string mapped;
+        for (uint32_t i = 0; i < ref.count; ++i) {
+            Ref pair[2];
+            std::memcpy(pair, p + static_cast<size_t>(i) * sizeof(pair), sizeof(pair));
+            if (!bundle_.ReadString(pair[0], key) || !bundle_.ReadString(pair[1], mapped)) {
+                ok_ = false;
+                return;
+            }
+            value.emplace(key, mapped);
+        }
+    }
+
+    //==================================================
+    // BundleWriter
+    //==================================================
+
+    void BundleWriter::AddSource(const SourceInfo& source) {
+        const Ref path = AddString(source.path);
+        sources_.push_back({ path.offset, path.count, source.size, source.writeTime });
+    }
+
+    Ref BundleWriter::AddString(std::string_view s) {
+        auto it = stringIndex_.find(std::string(s));
+        if (it != stringIndex_.end()) {
+            return { it->second, static_cast<uint32_t>(s.size()) };
+        }
+        const uint32_t offset = static_cast<uint32_t>(strings_.size());
+        AppendBytes(strings_, s.data(), s.size());
+        strings_.push_back(0);
+        stringIndex_.emplace(std::string(s), offset);
+        return { offset, static_cast<uint32_t>(s.size()) };
+    }
+
+    Ref BundleWriter::AddData(const void* p, size_t bytes, size_t count) {
+        data_.resize(AlignUp(data_.size(), kDataAlign), 0);
+        const uint32_t offset = static_cast<uint32_t>(data_.size());
+        if (bytes > 0) {
+            AppendBytes(data_, p, bytes);
+        }
+        return { offset, static_cast<uint32_t>(count) };
+    }
+
+    std::vector<uint8_t> BundleWriter::Finish() const {
+        Header header{};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.headerSize = static_cast<uint16_t>(sizeof(Header));
+        header.kind = kind_;
+        header.schemaHash = schemaHash_;
+        header.recordCount = recordCount_;
+        header.recordSize = recordSize_;
+        header.sourceCount = static_cast<uint32_t>(sources_.size());
+        header.sourcesOffset = static_cast<uint32_t>(sizeof(Header));
+        header.recordsOffset = static_cast<uint32_t>(AlignUp(header.sourcesOffset + sources_.size() * sizeof(SourceEntry), kDataAlign));
+        header.stringsOffset = static_cast<uint32_t>(header.recordsOffset + records_.size());
+        header.stringsSize = static_cast<uint32_t>(strings_.size());
+        header.dataOffset = static_cast<uint32_t>(AlignUp(header.stringsOffset + header.stringsSize, kDataAlign));
+        header.dataSize = static_cast<uint32_t>(data_.size());
+
+        std::vector<uint8_t> out;
+        out.reserve(header.dataOffset + header.dataSize);
+        AppendBytes(out, &header, sizeof(header));
+        if (!sources_.empty()) {
+            AppendBytes(out, sources_.data(), sources_.size() * sizeof(SourceEntry));
+        }
+        out.resize(header.recordsOffset, 0);
+        out.insert(out.end(), records_.begin(), records_.end());
+        out.insert(out.end(), strings_.begin(), strings_.end());
+        out.resize(header.dataOffset, 0);
+        out.insert(out.end(), data_.begin(), data_.end());
+        return out;
+    }
+
+    bool BundleWriter::WriteFile(const std::string& path) const {
+        const std::vector<uint8_t> bytes = Finish();
+        std::error_code ec;
+        const std::filesystem::path target(path);
+        if (target.has_parent_path()) {
+            std::filesystem::create_directories(target.parent_path(), ec);
+        }
+        const std::filesystem::path temp = target.string() + ".tmp";
+        {
+            std::ofstream ofs(temp, std::ios::binary | std::ios::trunc);
+            if (!ofs) return false;
+            ofs.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!ofs) return false;
+        }
+        std::filesystem::rename(temp, target, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    //==================================================
+    // BundleReader
+    //==================================================
+
+    bool BundleReader::Open(std::vector<uint8_t> bytes, uint32_t kind, const SchemaHasher& schema) {
+        bytes_ = std::move(bytes);
+        base_ = bytes_.data();
+        const size_t size = bytes_.size();
+        if (size < sizeof(Header)) return false;
+        std::memcpy(&header_, base_, sizeof(Header));
+
+        if (header_.magic != kMagic || header_.version != kVersion || header_.headerSize != sizeof(Header)) return false;
+        if (header_.kind != kind || header_.schemaHash != schema.GetHash()) return false;
+        if (header_.recordSize != schema.GetRecordSize()) return false;
+        if (!InRange(size, header_.sourcesOffset, static_cast<uint64_t>(header_.sourceCount) * sizeof(SourceEntry))) return false;
+        if (!InRange(size, header_.recordsOffset, static_cast<uint64_t>(header_.recordCount) * header_.recordSize)) return false;
+        if (!InRange(size, header_.stringsOffset, header_.stringsSize)) return false;
+        if (!InRange(size, header_.dataOffset, header_.dataSize)) return false;
+        return true;
+    }
+
+    bool BundleReader::MatchesSources(const std::vector<SourceInfo>& current) const {
+        if (current.size() != header_.sourceCount) return false;
+        std::string path;
+        for (uint32_t i = 0; i < header_.sourceCount; ++i) {
+            SourceEntry entry;
+            std::memcpy(&entry, base_ + header_.sourcesOffset + static_cast<size_t>(i) * sizeof(SourceEntry), sizeof(entry));
+            if (!ReadString({ entry.pathOffset, entry.pathLength }, path)) return false;
+            const SourceInfo& now = current[i];
+            if (path != now.path || entry.size != now.size || entry.writeTime != now.writeTime) return false;
+        }
+        return true;
+    }
+
+    bool BundleReader::ReadString(const Ref& ref, std::string& out) const {
+        if (!InRange(header_.stringsSize, ref.offset, ref.count)) return false;
+        out.assign(reinterpret_cast<const char*>(base_ + header_.stringsOffset + ref.offset), ref.count);
+        return true;
+    }
+
+    const uint8_t* BundleReader::DataAt(const Ref& ref, size_t elementSize) const {
+        if (!InRange(header_.dataSize, ref.offset, static_cast<uint64_t>(ref.count) * elementSize)) return nullptr;
+        return base_ + header_.dataOffset + ref.offset;
+    }
+
+} // namespace CookedDefs
@@ -0,0 +1,473 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+/// <summary>
+/// JSON で書いた定義（プリファブ / エフェクト / ウェーブ）を焼き込んだバイナリ（.defs）。
+///
+/// レイアウト（リトルエンディアン。位置はすべてファイル先頭からのオフセットでポインタを含まない）:
+///   Header
+///   SourceEntry[sourceCount]   焼き込み元 JSON のパス・サイズ・更新時刻（古くなったかの判定用）
+///   records                    recordSize × recordCount の固定長レコード
+///   strings                    NUL 終端文字列を連結した文字列テーブル（同じ文字列は 1 つにまとめる）
+///   data                       可変長配列（カーブの制御点などの平たい配列 / 子レコードの並び）を 8 byte 境界で連結
+/// レコード内の文字列は (offset, length) で strings を、配列は (offset, count) で data を指す。
+///
+/// 各型のフィールド並びは CookFields(ar, value) に 1 回だけ書き、書き出し・読み込み・スキーマハッシュで共用する。
+/// 構造体を変えるとスキーマハッシュが変わり、古い .defs は読まずに JSON から読み直して焼き直す。
+/// </summary>
+namespace CookedDefs {
+
+    static_assert(std::endian::native == std::endian::little, "cooked defs are little-endian");
+
+    constexpr uint32_t kMagic = 0x53464544;   // "DEFS"
+    constexpr uint16_t kVersion = 1;
+
+    constexpr uint32_t MakeKind(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+            (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+            (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+            (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t kind;            // MakeKind で作る種別（'PRFB' など）
+        uint32_t schemaHash;      // SchemaHash<T>()
+        uint32_t recordCount;
+        uint32_t recordSize;
+        uint32_t sourceCount;
+        uint32_t sourcesOffset;
+        uint32_t recordsOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+        uint32_t dataOffset;
+        uint32_t dataSize;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 56, "CookedDefs::Header layout");
+
+    struct SourceEntry {
+        uint32_t pathOffset;      // strings 内
+        uint32_t pathLength;
+        uint64_t size;
+        int64_t  writeTime;       // std::filesystem::file_time_type の生カウント
+    };
+    static_assert(sizeof(SourceEntry) == 24, "CookedDefs::SourceEntry layout");
+
+    /// <summary>文字列・配列の参照（レコード内に 8 byte で埋まる）</summary>
+    struct Ref {
+        uint32_t offset;
+        uint32_t count;           // 文字列なら長さ、配列なら要素数
+    };
+
+    /// <summary>焼き込み元ファイルの情報</summary>
+    struct SourceInfo {
+        std::string path;
+        uint64_t size = 0;
+        int64_t  writeTime = 0;
+    };
+
+    /// <summary>どこから読むか</summary>
+    enum class Mode {
+        PreferCooked,   // 新しい .defs があればそれを、無ければ JSON から読んで焼き直す
+        JsonOnly,       // JSON だけ（焼き直さない）
+        CookedOnly,     // .defs だけ（無い・古いなら失敗）
+    };
+
+    /// <summary>
+    /// "Resources/Json/..." の JSON ファイル / ディレクトリに対応する .defs のパス
+    /// （"Resources/Cooked/..." 。ファイルは拡張子を .defs に、ディレクトリは末尾に .defs を付ける）。
+    /// Resources/Json 以下でなければ空。
+    /// </summary>
+    std::string CookedPathFor(const std::string& jsonPath);
+
+    /// <summary>1 ファイルのサイズと更新時刻を取る（無ければ false）</summary>
+    bool StatSource(const std::string& path, SourceInfo& out);
+
+    /// <summary>dir 直下の *.json をパス順に列挙する（再帰なし）</summary>
+    std::vector<SourceInfo> ScanSources(const std::string& dir);
+
+    //====================
+    // フィールドの書き出し・読み込み・ハッシュ（CookFields から呼ばれる）
+    // 中身がそのまま写せる型（trivially copyable）はバイト列のまま、それ以外は CookFields で再帰する。
+    // そのまま写す構造体にも CookFields を書く（スキーマハッシュがフィールドの並びと型を見るため）
+    //====================
+
+    template <class T>
+    inline constexpr bool kIsRaw = std::is_trivially_copyable_v<T>;
+
+    // 数学型の成分の並び（バイト列のまま写す。スキーマハッシュに成分の型と並びを含めるためだけに使う）
+    template <class Ar> void CookFields(Ar& ar, Vector2& v) { ar.Field(v.x); ar.Field(v.y); }
+    template <class Ar> void CookFields(Ar& ar, Vector3& v) { ar.Field(v.x); ar.Field(v.y); ar.Field(v.z); }
+    template <class Ar> void CookFields(Ar& ar, Vector4& v) { ar.Field(v.x); ar.Field(v.y); ar.Field(v.z); ar.Field(v.w); }
+
+    class BundleWriter;
+    class BundleReader;
+
+    class RecordWriter {
+    public:
+        RecordWriter(BundleWriter& bundle, std::vector<uint8_t>& out) : bundle_(bundle), out_(out) {}
+
+        template <class T>
+        void Field(const T& value) {
+            if constexpr (kIsRaw<T>) {
+                Append(&value, sizeof(T));
+            } else {
+                CookFields(*this, const_cast<T&>(value));
+            }
+        }
+        void Field(const std::string& value);
+        void Field(const std::unordered_map<std::string, std::string>& value);
+
+        template <class T>
+        void Field(const std::vector<T>& value);
+
+    private:
+        void Append(const void* p, size_t bytes) {
+            const uint8_t* src = static_cast<const uint8_t*>(p);
+            out_.insert(out_.end(), src, src + bytes);
+        }
+
+        BundleWriter& bundle_;
+        std::vector<uint8_t>& out_;
+    };
+
+    class RecordReader {
+    public:
+        RecordReader(const BundleReader& bundle, const uint8_t* cursor, const uint8_t* end)
+            : bundle_(bundle), cursor_(cursor), end_(end) {}
+
+        template <class T>
+        void Field(T& value) {
+            if constexpr (kIsRaw<T>) {
+                Read(&value, sizeof(T));
+            } else {
+                CookFields(*this, value);
+            }
+        }
+        void Field(std::string& value);
+        void Field(std::unordered_map<std::string, std::string>& value);
+
+        template <class T>
+        void Field(std::vector<T>& value);
+
+        bool Ok() const { return ok_; }
+
+    private:
+        void Read(void* dst, size_t bytes) {
+            if (!ok_ || static_cast<size_t>(end_ - cursor_) < bytes) {
+                ok_ = false;
+                return;
+            }
+            std::memcpy(dst, cursor_, bytes);
+            cursor_ += bytes;
+        }
+
+        const BundleReader& bundle_;
+        const uint8_t* cursor_;
+        const uint8_t* end_;
+        bool ok_ = true;
+    };
+
+    /// <summary>
+    /// フィールドの並び（種別・型・サイズ）をハッシュし、レコードサイズを数える。
+    /// バイト列のまま写す型も中身の型まで含める（同じサイズのフィールドの入れ替えや int→float でもハッシュが変わる）。
+    /// </summary>
+    class SchemaHasher {
+    public:
+        template <class T>
+        void Field(const T& value) {
+            if constexpr (kIsRaw<T>) {
+                MixRaw(value);
+                recordSize_ += sizeof(T);
+            } else {
+                Mix('{', 0);
+                CookFields(*this, const_cast<T&>(value));
+                Mix('}', 0);
+            }
+        }
+        void Field(const std::string&) { Mix('S', 0); recordSize_ += sizeof(Ref); }
+        void Field(const std::unordered_map<std::string, std::string>&) { Mix('M', 0); recordSize_ += sizeof(Ref); }
+
+        template <class T>
+        void Field(const std::vector<T>&) {
+            Mix('[', 0);
+            if constexpr (kIsRaw<T>) {
+                MixRaw(T{});
+            } else {
+                // 要素の並びもハッシュに含める（要素のサイズはこのレコードには数えない）
+                SchemaHasher element;
+                T sample{};
+                element.Field(sample);
+                Mix('E', element.hash_);
+            }
+            Mix(']', 0);
+            recordSize_ += sizeof(Ref);
+        }
+
+        uint32_t GetHash() const { return hash_; }
+        uint32_t GetRecordSize() const { return recordSize_; }
+
+    private:
+        // バイト列のまま写す型の中身：スカラーは種類とサイズ、配列は要素数と要素、構造体は CookFields の並び
+        template <class T>
+        void MixRaw(const T& value) {
+            if constexpr (std::is_enum_v<T>) {
+                Mix('N', sizeof(T));
+                MixScalar<std::underlying_type_t<T>>();
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                MixScalar<T>();
+            } else if constexpr (std::is_array_v<T>) {
+                Mix('A', static_cast<uint32_t>(std::extent_v<T>));
+                MixRaw(value[0]);
+            } else {
+                static_assert(requires(SchemaHasher& hasher, T& v) { CookFields(hasher, v); },
+                    "丸写しする構造体にも CookFields を書く（スキーマハッシュにフィールドの並びと型を含めるため）");
+                // 中の並びはハッシュだけに使う（レコードには sizeof(T) のまま丸写しする）
+                const uint32_t recordSize = recordSize_;
+                Mix('(', sizeof(T));
+                CookFields(*this, const_cast<T&>(value));
+                Mix(')', 0);
+                recordSize_ = recordSize;
+            }
+        }
+
+        template <class T>
+        void MixScalar() {
+            uint32_t kind = 'U';
+            if constexpr (std::is_same_v<T, bool>) kind = 'B';
+            else if constexpr (std::is_floating_point_v<T>) kind = 'F';
+            else if constexpr (std::is_signed_v<T>) kind = 'I';
+            Mix(kind, sizeof(T));
+        }
+
+        void Mix(uint32_t tag, uint32_t value) {
+            for (uint32_t v : { tag, value }) {
+                for (int i = 0; i < 4; ++i) {
+                    hash_ ^= (v >> (i * 8)) & 0xFFu;
+                    hash_ *= 16777619u;
+                }
+            }
+        }
+
+        uint32_t hash_ = 2166136261u;
+        uint32_t recordSize_ = 0;
+    };
+
+    template <class T>
+    SchemaHasher Describe() {
+        SchemaHasher hasher;
+        T sample{};
+        hasher.Field(sample);
+        return hasher;
+    }
+
+    //====================
+    // .defs の組み立て
+    //====================
+
+    class BundleWriter {
+    public:
+        BundleWriter(uint32_t kind, const SchemaHasher& schema)
+            : kind_(kind), schemaHash_(schema.GetHash()), recordSize_(schema.GetRecordSize()) {}
+
+        template <class T>
+        void AddRecord(const T& value) {
+            RecordWriter writer(*this, records_);
+            writer.Field(value);
+            ++recordCount_;
+        }
+
+        void AddSource(const SourceInfo& source);
+
+        /// <summary>ファイル全体のバイト列を作る</summary>
+        std::vector<uint8_t> Finish() const;
+
+        /// <summary>Finish した内容を書き出す（親ディレクトリも作る。一時ファイルに書いてから置き換える）</summary>
+        bool WriteFile(const std::string& path) const;
+
+        // RecordWriter から使う
+        Ref AddString(std::string_view s);
+        Ref AddData(const void* p, size_t bytes, size_t count);
+
+    private:
+        uint32_t kind_;
+        uint32_t schemaHash_;
+        uint32_t recordSize_;
+        uint32_t recordCount_ = 0;
+        std::vector<SourceEntry> sources_;
+        std::vector<uint8_t> records_;
+        std::vector<uint8_t> strings_;
+        std::vector<uint8_t> data_;
+        std::unordered_map<std::string, uint32_t> stringIndex_;
+    };
+
+    //====================
+    // .defs の読み込み（ヘッダと各区間の範囲を検証してから、レコードを 1 つずつ取り出す）
+    //====================
+
+    class BundleReader {
+    public:
+        /// <summary>バイト列を受け取って検証する。種別・スキーマ・レコードサイズが違えば false</summary>
+        bool Open(std::vector<uint8_t> bytes, uint32_t kind, const SchemaHasher& schema);
+
+        uint32_t GetRecordCount() const { return header_.recordCount; }
+
+        template <class T>
+        bool ReadRecord(uint32_t index, T& out) const {
+            if (index >= header_.recordCount) return false;
+            const uint8_t* record = base_ + header_.recordsOffset + static_cast<size_t>(index) * header_.recordSize;
+            RecordReader reader(*this, record, record + header_.recordSize);
+            reader.Field(out);
+            return reader.Ok();
+        }
+
+        /// <summary>焼き込み時の元ファイル一覧が current（パス順）と一致するか</summary>
+        bool MatchesSources(const std::vector<SourceInfo>& current) const;
+
+        // RecordReader から使う
+        bool ReadString(const Ref& ref, std::string& out) const;
+        const uint8_t* DataAt(const Ref& ref, size_t elementSize) const;
+        const uint8_t* DataEnd() const { return base_ + header_.dataOffset + header_.dataSize; }
+
+    private:
+        std::vector<uint8_t> bytes_;
+        const uint8_t* base_ = nullptr;
+        Header header_{};
+    };
+
+    //====================
+    // RecordWriter / RecordReader の配列
+    //====================
+
+    template <class T>
+    void RecordWriter::Field(const std::vector<T>& value) {
+        Ref ref{};
+        if constexpr (kIsRaw<T>) {
+            ref = bundle_.AddData(value.data(), value.size() * sizeof(T), value.size());
+        } else {
+            // 子レコードを連続して並べてから data へ写す（子の中の配列は先に data へ入る）
+            std::vector<uint8_t> children;
+            RecordWriter child(bundle_, children);
+            for (const T& element : value) {
+                child.Field(element);
+            }
+            ref = bundle_.AddData(children.data(), children.size(), value.size());
+        }
+        Append(&ref, sizeof(ref));
+    }
+
+    template <class T>
+    void RecordReader::Field(std::vector<T>& value) {
+        Ref ref{};
+        Read(&ref, sizeof(ref));
+        if (!ok_) return;
+        const uint8_t* p = bundle_.DataAt(ref, kIsRaw<T> ? sizeof(T) : 0);
+        if (!p) {
+            ok_ = false;
+            return;
+        }
+        value.resize(ref.count);
+        if constexpr (kIsRaw<T>) {
+            if (ref.count > 0) {
+                std::memcpy(value.data(), p, static_cast<size_t>(ref.count) * sizeof(T));
+            }
+        } else {
+            RecordReader child(bundle_, p, bundle_.DataEnd());
+            for (T& element : value) {
+                child.Field(element);
+            }
+            ok_ = child.Ok();
+        }
+    }
+
+    //====================
+    // 読み書きの入口
+    //====================
+
+    /// <summary>
+    /// .defs から全レコードを読む。sources が null でなければ焼き込み元と一致するかも確かめる
+    /// （pack モードでは元 JSON を見ずに .defs を信じる）。読めなければ out は変更しない。
+    /// </summary>
+    template <class T>
+    bool LoadRecords(const std::string& cookedPath, uint32_t kind,
+        const std::vector<SourceInfo>* sources, std::vector<T>& out);
+
+    /// <summary>
+    /// values を .defs に焼き込む。pack モードでは書かない（pack の中身が正）。
+    /// </summary>
+    template <class T>
+    bool SaveRecords(const std::string& cookedPath, uint32_t kind,
+        const std::vector<SourceInfo>& sources, const std::vector<T>& values);
+
+    /// <summary>
+    /// 元ファイルの一覧を含まないバイト列にする（ベンチマークで 2 つの読み方の結果を比べる用）
+    /// </summary>
+    template <class T>
+    std::vector<uint8_t> Encode(uint32_t kind, const std::vector<T>& values) {
+        BundleWriter writer(kind, Describe<T>());
+        for (const T& value : values) {
+            writer.AddRecord(value);
+        }
+        return writer.Finish();
+    }
+
+    // .defs のバイト列を読む（FS / pack 共通）。pack モードなら元 JSON の確認を省く
+    std::vector<uint8_t> LoadBytes(const std::string& cookedPath);
+    bool IsPackMode();
+
+    template <class T>
+    bool LoadRecords(const std::string& cookedPath, uint32_t kind,
+        const std::vector<SourceInfo>* sources, std::vector<T>& out) {
+        if (cookedPath.empty()) return false;
+        std::vector<uint8_t> bytes = LoadBytes(cookedPath);
+        if (bytes.empty()) return false;
+        BundleReader reader;
+        if (!reader.Open(std::move(bytes), kind, Describe<T>())) return false;
+        if (sources && !IsPackMode() && !reader.MatchesSources(*sources)) return false;
+
+        std::vector<T> values(reader.GetRecordCount());
+        for (uint32_t i = 0; i < reader.GetRecordCount(); ++i) {
+            if (!reader.ReadRecord(i, values[i])) return false;
+        }
+        out = std::move(values);
+        return true;
+    }
+
+    template <class T>
+    bool SaveRecords(const std::string& cookedPath, uint32_t kind,
+        const std::vector<SourceInfo>& sources, const std::vector<T>& values) {
+        if (cookedPath.empty() || IsPackMode()) return false;
+        BundleWriter writer(kind, Describe<T>());
+        for (const SourceInfo& source : sources) {
+            writer.AddSource(source);
+        }
+        for (const T& value : values) {
+            writer.AddRecord(value);
+        }
+        return writer.WriteFile(cookedPath);
+    }
+
+} // namespace CookedDefs
+
+/// <summary>
+/// .cpp に定義した CookFields を 3 種のアーカイブ向けに実体化する（ヘッダには宣言だけ置く）
+/// </summary>
+#define COOKED_DEFS_INSTANTIATE(Type) \
+    template void CookFields(CookedDefs::RecordWriter&, Type&); \
+    template void CookFields(CookedDefs::RecordReader&, Type&); \
+    template void CookFields(CookedDefs::SchemaHasher&, Type&)
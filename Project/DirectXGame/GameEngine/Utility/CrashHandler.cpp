@@ -4,6 +4,9 @@
 #include <dbghelp.h>
 #include <cstdio>
 
+#include "SessionLogger.h"
+#include "ReplaySystem.h"
+
 #pragma comment(lib, "dbghelp.lib")
 
 namespace {
@@ -85,6 +88,11 @@ namespace {
     }
 
     LONG WINAPI TopLevelExceptionFilter(EXCEPTION_POINTERS* ep) {
+        // 書き込みスレッドに渡る前のログ（落ちる直前の state/input）を先にファイルへ出す。ロックは取らない
+        SessionLogger::Instance().DrainForCrash();
+        // リプレイ記録も、キーフレーム待ちでバッファに残っている入力（最大 5 秒ぶん）を出す
+        ReplaySystem::Instance().DrainForCrash();
+
         // 出力先：セッションフォルダが分かっていれば crash.dmp、無ければカレントへ
         const std::string path = g_dumpDir.empty()
             ? ("crash_" + TimeStampForFile() + ".dmp")
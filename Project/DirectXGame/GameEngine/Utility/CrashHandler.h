@@ -14,7 +14,8 @@ namespace CrashHandler {
 
     /// <summary>
     /// ダンプ出力先フォルダ（セッションフォルダ）を通知する。
-    /// クラッシュ時に SessionLogger の mutex を触らないよう、ここでパスをキャッシュしておく。
+    /// クラッシュ時に SessionLogger の状態を触らないよう、ここでパスをキャッシュしておく。
+    /// （クラッシュ時は SessionLogger::DrainForCrash でリングに残ったログだけを書き出す）
     /// 未設定のままクラッシュした場合はカレントに crash_<時刻>.dmp を出す。
     /// </summary>
     void SetDumpDir(const std::string& dir);
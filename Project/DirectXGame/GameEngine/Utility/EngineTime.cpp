@@ -4,6 +4,12 @@
 namespace {
     // 現在の供給元（所有はしない。寿命はゲーム側が管理）
     ITimeScaleProvider* g_provider = nullptr;
+
+    // 固定ステップの状態（メインスレッドだけが触る）
+    bool g_fixedStep = false;
+    uint64_t g_simulationTick = 0;
+    uint64_t g_renderFrame = 0;
+    float g_interpolationAlpha = 1.0f;
 }
 
 namespace EngineTime {
@@ -16,4 +22,33 @@ namespace EngineTime {
         return g_provider ? g_provider->GetScaledDeltaTime(g) : fallback;
     }
 
+    void SetFixedStep(bool enabled) {
+        g_fixedStep = enabled;
+    }
+
+    bool IsFixedStep() {
+        return g_fixedStep;
+    }
+
+    void AdvanceSimulationTick() {
+        ++g_simulationTick;
+    }
+
+    uint64_t GetSimulationTick() {
+        return g_simulationTick;
+    }
+
+    void BeginRenderFrame(float alpha) {
+        ++g_renderFrame;
+        g_interpolationAlpha = (alpha < 0.0f) ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    }
+
+    uint64_t GetRenderFrame() {
+        return g_renderFrame;
+    }
+
+    float GetInterpolationAlpha() {
+        return g_fixedStep ? g_interpolationAlpha : 1.0f;
+    }
+
 } // namespace EngineTime
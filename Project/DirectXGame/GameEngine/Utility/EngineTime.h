@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include "TimeGroup.h"
 
 class ITimeScaleProvider;
@@ -22,4 +23,29 @@ namespace EngineTime {
     /// </summary>
     float ScaledDeltaTime(TimeGroup g, float fallback);
 
+    //====================
+    // 固定ステップ更新と描画補間（Framework が設定し、描画側が読む）
+    //====================
+
+    /// <summary>
+    /// 固定ステップで回しているか。false のときは 1 描画フレーム = 1 tick で補間しない。
+    /// </summary>
+    void SetFixedStep(bool enabled);
+    bool IsFixedStep();
+
+    /// <summary>
+    /// シミュレーションを 1 tick 進める。Framework がシーン更新の直前に呼ぶ。
+    /// 描画側はこの番号が変わったのを見て「前 tick の状態」を退避する。
+    /// </summary>
+    void AdvanceSimulationTick();
+    uint64_t GetSimulationTick();
+
+    /// <summary>
+    /// 描画フレームの開始を知らせる。alpha は直前 tick から次の tick までの経過割合（0..1）。
+    /// 描画は「前 tick と最新 tick の間を alpha で補間した状態」を使う（1 なら最新 tick そのまま）。
+    /// </summary>
+    void BeginRenderFrame(float alpha);
+    uint64_t GetRenderFrame();
+    float GetInterpolationAlpha();
+
 } // namespace EngineTime
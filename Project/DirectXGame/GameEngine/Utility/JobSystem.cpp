@@ -0,0 +1,135 @@
+#include "JobSystem.h"
+#include "PepperMacros.h"
+#include <algorithm>
+#include <string>
+
+namespace {
+// ワーカースレッド上かどうか（ワーカー内からの ParallelFor は直列に回す）
+thread_local bool tIsJobWorker = false;
+}
+
+JobSystem* JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return &instance;
+}
+
+JobSystem::~JobSystem()
+{
+    Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+    if (IsInitialized()) return;
+
+    if (workerCount == 0) {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        workerCount = (hw > 1) ? hw - 1 : 1;
+    }
+    stopping_ = false;
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+void JobSystem::Finalize()
+{
+    if (!IsInitialized()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeCv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain,
+    const std::function<void(uint32_t begin, uint32_t end)>& body,
+    uint32_t maxThreads)
+{
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    auto runSerial = [&]() {
+        for (uint32_t begin = 0; begin < count; begin += grain) {
+            body(begin, std::min(count, begin + grain));
+        }
+    };
+
+    // ワーカー内からの呼び出しや、別の ParallelFor が走っている間は直列
+    if (tIsJobWorker || busy_.exchange(true, std::memory_order_acquire)) {
+        runSerial();
+        return;
+    }
+
+    if (!IsInitialized()) Initialize();
+
+    const uint32_t chunks = (count + grain - 1) / grain;
+    uint32_t participants = GetWorkerCount();
+    if (maxThreads > 0) participants = std::min(participants, maxThreads - 1);
+    participants = std::min(participants, chunks - 1);
+
+    if (participants == 0) {
+        runSerial();
+        busy_.store(false, std::memory_order_release);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        grain_ = grain;
+        participants_ = participants;
+        activeWorkers_ = participants;
+        nextIndex_.store(0, std::memory_order_relaxed);
+        ++jobGeneration_;
+    }
+    wakeCv_.notify_all();
+
+    // 呼び出し元もチャンクを取りに行き、参加ワーカーが全員抜けるのを待つ（join）
+    RunChunks();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [this]() { return activeWorkers_ == 0; });
+        body_ = nullptr;
+    }
+    busy_.store(false, std::memory_order_release);
+}
+
+void JobSystem::RunChunks()
+{
+    const auto& body = *body_;
+    for (;;) {
+        const uint32_t begin = nextIndex_.fetch_add(grain_, std::memory_order_relaxed);
+        if (begin >= count_) break;
+        body(begin, std::min(count_, begin + grain_));
+    }
+}
+
+void JobSystem::WorkerMain(uint32_t workerIndex)
+{
+    tIsJobWorker = true;
+    PEPPER_THREAD_NAME("Job" + std::to_string(workerIndex));
+    uint64_t seenGeneration = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wakeCv_.wait(lock, [&]() { return stopping_ || jobGeneration_ != seenGeneration; });
+        if (stopping_) return;
+        seenGeneration = jobGeneration_;
+        if (workerIndex >= participants_) continue;  // このジョブには参加しない
+
+        lock.unlock();
+        {
+            PEPPER_SCOPE("Job_Chunks");
+            RunChunks();
+        }
+        lock.lock();
+        if (--activeWorkers_ == 0) doneCv_.notify_one();
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// フレーム内の並列処理用ワーカースレッドプール（シングルトン）。
+///
+/// ParallelFor で [0, count) をチャンクに分けてワーカーと呼び出し元スレッドで分担し、
+/// 全チャンクが終わるまで戻らない（＝呼び出しの直後が join 点）。
+/// スレッドは起動時に一度だけ作り、毎フレームの生成・破棄はしない。
+/// body は要素ごとに別のものへ書く前提（ロックは取らない）。
+/// ワーカー内から ParallelFor を呼んだ場合や、他の ParallelFor 実行中は呼び出し元で直列に回す。
+/// </summary>
+class JobSystem {
+public:
+    static JobSystem* GetInstance();
+
+    /// <summary>workerCount = 0 なら（論理コア数 - 1）本。呼び出し元スレッドも処理に加わる。</summary>
+    void Initialize(uint32_t workerCount = 0);
+    void Finalize();
+
+    bool IsInitialized() const { return !workers_.empty(); }
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    /// <summary>
+    /// [0, count) を grain 個ずつのチャンクにして body(begin, end) を並列に呼ぶ。全部終わってから戻る。
+    /// maxThreads > 0 なら呼び出し元を含めてその本数までしか使わない（スケーリング計測用）。
+    /// 未初期化なら既定の本数で Initialize する。
+    /// </summary>
+    void ParallelFor(uint32_t count, uint32_t grain,
+        const std::function<void(uint32_t begin, uint32_t end)>& body,
+        uint32_t maxThreads = 0);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerMain(uint32_t workerIndex);
+    // 現在のジョブからチャンクを取れるだけ取って処理する
+    void RunChunks();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeCv_;     // ワーカーを起こす（新しいジョブ / 終了）
+    std::condition_variable doneCv_;     // 呼び出し元へ「参加ワーカーが全員抜けた」を知らせる
+    uint64_t jobGeneration_ = 0;         // ジョブを出すたびに進む
+    bool stopping_ = false;
+
+    // ----- 実行中のジョブ（mutex_ で公開し、チャンクの取り合いは atomic） -----
+    const std::function<void(uint32_t, uint32_t)>* body_ = nullptr;
+    uint32_t count_ = 0;
+    uint32_t grain_ = 1;
+    uint32_t participants_ = 0;          // このジョブに参加するワーカー数
+    uint32_t activeWorkers_ = 0;         // まだ抜けていない参加ワーカー数
+    std::atomic<uint32_t> nextIndex_{ 0 };
+    std::atomic<bool> busy_{ false };    // ParallelFor の多重実行検出
+};
@@ -0,0 +1,503 @@
+#include "JsonDocument.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+
+#include "JsonParser.h"
+#include "LogBuffer.h"
+
+namespace {
+	// 読み取り専用アクセスで存在しないキーを返すときに使う共有のNullノード
+	const JsonNode kNullNode{};
+
+	// ハッシュ索引のスロット数（キー数の 2 倍以上の 2 の累乗）
+	uint32_t IndexCapacity(size_t count) {
+		uint32_t capacity = 16;
+		while (capacity < count * 2) {
+			capacity <<= 1;
+		}
+		return capacity;
+	}
+}
+
+//==================================================
+// JsonNode
+//==================================================
+
+bool JsonNode::AsBool(bool defaultValue) const {
+	if (type_ == Type::Bool) return boolValue_;
+	return defaultValue;
+}
+
+int64_t JsonNode::AsInt(int64_t defaultValue) const {
+	if (type_ == Type::Int) return intValue_;
+	if (type_ == Type::Double) return static_cast<int64_t>(doubleValue_);
+	return defaultValue;
+}
+
+double JsonNode::AsDouble(double defaultValue) const {
+	if (type_ == Type::Double) return doubleValue_;
+	if (type_ == Type::Int) return static_cast<double>(intValue_);
+	return defaultValue;
+}
+
+std::string_view JsonNode::AsStringView() const {
+	if (type_ == Type::String) return std::string_view(stringValue_, size_);
+	return std::string_view();
+}
+
+std::string JsonNode::AsString() const {
+	return std::string(AsStringView());
+}
+
+std::string JsonNode::AsString(std::string_view defaultValue) const {
+	if (type_ == Type::String) return std::string(stringValue_, size_);
+	return std::string(defaultValue);
+}
+
+JsonNode::Range<JsonNode> JsonNode::AsArray() const {
+	if (type_ == Type::Array) return Range<JsonNode>(items_, size_);
+	return Range<JsonNode>();
+}
+
+JsonNode::Range<JsonMember> JsonNode::AsObject() const {
+	if (type_ == Type::Object) return Range<JsonMember>(members_, size_);
+	return Range<JsonMember>();
+}
+
+const JsonNode* JsonNode::Find(std::string_view key) const {
+	if (type_ != Type::Object) return nullptr;
+
+	if (size_ < kHashThreshold) {
+		for (uint32_t i = 0; i < size_; ++i) {
+			if (members_[i].first == key) return &members_[i].second;
+		}
+		return nullptr;
+	}
+
+	// メンバー配列の直後にある索引（値はメンバー番号 + 1、0 は空き）を線形探索で引く
+	const uint32_t* index = reinterpret_cast<const uint32_t*>(members_ + size_);
+	const uint32_t mask = IndexCapacity(size_) - 1;
+	for (uint32_t slot = HashKey(key) & mask;; slot = (slot + 1) & mask) {
+		const uint32_t entry = index[slot];
+		if (entry == 0) return nullptr;
+		const JsonMember& member = members_[entry - 1];
+		if (member.first == key) return &member.second;
+	}
+}
+
+const JsonNode& JsonNode::operator[](std::string_view key) const {
+	const JsonNode* found = Find(key);
+	return found ? *found : kNullNode;
+}
+
+size_t JsonNode::Size() const {
+	if (type_ == Type::Array || type_ == Type::Object || type_ == Type::String) return size_;
+	return 0;
+}
+
+const JsonNode& JsonNode::operator[](size_t index) const {
+	if (type_ == Type::Array && index < size_) {
+		return items_[index];
+	}
+	return kNullNode;
+}
+
+const JsonNode& JsonNode::Null() {
+	return kNullNode;
+}
+
+uint32_t JsonNode::HashKey(std::string_view key) {
+	uint32_t hash = 2166136261u;
+	for (const char c : key) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+//==================================================
+// JsonDocument
+//==================================================
+
+void JsonDocument::Reset(size_t reserveBytes) {
+	root_ = JsonNode();
+	blocks_.clear();
+	cursor_ = nullptr;
+	remaining_ = 0;
+	arenaBytes_ = 0;
+	nextBlockSize_ = (std::max)(kMinBlockSize, reserveBytes);
+}
+
+void* JsonDocument::Allocate(size_t bytes, size_t alignment) {
+	const size_t misalign = reinterpret_cast<uintptr_t>(cursor_) & (alignment - 1);
+	const size_t padding = misalign ? alignment - misalign : 0;
+	if (!cursor_ || padding + bytes > remaining_) {
+		// 足りなければ新しいブロックへ（大きい要求はそのサイズで確保する）
+		const size_t blockSize = (std::max)(nextBlockSize_, bytes + alignment);
+		blocks_.push_back(std::make_unique<std::byte[]>(blockSize));
+		cursor_ = blocks_.back().get();
+		remaining_ = blockSize;
+		arenaBytes_ += blockSize;
+		nextBlockSize_ = (std::max)(kMinBlockSize, blockSize);
+		return Allocate(bytes, alignment);
+	}
+	std::byte* result = cursor_ + padding;
+	cursor_ = result + bytes;
+	remaining_ -= padding + bytes;
+	return result;
+}
+
+std::string_view JsonDocument::CopyString(std::string_view s) {
+	char* dst = static_cast<char*>(Allocate(s.size() + 1, 1));
+	if (!s.empty()) {
+		std::memcpy(dst, s.data(), s.size());
+	}
+	dst[s.size()] = '\0';
+	return std::string_view(dst, s.size());
+}
+
+JsonNode JsonDocument::MakeString(std::string_view s) {
+	JsonNode node;
+	node.type_ = JsonNode::Type::String;
+	node.size_ = static_cast<uint32_t>(s.size());
+	node.stringValue_ = CopyString(s).data();
+	return node;
+}
+
+JsonNode JsonDocument::MakeStringView(std::string_view s) {
+	JsonNode node;
+	node.type_ = JsonNode::Type::String;
+	node.size_ = static_cast<uint32_t>(s.size());
+	node.stringValue_ = s.data();
+	return node;
+}
+
+JsonNode JsonDocument::MakeArray(const JsonNode* items, size_t count) {
+	JsonNode node;
+	node.type_ = JsonNode::Type::Array;
+	node.size_ = static_cast<uint32_t>(count);
+	node.items_ = nullptr;
+	if (count > 0) {
+		JsonNode* dst = static_cast<JsonNode*>(Allocate(sizeof(JsonNode) * count, alignof(JsonNode)));
+		std::copy(items, items + count, dst);
+		node.items_ = dst;
+	}
+	return node;
+}
+
+JsonNode JsonDocument::MakeObject(const JsonMember* members, size_t count) {
+	JsonNode node;
+	node.type_ = JsonNode::Type::Object;
+	node.size_ = static_cast<uint32_t>(count);
+	node.members_ = nullptr;
+	if (count == 0) {
+		return node;
+	}
+
+	const bool indexed = count >= JsonNode::kHashThreshold;
+	const uint32_t capacity = indexed ? IndexCapacity(count) : 0;
+	const size_t bytes = sizeof(JsonMember) * count + sizeof(uint32_t) * capacity;
+	JsonMember* dst = static_cast<JsonMember*>(Allocate(bytes, alignof(JsonMember)));
+	std::copy(members, members + count, dst);
+	node.members_ = dst;
+
+	if (indexed) {
+		uint32_t* index = reinterpret_cast<uint32_t*>(dst + count);
+		std::fill(index, index + capacity, 0u);
+		const uint32_t mask = capacity - 1;
+		for (uint32_t i = 0; i < count; ++i) {
+			for (uint32_t slot = JsonNode::HashKey(dst[i].first) & mask;; slot = (slot + 1) & mask) {
+				if (index[slot] == 0) {
+					index[slot] = i + 1;
+					break;
+				}
+				if (dst[index[slot] - 1].first == dst[i].first) {
+					break;  // 重複キーは先に現れたほうを残す
+				}
+			}
+		}
+	}
+	return node;
+}
+
+//==================================================
+// ベンチマーク
+//==================================================
+
+namespace {
+	// 2 つの木が同じ内容か（オブジェクトは順序込みで比べる）
+	bool SameTree(const JsonValue& a, const JsonNode& b) {
+		if (a.GetType() != b.GetType()) return false;
+		switch (a.GetType()) {
+		case JsonValue::Type::Null:
+			return true;
+		case JsonValue::Type::Bool:
+			return a.AsBool() == b.AsBool();
+		case JsonValue::Type::Int:
+			return a.AsInt() == b.AsInt();
+		case JsonValue::Type::Double:
+			return a.AsDouble() == b.AsDouble();
+		case JsonValue::Type::String:
+			return a.AsString() == b.AsStringView();
+		case JsonValue::Type::Array: {
+			const auto& items = a.AsArray();
+			if (items.size() != b.Size()) return false;
+			for (size_t i = 0; i < items.size(); ++i) {
+				if (!SameTree(items[i], b[i])) return false;
+			}
+			return true;
+		}
+		case JsonValue::Type::Object: {
+			const auto& members = a.AsObject();
+			const auto other = b.AsObject();
+			if (members.size() != other.size()) return false;
+			for (size_t i = 0; i < members.size(); ++i) {
+				if (members[i].first != other[i].first) return false;
+				if (!SameTree(members[i].second, other[i].second)) return false;
+				// 索引経由の参照も同じメンバーに当たるか
+				const JsonValue* expected = a.Find(members[i].first);
+				const JsonNode* found = b.Find(members[i].first);
+				if (!expected || !found || !SameTree(*expected, *found)) return false;
+			}
+			return true;
+		}
+		}
+		return false;
+	}
+
+	// 参照ベンチマーク用に、全オブジェクトとそのキーを集める（両方の木を同じ順で辿る）
+	struct LookupSet {
+		std::vector<const JsonValue*> values;
+		std::vector<const JsonNode*> nodes;
+		std::vector<std::vector<std::string>> keys;
+	};
+
+	void CollectObjects(const JsonValue& a, const JsonNode& b, LookupSet& set) {
+		if (a.IsArray()) {
+			for (size_t i = 0; i < a.Size(); ++i) {
+				CollectObjects(a[i], b[i], set);
+			}
+		} else if (a.IsObject()) {
+			std::vector<std::string> keys;
+			for (const auto& member : a.AsObject()) {
+				keys.push_back(member.first);
+			}
+			keys.push_back("__missing_key__");  // 見つからない参照も混ぜる
+			set.values.push_back(&a);
+			set.nodes.push_back(&b);
+			set.keys.push_back(std::move(keys));
+			for (const auto& member : a.AsObject()) {
+				CollectObjects(member.second, *b.Find(member.first), set);
+			}
+		}
+	}
+
+	// SAX のイベントを数えるだけのハンドラ（木を作らない読み込みの速さを見る）
+	class CountingHandler : public JsonParser::Handler {
+	public:
+		size_t values = 0;   // スカラー + 配列 + オブジェクト
+		size_t keys = 0;
+
+		bool OnNull() override { ++values; return true; }
+		bool OnBool(bool) override { ++values; return true; }
+		bool OnInt(int64_t) override { ++values; return true; }
+		bool OnDouble(double) override { ++values; return true; }
+		bool OnString(std::string_view) override { ++values; return true; }
+		bool OnStartObject() override { ++values; return true; }
+		bool OnKey(std::string_view) override { ++keys; return true; }
+		bool OnStartArray() override { ++values; return true; }
+	};
+
+	void CountNodes(const JsonNode& node, size_t& values, size_t& keys) {
+		++values;
+		if (node.IsArray()) {
+			for (const JsonNode& item : node.AsArray()) {
+				CountNodes(item, values, keys);
+			}
+		} else if (node.IsObject()) {
+			for (const JsonMember& member : node.AsObject()) {
+				++keys;
+				CountNodes(member.second, values, keys);
+			}
+		}
+	}
+
+	// 不正な入力と、報告されるべき行・列
+	struct ErrorCase {
+		const char* source;
+		size_t line;
+		size_t column;
+	};
+
+	const ErrorCase kErrorCases[] = {
+		{ "{\n  \"a\": 1,\n  \"b\": ,\n}", 3, 8 },
+		{ "// comment\n{\"a\": tru}", 2, 7 },
+		{ "[1, 2", 1, 6 },
+		{ "{\"s\": \"abc", 1, 11 },
+		{ "[\"\\q\"]", 1, 5 },
+		{ "[1] x", 1, 5 },
+		{ "[-]", 1, 2 },
+	};
+}
+
+void RunJsonBenchmark() {
+	using Clock = std::chrono::steady_clock;
+	namespace fs = std::filesystem;
+
+	const char* kCorpusDir = "Resources/Json";
+	std::vector<std::string> sources;
+	size_t totalBytes = 0;
+	std::error_code ec;
+	for (fs::recursive_directory_iterator it(kCorpusDir, ec), end; !ec && it != end; it.increment(ec)) {
+		if (!it->is_regular_file() || it->path().extension() != ".json") continue;
+		std::string source;
+		if (!JsonParser::ReadFile(it->path().string(), source)) continue;
+		totalBytes += source.size();
+		sources.push_back(std::move(source));
+	}
+	if (sources.empty()) {
+		LogBuffer::Instance().Add(std::string("[Json] No .json files under ") + kCorpusDir);
+		return;
+	}
+
+	// 1 回あたり 8MB 程度になるまで繰り返す
+	const int parseReps = static_cast<int>((std::max)(size_t{ 1 }, (8u << 20) / (std::max)(totalBytes, size_t{ 1 })));
+
+	auto t0 = Clock::now();
+	for (int r = 0; r < parseReps; ++r) {
+		for (const auto& src : sources) {
+			JsonParser::Result result = JsonParser::Parse(src);
+			if (!result.success) break;
+		}
+	}
+	const double valueParseMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+	t0 = Clock::now();
+	for (int r = 0; r < parseReps; ++r) {
+		for (const auto& src : sources) {
+			JsonParser::DocumentResult result = JsonParser::ParseDocument(src);
+			if (!result.success) break;
+		}
+	}
+	const double documentParseMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+	CountingHandler counter;
+	t0 = Clock::now();
+	for (int r = 0; r < parseReps; ++r) {
+		counter = CountingHandler{};
+		for (const auto& src : sources) {
+			JsonParser::SaxResult result = JsonParser::ParseSax(src, counter);
+			if (!result.success) break;
+		}
+	}
+	const double saxParseMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+	// 一致確認と参照ベンチマークの材料
+	std::vector<JsonParser::Result> values;
+	std::vector<JsonParser::DocumentResult> documents;
+	values.reserve(sources.size());
+	documents.reserve(sources.size());
+	bool match = true;
+	size_t parseFailures = 0;
+	size_t arenaBytes = 0;
+	size_t nodeCount = 0;
+	size_t keyCount = 0;
+	LookupSet lookups;
+	for (const auto& src : sources) {
+		values.push_back(JsonParser::Parse(src));
+		documents.push_back(JsonParser::ParseDocument(src));
+		if (values.back().success != documents.back().success) match = false;
+		if (!values.back().success || !documents.back().success) {
+			++parseFailures;
+			continue;
+		}
+		arenaBytes += documents.back().document.GetArenaBytes();
+		CountNodes(documents.back().document.Root(), nodeCount, keyCount);
+		if (!SameTree(values.back().value, documents.back().document.Root())) match = false;
+		CollectObjects(values.back().value, documents.back().document.Root(), lookups);
+	}
+
+	size_t lookupCount = 0;
+	for (const auto& keys : lookups.keys) lookupCount += keys.size();
+	const int lookupReps = static_cast<int>((std::max)(size_t{ 1 }, size_t{ 2000000 } / (std::max)(lookupCount, size_t{ 1 })));
+
+	// 呼び出し側と同じく const char* のキーで引く（旧方式はそのたびに std::string を作る）
+	size_t valueHits = 0;
+	t0 = Clock::now();
+	for (int r = 0; r < lookupReps; ++r) {
+		for (size_t i = 0; i < lookups.values.size(); ++i) {
+			const JsonValue& obj = *lookups.values[i];
+			for (const auto& key : lookups.keys[i]) {
+				valueHits += obj[key.c_str()].IsNull() ? 0 : 1;
+			}
+		}
+	}
+	const double valueLookupMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+	size_t nodeHits = 0;
+	t0 = Clock::now();
+	for (int r = 0; r < lookupReps; ++r) {
+		for (size_t i = 0; i < lookups.nodes.size(); ++i) {
+			const JsonNode& obj = *lookups.nodes[i];
+			for (const auto& key : lookups.keys[i]) {
+				nodeHits += obj[key.c_str()].IsNull() ? 0 : 1;
+			}
+		}
+	}
+	const double nodeLookupMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	if (valueHits != nodeHits) match = false;
+	const bool saxMatch = counter.values == nodeCount && counter.keys == keyCount;
+
+	// 不正入力の行・列が 3 つの入口で同じで、期待どおりか
+	size_t errorCasesOk = 0;
+	for (const ErrorCase& c : kErrorCases) {
+		JsonParser::Result value = JsonParser::Parse(c.source);
+		JsonParser::DocumentResult document = JsonParser::ParseDocument(c.source);
+		CountingHandler handler;
+		JsonParser::SaxResult sax = JsonParser::ParseSax(c.source, handler);
+		const bool ok =
+			value.status == JsonParser::Status::SyntaxError &&
+			value.errorLine == c.line && value.errorColumn == c.column &&
+			document.status == value.status && document.errorLine == c.line && document.errorColumn == c.column &&
+			sax.status == value.status && sax.errorLine == c.line && sax.errorColumn == c.column;
+		if (ok) {
+			++errorCasesOk;
+		} else {
+			char line[160];
+			std::snprintf(line, sizeof(line), "  error case MISMATCH: %s at %zu:%zu (expected %zu:%zu)",
+				value.errorMessage.c_str(), value.errorLine, value.errorColumn, c.line, c.column);
+			LogBuffer::Instance().Add(line);
+		}
+	}
+
+	const double parsedMB = static_cast<double>(totalBytes) * parseReps / (1024.0 * 1024.0);
+	const double lookupTotal = static_cast<double>(lookupCount) * lookupReps;
+	char buf[256];
+	LogBuffer::Instance().Add("[Json] JsonValue vs JsonDocument (arena) vs SAX on Resources/Json");
+	std::snprintf(buf, sizeof(buf), "  corpus: %zu files, %.1f KB, %zu objects, %zu keys  node: %zu vs %zu bytes",
+		sources.size(), totalBytes / 1024.0, lookups.values.size(), lookupCount,
+		sizeof(JsonValue), sizeof(JsonNode));
+	LogBuffer::Instance().Add(buf);
+	std::snprintf(buf, sizeof(buf), "  parse x%d : JsonValue %.2f ms (%.1f MB/s) / JsonDocument %.2f ms (%.1f MB/s)  x%.2f",
+		parseReps, valueParseMs, parsedMB / (valueParseMs / 1000.0),
+		documentParseMs, parsedMB / (documentParseMs / 1000.0),
+		(documentParseMs > 0.0) ? valueParseMs / documentParseMs : 0.0);
+	LogBuffer::Instance().Add(buf);
+	std::snprintf(buf, sizeof(buf), "  SAX (no tree) %.2f ms (%.1f MB/s), %zu values / %zu keys per pass, events %s",
+		saxParseMs, parsedMB / (saxParseMs / 1000.0), counter.values, counter.keys,
+		saxMatch ? "match" : "MISMATCH");
+	LogBuffer::Instance().Add(buf);
+	std::snprintf(buf, sizeof(buf), "  lookup x%d : JsonValue %.1f ns / JsonDocument %.1f ns per key  x%.2f",
+		lookupReps, valueLookupMs * 1e6 / lookupTotal, nodeLookupMs * 1e6 / lookupTotal,
+		(nodeLookupMs > 0.0) ? valueLookupMs / nodeLookupMs : 0.0);
+	LogBuffer::Instance().Add(buf);
+	std::snprintf(buf, sizeof(buf), "  arena %.1f KB total, parse failures %zu, trees %s, error positions %zu/%zu",
+		arenaBytes / 1024.0, parseFailures, match ? "match" : "MISMATCH",
+		errorCasesOk, std::size(kErrorCases));
+	LogBuffer::Instance().Add(buf);
+}
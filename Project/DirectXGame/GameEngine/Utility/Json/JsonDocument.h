@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JsonValue.h"
+
+struct JsonMember;
+
+/// <summary>
+/// 読み取り専用の JSON ノード（16 byte の tagged union）
+/// 文字列・配列要素・オブジェクトのメンバーはすべて所属する JsonDocument のアリーナ上にあり、
+/// ノード自体は型・要素数・値（またはアリーナへのポインタ）だけを持つ。
+/// 読み取り API は JsonValue と同じ名前（Find / operator[] / AsXxx / Size）で、
+/// 存在しないキーや範囲外の添字は共有の Null ノードを返す。
+/// </summary>
+class JsonNode {
+public:
+	using Type = JsonValue::Type;
+	using Member = JsonMember;
+
+	/// <summary>
+	/// 要素の連続領域を指す範囲（range-for 用）
+	/// </summary>
+	template <class T>
+	class Range {
+	public:
+		Range() = default;
+		Range(const T* first, size_t count) : first_(first), count_(count) {}
+		const T* begin() const { return first_; }
+		const T* end() const { return first_ + count_; }
+		size_t size() const { return count_; }
+		bool empty() const { return count_ == 0; }
+		const T& operator[](size_t index) const { return first_[index]; }
+
+	private:
+		const T* first_ = nullptr;
+		size_t count_ = 0;
+	};
+
+	/// <summary>
+	/// これ以上のキー数を持つオブジェクトはハッシュ索引を持つ（未満は線形探索のほうが速い）
+	/// </summary>
+	static constexpr uint32_t kHashThreshold = 8;
+
+public:
+	JsonNode() : type_(Type::Null), size_(0), intValue_(0) {}
+	explicit JsonNode(bool value) : type_(Type::Bool), size_(0), intValue_(0) { boolValue_ = value; }
+	explicit JsonNode(int64_t value) : type_(Type::Int), size_(0), intValue_(value) {}
+	explicit JsonNode(double value) : type_(Type::Double), size_(0), doubleValue_(value) {}
+
+	//====================
+	// 型判定
+	//====================
+	Type GetType() const { return type_; }
+	bool IsNull() const { return type_ == Type::Null; }
+	bool IsBool() const { return type_ == Type::Bool; }
+	bool IsInt() const { return type_ == Type::Int; }
+	bool IsDouble() const { return type_ == Type::Double; }
+	bool IsNumber() const { return type_ == Type::Int || type_ == Type::Double; }
+	bool IsString() const { return type_ == Type::String; }
+	bool IsArray() const { return type_ == Type::Array; }
+	bool IsObject() const { return type_ == Type::Object; }
+
+	//====================
+	// 値の取得（要求した型と異なる場合はデフォルト値を返す）
+	//====================
+	bool AsBool(bool defaultValue = false) const;
+	int64_t AsInt(int64_t defaultValue = 0) const;
+	double AsDouble(double defaultValue = 0.0) const;
+
+	/// <summary>
+	/// 文字列をアリーナ上のまま参照する（コピーなし）。String 以外なら空
+	/// </summary>
+	std::string_view AsStringView() const;
+
+	/// <summary>
+	/// 文字列を std::string にコピーして返す（保持する側へ代入する用）
+	/// </summary>
+	std::string AsString() const;
+	std::string AsString(std::string_view defaultValue) const;
+
+	/// <summary>
+	/// 配列要素 / オブジェクトのメンバーの範囲。型が違えば空
+	/// </summary>
+	Range<JsonNode> AsArray() const;
+	Range<JsonMember> AsObject() const;
+
+	//====================
+	// オブジェクト操作（キーはコピーせずに比較する）
+	//====================
+	bool Contains(std::string_view key) const { return Find(key) != nullptr; }
+	const JsonNode* Find(std::string_view key) const;
+	const JsonNode& operator[](std::string_view key) const;
+
+	//====================
+	// 配列操作
+	//====================
+	size_t Size() const;
+	const JsonNode& operator[](size_t index) const;
+
+	static const JsonNode& Null();
+
+	/// <summary>
+	/// オブジェクトの索引に使うキーのハッシュ（FNV-1a）
+	/// </summary>
+	static uint32_t HashKey(std::string_view key);
+
+private:
+	friend class JsonDocument;
+
+	Type type_;
+	uint32_t size_;   // 文字列長 / 要素数 / メンバー数
+
+	union {
+		bool boolValue_;
+		int64_t intValue_;
+		double doubleValue_;
+		const char* stringValue_;
+		const JsonNode* items_;
+		const JsonMember* members_;
+	};
+};
+
+static_assert(sizeof(JsonNode) == 16, "JsonNode must stay 16 bytes");
+
+/// <summary>
+/// オブジェクトの 1 メンバー（キーはアリーナ上の文字列を指す）
+/// </summary>
+struct JsonMember {
+	std::string_view first;
+	JsonNode second;
+};
+
+/// <summary>
+/// JsonNode の木とその文字列・子要素を 1 つのアリーナにまとめて持つ読み取り専用ドキュメント
+/// パース中の確保はアリーナのブロック単位（ソースサイズから見積もるので通常 1〜2 回）で、
+/// ドキュメントを破棄すると木全体が一度に解放される。
+/// JsonParser はソース自体もアリーナへ置き、エスケープを含まない文字列はその上を直接指す。
+/// 書き換えて保存する用途は従来どおり JsonValue / JsonWriter を使う。
+/// </summary>
+class JsonDocument {
+public:
+	JsonDocument() = default;
+	JsonDocument(JsonDocument&&) noexcept = default;
+	JsonDocument& operator=(JsonDocument&&) noexcept = default;
+	JsonDocument(const JsonDocument&) = delete;
+	JsonDocument& operator=(const JsonDocument&) = delete;
+
+	const JsonNode& Root() const { return root_; }
+
+	/// <summary>
+	/// 木を捨ててアリーナを空にする。次のブロックは bytes 以上で確保する
+	/// </summary>
+	void Reset(size_t reserveBytes = 0);
+
+	/// <summary>
+	/// アリーナから確保した総バイト数（統計用）
+	/// </summary>
+	size_t GetArenaBytes() const { return arenaBytes_; }
+
+	//====================
+	// 構築（JsonParser が使う）
+	//====================
+	void SetRoot(const JsonNode& root) { root_ = root; }
+	std::string_view CopyString(std::string_view s);
+	JsonNode MakeString(std::string_view s);
+
+	/// <summary>
+	/// 既にアリーナ上にある文字列をコピーせずに指すノードを作る（終端 NUL は無い）
+	/// </summary>
+	JsonNode MakeStringView(std::string_view s);
+
+	/// <summary>
+	/// アリーナから文字領域を確保する（パーサがソースを置き、文字列ノードから直接指すため）
+	/// </summary>
+	char* AllocateChars(size_t count) { return static_cast<char*>(Allocate(count, 1)); }
+	JsonNode MakeArray(const JsonNode* items, size_t count);
+
+	/// <summary>
+	/// メンバーをアリーナへ写す。キー数が kHashThreshold 以上なら後ろにハッシュ索引も作る。
+	/// 同じキーが複数あれば先に現れたものを引く（JsonValue::Find と同じ）
+	/// </summary>
+	JsonNode MakeObject(const JsonMember* members, size_t count);
+
+private:
+	void* Allocate(size_t bytes, size_t alignment);
+
+	static constexpr size_t kMinBlockSize = 16 * 1024;
+
+	JsonNode root_;
+	std::vector<std::unique_ptr<std::byte[]>> blocks_;
+	std::byte* cursor_ = nullptr;
+	size_t remaining_ = 0;
+	size_t nextBlockSize_ = kMinBlockSize;
+	size_t arenaBytes_ = 0;
+};
+
+/// <summary>
+/// Resources/Json 以下の全ファイルで、JsonValue / JsonDocument / SAX のパース時間と
+/// JsonValue / JsonDocument のキー参照時間を比べて LogBuffer に出す。
+/// 木と SAX イベントが一致するか、不正入力の行・列が 3 つの入口で同じかも確かめる。
+/// </summary>
+void RunJsonBenchmark();
@@ -1,205 +1,439 @@
 #include "JsonParser.h"
 
-#include <cctype>
-#include <cstdlib>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
 #include <fstream>
-#include <sstream>
+#include <vector>
 
 namespace {
 
-	// パース失敗時の例外（内部用）
-	struct ParseError {
-		std::string message;
+	// これより深い入れ子はエラーにする（再帰下降なのでスタックを守る）
+	constexpr int kMaxDepth = 512;
+
+	// SAX 用の値（木を作らないので中身は無い）
+	struct NoValue {};
+
+	// JsonValue の木を作る（従来の書き換え可能な木）
+	// どの関数も false を返すとパースを打ち切る（DOM を作るビルダーは常に true）
+	class ValueBuilder {
+	public:
+		using Value = JsonValue;
+		using ArrayFrame = JsonValue::Array;
+		using ObjectFrame = JsonValue::Object;
+		using Key = std::string;
+
+		bool Null(Value& out) { out = JsonValue(nullptr); return true; }
+		bool Bool(bool v, Value& out) { out = JsonValue(v); return true; }
+		bool Int(int64_t v, Value& out) { out = JsonValue(v); return true; }
+		bool Double(double v, Value& out) { out = JsonValue(v); return true; }
+		bool String(std::string_view s, bool, Value& out) { out = JsonValue(std::string(s)); return true; }
+		bool MakeKey(std::string_view s, bool, Key& key) { key.assign(s); return true; }
+
+		bool BeginArray(ArrayFrame&) { return true; }
+		bool PushItem(ArrayFrame& arr, Value& v) { arr.push_back(std::move(v)); return true; }
+		bool EndArray(ArrayFrame& arr, Value& out) { out = JsonValue(std::move(arr)); return true; }
+
+		bool BeginObject(ObjectFrame&) { return true; }
+		bool PushMember(ObjectFrame& obj, Key& key, Value& v) {
+			obj.emplace_back(std::move(key), std::move(v));
+			return true;
+		}
+		bool EndObject(ObjectFrame& obj, Value& out) { out = JsonValue(std::move(obj)); return true; }
 	};
 
+	// JsonDocument のアリーナへ木を作る。
+	// 子要素はいったん共有のスタックへ積み、閉じ括弧で要素数が決まった時点でアリーナへ連続して写す。
+	// ソースがアリーナ上にあるとき（inSource）はエスケープの無い文字列・キーをコピーせずに指す
+	class DocumentBuilder {
+	public:
+		using Value = JsonNode;
+		using ArrayFrame = size_t;
+		using ObjectFrame = size_t;
+		using Key = std::string_view;
+
+		DocumentBuilder(JsonDocument& document, bool sourceInArena)
+			: document_(document), sourceInArena_(sourceInArena) {}
+
+		bool Null(Value& out) { out = JsonNode(); return true; }
+		bool Bool(bool v, Value& out) { out = JsonNode(v); return true; }
+		bool Int(int64_t v, Value& out) { out = JsonNode(v); return true; }
+		bool Double(double v, Value& out) { out = JsonNode(v); return true; }
+		bool String(std::string_view s, bool inSource, Value& out) {
+			out = (inSource && sourceInArena_) ? document_.MakeStringView(s) : document_.MakeString(s);
+			return true;
+		}
+		bool MakeKey(std::string_view s, bool inSource, Key& key) {
+			key = (inSource && sourceInArena_) ? s : document_.CopyString(s);
+			return true;
+		}
+
+		bool BeginArray(ArrayFrame& mark) { mark = items_.size(); return true; }
+		bool PushItem(ArrayFrame&, Value& v) { items_.push_back(v); return true; }
+		bool EndArray(ArrayFrame& mark, Value& out) {
+			out = document_.MakeArray(items_.data() + mark, items_.size() - mark);
+			items_.resize(mark);
+			return true;
+		}
+
+		bool BeginObject(ObjectFrame& mark) { mark = members_.size(); return true; }
+		bool PushMember(ObjectFrame&, Key& key, Value& v) { members_.push_back({ key, v }); return true; }
+		bool EndObject(ObjectFrame& mark, Value& out) {
+			out = document_.MakeObject(members_.data() + mark, members_.size() - mark);
+			members_.resize(mark);
+			return true;
+		}
+
+	private:
+		JsonDocument& document_;
+		bool sourceInArena_;
+		std::vector<JsonNode> items_;
+		std::vector<JsonMember> members_;
+	};
+
+	// 木を作らずに Handler へイベントを流す
+	class SaxBuilder {
+	public:
+		using Value = NoValue;
+		using ArrayFrame = size_t;
+		using ObjectFrame = size_t;
+		using Key = NoValue;
+
+		explicit SaxBuilder(JsonParser::Handler& handler) : handler_(handler) {}
+
+		bool Null(Value&) { return handler_.OnNull(); }
+		bool Bool(bool v, Value&) { return handler_.OnBool(v); }
+		bool Int(int64_t v, Value&) { return handler_.OnInt(v); }
+		bool Double(double v, Value&) { return handler_.OnDouble(v); }
+		bool String(std::string_view s, bool, Value&) { return handler_.OnString(s); }
+		bool MakeKey(std::string_view s, bool, Key&) { return handler_.OnKey(s); }
+
+		bool BeginArray(ArrayFrame& count) { count = 0; return handler_.OnStartArray(); }
+		bool PushItem(ArrayFrame& count, Value&) { ++count; return true; }
+		bool EndArray(ArrayFrame& count, Value&) { return handler_.OnEndArray(count); }
+
+		bool BeginObject(ObjectFrame& count) { count = 0; return handler_.OnStartObject(); }
+		bool PushMember(ObjectFrame& count, Key&, Value&) { ++count; return true; }
+		bool EndObject(ObjectFrame& count, Value&) { return handler_.OnEndObject(count); }
+
+	private:
+		JsonParser::Handler& handler_;
+	};
+
+	// 空白か（JSON の空白は 4 種のみ）
+	inline bool IsSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	inline bool IsDigit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	// from 以降で最初の空白でない位置（16 byte ずつまとめて比べる）
+	size_t SkipSpaces(const char* data, size_t size, size_t from) {
+		// 空白が無い・1 文字だけのことが多いので先に 1 文字ずつ見る
+		if (from < size && !IsSpace(data[from])) return from;
+		const __m128i space = _mm_set1_epi8(' ');
+		const __m128i tab = _mm_set1_epi8('\t');
+		const __m128i lf = _mm_set1_epi8('\n');
+		const __m128i cr = _mm_set1_epi8('\r');
+		while (from + 16 <= size) {
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+			const __m128i ws = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+			const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(ws)) & 0xFFFFu;
+			if (mask != 0) return from + std::countr_zero(mask);
+			from += 16;
+		}
+		while (from < size && IsSpace(data[from])) ++from;
+		return from;
+	}
+
+	// from 以降で最初の '"' か '\\' の位置。無ければ size
+	size_t FindStringSpecial(const char* data, size_t size, size_t from) {
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		while (from + 16 <= size) {
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+			const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+			if (mask != 0) return from + std::countr_zero(mask);
+			from += 16;
+		}
+		while (from < size && data[from] != '"' && data[from] != '\\') ++from;
+		return from;
+	}
+
+	template <class Builder>
 	class Parser {
 	public:
-		Parser(std::string_view src) : src_(src) {}
+		using Value = typename Builder::Value;
+
+		Parser(std::string_view src, Builder& builder) : src_(src), builder_(builder) {}
 
-		JsonValue ParseRoot() {
+		bool ParseRoot(Value& out) {
 			SkipWhitespaceAndComments();
-			JsonValue value = ParseValue();
+			if (!ParseValue(out, 0)) return false;
 			SkipWhitespaceAndComments();
 			if (!AtEnd()) {
-				Throw("Trailing data after root JSON value");
+				return Fail("Trailing data after root JSON value");
 			}
-			return value;
+			return true;
 		}
 
-		size_t Line() const { return line_; }
-		size_t Column() const { return column_; }
+		JsonParser::Status GetStatus() const { return status_; }
+		const std::string& ErrorMessage() const { return message_; }
+
+		// 行・列はエラー時にだけ先頭から数え直す（通常の走査では改行を数えない）
+		size_t ErrorLine() const {
+			size_t line = 1;
+			for (size_t i = 0; i < errorPos_; ++i) {
+				if (src_[i] == '\n') ++line;
+			}
+			return line;
+		}
+
+		size_t ErrorColumn() const {
+			const size_t lineStart = src_.rfind('\n', errorPos_ == 0 ? 0 : errorPos_ - 1);
+			if (lineStart == std::string_view::npos || errorPos_ == 0) return errorPos_ + 1;
+			return errorPos_ - lineStart;
+		}
 
 	private:
 		bool AtEnd() const { return pos_ >= src_.size(); }
 		char Peek() const { return src_[pos_]; }
 
-		char Advance() {
-			char c = src_[pos_++];
-			if (c == '\n') {
-				++line_;
-				column_ = 1;
-			} else {
-				++column_;
-			}
-			return c;
-		}
-
 		bool Match(char c) {
 			if (!AtEnd() && Peek() == c) {
-				Advance();
+				++pos_;
 				return true;
 			}
 			return false;
 		}
 
-		void Expect(char c) {
+		bool Expect(char c) {
 			if (AtEnd() || Peek() != c) {
 				std::string msg = "Expected '";
 				msg += c;
 				msg += "'";
-				Throw(msg);
+				return Fail(msg);
 			}
-			Advance();
+			++pos_;
+			return true;
 		}
 
-		[[noreturn]] void Throw(const std::string& msg) {
-			throw ParseError{ msg };
+		// 最初のエラーだけを残す
+		bool Fail(std::string_view msg) {
+			if (status_ == JsonParser::Status::Ok) {
+				status_ = JsonParser::Status::SyntaxError;
+				message_.assign(msg);
+				errorPos_ = (std::min)(pos_, src_.size());
+			}
+			return false;
+		}
+
+		bool Abort() {
+			if (status_ == JsonParser::Status::Ok) {
+				status_ = JsonParser::Status::Aborted;
+				message_ = "Aborted by handler";
+				errorPos_ = (std::min)(pos_, src_.size());
+			}
+			return false;
 		}
 
 		// // と /* */ をスキップ
 		void SkipWhitespaceAndComments() {
-			while (!AtEnd()) {
-				char c = Peek();
-				if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
-					Advance();
-				} else if (c == '/' && pos_ + 1 < src_.size()) {
-					char next = src_[pos_ + 1];
-					if (next == '/') {
-						// 行コメント: 改行まで読み飛ばす
-						Advance(); Advance();
-						while (!AtEnd() && Peek() != '\n') {
-							Advance();
-						}
-					} else if (next == '*') {
-						// ブロックコメント: */ まで読み飛ばす
-						Advance(); Advance();
-						while (!AtEnd()) {
-							if (Peek() == '*' && pos_ + 1 < src_.size() && src_[pos_ + 1] == '/') {
-								Advance(); Advance();
-								break;
-							}
-							Advance();
-						}
-					} else {
-						return;
-					}
+			const char* data = src_.data();
+			const size_t size = src_.size();
+			while (true) {
+				pos_ = SkipSpaces(data, size, pos_);
+				if (pos_ + 1 >= size || data[pos_] != '/') return;
+				const char next = data[pos_ + 1];
+				if (next == '/') {
+					// 行コメント: 改行まで読み飛ばす
+					const void* lf = std::memchr(data + pos_ + 2, '\n', size - pos_ - 2);
+					pos_ = lf ? static_cast<size_t>(static_cast<const char*>(lf) - data) : size;
+				} else if (next == '*') {
+					// ブロックコメント: */ まで読み飛ばす（閉じていなければ末尾まで）
+					const size_t close = src_.find("*/", pos_ + 2);
+					pos_ = (close == std::string_view::npos) ? size : close + 2;
 				} else {
 					return;
 				}
 			}
 		}
 
-		JsonValue ParseValue() {
+		bool ParseValue(Value& out, int depth) {
 			SkipWhitespaceAndComments();
-			if (AtEnd()) Throw("Unexpected end of input");
-
-			char c = Peek();
-			if (c == '{') return ParseObject();
-			if (c == '[') return ParseArray();
-			if (c == '"') return JsonValue(ParseString());
-			if (c == 't' || c == 'f') return ParseBool();
-			if (c == 'n') return ParseNull();
-			if (c == '-' || (c >= '0' && c <= '9')) return ParseNumber();
-			Throw(std::string("Unexpected character '") + c + "'");
+			if (AtEnd()) return Fail("Unexpected end of input");
+
+			const char c = Peek();
+			switch (c) {
+			case '{': return ParseObject(out, depth);
+			case '[': return ParseArray(out, depth);
+			case '"': {
+				std::string_view s;
+				bool inSource = false;
+				if (!ParseString(s, inSource)) return false;
+				return builder_.String(s, inSource, out) || Abort();
+			}
+			case 't':
+			case 'f': return ParseBool(out);
+			case 'n': return ParseNull(out);
+			default:
+				if (c == '-' || IsDigit(c)) return ParseNumber(out);
+				return Fail(std::string("Unexpected character '") + c + "'");
+			}
 		}
 
-		JsonValue ParseObject() {
-			Expect('{');
-			JsonValue::Object obj;
+		bool ParseObject(Value& out, int depth) {
+			if (depth >= kMaxDepth) return Fail("Nesting too deep");
+			++pos_;   // '{'
+			typename Builder::ObjectFrame obj{};
+			if (!builder_.BeginObject(obj)) return Abort();
 			SkipWhitespaceAndComments();
-			if (Match('}')) return JsonValue(std::move(obj));
+			if (Match('}')) return builder_.EndObject(obj, out) || Abort();
 
 			while (true) {
 				SkipWhitespaceAndComments();
 				if (AtEnd() || Peek() != '"') {
-					Throw("Expected string key in object");
+					return Fail("Expected string key in object");
 				}
-				std::string key = ParseString();
+				std::string_view keyText;
+				bool inSource = false;
+				if (!ParseString(keyText, inSource)) return false;
+				// エスケープ付きのキーは作業バッファにあるので値を読む前に写してもらう
+				typename Builder::Key key{};
+				if (!builder_.MakeKey(keyText, inSource, key)) return Abort();
 				SkipWhitespaceAndComments();
-				Expect(':');
-				JsonValue value = ParseValue();
-				obj.emplace_back(std::move(key), std::move(value));
+				if (!Expect(':')) return false;
+				Value value{};
+				if (!ParseValue(value, depth + 1)) return false;
+				if (!builder_.PushMember(obj, key, value)) return Abort();
 				SkipWhitespaceAndComments();
 				if (Match(',')) {
 					continue;
 				}
 				if (Match('}')) {
-					return JsonValue(std::move(obj));
+					return builder_.EndObject(obj, out) || Abort();
 				}
-				Throw("Expected ',' or '}' in object");
+				return Fail("Expected ',' or '}' in object");
 			}
 		}
 
-		JsonValue ParseArray() {
-			Expect('[');
-			JsonValue::Array arr;
+		bool ParseArray(Value& out, int depth) {
+			if (depth >= kMaxDepth) return Fail("Nesting too deep");
+			++pos_;   // '['
+			typename Builder::ArrayFrame arr{};
+			if (!builder_.BeginArray(arr)) return Abort();
 			SkipWhitespaceAndComments();
-			if (Match(']')) return JsonValue(std::move(arr));
+			if (Match(']')) return builder_.EndArray(arr, out) || Abort();
 
 			while (true) {
-				arr.push_back(ParseValue());
+				Value item{};
+				if (!ParseValue(item, depth + 1)) return false;
+				if (!builder_.PushItem(arr, item)) return Abort();
 				SkipWhitespaceAndComments();
 				if (Match(',')) {
 					continue;
 				}
 				if (Match(']')) {
-					return JsonValue(std::move(arr));
+					return builder_.EndArray(arr, out) || Abort();
 				}
-				Throw("Expected ',' or ']' in array");
+				return Fail("Expected ',' or ']' in array");
 			}
 		}
 
-		std::string ParseString() {
-			Expect('"');
-			std::string out;
-			while (!AtEnd()) {
-				char c = Advance();
-				if (c == '"') return out;
-				if (c == '\\') {
-					if (AtEnd()) Throw("Unterminated escape sequence");
-					char esc = Advance();
-					switch (esc) {
-					case '"':  out.push_back('"');  break;
-					case '\\': out.push_back('\\'); break;
-					case '/':  out.push_back('/');  break;
-					case 'b':  out.push_back('\b'); break;
-					case 'f':  out.push_back('\f'); break;
-					case 'n':  out.push_back('\n'); break;
-					case 'r':  out.push_back('\r'); break;
-					case 't':  out.push_back('\t'); break;
-					case 'u': {
-						// \uXXXX → UTF-8変換
-						if (pos_ + 4 > src_.size()) Throw("Invalid \\u escape");
-						uint32_t codepoint = 0;
-						for (int i = 0; i < 4; ++i) {
-							char h = Advance();
-							codepoint <<= 4;
-							if (h >= '0' && h <= '9') codepoint |= (h - '0');
-							else if (h >= 'a' && h <= 'f') codepoint |= (h - 'a' + 10);
-							else if (h >= 'A' && h <= 'F') codepoint |= (h - 'A' + 10);
-							else Throw("Invalid hex digit in \\u escape");
+		// 文字列を読む。エスケープが無ければソース上をそのまま指し（inSource = true）、
+		// あれば作業バッファへ展開する（次の ParseString で上書きされるので呼び出し側で写すこと）
+		bool ParseString(std::string_view& out, bool& inSource) {
+			const char* data = src_.data();
+			const size_t size = src_.size();
+			const size_t start = ++pos_;   // '"' の次
+			size_t special = FindStringSpecial(data, size, start);
+			if (special >= size) {
+				pos_ = size;
+				return Fail("Unterminated string");
+			}
+			if (data[special] == '"') {
+				out = std::string_view(data + start, special - start);
+				inSource = true;
+				pos_ = special + 1;
+				return true;
+			}
+
+			scratch_.assign(data + start, special - start);
+			pos_ = special;
+			while (true) {
+				if (data[pos_] == '"') {
+					++pos_;
+					out = scratch_;
+					inSource = false;
+					return true;
+				}
+				// data[pos_] == '\\'
+				++pos_;
+				if (AtEnd()) return Fail("Unterminated escape sequence");
+				const char esc = data[pos_++];
+				switch (esc) {
+				case '"':  scratch_.push_back('"');  break;
+				case '\\': scratch_.push_back('\\'); break;
+				case '/':  scratch_.push_back('/');  break;
+				case 'b':  scratch_.push_back('\b'); break;
+				case 'f':  scratch_.push_back('\f'); break;
+				case 'n':  scratch_.push_back('\n'); break;
+				case 'r':  scratch_.push_back('\r'); break;
+				case 't':  scratch_.push_back('\t'); break;
+				case 'u': {
+					// \uXXXX → UTF-8変換（サロゲートペアは 1 文字にまとめる）
+					uint32_t codepoint = 0;
+					if (!ParseHex4(codepoint)) return false;
+					if (codepoint >= 0xD800 && codepoint <= 0xDBFF &&
+						pos_ + 1 < size && data[pos_] == '\\' && data[pos_ + 1] == 'u') {
+						const size_t save = pos_;
+						pos_ += 2;
+						uint32_t low = 0;
+						if (!ParseHex4(low)) return false;
+						if (low >= 0xDC00 && low <= 0xDFFF) {
+							codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+						} else {
+							pos_ = save;
 						}
-						AppendUtf8(out, codepoint);
-						break;
-					}
-					default:
-						Throw(std::string("Invalid escape '\\") + esc + "'");
 					}
-				} else {
-					out.push_back(c);
+					AppendUtf8(scratch_, codepoint);
+					break;
+				}
+				default:
+					return Fail(std::string("Invalid escape '\\") + esc + "'");
 				}
+
+				special = FindStringSpecial(data, size, pos_);
+				if (special >= size) {
+					pos_ = size;
+					return Fail("Unterminated string");
+				}
+				scratch_.append(data + pos_, special - pos_);
+				pos_ = special;
 			}
-			Throw("Unterminated string");
+		}
+
+		bool ParseHex4(uint32_t& codepoint) {
+			if (pos_ + 4 > src_.size()) return Fail("Invalid \\u escape");
+			codepoint = 0;
+			for (int i = 0; i < 4; ++i) {
+				const char h = src_[pos_];
+				codepoint <<= 4;
+				if (h >= '0' && h <= '9') codepoint |= (h - '0');
+				else if (h >= 'a' && h <= 'f') codepoint |= (h - 'a' + 10);
+				else if (h >= 'A' && h <= 'F') codepoint |= (h - 'A' + 10);
+				else return Fail("Invalid hex digit in \\u escape");
+				++pos_;
+			}
+			return true;
 		}
 
 		static void AppendUtf8(std::string& out, uint32_t cp) {
@@ -208,98 +442,258 @@ namespace {
 			} else if (cp < 0x800) {
 				out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
 				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-			} else {
+			} else if (cp < 0x10000) {
 				out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
 				out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
 				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+			} else {
+				out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+				out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
 			}
 		}
 
-		JsonValue ParseBool() {
+		bool ParseBool(Value& out) {
 			if (src_.compare(pos_, 4, "true") == 0) {
-				for (int i = 0; i < 4; ++i) Advance();
-				return JsonValue(true);
+				pos_ += 4;
+				return builder_.Bool(true, out) || Abort();
 			}
 			if (src_.compare(pos_, 5, "false") == 0) {
-				for (int i = 0; i < 5; ++i) Advance();
-				return JsonValue(false);
+				pos_ += 5;
+				return builder_.Bool(false, out) || Abort();
 			}
-			Throw("Invalid literal (expected true/false)");
+			return Fail("Invalid literal (expected true/false)");
 		}
 
-		JsonValue ParseNull() {
+		bool ParseNull(Value& out) {
 			if (src_.compare(pos_, 4, "null") == 0) {
-				for (int i = 0; i < 4; ++i) Advance();
-				return JsonValue(nullptr);
+				pos_ += 4;
+				return builder_.Null(out) || Abort();
 			}
-			Throw("Invalid literal (expected null)");
+			return Fail("Invalid literal (expected null)");
 		}
 
-		JsonValue ParseNumber() {
-			size_t start = pos_;
+		// 範囲を決めてから from_chars で変換する（ロケール非依存・終端文字不要）
+		bool ParseNumber(Value& out) {
+			const char* data = src_.data();
+			const size_t size = src_.size();
+			const size_t start = pos_;
 			bool isFloat = false;
 
-			if (Peek() == '-') Advance();
-
-			while (!AtEnd() && std::isdigit(static_cast<unsigned char>(Peek()))) {
-				Advance();
-			}
-			if (!AtEnd() && Peek() == '.') {
+			if (data[pos_] == '-') ++pos_;
+			while (pos_ < size && IsDigit(data[pos_])) ++pos_;
+			if (pos_ < size && data[pos_] == '.') {
 				isFloat = true;
-				Advance();
-				while (!AtEnd() && std::isdigit(static_cast<unsigned char>(Peek()))) {
-					Advance();
-				}
+				++pos_;
+				while (pos_ < size && IsDigit(data[pos_])) ++pos_;
 			}
-			if (!AtEnd() && (Peek() == 'e' || Peek() == 'E')) {
+			if (pos_ < size && (data[pos_] == 'e' || data[pos_] == 'E')) {
 				isFloat = true;
-				Advance();
-				if (!AtEnd() && (Peek() == '+' || Peek() == '-')) Advance();
-				while (!AtEnd() && std::isdigit(static_cast<unsigned char>(Peek()))) {
-					Advance();
+				++pos_;
+				if (pos_ < size && (data[pos_] == '+' || data[pos_] == '-')) ++pos_;
+				while (pos_ < size && IsDigit(data[pos_])) ++pos_;
+			}
+
+			const char* first = data + start;
+			const char* last = data + pos_;
+			if (!isFloat) {
+				int64_t value = 0;
+				const auto [ptr, ec] = std::from_chars(first, last, value);
+				if (ec == std::errc() && ptr == last) {
+					return builder_.Int(value, out) || Abort();
 				}
+				// int64 に収まらない整数は double として読む
+				if (ec != std::errc::result_out_of_range) {
+					pos_ = start;
+					return Fail("Invalid number");
+				}
+			}
+			double value = 0.0;
+			const auto [ptr, ec] = std::from_chars(first, last, value);
+			if (ptr != last || (ec != std::errc() && ec != std::errc::result_out_of_range)) {
+				pos_ = start;
+				return Fail("Invalid number");
 			}
+			if (ec == std::errc::result_out_of_range) {
+				// from_chars は範囲外のとき value を書かないので、strtod と同じく桁あふれは ±HUGE_VAL、下あふれは ±0 にする
+				const bool negative = (*first == '-');
+				const double magnitude = IsOverflow(first, last) ? HUGE_VAL : 0.0;
+				value = negative ? -magnitude : magnitude;
+			}
+			return builder_.Double(value, out) || Abort();
+		}
 
-			std::string numStr(src_.substr(start, pos_ - start));
-			if (isFloat) {
-				return JsonValue(std::strtod(numStr.c_str(), nullptr));
+		// double に収まらない数値リテラルが桁あふれ（大きすぎる）か下あふれ（0 に近すぎる）かを、
+		// 先頭の 0 でない桁の 10 進指数で判断する（範囲外なら指数が 0 以上＝絶対値 1 以上は必ず桁あふれ）
+		static bool IsOverflow(const char* first, const char* last) {
+			const char* p = first;
+			if (*p == '-') ++p;
+			int64_t leadExponent = 0;
+			bool seenNonZero = false;
+			int64_t intDigits = 0;
+			for (; p < last && IsDigit(*p); ++p) {
+				if (seenNonZero || *p != '0') { seenNonZero = true; ++intDigits; }
+			}
+			if (seenNonZero) {
+				leadExponent = intDigits - 1;
+			}
+			if (p < last && *p == '.') {
+				++p;
+				int64_t zeros = 0;
+				for (; p < last && IsDigit(*p); ++p) {
+					if (!seenNonZero) {
+						if (*p == '0') { ++zeros; }
+						else { seenNonZero = true; leadExponent = -zeros - 1; }
+					}
+				}
+			}
+			if (p < last && (*p == 'e' || *p == 'E')) {
+				++p;
+				const bool negativeExponent = (*p == '-');
+				if (*p == '+' || *p == '-') ++p;
+				int64_t exponent = 0;
+				if (std::from_chars(p, last, exponent).ec == std::errc::result_out_of_range) {
+					return !negativeExponent;  // 指数そのものが int64 を超える
+				}
+				leadExponent += negativeExponent ? -exponent : exponent;
 			}
-			return JsonValue(static_cast<int64_t>(std::strtoll(numStr.c_str(), nullptr, 10)));
+			return leadExponent >= 0;
 		}
 
 	private:
 		std::string_view src_;
+		Builder& builder_;
+		std::string scratch_;   // エスケープ付き文字列の展開先（使い回して確保を減らす）
 		size_t pos_ = 0;
-		size_t line_ = 1;
-		size_t column_ = 1;
+		JsonParser::Status status_ = JsonParser::Status::Ok;
+		std::string message_;
+		size_t errorPos_ = 0;
 	};
 
+	// パーサの状態を結果へ写す（Result / DocumentResult / SaxResult 共通）
+	template <class ResultT, class ParserT>
+	void FillError(ResultT& result, const ParserT& parser) {
+		result.success = false;
+		result.status = parser.GetStatus();
+		result.errorMessage = parser.ErrorMessage();
+		result.errorLine = parser.ErrorLine();
+		result.errorColumn = parser.ErrorColumn();
+	}
+
+	template <class ResultT>
+	ResultT OpenFailed(const std::string& filePath) {
+		ResultT result;
+		result.success = false;
+		result.status = JsonParser::Status::OpenFailed;
+		result.errorMessage = "Failed to open file: " + filePath;
+		return result;
+	}
+
+	// ファイルサイズを取ってから読む（失敗時は false）
+	bool OpenSized(const std::string& filePath, std::ifstream& ifs, size_t& size) {
+		ifs.open(filePath, std::ios::binary | std::ios::ate);
+		if (!ifs) return false;
+		const std::streamoff end = ifs.tellg();
+		if (end < 0) return false;
+		size = static_cast<size_t>(end);
+		ifs.seekg(0, std::ios::beg);
+		return true;
+	}
+
+	// ソースがアリーナ上にある前提でドキュメントを作る
+	void ParseIntoDocument(std::string_view source, JsonParser::DocumentResult& result) {
+		DocumentBuilder builder(result.document, true);
+		Parser<DocumentBuilder> parser(source, builder);
+		JsonNode root;
+		if (parser.ParseRoot(root)) {
+			result.document.SetRoot(root);
+			result.success = true;
+			result.status = JsonParser::Status::Ok;
+		} else {
+			FillError(result, parser);
+			result.document.Reset();
+		}
+	}
+
 } // namespace
 
+bool JsonParser::ReadFile(const std::string& filePath, std::string& out) {
+	std::ifstream ifs;
+	size_t size = 0;
+	if (!OpenSized(filePath, ifs, size)) return false;
+	out.resize(size);
+	if (size > 0 && !ifs.read(out.data(), static_cast<std::streamsize>(size))) return false;
+	return true;
+}
+
 JsonParser::Result JsonParser::Parse(std::string_view source) {
 	Result result;
-	Parser parser(source);
-	try {
-		result.value = parser.ParseRoot();
+	ValueBuilder builder;
+	Parser<ValueBuilder> parser(source, builder);
+	if (parser.ParseRoot(result.value)) {
 		result.success = true;
-	} catch (const ParseError& e) {
-		result.success = false;
-		result.errorMessage = e.message;
-		result.errorLine = parser.Line();
-		result.errorColumn = parser.Column();
+	} else {
+		result.value = JsonValue();
+		FillError(result, parser);
 	}
 	return result;
 }
 
 JsonParser::Result JsonParser::ParseFile(const std::string& filePath) {
-	std::ifstream ifs(filePath, std::ios::binary);
-	if (!ifs) {
-		Result result;
-		result.success = false;
-		result.errorMessage = "Failed to open file: " + filePath;
-		return result;
+	std::string source;
+	if (!ReadFile(filePath, source)) {
+		return OpenFailed<Result>(filePath);
+	}
+	return Parse(source);
+}
+
+JsonParser::DocumentResult JsonParser::ParseDocument(std::string_view source) {
+	DocumentResult result;
+	// ソースの写し + ノード・キー索引でおおむねソースの 3 倍に収まるので、最初のブロックをその大きさにする
+	result.document.Reset(source.size() * 3);
+	char* text = result.document.AllocateChars(source.size());
+	if (!source.empty()) {
+		std::memcpy(text, source.data(), source.size());
+	}
+	ParseIntoDocument(std::string_view(text, source.size()), result);
+	return result;
+}
+
+JsonParser::DocumentResult JsonParser::ParseDocumentFile(const std::string& filePath) {
+	std::ifstream ifs;
+	size_t size = 0;
+	if (!OpenSized(filePath, ifs, size)) {
+		return OpenFailed<DocumentResult>(filePath);
+	}
+	// 中間バッファを介さずアリーナへ直接読み込む
+	DocumentResult result;
+	result.document.Reset(size * 3);
+	char* text = result.document.AllocateChars(size);
+	if (size > 0 && !ifs.read(text, static_cast<std::streamsize>(size))) {
+		return OpenFailed<DocumentResult>(filePath);
+	}
+	ParseIntoDocument(std::string_view(text, size), result);
+	return result;
+}
+
+JsonParser::SaxResult JsonParser::ParseSax(std::string_view source, Handler& handler) {
+	SaxResult result;
+	SaxBuilder builder(handler);
+	Parser<SaxBuilder> parser(source, builder);
+	NoValue root;
+	if (parser.ParseRoot(root)) {
+		result.success = true;
+	} else {
+		FillError(result, parser);
+	}
+	return result;
+}
+
+JsonParser::SaxResult JsonParser::ParseSaxFile(const std::string& filePath, Handler& handler) {
+	std::string source;
+	if (!ReadFile(filePath, source)) {
+		return OpenFailed<SaxResult>(filePath);
 	}
-	std::ostringstream oss;
-	oss << ifs.rdbuf();
-	return Parse(oss.str());
+	return ParseSax(source, handler);
 }
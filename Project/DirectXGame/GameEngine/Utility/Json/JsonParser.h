@@ -1,24 +1,78 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
+#include "JsonDocument.h"
 #include "JsonValue.h"
 
 /// <summary>
 /// JSONパーサ
 /// 純JSON仕様 + 拡張として // 行コメントと / * ブロックコメント * / を許容する
+/// 例外は使わず、失敗は Status と行・列で返す。空白・文字列の走査は SSE2 で 16 byte ずつ進める。
 /// </summary>
 class JsonParser {
 public:
+	/// <summary>
+	/// パース結果の種別
+	/// </summary>
+	enum class Status {
+		Ok,
+		OpenFailed,    // ファイルを開けない
+		SyntaxError,   // JSON として不正（errorMessage / errorLine / errorColumn に詳細）
+		Aborted,       // SAX ハンドラが false を返して打ち切った
+	};
+
 	struct Result {
 		bool success = false;
+		Status status = Status::Ok;
 		JsonValue value;
 		std::string errorMessage;
 		size_t errorLine = 0;
 		size_t errorColumn = 0;
 	};
 
+	struct DocumentResult {
+		bool success = false;
+		Status status = Status::Ok;
+		JsonDocument document;
+		std::string errorMessage;
+		size_t errorLine = 0;
+		size_t errorColumn = 0;
+	};
+
+	struct SaxResult {
+		bool success = false;
+		Status status = Status::Ok;
+		std::string errorMessage;
+		size_t errorLine = 0;
+		size_t errorColumn = 0;
+	};
+
+	/// <summary>
+	/// SAX 形式のイベント受け取り口。木を作らずに値を順に受け取る（大きいシーン・ウェーブ用）
+	/// どのコールバックも false を返すとそこでパースを打ち切る（Status::Aborted）。
+	/// 文字列・キーの string_view はコールバック中だけ有効。
+	/// </summary>
+	class Handler {
+	public:
+		virtual ~Handler() = default;
+
+		virtual bool OnNull() { return true; }
+		virtual bool OnBool(bool) { return true; }
+		virtual bool OnInt(int64_t) { return true; }
+		virtual bool OnDouble(double) { return true; }
+		virtual bool OnString(std::string_view) { return true; }
+
+		virtual bool OnStartObject() { return true; }
+		virtual bool OnKey(std::string_view) { return true; }
+		virtual bool OnEndObject(size_t /*memberCount*/) { return true; }
+
+		virtual bool OnStartArray() { return true; }
+		virtual bool OnEndArray(size_t /*itemCount*/) { return true; }
+	};
+
 	/// <summary>
 	/// 文字列からパース
 	/// </summary>
@@ -28,4 +82,30 @@ public:
 	/// ファイルから読み込んでパース
 	/// </summary>
 	static Result ParseFile(const std::string& filePath);
+
+	/// <summary>
+	/// 文字列から読み取り専用のアリーナ木へパース（読み込むだけの用途はこちら）
+	/// ソースをアリーナへ写し、エスケープを含まない文字列はその上を直接指す
+	/// </summary>
+	static DocumentResult ParseDocument(std::string_view source);
+
+	/// <summary>
+	/// ファイルをアリーナへ直接読み込んでパース
+	/// </summary>
+	static DocumentResult ParseDocumentFile(const std::string& filePath);
+
+	/// <summary>
+	/// 木を作らずにイベントを handler へ流す
+	/// </summary>
+	static SaxResult ParseSax(std::string_view source, Handler& handler);
+
+	/// <summary>
+	/// ファイルを読み込んでイベントを handler へ流す
+	/// </summary>
+	static SaxResult ParseSaxFile(const std::string& filePath, Handler& handler);
+
+	/// <summary>
+	/// ファイル全体を読み込む（ostringstream を経由せずにサイズ分を一度に読む）
+	/// </summary>
+	static bool ReadFile(const std::string& filePath, std::string& out);
 };
@@ -1,11 +1,18 @@
 #include "SessionLogger.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <filesystem>
+#include <vector>
 
 #include "CrashHandler.h"
+#include "LogBuffer.h"
 
 namespace {
     // カテゴリ → ファイル名 / レコード上の表記
@@ -47,7 +54,7 @@ namespace {
         }
     }
 
-    // HH:MM:SS.mmm
+    // HH:MM:SS.mmm（ベンチマークの旧方式用。本体の書き込みスレッドは秒単位でキャッシュして整形する）
     std::string TimeStamp() {
         const auto now = std::chrono::system_clock::now();
         const auto t = std::chrono::system_clock::to_time_t(now);
@@ -73,6 +80,16 @@ namespace {
         oss << std::put_time(&lt, "%Y-%m-%d_%H%M%S");
         return oss.str();
     }
+
+    // 書き込みスレッドが 1 回に取り出す最大レコード数（この単位でファイルへ書いて flush する）
+    constexpr size_t kDrainBatch = 1024;
+    // リングが空のときに書き込みスレッドが眠る時間
+    constexpr auto kWriterIdleWait = std::chrono::milliseconds(4);
+    // リングが埋まっていたときに呼び出し側が待つ上限（Warn 以上は長めに待つ）
+    constexpr auto kBackPressureWaitUrgent = std::chrono::microseconds(2000);
+    constexpr auto kBackPressureWait = std::chrono::microseconds(50);
+    // クラッシュ時、書き込みスレッドのバッチが終わるのを待つ上限（ミリ秒）
+    constexpr int kCrashDrainWaitMs = 100;
 }
 
 SessionLogger& SessionLogger::Instance() {
@@ -85,8 +102,8 @@ SessionLogger::~SessionLogger() {
 }
 
 void SessionLogger::Initialize() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (initialized_) {
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (writer_.joinable()) {
         return;
     }
 
@@ -96,68 +113,396 @@ void SessionLogger::Initialize() {
 #else
     const Level defaultLevel = Level::Critical;
 #endif
-    minLevels_.fill(defaultLevel);
+    for (auto& minLevel : minLevels_) {
+        minLevel.store(static_cast<int>(defaultLevel), std::memory_order_relaxed);
+    }
 
     sessionDir_ = std::string("Logs/") + FolderStamp();
+    Open(sessionDir_);
+
+    // クラッシュダンプの出力先を、このセッションフォルダに向ける
+    CrashHandler::SetDumpDir(sessionDir_);
+}
 
+void SessionLogger::Open(const std::string& dir) {
     std::error_code ec;
-    std::filesystem::create_directories(sessionDir_, ec);
+    std::filesystem::create_directories(dir, ec);
 
     for (size_t i = 0; i < kCategoryCount; ++i) {
         const std::string path =
-            sessionDir_ + "/" + CategoryFileName(static_cast<Category>(i));
+            dir + "/" + CategoryFileName(static_cast<Category>(i));
         files_[i].open(path, std::ios::out | std::ios::trunc);
     }
 
-    // クラッシュダンプの出力先を、このセッションフォルダに向ける
-    CrashHandler::SetDumpDir(sessionDir_);
+    // スロット i の sequence = i が「空き（pos = i で書ける）」状態
+    if (!ring_) {
+        ring_ = std::make_unique<Record[]>(kRingCapacity);
+    }
+    for (size_t i = 0; i < kRingCapacity; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePos_.store(0, std::memory_order_relaxed);
+    dequeuePos_ = 0;
+    writtenPos_.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < kCategoryCount; ++i) {
+        dropped_[i].store(0, std::memory_order_relaxed);
+        reportedDropped_[i] = 0;
+    }
+    cachedSecond_ = -1;
+
+    stopping_.store(false, std::memory_order_relaxed);
+    writer_ = std::thread(&SessionLogger::WriterMain, this);
+    accepting_.store(true, std::memory_order_release);
+}
 
-    initialized_ = true;
+bool SessionLogger::IsEnabled(Category category, Level level) const {
+    // 「出力する最低レベル」より深刻でない(=値が大きい)ものは捨てる
+    return accepting_.load(std::memory_order_acquire)
+        && static_cast<int>(level) <= minLevels_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
 }
 
-void SessionLogger::Write(Category category, Level level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!initialized_) {
+void SessionLogger::Write(Category category, Level level, std::string_view message) {
+    if (!IsEnabled(category, level)) {
         return;
     }
+    Enqueue(category, level, message);
+}
 
-    const size_t idx = static_cast<size_t>(category);
-    // 「出力する最低レベル」より深刻でない(=値が大きい)ものは捨てる
-    if (static_cast<int>(level) > static_cast<int>(minLevels_[idx])) {
+void SessionLogger::Writef(Category category, Level level, const char* format, ...) {
+    if (!IsEnabled(category, level)) {
         return;
     }
 
-    std::ofstream& out = files_[idx];
-    if (!out.is_open()) {
+    // 上限 + "..." ぶん余分に整形しておけば、切り詰めが必要かどうかを Enqueue 側で判定できる
+    char buffer[kMaxMessageLength + 4];
+    va_list args;
+    va_start(args, format);
+    const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) {
         return;
     }
+    Enqueue(category, level, std::string_view(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)));
+}
 
+void SessionLogger::Enqueue(Category category, Level level, std::string_view message) {
     // 末尾の改行は1行1レコードの整形のため取り除く
-    std::string body = message;
-    while (!body.empty() && (body.back() == '\n' || body.back() == '\r')) {
-        body.pop_back();
+    while (!message.empty() && (message.back() == '\n' || message.back() == '\r')) {
+        message.remove_suffix(1);
+    }
+    const int64_t now = std::chrono::system_clock::now().time_since_epoch().count();
+    const size_t idx = static_cast<size_t>(category);
+
+    // 空きスロットを 1 つ確保する。埋まっていれば書き込みスレッドを起こして上限まで待ち、ダメなら捨てる
+    Record* slot = nullptr;
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    std::chrono::steady_clock::time_point deadline{};
+    bool waiting = false;
+    for (;;) {
+        Record& record = ring_[pos & (kRingCapacity - 1)];
+        const uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot = &record;
+                break;
+            }
+        } else if (diff < 0) {
+            // 1 周前のレコードがまだ書き出されていない＝満杯
+            const auto current = std::chrono::steady_clock::now();
+            if (!waiting) {
+                waiting = true;
+                deadline = current + ((level <= Level::Warn) ? kBackPressureWaitUrgent : kBackPressureWait);
+                wakeCv_.notify_one();
+            } else if (current >= deadline) {
+                dropped_[idx].fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        } else {
+            // 他の生産者に先を越された
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t length = message.size();
+    if (length > kMaxMessageLength) {
+        length = kMaxMessageLength;
+        std::memcpy(slot->text, message.data(), length - 3);
+        std::memcpy(slot->text + length - 3, "...", 3);
+    } else {
+        std::memcpy(slot->text, message.data(), length);
+    }
+    slot->time = now;
+    slot->category = static_cast<uint8_t>(category);
+    slot->level = static_cast<uint8_t>(level);
+    slot->length = static_cast<uint16_t>(length);
+
+    // 書き込み済みにする（消費側は sequence == pos + 1 を見て取り出す）
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+size_t SessionLogger::DrainLocked() {
+    // system_clock の生カウント → "HH:MM:SS.mmm "（秒が変わったときだけ localtime を呼ぶ）
+    auto appendTime = [this](std::string& out, int64_t rawTime) {
+        const std::chrono::system_clock::time_point tp{ std::chrono::system_clock::duration(rawTime) };
+        const auto sinceEpoch = tp.time_since_epoch();
+        const int64_t second = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count();
+        const int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000);
+        if (second != cachedSecond_) {
+            const std::time_t t = std::chrono::system_clock::to_time_t(tp);
+            std::tm lt;
+            localtime_s(&lt, &t);
+            std::strftime(cachedClock_, sizeof(cachedClock_), "%H:%M:%S", &lt);
+            cachedSecond_ = second;
+        }
+        const char msText[5] = { '.', static_cast<char>('0' + ms / 100), static_cast<char>('0' + ms / 10 % 10),
+            static_cast<char>('0' + ms % 10), ' ' };
+        out.append(cachedClock_).append(msText, sizeof(msText));
+    };
+
+    size_t count = 0;
+    for (; count < kDrainBatch; ++count) {
+        Record& record = ring_[dequeuePos_ & (kRingCapacity - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            break;  // 空、または確保済みでまだ書き込み中
+        }
+
+        const Category category = static_cast<Category>(record.category);
+        std::string& out = batches_[record.category];
+        appendTime(out, record.time);
+        out.append(CategoryTag(category)).append(1, ' ')
+            .append(LevelTag(static_cast<Level>(record.level))).append(1, ' ')
+            .append(record.text, record.length).append(1, '\n');
+
+        // スロットを次の周回の生産者に返す
+        record.sequence.store(dequeuePos_ + kRingCapacity, std::memory_order_release);
+        ++dequeuePos_;
+    }
+
+    // 前回から増えたドロップ数をそのカテゴリのファイルに残す（SUNDAY が欠落区間を判別できるように）
+    for (size_t i = 0; i < kCategoryCount; ++i) {
+        const uint64_t dropped = dropped_[i].load(std::memory_order_relaxed);
+        if (dropped == reportedDropped_[i]) {
+            continue;
+        }
+        char line[96];
+        std::snprintf(line, sizeof(line), "dropped=%llu total_dropped=%llu reason=log_queue_full\n",
+            static_cast<unsigned long long>(dropped - reportedDropped_[i]),
+            static_cast<unsigned long long>(dropped));
+        appendTime(batches_[i], std::chrono::system_clock::now().time_since_epoch().count());
+        batches_[i].append(CategoryTag(static_cast<Category>(i))).append(" WARN ").append(line);
+        reportedDropped_[i] = dropped;
+    }
+
+    // カテゴリごとにまとめて書いて 1 回だけ flush
+    for (size_t i = 0; i < kCategoryCount; ++i) {
+        std::string& batch = batches_[i];
+        if (batch.empty()) {
+            continue;
+        }
+        if (files_[i].is_open()) {
+            files_[i].write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            files_[i].flush();
+        }
+        batch.clear();
     }
 
-    out << TimeStamp() << ' ' << CategoryTag(category) << ' '
-        << LevelTag(level) << ' ' << body << '\n';
-    out.flush();
+    writtenPos_.store(dequeuePos_, std::memory_order_release);
+    return count;
+}
+
+void SessionLogger::WriterMain() {
+    for (;;) {
+        size_t drained = 0;
+        if (!consumerBusy_.exchange(true, std::memory_order_acquire)) {
+            drained = DrainLocked();
+            consumerBusy_.store(false, std::memory_order_release);
+        }
+        if (drained > 0) {
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCv_.wait_for(lock, kWriterIdleWait);
+    }
+
+    // 停止前に積まれていた残りを書き切る
+    if (!consumerBusy_.exchange(true, std::memory_order_acquire)) {
+        while (DrainLocked() > 0) {}
+        consumerBusy_.store(false, std::memory_order_release);
+    }
 }
 
 void SessionLogger::SetCategoryLevel(Category category, Level minLevel) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    minLevels_[static_cast<size_t>(category)] = minLevel;
+    minLevels_[static_cast<size_t>(category)].store(static_cast<int>(minLevel), std::memory_order_relaxed);
 }
 
-void SessionLogger::Finalize() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!initialized_) {
+void SessionLogger::Flush() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    const uint64_t target = enqueuePos_.load(std::memory_order_acquire);
+    while (writtenPos_.load(std::memory_order_acquire) < target) {
+        wakeCv_.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void SessionLogger::DrainForCrash() {
+    if (!ring_ || !writer_.joinable()) {
         return;
     }
+    // 書き込みスレッドがバッチを書いている途中なら終わるのを少し待つ。
+    // クラッシュしたのが書き込みスレッド自身（＝ファイル書き込み中に落ちた）なら取れないので諦める
+    for (int waited = 0; consumerBusy_.exchange(true, std::memory_order_acquire); ++waited) {
+        if (waited >= kCrashDrainWaitMs) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    while (DrainLocked() > 0) {}
+    // プロセスはこのまま終了するので consumerBusy_ は戻さない（書き込みスレッドと交互に書かせない）
+}
+
+uint64_t SessionLogger::GetDroppedCount() const {
+    uint64_t total = 0;
+    for (const auto& dropped : dropped_) {
+        total += dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void SessionLogger::Close() {
+    accepting_.store(false, std::memory_order_release);
+    stopping_.store(true, std::memory_order_release);
+    wakeCv_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
     for (auto& f : files_) {
         if (f.is_open()) {
             f.flush();
             f.close();
         }
     }
-    initialized_ = false;
+}
+
+void SessionLogger::Finalize() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (!writer_.joinable()) {
+        return;
+    }
+    Close();
+}
+
+void SessionLogger::RunThroughputBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const int kRecordsPerThread = 20000;
+    const unsigned kThreadCounts[] = { 1, 4 };
+
+    const std::string& sessionDir = Instance().GetSessionDir();
+    const std::string benchDir = (sessionDir.empty() ? std::string("Logs") : sessionDir) + "/logger_bench";
+
+    struct Result {
+        double recordsPerSec = 0.0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+    };
+    // threadCount 本の生産者が writeOne(thread, i) を kRecordsPerThread 回ずつ呼び、1 回ごとの所要時間を取る。
+    // finish はディスクに書き終わるまで待つ処理（旧方式は呼び出し中に書くので空）
+    auto run = [&](unsigned threadCount, const auto& writeOne, const auto& finish) {
+        std::vector<std::vector<float>> latencies(threadCount);
+        std::atomic<bool> go{ false };
+        std::vector<std::thread> producers;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            producers.emplace_back([&, t]() {
+                std::vector<float>& samples = latencies[t];
+                samples.reserve(kRecordsPerThread);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < kRecordsPerThread; ++i) {
+                    const auto t0 = Clock::now();
+                    writeOne(t, i);
+                    samples.push_back(std::chrono::duration<float, std::micro>(Clock::now() - t0).count());
+                }
+            });
+        }
+        const auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        finish();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<float> all;
+        for (const auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        Result result;
+        result.recordsPerSec = (seconds > 0.0) ? static_cast<double>(all.size()) / seconds : 0.0;
+        auto percentile = [&all](double p) {
+            const size_t k = std::min(all.size() - 1, static_cast<size_t>(p * static_cast<double>(all.size())));
+            std::nth_element(all.begin(), all.begin() + k, all.end());
+            return static_cast<double>(all[k]);
+        };
+        result.p50Us = percentile(0.50);
+        result.p99Us = percentile(0.99);
+        return result;
+    };
+
+    LogBuffer::Instance().Add("[SessionLogger] Throughput benchmark (mutex + flush per record vs ring + writer thread)");
+    for (unsigned threadCount : kThreadCounts) {
+        // 旧方式: 呼び出し側で std::string を組み立て、mutex の中で時刻整形・書き込み・flush
+        Result legacy;
+        {
+            std::mutex mutex;
+            std::filesystem::create_directories(benchDir + "/legacy");
+            std::ofstream out(benchDir + "/legacy/state.log", std::ios::out | std::ios::trunc);
+            legacy = run(threadCount, [&](unsigned t, int i) {
+                const std::string message = "frame=" + std::to_string(i)
+                    + " x=" + std::to_string(0.5f * i) + " y=" + std::to_string(1.0f) + " z=" + std::to_string(-0.25f * t)
+                    + " hp=" + std::to_string(100) + "/" + std::to_string(100) + " scene=STAGEPLAY";
+                std::lock_guard<std::mutex> lock(mutex);
+                std::string body = message;
+                out << TimeStamp() << ' ' << "STATE" << ' ' << "TRACE" << ' ' << body << '\n';
+                out.flush();
+            }, []() {});
+        }
+
+        // 新方式: Writef でスロットへ直接整形し、書き込みスレッドがまとめて書く
+        Result async;
+        uint64_t dropped = 0;
+        {
+            SessionLogger logger;
+            for (auto& minLevel : logger.minLevels_) {
+                minLevel.store(static_cast<int>(Level::Trace), std::memory_order_relaxed);
+            }
+            logger.Open(benchDir + "/async");
+            async = run(threadCount, [&](unsigned t, int i) {
+                logger.Writef(Category::State, Level::Trace, "frame=%d x=%f y=%f z=%f hp=%d/%d scene=%s",
+                    i, 0.5f * i, 1.0f, -0.25f * t, 100, 100, "STAGEPLAY");
+            }, [&]() { logger.Flush(); });
+            dropped = logger.GetDroppedCount();
+            logger.Close();
+            // 秒間レコード数は実際にファイルへ書けたぶんで数える
+            const double total = static_cast<double>(threadCount) * kRecordsPerThread;
+            async.recordsPerSec *= (total - static_cast<double>(dropped)) / total;
+        }
+
+        char buf[256];
+        std::snprintf(buf, sizeof(buf),
+            "[SessionLogger] %u thread(s) x %d  legacy %.0f rec/s p50 %.2fus p99 %.2fus | async %.0f rec/s p50 %.2fus p99 %.2fus dropped %llu",
+            threadCount, kRecordsPerThread, legacy.recordsPerSec, legacy.p50Us, legacy.p99Us,
+            async.recordsPerSec, async.p50Us, async.p99Us, static_cast<unsigned long long>(dropped));
+        LogBuffer::Instance().Add(buf);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(benchDir, ec);
 }
@@ -1,8 +1,14 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 /// <summary>
 /// セッション単位のファイルログ基盤（シングルトン）。
@@ -10,6 +16,11 @@
 /// カテゴリ別ファイル（input/state/event/gfx/error/session）を出力する。
 /// 1行1レコード形式: "HH:MM:SS.mmm CAT LEVEL message"
 /// S.U.N.D.A.Y. が追尾・解析することを前提にした設計。
+///
+/// 呼び出し側は固定長スロットのリングバッファ（複数生産者・ロックなし）にレコードを積むだけで、
+/// 時刻の整形・ファイル書き込み・flush は専用の書き込みスレッドがまとめて行う。
+/// リングが埋まったときは短時間だけ待ち（深刻なレベルほど長く待つ）、それでも空かなければ
+/// そのレコードを捨ててカテゴリごとのドロップ数に数える（ドロップ数は次のバッチで同じファイルに記録する）。
 /// </summary>
 class SessionLogger {
 public:
@@ -39,21 +50,37 @@ public:
         Trace
     };
 
+    /// <summary>
+    /// 1レコードの本文の最大バイト数。超えた分は切り詰めて末尾を "..." にする。
+    /// </summary>
+    static constexpr size_t kMaxMessageLength = 480;
+
     /// <summary>
     /// シングルトンインスタンスの取得
     /// </summary>
     static SessionLogger& Instance();
 
     /// <summary>
-    /// セッションフォルダを作成し各カテゴリのファイルを開く。
+    /// セッションフォルダを作成し各カテゴリのファイルを開き、書き込みスレッドを起動する。
     /// Framework::Initialize の最初に1回だけ呼ぶ。
     /// </summary>
     void Initialize();
 
     /// <summary>
     /// 1レコード出力。カテゴリ別の最低レベルで間引かれる。
+    /// 本文はリングのスロットへコピーするだけなので、呼び出し側でのヒープ確保は不要。
     /// </summary>
-    void Write(Category category, Level level, const std::string& message);
+    void Write(Category category, Level level, std::string_view message);
+
+    /// <summary>
+    /// printf 形式で 1レコード出力する（スタック上で整形してから積む。std::string を組み立てない）。
+    /// </summary>
+    void Writef(Category category, Level level, const char* format, ...);
+
+    /// <summary>
+    /// そのカテゴリ・レベルのレコードが出力対象か（重い整形を呼び出し側で省くための事前判定）。
+    /// </summary>
+    bool IsEnabled(Category category, Level level) const;
 
     /// <summary>
     /// カテゴリごとの「出力する最低レベル」を設定する。
@@ -62,16 +89,40 @@ public:
     void SetCategoryLevel(Category category, Level minLevel);
 
     /// <summary>
-    /// 全ファイルを flush して閉じる。Framework::Finalize で呼ぶ。
+    /// 呼び出し時点までに積まれたレコードがファイルに書かれるまで待つ。
+    /// </summary>
+    void Flush();
+
+    /// <summary>
+    /// クラッシュ時用。ロックを取らずにリングに残っているレコードを呼び出しスレッドで書き出す。
+    /// 書き込みスレッドが書き込み中のまま止まっている場合は、一定時間待って諦める。
+    /// CrashHandler のトップレベル例外フィルタから呼ぶ。
+    /// </summary>
+    void DrainForCrash();
+
+    /// <summary>
+    /// 書き込みスレッドを止め、残りを書き出して全ファイルを閉じる。Framework::Finalize で呼ぶ。
     /// </summary>
     void Finalize();
 
+    /// <summary>
+    /// リングが埋まって捨てたレコードの累計（全カテゴリ合計）。
+    /// </summary>
+    uint64_t GetDroppedCount() const;
+
     /// <summary>
     /// 今回のセッションフォルダパス（例: "Logs/2026-06-11_212430"）。
     /// 未初期化なら空文字。
     /// </summary>
     const std::string& GetSessionDir() const { return sessionDir_; }
 
+    /// <summary>
+    /// 旧方式（mutex + 1レコードごとの flush）とリング＋書き込みスレッド方式で、
+    /// 生産者スレッド数を変えて秒間レコード数と呼び出し側レイテンシ（p50/p99）を LogBuffer に出す。
+    /// 出力はセッションフォルダ配下の一時フォルダに書き、終わったら消す。
+    /// </summary>
+    static void RunThroughputBenchmark();
+
 private:
     SessionLogger() = default;
     ~SessionLogger();
@@ -79,10 +130,49 @@ private:
     SessionLogger& operator=(const SessionLogger&) = delete;
 
     static constexpr size_t kCategoryCount = static_cast<size_t>(Category::kCount);
+    static constexpr size_t kRingCapacity = 16384;  // 2 の累乗（約 500 byte × 16384 ≒ 8MB）
+
+    // リングの 1 スロット。sequence でスロットの状態（空き / 書き込み済み）を表す
+    struct Record {
+        std::atomic<uint64_t> sequence{ 0 };
+        int64_t time = 0;                // system_clock の生カウント（整形は書き込みスレッド）
+        uint8_t category = 0;
+        uint8_t level = 0;
+        uint16_t length = 0;
+        char text[kMaxMessageLength] = {};
+    };
+
+    // dir にカテゴリ別ファイルを開き、リングを初期化して書き込みスレッドを起動する
+    void Open(const std::string& dir);
+    // 書き込みスレッドを止めて残りを書き出し、ファイルを閉じる
+    void Close();
+    // リングに 1 レコード積む（埋まっていれば待つか捨てる）
+    void Enqueue(Category category, Level level, std::string_view message);
+    // リングから取れるだけ取ってファイルへ書く（consumerBusy_ を持っているスレッドだけが呼ぶ）
+    size_t DrainLocked();
+    void WriterMain();
 
     std::string sessionDir_;
     std::array<std::ofstream, kCategoryCount> files_;
-    std::array<Level, kCategoryCount> minLevels_;
-    bool initialized_ = false;
-    mutable std::mutex mutex_;
+    std::array<std::atomic<int>, kCategoryCount> minLevels_{};
+    std::atomic<bool> accepting_{ false };   // Write を受け付けるか
+    std::mutex lifecycleMutex_;              // Initialize / Finalize 同士の排他（Write は取らない）
+
+    // ----- リング（複数生産者 / 単一消費者） -----
+    std::unique_ptr<Record[]> ring_;
+    alignas(64) std::atomic<uint64_t> enqueuePos_{ 0 };
+    alignas(64) uint64_t dequeuePos_ = 0;    // consumerBusy_ を持っているスレッドだけが触る
+    std::atomic<uint64_t> writtenPos_{ 0 };  // ファイルへ書き終えたところ（Flush 用）
+    std::atomic<bool> consumerBusy_{ false };
+    std::array<std::atomic<uint64_t>, kCategoryCount> dropped_{};
+    std::array<uint64_t, kCategoryCount> reportedDropped_{};  // ファイルに記録済みのドロップ数
+
+    // ----- 書き込みスレッド -----
+    std::thread writer_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::atomic<bool> stopping_{ false };
+    std::array<std::string, kCategoryCount> batches_;  // カテゴリごとの書き込み待ち（書き込みスレッド専用）
+    int64_t cachedSecond_ = -1;                         // 時刻整形のキャッシュ（秒が変わったときだけ localtime）
+    char cachedClock_[16] = {};
 };
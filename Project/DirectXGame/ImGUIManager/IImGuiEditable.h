@@ -56,6 +56,14 @@ public:
     //====================
     uint8_t GetObjectId() const { return objectId_; }
 
+    //====================
+    // ゲーム側サイドテーブルのスロット（不透明な 64bit 値、0 = 未割当）。
+    // ゲーム側（Gameplay）がエンティティ→コンポーネントをハッシュ無しで引くために書き込む。
+    // エンジン基底は値の意味を知らない。
+    //====================
+    uint64_t GetSideTableSlot() const { return sideTableSlot_; }
+    void SetSideTableSlot(uint64_t slot) { sideTableSlot_ = slot; }
+
     /// <summary>Inspectorでの編集UIを描画</summary>
     virtual void OnImGuiInspector() = 0;
 
@@ -85,6 +93,8 @@ protected:
     uint8_t objectId_ = 0;
 
 private:
+    uint64_t sideTableSlot_ = 0;
+
     // 生成/破棄フック（ゲーム側が SetHooks で登録）
     static LifecycleHook s_onConstructed;
     static LifecycleHook s_onDestroyed;
@@ -22,6 +22,8 @@
 #include "GPUParticleManager.h"
 #include "Effect/EffectManager.h"
 #include "Effect/EffectEditorWindow.h"
+#include "Effect/EffectCurveLut.h"
+#include "Effect/LightningBatch.h"
 #include "EffectHierarchyWindow.h"
 #include "EffectPaletteWindow.h"
 #include "TransitionManager.h"
@@ -36,6 +38,20 @@
 #include "SceneManager.h"
 #include "Scene.h"
 #include "Components/CollisionManager.h"
+#include "Components/Gameplay.h"
+#include "Components/CookedDefsBenchmark.h"
+#include "Voronoi2D.h"
+#include "Skeleton.h"
+#include "AnimationCodec.h"
+#include "SessionLogger.h"
+#include "ReplayStream.h"
+#include "Json/JsonDocument.h"
+#include "TextureMips.h"
+#include "ParticlePool.h"
+#include "ParticleGroupTable.h"
+#ifdef USE_PEPPER
+#include "Profiler.h"
+#endif
 #include "TimeGroup.h"
 
 #include <dxgi.h>  // DXGI_FORMAT用
@@ -251,6 +267,88 @@ void ImGuiManager::Initialize(HWND hwnd, DirectXCore* dxCore, SRVManager* srvMan
             }
             ImGui::TextDisabled("- Tag-colored when not colliding");
             ImGui::TextDisabled("- Red when colliding this frame");
+
+            ImGui::Separator();
+            int mode = static_cast<int>(cm->GetBroadphaseMode());
+            const char* modeNames[] = { "Spatial Hash", "Brute Force" };
+            if (ImGui::Combo("Broadphase", &mode, modeNames, IM_ARRAYSIZE(modeNames))) {
+                cm->SetBroadphaseMode(static_cast<CollisionManager::BroadphaseMode>(mode));
+            }
+            float cellSize = cm->GetCellSize();
+            if (ImGui::DragFloat("Cell Size", &cellSize, 0.1f, 0.5f, 64.0f, "%.1f")) {
+                cm->SetCellSize(cellSize);
+            }
+            const auto& fs = cm->GetFrameStats();
+            const auto& bs = cm->GetBroadphaseStats();
+            ImGui::Text("Bodies: %u (swept %u)  Candidates: %u  Hits: %u", fs.bodies, fs.sweptBodies, fs.candidatePairs, fs.hits);
+            ImGui::Text("Cells: %u (skipped %u)  Large: %u", bs.bucketCount, bs.skippedBuckets, bs.largeProxyCount);
+            if (ImGui::Button("Run Broadphase Benchmark")) {
+                cm->RunBroadphaseBenchmark();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Run OBB-Capsule Benchmark")) {
+                cm->RunOBBCapsuleBenchmark();
+            }
+        }));
+    // 各システムのマイクロベンチマーク（結果は Log ウィンドウへ）
+    windows_.push_back(std::make_unique<CallbackWindow>("Benchmarks",
+        []() {
+            if (ImGui::Button("Gameplay Lookup (handle vs map)")) {
+                Gameplay::RunLookupBenchmark();
+            }
+            if (ImGui::Button("Voronoi Cells (grid vs brute force)")) {
+                Voronoi2D::RunBenchmark();
+            }
+            if (ImGui::Button("Animation Sampling (scan vs cursor)")) {
+                RunAnimationSamplingBenchmark();
+            }
+            if (ImGui::Button("Animation Codec (.anim v1 vs v2)")) {
+                RunAnimationCodecBenchmark();
+            }
+            if (ImGui::Button("Pose Evaluation (serial vs JobSystem)")) {
+                RunPoseEvaluationBenchmark();
+            }
+            if (ImGui::Button("Skeleton Layout (Joint AoS vs flat SoA)")) {
+                RunSkeletonLayoutBenchmark();
+            }
+            if (ImGui::Button("SessionLogger Throughput (sync vs async)")) {
+                SessionLogger::RunThroughputBenchmark();
+            }
+            if (ImGui::Button("Replay Stream (input.log vs input.rpl)")) {
+                RunReplayStreamBenchmark();
+            }
+#ifdef USE_PEPPER
+            if (ImGui::Button("Profiler Scope Overhead")) {
+                Profiler::RunOverheadBenchmark();
+            }
+#endif
+            if (ImGui::Button("Json Parse/Lookup (JsonValue / JsonDocument / SAX)")) {
+                RunJsonBenchmark();
+            }
+            if (ImGui::Button("Cooked Defs (JSON vs .defs)")) {
+                RunCookedDefsBenchmark();
+            }
+            if (ImGui::Button("Asset Pack (ifstream vs mmap)")) {
+                AssetLocator::RunPackBenchmark();
+            }
+            if (ImGui::Button("Texture Mips (Box / Kaiser, thread sweep)")) {
+                RunTextureMipBenchmark();
+            }
+            if (ImGui::Button("Effect Pool Stress (Hit_Small 1000/s, no pool vs pool)")) {
+                EffectManager::GetInstance()->StartStressBenchmark("Hit_Small");
+            }
+            if (ImGui::Button("Effect Curves (exact vs LUT vs SSE2 batch, error)")) {
+                RunEffectCurveBenchmark();
+            }
+            if (ImGui::Button("Lightning Bolts (MeshData vs direct write, thread sweep)")) {
+                RunLightningBoltBenchmark();
+            }
+            if (ImGui::Button("CPU Particles 10k/100k (list vs SoA SSE2)")) {
+                RunParticlePoolBenchmark();
+            }
+            if (ImGui::Button("GPU Particle Groups (name lookup vs handle)")) {
+                RunParticleGroupLookupBenchmark();
+            }
         }));
     windows_.push_back(std::make_unique<CallbackWindow>("TimeControler",
         [this]() {
@@ -121,6 +121,7 @@ void InspectorWindow::OnDraw() {
                     switch (c.shape) {
                     case ColliderShape::Sphere:
                         ImGui::DragFloat("Radius", &c.radius, 0.05f, 0.0f, 100.0f, "%.2f");
+                        ImGui::Checkbox("Continuous (Swept)", &c.continuous);
                         break;
                     case ColliderShape::OBB:
                         ImGui::DragFloat3("Half Extents", &c.halfExtents.x, 0.05f, 0.0f, 100.0f, "%.2f");
@@ -338,9 +339,9 @@ void InspectorWindow::OnDraw() {
                 if (anim && anim->HasSkeleton()) {
                     const Skeleton& sk = anim->GetSkeleton();
                     if (ImGui::BeginCombo("Bone", wp.bone.c_str())) {
-                        for (const auto& kv : sk.jointMap) {
-                            const bool bsel = (kv.first == wp.bone);
-                            if (ImGui::Selectable(kv.first.c_str(), bsel)) wp.bone = kv.first;
+                        for (const std::string& name : sk.names) {
+                            const bool bsel = (name == wp.bone);
+                            if (ImGui::Selectable(name.c_str(), bsel)) wp.bone = name;
                             if (bsel) ImGui::SetItemDefaultFocus();
                         }
                         ImGui::EndCombo();
@@ -363,7 +364,8 @@ void InspectorWindow::OnDraw() {
             if (showBulletSlots) {
                 sep();
                 ImGui::TextDisabled("Bullet Prefab Slots");
-                auto& bulletPrefabs = Gameplay::Of(selected).GetBulletPrefabs();
+                GameplayComponents& slotOwner = Gameplay::Of(selected);
+                auto& bulletPrefabs = slotOwner.GetBulletPrefabs();
                 // 弾スロットと近接スロット（攻撃スロットとして同じ map を流用）
                 const char* slotNames[8] = {
                     "normal", "charge1", "charge2",
@@ -378,11 +380,13 @@ void InspectorWindow::OnDraw() {
                     ImGui::SetNextItemWidth(200.0f);
                     if (ImGui::InputText("##bp", buf, sizeof(buf))) {
                         bulletPrefabs[slot] = buf;
+                        slotOwner.MarkBulletPrefabsEdited();
                     }
                     if (ImGui::BeginDragDropTarget()) {
                         if (const ImGuiPayload* p = ImGui::AcceptDragDropPayload(PREFAB_DROP_PAYLOAD_TYPE)) {
                             const auto* pld = static_cast<const PrefabDropPayload*>(p->Data);
                             bulletPrefabs[slot] = pld->prefabName;
+                            slotOwner.MarkBulletPrefabsEdited();
                         }
                         ImGui::EndDragDropTarget();
                     }
@@ -4,13 +4,15 @@
 #ifdef USE_PEPPER
 #include "Profiler.h"
 #include <cstdio>
+#include <string>
 #endif
 
 /// <summary>
 /// P.E.P.P.E.R. リアルタイム表示ウィンドウ（Unity プロファイラ風）。
 /// フレーム時間グラフ・区間テーブル(CPU/GPU)・カウンタ・メモリ/リソースゲージを表示する。
 /// 数値テーブルは直近1秒ウィンドウの集計（avg/max）＝毎秒更新で安定。
-/// グラフは毎フレームのフレーム時間。
+/// グラフは毎フレームのフレーム時間。区間はスレッドごとに分けて並ぶ。
+/// トレースの開始/停止で全区間のタイムラインを trace.json に書き出せる。
 /// 二重ガード: ImGui 本体は _DEBUG、計測データ読み出しは USE_PEPPER。
 /// </summary>
 class PepperWindow : public IImGuiWindow {
@@ -59,6 +61,27 @@ protected:
                 "OK (%.2f ms / %.1f fps)", frameMs, fps);
         }
 
+        // ===== トレース（chrome://tracing / Perfetto UI で開く trace.json）=====
+        if (p.IsTracing()) {
+            if (ImGui::Button("Stop Trace")) {
+                lastTracePath_ = p.StopTrace();
+            }
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.3f, 1.0f), "REC %zu events", p.GetTraceEventCount());
+        } else {
+            if (ImGui::Button("Start Trace")) {
+                p.StartTrace();
+            }
+            if (!lastTracePath_.empty()) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("%s", lastTracePath_.c_str());
+            }
+        }
+        if (p.GetDroppedEventCount() > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("| dropped %llu", static_cast<unsigned long long>(p.GetDroppedEventCount()));
+        }
+
         if (p.GetLiveWindowFrames() == 0) {
             ImGui::Separator();
             ImGui::TextDisabled("Collecting... (first 1s window not flushed yet)");
@@ -73,8 +96,9 @@ protected:
             const ImGuiTableFlags flags =
                 ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
                 ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
-            if (ImGui::BeginTable("pepper_sections", 5, flags, ImVec2(0, 230))) {
+            if (ImGui::BeginTable("pepper_sections", 6, flags, ImVec2(0, 230))) {
                 ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed, 80);
                 ImGui::TableSetupColumn("CPU ms", ImGuiTableColumnFlags_WidthFixed, 64);
                 ImGui::TableSetupColumn("GPU ms", ImGuiTableColumnFlags_WidthFixed, 64);
                 ImGui::TableSetupColumn("max ms", ImGuiTableColumnFlags_WidthFixed, 60);
@@ -93,19 +117,22 @@ protected:
                     ImGui::TextUnformatted(nameBuf);
 
                     ImGui::TableSetColumnIndex(1);
-                    DrawColoredMs(s.cpuAvgMs);
+                    ImGui::TextDisabled("%s", s.thread.c_str());
 
                     ImGui::TableSetColumnIndex(2);
+                    DrawColoredMs(s.cpuAvgMs);
+
+                    ImGui::TableSetColumnIndex(3);
                     if (s.gpuAvgMs > 0.0) {
                         ImGui::Text("%.3f", s.gpuAvgMs);
                     } else {
                         ImGui::TextDisabled("-");
                     }
 
-                    ImGui::TableSetColumnIndex(3);
+                    ImGui::TableSetColumnIndex(4);
                     ImGui::Text("%.3f", s.cpuMaxMs);
 
-                    ImGui::TableSetColumnIndex(4);
+                    ImGui::TableSetColumnIndex(5);
                     const double callsPerFrame =
                         (s.presentFrames > 0)
                         ? (static_cast<double>(s.totalCalls) / s.presentFrames)
@@ -170,6 +197,8 @@ private:
     static constexpr double kComfortFps_ = 60.0;
     static constexpr double kWarnFps_    = 50.0;
 
+    std::string lastTracePath_;  // 直近に書き出した trace.json
+
     // CPU ms を負荷に応じて色分け表示する。
     static void DrawColoredMs(double ms) {
         ImVec4 col(0.7f, 1.0f, 0.7f, 1.0f);      // 軽い: 緑
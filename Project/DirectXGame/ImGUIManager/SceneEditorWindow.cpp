@@ -9,6 +9,7 @@
 #include "Components/PrefabManager.h"
 #include "Components/Prefab.h"
 #include "Effect/EffectManager.h"
+#include "PepperMacros.h"
 
 #include <filesystem>
 #include <algorithm>
@@ -116,9 +117,13 @@ SceneEditorWindow::~SceneEditorWindow() {
 }
 
 void SceneEditorWindow::WorkerFunc() {
+    PEPPER_THREAD_NAME("SceneScan");
     // バックグラウンドスレッドでの例外はプロセス全体を落とすため try-catch で保護する
     try {
-        ScanModelsAndTextures();
+        {
+            PEPPER_SCOPE("SceneScan_Scan");
+            ScanModelsAndTextures();
+        }
         if (stopRequested_) return;
         scanDone_ = true;
 
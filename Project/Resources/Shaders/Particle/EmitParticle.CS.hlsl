@@ -40,7 +40,7 @@ struct EmitterSphere
     float  ringThickness; // Ring の太さ（円周まわりのランダム散らばり）
     float  lifeScaleStart;// 寿命開始時のサイズ倍率
     float  lifeScaleEnd;  // 寿命終了時のサイズ倍率
-    float  pad2;          // 16B境界合わせ
+    float  seedOffset;    // 乱数の種ずらし（同じフレームのバースト要求ごとに違う値。連続発射は 0）
     float4 rotRandomRange;// .xyz=出現時ランダム初期姿勢の各軸最大角（rad）
     float4 rotateSpeed;   // .xyz=各軸の角速度（rad/s）
 };
@@ -90,7 +90,7 @@ RWStructuredBuffer<uint> gFreeList : register(u2);
 void main(uint3 DTid : SV_DispatchThreadID)
 {
     RandomGenerator generator;
-    generator.seed = (float3(DTid) + gPerFrame.time) * gPerFrame.time;
+    generator.seed = (float3(DTid) + gPerFrame.time + gEmitter.seedOffset) * gPerFrame.time;
 
     if (gEmitter.emit != 0)
     {
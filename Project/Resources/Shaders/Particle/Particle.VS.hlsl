@@ -1,21 +1,30 @@
 #include "Particle.hlsli"
 
-struct ParticleForGPU
+// CPU Particle: 位置・スケール・回転・色だけ受け取り、WorldMatrix は VS で組む
+// （Scale → Rotate → Billboard → Translate。CPU 側の MakeRotateMatrix と同じ行ベクトル配置）
+
+struct ParticleInstance
 {
-    float4x4 WVP;
-    float4x4 World;
+    float3 translate;
+    uint billboardMode; // 0=None, 1=Full, 2=YAxis
+    float3 scale;
+    float padding0;
+    float3 rotate;
+    float padding1;
     float4 color;
 };
 
-StructuredBuffer<ParticleForGPU> gParticle : register(t0);
-
-struct Material
+struct PerView
 {
-    float4 color;
-    int enableLighting;
-    float4x4 uvTransform;
+    float4x4 viewProjection;
+    float4x4 billboardMatrix; // Full 用（CPU側で構築済み）
+    float3 cameraPosition;    // YAxis 用
+    float padding;
 };
 
+StructuredBuffer<ParticleInstance> gParticle : register(t0);
+ConstantBuffer<PerView> gPerView : register(b0);
+
 struct VertexShaderInput
 {
     float4 position : POSITION0;
@@ -23,12 +32,65 @@ struct VertexShaderInput
     float3 normal : NORMAL0;
 };
 
-VertexShaderOutput main(VertexShaderInput input,uint instanceId:SV_InstanceID)
+// MakeRotateMatrix(rotate) = Z * Y * X
+float3x3 MakeRotateXYZ(float3 r)
+{
+    float3 s = sin(r);
+    float3 c = cos(r);
+    float3x3 rx = float3x3(
+        1.0f, 0.0f, 0.0f,
+        0.0f, c.x,  s.x,
+        0.0f, -s.x, c.x);
+    float3x3 ry = float3x3(
+        c.y,  0.0f, -s.y,
+        0.0f, 1.0f, 0.0f,
+        s.y,  0.0f, c.y);
+    float3x3 rz = float3x3(
+        c.z,  s.z,  0.0f,
+        -s.z, c.z,  0.0f,
+        0.0f, 0.0f, 1.0f);
+    return mul(mul(rz, ry), rx);
+}
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
 {
     VertexShaderOutput output;
-    output.position = mul(input.position, gParticle[instanceId].WVP);
+    ParticleInstance particle = gParticle[instanceId];
+
+    // 自己回転（回転なしなら単位行列のまま）
+    float3x3 basis = float3x3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+    if (any(particle.rotate != 0.0f)) {
+        basis = MakeRotateXYZ(particle.rotate);
+    }
+
+    // ビルボード
+    if (particle.billboardMode == 1) {
+        basis = mul(basis, (float3x3) gPerView.billboardMatrix);
+    } else if (particle.billboardMode == 2) {
+        // YAxis：ワールドY軸固定で水平にカメラを向く
+        float fx = gPerView.cameraPosition.x - particle.translate.x;
+        float fz = gPerView.cameraPosition.z - particle.translate.z;
+        float len = sqrt(fx * fx + fz * fz);
+        if (len < 1e-5f) { fx = 0.0f; fz = 1.0f; }
+        else             { fx /= len; fz /= len; }
+        // forward=(fx,0,fz)、up=(0,1,0)、right=(fz,0,-fx)
+        float3x3 yAxis = float3x3(
+            fz,   0.0f, -fx,
+            0.0f, 1.0f, 0.0f,
+            fx,   0.0f, fz);
+        basis = mul(basis, yAxis);
+    }
+
+    // スケール（行ごと）
+    basis[0] *= particle.scale.x;
+    basis[1] *= particle.scale.y;
+    basis[2] *= particle.scale.z;
+
+    float3 worldPos = mul(input.position.xyz, basis) + particle.translate;
+    output.position = mul(float4(worldPos, 1.0f), gPerView.viewProjection);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float3x3) gParticle[instanceId].World));
-    output.color = gParticle[instanceId].color;
+    output.normal = normalize(mul(input.normal, basis));
+    output.color = particle.color;
+    output.dissolveLife = 0.0f;
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "Primitive.hlsli"
+
+// インスタンスごとの変換行列（SV_InstanceID で引く）。PS は Primitive.PS.hlsl を共用。
+StructuredBuffer<TransformationMatrix> gInstances : register(t0);
+
+VertexOutput main(VertexInput input, uint instanceId : SV_InstanceID)
+{
+    TransformationMatrix transform = gInstances[instanceId];
+    VertexOutput output;
+    output.position = mul(float4(input.position, 1.0f), transform.WVP);
+    output.texcoord = input.texcoord;
+    output.normal = normalize(mul(input.normal, (float3x3) transform.World));
+    output.color = input.color;
+    output.worldPos = mul(float4(input.position, 1.0f), transform.World).xyz;
+    return output;
+}
@@ -5,6 +5,7 @@
     python tools/Python/cook_assets.py            # 差分のみ変換
     python tools/Python/cook_assets.py --force    # 全再変換
     python tools/Python/cook_assets.py --dry-run  # 何も書き換えず予定だけ出力
+    python tools/Python/cook_assets.py --anim-v1  # .anim を旧 v1 形式で書き出す（既定は量子化 v2）
 
 ファイル拡張子別の処理:
     .png         → Resources/同パス/*.dds (BC7, texconv)         [Step 1 で実装]
@@ -21,6 +22,7 @@ from __future__ import annotations
 
 import argparse
 import json
+import math
 import struct
 import subprocess
 import sys
@@ -506,6 +508,27 @@ ANIM_VERSION = 1
 ANIM_HEADER_SIZE = 24
 ANIM_CHANNEL_SIZE = 64 + 6 * 4  # 88
 
+# ---- .anim v2（量子化＋キー削減。AnimationCodec.cpp と同じレイアウト）----
+# Channel: u8 name_len + name + Track(T) + Track(R) + Track(S)
+# Track:   u8 kind (下位 2bit: 0=空 1=定数 2=量子化 3=f32 値, bit2: 時刻を f32 で持つ)
+ANIM_VERSION_V2 = 2
+ANIM_TRACK_EMPTY = 0
+ANIM_TRACK_CONSTANT = 1
+ANIM_TRACK_QUANTIZED = 2
+ANIM_TRACK_RAW = 3
+ANIM_TRACK_FLOAT_TIME = 0x4
+ANIM_TIME_TOLERANCE = 0.0001        # 秒。超える長さのクリップは時刻を f32 で持つ
+ANIM_TOLERANCE_T = 1.0e-4           # 位置
+ANIM_TOLERANCE_R = 1.0e-3           # 回転（ラジアン）
+ANIM_TOLERANCE_S = 1.0e-4           # スケール
+ANIM_MAX_SEGMENT_KEYS = 256         # 1 区間で削れるキー数の上限
+ANIM_SMALLEST_THREE_RANGE = 0.70710678
+ANIM_QUAT_STEP = 32767
+ANIM_VEC3_STEP = 65535
+
+# 書き出す .anim のバージョン（--anim-v1 で 1 に戻せる）
+ANIM_WRITE_VERSION = ANIM_VERSION_V2
+
 # ============================================================
 # glTF 読み込みヘルパー
 # ============================================================
@@ -1089,6 +1112,168 @@ def _write_anim_v1(out_path: Path, anim: dict) -> None:
                 f.write(struct.pack("<f3f", t, *v))
 
 
+def _anim_vec3_error(a, b) -> float:
+    return max(abs(a[0] - b[0]), abs(a[1] - b[1]), abs(a[2] - b[2]))
+
+
+def _anim_quat_error(a, b) -> float:
+    """2 つの回転の角度差（ラジアン。q と -q は同じ回転）"""
+    d = min(1.0, abs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]))
+    return 2.0 * math.acos(d)
+
+
+def _anim_lerp3(a, b, t):
+    return tuple(a[i] + (b[i] - a[i]) * t for i in range(3))
+
+
+def _anim_slerp(a, b, t):
+    """Quaternion.cpp の Slerp と同じ（最短経路、近い向きは線形補間して正規化）"""
+    d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]
+    if d < 0.0:
+        b = tuple(-c for c in b)
+        d = -d
+    if d >= 1.0 - 0.0005:
+        r = tuple((1.0 - t) * a[i] + t * b[i] for i in range(4))
+        n = math.sqrt(sum(c * c for c in r)) or 1.0
+        return tuple(c / n for c in r)
+    theta = math.acos(d)
+    s = math.sin(theta)
+    k1 = math.sin((1.0 - t) * theta) / s
+    k2 = math.sin(t * theta) / s
+    return tuple(k1 * a[i] + k2 * b[i] for i in range(4))
+
+
+def _anim_reduce_keys(keys, tolerance, interp, error) -> list[int]:
+    """残すキーの index。区間 [a, b] で補間し直しても間のキーが許容値以内なら b を先へ伸ばす"""
+    count = len(keys)
+    kept = [0]
+    a, b = 0, 2
+    while b < count:
+        fits = (b - a) <= ANIM_MAX_SEGMENT_KEYS
+        span = keys[b][0] - keys[a][0]
+        j = a + 1
+        while fits and j < b:
+            t = (keys[j][0] - keys[a][0]) / span if span > 0.0 else 0.0
+            fits = error(interp(keys[a][1], keys[b][1], t), keys[j][1]) <= tolerance
+            j += 1
+        if fits:
+            b += 1
+        else:
+            a = b - 1
+            kept.append(a)
+            b = a + 2
+    if count > 1:
+        kept.append(count - 1)
+    return kept
+
+
+def _anim_quantize_unit(value: float, step: int) -> int:
+    return int(math.floor(min(max(value, 0.0), 1.0) * step + 0.5))
+
+
+def _anim_pack_quat(q) -> bytes:
+    """smallest-three: 最大成分を正にして落とし、残り 3 成分を 15bit ずつ詰めた 48bit"""
+    n = math.sqrt(sum(c * c for c in q)) or 1.0
+    c = [v / n for v in q]
+    largest = max(range(4), key=lambda i: abs(c[i]))
+    sign = -1.0 if c[largest] < 0.0 else 1.0
+    bits = largest << 45
+    shift = 30
+    rng = ANIM_SMALLEST_THREE_RANGE
+    for i in range(4):
+        if i == largest:
+            continue
+        u = (c[i] * sign + rng) / (2.0 * rng)
+        bits |= _anim_quantize_unit(u, ANIM_QUAT_STEP) << shift
+        shift -= 15
+    return struct.pack("<3H", bits & 0xFFFF, (bits >> 16) & 0xFFFF, (bits >> 32) & 0xFFFF)
+
+
+def _anim_encode_times(times, duration: float, kind: int) -> bytes:
+    """u16 に丸めても単調増加で誤差が許容値以内なら u16、そうでなければ f32"""
+    use_u16 = duration > 0.0 and duration / (2.0 * ANIM_VEC3_STEP) <= ANIM_TIME_TOLERANCE
+    q = []
+    for t in times if use_u16 else []:
+        v = _anim_quantize_unit(t / duration, ANIM_VEC3_STEP)
+        if q and v <= q[-1]:
+            use_u16 = False
+            break
+        q.append(v)
+    if not use_u16:
+        kind |= ANIM_TRACK_FLOAT_TIME
+    out = struct.pack("<BI", kind, len(times))
+    if use_u16:
+        out += struct.pack(f"<{len(q)}H", *q)
+    else:
+        out += struct.pack(f"<{len(times)}f", *times)
+    return out
+
+
+def _anim_encode_vec3_track(keys, duration: float, tolerance: float) -> bytes:
+    if not keys:
+        return struct.pack("<B", ANIM_TRACK_EMPTY)
+    if all(_anim_vec3_error(keys[0][1], v) <= tolerance for _, v in keys):
+        return struct.pack("<B3f", ANIM_TRACK_CONSTANT, *keys[0][1])
+
+    kept = [keys[i] for i in _anim_reduce_keys(keys, tolerance, _anim_lerp3, _anim_vec3_error)]
+    times = [t for t, _ in kept]
+    lo = [min(v[i] for _, v in kept) for i in range(3)]
+    extent = [max(v[i] for _, v in kept) - lo[i] for i in range(3)]
+
+    # 範囲が広すぎて 16bit の刻みが許容値を超える（長いルートモーション等）なら値は f32 のまま
+    if max(extent) / (2.0 * ANIM_VEC3_STEP) > tolerance:
+        out = _anim_encode_times(times, duration, ANIM_TRACK_RAW)
+        for _, v in kept:
+            out += struct.pack("<3f", *v)
+        return out
+
+    out = _anim_encode_times(times, duration, ANIM_TRACK_QUANTIZED)
+    out += struct.pack("<3f", *lo) + struct.pack("<3f", *extent)
+    for _, v in kept:
+        out += struct.pack("<3H", *(
+            _anim_quantize_unit((v[i] - lo[i]) / extent[i] if extent[i] > 0.0 else 0.0, ANIM_VEC3_STEP)
+            for i in range(3)))
+    return out
+
+
+def _anim_encode_quat_track(keys, duration: float, tolerance: float) -> bytes:
+    if not keys:
+        return struct.pack("<B", ANIM_TRACK_EMPTY)
+    if all(_anim_quat_error(keys[0][1], q) <= tolerance for _, q in keys):
+        return struct.pack("<B4f", ANIM_TRACK_CONSTANT, *keys[0][1])
+
+    kept = [keys[i] for i in _anim_reduce_keys(keys, tolerance, _anim_slerp, _anim_quat_error)]
+    out = _anim_encode_times([t for t, _ in kept], duration, ANIM_TRACK_QUANTIZED)
+    for _, q in kept:
+        out += _anim_pack_quat(q)
+    return out
+
+
+def _write_anim_v2(out_path: Path, anim: dict) -> None:
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    items = list(anim["channels"].items())
+    duration = anim["duration"]
+    body = bytearray()
+    for name, data in items:
+        name_bytes = name.encode("utf-8")[:255]
+        body += struct.pack("<B", len(name_bytes)) + name_bytes
+        body += _anim_encode_vec3_track(data["t"], duration, ANIM_TOLERANCE_T)
+        body += _anim_encode_quat_track(data["r"], duration, ANIM_TOLERANCE_R)
+        body += _anim_encode_vec3_track(data["s"], duration, ANIM_TOLERANCE_S)
+
+    with out_path.open("wb") as f:
+        f.write(ANIM_MAGIC)
+        f.write(struct.pack("<IfIII", ANIM_VERSION_V2, duration, len(items), ANIM_HEADER_SIZE, 0))
+        f.write(body)
+
+
+def _write_anim(out_path: Path, anim: dict) -> None:
+    if ANIM_WRITE_VERSION == ANIM_VERSION:
+        _write_anim_v1(out_path, anim)
+    else:
+        _write_anim_v2(out_path, anim)
+
+
 # ============================================================
 # glTF → .mesh + .skel + .mat + .anim 変換
 # ============================================================
@@ -1185,7 +1370,7 @@ def convert_gltf_to_mesh(task: FileTask) -> bool:
         else:
             safe_name = anim["name"].replace("/", "_").replace(" ", "_")
             anim_path = out_dir / f"{stem}_{safe_name}.anim"
-        _write_anim_v1(anim_path, anim)
+        _write_anim(anim_path, anim)
 
     print(f"  vc={len(vb)} ic={len(ib)} skin={has_skinning} "
           f"joints={len(skel) if skel else 0} anims={len(animations)} "
@@ -1338,8 +1523,13 @@ def main() -> int:
     parser = argparse.ArgumentParser(description="Assets/ → Resources/ アセットコンバータ")
     parser.add_argument("--force", action="store_true", help="差分を無視して全再変換")
     parser.add_argument("--dry-run", action="store_true", help="実際の変換は行わず予定のみ表示")
+    parser.add_argument("--anim-v1", action="store_true", help=".anim を旧形式（float キーそのまま）で書き出す")
     args = parser.parse_args()
 
+    global ANIM_WRITE_VERSION
+    if args.anim_v1:
+        ANIM_WRITE_VERSION = ANIM_VERSION
+
     if not ASSETS_DIR.exists():
         print(
             f"[ERROR] {ASSETS_DIR} が見つかりません。Project/ ディレクトリで実行してください。",
@@ -9,6 +9,7 @@
     - Resources/ 配下の全ファイルを走査
     - パスは "Resources/Textures/uvChecker.dds" の形式で .pack 内に登録
     - エンジン側 AssetLocator::Open("Resources/...") の引数と一致する形にする
+    - 目次は最小完全ハッシュ（MPH）のスロット順。拡張子別の索引も書き出す（v2）
     - 圧縮タイプは現状すべて NONE（Phase B.3 で GDeflate を追加予定）
 
 フォーマット詳細は memory の directstorage_pipeline_plan.md を参照。
@@ -29,9 +30,12 @@ from pathlib import Path
 # フォーマット定数
 # ============================================================
 PACK_MAGIC = 0x4B434150            # "PACK" little-endian
-PACK_VERSION = 1
-PACK_HEADER_SIZE = 16
+PACK_VERSION = 2
+PACK_HEADER_SIZE = 48
 PACK_INDEX_ENTRY_SIZE = 40
+PACK_EXT_ENTRY_SIZE = 16
+MPH_KEYS_PER_BUCKET = 3            # 平均バケットサイズ（小さいほど seed 探索が速く、seed 表が大きい）
+MPH_MAX_SEED = 1 << 20
 PACK_PAYLOAD_ALIGN = 4096          # DirectStorage 推奨
 
 # compression_type
@@ -50,6 +54,7 @@ ASSET_SKEL = 2
 ASSET_MAT = 3
 ASSET_ANIM = 4
 ASSET_TEXTURE = 5
+ASSET_DEFS = 6
 
 _EXT_TO_TYPE = {
     ".mesh": ASSET_MESH,
@@ -57,8 +62,16 @@ _EXT_TO_TYPE = {
     ".mat":  ASSET_MAT,
     ".anim": ASSET_ANIM,
     ".dds":  ASSET_TEXTURE,
+    ".defs": ASSET_DEFS,
 }
 
+# 焼き込み済み定義（CookedDefs.h）。Header の先頭と SourceEntry
+DEFS_MAGIC = 0x53464544            # "DEFS" little-endian
+DEFS_HEADER_FORMAT = "<IHHIIIIIIIIIIII"   # 56 bytes
+DEFS_SOURCE_FORMAT = "<IIQq"              # 24 bytes
+# MSVC の std::filesystem::file_time_type は 1601-01-01 起点の 100ns 単位
+_FILETIME_UNIX_EPOCH = 116444736000000000
+
 
 # ============================================================
 # パス → ハッシュ
@@ -72,6 +85,67 @@ def fnv1a_64(s: str) -> int:
     return h
 
 
+# ============================================================
+# 最小完全ハッシュ（CHD 方式: バケットごとに seed をずらして空きスロットへ落とす）
+# AssetLocator.cpp の MphMix / MphBucket / MphSlot と完全に同じ計算にすること
+# ============================================================
+_M64 = 0xFFFFFFFFFFFFFFFF
+
+
+def mph_mix(h: int, seed: int) -> int:
+    """name_hash を seed で攪拌する（splitmix64 の finalizer）"""
+    x = (h ^ ((seed * 0x9E3779B97F4A7C15) & _M64)) & _M64
+    x ^= x >> 33
+    x = (x * 0xFF51AFD7ED558CCD) & _M64
+    x ^= x >> 33
+    x = (x * 0xC4CEB9FE1A85EC53) & _M64
+    x ^= x >> 33
+    return x
+
+
+def mph_bucket(h: int, bucket_count: int) -> int:
+    return mph_mix(h, 0) % bucket_count
+
+
+def mph_slot(h: int, seed: int, count: int) -> int:
+    return mph_mix(h, seed + 1) % count
+
+
+def build_mph(hashes: list[int]) -> tuple[list[int], list[int]]:
+    """hashes (重複なし) の最小完全ハッシュを作る。
+
+    戻り値: (seeds[bucket_count], slot_of[len(hashes)])
+    slot_of[i] は hashes[i] の落ち先スロット（0..n-1 の置換）。
+    """
+    n = len(hashes)
+    if n == 0:
+        return [], []
+    bucket_count = max(1, (n + MPH_KEYS_PER_BUCKET - 1) // MPH_KEYS_PER_BUCKET)
+    buckets: list[list[int]] = [[] for _ in range(bucket_count)]
+    for i, h in enumerate(hashes):
+        buckets[mph_bucket(h, bucket_count)].append(i)
+
+    seeds = [0] * bucket_count
+    slot_of = [-1] * n
+    taken = [False] * n
+    # 大きいバケットから（空きが多いうちに）詰める
+    for b in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        keys = buckets[b]
+        if not keys:
+            break
+        for seed in range(MPH_MAX_SEED):
+            slots = [mph_slot(hashes[i], seed, n) for i in keys]
+            if len(set(slots)) == len(slots) and not any(taken[s] for s in slots):
+                break
+        else:
+            raise RuntimeError(f"MPH: bucket {b} ({len(keys)} keys) に seed が見つからない")
+        seeds[b] = seed
+        for i, s in zip(keys, slots):
+            taken[s] = True
+            slot_of[i] = s
+    return seeds, slot_of
+
+
 def asset_type_from_path(path: str) -> int:
     ext = Path(path).suffix.lower()
     return _EXT_TO_TYPE.get(ext, ASSET_OTHER)
@@ -305,29 +379,120 @@ def collect_entries(resources_root: Path,
     return entries
 
 
+def check_cooked_defs(resources_root: Path) -> int:
+    """Resources/Cooked/*.defs が元の Resources/Json と一致しているか確かめ、古いものを警告する。
+
+    .defs はエンジンが JSON を読んだときに焼き直す（pack モードでは焼かない）ので、
+    JSON を編集したあと一度ゲームを起動せずに pack すると古い定義が入ってしまう。
+    ディレクトリ単位の .defs（Prefabs.defs など）は JSON の追加・削除も見る。
+    戻り値は警告の数。
+    """
+    cooked_root = resources_root / "Cooked"
+    json_root = resources_root / "Json"
+    project_root = resources_root.parent
+    if not cooked_root.exists():
+        if json_root.exists():
+            print("[WARN] Resources/Cooked が無い（定義は JSON から読むので動くが遅い）。"
+                  "一度ゲームを起動して .defs を焼いてから pack すること", file=sys.stderr)
+            return 1
+        return 0
+
+    header_size = struct.calcsize(DEFS_HEADER_FORMAT)
+    source_size = struct.calcsize(DEFS_SOURCE_FORMAT)
+    warnings = 0
+    for defs in sorted(cooked_root.rglob("*.defs")):
+        data = defs.read_bytes()
+        rel = defs.relative_to(project_root).as_posix()
+        if len(data) < header_size:
+            print(f"[WARN] {rel}: ヘッダが壊れている", file=sys.stderr)
+            warnings += 1
+            continue
+        header = struct.unpack_from(DEFS_HEADER_FORMAT, data)
+        magic, source_count, sources_offset, strings_offset = header[0], header[7], header[8], header[10]
+        if magic != DEFS_MAGIC:
+            print(f"[WARN] {rel}: .defs ではない", file=sys.stderr)
+            warnings += 1
+            continue
+
+        recorded = []
+        for i in range(source_count):
+            path_offset, path_length, size, write_time = struct.unpack_from(
+                DEFS_SOURCE_FORMAT, data, sources_offset + i * source_size)
+            start = strings_offset + path_offset
+            recorded.append((data[start:start + path_length].decode("utf-8"), size, write_time))
+
+        # Resources/Cooked/<X>.defs ← Resources/Json/<X>/*.json または Resources/Json/<X>.json
+        stem = defs.relative_to(cooked_root).with_suffix("")
+        json_dir = json_root / stem
+        if json_dir.is_dir():
+            current = sorted(p for p in json_dir.glob("*.json") if p.is_file())
+        else:
+            current = [p for p in [json_root / stem.with_suffix(".json")] if p.is_file()]
+
+        stale = len(current) != len(recorded)
+        for path, (recorded_path, size, write_time) in zip(current, recorded):
+            st = path.stat()
+            if path.relative_to(project_root).as_posix() != recorded_path or st.st_size != size:
+                stale = True
+            elif os.name == "nt" and st.st_mtime_ns // 100 + _FILETIME_UNIX_EPOCH != write_time:
+                stale = True
+        if stale:
+            print(f"[WARN] {rel} が元の JSON より古い。一度ゲームを起動して焼き直してから pack すること",
+                  file=sys.stderr)
+            warnings += 1
+    return warnings
+
+
 def align_up(value: int, alignment: int) -> int:
     return (value + alignment - 1) & ~(alignment - 1)
 
 
 def write_pack(entries: list[dict], output_path: Path) -> None:
-    # ---- ハッシュ昇順にソート（二分探索を可能にする）----
+    # ---- 最小完全ハッシュのスロット順に並べる（ランタイムは 1 回のプローブで引ける）----
     for e in entries:
         e["name_hash"] = fnv1a_64(e["path"])
-    entries.sort(key=lambda e: e["name_hash"])
-
-    # ---- 文字列テーブル組み立て ----
-    string_table = bytearray()
+    seen: dict[int, str] = {}
+    for e in entries:
+        other = seen.setdefault(e["name_hash"], e["path"])
+        if other != e["path"]:
+            raise RuntimeError(f"FNV-1a 衝突: {other} / {e['path']}（どちらかをリネームすること）")
+    seeds, slot_of = build_mph([e["name_hash"] for e in entries])
+    for e, slot in zip(entries, slot_of):
+        e["slot"] = slot
+    entries.sort(key=lambda e: e["slot"])
+
+    # ---- 文字列プール（全パス + 拡張子。NUL 終端なし、offset/length で参照）----
+    string_pool = bytearray()
     for e in entries:
-        e["path_offset"] = len(string_table)
+        e["path_offset"] = len(string_pool)
         path_bytes = e["path"].encode("utf-8")
         e["path_length"] = len(path_bytes)
-        string_table.extend(path_bytes)
+        string_pool.extend(path_bytes)
+
+    # ---- 拡張子別の索引（拡張子は小文字、各グループ内はパス昇順）----
+    ext_groups: dict[str, list[int]] = {}
+    for e in entries:
+        ext = Path(e["path"]).suffix.lower()
+        if ext:
+            ext_groups.setdefault(ext, []).append(e["slot"])
+    ext_table = []   # (str_offset, str_len, first, count)
+    ext_list: list[int] = []
+    for ext in sorted(ext_groups):
+        slots = sorted(ext_groups[ext], key=lambda s: entries[s]["path"])
+        ext_bytes = ext.encode("utf-8")
+        ext_table.append((len(string_pool), len(ext_bytes), len(ext_list), len(slots)))
+        string_pool.extend(ext_bytes)
+        ext_list.extend(slots)
 
     # ---- レイアウト計算 ----
+    # [Header 48B][Index 40B×N][MPH seed 4B×B][拡張子表 16B×E][拡張子別リスト 4B×M][文字列プール]
     asset_count = len(entries)
     index_offset = PACK_HEADER_SIZE
-    string_table_offset = index_offset + asset_count * PACK_INDEX_ENTRY_SIZE
-    payload_section_start = align_up(string_table_offset + len(string_table),
+    mph_offset = index_offset + asset_count * PACK_INDEX_ENTRY_SIZE
+    ext_table_offset = mph_offset + len(seeds) * 4
+    ext_list_offset = ext_table_offset + len(ext_table) * PACK_EXT_ENTRY_SIZE
+    string_pool_offset = ext_list_offset + len(ext_list) * 4
+    payload_section_start = align_up(string_pool_offset + len(string_pool),
                                      PACK_PAYLOAD_ALIGN)
 
     # 各エントリの payload_offset を計算（各ペイロードも 4KB 境界に揃える）
@@ -346,11 +511,15 @@ def write_pack(entries: list[dict], output_path: Path) -> None:
     # ---- 書き出し ----
     output_path.parent.mkdir(parents=True, exist_ok=True)
     with output_path.open("wb") as f:
-        # Header (16B)
-        f.write(struct.pack("<IIII",
-                            PACK_MAGIC, PACK_VERSION, asset_count, index_offset))
-
-        # Index entries (40B × N)
+        # Header (48B)
+        f.write(struct.pack("<IIIIIIIIIIII",
+                            PACK_MAGIC, PACK_VERSION, asset_count, index_offset,
+                            string_pool_offset, len(string_pool),
+                            mph_offset, len(seeds),
+                            ext_table_offset, len(ext_table),
+                            ext_list_offset, len(ext_list)))
+
+        # Index entries (40B × N, MPH スロット順)
         for e in entries:
             f.write(struct.pack("<QIHBBQQQ",
                                 e["name_hash"],
@@ -362,8 +531,12 @@ def write_pack(entries: list[dict], output_path: Path) -> None:
                                 e["uncompressed_size"],
                                 e["payload_offset"]))
 
-        # String table
-        f.write(string_table)
+        # MPH seed 表 / 拡張子表 / 拡張子別リスト / 文字列プール
+        f.write(struct.pack(f"<{len(seeds)}I", *seeds))
+        for str_offset, str_len, first, count in ext_table:
+            f.write(struct.pack("<IHHII", str_offset, str_len, 0, first, count))
+        f.write(struct.pack(f"<{len(ext_list)}I", *ext_list))
+        f.write(string_pool)
 
         # Payload セクション開始までゼロ埋め
         pad = payload_section_start - f.tell()
@@ -383,7 +556,7 @@ def write_pack(entries: list[dict], output_path: Path) -> None:
     # 統計
     type_names = {
         ASSET_MESH: "mesh", ASSET_SKEL: "skel", ASSET_MAT: "mat",
-        ASSET_ANIM: "anim", ASSET_TEXTURE: "dds", ASSET_OTHER: "other",
+        ASSET_ANIM: "anim", ASSET_TEXTURE: "dds", ASSET_DEFS: "defs", ASSET_OTHER: "other",
     }
     type_counts: dict[int, int] = {}
     for e in entries:
@@ -397,6 +570,8 @@ def write_pack(entries: list[dict], output_path: Path) -> None:
 
     print(f"Packed {asset_count} assets → {output_path}")
     print(f"  Total size:   {total_size:,} bytes ({total_size / 1024 / 1024:.2f} MB)")
+    print(f"  Index:        MPH {len(seeds)} buckets, {len(ext_table)} extensions, "
+          f"string pool {len(string_pool):,} bytes")
     print(f"  Payload sum:  raw={uncomp_sum / 1024 / 1024:.2f} MB → "
           f"stored={comp_sum / 1024 / 1024:.2f} MB"
           + (f" ({comp_sum / uncomp_sum * 100:.1f}%)" if uncomp_sum > 0 else ""))
@@ -445,6 +620,8 @@ def main() -> int:
     else:
         print("[pack] GDeflate 圧縮 OFF")
 
+    check_cooked_defs(resources)
+
     entries = collect_entries(resources, gdeflate_exe)
     if not entries:
         print("[ERROR] no assets to pack", file=sys.stderr)
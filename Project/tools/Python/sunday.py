@@ -7,7 +7,7 @@
 再現性判定(Step7)・GitHub Issue起票(Step8)・JARVIS統合(Step9)は次段で追加する。
 
 前提:
-- Debug ビルドの CG2_0_1.exe（全カテゴリ TRACE 出力。state/event/input.log が出る）
+- Debug ビルドの CG2_0_1.exe（全カテゴリ TRACE 出力。state/event.log と入力記録 input.rpl が出る）
 - 入力は仮想Xboxコントローラ(vgamepad/ViGEmBus)で送る。XInput はウィンドウの
   フォーカスやマウス位置に依存しないため、無人稼働に向く。
 - シーン認識は event.log の SCENE_CHANGE を追尾して行う（Title/Hub は state.log を出さないため）
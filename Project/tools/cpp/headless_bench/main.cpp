@@ -0,0 +1,140 @@
+/*
+ Headless benchmark CLI
+
+ 用途:
+   ウィンドウ・D3D12 デバイス・ImGui を作らずに、CPU 側だけで完結するベンチマークを回して結果を標準出力に出す。
+   ゲーム本体の Benchmarks ウィンドウ（ImGuiManager）と同じ関数を呼ぶので、数値はそちらと比べられる。
+   CI や Windows 以外の環境で計測・一致確認したいとき用。
+
+ 使い方:
+   headless_bench.exe [texture-mips] [lightning-bolts] [cpu-particles] [pose-evaluation] [anim-codec] [pack [Assets.pack]]
+                      [collision-broadphase] [collision-narrowphase] [all]
+     引数なし / all なら全部。結果は LogBuffer に積まれたものをそのまま 1 行ずつ出す。
+     pack の後ろにパスを書けばその pack を計る（tools/Python/pack_assets.py で作ったもの）。
+     省略時は ../Generated/Assets.pack などを探し、見つからなければ飛ばす。
+
+   Windows 以外（Windows SDK 不要。DDSHeader.h / LogBuffer.cpp は _WIN32 以外でもビルドできる。
+   Skeleton.cpp / Animation.cpp / AnimationCodec.cpp は D3D12・assimp を読まない。assimp の読み込みは AnimationLoader.cpp。
+   MappedFile.cpp は _WIN32 以外では mmap を使う。Game/Components の当たり判定は Collision*.cpp だけで閉じている）:
+     G=DirectXGame/GameEngine   # Project/ から
+     g++ -std=c++20 -O2 -pthread -DNDEBUG \
+         -I$G/Graphics -I$G/Graphics/Effect -I$G/Graphics/Primitive -I$G/Graphics/Particle -I$G/Graphics/Object3D \
+         -I$G/Core -I$G/Utility -I$G/Math \
+         -I$G/Profiling -IDirectXGame/Debug -IDirectXGame/Game/Components \
+         tools/cpp/headless_bench/main.cpp $G/Graphics/TextureMips.cpp $G/Graphics/Effect/LightningBatch.cpp \
+         $G/Graphics/Primitive/PrimitiveGenerator.cpp $G/Graphics/Particle/ParticlePool.cpp \
+         $G/Graphics/Object3D/Skeleton.cpp $G/Graphics/Object3D/Animation.cpp $G/Graphics/Object3D/AnimationCodec.cpp \
+         $G/Math/MathUtility.cpp $G/Math/Quaternion.cpp $G/Core/AssetLocator.cpp $G/Core/MappedFile.cpp \
+         $G/Utility/JobSystem.cpp DirectXGame/Debug/LogBuffer.cpp \
+         DirectXGame/Game/Components/CollisionBroadphase.cpp DirectXGame/Game/Components/CollisionNarrowphase.cpp \
+         DirectXGame/Game/Components/CollisionBenchmark.cpp \
+         -o headless_bench
+
+ 終了コード: 0 = 全部一致 / 1 = MISMATCH などエラーのログが出た / 2 = 引数が不正
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "AnimationCodec.h"
+#include "AssetLocator.h"
+#include "CollisionBenchmark.h"
+#include "CollisionBroadphase.h"
+#include "JobSystem.h"
+#include "LightningBatch.h"
+#include "LogBuffer.h"
+#include "ParticlePool.h"
+#include "Skeleton.h"
+#include "TextureMips.h"
+
+namespace {
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+    void (*runWithArg)(const std::string&) = nullptr;  // 引数を 1 つ取るもの（run は nullptr）
+    const char* argName = nullptr;                    // usage に出す引数名
+};
+
+const Benchmark kBenchmarks[] = {
+    { "texture-mips",    RunTextureMipBenchmark },
+    { "lightning-bolts", RunLightningBoltBenchmark },
+    { "cpu-particles",   RunParticlePoolBenchmark },
+    { "pose-evaluation", RunPoseEvaluationBenchmark },
+    { "anim-codec",      RunAnimationCodecBenchmark },  // 誤差が上限を超えたらエラー（終了コード 1）
+    { "pack",            nullptr, AssetLocator::RunPackBenchmark, "Assets.pack" },
+    // ゲームでは CollisionManager の現在のセルサイズで回す。ここでは既定値
+    { "collision-broadphase", [] { CollisionBenchmark::RunBroadphase(SpatialHashBroadphase().GetCellSize()); } },
+    // OBB-Capsule の厳密判定と、SSE 経路とスカラー経路の照合（ゲームの Run OBB-Capsule Benchmark と同じ）
+    { "collision-narrowphase", [] { CollisionBenchmark::RunOBBCapsule(); CollisionBenchmark::RunNarrowphase(); } },
+};
+
+struct Selection {
+    const Benchmark* benchmark;
+    std::string arg;
+};
+
+const Benchmark* FindBenchmark(const char* name) {
+    for (const Benchmark& b : kBenchmarks) {
+        if (std::strcmp(b.name, name) == 0) return &b;
+    }
+    return nullptr;
+}
+
+void PrintUsage() {
+    std::fprintf(stderr, "usage: headless_bench [all");
+    for (const Benchmark& b : kBenchmarks) {
+        if (b.argName) std::fprintf(stderr, " | %s [%s]", b.name, b.argName);
+        else std::fprintf(stderr, " | %s", b.name);
+    }
+    std::fprintf(stderr, "] ...\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<Selection> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "all") == 0) {
+            selected.clear();
+            break;
+        }
+        const Benchmark* b = FindBenchmark(argv[i]);
+        if (!b) {
+            std::fprintf(stderr, "unknown benchmark: %s\n", argv[i]);
+            PrintUsage();
+            return 2;
+        }
+        Selection s{ b, std::string() };
+        // 引数を取るものは、次がベンチマーク名でなければそれを引数として食う
+        if (b->runWithArg && i + 1 < argc && std::strcmp(argv[i + 1], "all") != 0 && !FindBenchmark(argv[i + 1])) {
+            s.arg = argv[++i];
+        }
+        selected.push_back(s);
+    }
+    if (selected.empty()) {
+        for (const Benchmark& b : kBenchmarks) selected.push_back({ &b, std::string() });
+    }
+
+    // ゲーム本体と同じく起動時にワーカーを作る（論理コア数 - 1 本）
+    JobSystem::GetInstance()->Initialize();
+
+    for (const Selection& s : selected) {
+        std::printf("== %s%s%s\n", s.benchmark->name, s.arg.empty() ? "" : " ", s.arg.c_str());
+        std::fflush(stdout);
+        if (s.benchmark->runWithArg) s.benchmark->runWithArg(s.arg);
+        else s.benchmark->run();
+    }
+
+    bool failed = false;
+    for (const LogBuffer::LogEntry& entry : LogBuffer::Instance().GetLogs()) {
+        const bool error = entry.level == LogBuffer::Level::Error;
+        failed = failed || error;
+        std::printf("%s%s\n", error ? "[ERROR] " : "", entry.message.c_str());
+    }
+
+    JobSystem::GetInstance()->Finalize();
+    return failed ? 1 : 0;
+}